@@ -29,6 +29,7 @@
 #include "cinder/Buffer.h"
 #include "cinder/Stream.h"
 #include "cinder/Filesystem.h"
+#include "cinder/MemoryMappedFile.h"
 
 namespace cinder {
 
@@ -152,4 +153,31 @@ class CI_API DataSourceBuffer : public DataSource {
 	IStreamMemRef	mStream;
 };
 
+typedef std::shared_ptr<class DataSourceMemoryMapped>	DataSourceMemoryMappedRef;
+
+//! DataSource whose Buffer is a read-only memory mapping of a file, so that getBuffer() doesn't read or copy the file's contents.
+class CI_API DataSourceMemoryMapped : public DataSource {
+  public:
+	//! Maps the file at \a path. Throws MemoryMappedFileExc if the file can't be mapped.
+	static DataSourceMemoryMappedRef	create( const fs::path &path );
+
+	virtual bool	isFilePath() { return true; }
+	virtual bool	isUrl() { return false; }
+
+	virtual IStreamRef	createStream();
+
+	//! Returns the mapping, which the Buffer returned by getBuffer() and the streams returned by createStream() also keep alive.
+	const MemoryMappedFileRef&	getMemoryMappedFile() const	{ return mFile; }
+
+  protected:
+	explicit DataSourceMemoryMapped( const fs::path &path );
+
+	virtual	void	createBuffer();
+
+	MemoryMappedFileRef		mFile;
+};
+
+//! Returns a DataSourceMemoryMapped for \a path. \see DataSourceMemoryMapped
+CI_API DataSourceRef loadFileMapped( const fs::path &path );
+
 } // namespace cinder
@@ -61,7 +61,11 @@ class WatchEvent {
 
 //! FileMonitor provides a system for monitoring the filesystem for changes at runtime using callbacks.
 //!
-//! Performs file watching asynchronously, however all callbacks will be emitted on the main thread. It is advisable to capture
+//! Performs file watching asynchronously, however all callbacks will be emitted on the main thread. Watching a directory reports
+//! the files inside it that are created or modified, optionally including all of its subdirectories (see Options::recursive()).
+//!
+//! On Linux, changes are received from inotify by default, which costs no CPU time while nothing changes regardless of the number
+//! of watched files. Elsewhere, or if inotify is unavailable, a thread polls the last write time of every watched file, see Backend. It is advisable to capture
 //! the resulting signals::Connection with with some sort of scope controlling to ensure that your callbacks are disconnected
 //! when your object is destroyed. \see signals::ScopedConnection, signals::ConnectionList.
 //!
@@ -70,16 +74,27 @@ class WatchEvent {
 //! on a specific file, you can use the returned Connection's disable() or disconnect() methods.
 class CI_API FileWatcher : private Noncopyable {
   public:
-	FileWatcher();
+	//! Determines how modified files are detected.
+	enum class Backend {
+		//! Compares the last write time of every watched file, every getThreadUpdateInterval() seconds.
+		POLLING,
+		//! Receives change notifications from the OS, currently inotify on Linux. Falls back to POLLING on other platforms.
+		NATIVE
+	};
+
+	FileWatcher( Backend backend = Backend::NATIVE );
 	~FileWatcher();
 
 	//! Optional parameters provided to watch()
 	struct Options {
 		//! If true (default), the callback is fired directly after the watch is added, before the call to watch() returns.
 		Options& callOnWatch( bool b )	{ mCallOnWatch = b; return *this; }
+		//! If true, watched directories also report files in all of their subdirectories, including those created later. Default = false.
+		Options& recursive( bool b = true )	{ mRecursive = b; return *this; }
 
 	private:
 		bool	mCallOnWatch = true;
+		bool	mRecursive = false;
 
 		friend class FileWatcher;
 	};
@@ -91,6 +106,8 @@ class CI_API FileWatcher : private Noncopyable {
 	void	setWatchingEnabled( bool enable );
 	//! Returns whether file watching is enabled or disabled (\default true).
 	bool	isWatchingEnabled() const				{ return mWatchingEnabled; }
+	//! Returns the Backend in use, which is Backend::POLLING when the requested Backend::NATIVE isn't available.
+	Backend	getBackend() const						{ return mBackend; }
 	//! Enables or disables automatic updates by connecting to the App's update method (\default true). Requires an App instance. If false, you must explicitly call update() to receive WatchEvents.
 	void	setConnectToAppUpdateEnabled( bool enable );
 	//! Returns whether file watching is enabled or disabled.
@@ -128,6 +145,11 @@ class CI_API FileWatcher : private Noncopyable {
 	void		setThreadUpdateInterval( double seconds )	{ mThreadUpdateInterval = seconds; }
 	//! Returns the update time interval in seconds for the polling thread. \default is 0.02 seconds.
 	double		getThreadUpdateInterval() const				{ return mThreadUpdateInterval; }
+	//! Sets how long in seconds Backend::NATIVE waits for further changes before reporting a change, so that the several events of saving
+	//! a file (such as writing a temporary file and renaming it over the original) result in a single callback. \default is 0.01 seconds.
+	void		setCoalesceInterval( double seconds )		{ mCoalesceInterval = seconds; }
+	//! Returns how long in seconds Backend::NATIVE waits for further changes before reporting a change. \default is 0.01 seconds.
+	double		getCoalesceInterval() const					{ return mCoalesceInterval; }
 
   private:
 
@@ -135,12 +157,20 @@ class CI_API FileWatcher : private Noncopyable {
 	void	connectAppUpdate();
 	void	stopWatchPolling();
 	void	threadEntry();
+	void	threadEntryNative();
+	//! Removes \a watch from the watch list, along with any OS notifications it uses. Expects mMutex to be locked.
+	std::list<std::unique_ptr<Watch>>::iterator	eraseWatch( std::list<std::unique_ptr<Watch>>::iterator it );
+
+	class NativeImpl;
 
+	Backend								mBackend;
+	std::unique_ptr<NativeImpl>			mNative;
 	std::list<std::unique_ptr<Watch>>	mWatchList;
 	mutable std::recursive_mutex		mMutex;
 	std::thread							mThread;
 	std::atomic<bool>					mThreadShouldQuit;
 	std::atomic<double>					mThreadUpdateInterval		= { 0.02 };
+	std::atomic<double>					mCoalesceInterval			= { 0.01 };
 	std::atomic<bool>					mWatchingEnabled			= { true };
 	std::atomic<bool>					mConnectToAppUpdateEnabled	= { true };
 	signals::Connection					mConnectionAppUpdate;
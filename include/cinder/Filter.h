@@ -116,7 +116,7 @@ class CI_API FilterCatmullRom : public FilterBase {
 // see Mitchell&Netravali, "Reconstruction Filters in Computer Graphics", SIGGRAPH 88
 class CI_API FilterMitchell : public FilterBase {
  public:
-	FilterMitchell( float aSupport = 2.0f, float b = 0.3333333333f, float c = 0.3333333333f ) : FilterBase( aSupport ) {
+	FilterMitchell( float aSupport = 2.0f, float b = 0.3333333333f, float c = 0.3333333333f ) : FilterBase( aSupport ), mB( b ), mC( c ) {
 	    mP0 = ( 6.0f - 2.0f * b ) / 6.0f;
 		mP2 = ( -18.0f + 12.0f * b + 6.0f * c ) / 6.0f;
 		mP3 = ( 12.0f - 9.0f * b - 6.0f * c ) / 6.0f;
@@ -134,8 +134,12 @@ class CI_API FilterMitchell : public FilterBase {
 		else if ( x < 2.0f ) return mQ0 + x * ( mQ1 + x * ( mQ2 + x * mQ3 ) );
 		return 0.0f;
 	}
+
+	float getB() const { return mB; }
+	float getC() const { return mC; }
 	
  private:
+	float mB, mC;
 	float mQ0, mQ1, mQ2, mQ3;
 	float mP0, mP2, mP3;
 };
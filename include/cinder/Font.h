@@ -42,6 +42,8 @@
 		class Font;
 	}
 #elif defined( CINDER_ANDROID ) || defined( CINDER_LINUX )
+	#include <mutex>
+
 	typedef struct FT_FaceRec_* FT_Face;
 #endif
 
@@ -93,9 +95,12 @@ class CI_API Font {
 
 #if defined( CINDER_ANDROID ) || defined( CINDER_LINUX )
 	FT_Face					getFreetypeFace() const;
+	//! Returns the mutex held while a FreeType face is used, created or destroyed. FreeType faces and the library they belong to must not be used from several threads at once.
+	static std::mutex&		getFreetypeMutex();
 #endif
 	
-	static const std::vector<std::string>&		getNames( bool forceRefresh = false );
+	//! Returns a copy of the names of the installed fonts, which are enumerated on the first call or when \a forceRefresh is \c true.
+	static std::vector<std::string>		getNames( bool forceRefresh = false );
 	static Font				getDefault();
 
 #if defined( CINDER_COCOA )
@@ -0,0 +1,104 @@
+/*
+ Copyright (c) 2026, The Cinder Project
+
+ This code is intended to be used with the Cinder C++ library, http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#pragma once
+
+#include "cinder/ImageIo.h"
+#include "cinder/MemoryMappedFile.h"
+
+namespace cinder {
+
+//! \brief Header of the uncompressed ".ciraw" image format.
+//!
+//! The header is followed by mHeight rows of mRowBytes bytes each, starting mDataOffset bytes from the beginning of the file.
+//! Values are stored in the byte order of the machine that wrote the file, which is checked against mByteOrderMark.
+//! Pixels are stored as they are laid out in memory, so that a file can be mapped and used as a Surface directly. \see mapSurface()
+struct RawImageHeader {
+	static const uint32_t	VERSION = 1;
+	//! The data offset written by ImageTargetFileRaw, which keeps the pixels aligned for SIMD access when the file is mapped.
+	static const uint32_t	DATA_OFFSET = 64;
+
+	char		mMagic[8];
+	uint32_t	mByteOrderMark;
+	uint32_t	mVersion;
+	uint32_t	mWidth, mHeight;
+	uint32_t	mDataType;		// ImageIo::DataType
+	uint32_t	mChannelOrder;	// ImageIo::ChannelOrder
+	uint32_t	mColorModel;	// ImageIo::ColorModel
+	uint32_t	mPremultiplied;
+	uint64_t	mRowBytes;
+	uint64_t	mDataOffset;
+
+	//! Returns a header describing \a imageSource, laid out with the channel order of \a imageSource where possible.
+	static RawImageHeader	create( const ImageSourceRef &imageSource );
+	//! Returns the header at the start of \a data, throwing ImageIoExceptionFailedLoad if it isn't a valid header or \a size is too small for the pixels.
+	static RawImageHeader	read( const void *data, size_t size );
+};
+
+typedef std::shared_ptr<class ImageSourceFileRaw>	ImageSourceFileRawRef;
+
+//! Loads ".ciraw" images. Files are memory mapped, so only the rows which are loaded are read from disk.
+class ImageSourceFileRaw : public ImageSource {
+  public:
+	static ImageSourceRef	create( DataSourceRef dataSource, ImageSource::Options options = ImageSource::Options() );
+
+	void	load( ImageTargetRef target ) override;
+
+	static void		registerSelf();
+
+  protected:
+	ImageSourceFileRaw( DataSourceRef dataSource, ImageSource::Options options );
+
+	BufferRef			mData;
+	RawImageHeader		mHeader;
+};
+
+//! Writes ".ciraw" images, keeping the data type and channel order of the ImageSource.
+class ImageTargetFileRaw : public ImageTarget {
+  public:
+	static ImageTargetRef	create( DataTargetRef dataTarget, ImageSourceRef imageSource, ImageTarget::Options options, const std::string &extensionData );
+
+	void*	getRowPointer( int32_t row ) override;
+	void	finalize() override;
+
+	static void		registerSelf();
+
+  protected:
+	ImageTargetFileRaw( DataTargetRef dataTarget, ImageSourceRef imageSource, ImageTarget::Options options, const std::string &extensionData );
+
+	DataTargetRef			mDataTarget;
+	RawImageHeader			mHeader;
+	std::vector<uint8_t>	mData;
+};
+
+//! \brief Returns a Surface whose pixels are the memory mapped ".ciraw" file at \a path, without copying them.
+//!
+//! The Surface's data store keeps the mapping alive, and pages are only read from disk as they are accessed. By default the mapping is read-only
+//! and writing to the Surface is an access violation. When \a copyOnWrite is \c true the Surface may be modified, with changed pages becoming
+//! private copies. The file itself is never modified. Throws ImageIoException if the file can't be mapped, or its data type or channel order
+//! can't be represented by a SurfaceT<T>.
+template<typename T>
+CI_API std::shared_ptr<SurfaceT<T>>	mapSurface( const fs::path &path, bool copyOnWrite = false );
+
+} // namespace cinder
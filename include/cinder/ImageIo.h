@@ -85,27 +85,39 @@ class CI_API ImageIo {
 
 class CI_API ImageSource : public ImageIo {
   public:
-	ImageSource() : ImageIo(), mIsPremultiplied( false ), mPixelAspectRatio( 1 ), mCustomPixelInc( 0 ), mFrameCount( 1 ) {}
+	ImageSource() : ImageIo(), mIsPremultiplied( false ), mPixelAspectRatio( 1 ), mCustomPixelInc( 0 ), mFrameCount( 1 ), mRegionDownscale( 1 ), mRegionLastRow( -1 ), mRegionApplied( false ) {}
 	virtual ~ImageSource() {}  
 
 	//! Optional parameters passed when creating an Image. \see loadImage()
 	class Options {
 	  public:
-		Options() : mIndex( 0 ), mThrowOnFirstException( false ) {}
+		Options() : mIndex( 0 ), mThrowOnFirstException( false ), mArea( 0, 0, 0, 0 ), mDownscale( 1 ) {}
 
 		//! Specifies an image index for multi-part images, like animated GIFs. 0-based index.
 		Options& index( int32_t index )						{ mIndex = index; return *this; }
 		//! If an exception occurs, enabling this will prevent any attempts at using other handlers to load the image. Default = false, all handlers are tried and if none succeed, the last exception is rethrown. \see ImageIoException
 		Options& throwOnFirstException( bool b = true )		{ mThrowOnFirstException = b; return *this; }
+		//! Restricts the ImageSource to \a area, in pixels of the full image, which is clipped to the image's bounds. Default is an empty Area, meaning the whole image.
+		Options& area( const Area &area )					{ mArea = area; return *this; }
+		//! Reduces the ImageSource's size by an integer \a factor, averaging each block of \a factor x \a factor pixels. Applied after area(). Default = 1.
+		Options& downscale( int32_t factor )				{ mDownscale = factor; return *this; }
 
 		//! Returns image index. \see index()
 		int32_t				getIndex() const				{ return mIndex; }
 		//! Returns whether throwOnFirstException() is enabled or not.
 		bool				getThrowOnFirstException()		{ return mThrowOnFirstException; }
+		//! Returns the area of the image to load, or an empty Area for the whole image. \see area()
+		const Area&			getArea() const					{ return mArea; }
+		//! Returns the downscale factor. \see downscale()
+		int32_t				getDownscale() const			{ return mDownscale; }
+		//! Returns whether area() or downscale() change the size of the image from that of the file.
+		bool				hasRegion() const				{ return mArea.getWidth() > 0 || mArea.getHeight() > 0 || mDownscale > 1; }
 		
 	  protected:
 		int32_t			mIndex;
 		bool			mThrowOnFirstException;
+		Area			mArea;
+		int32_t			mDownscale;
 	};
 
 	//! Returns the aspect ratio of individual pixels to accommodate non-square pixels
@@ -129,6 +141,13 @@ class CI_API ImageSource : public ImageIo {
 	void		setFrameCount( int32_t frameCount ) { mFrameCount = frameCount; }
 
 	RowFunc		setupRowFunc( ImageTargetRef target );
+
+	//! Applies the area and downscale factor of \a options, which must follow setSize() with the size of the full image. Replaces the size with that of the result.
+	void		setupRegion( const Options &options );
+	//! Passes full width row \a sourceRow of the image through the area and downscale factor set by setupRegion(), calling \a func with the resulting rows. Rows must arrive in order, and rows outside of mRegionArea are ignored.
+	void		processRegionRow( ImageTargetRef target, RowFunc func, int32_t sourceRow, const void *data );
+	template<typename T>
+	void		downscaleRegionRow( ImageTargetRef target, RowFunc func, int32_t regionRow, const T *data );
 	void		setupRowFuncRgbSource( ImageTargetRef target );
 	void		setupRowFuncGraySource( ImageTargetRef target );
 	template<typename SD, typename TD, ColorModel TCS>
@@ -143,6 +162,16 @@ class CI_API ImageSource : public ImageIo {
 	template<typename SD, typename TD, ColorModel TCM, bool ALPHA>
 	void		rowFuncSourceGray( ImageTargetRef target, int32_t row, const void *data );
 
+	//! Returns a specialized RowFunc for common conversions, or \c nullptr when the generic rowFuncSource*() must be used. Expects the mRowFunc offsets to be set up.
+	template<typename SD, typename TD, ColorModel TCM>
+	RowFunc		setupRowFuncFastPath();
+	//! Converts a whole row at once when source and target share the same channel layout
+	template<typename SD, typename TD>
+	void		rowFuncSameLayout( ImageTargetRef target, int32_t row, const void *data );
+	//! Reorders 8 bit channels according to mRowFuncShuffle, 4 pixels at a time where SIMD shuffles are available. A source or target that isn't 8 bit is converted through mRowFuncScratch.
+	template<typename SD, typename TD, int SOURCEINC, int TARGETINC>
+	void		rowFuncShuffle8u( ImageTargetRef target, int32_t row, const void *data );
+
 	float						mPixelAspectRatio;
 	bool						mIsPremultiplied;
 	int8_t						mCustomPixelInc;
@@ -152,6 +181,20 @@ class CI_API ImageSource : public ImageIo {
 	int8_t						mRowFuncTargetRed, mRowFuncTargetGreen, mRowFuncTargetBlue, mRowFuncTargetAlpha;
 	int8_t						mRowFuncSourceGray, mRowFuncTargetGray;
 	int8_t						mRowFuncSourceInc, mRowFuncTargetInc;
+	//! Source byte index for each of 4 target pixels, or \c 0x80 for channels taken from mRowFuncShuffleFill
+	uint8_t						mRowFuncShuffle[16], mRowFuncShuffleFill[16];
+	std::vector<uint8_t>		mRowFuncScratch;
+
+	//! The area of the full image that is loaded, set by setupRegion(). Sources which don't decode rows outside of it save that work.
+	Area						mRegionArea;
+	int32_t						mRegionDownscale;
+	//! The last row passed to downscaleRegionRow(), to check that rows arrive in order
+	int32_t						mRegionLastRow;
+	bool						mRegionApplied;
+	std::vector<double>			mRegionSums;
+	std::vector<uint8_t>		mRegionRow;
+
+	friend class ImageSourceRegion;
 };
 
 class CI_API ImageTarget : public ImageIo {
@@ -0,0 +1,215 @@
+/*
+ Copyright (c) 2026, The Cinder Project
+
+ This code is intended to be used with the Cinder C++ library, http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#pragma once
+
+#include "cinder/ImageIo.h"
+#include "cinder/Noncopyable.h"
+#include "cinder/Surface.h"
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <future>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace cinder {
+
+typedef std::shared_ptr<class ImageLoadQueue>		ImageLoadQueueRef;
+typedef std::shared_ptr<class ImageLoadRequest>		ImageLoadRequestRef;
+
+//! A single image decode submitted to an ImageLoadQueue. \see ImageLoadQueue::load()
+class CI_API ImageLoadRequest : public std::enable_shared_from_this<ImageLoadRequest>, private Noncopyable {
+  public:
+	enum State { QUEUED, DECODING, DONE, FAILED, CANCELLED };
+
+	//! Returns the DataSource being decoded.
+	const DataSourceRef&	getDataSource() const		{ return mDataSource; }
+	//! Returns the current State of the request.
+	State		getState() const;
+	//! Returns whether the request has finished, either successfully, with an exception or by being cancelled.
+	bool		isFinished() const;
+
+	//! Returns the priority of the request. Queued requests with higher priorities are decoded first.
+	int32_t		getPriority() const;
+	//! Sets the priority of the request. Has no effect once decoding has started.
+	void		setPriority( int32_t priority );
+	//! Cancels the request if decoding hasn't started yet. Returns whether it was cancelled. The request's callback is not called for cancelled requests.
+	bool		cancel();
+
+	//! Blocks until the request has finished and returns the decoded Surface. Rethrows the decoding exception, or throws ImageLoadExceptionCancelled.
+	Surface8uRef	getSurface() const					{ return mFuture.get(); }
+	//! Returns a future for the decoded Surface, which holds the decoding exception or an ImageLoadExceptionCancelled on failure.
+	const std::shared_future<Surface8uRef>&	getFuture() const	{ return mFuture; }
+	//! Returns the time in seconds spent creating the ImageSource and decoding it into a Surface, or \c 0 if the request hasn't finished decoding.
+	double		getDecodeSeconds() const;
+
+  private:
+	ImageLoadRequest( const ImageLoadQueueRef &queue, const DataSourceRef &dataSource, int32_t priority, uint64_t sequence );
+
+	std::weak_ptr<ImageLoadQueue>			mQueue;
+	DataSourceRef							mDataSource;
+	std::function<void( const ImageLoadRequestRef& )>	mCallback;
+	std::promise<Surface8uRef>				mPromise;
+	std::shared_future<Surface8uRef>		mFuture;
+
+	// guarded by the queue's mutex
+	State		mState;
+	int32_t		mPriority;
+	uint64_t	mSequence;
+	double		mDecodeSeconds;
+
+	friend class ImageLoadQueue;
+};
+
+//! \brief Decodes images concurrently on a bounded pool of worker threads.
+//!
+//! Each call to load() returns an ImageLoadRequest, which delivers the decoded Surface8u through a future, an optional callback
+//! or both. Queued requests are decoded in order of priority, then in the order they were submitted, and can be cancelled or
+//! reprioritized until a worker picks them up. The time spent decoding is recorded per file extension, see getDecodeStats().
+//!
+//! Callbacks are called on the worker thread that decoded the image, unless Options::deferCallbacks() is enabled, in which case
+//! they are held until the next call to poll(), typically from the app's update(). Exceptions thrown by callbacks are logged and
+//! don't prevent the remaining callbacks from being called.
+//!
+//! \note Callbacks must not hold the last reference to their queue, which would then be destroyed on one of its own workers.
+class CI_API ImageLoadQueue : public std::enable_shared_from_this<ImageLoadQueue>, private Noncopyable {
+  public:
+	typedef std::function<void( const ImageLoadRequestRef &request )>	Callback;
+
+	class CI_API Options {
+	  public:
+		Options() : mNumThreads( 0 ), mDeferCallbacks( false ) {}
+
+		//! Sets the number of worker threads. \c 0 (the default) uses one per hardware thread.
+		Options&	numThreads( size_t numThreads )						{ mNumThreads = numThreads; return *this; }
+		//! Holds callbacks until poll() is called, rather than calling them on the worker threads. Default = false.
+		Options&	deferCallbacks( bool defer = true )					{ mDeferCallbacks = defer; return *this; }
+		//! Sets the ImageSource::Options used to create every ImageSource.
+		Options&	imageSourceOptions( const ImageSource::Options &options )	{ mImageSourceOptions = options; return *this; }
+
+		size_t							getNumThreads() const			{ return mNumThreads; }
+		bool							getDeferCallbacks() const		{ return mDeferCallbacks; }
+		const ImageSource::Options&		getImageSourceOptions() const	{ return mImageSourceOptions; }
+
+	  private:
+		size_t					mNumThreads;
+		bool					mDeferCallbacks;
+		ImageSource::Options	mImageSourceOptions;
+	};
+
+	//! Decoding statistics for a single file extension. \see getDecodeStats()
+	struct DecodeStats {
+		DecodeStats() : mNumDecoded( 0 ), mNumFailed( 0 ), mNumPixels( 0 ), mTotalSeconds( 0 ), mMaxSeconds( 0 ) {}
+
+		//! Returns the average time in seconds spent per image, including failed ones.
+		double	getAverageSeconds() const	{ return ( mNumDecoded + mNumFailed ) ? mTotalSeconds / double( mNumDecoded + mNumFailed ) : 0; }
+
+		size_t		mNumDecoded, mNumFailed;
+		uint64_t	mNumPixels;
+		double		mTotalSeconds, mMaxSeconds;
+	};
+
+	static ImageLoadQueueRef	create( const Options &options = Options() );
+	//! Returns a process-wide ImageLoadQueue with default Options, which is created on first use.
+	static ImageLoadQueueRef	getDefault();
+
+	//! Cancels all queued requests and waits for the ones being decoded to finish.
+	~ImageLoadQueue();
+
+	//! Queues \a dataSource for decoding. The file extension is taken from the DataSource's file path hint, as with loadImage().
+	ImageLoadRequestRef					load( const DataSourceRef &dataSource, int32_t priority = 0, const Callback &callback = Callback() );
+	//! Queues the file at \a path for decoding.
+	ImageLoadRequestRef					load( const fs::path &path, int32_t priority = 0, const Callback &callback = Callback() );
+	//! Queues each of \a dataSources for decoding, returning their requests in the same order.
+	std::vector<ImageLoadRequestRef>	load( const std::vector<DataSourceRef> &dataSources, int32_t priority = 0, const Callback &callback = Callback() );
+
+	//! Cancels every queued request. Requests that are being decoded run to completion.
+	void	cancelAll();
+	//! Blocks until every queued request has finished.
+	void	waitAll();
+	//! Calls the callbacks of requests that finished since the last call. Only needed when Options::deferCallbacks() is enabled.
+	void	poll();
+
+	//! Returns the number of requests waiting for a worker.
+	size_t	getNumQueued() const;
+	//! Returns the number of worker threads.
+	size_t	getNumThreads() const		{ return mThreads.size(); }
+
+	//! Returns decoding statistics keyed by lowercase file extension, without the leading dot.
+	std::map<std::string, DecodeStats>	getDecodeStats() const;
+	//! Clears the statistics returned by getDecodeStats().
+	void								resetDecodeStats();
+
+  private:
+	ImageLoadQueue( const Options &options );
+
+	struct RequestOrder {
+		bool operator()( const ImageLoadRequestRef &a, const ImageLoadRequestRef &b ) const
+		{
+			return a->mPriority != b->mPriority ? a->mPriority > b->mPriority : a->mSequence < b->mSequence;
+		}
+	};
+
+	void	start();
+	void	threadFn();
+	void	decode( const ImageLoadRequestRef &request );
+	void	finish( const ImageLoadRequestRef &request );
+
+	// Must be called with mMutex held.
+	bool	cancelLocked( const ImageLoadRequestRef &request );
+
+	Options											mOptions;
+	std::vector<std::thread>						mThreads;
+
+	mutable std::mutex								mMutex;
+	std::condition_variable							mRequestCondition, mFinishedCondition;
+	std::set<ImageLoadRequestRef, RequestOrder>		mQueued;
+	size_t											mNumDecoding;
+	uint64_t										mNextSequence;
+	bool											mStopping;
+	std::map<std::string, DecodeStats>				mDecodeStats;
+
+	std::mutex										mDeferredMutex;
+	std::vector<ImageLoadRequestRef>				mDeferred;
+
+	friend class ImageLoadRequest;
+};
+
+//! Thrown from ImageLoadRequest::getSurface() and its future when the request was cancelled.
+class CI_API ImageLoadExceptionCancelled : public ImageIoException {
+  public:
+	ImageLoadExceptionCancelled() : ImageIoException( "Image load request was cancelled." ) {}
+};
+
+//! Decodes \a dataSources concurrently on ImageLoadQueue::getDefault(), returning a future for each in the same order.
+CI_API std::vector<std::shared_future<Surface8uRef>>	loadImagesAsync( const std::vector<DataSourceRef> &dataSources, int32_t priority = 0 );
+//! Decodes the files at \a paths concurrently on ImageLoadQueue::getDefault(), returning a future for each in the same order.
+CI_API std::vector<std::shared_future<Surface8uRef>>	loadImagesAsync( const std::vector<fs::path> &paths, int32_t priority = 0 );
+
+} // namespace cinder
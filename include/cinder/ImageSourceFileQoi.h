@@ -33,8 +33,6 @@ typedef std::shared_ptr<class ImageSourceFileQoi>	ImageSourceFileQoiRef;
 
 class ImageSourceFileQoi : public ImageSource {
   public:
-	~ImageSourceFileQoi();
-
 	static ImageSourceRef	create( DataSourceRef dataSourceRef, ImageSource::Options options ) { return ImageSourceFileQoiRef( new ImageSourceFileQoi( dataSourceRef, options ) ); }
 
 	static void		registerSelf();
@@ -44,8 +42,9 @@ class ImageSourceFileQoi : public ImageSource {
   protected:
 	ImageSourceFileQoi( DataSourceRef dataSourceRef, ImageSource::Options options );
 
-	uint8_t		*mData;
-	size_t		mRowBytes;
+	//! The encoded file, which load() decodes a row at a time
+	BufferRef	mEncoded;
+	int32_t		mFullWidth;
 };
 
 } // namespace cinder
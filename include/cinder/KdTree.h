@@ -24,6 +24,9 @@
 
 #include "cinder/Cinder.h"
 #include "cinder/Vector.h"
+#include "cinder/CinderAssert.h"
+#include "cinder/Exception.h"
+#include "cinder/Parallel.h"
 
 #include <vector>
 #include <float.h>
@@ -34,13 +37,16 @@
 namespace cinder {
 
 // KdTree Declarations
+//! A node of a KdTree, which stores a copy of its point so that queries don't have to read the original data. The left child
+//! directly follows its parent, and the subtree of a node spans a contiguous range of nodes.
 template<unsigned char K>
 struct KdNode {
-	void init( float p, uint32_t a) {
-		splitPos = p;
+	void init( uint32_t a, float leftMax, float rightMin ) {
 		splitAxis = a;
 		rightChild = ~0;
 		hasLeftChild = 0;
+		leftSplitMax = leftMax;
+		rightSplitMin = rightMin;
 	}
 	void initLeaf() {
 		splitAxis = K;
@@ -48,43 +54,96 @@ struct KdNode {
 		hasLeftChild = 0;
 	}
 	// KdNode Data
-	float splitPos;
+	float point[K];
+	uint32_t index;
 	uint32_t splitAxis:2;
 	uint32_t hasLeftChild:1;
 	uint32_t rightChild:29;
+	// bounds of the children along splitAxis, which only differ from point[splitAxis] once the tree has been refit
+	float leftSplitMax, rightSplitMin;
 };
 
 struct NullLookupProc {
  public:
-	void process( uint32_t id, float distSqrd, float &maxDistSqrd ) {}
+	void process( uint32_t id, float distSqrd, float &maxDistSqrd ) const {}
 };
 
+//! \brief A K-dimensional tree of points (K <= 3) for nearest neighbor and radius queries.
+//!
+//! The tree copies the points it is built from, so the original data doesn't need to outlive it. Building, refit() and the batch
+//! queries spread their work across up to getMaxThreads() threads. Single queries are thread-safe and write
+//! their results to buffers provided by the caller, so they can be issued from any number of threads without allocating.
+//!
+//! When the points move only a little between frames, refit() updates them in place and keeps the structure of the tree,
+//! which is several times cheaper than building it again. Queries remain exact, but get slower as the points drift away from
+//! where they were when the tree was built, so a tree that is refit every frame should still be rebuilt now and then.
 template <typename NodeData, unsigned char K=3, class LookupProc = NullLookupProc> class KdTree {
 public:
-	typedef std::pair<const NodeData*, uint32_t> NodeDataIndex;
-	
 	// KdTree Public Methods
+	//! Builds the tree from \a data using up to \a maxThreads threads, where \c 0 means one per hardware thread.
 	template<typename NodeDataVector>
-	KdTree( const NodeDataVector &data );
+	KdTree( const NodeDataVector &data, size_t maxThreads = 0 );
 	KdTree() {}
+	//! Builds the tree from \a d, replacing any previous contents. Throws KdTreeExc if \a d has more than 2^29 - 2 points.
 	template<typename NodeDataVector>
 	void initialize( const NodeDataVector &d );
-	~KdTree() {
-		free( nodes );
-		delete[] mNodeData;
-	}
-	void recursiveBuild( uint32_t nodeNum, uint32_t start, uint32_t end, std::vector<NodeDataIndex> &buildNodes );
+	//! Updates the points to those of \a d, which must be the same size as the data the tree was built from, keeping the structure of the tree.
+	template<typename NodeDataVector>
+	void refit( const NodeDataVector &d );
+
+	//! Returns the number of points in the tree.
+	uint32_t	getNumNodes() const		{ return static_cast<uint32_t>( mNodes.size() ); }
+
+	//! Sets the maximum number of threads used by building, refit() and the batch queries, where \c 0 means one per hardware thread. Defaults to \c 0.
+	void		setMaxThreads( size_t maxThreads )	{ mMaxThreads = maxThreads; }
+	//! Returns the maximum number of threads used by building, refit() and the batch queries, where \c 0 means one per hardware thread.
+	size_t		getMaxThreads() const				{ return mMaxThreads; }
+
+	//! Calls \a process.process() for every point closer than \a maxDist to \a p, in no particular order. The process may reduce the search radius through its \c maxDistSqrd argument.
 	void lookup( const NodeData &p, const LookupProc &process, float maxDist ) const;
+	//! Finds the point closest to \a p, writing its coordinates to \a result and its index to \a resultIndex. \a resultIndex is set to \c -1 if the tree is empty or no point has a finite distance to \a p, such as when \a p is NaN or infinite.
 	void findNearest( float p[K], float result[K], uint32_t *resultIndex ) const;
-	
+	//! Finds up to \a k points closest to \a p and within \a maxDist, writing their indices and squared distances to \a resultIndices and \a resultDistancesSquared, nearest first. Both must have room for \a k elements. \return the number of points found.
+	uint32_t findKNearest( const NodeData &p, uint32_t k, uint32_t *resultIndices, float *resultDistancesSquared, float maxDist = FLT_MAX ) const;
+	//! Finds the points within \a radius of \a p, in no particular order. Writes the indices of the first \a maxResults of them to \a resultIndices and, unless it is null, their squared distances to \a resultDistancesSquared.
+	//! \return the number of points within \a radius, which may be more than \a maxResults.
+	uint32_t findWithinRadius( const NodeData &p, float radius, uint32_t *resultIndices, float *resultDistancesSquared, uint32_t maxResults ) const;
+
+	//! Calls findKNearest() for each point in \a queries, in parallel. Results for query \c i are written starting at element <tt>i * k</tt> of \a resultIndices and \a resultDistancesSquared, and its count to \a resultCounts[i].
+	template<typename NodeDataVector>
+	void findKNearest( const NodeDataVector &queries, uint32_t k, uint32_t *resultIndices, float *resultDistancesSquared, uint32_t *resultCounts, float maxDist = FLT_MAX ) const;
+	//! Calls findWithinRadius() for each point in \a queries, in parallel. Results for query \c i are written starting at element <tt>i * maxResults</tt> of \a resultIndices and \a resultDistancesSquared, and its count to \a resultCounts[i].
+	template<typename NodeDataVector>
+	void findWithinRadius( const NodeDataVector &queries, float radius, uint32_t *resultIndices, float *resultDistancesSquared, uint32_t maxResults, uint32_t *resultCounts ) const;
+
 private:
+	struct Bounds {
+		float	mMin[K], mMax[K];
+	};
+	// A subtree which is built or refit as a single task
+	struct Task {
+		uint32_t	mStart, mEnd;
+		Bounds		mBounds;
+	};
+
 	// KdTree Private Methods
-	void privateLookup(uint32_t nodeNum, float p[K], const LookupProc &process, float &maxDistSquared) const;
-	void privateFindNearest( uint32_t nodeNum, float p[K], float &maxDistSquared, float result[K], uint32_t *resultIndex ) const;
+	uint32_t	getTaskSize() const;
+	void		build( uint32_t start, uint32_t end, const Bounds &bounds, uint32_t taskSize, std::vector<Task> *tasks );
+	void		refitBounds( uint32_t nodeNum, uint32_t end, uint32_t taskSize, std::vector<Task> *tasks, size_t *nextTask, Bounds *result );
+	template<typename Fn>
+	void		traverse( uint32_t nodeNum, const float p[K], float &maxDistSquared, Fn &fn ) const;
+	template<typename NodeDataVector>
+	static void	getPoint( const NodeDataVector &d, uint32_t i, float result[K] );
+
 	// KdTree Private Data
-	KdNode<K> *nodes;
-	NodeDataIndex *mNodeData;
-	uint32_t nNodes, nextFreeNode;
+	std::vector<KdNode<K>>	mNodes;
+	size_t					mMaxThreads = 0;
+};
+
+//! Thrown by KdTree::initialize() when it is given more points than a tree can hold.
+class KdTreeExc : public Exception {
+  public:
+	KdTreeExc( const std::string &description ) : Exception( description ) {}
 };
 
 
@@ -132,173 +191,387 @@ struct NodeDataTraits<vec2>
 	}
 };
 
-template<typename NodeData> struct CompareNode {
+template<unsigned char K> struct CompareNode {
 	CompareNode( int a ) { axis = a; }
 	int axis;
-	bool operator()(const std::pair<const NodeData*,uint32_t> &d1,
-			const std::pair<const NodeData*,uint32_t> &d2) const {
-		return NodeDataTraits<NodeData>::getAxis( *d1.first, axis ) == NodeDataTraits<NodeData>::getAxis( *d2.first, axis ) ? ( d1.first < d2.first ) :
-			NodeDataTraits<NodeData>::getAxis( *d1.first, axis ) < NodeDataTraits<NodeData>::getAxis( *d2.first, axis );
+	bool operator()( const KdNode<K> &n1, const KdNode<K> &n2 ) const {
+		return n1.point[axis] == n2.point[axis] ? ( n1.index < n2.index ) : n1.point[axis] < n2.point[axis];
 	}
 };
 
 // KdTree Method Definitions
 template<typename NodeData, unsigned char K, typename LookupProc>
  template<typename NodeDataVector>
-KdTree<NodeData, K, LookupProc>::KdTree(const NodeDataVector &d)
+KdTree<NodeData, K, LookupProc>::KdTree( const NodeDataVector &d, size_t maxThreads )
+	: mMaxThreads( maxThreads )
 {
 	initialize( d );
 }
 
 template<typename NodeData, unsigned char K, typename LookupProc>
  template<typename NodeDataVector>
-void KdTree<NodeData, K, LookupProc>::initialize( const NodeDataVector &d )
+void KdTree<NodeData, K, LookupProc>::getPoint( const NodeDataVector &d, uint32_t i, float result[K] )
 {
-	nNodes = NodeDataVectorTraits<NodeDataVector>::getSize( d );
-	nextFreeNode = 1;
-	nodes = (KdNode<K> *)malloc(nNodes * sizeof(KdNode<K>));
-	mNodeData = new NodeDataIndex[nNodes];
-	std::vector<NodeDataIndex> buildNodes;
-	buildNodes.reserve( nNodes );
-	for( uint32_t i = 0; i < nNodes; ++i )
-		buildNodes.push_back( std::make_pair( &d[i], i ) );
-	// Begin the KdTree building process
-	recursiveBuild( 0, 0, nNodes, buildNodes );
+	for( unsigned char k = 0; k < K; ++k )
+		result[k] = NodeDataTraits<NodeData>::getAxis( d[i], k );
 }
 
 template<typename NodeData, unsigned char K, typename LookupProc>
-void KdTree<NodeData, K, LookupProc>::recursiveBuild( uint32_t nodeNum, uint32_t start, uint32_t end, std::vector<NodeDataIndex> &buildNodes )
+uint32_t KdTree<NodeData, K, LookupProc>::getTaskSize() const
 {
-	// Create leaf node of kd-tree if we've reached the bottom
-	if( start + 1 == end) {
-		nodes[nodeNum].initLeaf();
-		mNodeData[nodeNum] = buildNodes[start];
+	// subtrees smaller than this are built by a single task, enough of them to balance the load across threads
+	const size_t numThreads = getNumParallelThreads( mMaxThreads );
+	if( numThreads <= 1 )
+		return getNumNodes();
+
+	return std::max<uint32_t>( 4096, static_cast<uint32_t>( mNodes.size() / ( numThreads * 8 ) ) );
+}
+
+template<typename NodeData, unsigned char K, typename LookupProc>
+ template<typename NodeDataVector>
+void KdTree<NodeData, K, LookupProc>::initialize( const NodeDataVector &d )
+{
+	const uint32_t numNodes = NodeDataVectorTraits<NodeDataVector>::getSize( d );
+	// nodes are numbered with 29 bits, see KdNode
+	if( numNodes >= ( 1u << 29 ) - 1 )
+		throw KdTreeExc( "KdTree can't hold " + std::to_string( numNodes ) + " points" );
+	mNodes.resize( numNodes );
+	if( ! numNodes )
 		return;
-	}
-	// Choose split direction and partition data
-	// Compute bounds of data from _start_ to _end_
-	float boundMin[K], boundMax[K];
+
+	Bounds bounds;
 	for( unsigned char k = 0; k < K; ++k ) {
-		boundMin[k] = FLT_MAX;
-		boundMax[k] = FLT_MIN;
+		bounds.mMin[k] = FLT_MAX;
+		bounds.mMax[k] = -FLT_MAX;
 	}
-	
-	for( uint32_t i = start; i < end; ++i ) {
-		for( uint8_t axis = 0; axis < K; axis++ ) {
+	for( uint32_t i = 0; i < numNodes; ++i ) {
+		getPoint( d, i, mNodes[i].point );
+		mNodes[i].index = i;
+		for( unsigned char k = 0; k < K; ++k ) {
 			// NOT Compiling? you should define NOMINMAX
-			boundMin[axis] = std::min( boundMin[axis], NodeDataTraits<NodeData>::getAxis( *buildNodes[i].first, axis ) );
-			boundMax[axis] = std::max( boundMax[axis], NodeDataTraits<NodeData>::getAxis( *buildNodes[i].first, axis ) );
+			bounds.mMin[k] = std::min( bounds.mMin[k], mNodes[i].point[k] );
+			bounds.mMax[k] = std::max( bounds.mMax[k], mNodes[i].point[k] );
 		}
 	}
+
+	// build the top of the tree on this thread, then the subtrees below it in parallel
+	const uint32_t taskSize = getTaskSize();
+	std::vector<Task> tasks;
+	build( 0, numNodes, bounds, taskSize, &tasks );
+	parallelFor( 0, static_cast<int32_t>( tasks.size() ), 1, mMaxThreads, [&]( int32_t taskBegin, int32_t taskEnd ) {
+		for( int32_t t = taskBegin; t < taskEnd; ++t )
+			build( tasks[t].mStart, tasks[t].mEnd, tasks[t].mBounds, taskSize, nullptr );
+	} );
+}
+
+template<typename NodeData, unsigned char K, typename LookupProc>
+void KdTree<NodeData, K, LookupProc>::build( uint32_t start, uint32_t end, const Bounds &bounds, uint32_t taskSize, std::vector<Task> *tasks )
+{
+	// Defer the subtree to a task if it's small enough
+	if( tasks && end - start <= taskSize ) {
+		tasks->push_back( { start, end, bounds } );
+		return;
+	}
+	// Create leaf node of kd-tree if we've reached the bottom
+	if( start + 1 == end ) {
+		mNodes[start].initLeaf();
+		return;
+	}
+	// Choose split direction as the longest side of the bounds, which are narrowed at each split rather than computed from the points
 	int splitAxis = 0;
-	float maxExtent = boundMax[0] - boundMin[0];
+	float maxExtent = bounds.mMax[0] - bounds.mMin[0];
 	for( unsigned char k = 1; k < K; ++k ) {
-		if( boundMax[k] - boundMin[k] > maxExtent ) {
+		if( bounds.mMax[k] - bounds.mMin[k] > maxExtent ) {
 			splitAxis = k;
-			maxExtent = boundMax[k] - boundMin[k];
+			maxExtent = bounds.mMax[k] - bounds.mMin[k];
 		}	
 	}
+	// Partition around the median, then move it to the front, so that the left subtree directly follows it
 	uint32_t splitPos = ( start + end ) / 2;
-	std::nth_element( &buildNodes[start], &buildNodes[splitPos], &buildNodes[end-1] + 1, CompareNode<NodeData>(splitAxis) );
-	// Allocate kd-tree node and continue recursively
-	nodes[nodeNum].init( NodeDataTraits<NodeData>::getAxis( *buildNodes[splitPos].first, splitAxis ), splitAxis );
-	mNodeData[nodeNum] = buildNodes[splitPos];
+	std::nth_element( mNodes.begin() + start, mNodes.begin() + splitPos, mNodes.begin() + end, CompareNode<K>( splitAxis ) );
+	std::rotate( mNodes.begin() + start, mNodes.begin() + splitPos, mNodes.begin() + splitPos + 1 );
+
+	KdNode<K> &node = mNodes[start];
+	const float split = node.point[splitAxis];
+	node.init( splitAxis, split, split );
 	if( start < splitPos ) {
-		nodes[nodeNum].hasLeftChild = 1;
-		uint32_t childNum = nextFreeNode++;
-		recursiveBuild( childNum, start, splitPos, buildNodes );
+		node.hasLeftChild = 1;
+		Bounds leftBounds = bounds;
+		leftBounds.mMax[splitAxis] = split;
+		build( start + 1, splitPos + 1, leftBounds, taskSize, tasks );
 	}
 	if( splitPos + 1 < end ) {
-		nodes[nodeNum].rightChild = nextFreeNode++;
-		recursiveBuild( nodes[nodeNum].rightChild, splitPos + 1, end, buildNodes );
+		node.rightChild = splitPos + 1;
+		Bounds rightBounds = bounds;
+		rightBounds.mMin[splitAxis] = split;
+		build( splitPos + 1, end, rightBounds, taskSize, tasks );
 	}
 }
 
 template<typename NodeData, unsigned char K, typename LookupProc>
-void KdTree<NodeData, K, LookupProc>::lookup( const NodeData &p, const LookupProc &proc, float maxDist ) const 
+ template<typename NodeDataVector>
+void KdTree<NodeData, K, LookupProc>::refit( const NodeDataVector &d )
 {
-	float maxDistSqrd = maxDist * maxDist;
-	float pt[K];
-	for( unsigned char k = 0; k < K; ++k )
-		pt[k] = NodeDataTraits<NodeData>::getAxis( p, k );
+	CI_ASSERT( NodeDataVectorTraits<NodeDataVector>::getSize( d ) == getNumNodes() );
+	if( mNodes.empty() )
+		return;
+
+	parallelFor( 0, static_cast<int32_t>( mNodes.size() ), 16384, mMaxThreads, [&]( int32_t taskBegin, int32_t taskEnd ) {
+		for( int32_t i = taskBegin; i < taskEnd; ++i )
+			getPoint( d, mNodes[i].index, mNodes[i].point );
+	} );
+
+	// the subtrees below the top of the tree are refit in parallel first, then the top on this thread using their bounds
+	const uint32_t taskSize = getTaskSize();
+	std::vector<Task> tasks;
+	refitBounds( 0, getNumNodes(), taskSize, &tasks, nullptr, nullptr );
+
+	parallelFor( 0, static_cast<int32_t>( tasks.size() ), 1, mMaxThreads, [&]( int32_t taskBegin, int32_t taskEnd ) {
+		for( int32_t t = taskBegin; t < taskEnd; ++t )
+			refitBounds( tasks[t].mStart, tasks[t].mEnd, taskSize, nullptr, nullptr, &tasks[t].mBounds );
+	} );
 
-	privateLookup( 0, pt, proc, maxDistSqrd );
+	size_t nextTask = 0;
+	Bounds bounds;
+	refitBounds( 0, getNumNodes(), taskSize, &tasks, &nextTask, &bounds );
 }
 
+// Computes the bounds of the subtree at nodeNum, which ends at end, updating the split bounds of its nodes. When tasks is given, subtrees
+// no larger than taskSize are either appended to it (nextTask is null) or have their bounds taken from the next task (nextTask isn't null).
 template<typename NodeData, unsigned char K, typename LookupProc>
-void KdTree<NodeData, K, LookupProc>::privateLookup( uint32_t nodeNum, float p[K], const LookupProc &process, float &maxDistSquared ) const 
+void KdTree<NodeData, K, LookupProc>::refitBounds( uint32_t nodeNum, uint32_t end, uint32_t taskSize, std::vector<Task> *tasks, size_t *nextTask, Bounds *result )
 {
-	KdNode<K> *node = &nodes[nodeNum];
-	// process kd-tree node's children
-	int axis = node->splitAxis;
-	if( axis != K ) {
-		float dist2 = ( p[axis] - node->splitPos ) * ( p[axis] - node->splitPos );
-		if( p[axis] <= node->splitPos ) {
-			if(node->hasLeftChild)
-				privateLookup( nodeNum + 1, p, process, maxDistSquared );
-			if( ( dist2 < maxDistSquared ) && ( node->rightChild < nNodes ) )
-				privateLookup( node->rightChild, p, process, maxDistSquared );
+	if( tasks && end - nodeNum <= taskSize ) {
+		if( nextTask )
+			*result = (*tasks)[(*nextTask)++].mBounds;
+		else
+			tasks->push_back( { nodeNum, end, Bounds() } );
+		return;
+	}
+
+	KdNode<K> &node = mNodes[nodeNum];
+	const bool collecting = tasks && ! nextTask;
+	Bounds childBounds;
+	if( ! collecting ) {
+		for( unsigned char k = 0; k < K; ++k )
+			result->mMin[k] = result->mMax[k] = node.point[k];
+	}
+
+	const uint32_t rightChild = node.rightChild;
+	if( node.hasLeftChild ) {
+		refitBounds( nodeNum + 1, ( rightChild < end ) ? rightChild : end, taskSize, tasks, nextTask, &childBounds );
+		if( ! collecting ) {
+			node.leftSplitMax = childBounds.mMax[node.splitAxis];
+			for( unsigned char k = 0; k < K; ++k ) {
+				result->mMin[k] = std::min( result->mMin[k], childBounds.mMin[k] );
+				result->mMax[k] = std::max( result->mMax[k], childBounds.mMax[k] );
+			}
 		}
-		else {
-			if( node->rightChild < nNodes )
-				privateLookup( node->rightChild, p, process, maxDistSquared );
-			if( ( dist2 < maxDistSquared ) && node->hasLeftChild )
-				privateLookup( nodeNum + 1, p, process, maxDistSquared );
+	}
+	if( rightChild < end ) {
+		refitBounds( rightChild, end, taskSize, tasks, nextTask, &childBounds );
+		if( ! collecting ) {
+			node.rightSplitMin = childBounds.mMin[node.splitAxis];
+			for( unsigned char k = 0; k < K; ++k ) {
+				result->mMin[k] = std::min( result->mMin[k], childBounds.mMin[k] );
+				result->mMax[k] = std::max( result->mMax[k], childBounds.mMax[k] );
+			}
 		}
 	}
-	// Hand kd-tree node to processing function
+}
+
+// Calls fn( node, distSqr, maxDistSquared ) for the nodes which may be within maxDistSquared of p, which fn may reduce
+template<typename NodeData, unsigned char K, typename LookupProc>
+ template<typename Fn>
+void KdTree<NodeData, K, LookupProc>::traverse( uint32_t nodeNum, const float p[K], float &maxDistSquared, Fn &fn ) const
+{
+	const KdNode<K> *node = &mNodes[nodeNum];
+	// Hand kd-tree node to processing function first, as it lies on the split and is likely to narrow the search
 	float distSqr = 0.0f;
 	for( unsigned char k = 0; k < K; ++k ) {
-		float v = NodeDataTraits<NodeData>::getAxis( *mNodeData[nodeNum].first, k ) - p[k];
+		float v = node->point[k] - p[k];
 		distSqr += v * v;
 	}
-	
-	if( distSqr < maxDistSquared )
-		process.process( mNodeData[nodeNum].second, distSqr, maxDistSquared );
+	fn( *node, distSqr, maxDistSquared );
+
+	// process kd-tree node's children, nearest first
+	int axis = node->splitAxis;
+	if( axis != K ) {
+		const float leftDist = std::max( 0.0f, p[axis] - node->leftSplitMax );
+		const float rightDist = std::max( 0.0f, node->rightSplitMin - p[axis] );
+		const uint32_t rightChild = node->rightChild;
+		if( leftDist <= rightDist ) {
+			if( node->hasLeftChild )
+				traverse( nodeNum + 1, p, maxDistSquared, fn );
+			if( rightChild < mNodes.size() && rightDist * rightDist <= maxDistSquared )
+				traverse( rightChild, p, maxDistSquared, fn );
+		}
+		else {
+			if( rightChild < mNodes.size() )
+				traverse( rightChild, p, maxDistSquared, fn );
+			if( node->hasLeftChild && leftDist * leftDist <= maxDistSquared )
+				traverse( nodeNum + 1, p, maxDistSquared, fn );
+		}
+	}
+}
+
+template<typename NodeData, unsigned char K, typename LookupProc>
+void KdTree<NodeData, K, LookupProc>::lookup( const NodeData &p, const LookupProc &proc, float maxDist ) const 
+{
+	if( mNodes.empty() )
+		return;
+
+	float maxDistSqrd = maxDist * maxDist;
+	float pt[K];
+	for( unsigned char k = 0; k < K; ++k )
+		pt[k] = NodeDataTraits<NodeData>::getAxis( p, k );
+
+	auto fn = [&proc]( const KdNode<K> &node, float distSqr, float &maxDistSquared ) {
+		if( distSqr < maxDistSquared )
+			proc.process( node.index, distSqr, maxDistSquared );
+	};
+	traverse( 0, pt, maxDistSqrd, fn );
 }
 
 // Find Nearest
 template<typename NodeData, unsigned char K, typename LookupProc>
 void KdTree<NodeData, K, LookupProc>::findNearest( float p[K], float result[K], uint32_t *resultIndex ) const
 {
-	float maxDist = FLT_MAX;
 	*resultIndex = -1;
-	privateFindNearest( 0, p, maxDist, result, resultIndex );
+	if( mNodes.empty() )
+		return;
+
+	float maxDist = FLT_MAX;
+	const KdNode<K> *nearest = nullptr;
+	auto fn = [&nearest]( const KdNode<K> &node, float distSqr, float &maxDistSquared ) {
+		if( distSqr < maxDistSquared ) {
+			maxDistSquared = distSqr;
+			nearest = &node;
+		}
+	};
+	traverse( 0, p, maxDist, fn );
+	if( ! nearest )
+		return;
+
+	for( unsigned char k = 0; k < K; ++k )
+		result[k] = nearest->point[k];
+	*resultIndex = nearest->index;
 }
 
 template<typename NodeData, unsigned char K, typename LookupProc>
-void KdTree<NodeData, K, LookupProc>::privateFindNearest( uint32_t nodeNum, float p[K], float &maxDistSquared, float result[K], uint32_t *resultIndex ) const
+uint32_t KdTree<NodeData, K, LookupProc>::findKNearest( const NodeData &p, uint32_t k, uint32_t *resultIndices, float *resultDistancesSquared, float maxDist ) const
 {
-	KdNode<K> *node = &nodes[nodeNum];
-	// process kd-tree node's children
-	int axis = node->splitAxis;
-	if( axis != K ) {
-		float dist2 = (p[axis] - node->splitPos) * (p[axis] - node->splitPos);
-		if( p[axis] <= node->splitPos ) {
-			if( node->hasLeftChild )
-				privateFindNearest( nodeNum+1, p, maxDistSquared, result, resultIndex );
-			if( ( dist2 < maxDistSquared ) && ( node->rightChild < nNodes) )
-				privateFindNearest( node->rightChild, p, maxDistSquared, result, resultIndex );
+	if( mNodes.empty() || ! k )
+		return 0;
+
+	float pt[K];
+	for( unsigned char i = 0; i < K; ++i )
+		pt[i] = NodeDataTraits<NodeData>::getAxis( p, i );
+
+	// the results form a max-heap on distance while searching, so the farthest one can be replaced, and the search radius shrinks once it's full
+	uint32_t count = 0;
+	auto fn = [&]( const KdNode<K> &node, float distSqr, float &maxDistSquared ) {
+		if( distSqr > maxDistSquared || ( count == k && distSqr == maxDistSquared ) )
+			return;
+
+		uint32_t i;
+		if( count < k ) {
+			// sift up from the end
+			for( i = count++; i > 0 && resultDistancesSquared[( i - 1 ) / 2] < distSqr; i = ( i - 1 ) / 2 ) {
+				resultDistancesSquared[i] = resultDistancesSquared[( i - 1 ) / 2];
+				resultIndices[i] = resultIndices[( i - 1 ) / 2];
+			}
 		}
 		else {
-			if( node->rightChild < nNodes)
-				privateFindNearest(node->rightChild,
-				              p,
-							  maxDistSquared, result, resultIndex );
-			if( dist2 < maxDistSquared && node->hasLeftChild)
-				privateFindNearest(nodeNum+1,
-				              p,
-							  maxDistSquared, result, resultIndex );
+			// replace the farthest and sift down
+			for( i = 0; 2 * i + 1 < count; ) {
+				uint32_t child = 2 * i + 1;
+				if( child + 1 < count && resultDistancesSquared[child + 1] > resultDistancesSquared[child] )
+					++child;
+				if( resultDistancesSquared[child] <= distSqr )
+					break;
+				resultDistancesSquared[i] = resultDistancesSquared[child];
+				resultIndices[i] = resultIndices[child];
+				i = child;
+			}
+		}
+		resultDistancesSquared[i] = distSqr;
+		resultIndices[i] = node.index;
+
+		if( count == k )
+			maxDistSquared = resultDistancesSquared[0];
+	};
+	float maxDistSquared = ( maxDist == FLT_MAX ) ? FLT_MAX : maxDist * maxDist;
+	traverse( 0, pt, maxDistSquared, fn );
+
+	// sort the heap, nearest first
+	for( uint32_t end = count; end > 1; --end ) {
+		std::swap( resultDistancesSquared[0], resultDistancesSquared[end - 1] );
+		std::swap( resultIndices[0], resultIndices[end - 1] );
+		for( uint32_t i = 0; 2 * i + 1 < end - 1; ) {
+			uint32_t child = 2 * i + 1;
+			if( child + 1 < end - 1 && resultDistancesSquared[child + 1] > resultDistancesSquared[child] )
+				++child;
+			if( resultDistancesSquared[child] <= resultDistancesSquared[i] )
+				break;
+			std::swap( resultDistancesSquared[i], resultDistancesSquared[child] );
+			std::swap( resultIndices[i], resultIndices[child] );
+			i = child;
 		}
 	}
-	
-	float distSqr = NodeDataTraits<NodeData>::distanceSquared( *mNodeData[nodeNum].first, p );
-	if( distSqr < maxDistSquared ) {
-		maxDistSquared = distSqr;
-		for( unsigned char k = 0; k < K; ++k )
-			result[k] = NodeDataTraits<NodeData>::getAxis( *mNodeData[nodeNum].first, k );
-		*resultIndex = mNodeData[nodeNum].second;
-	}
+
+	return count;
+}
+
+template<typename NodeData, unsigned char K, typename LookupProc>
+uint32_t KdTree<NodeData, K, LookupProc>::findWithinRadius( const NodeData &p, float radius, uint32_t *resultIndices, float *resultDistancesSquared, uint32_t maxResults ) const
+{
+	if( mNodes.empty() )
+		return 0;
+
+	float pt[K];
+	for( unsigned char k = 0; k < K; ++k )
+		pt[k] = NodeDataTraits<NodeData>::getAxis( p, k );
+
+	uint32_t count = 0;
+	auto fn = [&]( const KdNode<K> &node, float distSqr, float &maxDistSquared ) {
+		if( distSqr > maxDistSquared )
+			return;
+		if( count < maxResults ) {
+			resultIndices[count] = node.index;
+			if( resultDistancesSquared )
+				resultDistancesSquared[count] = distSqr;
+		}
+		++count;
+	};
+	float radiusSquared = radius * radius;
+	traverse( 0, pt, radiusSquared, fn );
+
+	return count;
+}
+
+template<typename NodeData, unsigned char K, typename LookupProc>
+ template<typename NodeDataVector>
+void KdTree<NodeData, K, LookupProc>::findKNearest( const NodeDataVector &queries, uint32_t k, uint32_t *resultIndices, float *resultDistancesSquared, uint32_t *resultCounts, float maxDist ) const
+{
+	const uint32_t numQueries = NodeDataVectorTraits<NodeDataVector>::getSize( queries );
+	parallelFor( 0, static_cast<int32_t>( numQueries ), 256, mMaxThreads, [&]( int32_t taskBegin, int32_t taskEnd ) {
+		for( int32_t i = taskBegin; i < taskEnd; ++i )
+			resultCounts[i] = findKNearest( queries[i], k, resultIndices + size_t( i ) * k, resultDistancesSquared + size_t( i ) * k, maxDist );
+	} );
+}
+
+template<typename NodeData, unsigned char K, typename LookupProc>
+ template<typename NodeDataVector>
+void KdTree<NodeData, K, LookupProc>::findWithinRadius( const NodeDataVector &queries, float radius, uint32_t *resultIndices, float *resultDistancesSquared, uint32_t maxResults, uint32_t *resultCounts ) const
+{
+	const uint32_t numQueries = NodeDataVectorTraits<NodeDataVector>::getSize( queries );
+	parallelFor( 0, static_cast<int32_t>( numQueries ), 256, mMaxThreads, [&]( int32_t taskBegin, int32_t taskEnd ) {
+		for( int32_t i = taskBegin; i < taskEnd; ++i ) {
+			float *distances = resultDistancesSquared ? resultDistancesSquared + size_t( i ) * maxResults : nullptr;
+			resultCounts[i] = findWithinRadius( queries[i], radius, resultIndices + size_t( i ) * maxResults, distances, maxResults );
+		}
+	} );
 }
 
 } // namespace ci
@@ -35,6 +35,8 @@
 #include <vector>
 #include <memory>
 #include <mutex>
+#include <atomic>
+#include <chrono>
 #include <functional>
 
 // CI_MIN_LOG_LEVEL is designed so that if you set it to 7 : nothing logs, 6 : only fatal, 5 : fatal + error, ..., 1 : everything
@@ -80,6 +82,8 @@ struct CI_API Metadata {
 
 	Level		mLevel;
 	Location	mLocation;
+	//! The time the entry was logged, set when the Entry is created. Timestamps use the time it is written when this is left at the epoch.
+	std::chrono::system_clock::time_point	mTime;
 };
 
 CI_API extern std::ostream& operator<<( std::ostream &os, const Location &rhs );
@@ -93,6 +97,8 @@ class CI_API Logger : private Noncopyable {
 	virtual ~Logger()	{}
 
 	virtual void write( const Metadata &meta, const std::string &text ) = 0;
+	//! Called after a batch of write() calls when the LogManager is logging asynchronously. Loggers that buffer their output should flush it here.
+	virtual void flush()	{}
 
 	void setTimestampEnabled( bool enable = true )	{ mTimeStampEnabled = enable; }
 	bool isTimestampEnabled() const					{ return mTimeStampEnabled; }
@@ -101,13 +107,17 @@ class CI_API Logger : private Noncopyable {
 	Level	getLevel() const { return mLevel; }
 
   protected:
-	Logger( Level level = static_cast<Level>( CI_MIN_LOG_LEVEL ) ) : mLevel( level ), mTimeStampEnabled( false ) {}
+	Logger( Level level = static_cast<Level>( CI_MIN_LOG_LEVEL ) ) : mLevel( level ), mTimeStampEnabled( false ), mBatching( false ) {}
 	
+	//! Writes \a meta and \a text as a single line to \a stream. The stream is flushed after each line, unless a batch is being written.
 	void writeDefault( std::ostream &stream, const Metadata &meta, const std::string &text );
 
 	Level	mLevel;
   private:
 	bool	mTimeStampEnabled;
+	bool	mBatching;
+
+	friend class LogManager;
 };
 	
 typedef std::shared_ptr<Logger>	LoggerRef;
@@ -116,6 +126,7 @@ typedef std::shared_ptr<Logger>	LoggerRef;
 class CI_API LoggerConsole : public Logger {
   public:
 	void write( const Metadata &meta, const std::string &text ) override;
+	void flush() override;
 };
 
 //! \brief LoggerFile will write log messages to a specified file.
@@ -130,6 +141,7 @@ class CI_API LoggerFile : public Logger {
 	virtual ~LoggerFile();
 
 	void write( const Metadata &meta, const std::string &text ) override;
+	void flush() override;
 
 	//! Returns the file path targeted by this logger.
 	const fs::path&		getFilePath() const		{ return mFilePath; }
@@ -199,12 +211,50 @@ protected:
 //! \brief LogManager manages a stack of all active Loggers.
 //!
 //! LogManager's default state contains a single LoggerConsole.  LogManager allows for adding and removing Loggers via their pointer values.
+//!
+//! By default every log entry is written to all Loggers on the calling thread, serialized by a single mutex. After enableAsync(),
+//! entries are instead queued in a bounded, lock-free buffer owned by the calling thread and written in batches by a background
+//! writer thread, so that logging from many threads no longer contends on the Loggers or waits on file I/O.
 class CI_API LogManager {
 public:
+	//! Options for enableAsync().
+	class CI_API AsyncOptions {
+	  public:
+		//! Determines what happens when a thread logs faster than the writer thread drains its buffer.
+		enum class Overflow {
+			DROP,	//!< Discards the entry. The number of dropped entries is reported by getNumDropped() and logged as a warning.
+			BLOCK	//!< Waits until the writer thread has made room in the buffer. Entries logged by a Logger while it writes are dropped instead, as waiting would deadlock.
+		};
+
+		AsyncOptions() : mBufferSize( 1024 ), mOverflow( Overflow::BLOCK ), mFlushInterval( 0.05 ), mSyncLevel( LEVEL_ERROR ) {}
+
+		//! Sets the number of entries buffered per logging thread, rounded up to a power of two. Default = 1024.
+		AsyncOptions&	bufferSize( size_t entries )		{ mBufferSize = entries; return *this; }
+		//! Sets the policy for full buffers. Default = Overflow::BLOCK.
+		AsyncOptions&	overflow( Overflow overflow )		{ mOverflow = overflow; return *this; }
+		//! Sets the longest time in seconds that an entry waits in a buffer before the writer thread picks it up. Default = 0.05.
+		AsyncOptions&	flushInterval( double seconds )		{ mFlushInterval = seconds; return *this; }
+		//! Entries at \a level or above are written on the calling thread, after everything queued before them. Default = LEVEL_ERROR.
+		AsyncOptions&	syncLevel( Level level )			{ mSyncLevel = level; return *this; }
+
+		size_t		getBufferSize() const		{ return mBufferSize; }
+		Overflow	getOverflow() const			{ return mOverflow; }
+		double		getFlushInterval() const	{ return mFlushInterval; }
+		Level		getSyncLevel() const		{ return mSyncLevel; }
+
+	  private:
+		size_t		mBufferSize;
+		Overflow	mOverflow;
+		double		mFlushInterval;
+		Level		mSyncLevel;
+	};
+
+	~LogManager();
+
 	// Returns a pointer to the shared instance. To enable logging during shutdown, this instance is leaked at shutdown.
 	static LogManager* instance()	{ return sInstance; }
 	//! Destroys the shared instance. Useful to remove false positives with leak detectors like valgrind.
-	static void destroyInstance()	{ delete sInstance; }
+	static void destroyInstance()	{ delete sInstance; sInstance = nullptr; }
 	//! Restores LogManager to its default state - a single LoggerConsole.
 	void restoreToDefault();
 
@@ -227,7 +277,20 @@ public:
 	void	setLevel( Level level );
 	
 	void write( const Metadata &meta, const std::string &text );
-	
+	//! Writes \a text, which is moved into the writer thread's queue when logging asynchronously.
+	void write( const Metadata &meta, std::string &&text );
+
+	//! Starts writing log entries on a background thread. Calling it again while enabled applies the new \a options, after writing all pending entries.
+	void	enableAsync( const AsyncOptions &options = AsyncOptions() );
+	//! Writes all pending entries, stops the writer thread and returns to writing entries on the calling thread.
+	void	disableAsync();
+	//! Returns whether entries are currently written on a background thread.
+	bool	isAsyncEnabled() const		{ return mAsyncEnabled.load( std::memory_order_acquire ); }
+	//! Blocks until all entries logged before this call have been written. Has no effect unless asynchronous logging is enabled.
+	void	flush();
+	//! Returns the total number of entries discarded because a thread's buffer was full, with AsyncOptions::Overflow::DROP.
+	uint64_t	getNumDropped() const;
+
 	template<typename LoggerT, typename... Args>
 	std::shared_ptr<LoggerT> makeLogger( Args&&... args );
 
@@ -237,9 +300,19 @@ public:
 protected:
 	LogManager();
 
+	class AsyncWriter;
+	struct AsyncEntry;
+
+	bool	writeAsync( const Metadata &meta, std::string &&text );
+	void	writeBatch( const std::vector<AsyncEntry> &entries );
+
 	std::vector<LoggerRef>			mLoggers;
 	
 	mutable std::mutex				mMutex;
+
+	std::unique_ptr<AsyncWriter>	mAsyncWriter;
+	std::atomic<bool>				mAsyncEnabled;
+	std::mutex						mAsyncMutex;
 	
 	static LogManager 				*sInstance;
 };
@@ -0,0 +1,76 @@
+/*
+ Copyright (c) 2026, The Cinder Project
+
+ This code is intended to be used with the Cinder C++ library, http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#pragma once
+
+#include "cinder/Cinder.h"
+#include "cinder/Exception.h"
+#include "cinder/Filesystem.h"
+#include "cinder/Noncopyable.h"
+
+namespace cinder {
+
+typedef std::shared_ptr<class MemoryMappedFile>	MemoryMappedFileRef;
+
+//! \brief Read-only view of an entire file mapped into memory.
+//!
+//! Pages are loaded on demand by the operating system and shared between all processes that map the same file, so large data files can be
+//! accessed without reading them into private memory first. The mapping stays valid for the lifetime of the MemoryMappedFile.
+class CI_API MemoryMappedFile : private Noncopyable {
+  public:
+	//! Maps the file at \a path for reading. Throws MemoryMappedFileExc if the file can't be opened or mapped. When \a copyOnWrite is \c true the
+	//! mapped memory may also be written to, with each modified page becoming a private copy. The file itself is never modified.
+	static MemoryMappedFileRef create( const fs::path &path, bool copyOnWrite = false )	{ return MemoryMappedFileRef( new MemoryMappedFile( path, copyOnWrite ) ); }
+
+	~MemoryMappedFile();
+
+	//! Returns a pointer to the first byte of the file, or nullptr if the file is empty.
+	const void*		getData() const		{ return mData; }
+	//! Returns the size of the file in bytes.
+	size_t			getSize() const		{ return mSize; }
+	//! Returns the path of the mapped file.
+	const fs::path&	getFilePath() const	{ return mFilePath; }
+	//! Returns whether the mapped memory may be written to. \see create()
+	bool			isCopyOnWrite() const	{ return mCopyOnWrite; }
+
+  private:
+	MemoryMappedFile( const fs::path &path, bool copyOnWrite );
+
+	fs::path	mFilePath;
+	const void*	mData;
+	size_t		mSize;
+	bool		mCopyOnWrite;
+#if defined( CINDER_MSW )
+	void*		mFileHandle;
+	void*		mMappingHandle;
+#endif
+};
+
+//! Exception thrown when a file can't be memory mapped.
+class CI_API MemoryMappedFileExc : public Exception {
+  public:
+	MemoryMappedFileExc( const std::string &description ) : Exception( description )	{}
+};
+
+} // namespace cinder
@@ -0,0 +1,160 @@
+/*
+ Copyright (c) 2026, The Cinder Project
+
+ This code is intended to be used with the Cinder C++ library, http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+
+#pragma once
+
+#include "cinder/GeomIo.h"
+#include "cinder/DataSource.h"
+#include "cinder/DataTarget.h"
+#include "cinder/Exception.h"
+
+#include <vector>
+
+namespace cinder {
+
+//! \brief Header of the binary ".cimesh" triangle mesh format.
+//!
+//! The header is followed by a table of mNumAttribs MeshFileAttrib entries, then by the indices and the data of each attribute, every one of
+//! which starts at a multiple of DATA_ALIGNMENT bytes. Values are stored in the byte order of the machine that wrote the file, which is checked
+//! against mByteOrderMark. Uncompressed indices and FLOAT32 attributes are stored as they are laid out in memory, so that a memory mapped file can
+//! be handed to a geom::Target without copying them. \see MeshFile
+struct MeshFileHeader {
+	static const uint32_t	VERSION = 1;
+	//! The alignment of the index and attribute data, which keeps them aligned for SIMD access when the file is mapped.
+	static const uint32_t	DATA_ALIGNMENT = 64;
+
+	enum IndexEncoding : uint32_t {
+		//! Triangle indices as uint32_t's.
+		INDICES_UINT32,
+		//! The difference of each index to the previous one, zigzag encoded as a variable length integer. Indices of meshes whose triangles
+		//! reference nearby vertices, as most meshes optimized for the vertex cache do, take one or two bytes each.
+		INDICES_DELTA_VARINT
+	};
+
+	char		mMagic[8];
+	uint32_t	mByteOrderMark;
+	uint32_t	mVersion;
+	uint64_t	mNumVertices;
+	uint64_t	mNumIndices;
+	uint32_t	mNumAttribs;
+	uint32_t	mIndexEncoding;	// IndexEncoding
+	uint64_t	mIndexOffset;
+	uint64_t	mIndexBytes;
+	uint64_t	mReserved;
+};
+
+//! An entry of the attribute table of a ".cimesh" file, describing where the data of one attribute is stored and how it is encoded.
+struct MeshFileAttrib {
+	enum Encoding : uint32_t {
+		//! mDims floats per vertex.
+		FLOAT32,
+		//! mDims uint16_t's per vertex, each component mapping [0, 65535] linearly to [mMin, mMin + 65535 * mScale].
+		UNORM16,
+		//! Unit vectors with mDims = 3 as two int16_t's per vertex, the octahedral projection of the vector mapped to [-32767, 32767].
+		OCT_SNORM16
+	};
+
+	uint32_t	mAttrib;	// geom::Attrib
+	uint32_t	mDims;		// the number of components after decoding
+	uint32_t	mEncoding;	// Encoding
+	uint32_t	mReserved;
+	uint64_t	mOffset;
+	uint64_t	mBytes;
+	float		mMin[4], mScale[4];
+};
+
+typedef std::shared_ptr<class MeshFile>	MeshFileRef;
+
+//! \brief A triangle mesh stored in a ".cimesh" file, which is a geom::Source.
+//!
+//! Files are memory mapped rather than read, and the indices and FLOAT32 attributes are passed to geom::Target's directly from the mapping,
+//! so loading a mesh into a TriMesh or gl::VboMesh costs little more than the target's own copy. Quantized attributes and compressed indices
+//! are decoded by loadInto(). Any geom::Source can be converted with write(), including ObjLoader:
+//! \code
+//! MeshFile::write( writeFile( "scan.cimesh" ), ObjLoader( loadFile( "scan.obj" ) ), MeshFile::Options().quantizeNormals() );
+//! auto mesh = gl::VboMesh::create( *MeshFile::create( loadFile( "scan.cimesh" ) ) );
+//! \endcode
+class CI_API MeshFile : public geom::Source {
+  public:
+	//! Options for write(). By default, everything is stored uncompressed.
+	class CI_API Options {
+	  public:
+		Options() : mQuantizePositions( false ), mQuantizeNormals( false ), mCompressIndices( false ) {}
+
+		//! Stores positions as UNORM16 within the bounds of the mesh, which halves their size. Each component is off by at most 1 / 131070 of the mesh's extent along its axis.
+		Options&	quantizePositions( bool quantize = true )	{ mQuantizePositions = quantize; return *this; }
+		//! Stores normals, tangents and bitangents as OCT_SNORM16, which takes 4 bytes per vertex instead of 12, with an angular error below 0.005 degrees.
+		Options&	quantizeNormals( bool quantize = true )		{ mQuantizeNormals = quantize; return *this; }
+		//! Stores indices as INDICES_DELTA_VARINT.
+		Options&	compressIndices( bool compress = true )		{ mCompressIndices = compress; return *this; }
+
+		bool	getQuantizePositions() const	{ return mQuantizePositions; }
+		bool	getQuantizeNormals() const		{ return mQuantizeNormals; }
+		bool	getCompressIndices() const		{ return mCompressIndices; }
+
+	  private:
+		bool	mQuantizePositions, mQuantizeNormals, mCompressIndices;
+	};
+
+	//! Opens the ".cimesh" file of \a dataSource, memory mapping it if it's a file. Throws MeshFileExc if it isn't a valid file.
+	static MeshFileRef	create( const DataSourceRef &dataSource )	{ return MeshFileRef( new MeshFile( dataSource ) ); }
+	//! Writes the triangles of \a source to \a dataTarget as a ".cimesh" file. Other primitives are converted to triangles, and non-indexed sources are indexed.
+	static void			write( const DataTargetRef &dataTarget, const geom::Source &source, const Options &options = Options() );
+
+	//! Returns the header of the file.
+	const MeshFileHeader&				getHeader() const		{ return mHeader; }
+	//! Returns the attribute table of the file.
+	const std::vector<MeshFileAttrib>&	getAttribTable() const	{ return mAttribs; }
+	//! Returns the values of \a attr inside the file if they are stored as FLOAT32, otherwise \c nullptr.
+	const float*	getAttribData( geom::Attrib attr ) const;
+	//! Returns the indices inside the file if they are stored as INDICES_UINT32, otherwise \c nullptr. They were checked against getNumVertices() when the file was opened.
+	const uint32_t*	getIndexData() const;
+
+	size_t				getNumVertices() const override		{ return static_cast<size_t>( mHeader.mNumVertices ); }
+	size_t				getNumIndices() const override		{ return static_cast<size_t>( mHeader.mNumIndices ); }
+	geom::Primitive		getPrimitive() const override		{ return geom::Primitive::TRIANGLES; }
+	uint8_t				getAttribDims( geom::Attrib attr ) const override;
+	geom::AttribSet		getAvailableAttribs() const override;
+	void				loadInto( geom::Target *target, const geom::AttribSet &requestedAttribs ) const override;
+	MeshFile*			clone() const override				{ return new MeshFile( *this ); }
+
+  protected:
+	MeshFile( const DataSourceRef &dataSource );
+
+	const MeshFileAttrib*	findAttrib( geom::Attrib attr ) const;
+	const uint8_t*			getData( uint64_t offset ) const	{ return static_cast<const uint8_t*>( mData->getData() ) + offset; }
+
+	BufferRef					mData;
+	MeshFileHeader				mHeader;
+	std::vector<MeshFileAttrib>	mAttribs;
+};
+
+//! Exception thrown when a ".cimesh" file can't be loaded or written.
+class CI_API MeshFileExc : public Exception {
+  public:
+	MeshFileExc( const std::string &description ) : Exception( description )	{}
+};
+
+} // namespace cinder
@@ -0,0 +1,41 @@
+/*
+ Copyright (c) 2026, The Cinder Project
+
+ This code is intended to be used with the Cinder C++ library, http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#pragma once
+
+#include "cinder/Cinder.h"
+
+#include <functional>
+
+namespace cinder {
+
+//! Returns the number of threads used for \a maxThreads, resolving \c 0 to one per hardware thread.
+CI_API size_t	getNumParallelThreads( size_t maxThreads );
+
+//! Calls \a fn( taskBegin, taskEnd ) for consecutive ranges which together cover [\a begin, \a end), using up to \a maxThreads threads including the
+//! calling thread, where \c 0 means one per hardware thread. Ranges are at least \a minItemsPerTask long, other than the last one. Work is handed to a
+//! process-wide thread pool. Returns once all ranges are complete, rethrowing the first exception thrown by \a fn. Calls made from inside \a fn run
+//! sequentially on the calling thread. \see ip::parallelFor(), which takes the number of threads from the ip::ExecutionPolicy.
+CI_API void		parallelFor( int32_t begin, int32_t end, int32_t minItemsPerTask, size_t maxThreads, const std::function<void( int32_t taskBegin, int32_t taskEnd )> &fn );
+
+} // namespace cinder
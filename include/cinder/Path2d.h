@@ -24,10 +24,12 @@
 
 #include "cinder/Vector.h"
 #include "cinder/BSpline.h"
+#include "cinder/Channel.h"
 #include "cinder/Rect.h"
 #include "cinder/Exception.h"
 #include "cinder/Matrix.h"
 
+#include <cfloat>
 #include <vector>
 
 namespace cinder {
@@ -416,6 +418,131 @@ class CI_API Path2dCalcCache {
 	std::vector<float>	mSegmentLengths;
 };
 
+//! \brief Accelerates hit-testing and distance queries on a Path2d or Shape2d, for testing many points against the same geometry.
+//!
+//! The curves are split into pieces that are monotonic in y, which are sorted into horizontal bands for contains(), and the bounding boxes
+//! of the segments are kept in a bounding volume hierarchy for the distance queries. Results are identical to those of the corresponding
+//! Shape2d member functions, while a query only visits the segments near the point. The cache copies the geometry it's built from and is
+//! safe to query from any number of threads. The batch functions spread their work across threads according to ip::getExecutionPolicy().
+class CI_API Path2dQueryCache {
+  public:
+	Path2dQueryCache( const Path2d &path );
+	Path2dQueryCache( const Shape2d &shape );
+
+	//! Returns the bounding box around all control points.
+	const Rectf&	getBounds() const { return mBounds; }
+
+	//! Returns whether the point \a pt is contained within the boundaries of the geometry. If \a evenOddFill is \c true (the default) then Even-Odd fill rule is used, otherwise, the Winding fill rule is applied.
+	bool	contains( const vec2 &pt, bool evenOddFill = true ) const;
+	//! Calls contains() for each of the \a numPoints \a points, writing the results to \a results, which must have room for \a numPoints elements.
+	void	containsMany( const vec2 *points, size_t numPoints, bool *results, bool evenOddFill = true ) const;
+
+	//! Returns the minimum distance from point \a pt to the geometry, or \c FLT_MAX if it has no segments.
+	float	calcDistance( const vec2 &pt ) const;
+	//! Returns the minimum distance from the geometry to point \a pt. For points inside the geometry, the distance is negative.
+	float	calcSignedDistance( const vec2 &pt, bool evenOddFill = true ) const;
+	//! Returns the point on the geometry closest to point \a pt.
+	vec2	calcClosestPoint( const vec2 &pt ) const;
+
+	//! Fills \a result with the signed distance to the geometry at the center of each of its pixels, with the channel spanning \a bounds.
+	//! Distances are clamped to [-\a maxDistance, \a maxDistance], and a smaller \a maxDistance makes the calculation considerably faster.
+	void	calcSignedDistanceField( Channel32f *result, const Rectf &bounds, float maxDistance = FLT_MAX, bool evenOddFill = true ) const;
+
+  private:
+	struct MonotonePiece {
+		vec2				mPoints[4];
+		Path2d::SegmentType	mType;
+		float				mMinY, mMaxY;
+	};
+
+	struct Segment {
+		vec2				mPoints[4];
+		Path2d::SegmentType	mType;
+		uint32_t			mOrder;
+		vec2				mMin, mMax;
+	};
+
+	//! A node of the bounding volume hierarchy. Leaves have a non-zero mCount, the children of other nodes are the next node and mFirst.
+	struct Node {
+		vec2		mMin, mMax;
+		uint32_t	mFirst, mCount;
+	};
+
+	void		addContour( const Path2d &path );
+	void		build();
+	uint32_t	buildNode( uint32_t first, uint32_t last );
+	int			getBand( float y ) const;
+	//! Finds the closest point within \a maxDistanceSquared of \a pt. \return \c false if there is none.
+	bool		findClosest( const vec2 &pt, float maxDistanceSquared, vec2 *result, float *resultDistanceSquared ) const;
+
+	Rectf						mBounds;
+	std::vector<MonotonePiece>	mPieces;
+	float						mMinY, mMaxY, mInvBandHeight;
+	int							mNumBands;
+	std::vector<uint32_t>		mBandOffsets, mBandPieces;
+	std::vector<Segment>		mSegments;
+	std::vector<Node>			mNodes;
+};
+
+//! \brief Triangulates strokes directly into vertex and index buffers, as a faster alternative to passing the result of Path2d::calcStroke() to a Triangulator.
+//!
+//! Curves are flattened to within the tolerance and each segment, join and cap is emitted as its own triangles, so the triangles overlap
+//! where the stroke does. Draw the mesh opaque, or with a stencil or depth test that keeps pixels from being blended twice. Strokes are appended
+//! to the buffers and clear() keeps their capacity, so a StrokeMesh2d which is reused every frame stops allocating once it has grown to fit.
+//! Dash patterns are measured along the flattened path. Contours are stroked in single precision when their coordinates are small enough
+//! relative to the tolerance for the result to be the same, and in double precision otherwise, see setPrecision().
+class CI_API StrokeMesh2d {
+  public:
+	enum class Precision { AUTO, FLOAT, DOUBLE };
+
+	StrokeMesh2d() : mPrecision( Precision::AUTO ) {}
+
+	//! Appends the triangles of \a path stroked with \a style. \a tolerance is the maximum distance between the triangles and the exact outline.
+	void	appendStroke( const Path2d &path, const StrokeStyle &style, float tolerance = 0.25f );
+	//! Appends the triangles of each contour of \a shape stroked with \a style. \a tolerance is the maximum distance between the triangles and the exact outline.
+	void	appendStroke( const Shape2d &shape, const StrokeStyle &style, float tolerance = 0.25f );
+
+	//! Replaces the contents of each of the \a count \a results with the stroke of the corresponding path in \a paths, using the style at the same index of \a styles.
+	//! The paths are spread across threads according to ip::getExecutionPolicy().
+	static void	calcStrokes( const Path2d *paths, const StrokeStyle *styles, size_t count, StrokeMesh2d *results, float tolerance = 0.25f );
+	//! Replaces the contents of each of the \a count \a results with the stroke of the corresponding shape in \a shapes, using the style at the same index of \a styles.
+	//! The shapes are spread across threads according to ip::getExecutionPolicy().
+	static void	calcStrokes( const Shape2d *shapes, const StrokeStyle *styles, size_t count, StrokeMesh2d *results, float tolerance = 0.25f );
+
+	//! Removes all vertices and indices while keeping the memory allocated for them.
+	void	clear() { mPositions.clear(); mIndices.clear(); }
+	bool	empty() const { return mIndices.empty(); }
+
+	const std::vector<vec2>&		getPositions() const { return mPositions; }
+	const std::vector<uint32_t>&	getIndices() const { return mIndices; }
+	size_t							getNumVertices() const { return mPositions.size(); }
+	size_t							getNumTriangles() const { return mIndices.size() / 3; }
+
+	//! Sets whether contours are flattened and offset in single or double precision. The default, Precision::AUTO, uses single precision for contours whose coordinates are below 65536 times the tolerance.
+	void		setPrecision( Precision precision ) { mPrecision = precision; }
+	Precision	getPrecision() const { return mPrecision; }
+
+  private:
+	//! A flattened contour. mCorners marks the points which joined two segments of the Path2d, as opposed to the points sampled from a curve.
+	template<typename T>
+	struct Polyline {
+		std::vector<glm::tvec2<T>>	mPoints;
+		std::vector<uint8_t>		mCorners;
+	};
+
+	void	appendContour( const Path2d &path, const StrokeStyle &style, float tolerance );
+	template<typename T>
+	void	appendContour( const Path2d &path, const StrokeStyle &style, T tolerance, Polyline<T> *contour, Polyline<T> *dash, std::vector<T> *dashPattern );
+
+	Precision				mPrecision;
+	std::vector<vec2>		mPositions;
+	std::vector<uint32_t>	mIndices;
+	Polyline<float>			mContourF, mDashF;
+	Polyline<double>		mContourD, mDashD;
+	std::vector<float>		mDashPatternF;
+	std::vector<double>		mDashPatternD;
+};
+
 class CI_API Path2dExc : public Exception {
 };
 
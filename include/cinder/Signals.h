@@ -30,9 +30,13 @@
 #include "cinder/Noncopyable.h"
 #include "cinder/Export.h"
 
+#include <algorithm>
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <map>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 namespace cinder { namespace signals {
@@ -74,41 +78,53 @@ struct SignalLinkBase {
 
 	void enable()
 	{
-		mEnabled = true;
+		mEnabled.store( true, std::memory_order_relaxed );
 	}
 
 	void disable()
 	{
-		mEnabled = false;
+		mEnabled.store( false, std::memory_order_relaxed );
 	}
 
 	bool isEnabled() const
 	{
-		return mEnabled;
+		return mEnabled.load( std::memory_order_relaxed );
 	}
 
   private:
-	int		mRefCount;
-	bool	mEnabled;
+	int					mRefCount;
+	std::atomic<bool>	mEnabled; // atomic so that ThreadSafeSignal connections can be toggled from any thread
+};
+
+//! Whatever a signal gave up in a disconnection, released by calling mFn with mData once the Disconnector has unlocked.
+struct DeferredRelease {
+	void	(*mFn)( void *data ) = nullptr;
+	void	*mData = nullptr;
 };
 
 //! Base Signal class, which provides a concrete type that can be stored by the Disconnector
 struct SignalBase : private Noncopyable {
 	//! abstract method to disconnect \a link from the callback chain, which resides in the priority group \a priority.
 	virtual bool disconnect( SignalLinkBase *link, int priority ) = 0;
+	//! Disconnects \a link like disconnect(), but leaves releasing the callbacks given up to \a deferred, as their destructors may disconnect from other signals.
+	virtual bool disconnectDeferred( SignalLinkBase *link, int priority, DeferredRelease * /*deferred*/ ) { return disconnect( link, priority ); }
 
 	friend struct Disconnector;
 };
 
 //! Helper class for disconnecting Connections.
 struct CI_API Disconnector : private Noncopyable {
-	//! Constructs a new Disconnector, which is owned by \a signal.
-	Disconnector( SignalBase *signal );
+	//! Constructs a new Disconnector, which is owned by \a signal. If \a threadSafe is true, disconnect() may be called on any thread, including while the signal is destroyed.
+	Disconnector( SignalBase *signal, bool threadSafe = false );
 	//! Instructs the owning signal to disconnect \a link, which resides within priority group \a priority.
 	bool disconnect( SignalLinkBase *link, int priority );
+	//! Called by the owning signal when it is destroyed, after which disconnect() does nothing. Waits for disconnections in progress on other threads.
+	void detach();
 
   private:
-	SignalBase*	mSignal;
+	SignalBase*		mSignal;
+	const bool		mThreadSafe;
+	std::mutex		mMutex; // only used when mThreadSafe, and never held while callbacks are destroyed
 };
 
 } // namespace detail
@@ -422,6 +438,229 @@ class SignalProto<R ( Args... ), Collector> : private CollectorInvocation<Collec
 	std::shared_ptr<Disconnector>					mDisconnector;	// Connection holds a weak_ptr to this to make disconnections.
 };
 
+// ----------------------------------------------------------------------------------------------------
+// ThreadSafeSignalProto
+// ----------------------------------------------------------------------------------------------------
+
+//! The template implementation of ThreadSafeSignal.
+template<typename, typename> class	ThreadSafeSignalProto;   // undefined
+
+//! ThreadSafeSignalProto template, the parent class of ThreadSafeSignal, specialised for the callback signature and collector.
+//!
+//! Slots are kept in an immutable array sorted by priority. connect() and disconnect() copy the current array, modify the copy and
+//! publish it, while emit() only takes a reference to whichever array is current and iterates it without locking. An array that is
+//! replaced stays alive until the last emission using it is done, along with the slots that were removed from it.
+template<class Collector, class R, class... Args>
+class ThreadSafeSignalProto<R ( Args... ), Collector> : private CollectorInvocation<Collector, R ( Args... )> {
+  protected:
+	typedef std::function<R ( Args... )>		CallbackFn;
+	typedef typename CallbackFn::result_type	Result;
+	typedef typename Collector::CollectorResult	CollectorResult;
+
+  public:
+	//! Constructs an empty ThreadSafeSignalProto
+	ThreadSafeSignalProto()
+		: mDisconnector( new Disconnector( this, true ) ), mSlots( new SlotArray ), mAcquirePhase( 0 )
+	{}
+
+	//! Destructor releases all resources associated with this signal. Connections may still be disconnected on other threads while it runs, but no emissions may be in progress.
+	~ThreadSafeSignalProto()
+	{
+		mDisconnector->detach();
+
+		SlotArray *slots = mSlots.load();
+		slots->mRetired.swap( slots->mSlots );
+		release( slots );
+	}
+
+	//! Connects \a callback to the signal, assigned to the default priority group (priority = 0). Can be called from any thread. \return a Connection, which can be used to disconnect this callback slot.
+	Connection connect( const CallbackFn &callback )
+	{
+		return connect( 0, callback );
+	}
+
+	//! Connects \a callback to the signal, assigned to the priority group \a priority. Can be called from any thread. \return a Connection, which can be used to disconnect this callback slot.
+	Connection connect( int priority, const CallbackFn &callback )
+	{
+		Slot *slot = new Slot( callback, priority );
+		SlotArray *previous;
+		{
+			std::lock_guard<std::mutex> lock( mMutex );
+			const auto &current = mSlots.load()->mSlots;
+
+			// after all slots of the same or a higher priority, so that slots within a group are called first in first out
+			auto pos = std::find_if( current.begin(), current.end(), [priority]( const Slot *other ) { return other->mPriority < priority; } );
+			SlotArray *next = new SlotArray;
+			next->mSlots.reserve( current.size() + 1 );
+			next->mSlots.insert( next->mSlots.end(), current.begin(), pos );
+			next->mSlots.push_back( slot );
+			next->mSlots.insert( next->mSlots.end(), pos, current.end() );
+			previous = publish( next );
+		}
+		release( previous );
+
+		return Connection( mDisconnector, slot, priority );
+	}
+
+	//! Emit a signal, i.e. invoke all its callbacks and collect return types with Collector. Can be called from several threads at once. \return the CollectorResult from the collector.
+	CollectorResult	emit( Args... args )
+	{
+		Collector collector;
+		emit( collector, args... );
+		return collector.getResult();
+	}
+
+	//! Emit a signal, i.e. invoke all its callbacks and collect return types with \a collector. Can be called from several threads at once.
+	//! Slots connected during the emission aren't called by it. Slots disconnected during the emission are skipped, unless their callback had already been started.
+	void emit( Collector &collector, Args... args )
+	{
+		ScopedSlotArray slots( this );
+		for( Slot *slot : slots->mSlots ) {
+			if( slot->mConnected.load( std::memory_order_relaxed ) && slot->isEnabled() ) {
+				if( ! this->invoke( collector, slot->mCallbackFn, args... ) )
+					break;
+			}
+		}
+	}
+
+	//! Returns the number of connected slots.
+	size_t getNumSlots() const
+	{
+		ScopedSlotArray slots( this );
+		return slots->mSlots.size();
+	}
+
+  private:
+	struct Slot : public SignalLinkBase {
+		Slot( const CallbackFn &callback, int priority )
+			: mCallbackFn( callback ), mPriority( priority ), mConnected( true )
+		{}
+
+		// slots are only ever removed by the signal
+		bool removeSibling( SignalLinkBase * /*sibling*/ ) override	{ return false; }
+
+		const CallbackFn	mCallbackFn;
+		const int			mPriority;
+		std::atomic<bool>	mConnected;
+	};
+
+	//! An immutable, reference counted array of slots. Each array holds a reference to the one that replaced it, so that an array and
+	//! the slots retired along with it are destroyed only once all older arrays are gone, as those may still point to the same slots.
+	struct SlotArray {
+		SlotArray()
+			: mRefCount( 1 ), mNext( nullptr )
+		{}
+
+		~SlotArray()
+		{
+			for( Slot *slot : mRetired )
+				slot->decrRef();
+		}
+
+		std::vector<Slot*>	mSlots;
+		std::vector<Slot*>	mRetired;	// slots removed by the array that replaced this one, owned by this array
+		std::atomic<int>	mRefCount;
+		SlotArray*			mNext;
+	};
+
+	//! Holds a reference to the current SlotArray for the duration of a scope.
+	class ScopedSlotArray : private Noncopyable {
+	  public:
+		ScopedSlotArray( const ThreadSafeSignalProto *signal )
+			: mSlots( signal->acquire() )
+		{}
+		~ScopedSlotArray()								{ release( mSlots ); }
+
+		const SlotArray* operator->() const				{ return mSlots; }
+
+	  private:
+		SlotArray*	mSlots;
+	};
+
+	//! Returns the current SlotArray with its reference count incremented. Lock-free; the array can't be released between the load and
+	//! the increment, as publish() waits for the threads counted in mNumAcquiring before releasing the array it has replaced.
+	SlotArray* acquire() const
+	{
+		const int phase = mAcquirePhase.load();
+		mNumAcquiring[phase]++;
+		SlotArray *result = mSlots.load();
+		result->mRefCount.fetch_add( 1, std::memory_order_relaxed );
+		mNumAcquiring[phase]--;
+
+		return result;
+	}
+
+	static void release( SlotArray *slots )
+	{
+		while( slots && slots->mRefCount.fetch_sub( 1, std::memory_order_acq_rel ) == 1 ) {
+			SlotArray *next = slots->mNext;
+			delete slots;
+			slots = next;
+		}
+	}
+
+	//! Replaces the current SlotArray with \a next. Must be called with mMutex locked. \return the replaced array, which the caller
+	//! releases after unlocking mMutex, since that may destroy callbacks that in turn disconnect other slots.
+	SlotArray* publish( SlotArray *next )
+	{
+		SlotArray *previous = mSlots.load();
+		previous->mNext = next;
+		next->mRefCount.fetch_add( 1, std::memory_order_relaxed );
+
+		mSlots.store( next );
+
+		// Threads that start acquiring after a flip count themselves in the other phase, so each wait only covers those already
+		// acquiring and can't be prolonged by new ones. Both phases are waited for, as a thread may have read the phase before the
+		// previous publish() flipped it.
+		for( int i = 0; i < 2; i++ ) {
+			const int phase = mAcquirePhase.load();
+			mAcquirePhase.store( phase ^ 1 );
+			while( mNumAcquiring[phase].load() )
+				std::this_thread::yield();
+		}
+
+		return previous;
+	}
+
+	bool disconnect( SignalLinkBase *link, int priority ) override
+	{
+		DeferredRelease deferred;
+		bool result = disconnectDeferred( link, priority, &deferred );
+		if( deferred.mFn )
+			deferred.mFn( deferred.mData );
+
+		return result;
+	}
+
+	bool disconnectDeferred( SignalLinkBase *link, int /*priority*/, DeferredRelease *deferred ) override
+	{
+		std::lock_guard<std::mutex> lock( mMutex );
+		SlotArray *current = mSlots.load();
+
+		auto it = std::find( current->mSlots.begin(), current->mSlots.end(), link );
+		if( it == current->mSlots.end() )
+			return false;
+
+		( *it )->mConnected.store( false, std::memory_order_relaxed );
+		current->mRetired.push_back( *it );
+
+		SlotArray *next = new SlotArray;
+		next->mSlots.reserve( current->mSlots.size() - 1 );
+		next->mSlots.insert( next->mSlots.end(), current->mSlots.begin(), it );
+		next->mSlots.insert( next->mSlots.end(), it + 1, current->mSlots.end() );
+
+		deferred->mFn = []( void *slots ) { release( static_cast<SlotArray*>( slots ) ); };
+		deferred->mData = publish( next );
+		return true;
+	}
+
+	std::shared_ptr<Disconnector>	mDisconnector;	// Connection holds a weak_ptr to this to make disconnections.
+	std::atomic<SlotArray*>			mSlots;			// the current slots, sorted by descending priority
+	mutable std::atomic<int>		mNumAcquiring[2] = { { 0 }, { 0 } };	// number of threads between loading mSlots and incrementing its reference count, by phase
+	std::atomic<int>				mAcquirePhase;	// which of mNumAcquiring threads that start acquiring count themselves in, flipped by publish()
+	std::mutex						mMutex;			// serializes connect() and disconnect()
+};
+
 } // cinder::detail
 
 // namespace cinder
@@ -462,6 +701,28 @@ struct Signal : detail::SignalProto<Signature, Collector> {
 	typedef typename SignalProto::CallbackFn			CallbackFn;
 };
 
+// ----------------------------------------------------------------------------------------------------
+// ThreadSafeSignal
+// ----------------------------------------------------------------------------------------------------
+
+//! \brief ThreadSafeSignal is a Signal that can be emitted, connected to and disconnected from on any number of threads at once.
+//!
+//! The interface, priority groups, collectors and Connection handling are the same as Signal's. Slots are stored in a contiguous
+//! array that is copied and replaced whenever a slot is connected or disconnected, so emit() never blocks and iterates the slots
+//! without following links or touching per-slot reference counts. This makes emissions to many slots cheaper than with Signal,
+//! at the cost of a few atomic operations per emission, and connect() and disconnect() taking time proportional to the number of slots.
+//!
+//! A slot that is disconnected while emissions are in progress on other threads may still be running, or be about to be called by
+//! them, when disconnect() returns. The signal itself must not be destroyed while it is being emitted.
+//!
+//! \note ThreadSafeSignals are non-copyable.
+template <typename Signature, class Collector = detail::CollectorDefault<typename std::function<Signature>::result_type> >
+struct ThreadSafeSignal : detail::ThreadSafeSignalProto<Signature, Collector> {
+
+	typedef detail::ThreadSafeSignalProto<Signature, Collector>	SignalProto;
+	typedef typename SignalProto::CallbackFn					CallbackFn;
+};
+
 // ----------------------------------------------------------------------------------------------------
 // slot
 // ----------------------------------------------------------------------------------------------------
@@ -112,6 +112,8 @@ class CI_API SurfaceT {
 	SurfaceT( int32_t width, int32_t height, bool alpha, const SurfaceConstraints &constraints );
 	//! Constructs a surface from the memory pointed to by \a data. Does not assume ownership of the memory in \a data, which consequently should not be freed while the Surface is still in use.
 	SurfaceT( T *data, int32_t width, int32_t height, ptrdiff_t rowBytes, SurfaceChannelOrder channelOrder );
+	//! Constructs a surface from the memory pointed to by \a dataStore, sharing ownership of it. An aliasing \c shared_ptr allows the memory to be kept alive by another object, such as a MemoryMappedFile.
+	SurfaceT( const std::shared_ptr<T> &dataStore, int32_t width, int32_t height, ptrdiff_t rowBytes, SurfaceChannelOrder channelOrder );
 	//! Constructs a Surface from an \a imageSource and optional \a constraints. Includes alpha channel if one is present in the ImageSource.
 	SurfaceT( ImageSourceRef imageSource, const SurfaceConstraints &constraints = SurfaceConstraintsDefault() );
 	//! Constructs a Surface from an \a imageSource and optional \a constraints. Includes alpha channel based on \a alpha.
@@ -134,6 +136,10 @@ class CI_API SurfaceT {
 	static std::shared_ptr<SurfaceT<T>>	create( T *data, int32_t width, int32_t height, ptrdiff_t rowBytes, SurfaceChannelOrder channelOrder )
 	{ return std::make_shared<SurfaceT<T>>( data, width, height, rowBytes, channelOrder ); }
 
+	//! Creates a SurfaceRef from the memory pointed to by \a dataStore, sharing ownership of it.
+	static std::shared_ptr<SurfaceT<T>>	create( const std::shared_ptr<T> &dataStore, int32_t width, int32_t height, ptrdiff_t rowBytes, SurfaceChannelOrder channelOrder )
+	{ return std::make_shared<SurfaceT<T>>( dataStore, width, height, rowBytes, channelOrder ); }
+
 	//! Creates a SurfaceRef from an \a imageSource and optional \a constraints. Includes alpha channel if one is present in the ImageSource.
 	static std::shared_ptr<SurfaceT<T>>	create( ImageSourceRef imageSource, const SurfaceConstraints &constraints = SurfaceConstraintsDefault() )
 	{ return std::make_shared<SurfaceT<T>>( imageSource, constraints ); }
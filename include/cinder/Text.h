@@ -31,7 +31,15 @@
 #include <vector>
 #include <deque>
 #include <string>
-#include <map> 
+#include <map>
+
+#if defined( CINDER_ANDROID ) || defined( CINDER_LINUX )
+	#include "cinder/Noncopyable.h"
+
+	#include <list>
+	#include <mutex>
+	#include <unordered_map>
+#endif
 
 // Core Text forward declarations
 #if defined( CINDER_COCOA )
@@ -174,6 +182,147 @@ class CI_API TextBox {
 Surface renderStringPow2( const std::string &str, const Font &font, const ColorA &color, ivec2 *actualSize, float *baselineOffset = 0 );
 #else
 Surface renderString( const std::string &str, const Font &font, const ColorA &color, float *baselineOffset = 0 );
+
+//! Renders each of the \a count strings of \a strs like renderString(), replacing the corresponding element of \a results and of \a baselineOffsets unless it's null.
+//! With FreeType (Android and Linux) the strings are spread across threads according to ip::getExecutionPolicy(), elsewhere they are rendered in order on the calling thread.
+CI_API void renderStrings( const std::string *strs, size_t count, const Font &font, const ColorA &color, Surface *results, float *baselineOffsets = nullptr );
+//! Renders the \a count strings of \a strs with renderStrings() and packs them into rows of a single Surface, returning it. The atlas is \a width pixels wide, or as wide as the widest
+//! string if that doesn't fit, and as tall as the rows require. Strings are separated from each other and from the edges by \a padding transparent pixels. The area of each string
+//! is written to the corresponding element of \a areas, and its baseline offset to \a baselineOffsets unless it's null.
+CI_API Surface renderStringAtlas( const std::string *strs, size_t count, const Font &font, const ColorA &color, int32_t width, Area *areas, float *baselineOffsets = nullptr, int32_t padding = 1 );
+#endif
+
+#if defined( CINDER_ANDROID ) || defined( CINDER_LINUX )
+//! \brief Process-wide cache of the FreeType glyph bitmaps and runs of text that TextLayout, TextBox and renderString() draw.
+//!
+//! Glyphs are keyed by face, size, glyph index and the subpixel offset they were rendered at, and runs by face, size and string. A run
+//! holds the glyph indices and advances of a string along with its extents, so that measuring and re-rendering text which has been
+//! seen before only looks up the run and blits its cached glyphs, rather than loading and rasterizing every glyph with FreeType again.
+//!
+//! The least recently used glyphs and runs are released once the memory budget is exceeded. Glyphs and runs that are returned by the
+//! cache stay valid for as long as they are referenced. The cache may be used from any thread. Glyphs and runs that are missing are
+//! created while holding Font::getFreetypeMutex() but not the cache's own lock, so that other threads keep finding what is cached.
+class CI_API GlyphCache : private Noncopyable {
+  public:
+	//! A glyph rendered at a subpixel offset. Its bitmap is placed relative to the pen position, with y pointing up as in FreeType.
+	struct Glyph {
+		//! Whether FreeType could load the glyph. Glyphs that failed to load have an empty bitmap and no advance.
+		bool					mLoaded;
+		//! The offset of the bitmap's left edge and top row from the pen position, in pixels.
+		int						mLeft, mTop;
+		//! The size of the bitmap in pixels.
+		int						mWidth, mRows;
+		//! The advance of the pen in 1/64 pixels.
+		ivec2					mAdvance;
+		//! The width and height of the glyph's metrics in 1/64 pixels.
+		ivec2					mMetricsSize;
+		//! The coverage of each pixel of the bitmap, in rows of \a mWidth bytes.
+		std::vector<uint8_t>	mPixels;
+	};
+
+	//! A string set in one face, along with the extents ftutil::MeasureString() reports for it.
+	struct Run {
+		//! The UTF-32 characters of the string.
+		std::u32string			mChars;
+		//! The glyph index of each character.
+		std::vector<uint32_t>	mGlyphIndices;
+		//! The advance of each character's glyph in 1/64 pixels.
+		std::vector<ivec2>		mAdvances;
+		//! The size of the run in pixels, and the position of its baseline within that size.
+		ivec2					mSize, mBaseline;
+	};
+
+	typedef std::shared_ptr<const Glyph>	GlyphRef;
+	typedef std::shared_ptr<const Run>		RunRef;
+
+	//! Returns the process-wide GlyphCache.
+	static GlyphCache* get();
+
+	//! Returns the run of \a utf8 set in \a face.
+	RunRef		getRun( FT_Face face, const std::string &utf8 );
+	//! Returns glyph \a glyphIndex of \a face, rendered with the pen at \a pen, in 1/64 pixels. Only the fractional part of \a pen affects the bitmap.
+	GlyphRef	getGlyph( FT_Face face, uint32_t glyphIndex, const ivec2 &pen = ivec2( 0 ) );
+	//! Replaces the contents of \a result with the glyphs of \a run, rendered with the pen starting at \a pen in 1/64 pixels and moved by each glyph's advance.
+	void		getGlyphs( FT_Face face, const Run &run, const ivec2 &pen, std::vector<GlyphRef> *result );
+
+	//! Enables or disables caching (enabled by default). While disabled, glyphs and runs are created on every call and nothing is kept.
+	void	setEnabled( bool enabled = true );
+	//! Returns whether caching is enabled.
+	bool	isEnabled() const;
+
+	//! Sets the number of bytes of glyphs and runs the cache keeps (default = 32 MB). Evicts the least recently used entries if necessary.
+	void	setMemoryBudget( size_t bytes );
+	//! Returns the number of bytes of glyphs and runs the cache keeps.
+	size_t	getMemoryBudget() const;
+	//! Returns the approximate number of bytes of glyphs and runs currently held by the cache.
+	size_t	getMemoryUsage() const;
+	//! Returns the number of glyphs currently held by the cache.
+	size_t	getNumGlyphs() const;
+	//! Returns the number of runs currently held by the cache.
+	size_t	getNumRuns() const;
+
+	//! Releases all glyphs and runs.
+	void	clear();
+	//! Releases the glyphs and runs of \a face, which must be called before \a face is destroyed.
+	void	clear( FT_Face face );
+
+  private:
+	GlyphCache();
+
+	struct FaceKey {
+		FT_Face		mFace;
+		int64_t		mScaleX, mScaleY;
+
+		bool operator==( const FaceKey &other ) const	{ return mFace == other.mFace && mScaleX == other.mScaleX && mScaleY == other.mScaleY; }
+	};
+
+	struct GlyphKey {
+		FaceKey		mFaceKey;
+		uint32_t	mGlyphIndex;
+		ivec2		mSubpixel;
+
+		bool operator==( const GlyphKey &other ) const	{ return mFaceKey == other.mFaceKey && mGlyphIndex == other.mGlyphIndex && mSubpixel == other.mSubpixel; }
+	};
+
+	struct RunKey {
+		FaceKey		mFaceKey;
+		std::string	mText;
+
+		bool operator==( const RunKey &other ) const	{ return mFaceKey == other.mFaceKey && mText == other.mText; }
+	};
+
+	struct KeyHash {
+		size_t operator()( const FaceKey &key ) const;
+		size_t operator()( const GlyphKey &key ) const;
+		size_t operator()( const RunKey &key ) const;
+	};
+
+	template<typename KeyT, typename ValueT>
+	struct Entry {
+		KeyT		mKey;
+		ValueT		mValue;
+		size_t		mNumBytes;
+		uint64_t	mLastUse;
+	};
+
+	typedef std::list<Entry<GlyphKey, GlyphRef>>	GlyphList;
+	typedef std::list<Entry<RunKey, RunRef>>		RunList;
+
+	// Must be called with \a lock holding mMutex, which is released while a missing glyph is rendered.
+	GlyphRef	getGlyph( const FaceKey &faceKey, uint32_t glyphIndex, const ivec2 &pen, std::unique_lock<std::mutex> &lock );
+	static GlyphRef	renderGlyph( const GlyphKey &key );
+	// Must be called with mMutex held.
+	void		evictLocked();
+
+	mutable std::mutex											mMutex;
+	bool														mEnabled;
+	GlyphList													mGlyphs;	// most recently used first
+	RunList														mRuns;		// most recently used first
+	std::unordered_map<GlyphKey, GlyphList::iterator, KeyHash>	mGlyphMap;
+	std::unordered_map<RunKey, RunList::iterator, KeyHash>		mRunMap;
+	size_t														mMemoryBudget, mMemoryUsage;
+	uint64_t													mUseCount;
+};
 #endif
 
 } // namespace cinder
@@ -32,6 +32,7 @@
 #include <vector>
 #include <list>
 #include <map>
+#include <memory>
 #include <algorithm>
 
 namespace cinder {
@@ -39,10 +40,18 @@ namespace cinder {
 typedef std::shared_ptr<class Cue>			CueRef;
 typedef std::shared_ptr<class Timeline>		TimelineRef;
 	
+//! \brief Steps TimelineItems such as Tweens and Cues.
+//!
+//! Plain Tweens of any value type, meaning those without callbacks, a custom lerp function or a subclass overriding update(), are
+//! stepped in batches that keep their state in contiguous arrays and group them by value type and easing function. This is much
+//! faster than stepping each item on its own when a Timeline holds thousands of tweens. Batched tweens behave exactly like the
+//! others, but are stepped before them. Tweens that share their target with other items, and all tweens while stepping backwards,
+//! are stepped individually in the order they were added.
 class CI_API Timeline : public TimelineItem {		
   public:
 	//! Creates a new timeline, defaulted to infinite
 	static TimelineRef	create() { TimelineRef result( new Timeline() ); result->setInfinite( true ); return result; }
+	~Timeline();
 
 	//! Advances time a specified amount and evaluates items
 	void	step( float timestep );
@@ -184,6 +193,19 @@ class CI_API Timeline : public TimelineItem {
 
 	//! Call this to notify the Timeline if the \a item's start-time or duration has changed. Advanced use cases only.
 	void	itemTimeChanged( TimelineItem *item );
+	//! Call this to notify the Timeline if anything else affecting how \a item is stepped, such as its callbacks or easing function, has changed. Advanced use cases only.
+	void	itemChanged( TimelineItem *item );
+
+	//! Sets whether plain tweens are stepped in batches. Default = true.
+	void	setBatchingEnabled( bool enable );
+	//! Returns whether plain tweens are stepped in batches
+	bool	isBatchingEnabled() const { return mBatchingEnabled; }
+	//! Returns the number of tweens currently stepped in batches. Tweens added since the last step are not batched yet.
+	size_t	getNumBatchedItems() const;
+	//! Sets the number of threads, including the calling one, that step batched tweens when there are enough of them. \c 0 uses one per hardware thread. Default = 1.
+	void	setNumStepThreads( size_t numThreads );
+	//! Returns the number of threads that step batched tweens
+	size_t	getNumStepThreads() const { return mNumStepThreads; }
 
 	TimelineRef	thisRef()
 	{
@@ -210,14 +232,38 @@ class CI_API Timeline : public TimelineItem {
 	void						eraseMarked();
 	virtual float				calcDuration() const;
 
+	//! Adds \a item to mItems and to the items stepped individually, from which it may be batched on the next step
+	void						insertItem( const TimelineItemRef &item );
+	void						markForRemoval( TimelineItem *item );
+	//! Moves \a item from its batch to the items stepped individually
+	void						unbatch( TimelineItem *item );
+	//! Marks one of the items stepped individually to be batched on the next step if possible
+	void						setPending( TimelineItem *item );
+	//! Marks the items with \a target as sharing it if there is more than one not marked for removal, moving them out of their batches
+	void						shareTarget( void *target );
+	void						dissolveBatches();
+	void						batchPending();
+	void						stepBatches( float time );
+
 	bool						mDefaultAutoRemove;
 	float						mCurrentTime;
 	
 	std::multimap<void*,TimelineItemRef>		mItems;
+	//! Items that aren't batched, in the order they were added
+	std::vector<TimelineItemRef>				mSteppedItems;
+	//! Whether any of mSteppedItems should be batched on the next step
+	bool										mHasPendingItems;
+	//! Items marked for removal along with the target they are stored under in mItems
+	std::vector<std::pair<void*,TimelineItem*>>	mMarkedItems;
+	std::vector<std::unique_ptr<TweenBatchBase>>	mBatches;
+	bool										mBatchingEnabled;
+	size_t										mNumStepThreads;
 	
   private:
 	Timeline( const Timeline &rhs ); // private to prevent copying; use clone() method instead
 	Timeline& operator=( const Timeline &rhs ); // not defined to prevent copying
+
+	friend class TimelineItem;
 };
 
 class CI_API Cue : public TimelineItem {
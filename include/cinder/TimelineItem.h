@@ -26,10 +26,15 @@
 
 #include "cinder/Cinder.h"
 
+#include <typeinfo>
+
 namespace cinder
 {
 typedef std::shared_ptr<class TimelineItem>	TimelineItemRef;
 
+class TweenBatchBase;
+template<typename T> class TweenBatch;
+
 //! Base interface for anything that can go on a Timeline
 class CI_API TimelineItem : public std::enable_shared_from_this<TimelineItem>
 {
@@ -54,17 +59,17 @@ class CI_API TimelineItem : public std::enable_shared_from_this<TimelineItem>
 	//! Returns whether the item starts over when it is complete
 	bool			getLoop() const { return mLoop; }
 	//! Sets whether the item starts over when it is complete
-	void			setLoop( bool doLoop = true ) { mLoop = doLoop; }
+	void			setLoop( bool doLoop = true ) { mLoop = doLoop; notifyChanged(); }
 
 	//! Returns whether the item alternates between forward and reverse. Overrides loop when true.
 	bool			getPingPong() const { return mPingPong; }
 	//! Sets whether the item alternates between forward and reverse. Overrides loop when true.
-	void			setPingPong( bool pingPong = true ) { mPingPong = pingPong; }
+	void			setPingPong( bool pingPong = true ) { mPingPong = pingPong; notifyChanged(); }
 
 	//! Returns whether the item ever is marked as complete
 	bool			getInfinite() const { return mLoop; }
 	//! Sets whether the item ever is marked as complete
-	void			setInfinite( bool infinite = true ) { mInfinite = infinite; }
+	void			setInfinite( bool infinite = true ) { mInfinite = infinite; notifyChanged(); }
 
 	//! Returns the time of the item's competion, equivalent to getStartTime() + getDuration().
 	float			getEndTime() const { return mStartTime + getDuration(); }
@@ -74,7 +79,7 @@ class CI_API TimelineItem : public std::enable_shared_from_this<TimelineItem>
 	//! Removes the item from its parent Timeline
 	void removeSelf();
 	//! Marks the item as not completed, and if \a unsetStarted, marks the item as not started
-	virtual void reset( bool unsetStarted = false ) { if( unsetStarted ) mHasStarted = false; mComplete = false; }
+	virtual void reset( bool unsetStarted = false ) { if( unsetStarted ) mHasStarted = false; mComplete = false; notifyChanged(); }
 	
 	//! Returns whether the item has started
 	bool hasStarted() const { return mHasStarted; }			
@@ -84,7 +89,7 @@ class CI_API TimelineItem : public std::enable_shared_from_this<TimelineItem>
 	//! Should the item remove itself from the Timeline when it is complete
 	bool	getAutoRemove() const { return mAutoRemove; }
 	//! Sets whether the item will remove itself from the Timeline when it is complete
-	void	setAutoRemove( bool autoRemove = true ) { mAutoRemove = autoRemove; }
+	void	setAutoRemove( bool autoRemove = true ) { mAutoRemove = autoRemove; notifyChanged(); }
 	
 	virtual void start( bool reverse ) = 0;
 	virtual void loopStart() {}
@@ -102,8 +107,37 @@ class CI_API TimelineItem : public std::enable_shared_from_this<TimelineItem>
 	void stepTo( float time, bool reverse );
 	
 	TimelineItemRef thisRef() { return shared_from_this(); }
+
+	//! \cond
+	//! Identifies the TweenBatchBase that can step an item. Items are only batched together when their keys are equal.
+	struct BatchKey {
+		const std::type_info	*mType;
+		float					(*mEaseFunction)( float );
+
+		bool operator==( const BatchKey &rhs ) const { return mType == rhs.mType && mEaseFunction == rhs.mEaseFunction; }
+	};
+
+	//! Returns whether the parent Timeline can step the item in a TweenBatchBase rather than calling stepTo(), setting \a key if so
+	virtual bool				isBatchable( BatchKey * /*key*/ ) const { return false; }
+	//! Returns a new, empty TweenBatchBase for items with the same BatchKey. Only called when isBatchable() returns true.
+	virtual TweenBatchBase*		createBatch() const { return nullptr; }
+	//! \endcond
 	
   protected:
+	//! The TweenBatchBase stepping an item and the item's index in it, whether the item's parent holds other items with the same
+	//! target, which rules out batching, and whether the parent should try to batch it on the next step. Not copied along with the item.
+	struct BatchState {
+		BatchState() : mBatch( nullptr ), mIndex( 0 ), mSharesTarget( false ), mPending( false ) {}
+		BatchState( const BatchState & ) : BatchState() {}
+		BatchState& operator=( const BatchState & ) { return *this; }
+
+		TweenBatchBase	*mBatch;
+		size_t			mIndex;
+		bool			mSharesTarget, mPending;
+	};
+
+	//! Notifies the parent Timeline that something affecting how the item is stepped has changed
+	void	notifyChanged();
 	void	setDurationDirty() { mDirtyDuration = true; }
 	void	updateDuration() const;
 	//! Converts time from absolute to absolute based on item's looping attributes
@@ -122,8 +156,10 @@ class CI_API TimelineItem : public std::enable_shared_from_this<TimelineItem>
 	bool	mUseAbsoluteTime;
 	bool	mAutoRemove;
 	int32_t	mLastLoopIteration;
+	BatchState	mBatchState;
 	
 	friend class Timeline;
+	template<typename T> friend class TweenBatch;
   private:
 	mutable float	mDuration, mInvDuration;
 	mutable bool	mDirtyDuration; // marked if the virtual calcDuration() needs to be calculated
@@ -32,7 +32,10 @@ struct TESStesselator;
 
 namespace cinder {
 
-//! Converts an arbitrary Shape2d into a TriMesh2d
+//! \brief Converts an arbitrary Shape2d into a TriMesh2d
+//!
+//! Each tesselation removes the contours that were added, so a Triangulator can be reused for any number of shapes. The memory
+//! the tesselator uses is recycled from one tesselation to the next, so reusing a Triangulator avoids most allocations.
 class CI_API Triangulator {
   public:
 	typedef enum Winding { WINDING_ODD, WINDING_NONZERO, WINDING_POSITIVE, WINDING_NEGATIVE, WINDING_ABS_GEQ_TWO } Winding;
@@ -59,15 +62,32 @@ class CI_API Triangulator {
 	TriMesh		calcMesh( Winding winding = WINDING_ODD );
 	//! Performs the tesselation, returning a TriMesh2d
 	TriMeshRef	createMesh( Winding winding = WINDING_ODD );
+	//! Performs the tesselation, appending the vertices to \a positions and the indices of the triangles to \a indices, which refer to the appended vertices.
+	void		calcMesh( std::vector<vec2> *positions, std::vector<uint32_t> *indices, Winding winding = WINDING_ODD );
+	//! Performs the tesselation, appending the triangles to \a result, which must have 2D positions.
+	void		calcMesh( TriMesh *result, Winding winding = WINDING_ODD );
+
+	//! Tesselates each of the \a count \a shapes, replacing the contents of the corresponding element of \a results, which must have 2D positions.
+	//! The shapes are spread across threads according to ip::getExecutionPolicy(), and each thread keeps a Triangulator whose memory is reused by later calls,
+	//! up to 1 MB per thread. Memory needed beyond that by larger shapes is released before the call returns.
+	static void	calcMeshes( const Shape2d *shapes, size_t count, TriMesh *results, Winding winding = WINDING_ODD, float approximationScale = 1.0f );
 	
 	class CI_API Exception : public cinder::Exception {
 	};
 	
   protected:	
 	void			allocate();
+	//! If more than \a maxBytes are allocated, replaces the tesselator, discarding any contours added since the last tesselation, and releases the memory kept for reuse beyond \a maxBytes.
+	void			trimMemory( size_t maxBytes );
+	//! Tesselates the contours added so far. \return \c false if the tesselation failed, in which case the tesselator has been replaced by a new one.
+	bool			tesselate( Winding winding );
 	
-	int									mAllocated;
+	struct MemoryPool;
+
+	// declared before mTess, which frees its memory into the pool when it is destroyed
+	std::shared_ptr<MemoryPool>			mMemoryPool;
 	std::shared_ptr<TESStesselator>		mTess;
+	std::vector<vec2>					mSubdivided;
 };
 
 } // namespace cinder
\ No newline at end of file
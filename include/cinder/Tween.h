@@ -30,7 +30,10 @@
 #include "cinder/Easing.h"
 #include "cinder/Quaternion.h"
 
+#include <algorithm>
 #include <list>
+#include <typeinfo>
+#include <vector>
 
 namespace cinder {
 
@@ -84,22 +87,22 @@ class CI_API TweenBase : public TimelineItem {
 	virtual ~TweenBase() {}
 
 	//! change how the tween moves through time
-	void	setEaseFn( EaseFn easeFunction ) { mEaseFunction = easeFunction; }
+	void	setEaseFn( EaseFn easeFunction ) { mEaseFunction = easeFunction; notifyChanged(); }
 	EaseFn	getEaseFn() const { return mEaseFunction; }
 
-	void			setStartFn( StartFn startFunction ) { mStartFunction = startFunction; }
+	void			setStartFn( StartFn startFunction ) { mStartFunction = startFunction; notifyChanged(); }
 	StartFn			getStartFn() const { return mStartFunction; }
 
-	void			setReverseStartFn( StartFn reverseStartFunction ) { mReverseStartFunction = reverseStartFunction; }
+	void			setReverseStartFn( StartFn reverseStartFunction ) { mReverseStartFunction = reverseStartFunction; notifyChanged(); }
 	StartFn			getReverseStartFn() const { return mReverseStartFunction; }
 	
-	void			setUpdateFn( UpdateFn updateFunction ) { mUpdateFunction = updateFunction; }									
+	void			setUpdateFn( UpdateFn updateFunction ) { mUpdateFunction = updateFunction; notifyChanged(); }									
 	UpdateFn		getUpdateFn() const { return mUpdateFunction; }
 																																					
-	void			setFinishFn( FinishFn finishFn ) { mFinishFunction = finishFn; }
+	void			setFinishFn( FinishFn finishFn ) { mFinishFunction = finishFn; notifyChanged(); }
 	FinishFn		getFinishFn() const { return mFinishFunction; }
 
-	void			setReverseFinishFn( FinishFn reverseFinishFn ) { mReverseFinishFunction = reverseFinishFn; }
+	void			setReverseFinishFn( FinishFn reverseFinishFn ) { mReverseFinishFunction = reverseFinishFn; notifyChanged(); }
 	FinishFn		getReverseFinishFn() const { return mReverseFinishFunction; }
 	
 	class CI_API Options {
@@ -180,11 +183,34 @@ class Tween : public TweenBase {
 	//! Returns whether the tween will copy its target's value upon starting
 	bool	isCopyStartValue() { return mCopyStartValue; }
 
-	void	setLerpFn( const LerpFn &lerpFn ) { mLerpFunction = lerpFn; }
+	void	setLerpFn( const LerpFn &lerpFn ) { mLerpFunction = lerpFn; notifyChanged(); }
 
 	//! Returns a TweenRef<T> to \a this
 	TweenRef<T>		getThisRef(){ return TweenRef<T>( std::static_pointer_cast<Tween<T> >( shared_from_this() ) ); }
 
+	//! \cond
+	bool isBatchable( BatchKey *key ) const override
+	{
+		// subclasses may override update(), and callbacks or a custom lerp need the tween to be stepped on its own
+		auto easeFunction = mEaseFunction.template target<float (*)( float )>();
+		auto lerpFunction = mLerpFunction.template target<T (*)( const T&, const T&, float )>();
+		if( typeid( *this ) != typeid( Tween<T> ) || ( ! easeFunction ) || ( ! lerpFunction ) || *lerpFunction != &tweenLerp<T>
+			|| mStartFunction || mReverseStartFunction || mUpdateFunction || mFinishFunction || mReverseFinishFunction )
+			return false;
+
+		key->mType = &typeid( Tween<T> );
+		key->mEaseFunction = *easeFunction;
+		return true;
+	}
+
+	TweenBatchBase* createBatch() const override
+	{
+		BatchKey key;
+		isBatchable( &key );
+		return new TweenBatch<T>( key );
+	}
+	//! \endcond
+
 
 	class Options : public TweenBase::Options {
 	  public:
@@ -223,6 +249,7 @@ class Tween : public TweenBase {
 	virtual void reverse()
 	{
 		std::swap( mStartValue, mEndValue );
+		notifyChanged();
 	}
 
 	virtual TimelineItemRef	clone() const
@@ -261,6 +288,8 @@ class Tween : public TweenBase {
 	T	mStartValue, mEndValue;	
 	
 	LerpFn				mLerpFunction;
+
+	friend class TweenBatch<T>;
 };
 
 template<typename T>
@@ -296,6 +325,190 @@ class FnTweenRef : public TweenRef<T> {
 	{}
 };
 
+//! \cond
+//! Steps plain Tweens that share a value type and easing function, keeping the state needed by every step in contiguous arrays.
+//! Owned by a Timeline, which moves its tweens in and out of batches. \see Timeline::setBatchingEnabled()
+class CI_API TweenBatchBase {
+  public:
+	TweenBatchBase( const TimelineItem::BatchKey &key ) : mKey( key ) {}
+	virtual ~TweenBatchBase() {}
+
+	//! Returns the key shared by all tweens in the batch
+	const TimelineItem::BatchKey&	getKey() const { return mKey; }
+
+	virtual void			add( TimelineItem *item ) = 0;
+	//! Removes \a item by moving the last tween into its slot
+	virtual void			remove( TimelineItem *item ) = 0;
+	virtual void			clear() = 0;
+
+	virtual size_t			size() const = 0;
+	virtual TimelineItem*	getItem( size_t index ) const = 0;
+	//! Sets the value written by the tween at \a index, after its target has been replaced
+	virtual void			setTarget( size_t index, void *target ) = 0;
+
+	//! Steps the tweens in [\a begin, \a end) forward to \a time and returns how many completed and should be removed. Disjoint ranges can be stepped concurrently.
+	virtual size_t			step( float time, size_t begin, size_t end ) = 0;
+	//! Removes the tweens that completed and should be removed, appending them to \a removed
+	virtual void			eraseCompleted( std::vector<TimelineItem*> *removed ) = 0;
+
+  private:
+	TimelineItem::BatchKey	mKey;
+};
+
+template<typename T>
+class TweenBatch : public TweenBatchBase {
+  public:
+	typedef float (*EaseFnPtr)( float );
+
+	TweenBatch( const TimelineItem::BatchKey &key )
+		: TweenBatchBase( key ), mEaseFunction( key.mEaseFunction )
+	{}
+
+	void add( TimelineItem *item ) override
+	{
+		Tween<T> *tween = static_cast<Tween<T>*>( item );
+		const TimelineItem *base = tween;
+		base->updateDuration();
+		tween->mBatchState.mBatch = this;
+		tween->mBatchState.mIndex = mTweens.size();
+
+		mTweens.push_back( tween );
+		mTargets.push_back( tween->getTarget() );
+		mStartValues.push_back( tween->mStartValue );
+		mEndValues.push_back( tween->mEndValue );
+		mStartTimes.push_back( base->mStartTime );
+		mEndTimes.push_back( base->mStartTime + base->mDuration );
+		mInvDurations.push_back( base->mInvDuration );
+		mFlags.push_back( ( base->mHasStarted ? FLAG_STARTED : 0 ) | ( base->mComplete ? FLAG_COMPLETE : 0 ) | ( base->mLoop ? FLAG_LOOP : 0 )
+			| ( base->mPingPong ? FLAG_PING_PONG : 0 ) | ( base->mInfinite ? FLAG_INFINITE : 0 ) | ( base->mAutoRemove ? FLAG_AUTO_REMOVE : 0 ) );
+	}
+
+	void remove( TimelineItem *item ) override
+	{
+		const size_t index = item->mBatchState.mIndex, last = mTweens.size() - 1;
+		if( index != last ) {
+			mTweens[index] = mTweens[last];
+			mTargets[index] = mTargets[last];
+			mStartValues[index] = mStartValues[last];
+			mEndValues[index] = mEndValues[last];
+			mStartTimes[index] = mStartTimes[last];
+			mEndTimes[index] = mEndTimes[last];
+			mInvDurations[index] = mInvDurations[last];
+			mFlags[index] = mFlags[last];
+			mTweens[index]->mBatchState.mIndex = index;
+		}
+
+		mTweens.pop_back();
+		mTargets.pop_back();
+		mStartValues.pop_back();
+		mEndValues.pop_back();
+		mStartTimes.pop_back();
+		mEndTimes.pop_back();
+		mInvDurations.pop_back();
+		mFlags.pop_back();
+		item->mBatchState.mBatch = nullptr;
+	}
+
+	void clear() override
+	{
+		for( Tween<T> *tween : mTweens )
+			tween->mBatchState.mBatch = nullptr;
+
+		mTweens.clear();
+		mTargets.clear();
+		mStartValues.clear();
+		mEndValues.clear();
+		mStartTimes.clear();
+		mEndTimes.clear();
+		mInvDurations.clear();
+		mFlags.clear();
+	}
+
+	size_t			size() const override { return mTweens.size(); }
+	TimelineItem*	getItem( size_t index ) const override { return mTweens[index]; }
+	void			setTarget( size_t index, void *target ) override { mTargets[index] = reinterpret_cast<T*>( target ); }
+
+	// Mirrors TimelineItem::stepTo() and Tween<T>::update() for a forward step, writing back to the tween only when it starts or completes
+	size_t step( float time, size_t begin, size_t end ) override
+	{
+		size_t numCompleted = 0;
+		for( size_t i = begin; i < end; ++i ) {
+			if( time < mStartTimes[i] )
+				continue;
+
+			uint8_t flags = mFlags[i];
+			if( ! ( flags & FLAG_STARTED ) ) {
+				flags |= FLAG_STARTED;
+				start( i );
+			}
+
+			const float absTime = time - mStartTimes[i];
+			const float invDuration = mInvDurations[i];
+			float relTime;
+			if( invDuration <= 0 )
+				relTime = 1.0f;
+			else if( flags & FLAG_PING_PONG ) {
+				relTime = math<float>::fmod( absTime * invDuration, 2 );
+				if( relTime > 1 )
+					relTime = ( 2 - relTime );
+			}
+			else if( flags & FLAG_LOOP )
+				relTime = math<float>::fmod( absTime * invDuration, 1 );
+			else
+				relTime = std::min( absTime * invDuration, 1.0f );
+
+			*mTargets[i] = tweenLerp<T>( mStartValues[i], mEndValues[i], mEaseFunction( relTime ) );
+
+			if( time >= mEndTimes[i] && ! ( flags & ( FLAG_LOOP | FLAG_INFINITE | FLAG_COMPLETE ) ) ) {
+				flags |= FLAG_COMPLETE;
+				mTweens[i]->mComplete = true;
+				mTweens[i]->mReverseComplete = false;
+				if( flags & FLAG_AUTO_REMOVE )
+					++numCompleted;
+			}
+
+			mFlags[i] = flags;
+		}
+
+		return numCompleted;
+	}
+
+	void eraseCompleted( std::vector<TimelineItem*> *removed ) override
+	{
+		for( size_t i = 0; i < mTweens.size(); ) {
+			if( ( mFlags[i] & ( FLAG_COMPLETE | FLAG_AUTO_REMOVE ) ) == ( FLAG_COMPLETE | FLAG_AUTO_REMOVE ) ) {
+				removed->push_back( mTweens[i] );
+				remove( mTweens[i] );
+			}
+			else
+				++i;
+		}
+	}
+
+  private:
+	enum : uint8_t { FLAG_STARTED = 1, FLAG_COMPLETE = 2, FLAG_LOOP = 4, FLAG_PING_PONG = 8, FLAG_INFINITE = 16, FLAG_AUTO_REMOVE = 32 };
+
+	void start( size_t index )
+	{
+		Tween<T> *tween = mTweens[index];
+		tween->mHasStarted = true;
+		tween->mHasReverseStarted = false;
+		tween->mLastLoopIteration = 0;
+		if( tween->mCopyStartValue ) {
+			mStartValues[index] = *mTargets[index];
+			tween->mStartValue = mStartValues[index];
+		}
+	}
+
+	EaseFnPtr				mEaseFunction;
+	std::vector<Tween<T>*>	mTweens;
+	std::vector<T*>			mTargets;
+	std::vector<T>			mStartValues, mEndValues;
+	std::vector<float>		mStartTimes, mEndTimes, mInvDurations;
+	std::vector<uint8_t>	mFlags;
+};
+//! \endcond
+
 class CI_API AnimBase {
   public:
   	//! removes self from Timeline
@@ -30,14 +30,46 @@
 #include <cstdlib>
 #include <cstring>
 #include <algorithm>
+#include <new>
 
 // TODO: It'd be nice to have a 'BufferView' or similar functionality
 // - would not own the internal buffer, but would point to another one, with offset + size
 // - alt. would be for BufferBaseT to take an alternate constructor
-//		- requires T* as data storage gain, which is also necessary to ensure 16byte alignment
+//		- requires T* as data storage gain
 
 namespace cinder { namespace audio {
 
+//! Default alignment in bytes of the sample storage owned by the Buffer classes, wide enough for 256-bit vector registers.
+const size_t BUFFER_ALIGNMENT = 32;
+
+//! Standard library compatible allocator that returns storage aligned to \a Alignment bytes. Used by BufferBaseT so that dsp routines can operate on vector registers.
+template <typename T, size_t Alignment = BUFFER_ALIGNMENT>
+struct AlignedAllocator {
+	typedef T value_type;
+
+	template <typename U>
+	struct rebind { typedef AlignedAllocator<U, Alignment> other; };
+
+	AlignedAllocator() noexcept = default;
+	template <typename U>
+	AlignedAllocator( const AlignedAllocator<U, Alignment> & ) noexcept	{}
+
+	T* allocate( size_t n )
+	{
+		return static_cast<T *>( ::operator new( n * sizeof( T ), std::align_val_t( Alignment ) ) );
+	}
+
+	void deallocate( T *p, size_t )	noexcept
+	{
+		::operator delete( p, std::align_val_t( Alignment ) );
+	}
+
+	template <typename U>
+	bool operator==( const AlignedAllocator<U, Alignment> & ) const noexcept	{ return true; }
+	template <typename U>
+	bool operator!=( const AlignedAllocator<U, Alignment> & ) const noexcept	{ return false; }
+};
+
 //! Base class for the various Buffer classes.  The template parameter T defined the sample type (precision).
 template <typename T>
 class BufferBaseT {
@@ -81,7 +113,7 @@ class BufferBaseT {
 		: mNumFrames( numFrames ), mNumChannels( numChannels ), mData( numFrames * numChannels )
 	{}
 
-	std::vector<T> mData;
+	std::vector<T, AlignedAllocator<T>> mData;
 	size_t mNumChannels, mNumFrames;
 };
 
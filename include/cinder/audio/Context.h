@@ -26,9 +26,9 @@
 #include "cinder/audio/Node.h"
 #include "cinder/audio/InputNode.h"
 #include "cinder/audio/OutputNode.h"
+#include "cinder/audio/dsp/RingBuffer.h"
 #include "cinder/Timer.h"
 
-#include <list>
 #include <mutex>
 #include <set>
 #include <thread>
@@ -36,6 +36,7 @@
 namespace cinder { namespace audio {
 
 class DeviceManager;
+class RenderThreadPool;
 
 //! \brief Manages the creation, connections, and lifecycle of audio::Node's.
 
@@ -115,12 +116,23 @@ class CI_API Context : public std::enable_shared_from_this<Context> {
 	//! Schedule \a node to be enabled or disabled with with \a func on the audio thread, to be called at \a when seconds measured against getNumProcessedSeconds().
 	//! If \a \a callFuncBeforeProcess is true, then `func` will be called at the beginning of the processing block, if false will be called at the end.
 	//! \note Should be called from the user thread. Currently only one event can be scheduled on a node at a time. \a node is owned until the scheduled event completes.
+	//! The event is delivered to the audio thread through a lock-free command queue, so this never blocks audio processing.
 	void scheduleEvent( double when, const NodeRef &node, bool callFuncBeforeProcess, const std::function<void ()> &func );
-	//! Immediately cancels any events scheduled with scheduleEvent().
+	//! Cancels any events scheduled with scheduleEvent(), starting with the next processing block.
 	void cancelScheduledEvents( const NodeRef &node );
 	//! \deprecated  use scheduleEvent() instead.
 	void schedule( double when, const NodeRef &node, bool callFuncBeforeProcess, const std::function<void ()> &func )	{ scheduleEvent( when, node, callFuncBeforeProcess, func ); }
 
+	//! \brief Sets the number of additional threads used to render the audio graph, default is 0 (all processing happens on the audio device's thread).
+	//!
+	//! When non-zero, a Node whose inputs are independent subgraphs (they share no Node's and contain no cycles) has those inputs pulled
+	//! concurrently on a fixed pool of \a numThreads worker threads plus the audio thread, after which they are summed in the same order
+	//! as the serial path, so the output is identical. Only the outermost such Node in the graph is parallelized.
+	//! \note Node's that process on worker threads must not share state with Node's in sibling subgraphs, including any Param processor Node's.
+	void	setNumRenderThreads( size_t numThreads );
+	//! Returns the number of additional threads used to render the audio graph. \see setNumRenderThreads()
+	size_t	getNumRenderThreads() const;
+
 	//! Returns the mutex used to synchronize the audio thread. This is also used internally by the Node class when making connections.
 	std::mutex& getMutex() const			{ return mMutex; }
 	//! Returns true if the current thread is the thread used for audio processing, false otherwise.
@@ -142,33 +154,37 @@ class CI_API Context : public std::enable_shared_from_this<Context> {
   protected:
 	Context();
 
+	//! Destroys the commands sent to the audio thread by Param's and scheduleEvent() once it is done with them. Must not be called on the audio thread.
+	void	releaseDoneCommands();
+	//! Stores \a output when a subclass creates its default OutputNode lazily in getOutput(). Unlike setOutput(), this doesn't lock the mutex, which may already be held by the caller.
+	void	setDefaultOutput( const OutputNodeRef &output )	{ mOutput = output; }
+
   private:
-	struct ScheduledEvent {
-		ScheduledEvent( uint64_t eventFrameThreshold, const NodeRef &node, bool callFuncBeforeProcess, const std::function<void ()> &fn )
-			: mEventFrameThreshold( eventFrameThreshold ), mNode( node ), mCallFuncBeforeProcess( callFuncBeforeProcess ), mFunc( fn ), mProcessingEvent( false )
-		{}
-
-		uint64_t				mEventFrameThreshold;
-		NodeRef					mNode;
-		bool					mCallFuncBeforeProcess;
-		bool					mProcessingEvent;
-		std::function<void ()>	mFunc;
-	};
+	struct Command;
 
 	void	disconnectRecursive( const NodeRef &node, std::set<NodeRef> &traversedNodes );
 	void	initRecursisve( const NodeRef &node, std::set<NodeRef> &traversedNodes  );
 	void	uninitRecursive( const NodeRef &node, std::set<NodeRef> &traversedNodes  );
 	void	processAutoPulledNodes();
+	void	updateParallelPulledNodes();
+	void	findParallelPulledNodes( const NodeRef &node, std::set<Node *> &traversedNodes );
+	bool	inputsAreIndependent( const NodeRef &node ) const;
+	bool	collectUpstreamNodes( const NodeRef &node, std::set<Node *> &upstreamNodes ) const;
+	bool	pullInputsInParallel( Node *node );
+	static void pullParallelInput( void *node, size_t inputIndex );
+	void	queueCommand( std::unique_ptr<Command> command );
+	void	queueParamEvent( Param *param, const EventRef &event, bool replaceEvents );
+	void	queueParamReset( Param *param, bool setValue, float value );
+	void	processCommands();
 	void	preProcessScheduledEvents();
 	void	postProcessScheduledEvents();
 	void	incrementFrameCount();
 
 	static void registerClearStatics();
 
-	bool						mEnabled;
+	std::atomic<bool>			mEnabled;
 	std::atomic<uint64_t>		mNumProcessedFrames;
 	OutputNodeRef				mOutput;
-	std::list<ScheduledEvent>	mScheduledEvents;
 	ci::Timer					mProcessTimer;
 	std::atomic<double>			mTimeDuringLastProcessLoop;
 
@@ -181,9 +197,27 @@ class CI_API Context : public std::enable_shared_from_this<Context> {
 	mutable std::mutex		mMutex;
 	std::thread::id			mAudioThreadId;
 
+	// Commands sent from user threads to the audio thread. Producers are serialized by mCommandsMutex, which the audio thread never
+	// locks; the queue is consumed by whoever holds mMutex. Commands are owned by mCommands until the audio thread marks them as done,
+	// after which they are destroyed off the audio thread by releaseDoneCommands(): when the next command is queued, when the Context is
+	// disabled and after each OfflineContext::render(). While the Context is disabled commands are processed as soon as they are queued.
+	dsp::RingBufferT<Command *>				mCommandQueue;
+	std::vector<std::unique_ptr<Command>>	mCommands;
+	std::mutex								mCommandsMutex;
+	// pending events from scheduleEvent(), only accessed by the consumer of mCommandQueue
+	Command*								mScheduledEvents;
+
+	// parallel rendering, guarded by mMutex
+	std::unique_ptr<RenderThreadPool>	mRenderThreadPool;
+	std::vector<std::weak_ptr<Node>>	mParallelPulledNodes;
+	bool								mParallelGraphDirty;
+
 	// - Context is stored in Node classes as a weak_ptr, so it needs to (for now) be created as a shared_ptr
 	static std::shared_ptr<Context>			sMasterContext;
 	static std::unique_ptr<DeviceManager>	sDeviceManager; // TODO: consider turning DeviceManager into a HardwareContext class
+
+	friend class Node;
+	friend class Param;
 };
 
 template<typename NodeT>
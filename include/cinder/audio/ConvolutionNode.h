@@ -0,0 +1,85 @@
+/*
+ Copyright (c) 2026, The Cinder Project
+
+ This code is intended to be used with the Cinder C++ library, http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#pragma once
+
+#include "cinder/audio/Node.h"
+#include "cinder/audio/Source.h"
+
+#include <memory>
+#include <vector>
+
+namespace cinder { namespace audio {
+
+typedef std::shared_ptr<class ConvolutionNode>		ConvolutionNodeRef;
+
+//! \brief Convolves its input with an impulse response, such as for convolution reverb.
+//!
+//! The impulse response is split into partitions that are convolved in the frequency domain, so that the cost of each processing block stays
+//! fixed regardless of the impulse response's length. The first partitions are one processing block long, which results in zero latency. Later
+//! partitions grow in size (non-uniform partitioning) up to getMaxPartitionSize(), and their work, including their transforms, is spread evenly
+//! over the processing blocks in between. Setting the max partition size to the frames per block or less results in uniform partitioning.
+//!
+//! Each channel is convolved with the impulse response channel of the same index, or the last channel if the impulse response has fewer
+//! channels, so a mono impulse response is shared by all channels. To create a stereo reverb from a mono input, specify two channels with Node::Format.
+//! \note Requires the Context's frames per block to be a power of two.
+class CI_API ConvolutionNode : public Node {
+  public:
+	//! Constructs a ConvolutionNode with an optional \a format. It outputs silence until an impulse response is set.
+	ConvolutionNode( const Format &format = Format() );
+	//! Constructs a ConvolutionNode that convolves with \a impulseResponse, with an optional \a format.
+	ConvolutionNode( const BufferRef &impulseResponse, const Format &format = Format() );
+	virtual ~ConvolutionNode();
+
+	//! Sets the impulse response, which is expected to be at the Context's samplerate. Safe to do while enabled, though the current tail is cleared.
+	void setImpulseResponse( const BufferRef &impulseResponse );
+	//! Loads the entire contents of \a sourceFile, converted to the Context's samplerate, and sets it as the impulse response.
+	void loadImpulseResponse( const SourceFileRef &sourceFile );
+	//! Returns the current impulse response.
+	const BufferRef& getImpulseResponse() const	{ return mImpulseResponse; }
+
+	//! Sets the maximum partition size in frames, which must be a power of two (default = 8192). Larger partitions lower the cost of long impulse responses, but make it more uneven between processing blocks.
+	void	setMaxPartitionSize( size_t frames );
+	//! Returns the maximum partition size in frames.
+	size_t	getMaxPartitionSize() const			{ return mMaxPartitionSize; }
+	//! Returns the number of partitions that the impulse response is currently split into, or zero if the ConvolutionNode isn't initialized.
+	size_t	getNumPartitions() const;
+
+  protected:
+	void initialize()				override;
+	void uninitialize()				override;
+	void process( Buffer *buffer )	override;
+
+	struct Stage;
+
+	std::vector<std::unique_ptr<Stage>>	makeStages() const;
+	void								updateStages();
+
+	BufferRef							mImpulseResponse;
+	size_t								mMaxPartitionSize;
+	std::vector<std::unique_ptr<Stage>>	mStages;
+	BufferDynamic						mOutputBuffer;
+};
+
+} } // namespace cinder::audio
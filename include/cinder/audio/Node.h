@@ -155,6 +155,8 @@ class CI_API Node : public std::enable_shared_from_this<Node>, private Noncopyab
 	bool		isInitialized() const				{ return mInitialized; }
 	//! Returns whether this Node will process audio with an in-place Buffer.
 	bool		getProcessesInPlace() const			{ return mProcessInPlace; }
+	//! Returns whether this Node's inputs are pulled concurrently on the Context's render threads. \see Context::setNumRenderThreads()
+	bool		getPullsInputsInParallel() const	{ return mPullInputsInParallel; }
 	//! Returns whether it is possible to connect to \a input, example reasons of failure would be this == Node, or Node is already an input.
 	bool		canConnectToInput( const NodeRef &input );
 	//! Returns true if there is an unmanageable cycle betweeen \a sourceNode and \a destNode. If any Node's in the traversal returns true for supportsCycles(), this method will return false.
@@ -233,7 +235,7 @@ class CI_API Node : public std::enable_shared_from_this<Node>, private Noncopyab
 
 	std::weak_ptr<Context>	mContext;
 	std::atomic<bool>		mEnabled;
-	std::atomic<bool>		mEventScheduled;
+	std::atomic<size_t>		mNumEventsScheduled;	// scheduled with Context::scheduleEvent() and not yet completed or canceled
 	bool					mInitialized;
 	bool					mAutoEnabled;
 	bool					mProcessInPlace;
@@ -249,6 +251,11 @@ class CI_API Node : public std::enable_shared_from_this<Node>, private Noncopyab
 	std::set<std::shared_ptr<Node> >	mInputs;
 	std::vector<std::weak_ptr<Node> >	mOutputs;
 
+	// Set by the Context when this Node's inputs can be pulled concurrently, see Context::setNumRenderThreads()
+	bool						mPullInputsInParallel;
+	std::vector<Node *>			mParallelInputs;
+	std::vector<BufferDynamic>	mParallelInputBuffers;
+
 	friend class Context;
 	friend class Param;
 };
@@ -0,0 +1,115 @@
+/*
+ Copyright (c) 2026, The Cinder Project
+
+ This code is intended to be used with the Cinder C++ library, http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#pragma once
+
+#include "cinder/audio/Context.h"
+#include "cinder/audio/Target.h"
+
+#include <functional>
+
+namespace cinder { namespace audio {
+
+typedef std::shared_ptr<class OfflineContext>		OfflineContextRef;
+typedef std::shared_ptr<class OfflineOutputNode>	OfflineOutputNodeRef;
+
+//! \brief OutputNode that is not tied to any hardware, used by OfflineContext to render the audio graph on demand.
+//!
+//! Each rendered block is delivered to an optional TargetFile and an optional callback. Defaults to two channels if not specified by Node::Format.
+class CI_API OfflineOutputNode : public OutputNode {
+  public:
+	//! Callback type that receives each rendered block. \a numFrames may be less than the Buffer's frames for the final block of a render.
+	typedef std::function<void ( const Buffer *buffer, size_t numFrames )>	RenderCallback;
+
+	OfflineOutputNode( size_t sampleRate, size_t framesPerBlock, const Format &format = Format() );
+
+	//! Returns the samplerate that was specified at construction.
+	size_t getOutputSampleRate() override		{ return mSampleRate; }
+	//! Returns the frames per block that was specified at construction.
+	size_t getOutputFramesPerBlock() override	{ return mFramesPerBlock; }
+
+	//! Sets the TargetFile that each rendered block is written to. Pass in an empty TargetFileRef to stop writing.
+	void setTargetFile( const TargetFileRef &targetFile );
+	//! Returns the TargetFile that rendered blocks are written to, or an empty TargetFileRef if none is set.
+	const TargetFileRef& getTargetFile() const		{ return mTargetFile; }
+	//! Sets a callback that receives each rendered block. It is called on the rendering thread while the Context's mutex is held, so it must not make connections.
+	void setRenderCallback( const RenderCallback &callback );
+
+  protected:
+	bool supportsProcessInPlace() const override	{ return false; }
+
+  private:
+	// Called by OfflineContext, renders one block and delivers the first \a numFrames frames of it.
+	void renderBlock( size_t numFrames );
+
+	size_t			mSampleRate, mFramesPerBlock;
+	TargetFileRef	mTargetFile;
+	RenderCallback	mRenderCallback;
+
+	friend class OfflineContext;
+};
+
+//! \brief Context that renders its audio graph as fast as possible, on the calling thread, instead of being driven by an audio device.
+//!
+//! Useful for batch rendering to file on machines without audio hardware and for testing. Rendering is initiated with render(), which can be
+//! called repeatedly. Because there is no separate audio thread, Node's added with Context::makeNode() are processed on the thread that calls render().
+//!
+//! \code
+//! auto ctx = std::make_shared<audio::OfflineContext>( 48000, 512, 2 );
+//! auto gen = ctx->makeNode<audio::GenSineNode>( 440 );
+//! gen >> ctx->getOfflineOutput();
+//! ctx->getOfflineOutput()->setTargetFile( audio::TargetFile::create( "out.ogg", 48000, 2 ) );
+//! ctx->renderSeconds( 10 );
+//! \endcode
+class CI_API OfflineContext : public Context {
+  public:
+	//! Constructs an OfflineContext that renders \a numChannels channels at \a sampleRate, in blocks of \a framesPerBlock frames.
+	OfflineContext( size_t sampleRate = 44100, size_t framesPerBlock = 512, size_t numChannels = 2 );
+	virtual ~OfflineContext();
+
+	//! Not supported, throws AudioContextExc.
+	OutputDeviceNodeRef		createOutputDeviceNode( const DeviceRef &device = Device::getDefaultOutput(), const Node::Format &format = Node::Format() ) override;
+	//! Not supported, throws AudioContextExc.
+	InputDeviceNodeRef		createInputDeviceNode( const DeviceRef &device = Device::getDefaultInput(), const Node::Format &format = Node::Format() ) override;
+
+	//! Overridden to note that the user has provided an output, so that a default OfflineOutputNode isn't created.
+	void					setOutput( const OutputNodeRef &output ) override;
+	//! Returns the OutputNode for this Context. If one hasn't been set, an OfflineOutputNode is created.
+	const OutputNodeRef&	getOutput() override;
+	//! Returns the output cast to an OfflineOutputNode, or an empty reference if the user replaced it with a different type of OutputNode.
+	OfflineOutputNodeRef	getOfflineOutput();
+
+	//! Renders \a numFrames frames of the audio graph, rounded up to a whole number of blocks. Only \a numFrames frames are delivered to the output's TargetFile and callback.
+	void	render( size_t numFrames );
+	//! Renders \a seconds seconds of the audio graph. \see render()
+	void	renderSeconds( double seconds );
+	//! Renders a single block of the audio graph.
+	void	renderBlock();
+
+  private:
+	size_t	mSampleRate, mFramesPerBlock, mNumChannels;
+	bool	mOutputSet;
+};
+
+} } // namespace cinder::audio
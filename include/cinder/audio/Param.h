@@ -26,10 +26,11 @@
 #include "cinder/Export.h"
 #include "cinder/audio/Buffer.h"
 
-#include <list>
 #include <atomic>
 #include <functional>
+#include <mutex>
 #include <string>
+#include <vector>
 
 namespace cinder { namespace audio {
 
@@ -79,6 +80,11 @@ class CI_API Event {
 	std::string			mLabel;
 	RampFn				mRampFn;
 
+	// links within the owning Param's list of Event's being evaluated, so that the audio thread can add and remove Event's without allocating.
+	Event				*mPrev, *mNext;
+	// set once the audio thread has removed this Event and will no longer access it.
+	std::atomic<bool>	mIsRetired;
+
 	friend class Param;
 };
 
@@ -91,6 +97,9 @@ class CI_API Event {
 //! A Param is owned by a parent Node, from which it gains access to the current Context.  This is a necessary step in making it sample
 //! accurate yet still controllable in a thread-safe manager on the user thread.
 //!
+//! Ramps, setValue() and reset() are sent to the audio thread through the Context's command queue, so they never block or allocate on
+//! the audio thread. The Event's are held by the Param until the audio thread is done evaluating them.
+//!
 //! \note Ramp Events should not overlap, or you may get discontinuities in the evaluated curve. This could potentially happen when
 //! using multiple appendRamp() calls. Instead, use applyRamp() and set Options::beginTime() accordingly, which will remove any
 //! Events that would otherwise be overlapping.
@@ -173,18 +182,33 @@ class CI_API Param {
 
   protected:
 
-	// non-locking protected methods
-	void		initInternalBuffer();
-	void		resetImpl();
+	// user thread methods
+	EventRef	addEvent( double timeBegin, double timeEnd, float valueBegin, float valueEnd, bool copyValueOnBegin, bool replaceEvents, const Options &options );
+	void		resetImpl( bool setValue, float value );
+	void		removeRetiredEvents();
+
+	// audio thread methods, also called by the user thread with the Context's mutex locked
+	void		addEventImpl( Event *event, bool replaceEvents );
+	Event*		eraseEvent( Event *event );
+	void		resetEventsImpl();
 	void		removeEventsAt( double time );
+
+	void		initInternalBuffer();
 	ContextRef	getContext() const;
 
-	std::list<EventRef>	mEvents;
+	// Event's being evaluated, only accessed from the audio thread or with the Context's mutex locked.
+	Event				*mFirstEvent, *mLastEvent;
+	// Event's scheduled from user threads, owned here until the audio thread retires them.
+	std::vector<EventRef>	mScheduledEvents;
+	mutable std::mutex		mScheduledEventsMutex;
+
 	std::atomic<float>	mValue;
 	bool				mIsVaryingThisBlock;
 	Node*				mParentNode;
 	NodeRef				mProcessor;
 	BufferDynamic		mInternalBuffer;
+
+	friend class Context;
 };
 
 } } // namespace cinder::audio
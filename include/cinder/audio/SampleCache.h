@@ -0,0 +1,105 @@
+/*
+ Copyright (c) 2026, The Cinder Project
+
+ This code is intended to be used with the Cinder C++ library, http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#pragma once
+
+#include "cinder/audio/Buffer.h"
+#include "cinder/DataSource.h"
+#include "cinder/Filesystem.h"
+#include "cinder/Noncopyable.h"
+
+#include <list>
+#include <map>
+#include <mutex>
+
+namespace cinder { namespace audio {
+
+//! \brief Process-wide cache of decoded samples, so that a sample used by many BufferPlayerNode's is only decoded once.
+//!
+//! Buffers are keyed by file path and samplerate. When a disk cache directory is set, decoded samples are also written there as raw
+//! float files, which later loads (including from other processes or after a restart) memory map instead of decoding the file again.
+//! Cache files are invalidated when the source file's size or modification time changes.
+//!
+//! The least recently used buffers are released once the memory budget is exceeded. Buffers that are still referenced elsewhere
+//! are kept, since releasing them would not free any memory.
+//!
+//! \note Buffers returned by the cache are shared and must not be modified.
+class CI_API SampleCache : private Noncopyable {
+  public:
+	//! Returns the process-wide SampleCache.
+	static SampleCache* get();
+
+	//! Returns the contents of \a dataSource decoded at \a sampleRate, or at the file's native samplerate if \a sampleRate is 0. Only DataSource's that are file paths are cached.
+	BufferRef	load( const DataSourceRef &dataSource, size_t sampleRate = 0 );
+	//! Returns the contents of the file at \a filePath decoded at \a sampleRate, or at the file's native samplerate if \a sampleRate is 0.
+	BufferRef	load( const fs::path &filePath, size_t sampleRate = 0 )	{ return load( loadFile( filePath ), sampleRate ); }
+
+	//! Sets the number of bytes of decoded samples the cache keeps in memory (default = 512 MB). Evicts least recently used buffers if necessary.
+	void	setMemoryBudget( size_t bytes );
+	//! Returns the number of bytes of decoded samples the cache keeps in memory.
+	size_t	getMemoryBudget() const;
+	//! Returns the number of bytes of decoded samples currently held by the cache.
+	size_t	getMemoryUsage() const;
+	//! Returns the number of buffers currently held by the cache.
+	size_t	getNumBuffers() const;
+
+	//! Sets the directory where decoded samples are cached on disk, which is created if needed. An empty path (the default) disables the disk cache.
+	void		setDiskCacheDirectory( const fs::path &directory );
+	//! Returns the directory where decoded samples are cached on disk, or an empty path if the disk cache is disabled.
+	fs::path	getDiskCacheDirectory() const;
+
+	//! Releases all buffers held in memory. Files in the disk cache are left in place.
+	void	clear();
+
+  private:
+	SampleCache();
+
+	struct Key {
+		fs::path	mFilePath;
+		size_t		mSampleRate;
+
+		bool operator<( const Key &other ) const	{ return mSampleRate != other.mSampleRate ? mSampleRate < other.mSampleRate : mFilePath < other.mFilePath; }
+	};
+
+	struct Entry {
+		Key			mKey;
+		BufferRef	mBuffer;
+		size_t		mNumBytes;
+	};
+
+	typedef std::list<Entry>	EntryList;
+
+	// Must be called with mMutex held.
+	void	insertLocked( const Key &key, const BufferRef &buffer );
+	// Must be called with mMutex held.
+	void	evictLocked();
+
+	mutable std::mutex					mMutex;
+	EntryList							mEntries;	// most recently used first
+	std::map<Key, EntryList::iterator>	mEntryMap;
+	size_t								mMemoryBudget, mMemoryUsage;
+	fs::path							mDiskCacheDirectory;
+};
+
+} } // namespace cinder::audio
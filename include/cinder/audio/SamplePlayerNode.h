@@ -27,9 +27,7 @@
 #include "cinder/audio/Source.h"
 #include "cinder/audio/dsp/RingBuffer.h"
 
-#include <thread>
 #include <mutex>
-#include <condition_variable>
 
 namespace cinder { namespace audio {
 
@@ -37,6 +35,8 @@ typedef std::shared_ptr<class SamplePlayerNode>				SamplePlayerNodeRef;
 typedef std::shared_ptr<class BufferPlayerNode>				BufferPlayerNodeRef;
 typedef std::shared_ptr<class FilePlayerNode>				FilePlayerNodeRef;
 
+class FileReadScheduler;
+
 //! \brief Base Node class for sampled audio playback. Can do operations like seek and loop.
 //!
 //! SamplePlayerNode itself doesn't process any audio, but contains the common interface for InputNode's that do.
@@ -113,6 +113,8 @@ class CI_API BufferPlayerNode : public SamplePlayerNode {
 
 	//! Loads and stores a reference to a Buffer created from the entire contents of \a sourceFile. Resets the loop points to 0:getNumFrames()).
 	void loadBuffer( const SourceFileRef &sourceFile );
+	//! Loads the entire contents of \a dataSource through the process-wide SampleCache, so that it is only decoded once no matter how many Node's play it. Resets the loop points to 0:getNumFrames()).
+	void loadBufferCached( const DataSourceRef &dataSource );
 	//! Sets the current Buffer. Safe to do while enabled. Resets the loop points to 0:getNumFrames()).
 	void setBuffer( const BufferRef &buffer );
 	//! returns a shared_ptr to the current Buffer.
@@ -125,7 +127,11 @@ class CI_API BufferPlayerNode : public SamplePlayerNode {
 	BufferRef mBuffer;
 };
 
-//! File-based SamplePlayerNode, where samples are constantly streamed from file. Suitable for large audio files.
+//! \brief File-based SamplePlayerNode, where samples are constantly streamed from file. Suitable for large audio files.
+//!
+//! When reading asynchronously, all FilePlayerNode's share a small pool of reader threads (see setNumReadThreads()). The audio thread
+//! never blocks on file I/O; it posts a read request when its read-ahead buffer falls below half full, and the reader threads service the
+//! emptiest buffers first.
 class CI_API FilePlayerNode : public SamplePlayerNode {
   public:
 	//! Constructs a FilePlayerNode with optional \a format.
@@ -137,17 +143,31 @@ class CI_API FilePlayerNode : public SamplePlayerNode {
 	void stop() override;
 	void seek( size_t readPositionFrames ) override;
 
-	//! Returns whether reading occurs asynchronously (default is false). If true, file reading is done from an internal thread, if false it is done directly on the audio thread.
+	//! Returns whether reading occurs asynchronously (default is false). If true, file reading is done from the shared reader threads, if false it is done directly on the audio thread.
 	bool isReadAsync() const	{ return mIsReadAsync; }
 
 	//! \note \a sourceFile's samplerate is forced to match this Node's Context. Resets the loop points to 0:getNumFrames()).
 	void setSourceFile( const SourceFileRef &sourceFile );
 	const SourceFileRef& getSourceFile() const	{ return mSourceFile; }
 
+	//! Sets the number of frames buffered ahead of playback. Takes effect the next time this Node is initialized. The default of 0 uses twice the SourceFile's max frames per read, which is also the minimum.
+	void	setReadAheadFrames( size_t frames )	{ mReadAheadFrames = frames; }
+	//! Returns the number of frames buffered ahead of playback, as set with setReadAheadFrames().
+	size_t	getReadAheadFrames() const			{ return mReadAheadFrames; }
+	//! Returns how full the read-ahead buffer currently is, in the range [0:1].
+	float	getReadAheadFill() const;
+
 	//! Returns the frame of the last buffer underrun or 0 if none since the last time this method was called.
 	uint64_t getLastUnderrun();
 	//! Returns the frame of the last buffer overrun or 0 if none since the last time this method was called.
 	uint64_t getLastOverrun();
+	//! Returns the number of processing blocks that ran out of samples before the end of the file, since this Node was initialized.
+	uint64_t getNumUnderruns() const	{ return mNumUnderruns; }
+
+	//! Sets the number of threads shared by all asynchronous FilePlayerNode's for reading from file (default = 2). Values below 1 are clamped to 1.
+	static void		setNumReadThreads( size_t numThreads );
+	//! Returns the number of threads shared by all asynchronous FilePlayerNode's for reading from file.
+	static size_t	getNumReadThreads();
 
   protected:
 	void initialize()				override;
@@ -156,23 +176,28 @@ class CI_API FilePlayerNode : public SamplePlayerNode {
 	void disableProcessing()		override;
 	void process( Buffer *buffer )	override;
 
-	void readAsyncImpl();
-	void readImpl();
+	// Called from a reader thread, reads one chunk into the ring buffers. Returns true if there is room for more.
+	bool readAsyncImpl();
+	size_t readImpl();
 	void seekImpl( size_t readPos );
 	void stopImpl();
-	void destroyReadThreadImpl();
+	void removeFromReadScheduler();
 
 	std::vector<dsp::RingBuffer>				mRingBuffers;	// used to transfer samples from io to audio thread, one ring buffer per channel
 	BufferDynamic								mIoBuffer;		// used to read samples from the file on read thread, resizeable so the ringbuffer can be filled
 
 	SourceFileRef								mSourceFile;
-	size_t										mBufferFramesThreshold, mRingBufferPaddingFactor;
-	std::atomic<uint64_t>						mLastUnderrun, mLastOverrun;
+	size_t										mBufferFramesThreshold, mRingBufferPaddingFactor, mReadAheadFrames;
+	std::atomic<uint64_t>						mLastUnderrun, mLastOverrun, mNumUnderruns;
+	std::atomic<uint64_t>						mSeekGeneration;	// incremented by each seek, so that a read it overlapped doesn't advance mReadPos
+
+	std::shared_ptr<FileReadScheduler>			mReadScheduler;
+	std::mutex									mAsyncReadMutex;	// held while reading from mSourceFile on a reader thread
+	std::atomic<bool>							mReadRequested;		// set from the audio thread when the ring buffers need filling
+	bool										mReadInProgress;	// guarded by the FileReadScheduler
+	bool										mIsReadAsync;
 
-	std::unique_ptr<std::thread>				mReadThread;
-	std::mutex									mAsyncReadMutex;
-	std::condition_variable						mIssueAsyncReadCond;
-	bool										mIsReadAsync, mAsyncReadShouldQuit;
+	friend class FileReadScheduler;
 };
 
 } } // namespace cinder::audio
@@ -28,7 +28,9 @@
 #include "cinder/audio/Context.h"
 #include "cinder/audio/Device.h"
 #include "cinder/audio/Exception.h"
+#include "cinder/audio/OfflineContext.h"
 #include "cinder/audio/Param.h"
+#include "cinder/audio/SampleCache.h"
 #include "cinder/audio/Source.h"
 #include "cinder/audio/Target.h"
 #include "cinder/audio/Utilities.h"
@@ -29,6 +29,10 @@
 
 #if defined( CINDER_COCOA )
 	#define CINDER_AUDIO_VDSP
+#elif defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+	#define CINDER_AUDIO_SSE
+#elif defined( __aarch64__ ) || defined( _M_ARM64 )
+	#define CINDER_AUDIO_NEON
 #endif
 
 #include <atomic>
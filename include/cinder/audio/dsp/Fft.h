@@ -28,6 +28,7 @@
 
 #include "cinder/Cinder.h"
 
+#include <memory>
 #include <vector>
 
 #if defined( CINDER_AUDIO_VDSP )
@@ -38,7 +39,11 @@
 
 namespace cinder { namespace audio { namespace dsp {
 
-//! Real Discrete Fourier Transform (DFT).
+//! \brief Real Discrete Fourier Transform (DFT), along with complex DFTs of the same size.
+//!
+//! The sine / cosine tables (the 'plan') needed for each transform size are computed once and shared by all Fft instances of that size,
+//! so many Fft's can be created cheaply, such as one per analyzed channel. Each instance owns its own scratch space, so separate instances
+//! can be used on separate threads at the same time.
 class CI_API Fft {
   public:
 	//! Constructs an Fft object. \a fftSize must be a power of two and greater than two.
@@ -49,22 +54,39 @@ class CI_API Fft {
 	void forward( const Buffer *waveform, BufferSpectral *spectral );
 	//! Computes the Inverse DFT of \a spectral, filling \a waveform with time-domain audio data
 	void inverse( const BufferSpectral *spectral, Buffer *waveform );
+
+	//! Computes the Forward DFT of each channel of \a waveforms, filling the BufferSpectral at the same index of \a spectra.
+	//! This is faster than calling forward() for each channel, as multiple channels are transformed at once where supported.
+	void forward( const Buffer *waveforms, std::vector<BufferSpectral> *spectra );
+	//! Computes the Inverse DFT of each BufferSpectral in \a spectra, filling the channel at the same index of \a waveforms.
+	void inverse( const std::vector<BufferSpectral> *spectra, Buffer *waveforms );
+
+	//! Computes the Forward complex DFT of the getSize() complex values in \a input, defined as X[k] = sum( x[j] * exp( -2 pi i j k / n ) ), filling \a output.
+	//! Both must hold getSize() frames, ie. constructed with `BufferSpectral( fft.getSize() * 2 )`. \a input and \a output can be the same.
+	void forwardComplex( const BufferSpectral *input, BufferSpectral *output );
+	//! Computes the Inverse complex DFT of \a input, filling \a output. Scaled so that it exactly reverses forwardComplex().
+	void inverseComplex( const BufferSpectral *input, BufferSpectral *output );
+
 	//! Returns the size of the FFT.
 	size_t getSize() const	{ return mSize; }
 
+	//! Returns the number of transform sizes that currently have a plan shared between Fft instances.
+	static size_t getNumCachedPlans();
+
   protected:
+	struct Plan;
+
 	void init();
 
-	size_t				mSize, mSizeOverTwo;
+	size_t					mSize, mSizeOverTwo;
+	std::shared_ptr<Plan>	mPlan;
 
 #if defined( CINDER_AUDIO_VDSP )
 	size_t				mLog2FftSize;
-	::FFTSetup			mFftSetup;
-	::DSPSplitComplex	mSplitComplexSignal, mSplitComplexResult;
+	::DSPSplitComplex	mSplitComplexResult;
 #elif defined( CINDER_AUDIO_FFT_OOURA )
 	Buffer				mBufferCopy;
-	int					*mOouraIp;
-	float				*mOouraW;
+	Buffer				mBatchBuffer;	// holds four interleaved channels for batched transforms
 #endif
 };
 
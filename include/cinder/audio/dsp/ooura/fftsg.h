@@ -12,6 +12,10 @@ Modifications (August 2013):
 Definitions for T = float and double are declared at the bottom of fftsg.cpp
 - Removed pthreads support.
 
+Modifications (2026):
+- Added float4, a four-wide vector type that cdft() and rdft() are also instantiated with,
+so that four interleaved sequences are transformed with a single call.
+
 ========================================================================
 
 Original docs from OOURA's readme.txt:
@@ -188,8 +192,98 @@ Dec. 2006  : Fix a minor bug in "fftsg.f"
 
 #pragma once
 
+#include "cinder/audio/dsp/Dsp.h"
+
+#if defined( CINDER_AUDIO_SSE )
+	#include <emmintrin.h>
+#elif defined( CINDER_AUDIO_NEON )
+	#include <arm_neon.h>
+#endif
+
 namespace cinder { namespace audio { namespace dsp { namespace ooura {
 
+// Four floats operated on in parallel. When used as the scalar type of cdft() or rdft(), the data array holds four interleaved
+// sequences and the cos/sin table holds each value four times.
+struct float4 {
+	float4() = default;
+	float4( float value );
+	float4( float a, float b, float c, float d );
+
+	// only used while building cos/sin tables, where all four values are equal
+	explicit operator double() const;
+
+	void store( float *result ) const;
+
+	float4& operator+=( const float4 &rhs )		{ *this = *this + rhs; return *this; }
+	float4& operator-=( const float4 &rhs )		{ *this = *this - rhs; return *this; }
+	float4& operator*=( const float4 &rhs )		{ *this = *this * rhs; return *this; }
+
+	friend float4 operator+( const float4 &lhs, const float4 &rhs );
+	friend float4 operator-( const float4 &lhs, const float4 &rhs );
+	friend float4 operator*( const float4 &lhs, const float4 &rhs );
+	friend float4 operator/( const float4 &lhs, const float4 &rhs );
+	friend float4 operator-( const float4 &rhs );
+
+#if defined( CINDER_AUDIO_SSE )
+	__m128		mValue;
+#elif defined( CINDER_AUDIO_NEON )
+	float32x4_t	mValue;
+#else
+	float		mValue[4];
+#endif
+};
+
+#if defined( CINDER_AUDIO_SSE )
+
+inline float4::float4( float value ) : mValue( _mm_set1_ps( value ) )									{}
+inline float4::float4( float a, float b, float c, float d ) : mValue( _mm_setr_ps( a, b, c, d ) )		{}
+inline float4::operator double() const										{ return _mm_cvtss_f32( mValue ); }
+inline void float4::store( float *result ) const							{ _mm_storeu_ps( result, mValue ); }
+
+inline float4 operator+( const float4 &lhs, const float4 &rhs )				{ float4 r; r.mValue = _mm_add_ps( lhs.mValue, rhs.mValue ); return r; }
+inline float4 operator-( const float4 &lhs, const float4 &rhs )				{ float4 r; r.mValue = _mm_sub_ps( lhs.mValue, rhs.mValue ); return r; }
+inline float4 operator*( const float4 &lhs, const float4 &rhs )				{ float4 r; r.mValue = _mm_mul_ps( lhs.mValue, rhs.mValue ); return r; }
+inline float4 operator/( const float4 &lhs, const float4 &rhs )				{ float4 r; r.mValue = _mm_div_ps( lhs.mValue, rhs.mValue ); return r; }
+inline float4 operator-( const float4 &rhs )								{ float4 r; r.mValue = _mm_sub_ps( _mm_setzero_ps(), rhs.mValue ); return r; }
+
+#elif defined( CINDER_AUDIO_NEON )
+
+inline float4::float4( float value ) : mValue( vdupq_n_f32( value ) )									{}
+inline float4::float4( float a, float b, float c, float d )			{ float v[4] = { a, b, c, d }; mValue = vld1q_f32( v ); }
+inline float4::operator double() const										{ return vgetq_lane_f32( mValue, 0 ); }
+inline void float4::store( float *result ) const							{ vst1q_f32( result, mValue ); }
+
+inline float4 operator+( const float4 &lhs, const float4 &rhs )				{ float4 r; r.mValue = vaddq_f32( lhs.mValue, rhs.mValue ); return r; }
+inline float4 operator-( const float4 &lhs, const float4 &rhs )				{ float4 r; r.mValue = vsubq_f32( lhs.mValue, rhs.mValue ); return r; }
+inline float4 operator*( const float4 &lhs, const float4 &rhs )				{ float4 r; r.mValue = vmulq_f32( lhs.mValue, rhs.mValue ); return r; }
+inline float4 operator/( const float4 &lhs, const float4 &rhs )
+{
+	float4 r;
+#if defined( __aarch64__ ) || defined( _M_ARM64 )
+	r.mValue = vdivq_f32( lhs.mValue, rhs.mValue );
+#else
+	for( int i = 0; i < 4; i++ )
+		r.mValue[i] = lhs.mValue[i] / rhs.mValue[i];
+#endif
+	return r;
+}
+inline float4 operator-( const float4 &rhs )								{ float4 r; r.mValue = vnegq_f32( rhs.mValue ); return r; }
+
+#else
+
+inline float4::float4( float value ) : mValue{ value, value, value, value }							{}
+inline float4::float4( float a, float b, float c, float d ) : mValue{ a, b, c, d }						{}
+inline float4::operator double() const										{ return mValue[0]; }
+inline void float4::store( float *result ) const							{ for( int i = 0; i < 4; i++ ) result[i] = mValue[i]; }
+
+inline float4 operator+( const float4 &lhs, const float4 &rhs )				{ float4 r; for( int i = 0; i < 4; i++ ) r.mValue[i] = lhs.mValue[i] + rhs.mValue[i]; return r; }
+inline float4 operator-( const float4 &lhs, const float4 &rhs )				{ float4 r; for( int i = 0; i < 4; i++ ) r.mValue[i] = lhs.mValue[i] - rhs.mValue[i]; return r; }
+inline float4 operator*( const float4 &lhs, const float4 &rhs )				{ float4 r; for( int i = 0; i < 4; i++ ) r.mValue[i] = lhs.mValue[i] * rhs.mValue[i]; return r; }
+inline float4 operator/( const float4 &lhs, const float4 &rhs )				{ float4 r; for( int i = 0; i < 4; i++ ) r.mValue[i] = lhs.mValue[i] / rhs.mValue[i]; return r; }
+inline float4 operator-( const float4 &rhs )								{ float4 r; for( int i = 0; i < 4; i++ ) r.mValue[i] = -rhs.mValue[i]; return r; }
+
+#endif
+
 template <typename T> 
 void cdft(int n, int isgn, T *a, int *ip, T *w);
 
@@ -0,0 +1,87 @@
+/*
+ Copyright (c) 2026, The Cinder Project
+
+ This code is intended to be used with the Cinder C++ library, http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#pragma once
+
+#include "cinder/Cinder.h"
+#include "cinder/Area.h"
+#include "cinder/Noncopyable.h"
+
+#include <functional>
+
+namespace cinder { namespace ip {
+
+//! Controls how the ip:: routines spread their work across threads. Images are split into bands of rows which are
+//! processed by a process-wide thread pool, with the calling thread taking part.
+class CI_API ExecutionPolicy {
+  public:
+	ExecutionPolicy() : mMaxThreads( 0 ), mMinPixelsPerTask( 64 * 1024 ) {}
+
+	//! Returns a policy which runs everything on the calling thread.
+	static ExecutionPolicy	sequential()	{ return ExecutionPolicy().maxThreads( 1 ); }
+
+	//! Sets the maximum number of threads used by a call, including the calling thread. \c 0 (the default) uses one per hardware thread.
+	ExecutionPolicy&	maxThreads( size_t maxThreads )				{ mMaxThreads = maxThreads; return *this; }
+	//! Sets the smallest number of pixels worth handing to another thread. Images with fewer pixels are processed on the calling thread. Default is \c 65536.
+	ExecutionPolicy&	minPixelsPerTask( size_t minPixels )		{ mMinPixelsPerTask = minPixels; return *this; }
+
+	//! Returns the maximum number of threads, where \c 0 means one per hardware thread.
+	size_t	getMaxThreads() const			{ return mMaxThreads; }
+	//! Returns the smallest number of pixels worth handing to another thread.
+	size_t	getMinPixelsPerTask() const		{ return mMinPixelsPerTask; }
+	//! Returns the number of threads a call will use, resolving a maximum of \c 0 to the number of hardware threads.
+	size_t	getNumThreads() const;
+
+  private:
+	size_t	mMaxThreads;
+	size_t	mMinPixelsPerTask;
+};
+
+//! Sets the policy used by ip:: routines on threads without a ScopedExecutionPolicy.
+CI_API void				setDefaultExecutionPolicy( const ExecutionPolicy &policy );
+//! Returns the policy used by ip:: routines on threads without a ScopedExecutionPolicy.
+CI_API ExecutionPolicy	getDefaultExecutionPolicy();
+//! Returns the policy in effect on the calling thread, which is either that of the innermost ScopedExecutionPolicy or the default policy.
+CI_API ExecutionPolicy	getExecutionPolicy();
+
+//! Overrides the ExecutionPolicy of ip:: routines called from the current thread for the lifetime of this object.
+class CI_API ScopedExecutionPolicy : private Noncopyable {
+  public:
+	ScopedExecutionPolicy( const ExecutionPolicy &policy );
+	~ScopedExecutionPolicy();
+
+  private:
+	ExecutionPolicy			mPolicy;
+	const ExecutionPolicy	*mPrevPolicy;
+};
+
+//! Calls \a fn( taskBegin, taskEnd ) for consecutive ranges which together cover [\a begin, \a end), using up to getExecutionPolicy().getNumThreads() threads.
+//! Ranges are at least \a minItemsPerTask long, other than the last one. Returns once all ranges are complete, rethrowing the first exception thrown by \a fn.
+//! Calls made from inside \a fn run sequentially on the calling thread.
+CI_API void parallelFor( int32_t begin, int32_t end, int32_t minItemsPerTask, const std::function<void( int32_t taskBegin, int32_t taskEnd )> &fn );
+//! Calls \a fn( band ) for bands of rows which together cover \a area, in parallel according to getExecutionPolicy(). \a fn must only write to the rows of its band.
+//! Neighborhood operations which read \a halo rows above and below each band should pass it so bands stay tall enough that the rows read twice remain a small part of the work.
+CI_API void parallelForRows( const Area &area, const std::function<void( const Area &band )> &fn, int32_t halo = 0 );
+
+} } // namespace cinder::ip
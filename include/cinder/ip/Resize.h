@@ -28,6 +28,9 @@
 
 namespace cinder { namespace ip {
 
+// Resizing supports uint8_t, uint16_t and float Surfaces and Channels. Large images are filtered in bands of rows on the threads
+// allowed by the current ExecutionPolicy, and the sampled filter weights are cached between calls with the same filter and dimensions.
+
 template<typename T>
 CI_API void resize( const SurfaceT<T> &srcSurface, SurfaceT<T> *dstSurface, const FilterBase &filter = FilterTriangle() );
 template<typename T>
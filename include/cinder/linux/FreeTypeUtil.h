@@ -138,24 +138,25 @@ inline void DrawBitmap(
 	const ivec2& 		dstSize 
 )
 {
-	FT_Int i, j, p, q;
-	FT_Int x_max = offset.x + bitmap->width;
-	FT_Int y_max = offset.y + bitmap->rows;
-
-	for( j = offset.y, q = 0; j < y_max; ++j, ++q ) {
-		for( i = offset.x, p = 0; i < x_max; ++i, ++p ) {
-		 	if( i < 0 || j < 0 || i >= dstSize.x || j >= dstSize.y ) {
+	// clip the bitmap to the destination once, rather than every pixel
+	const int xBegin = std::max( offset.x, 0 ), xEnd = std::min( offset.x + (int)bitmap->width, dstSize.x );
+	const int yBegin = std::max( offset.y, 0 ), yEnd = std::min( offset.y + (int)bitmap->rows, dstSize.y );
+
+	for( int j = yBegin; j < yEnd; ++j ) {
+		const uint8_t *src = bitmap->buffer + ( j - offset.y ) * bitmap->width + ( xBegin - offset.x );
+		uint8_t *data = dstData + j*dstRowBytes + xBegin*dstPixelInc;
+		for( int i = xBegin; i < xEnd; ++i, ++src, data += dstPixelInc ) {
+			int val = *src;
+			// blending with no coverage leaves the destination unchanged
+			if( 0 == val ) {
 				continue;
 			}
-			
-			size_t index = j*dstRowBytes + i*dstPixelInc;
-			uint8_t *data = dstData + index;
+
 			int dr = *(data + 0);
 			int dg = *(data + 1);
 			int db = *(data + 2);
 			int da = *(data + 3);
 
-			int val = (bitmap->buffer[q * bitmap->width + p]);
 	  		int alpha = val + 1;
 			int invAlpha = 256 - val;
 			int r = (color.r*alpha + dr*invAlpha) >> 8;
@@ -28,8 +28,10 @@ list( APPEND SRC_SET_CINDER
 	${CINDER_SRC_DIR}/cinder/Font.cpp
 	${CINDER_SRC_DIR}/cinder/Frustum.cpp
 	${CINDER_SRC_DIR}/cinder/GeomIo.cpp
+	${CINDER_SRC_DIR}/cinder/ImageFileRaw.cpp
 	${CINDER_SRC_DIR}/cinder/ImageFileTinyExr.cpp
 	${CINDER_SRC_DIR}/cinder/ImageIo.cpp
+	${CINDER_SRC_DIR}/cinder/ImageLoadQueue.cpp
 	${CINDER_SRC_DIR}/cinder/ImageSourceFileRadiance.cpp
 	${CINDER_SRC_DIR}/cinder/ImageSourceFileStbImage.cpp
 	${CINDER_SRC_DIR}/cinder/ImageTargetFileStbImage.cpp
@@ -39,7 +41,10 @@ list( APPEND SRC_SET_CINDER
 	${CINDER_SRC_DIR}/cinder/Log.cpp
 	${CINDER_SRC_DIR}/cinder/Matrix.cpp
 	${CINDER_SRC_DIR}/cinder/MediaTime.cpp
+	${CINDER_SRC_DIR}/cinder/MemoryMappedFile.cpp
+	${CINDER_SRC_DIR}/cinder/MeshFile.cpp
 	${CINDER_SRC_DIR}/cinder/ObjLoader.cpp
+	${CINDER_SRC_DIR}/cinder/Parallel.cpp
 	${CINDER_SRC_DIR}/cinder/Path2d.cpp
 	${CINDER_SRC_DIR}/cinder/Path2dStroke.cpp
 	${CINDER_SRC_DIR}/cinder/Perlin.cpp
@@ -105,6 +110,7 @@ if( NOT CINDER_DISABLE_AUDIO )
 	list( APPEND SRC_SET_CINDER_AUDIO
 		${CINDER_SRC_DIR}/cinder/audio/ChannelRouterNode.cpp
 		${CINDER_SRC_DIR}/cinder/audio/Context.cpp
+		${CINDER_SRC_DIR}/cinder/audio/ConvolutionNode.cpp
 		${CINDER_SRC_DIR}/cinder/audio/DelayNode.cpp
 		${CINDER_SRC_DIR}/cinder/audio/Device.cpp
 		${CINDER_SRC_DIR}/cinder/audio/FileOggVorbis.cpp
@@ -113,10 +119,12 @@ if( NOT CINDER_DISABLE_AUDIO )
 		${CINDER_SRC_DIR}/cinder/audio/InputNode.cpp
 		${CINDER_SRC_DIR}/cinder/audio/Node.cpp
 		${CINDER_SRC_DIR}/cinder/audio/NodeMath.cpp
+		${CINDER_SRC_DIR}/cinder/audio/OfflineContext.cpp
 		${CINDER_SRC_DIR}/cinder/audio/MonitorNode.cpp
 		${CINDER_SRC_DIR}/cinder/audio/OutputNode.cpp
 		${CINDER_SRC_DIR}/cinder/audio/PanNode.cpp
 		${CINDER_SRC_DIR}/cinder/audio/Param.cpp
+		${CINDER_SRC_DIR}/cinder/audio/SampleCache.cpp
 		${CINDER_SRC_DIR}/cinder/audio/SamplePlayerNode.cpp
 		${CINDER_SRC_DIR}/cinder/audio/SampleRecorderNode.cpp
 		${CINDER_SRC_DIR}/cinder/audio/Source.cpp
@@ -194,6 +202,7 @@ list( APPEND SRC_SET_CINDER_IP
 	${CINDER_SRC_DIR}/cinder/ip/Premultiply.cpp
 	${CINDER_SRC_DIR}/cinder/ip/Threshold.cpp
 	${CINDER_SRC_DIR}/cinder/ip/EdgeDetect.cpp
+	${CINDER_SRC_DIR}/cinder/ip/Execution.cpp
 	${CINDER_SRC_DIR}/cinder/ip/Flip.cpp
 	${CINDER_SRC_DIR}/cinder/ip/Hdr.cpp
 	${CINDER_SRC_DIR}/cinder/ip/Resize.cpp
@@ -335,3 +335,20 @@ function( ci_make_app )
 	endif()
 
 endfunction()
+
+#
+# ci_make_benchmark( APP_NAME <name> CINDER_PATH <path> SOURCES <src1> [<src2> ...] [<other ci_make_app arguments>] )
+#
+# Builds a console app under test/, such as a benchmark, with ci_make_app(). These print their results,
+# so the target is not built as a WIN32 (windowed) executable. APP_NAME defaults to the project name.
+# Build benchmarks in Release mode, otherwise their numbers are meaningless.
+#
+function( ci_make_benchmark )
+	cmake_parse_arguments( ARG "" "APP_NAME" "" ${ARGN} )
+	if( NOT ARG_APP_NAME )
+		set( ARG_APP_NAME "${PROJECT_NAME}" )
+	endif()
+
+	ci_make_app( APP_NAME ${ARG_APP_NAME} ${ARG_UNPARSED_ARGUMENTS} )
+	set_target_properties( ${ARG_APP_NAME} PROPERTIES WIN32_EXECUTABLE FALSE )
+endfunction()
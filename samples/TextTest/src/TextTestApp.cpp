@@ -28,8 +28,8 @@ class TextTestApp : public App {
 void printFontNames()
 {
 
-	for( vector<string>::const_iterator fontName = Font::getNames().begin(); fontName != Font::getNames().end(); ++fontName )
-		console() << *fontName << endl;
+	for( const string &fontName : Font::getNames() )
+		console() << fontName << endl;
 }
 
 void TextTestApp::setup()
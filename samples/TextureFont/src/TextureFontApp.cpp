@@ -55,8 +55,9 @@ void TextureFontApp::keyDown( KeyEvent event )
 
 void TextureFontApp::mouseDown( MouseEvent event )
 {
+	const auto fontNames = Font::getNames();
 	while( true ) { // find the next random font with a letter 'a' in it
-		mFont = Font( Font::getNames()[Rand::randInt() % Font::getNames().size()], mFont.getSize() );
+		mFont = Font( fontNames[Rand::randInt() % fontNames.size()], mFont.getSize() );
 		if( mFont.getGlyphChar( 'a' ) == 0 )
 			continue;
 		console() << mFont.getName() << std::endl;
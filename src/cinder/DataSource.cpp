@@ -191,4 +191,37 @@ IStreamRef DataSourceBuffer::createStream()
 	return IStreamMem::create( mBuffer->getData(), mBuffer->getSize() );
 }
 
+/////////////////////////////////////////////////////////////////////////////
+// DataSourceMemoryMapped
+DataSourceMemoryMappedRef DataSourceMemoryMapped::create( const fs::path &path )
+{
+	return DataSourceMemoryMappedRef( new DataSourceMemoryMapped( path ) );
+}
+
+DataSourceMemoryMapped::DataSourceMemoryMapped( const fs::path &path )
+	: DataSource( path, Url() ), mFile( MemoryMappedFile::create( path ) )
+{
+	setFilePathHint( path );
+}
+
+void DataSourceMemoryMapped::createBuffer()
+{
+	// the Buffer doesn't own the mapped memory, so its deleter holds on to the mapping instead
+	MemoryMappedFileRef file = mFile;
+	mBuffer = BufferRef( new Buffer( const_cast<void*>( file->getData() ), file->getSize() ), [file]( Buffer *buffer ) { delete buffer; } );
+}
+
+IStreamRef DataSourceMemoryMapped::createStream()
+{
+	// likewise the stream may outlive this DataSource, so its deleter holds on to the mapping as well as the stream
+	MemoryMappedFileRef file = mFile;
+	IStreamMemRef stream = IStreamMem::create( file->getData(), file->getSize() );
+	return IStreamRef( stream.get(), [stream, file]( IStreamCinder * ) {} );
+}
+
+DataSourceRef loadFileMapped( const fs::path &path )
+{
+	return DataSourceMemoryMapped::create( path );
+}
+
 } // namespace cinder
\ No newline at end of file
@@ -27,6 +27,20 @@
 #include "cinder/Log.h"
 #include "cinder/Utilities.h"
 
+#include <cmath>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+
+#if defined( CINDER_LINUX )
+	#include <sys/inotify.h>
+	#include <sys/eventfd.h>
+	#include <poll.h>
+	#include <unistd.h>
+	#include <cerrno>
+	#include <cstring>
+#endif
+
 //#define LOG_UPDATE( stream )	CI_LOG_I( stream )
 #define LOG_UPDATE( stream )	( (void)( 0 ) )
 
@@ -38,12 +52,17 @@ namespace cinder {
 //! Base class for Watch types, which are returned from FileWatcher::load() and watch()
 class Watch : public std::enable_shared_from_this<Watch>, private Noncopyable {
   public:
-	Watch( const std::vector<fs::path> &filePaths, bool needsCallback );
+	Watch( const std::vector<fs::path> &filePaths, bool needsCallback, bool recursive );
 
 	signals::Connection	connect( const function<void ( const WatchEvent& )> &callback )	{ return mSignalChanged.connect( callback ); }
 
 	//! Checks if the asset file is up-to-date. Also may discard the Watch if there are no more connected slots.
 	void checkCurrent();
+	//! Discards the Watch if there are no more connected slots. Returns whether it is discarded.
+	bool discardIfDisconnected();
+	//! Records that \a filePath was modified if it is one of the enabled files or inside one of the enabled directories, and returns whether it was.
+	//! If \a checkTimeStamp is true, \a filePath is only considered modified if its last write time advanced.
+	bool notifyModified( const fs::path &filePath, bool checkTimeStamp );
 	//! Remove any watches for \a filePath. If it is the last file associated with this Watch, discard
 	void unwatch( const fs::path &filePath );
 	//! Emit the signal callback. 
@@ -63,18 +82,29 @@ class Watch : public std::enable_shared_from_this<Watch>, private Noncopyable {
 	class WatchItem {
 	  public:
 		WatchItem( const fs::path& path, const fs::file_time_type& timeStamp, bool enabled )
-			: mFilePath( path ), mTimeStamp( timeStamp ), mEnabled( enabled ), mErrors( 0 )
+			: mFilePath( path ), mTimeStamp( timeStamp ), mEnabled( enabled ), mErrors( 0 ), mIsDirectory( false ), mRecursive( false )
 		{}
 		
 		fs::path			mFilePath;
 		fs::file_time_type	mTimeStamp;
 		bool				mEnabled;
 		int8_t				mErrors;
+
+		// directories report the files inside them, whose last write times are kept in mFileTimeStamps
+		bool				mIsDirectory;
+		bool				mRecursive;
+		std::map<fs::path, fs::file_time_type>	mFileTimeStamps;
+		// the directories that receive OS notifications on behalf of this item, with Backend::NATIVE
+		std::vector<fs::path>	mNativeDirectories;
 	};
 
 	const std::vector<WatchItem>&	getItems() const	{ return mWatchItems; }
+	std::vector<WatchItem>&			getItems()			{ return mWatchItems; }
 
   private:
+	void addModifiedFilePath( const fs::path &filePath );
+	void checkDirectory( WatchItem *item, bool reportChanges );
+
 	bool mDiscarded = false;
 	bool mEnabled = true;
 	bool mNeedsCallback = false;
@@ -102,6 +132,33 @@ fs::path findFullFilePath( const fs::path &filePath )
 	return resolvedAssetPath;
 }
 
+// Calls \a fn with every regular file inside \a dir, including those in subdirectories if \a recursive is true.
+template<typename FnT>
+void forEachFile( const fs::path &dir, bool recursive, const FnT &fn )
+{
+	error_code ec;
+	if( recursive ) {
+		for( fs::recursive_directory_iterator it( dir, fs::directory_options::skip_permission_denied, ec ), end; it != end; it.increment( ec ) ) {
+			if( it->is_regular_file( ec ) )
+				fn( it->path() );
+		}
+	}
+	else {
+		for( fs::directory_iterator it( dir, ec ), end; it != end; it.increment( ec ) ) {
+			if( it->is_regular_file( ec ) )
+				fn( it->path() );
+		}
+	}
+}
+
+bool isInsideDirectory( const fs::path &filePath, const fs::path &dir, bool recursive )
+{
+	if( ! recursive )
+		return filePath.parent_path() == dir;
+
+	return mismatch( dir.begin(), dir.end(), filePath.begin(), filePath.end() ).first == dir.end() && filePath != dir;
+}
+
 // Used from the debugger.
 void debugPrintWatches( const std::list<std::unique_ptr<Watch>>&watchList )
 {
@@ -139,12 +196,21 @@ double getElapsedSeconds()
 // Watch
 // ----------------------------------------------------------------------------------------------------
 
-Watch::Watch( const vector<fs::path> &filePaths, bool needsCallback )
+Watch::Watch( const vector<fs::path> &filePaths, bool needsCallback, bool recursive )
 {
 	mWatchItems.reserve( filePaths.size() );
 	for( const auto &fp : filePaths ) {
 		auto fullPath = findFullFilePath( fp );
+		if( fs::is_directory( fullPath ) && ! fullPath.has_filename() )
+			fullPath = fullPath.parent_path();
+
 		mWatchItems.push_back( { fullPath, fs::last_write_time( fullPath ), true } );
+		if( fs::is_directory( fullPath ) ) {
+			auto &item = mWatchItems.back();
+			item.mIsDirectory = true;
+			item.mRecursive = recursive;
+			checkDirectory( &item, false );
+		}
 	}
 
 	if( needsCallback ) {
@@ -160,13 +226,17 @@ Watch::Watch( const vector<fs::path> &filePaths, bool needsCallback )
 void Watch::checkCurrent()
 {
 	// Discard when there are no more connected slots
-	if( mSignalChanged.getNumSlots() == 0 ) {
-		markDiscarded();
+	if( discardIfDisconnected() )
 		return;
-	}
 
 	mModifiedFilePaths.clear();
 	for( auto &item : mWatchItems ) {
+		if( item.mIsDirectory ) {
+			if( item.mEnabled )
+				checkDirectory( &item, true );
+			continue;
+		}
+
 		try {
 			if( item.mEnabled && fs::exists( item.mFilePath ) ) {
 				auto timeLastWrite = fs::last_write_time( item.mFilePath );
@@ -190,6 +260,78 @@ void Watch::checkCurrent()
 	}
 }
 
+bool Watch::discardIfDisconnected()
+{
+	if( mSignalChanged.getNumSlots() == 0 )
+		markDiscarded();
+
+	return isDiscarded();
+}
+
+// Records the last write times of the files inside a directory item. If \a reportChanges is true, files that are new or were
+// modified since the last check are marked as modified.
+void Watch::checkDirectory( WatchItem *item, bool reportChanges )
+{
+	map<fs::path, fs::file_time_type> timeStamps;
+	forEachFile( item->mFilePath, item->mRecursive, [&]( const fs::path &filePath ) {
+		error_code ec;
+		auto timeLastWrite = fs::last_write_time( filePath, ec );
+		if( ec )
+			return;
+
+		auto existing = item->mFileTimeStamps.find( filePath );
+		if( reportChanges && ( existing == item->mFileTimeStamps.end() || existing->second < timeLastWrite ) ) {
+			addModifiedFilePath( filePath );
+			setNeedsCallback( true );
+		}
+		timeStamps[filePath] = timeLastWrite;
+	} );
+
+	// forget about removed files
+	item->mFileTimeStamps.swap( timeStamps );
+}
+
+bool Watch::notifyModified( const fs::path &filePath, bool checkTimeStamp )
+{
+	bool result = false;
+	for( auto &item : mWatchItems ) {
+		if( ! item.mEnabled )
+			continue;
+
+		fs::file_time_type *timeStamp;
+		if( item.mIsDirectory && isInsideDirectory( filePath, item.mFilePath, item.mRecursive ) )
+			timeStamp = &item.mFileTimeStamps.emplace( filePath, fs::file_time_type::min() ).first->second; // new files count as modified
+		else if( ! item.mIsDirectory && item.mFilePath == filePath )
+			timeStamp = &item.mTimeStamp;
+		else
+			continue;
+
+		// files that no longer exist, such as temporary files that were renamed by the time the change is reported, are skipped
+		error_code ec;
+		auto timeLastWrite = fs::last_write_time( filePath, ec );
+		if( ec || ! fs::is_regular_file( filePath, ec ) ) {
+			if( item.mIsDirectory )
+				item.mFileTimeStamps.erase( filePath );
+			continue;
+		}
+		if( checkTimeStamp && ! ( *timeStamp < timeLastWrite ) )
+			continue;
+
+		*timeStamp = timeLastWrite;
+		addModifiedFilePath( filePath );
+		setNeedsCallback( true );
+		result = true;
+	}
+
+	return result;
+}
+
+void Watch::addModifiedFilePath( const fs::path &filePath )
+{
+	if( find( mModifiedFilePaths.begin(), mModifiedFilePaths.end(), filePath ) == mModifiedFilePaths.end() )
+		mModifiedFilePaths.push_back( filePath );
+}
+
 void Watch::unwatch( const fs::path &filePath ) 
 {
 	mWatchItems.erase( remove_if( mWatchItems.begin(), mWatchItems.end(),
@@ -211,6 +353,8 @@ void Watch::setEnabled( bool enable, const fs::path &filePath )
 			// update the timestamp so that any modifications while
 			// the watch was disabled don't trigger a callback
 			item.mTimeStamp = fs::last_write_time( item.mFilePath );
+			if( item.mIsDirectory )
+				checkDirectory( &item, false );
 		}
 	}
 }
@@ -221,8 +365,314 @@ void Watch::emitCallback()
 
 	mSignalChanged.emit( event );
 	setNeedsCallback( false );
+	mModifiedFilePaths.clear();
 } 
 
+// ----------------------------------------------------------------------------------------------------
+// FileWatcher::NativeImpl
+// ----------------------------------------------------------------------------------------------------
+
+typedef std::list<std::unique_ptr<Watch>>::iterator WatchIter;
+
+#if defined( CINDER_LINUX )
+
+// Receives changes through inotify. Rather than watching each file, inotify watches the directories that contain watched files,
+// which needs far fewer watch descriptors and keeps working when editors replace a file by renaming another one over it.
+// Everything except waitForEvents() and wake() expects the FileWatcher's mutex to be locked.
+class FileWatcher::NativeImpl : private Noncopyable {
+  public:
+	NativeImpl()
+	{
+		mFd = inotify_init1( IN_NONBLOCK | IN_CLOEXEC );
+		if( mFd < 0 )
+			throw FileWatcherException( string( "inotify_init1() failed: " ) + strerror( errno ) );
+
+		mWakeFd = eventfd( 0, EFD_NONBLOCK | EFD_CLOEXEC );
+		if( mWakeFd < 0 ) {
+			close( mFd );
+			throw FileWatcherException( string( "eventfd() failed: " ) + strerror( errno ) );
+		}
+	}
+
+	~NativeImpl()
+	{
+		close( mWakeFd );
+		close( mFd );
+	}
+
+	//! Starts receiving changes for all files of \a it.
+	void addWatch( WatchIter it )
+	{
+		for( auto &item : (*it)->getItems() ) {
+			mWatches[item.mFilePath.string()].push_back( it );
+			if( item.mIsDirectory )
+				addDirectoryTree( item.mFilePath, &item, false );
+			else
+				addDirectory( item.mFilePath.parent_path(), &item );
+		}
+	}
+
+	//! Stops receiving changes for \a it, which needs to happen before its items are changed or it is destroyed.
+	void removeWatch( WatchIter it )
+	{
+		for( auto &item : (*it)->getItems() ) {
+			auto watchesIt = mWatches.find( item.mFilePath.string() );
+			if( watchesIt != mWatches.end() ) {
+				auto &watches = watchesIt->second;
+				watches.erase( remove( watches.begin(), watches.end(), it ), watches.end() );
+				if( watches.empty() )
+					mWatches.erase( watchesIt );
+			}
+
+			for( const auto &dir : item.mNativeDirectories )
+				removeDirectory( dir );
+			item.mNativeDirectories.clear();
+		}
+	}
+
+	//! Returns true once changes are available, or false after \a seconds or a call to wake().
+	bool waitForEvents( double seconds )
+	{
+		pollfd fds[2] = { { mFd, POLLIN, 0 }, { mWakeFd, POLLIN, 0 } };
+		int result = poll( fds, 2, (int)std::ceil( seconds * 1000 ) );
+		if( result > 0 && ( fds[1].revents & POLLIN ) ) {
+			uint64_t value;
+			ssize_t bytesRead = read( mWakeFd, &value, sizeof( value ) );
+			(void)bytesRead;
+			return false;
+		}
+
+		return result > 0 && ( fds[0].revents & POLLIN );
+	}
+
+	//! Makes waitForEvents() return immediately. Can be called from any thread.
+	void wake()
+	{
+		uint64_t value = 1;
+		ssize_t bytesWritten = write( mWakeFd, &value, sizeof( value ) );
+		(void)bytesWritten;
+	}
+
+	//! Reads all pending events, collecting the paths that changed until dispatchEvents() is called.
+	void readEvents()
+	{
+		alignas( inotify_event ) char buffer[16 * 1024];
+		while( true ) {
+			ssize_t length = read( mFd, buffer, sizeof( buffer ) );
+			if( length <= 0 )
+				break;
+
+			for( char *ptr = buffer; ptr < buffer + length; ) {
+				const inotify_event *event = reinterpret_cast<const inotify_event*>( ptr );
+				ptr += sizeof( inotify_event ) + event->len;
+				processEvent( *event );
+			}
+		}
+	}
+
+	//! Reports the changes collected by readEvents() to the Watches, returning the ones that now need their callbacks emitted.
+	//! Sets \a overflowed if the OS discarded events, in which case all Watches need to be checked.
+	vector<WatchIter> dispatchEvents( bool *overflowed )
+	{
+		rearmRemovedDirectories();
+
+		// watch new subdirectories of recursively watched directories, and report files that were created before the watch was added
+		for( const auto &dir : mNewDirectories ) {
+			for( WatchIter it : findWatches( dir ) ) {
+				for( auto &item : (*it)->getItems() ) {
+					if( item.mIsDirectory && item.mRecursive && isInsideDirectory( dir, item.mFilePath, true ) ) {
+						addDirectoryTree( dir, &item, true );
+						forEachFile( dir, true, [this]( const fs::path &filePath ) { mChanges.insert( { filePath, false } ); } );
+					}
+				}
+			}
+		}
+
+		vector<WatchIter> result;
+		for( const auto &change : mChanges ) {
+			for( WatchIter it : findWatches( change.first ) ) {
+				if( (*it)->notifyModified( change.first, ! change.second ) )
+					result.push_back( it );
+			}
+		}
+
+		*overflowed = mOverflowed;
+		mOverflowed = false;
+		mNewDirectories.clear();
+		mChanges.clear();
+		return result;
+	}
+
+	//! Watches directories that were removed again once they have been recreated, reporting the files inside them. Returns whether
+	//! there are changes for dispatchEvents().
+	bool rearmRemovedDirectories()
+	{
+		for( auto it = mRemovedDirectories.begin(); it != mRemovedDirectories.end(); /* */ ) {
+			auto directoryIt = mDirectories.find( *it );
+			if( directoryIt != mDirectories.end() && directoryIt->second.mWd < 0 ) {
+				fs::path dir = *it;
+				int wd = inotify_add_watch( mFd, dir.c_str(), DIRECTORY_MASK );
+				if( wd < 0 ) {
+					++it;
+					continue;
+				}
+
+				directoryIt->second.mWd = wd;
+				mDirectoryPaths[wd] = dir;
+				forEachFile( dir, false, [this]( const fs::path &filePath ) { mChanges.insert( { filePath, false } ); } );
+			}
+			it = mRemovedDirectories.erase( it );
+		}
+
+		return ! mChanges.empty();
+	}
+
+	//! Returns whether there are watched directories that were removed.
+	bool hasRemovedDirectories() const	{ return ! mRemovedDirectories.empty(); }
+
+  private:
+	static const uint32_t DIRECTORY_MASK = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_MODIFY | IN_ATTRIB | IN_ONLYDIR;
+
+	struct Directory {
+		int		mWd = -1;
+		int		mRefCount = 0;
+	};
+
+	void processEvent( const inotify_event &event )
+	{
+		if( event.mask & IN_Q_OVERFLOW ) {
+			mOverflowed = true;
+			return;
+		}
+
+		auto dirIt = mDirectoryPaths.find( event.wd );
+		if( dirIt == mDirectoryPaths.end() )
+			return;
+
+		// the directory itself was removed, it is watched again by rearmRemovedDirectories() if it is recreated
+		if( event.mask & IN_IGNORED ) {
+			auto directoryIt = mDirectories.find( dirIt->second.string() );
+			if( directoryIt != mDirectories.end() && directoryIt->second.mWd == event.wd ) {
+				directoryIt->second.mWd = -1;
+				mRemovedDirectories.insert( directoryIt->first );
+			}
+			mDirectoryPaths.erase( dirIt );
+			return;
+		}
+
+		if( event.len == 0 )
+			return;
+
+		fs::path path = dirIt->second / event.name;
+		if( event.mask & IN_ISDIR ) {
+			if( event.mask & ( IN_CREATE | IN_MOVED_TO ) )
+				mNewDirectories.push_back( path );
+			return;
+		}
+
+		// files that were written and closed or moved into place are reported even if their last write time didn't advance, other
+		// events (such as the attributes or last write time changing) only if it did
+		bool &contentChanged = mChanges[path];
+		contentChanged = contentChanged || ( event.mask & ( IN_CLOSE_WRITE | IN_MOVED_TO ) );
+	}
+
+	void addDirectory( const fs::path &dir, Watch::WatchItem *item )
+	{
+		auto &directory = mDirectories[dir.string()];
+		if( directory.mRefCount++ == 0 || directory.mWd < 0 ) {
+			directory.mWd = inotify_add_watch( mFd, dir.c_str(), DIRECTORY_MASK );
+			if( directory.mWd >= 0 ) {
+				mDirectoryPaths[directory.mWd] = dir;
+				mRemovedDirectories.erase( dir.string() );
+			}
+			else if( errno == ENOSPC )
+				CI_LOG_W( "reached the limit of inotify watches (see /proc/sys/fs/inotify/max_user_watches), changes in " << dir << " will be missed" );
+			else
+				CI_LOG_W( "inotify_add_watch() failed for " << dir << ": " << strerror( errno ) );
+		}
+
+		item->mNativeDirectories.push_back( dir );
+	}
+
+	void addDirectoryTree( const fs::path &dir, Watch::WatchItem *item, bool recursive )
+	{
+		addDirectory( dir, item );
+		if( ! ( recursive || item->mRecursive ) )
+			return;
+
+		error_code ec;
+		for( fs::recursive_directory_iterator it( dir, fs::directory_options::skip_permission_denied, ec ), end; it != end; it.increment( ec ) ) {
+			if( it->is_directory( ec ) && ! it->is_symlink( ec ) )
+				addDirectory( it->path(), item );
+		}
+	}
+
+	void removeDirectory( const fs::path &dir )
+	{
+		auto directoryIt = mDirectories.find( dir.string() );
+		if( directoryIt == mDirectories.end() || --directoryIt->second.mRefCount > 0 )
+			return;
+
+		if( directoryIt->second.mWd >= 0 ) {
+			inotify_rm_watch( mFd, directoryIt->second.mWd );
+			mDirectoryPaths.erase( directoryIt->second.mWd );
+		}
+		mRemovedDirectories.erase( directoryIt->first );
+		mDirectories.erase( directoryIt );
+	}
+
+	// Returns the Watches with an item at \a path or at one of its parent directories.
+	vector<WatchIter> findWatches( const fs::path &path ) const
+	{
+		vector<WatchIter> result;
+		for( fs::path p = path; ; p = p.parent_path() ) {
+			auto watchesIt = mWatches.find( p.string() );
+			if( watchesIt != mWatches.end() ) {
+				for( WatchIter it : watchesIt->second ) {
+					if( find( result.begin(), result.end(), it ) == result.end() )
+						result.push_back( it );
+				}
+			}
+
+			if( ! p.has_relative_path() )
+				break;
+		}
+
+		return result;
+	}
+
+	int		mFd, mWakeFd;
+	bool	mOverflowed = false;
+
+	// Watches by the path of their items
+	unordered_map<string, vector<WatchIter>>	mWatches;
+	unordered_map<string, Directory>			mDirectories;
+	unordered_map<int, fs::path>				mDirectoryPaths;
+	// directories that were removed while they were watched, by path
+	unordered_set<string>						mRemovedDirectories;
+
+	// collected by readEvents(), keyed by path with whether the file's contents changed
+	map<fs::path, bool>		mChanges;
+	vector<fs::path>		mNewDirectories;
+};
+
+#else
+
+// Not available, FileWatcher falls back to Backend::POLLING
+class FileWatcher::NativeImpl {
+  public:
+	void				addWatch( WatchIter /*it*/ )					{}
+	void				removeWatch( WatchIter /*it*/ )					{}
+	bool				waitForEvents( double /*seconds*/ )				{ return false; }
+	void				wake()											{}
+	void				readEvents()									{}
+	vector<WatchIter>	dispatchEvents( bool * /*overflowed*/ )			{ return {}; }
+	bool				hasRemovedDirectories() const					{ return false; }
+	bool				rearmRemovedDirectories()						{ return false; }
+};
+
+#endif
+
 // ----------------------------------------------------------------------------------------------------
 // FileWatcher
 // ----------------------------------------------------------------------------------------------------
@@ -234,8 +684,20 @@ FileWatcher& FileWatcher::instance()
 	return sInstance;
 }
 
-FileWatcher::FileWatcher()
+FileWatcher::FileWatcher( Backend backend )
 {
+#if defined( CINDER_LINUX )
+	if( backend == Backend::NATIVE ) {
+		try {
+			mNative.reset( new NativeImpl );
+		}
+		catch( FileWatcherException &exc ) {
+			CI_LOG_EXCEPTION( "falling back to polling", exc );
+		}
+	}
+#endif
+
+	mBackend = mNative ? Backend::NATIVE : Backend::POLLING;
 }
 
 FileWatcher::~FileWatcher()
@@ -288,12 +750,14 @@ signals::Connection FileWatcher::watch( const vector<fs::path> &filePaths, const
 
 signals::Connection FileWatcher::watch( const vector<fs::path> &filePaths, const Options &options, const function<void ( const WatchEvent& )> &callback )
 {
-	auto watch = new Watch( filePaths, options.mCallOnWatch );
+	auto watch = new Watch( filePaths, options.mCallOnWatch, options.mRecursive );
 	auto conn = watch->connect( callback );
 
 	lock_guard<recursive_mutex> lock( mMutex );
 
 	mWatchList.emplace_back( watch );
+	if( mNative )
+		mNative->addWatch( prev( mWatchList.end() ) );
 
 	if( options.mCallOnWatch )
 		watch->emitCallback();
@@ -311,11 +775,19 @@ void FileWatcher::unwatch( const fs::path &filePath )
 	
 	for( auto it = mWatchList.begin(); it != mWatchList.end(); /* */ ) {
 		const auto &watch = *it;
+		const auto &items = watch->getItems();
+		const bool watchesPath = any_of( items.begin(), items.end(), [&fullPath]( const Watch::WatchItem &item ) { return item.mFilePath == fullPath; } );
+
+		// the Watch's items change, so its OS notifications are set up again
+		if( mNative && watchesPath )
+			mNative->removeWatch( it );
 		watch->unwatch( fullPath );
 		if( watch->isDiscarded() ) {
-			it = mWatchList.erase( it );
+			it = eraseWatch( it );
 			continue;
 		}
+		if( mNative && watchesPath )
+			mNative->addWatch( it );
 		++it;
 	}
 }
@@ -359,7 +831,7 @@ void FileWatcher::configureWatchPolling()
 
 	if( ! mThread.joinable() ) {
 		mThreadShouldQuit = false;
-		mThread = thread( std::bind( &FileWatcher::threadEntry, this ) );
+		mThread = thread( std::bind( mNative ? &FileWatcher::threadEntryNative : &FileWatcher::threadEntry, this ) );
 	}
 }
 
@@ -368,6 +840,8 @@ void FileWatcher::stopWatchPolling()
 	mConnectionAppUpdate.disconnect();
 
 	mThreadShouldQuit = true;
+	if( mNative )
+		mNative->wake();
 	if( mThread.joinable() ) {
 		mThread.join();
 	}
@@ -391,7 +865,7 @@ void FileWatcher::threadEntry()
                 
                 // erase discarded
                 if( watch->isDiscarded() ) {
-                    it = mWatchList.erase( it );
+                    it = eraseWatch( it );
                     continue;
                 }
                 // check if Watch's target has been modified and needs a callback, if not already marked.
@@ -412,6 +886,70 @@ void FileWatcher::threadEntry()
 	}
 }
 
+void FileWatcher::threadEntryNative()
+{
+	setThreadName( "cinder::FileWatcher" );
+
+	// Watches whose callbacks were all disconnected and watched directories that were recreated are only found by looking, which is
+	// done at this interval
+	const auto checkInterval = chrono::milliseconds( 500 );
+	auto lastCheck = chrono::steady_clock::now();
+
+	while( ! mThreadShouldQuit ) {
+		bool rearmed = false;
+		if( chrono::steady_clock::now() - lastCheck >= checkInterval ) {
+			lock_guard<recursive_mutex> lock( mMutex );
+			for( auto it = mWatchList.begin(); it != mWatchList.end(); /* */ ) {
+				if( (*it)->discardIfDisconnected() ) {
+					it = eraseWatch( it );
+					continue;
+				}
+				++it;
+			}
+			rearmed = mNative->hasRemovedDirectories() && mNative->rearmRemovedDirectories();
+			lastCheck = chrono::steady_clock::now();
+		}
+
+		if( rearmed || mNative->waitForEvents( mThreadUpdateInterval ) ) {
+			// keep reading until there have been no changes for the coalesce interval, so that a file that is saved in several steps
+			// is only reported once, after it is complete. Files that are written continuously are reported at ten times the interval.
+			const auto coalesceEnd = chrono::steady_clock::now() + chrono::duration<double>( mCoalesceInterval * 10 );
+			do {
+				lock_guard<recursive_mutex> lock( mMutex );
+				mNative->readEvents();
+			} while( ! mThreadShouldQuit && chrono::steady_clock::now() < coalesceEnd && mNative->waitForEvents( mCoalesceInterval ) );
+
+			lock_guard<recursive_mutex> lock( mMutex );
+
+			bool overflowed;
+			auto modified = mNative->dispatchEvents( &overflowed );
+			if( overflowed ) {
+				// changes were lost, so check all Watches the same way as polling does
+				CI_LOG_W( "inotify event queue overflowed, checking all files" );
+				for( auto it = mWatchList.begin(); it != mWatchList.end(); ++it ) {
+					if( ! (*it)->needsCallback() && ! (*it)->isDiscarded() ) {
+						(*it)->checkCurrent();
+						if( (*it)->needsCallback() )
+							modified.push_back( it );
+					}
+				}
+			}
+
+			// Watches that need a callback go to the front of the list, see update()
+			for( WatchIter it : modified )
+				mWatchList.splice( mWatchList.begin(), mWatchList, it );
+		}
+	}
+}
+
+std::list<std::unique_ptr<Watch>>::iterator FileWatcher::eraseWatch( std::list<std::unique_ptr<Watch>>::iterator it )
+{
+	if( mNative )
+		mNative->removeWatch( it );
+
+	return mWatchList.erase( it );
+}
+
 void FileWatcher::update()
 {
 	LOG_UPDATE( "elapsed seconds: " << getElapsedSeconds() );
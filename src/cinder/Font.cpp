@@ -47,6 +47,7 @@
 	#include FT_FREETYPE_H 
 	#include FT_OUTLINE_H 
  	#include "cinder/linux/FreeTypeUtil.h" 
+	#include "cinder/Text.h"
 	#include <set>
  	#if defined( CINDER_ANDROID )
 		#include "freetype/ftsnames.h"
@@ -58,6 +59,8 @@
 #include "cinder/Utilities.h"
 #include "cinder/Unicode.h"
 
+#include <mutex>
+
 using std::vector;
 using std::string;
 using std::wstring;
@@ -107,9 +110,10 @@ class FontManager
 
 	static FontManager*		instance();
 
-	const vector<string>&	getNames( bool forceRefresh );
+	vector<string>			getNames( bool forceRefresh );
 	Font					getDefault() const
 	{
+		std::lock_guard<std::recursive_mutex> lock( mMutex );
 		if( ! mDefault )
 #if defined( CINDER_COCOA )        
             mDefault = Font( "Helvetica", 12 );
@@ -139,6 +143,10 @@ class FontManager
 	FontManager();
 
 	static FontManager*	sInstance;
+	static std::mutex	sInstanceMutex;
+
+	// guards the font names, the default font and the tracked fonts. Recursive since creating the default font tracks it.
+	mutable std::recursive_mutex	mMutex;
 
 	bool				mFontsEnumerated;
 	vector<string>		mFontNames;
@@ -165,9 +173,11 @@ class FontManager
 #if defined( CINDER_ANDROID ) || defined( CINDER_LINUX )
 	std::set<std::shared_ptr<ci::FontObj>>	mTrackedFonts;
 	void fontCreated( const std::shared_ptr<ci::FontObj>& fontObj ) {
+		std::lock_guard<std::recursive_mutex> lock( mMutex );
 		mTrackedFonts.insert( fontObj );
 	}
 	void fontDestroyed( const std::shared_ptr<ci::FontObj>& fontObj ) {
+		std::lock_guard<std::recursive_mutex> lock( mMutex );
 		if( fontObj ) {
 			fontObj->releaseFreeTypeFace();
 		}
@@ -184,10 +194,12 @@ class FontManager
 };
 
 FontManager* FontManager::sInstance = nullptr;
+std::mutex FontManager::sInstanceMutex;
 
 #if defined( CINDER_ANDROID ) || defined( CINDER_LINUX )
 void FontManager_destroyStaticInstance() 
 {
+	std::lock_guard<std::mutex> lock( FontManager::sInstanceMutex );
 	if( nullptr != FontManager::sInstance ) {
 		delete FontManager::sInstance;
 		FontManager::sInstance = nullptr;
@@ -263,6 +275,7 @@ FontManager::~FontManager()
 
 FontManager* FontManager::instance()
 {
+	std::lock_guard<std::mutex> lock( sInstanceMutex );
 	if( ! FontManager::sInstance ) {
 		FontManager::sInstance =  new FontManager();
 	}
@@ -312,8 +325,9 @@ FontManager::FontInfo FontManager::getFontInfo( const std::string& fontName ) co
 }
 #endif
 
-const vector<string>& FontManager::getNames( bool forceRefresh )
+vector<string> FontManager::getNames( bool forceRefresh )
 {
+	std::lock_guard<std::recursive_mutex> lock( mMutex );
 	if( ( ! mFontsEnumerated ) || forceRefresh ) {
 		mFontNames.clear();
 #if defined( CINDER_MAC )
@@ -402,7 +416,7 @@ Font::Font( DataSourceRef dataSource, float size )
 }
 #endif
 
-const vector<string>& Font::getNames( bool forceRefresh )
+vector<string> Font::getNames( bool forceRefresh )
 {
 	return FontManager::instance()->getNames( forceRefresh );
 }
@@ -737,11 +751,13 @@ size_t Font::getNumGlyphs() const
 
 Font::Glyph Font::getGlyphChar( char c ) const
 {
+	std::lock_guard<std::mutex> lock( getFreetypeMutex() );
 	return FT_Get_Char_Index(mObj->mFace, c);
 }
 
 Font::Glyph Font::getGlyphIndex( size_t idx ) const
 {
+	std::lock_guard<std::mutex> lock( getFreetypeMutex() );
 	FT_UInt result = FT_Get_Char_Index( mObj->mFace, (FT_ULong)idx );
 	return result;
 }
@@ -749,6 +765,7 @@ Font::Glyph Font::getGlyphIndex( size_t idx ) const
 vector<Font::Glyph> Font::getGlyphs( const string &utf8String ) const
 {
 	vector<Glyph> result;
+	std::lock_guard<std::mutex> lock( getFreetypeMutex() );
 	for(unsigned i = 0; i < utf8String.size(); ++i)
 		result.push_back((Glyph)FT_Get_Char_Index(mObj->mFace, utf8String[i]));
 	return result;
@@ -784,6 +801,7 @@ static int ftShape2dCubicTo(const FT_Vector *control1, const FT_Vector *control2
 
 Shape2d Font::getGlyphShape( Glyph glyphIndex ) const
 {
+	std::lock_guard<std::mutex> lock( getFreetypeMutex() );
 	FT_Face face = mObj->mFace;
 	FT_Load_Glyph(face, glyphIndex, FT_LOAD_DEFAULT);
 	FT_GlyphSlot glyph = face->glyph;
@@ -805,6 +823,7 @@ Shape2d Font::getGlyphShape( Glyph glyphIndex ) const
 
 Rectf Font::getGlyphBoundingBox( Glyph glyphIndex ) const
 {
+	std::lock_guard<std::mutex> lock( getFreetypeMutex() );
 	FT_Load_Glyph( mObj->mFace, glyphIndex, FT_LOAD_DEFAULT );
 	const FT_GlyphSlot& glyph = mObj->mFace->glyph;
 	const FT_Glyph_Metrics& metrics = glyph->metrics;
@@ -867,8 +886,10 @@ FontObj::FontObj( const string &aName, float aSize )
 	}
 
 	mFileData = dataSource->getBuffer();
+	FT_Library library = FontManager::instance()->mLibrary;
+	std::lock_guard<std::mutex> lock( Font::getFreetypeMutex() );
 	FT_Error error = FT_New_Memory_Face(
-		FontManager::instance()->mLibrary, 
+		library, 
 		(FT_Byte*)mFileData->getData(), 
 		mFileData->getSize(), 
 		0, 
@@ -883,6 +904,8 @@ FontObj::FontObj( const string &aName, float aSize )
 
 	mName = fontInfo.name;
 #elif defined( CINDER_LINUX )
+	// FontManager::getNames() shuts fontconfig down once it has listed the fonts
+	std::lock_guard<std::recursive_mutex> fontManagerLock( FontManager::instance()->mMutex );
 	::FcPattern *pat = ::FcNameParse( (const FcChar8*)aName.c_str() );
 
 	// nullptr means use current config
@@ -909,8 +932,10 @@ FontObj::FontObj( const string &aName, float aSize )
 		}
 
 		mFileData = dataSource->getBuffer();
+		FT_Library library = FontManager::instance()->mLibrary;
+		std::lock_guard<std::mutex> lock( Font::getFreetypeMutex() );
 		FT_Error error = FT_New_Memory_Face(
-			FontManager::instance()->mLibrary, 
+			library, 
 			(FT_Byte*)mFileData->getData(), 
 			mFileData->getSize(), 
 			0, 
@@ -1011,8 +1036,10 @@ FontObj::FontObj( DataSourceRef dataSource, float size )
 	finishSetup();
 #elif defined( CINDER_ANDROID ) || defined( CINDER_LINUX )
 	mFileData = dataSource->getBuffer();
+	FT_Library library = FontManager::instance()->mLibrary;
+	std::lock_guard<std::mutex> lock( Font::getFreetypeMutex() );
 	FT_New_Memory_Face(
-		FontManager::instance()->mLibrary, 
+		library, 
 		(FT_Byte*)mFileData->getData(), 
 		mFileData->getSize(), 
 		0, 
@@ -1044,6 +1071,8 @@ FontObj::~FontObj()
 void FontObj::releaseFreeTypeFace()
 {
 	if( nullptr != mFace ) {
+		GlyphCache::get()->clear( mFace );
+		std::lock_guard<std::mutex> lock( Font::getFreetypeMutex() );
 		FT_Done_Face( mFace );
 		mFace = nullptr;
 	}
@@ -1082,6 +1111,12 @@ FT_Face Font::getFreetypeFace() const
 {
 	return mObj->mFace;
 }
+
+std::mutex& Font::getFreetypeMutex()
+{
+	static std::mutex sMutex;
+	return sMutex;
+}
 #endif
 
 #if defined( CINDER_MSW_DESKTOP )
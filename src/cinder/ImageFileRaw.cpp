@@ -0,0 +1,239 @@
+/*
+ Copyright (c) 2026, The Cinder Project
+
+ This code is intended to be used with the Cinder C++ library, http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include "cinder/ImageFileRaw.h"
+#include "cinder/DataSource.h"
+
+#include <cstring>
+
+using namespace std;
+
+namespace cinder {
+
+namespace {
+
+const char sMagic[8] = { 'C', 'I', 'R', 'A', 'W', 0, 0, 0 };
+const uint32_t sByteOrderMark = 0x01020304;
+
+ImageIo::ChannelOrder naturalChannelOrder( ImageIo::ColorModel colorModel, bool alpha )
+{
+	if( colorModel == ImageIo::CM_GRAY )
+		return alpha ? ImageIo::YA : ImageIo::Y;
+	else
+		return alpha ? ImageIo::RGBA : ImageIo::RGB;
+}
+
+template<typename T> ImageIo::DataType surfaceDataType();
+template<> ImageIo::DataType surfaceDataType<uint8_t>()		{ return ImageIo::UINT8; }
+template<> ImageIo::DataType surfaceDataType<uint16_t>()	{ return ImageIo::UINT16; }
+template<> ImageIo::DataType surfaceDataType<float>()		{ return ImageIo::FLOAT32; }
+
+} // anonymous namespace
+
+///////////////////////////////////////////////////////////////////////////////
+// RawImageHeader
+RawImageHeader RawImageHeader::create( const ImageSourceRef &imageSource )
+{
+	if( imageSource->getColorModel() != ImageIo::CM_RGB && imageSource->getColorModel() != ImageIo::CM_GRAY )
+		throw ImageIoExceptionIllegalColorModel( "ciraw only supports RGB and gray color models" );
+	if( imageSource->getDataType() == ImageIo::DATA_UNKNOWN )
+		throw ImageIoExceptionIllegalDataType( "ciraw requires a known data type" );
+
+	RawImageHeader result;
+	memset( &result, 0, sizeof( result ) );
+	memcpy( result.mMagic, sMagic, sizeof( sMagic ) );
+	result.mByteOrderMark = sByteOrderMark;
+	result.mVersion = VERSION;
+	result.mWidth = imageSource->getWidth();
+	result.mHeight = imageSource->getHeight();
+	result.mDataType = imageSource->getDataType();
+	result.mColorModel = imageSource->getColorModel();
+	result.mChannelOrder = ( imageSource->getChannelOrder() != ImageIo::CUSTOM ) ? imageSource->getChannelOrder() : naturalChannelOrder( imageSource->getColorModel(), imageSource->hasAlpha() );
+	result.mPremultiplied = imageSource->isPremultiplied() ? 1 : 0;
+	result.mRowBytes = uint64_t( result.mWidth ) * ImageIo::channelOrderNumChannels( (ImageIo::ChannelOrder)result.mChannelOrder ) * ImageIo::dataTypeBytes( (ImageIo::DataType)result.mDataType );
+	result.mDataOffset = DATA_OFFSET;
+	return result;
+}
+
+RawImageHeader RawImageHeader::read( const void *data, size_t size )
+{
+	RawImageHeader result;
+	if( ! data || size < sizeof( result ) )
+		throw ImageIoExceptionFailedLoad( "ciraw: file is too small" );
+
+	memcpy( &result, data, sizeof( result ) );
+	if( memcmp( result.mMagic, sMagic, sizeof( sMagic ) ) != 0 )
+		throw ImageIoExceptionFailedLoad( "ciraw: not a ciraw file" );
+	if( result.mByteOrderMark != sByteOrderMark )
+		throw ImageIoExceptionFailedLoad( "ciraw: file was written with a different byte order" );
+	if( result.mVersion != VERSION )
+		throw ImageIoExceptionFailedLoad( "ciraw: unsupported version" );
+	if( result.mDataType >= ImageIo::DATA_UNKNOWN || result.mChannelOrder >= ImageIo::CUSTOM || result.mColorModel >= ImageIo::CM_UNKNOWN )
+		throw ImageIoExceptionFailedLoad( "ciraw: invalid pixel format" );
+	if( ( result.mColorModel == ImageIo::CM_GRAY ) != ( result.mChannelOrder == ImageIo::Y || result.mChannelOrder == ImageIo::YA ) )
+		throw ImageIoExceptionFailedLoad( "ciraw: channel order doesn't match color model" );
+
+	const uint64_t bytes = ImageIo::dataTypeBytes( (ImageIo::DataType)result.mDataType );
+	const uint64_t minRowBytes = uint64_t( result.mWidth ) * ImageIo::channelOrderNumChannels( (ImageIo::ChannelOrder)result.mChannelOrder ) * bytes;
+	if( result.mWidth == 0 || result.mHeight == 0 || result.mWidth > INT32_MAX || result.mHeight > INT32_MAX || result.mRowBytes < minRowBytes
+			|| result.mRowBytes % bytes || result.mDataOffset % bytes || result.mDataOffset < sizeof( result ) )
+		throw ImageIoExceptionFailedLoad( "ciraw: invalid dimensions" );
+	if( result.mDataOffset > size || ( size - result.mDataOffset ) / result.mRowBytes < result.mHeight )
+		throw ImageIoExceptionFailedLoad( "ciraw: file is truncated" );
+
+	return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// ImageSourceFileRaw
+void ImageSourceFileRaw::registerSelf()
+{
+	static bool alreadyRegistered = false;
+	static const int32_t SOURCE_PRIORITY = 2;
+
+	if( alreadyRegistered )
+		return;
+	alreadyRegistered = true;
+
+	ImageIoRegistrar::registerSourceType( "ciraw", ImageSourceFileRaw::create, SOURCE_PRIORITY );
+}
+
+ImageSourceRef ImageSourceFileRaw::create( DataSourceRef dataSource, ImageSource::Options options )
+{
+	return ImageSourceRef( new ImageSourceFileRaw( dataSource, options ) );
+}
+
+ImageSourceFileRaw::ImageSourceFileRaw( DataSourceRef dataSource, ImageSource::Options options )
+{
+	if( dataSource->isFilePath() && ! dynamic_pointer_cast<DataSourceMemoryMapped>( dataSource ) ) {
+		try {
+			mData = DataSourceMemoryMapped::create( dataSource->getFilePath() )->getBuffer();
+		}
+		catch( MemoryMappedFileExc &exc ) {
+			throw ImageIoExceptionFailedLoad( string( "ciraw: " ) + exc.what() );
+		}
+	}
+	else
+		mData = dataSource->getBuffer();
+
+	mHeader = RawImageHeader::read( mData->getData(), mData->getSize() );
+	setSize( mHeader.mWidth, mHeader.mHeight );
+	setDataType( (ImageIo::DataType)mHeader.mDataType );
+	setColorModel( (ImageIo::ColorModel)mHeader.mColorModel );
+	setChannelOrder( (ImageIo::ChannelOrder)mHeader.mChannelOrder );
+	setPremultiplied( mHeader.mPremultiplied != 0 );
+	setupRegion( options );
+}
+
+void ImageSourceFileRaw::load( ImageTargetRef target )
+{
+	ImageSource::RowFunc func = setupRowFunc( target );
+	const uint8_t *data = static_cast<const uint8_t*>( mData->getData() ) + mHeader.mDataOffset;
+	for( int32_t row = mRegionArea.y1; row < mRegionArea.y2; ++row )
+		processRegionRow( target, func, row, data + row * mHeader.mRowBytes );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// ImageTargetFileRaw
+void ImageTargetFileRaw::registerSelf()
+{
+	static bool alreadyRegistered = false;
+	const int32_t PRIORITY = 1;
+
+	if( alreadyRegistered )
+		return;
+	alreadyRegistered = true;
+
+	ImageIoRegistrar::registerTargetType( "ciraw", ImageTargetFileRaw::create, PRIORITY, "ciraw" );
+}
+
+ImageTargetRef ImageTargetFileRaw::create( DataTargetRef dataTarget, ImageSourceRef imageSource, ImageTarget::Options options, const std::string &extensionData )
+{
+	return ImageTargetRef( new ImageTargetFileRaw( dataTarget, imageSource, options, extensionData ) );
+}
+
+ImageTargetFileRaw::ImageTargetFileRaw( DataTargetRef dataTarget, ImageSourceRef imageSource, ImageTarget::Options options, const std::string & /*extensionData*/ )
+	: mDataTarget( dataTarget ), mHeader( RawImageHeader::create( imageSource ) )
+{
+	if( ! options.isColorModelDefault() && options.getColorModel() != mHeader.mColorModel ) {
+		if( options.getColorModel() != ImageIo::CM_RGB && options.getColorModel() != ImageIo::CM_GRAY )
+			throw ImageIoExceptionIllegalColorModel( "ciraw only supports RGB and gray color models" );
+		mHeader.mColorModel = options.getColorModel();
+		mHeader.mChannelOrder = naturalChannelOrder( options.getColorModel(), imageSource->hasAlpha() );
+		mHeader.mRowBytes = uint64_t( mHeader.mWidth ) * channelOrderNumChannels( (ImageIo::ChannelOrder)mHeader.mChannelOrder ) * dataTypeBytes( (ImageIo::DataType)mHeader.mDataType );
+	}
+
+	setSize( mHeader.mWidth, mHeader.mHeight );
+	setDataType( (ImageIo::DataType)mHeader.mDataType );
+	setColorModel( (ImageIo::ColorModel)mHeader.mColorModel );
+	setChannelOrder( (ImageIo::ChannelOrder)mHeader.mChannelOrder );
+	mData.resize( mHeader.mDataOffset + mHeader.mRowBytes * mHeader.mHeight );
+	memcpy( mData.data(), &mHeader, sizeof( mHeader ) );
+}
+
+void* ImageTargetFileRaw::getRowPointer( int32_t row )
+{
+	return mData.data() + mHeader.mDataOffset + row * mHeader.mRowBytes;
+}
+
+void ImageTargetFileRaw::finalize()
+{
+	OStreamRef stream = mDataTarget->getStream();
+	if( ! stream )
+		throw ImageIoExceptionFailedWrite( "ciraw: no stream to write to" );
+
+	stream->writeData( mData.data(), mData.size() );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// mapSurface
+template<typename T>
+std::shared_ptr<SurfaceT<T>> mapSurface( const fs::path &path, bool copyOnWrite )
+{
+	MemoryMappedFileRef file;
+	try {
+		file = MemoryMappedFile::create( path, copyOnWrite );
+	}
+	catch( MemoryMappedFileExc &exc ) {
+		throw ImageIoExceptionFailedLoad( string( "ciraw: " ) + exc.what() );
+	}
+
+	const RawImageHeader header = RawImageHeader::read( file->getData(), file->getSize() );
+	if( header.mDataType != surfaceDataType<T>() )
+		throw ImageIoExceptionIllegalDataType( "ciraw: file's data type doesn't match the Surface's" );
+	if( header.mColorModel != ImageIo::CM_RGB )
+		throw ImageIoExceptionIllegalColorModel( "ciraw: Surfaces require an RGB color model" );
+
+	// the aliasing data store shares ownership of the mapping; RGB ImageIo::ChannelOrders have the same codes as SurfaceChannelOrder
+	T *data = reinterpret_cast<T*>( static_cast<uint8_t*>( const_cast<void*>( file->getData() ) ) + header.mDataOffset );
+	auto result = SurfaceT<T>::create( std::shared_ptr<T>( file, data ), header.mWidth, header.mHeight, header.mRowBytes, SurfaceChannelOrder( header.mChannelOrder ) );
+	result->setPremultiplied( header.mPremultiplied != 0 );
+	return result;
+}
+
+template CI_API std::shared_ptr<SurfaceT<uint8_t>> mapSurface<uint8_t>( const fs::path &path, bool copyOnWrite );
+template CI_API std::shared_ptr<SurfaceT<uint16_t>> mapSurface<uint16_t>( const fs::path &path, bool copyOnWrite );
+template CI_API std::shared_ptr<SurfaceT<float>> mapSurface<float>( const fs::path &path, bool copyOnWrite );
+
+} // namespace cinder
@@ -48,7 +48,7 @@ void ImageSourceFileTinyExr::registerSelf()
 	ImageIoRegistrar::registerSourceType( "exr", sourceFunc, 1 ); // lower is higher priority
 }
 
-ImageSourceFileTinyExr::ImageSourceFileTinyExr( DataSourceRef dataSource, ImageSource::Options /*options*/ )
+ImageSourceFileTinyExr::ImageSourceFileTinyExr( DataSourceRef dataSource, ImageSource::Options options )
 	: mExrHeader( new EXRHeader, FreeEXRHeader ) // We're using the provided FreeEXRHeader function as a custom deleter
 	, mExrImage( new EXRImage, FreeEXRImage )    // We're using the provided FreeEXRImage function as a custom deleter
 {
@@ -156,6 +156,8 @@ ImageSourceFileTinyExr::ImageSourceFileTinyExr( DataSourceRef dataSource, ImageS
 		default:
 			throw ImageIoExceptionFailedLoadTinyExr( "Unsupported channel count (" + to_string( mExrImage->num_channels ) + "); expected 1-4 channels" );
 	}
+
+	setupRegion( options );
 }
 
 void ImageSourceFileTinyExr::load( ImageTargetRef target )
@@ -163,6 +165,8 @@ void ImageSourceFileTinyExr::load( ImageTargetRef target )
 	ImageSource::RowFunc rowFunc = setupRowFunc( target );
 
 	const size_t numChannels = mExrHeader->num_channels;
+	// only the columns and rows of the requested area are interleaved; mWidth and mHeight are the size after setupRegion()
+	const int32_t width = mExrImage->width;
 	const void * red = nullptr, *green = nullptr, *blue = nullptr, *alpha = nullptr;
 	const void * gray = nullptr;
 
@@ -184,58 +188,58 @@ void ImageSourceFileTinyExr::load( ImageTargetRef target )
 
 	if( gray ) {
 		if( getDataType() == ImageIo::FLOAT32 ) {
-			vector<float> rowData( mWidth * mExrImage->num_channels, 0 );
-			for( int32_t row = 0; row < mHeight; row++ ) {
-				for( int32_t col = 0; col < mWidth; col++ ) {
-					rowData.at( col * numChannels + 0 ) = static_cast<const float *>( gray )[row * mWidth + col];
+			vector<float> rowData( width * mExrImage->num_channels, 0 );
+			for( int32_t row = mRegionArea.y1; row < mRegionArea.y2; row++ ) {
+				for( int32_t col = mRegionArea.x1; col < mRegionArea.x2; col++ ) {
+					rowData.at( col * numChannels + 0 ) = static_cast<const float *>( gray )[row * width + col];
 					if( alpha )
-						rowData.at( col * numChannels + 1 ) = static_cast<const float *>( alpha )[row * mWidth + col];
+						rowData.at( col * numChannels + 1 ) = static_cast<const float *>( alpha )[row * width + col];
 				}
 
-				( ( *this ).*rowFunc )( target, row, rowData.data() );
+				processRegionRow( target, rowFunc, row, rowData.data() );
 			}
 		}
 		else { // float16
-			vector<uint16_t> rowData( mWidth * mExrImage->num_channels, 0 );
-			for( int32_t row = 0; row < mHeight; row++ ) {
-				for( int32_t col = 0; col < mWidth; col++ ) {
-					rowData.at( col * numChannels + 0 ) = static_cast<const uint16_t *>( gray )[row * mWidth + col];
+			vector<uint16_t> rowData( width * mExrImage->num_channels, 0 );
+			for( int32_t row = mRegionArea.y1; row < mRegionArea.y2; row++ ) {
+				for( int32_t col = mRegionArea.x1; col < mRegionArea.x2; col++ ) {
+					rowData.at( col * numChannels + 0 ) = static_cast<const uint16_t *>( gray )[row * width + col];
 					if( alpha )
-						rowData.at( col * numChannels + 1 ) = static_cast<const uint16_t *>( alpha )[row * mWidth + col];
+						rowData.at( col * numChannels + 1 ) = static_cast<const uint16_t *>( alpha )[row * width + col];
 				}
 
-				( ( *this ).*rowFunc )( target, row, rowData.data() );
+				processRegionRow( target, rowFunc, row, rowData.data() );
 			}
 		}
 	}
 	else {
 		// load one interleaved row at a time
 		if( getDataType() == ImageIo::FLOAT32 ) {
-			vector<float> rowData( mWidth * mExrImage->num_channels, 0 );
-			for( int32_t row = 0; row < mHeight; row++ ) {
-				for( int32_t col = 0; col < mWidth; col++ ) {
-					rowData.at( col * numChannels + 0 ) = static_cast<const float *>( red )[row * mWidth + col];
-					rowData.at( col * numChannels + 1 ) = static_cast<const float *>( green )[row * mWidth + col];
-					rowData.at( col * numChannels + 2 ) = static_cast<const float *>( blue )[row * mWidth + col];
+			vector<float> rowData( width * mExrImage->num_channels, 0 );
+			for( int32_t row = mRegionArea.y1; row < mRegionArea.y2; row++ ) {
+				for( int32_t col = mRegionArea.x1; col < mRegionArea.x2; col++ ) {
+					rowData.at( col * numChannels + 0 ) = static_cast<const float *>( red )[row * width + col];
+					rowData.at( col * numChannels + 1 ) = static_cast<const float *>( green )[row * width + col];
+					rowData.at( col * numChannels + 2 ) = static_cast<const float *>( blue )[row * width + col];
 					if( alpha )
-						rowData.at( col * numChannels + 3 ) = static_cast<const float *>( alpha )[row * mWidth + col];
+						rowData.at( col * numChannels + 3 ) = static_cast<const float *>( alpha )[row * width + col];
 				}
 
-				( ( *this ).*rowFunc )( target, row, rowData.data() );
+				processRegionRow( target, rowFunc, row, rowData.data() );
 			}
 		}
 		else { // float16
-			vector<uint16_t> rowData( mWidth * mExrImage->num_channels, 0 );
-			for( int32_t row = 0; row < mHeight; row++ ) {
-				for( int32_t col = 0; col < mWidth; col++ ) {
-					rowData.at( col * numChannels + 0 ) = static_cast<const uint16_t *>( red )[row * mWidth + col];
-					rowData.at( col * numChannels + 1 ) = static_cast<const uint16_t *>( green )[row * mWidth + col];
-					rowData.at( col * numChannels + 2 ) = static_cast<const uint16_t *>( blue )[row * mWidth + col];
+			vector<uint16_t> rowData( width * mExrImage->num_channels, 0 );
+			for( int32_t row = mRegionArea.y1; row < mRegionArea.y2; row++ ) {
+				for( int32_t col = mRegionArea.x1; col < mRegionArea.x2; col++ ) {
+					rowData.at( col * numChannels + 0 ) = static_cast<const uint16_t *>( red )[row * width + col];
+					rowData.at( col * numChannels + 1 ) = static_cast<const uint16_t *>( green )[row * width + col];
+					rowData.at( col * numChannels + 2 ) = static_cast<const uint16_t *>( blue )[row * width + col];
 					if( alpha )
-						rowData.at( col * numChannels + 3 ) = static_cast<const uint16_t *>( alpha )[row * mWidth + col];
+						rowData.at( col * numChannels + 3 ) = static_cast<const uint16_t *>( alpha )[row * width + col];
 				}
 
-				( ( *this ).*rowFunc )( target, row, rowData.data() );
+				processRegionRow( target, rowFunc, row, rowData.data() );
 			}
 		}
 	}
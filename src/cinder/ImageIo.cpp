@@ -24,9 +24,24 @@
 
 #include "cinder/ImageIo.h"
 #include "cinder/Utilities.h"
+#include "cinder/CinderAssert.h"
 
 #include <iterator>
 #include <cctype>
+#include <cstring>
+#include <type_traits>
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+	#define CINDER_IMAGEIO_SSE
+	#include <emmintrin.h>
+	#if defined( __SSSE3__ ) || defined( __AVX__ )
+		#define CINDER_IMAGEIO_SSSE3
+		#include <tmmintrin.h>
+	#endif
+#elif defined( __aarch64__ ) || defined( _M_ARM64 )
+	#define CINDER_IMAGEIO_NEON
+	#include <arm_neon.h>
+#endif
 
 #if defined( CINDER_COCOA )
 	#include "cinder/cocoa/CinderCocoa.h"
@@ -274,6 +289,220 @@ void ImageSource::rowFuncSourceGray( ImageTargetRef target, int32_t row, const v
 	}
 }
 
+namespace {
+
+// Converts \a count values at once, for rows whose source and target channel layouts match
+template<typename SD, typename TD>
+void convertSpan( const SD *source, TD *target, size_t count )
+{
+	for( size_t i = 0; i < count; i++ )
+		target[i] = CHANTRAIT<TD>::convert( source[i] );
+}
+
+template<typename T>
+void convertSpan( const T *source, T *target, size_t count )
+{
+	memcpy( target, source, count * sizeof( T ) );
+}
+
+void convertSpan( const uint8_t *source, float *target, size_t count )
+{
+	size_t i = 0;
+	// dividing rather than multiplying by the reciprocal matches CHANTRAIT<float>::convert() exactly
+#if defined( CINDER_IMAGEIO_SSE )
+	const __m128 scale = _mm_set1_ps( 255.0f );
+	const __m128i zero = _mm_setzero_si128();
+	for( ; i + 16 <= count; i += 16 ) {
+		__m128i v = _mm_loadu_si128( reinterpret_cast<const __m128i*>( source + i ) );
+		__m128i lo = _mm_unpacklo_epi8( v, zero );
+		__m128i hi = _mm_unpackhi_epi8( v, zero );
+		_mm_storeu_ps( target + i, _mm_div_ps( _mm_cvtepi32_ps( _mm_unpacklo_epi16( lo, zero ) ), scale ) );
+		_mm_storeu_ps( target + i + 4, _mm_div_ps( _mm_cvtepi32_ps( _mm_unpackhi_epi16( lo, zero ) ), scale ) );
+		_mm_storeu_ps( target + i + 8, _mm_div_ps( _mm_cvtepi32_ps( _mm_unpacklo_epi16( hi, zero ) ), scale ) );
+		_mm_storeu_ps( target + i + 12, _mm_div_ps( _mm_cvtepi32_ps( _mm_unpackhi_epi16( hi, zero ) ), scale ) );
+	}
+#elif defined( CINDER_IMAGEIO_NEON )
+	const float32x4_t scale = vdupq_n_f32( 255.0f );
+	for( ; i + 16 <= count; i += 16 ) {
+		uint8x16_t v = vld1q_u8( source + i );
+		uint16x8_t lo = vmovl_u8( vget_low_u8( v ) );
+		uint16x8_t hi = vmovl_u8( vget_high_u8( v ) );
+		vst1q_f32( target + i, vdivq_f32( vcvtq_f32_u32( vmovl_u16( vget_low_u16( lo ) ) ), scale ) );
+		vst1q_f32( target + i + 4, vdivq_f32( vcvtq_f32_u32( vmovl_u16( vget_high_u16( lo ) ) ), scale ) );
+		vst1q_f32( target + i + 8, vdivq_f32( vcvtq_f32_u32( vmovl_u16( vget_low_u16( hi ) ) ), scale ) );
+		vst1q_f32( target + i + 12, vdivq_f32( vcvtq_f32_u32( vmovl_u16( vget_high_u16( hi ) ) ), scale ) );
+	}
+#endif
+	for( ; i < count; i++ )
+		target[i] = CHANTRAIT<float>::convert( source[i] );
+}
+
+void convertSpan( const uint16_t *source, uint8_t *target, size_t count )
+{
+	size_t i = 0;
+	// v / 257 == ( v * 65281 ) >> 24 for every 16 bit value
+#if defined( CINDER_IMAGEIO_SSE )
+	const __m128i mult = _mm_set1_epi16( static_cast<short>( 65281 ) );
+	for( ; i + 16 <= count; i += 16 ) {
+		__m128i lo = _mm_srli_epi16( _mm_mulhi_epu16( _mm_loadu_si128( reinterpret_cast<const __m128i*>( source + i ) ), mult ), 8 );
+		__m128i hi = _mm_srli_epi16( _mm_mulhi_epu16( _mm_loadu_si128( reinterpret_cast<const __m128i*>( source + i + 8 ) ), mult ), 8 );
+		_mm_storeu_si128( reinterpret_cast<__m128i*>( target + i ), _mm_packus_epi16( lo, hi ) );
+	}
+#elif defined( CINDER_IMAGEIO_NEON )
+	const uint16x4_t mult = vdup_n_u16( 65281 );
+	for( ; i + 8 <= count; i += 8 ) {
+		uint16x8_t v = vld1q_u16( source + i );
+		uint16x4_t lo = vshrn_n_u32( vmull_u16( vget_low_u16( v ), mult ), 16 );
+		uint16x4_t hi = vshrn_n_u32( vmull_u16( vget_high_u16( v ), mult ), 16 );
+		vst1_u8( target + i, vshrn_n_u16( vcombine_u16( lo, hi ), 8 ) );
+	}
+#endif
+	for( ; i < count; i++ )
+		target[i] = CHANTRAIT<uint8_t>::convert( source[i] );
+}
+
+// Reorders 8 bit pixels according to \a shuffle, where entries with the high bit set are taken from \a fill instead
+template<int SOURCEINC, int TARGETINC>
+void shuffleRow8u( const uint8_t *sourceData, uint8_t *targetData, int32_t width, const uint8_t shuffle[16], const uint8_t fill[16] )
+{
+	int32_t c = 0;
+#if defined( CINDER_IMAGEIO_SSSE3 ) || defined( CINDER_IMAGEIO_NEON )
+	// each iteration loads 16 source bytes, which must not run past the last byte of the row
+	const int32_t lastLoad = ( width - 1 ) * SOURCEINC + 1 - 16;
+  #if defined( CINDER_IMAGEIO_SSSE3 )
+	const __m128i shuffleMask = _mm_loadu_si128( reinterpret_cast<const __m128i*>( shuffle ) );
+	const __m128i fillMask = _mm_loadu_si128( reinterpret_cast<const __m128i*>( fill ) );
+	for( ; c + 4 <= width && c * SOURCEINC <= lastLoad; c += 4 ) {
+		__m128i v = _mm_or_si128( _mm_shuffle_epi8( _mm_loadu_si128( reinterpret_cast<const __m128i*>( sourceData + c * SOURCEINC ) ), shuffleMask ), fillMask );
+		if( TARGETINC == 4 )
+			_mm_storeu_si128( reinterpret_cast<__m128i*>( targetData + c * 4 ), v );
+		else {
+			_mm_storel_epi64( reinterpret_cast<__m128i*>( targetData + c * 3 ), v );
+			uint32_t last = static_cast<uint32_t>( _mm_cvtsi128_si32( _mm_srli_si128( v, 8 ) ) );
+			memcpy( targetData + c * 3 + 8, &last, 4 );
+		}
+	}
+  #else
+	const uint8x16_t shuffleMask = vld1q_u8( shuffle );
+	const uint8x16_t fillMask = vld1q_u8( fill );
+	for( ; c + 4 <= width && c * SOURCEINC <= lastLoad; c += 4 ) {
+		uint8x16_t v = vorrq_u8( vqtbl1q_u8( vld1q_u8( sourceData + c * SOURCEINC ), shuffleMask ), fillMask );
+		if( TARGETINC == 4 )
+			vst1q_u8( targetData + c * 4, v );
+		else {
+			vst1_u8( targetData + c * 3, vget_low_u8( v ) );
+			uint32_t last = vgetq_lane_u32( vreinterpretq_u32_u8( v ), 2 );
+			memcpy( targetData + c * 3 + 8, &last, 4 );
+		}
+	}
+  #endif
+#endif
+
+	sourceData += c * SOURCEINC;
+	targetData += c * TARGETINC;
+	for( ; c < width; c++ ) {
+		for( int t = 0; t < TARGETINC; t++ )
+			targetData[t] = ( shuffle[t] & 0x80 ) ? fill[t] : sourceData[shuffle[t]];
+		sourceData += SOURCEINC;
+		targetData += TARGETINC;
+	}
+}
+
+} // anonymous namespace
+
+template<typename SD, typename TD>
+void ImageSource::rowFuncSameLayout( ImageTargetRef target, int32_t row, const void *data )
+{
+	convertSpan( reinterpret_cast<const SD*>( data ), reinterpret_cast<TD*>( target->getRowPointer( row ) ), static_cast<size_t>( getWidth() ) * mRowFuncSourceInc );
+}
+
+template<typename SD, typename TD, int SOURCEINC, int TARGETINC>
+void ImageSource::rowFuncShuffle8u( ImageTargetRef target, int32_t row, const void *data )
+{
+	const int32_t width = getWidth();
+
+	// at most one of SD and TD is something other than uint8_t, converted before or after the shuffle
+	const uint8_t *sourceData = reinterpret_cast<const uint8_t*>( data );
+	if( ! std::is_same<SD,uint8_t>::value ) {
+		mRowFuncScratch.resize( width * SOURCEINC );
+		convertSpan( reinterpret_cast<const SD*>( data ), mRowFuncScratch.data(), mRowFuncScratch.size() );
+		sourceData = mRowFuncScratch.data();
+	}
+
+	if( std::is_same<TD,uint8_t>::value )
+		shuffleRow8u<SOURCEINC,TARGETINC>( sourceData, reinterpret_cast<uint8_t*>( target->getRowPointer( row ) ), width, mRowFuncShuffle, mRowFuncShuffleFill );
+	else {
+		mRowFuncScratch.resize( width * TARGETINC );
+		shuffleRow8u<SOURCEINC,TARGETINC>( sourceData, mRowFuncScratch.data(), width, mRowFuncShuffle, mRowFuncShuffleFill );
+		convertSpan( mRowFuncScratch.data(), reinterpret_cast<TD*>( target->getRowPointer( row ) ), mRowFuncScratch.size() );
+	}
+}
+
+template<typename SD, typename TD, ImageIo::ColorModel TCM>
+ImageSource::RowFunc ImageSource::setupRowFuncFastPath()
+{
+	const bool sourceHasPadding = mRowFuncSourceInc > ( mColorModel == CM_RGB ? 3 : 1 ) + ( mRowFuncSourceAlpha >= 0 ? 1 : 0 );
+
+	// identical layouts only need a type conversion over the whole row. Padding channels are copied along with the rest,
+	// but never converted, as they may hold values which aren't valid in the source type.
+	if( mCustomPixelInc == 0 && mRowFuncSourceInc == mRowFuncTargetInc && mRowFuncSourceAlpha == mRowFuncTargetAlpha && ( std::is_same<SD,TD>::value || ! sourceHasPadding ) ) {
+		bool sameLayout = false;
+		if( mColorModel == CM_RGB && TCM == CM_RGB )
+			sameLayout = mRowFuncSourceRed == mRowFuncTargetRed && mRowFuncSourceGreen == mRowFuncTargetGreen && mRowFuncSourceBlue == mRowFuncTargetBlue;
+		else if( mColorModel == CM_GRAY && TCM == CM_GRAY )
+			sameLayout = mRowFuncSourceGray == mRowFuncTargetGray;
+		if( sameLayout )
+			return &ImageSource::rowFuncSameLayout<SD,TD>;
+	}
+
+	// RGB targets where either side is 8 bit are a byte shuffle, with the other side's type converted in bulk. Every 16 bit
+	// value converts safely, but padding in other types might not.
+	const bool shuffle8u = std::is_same<SD,uint8_t>::value || ( std::is_same<TD,uint8_t>::value && ( std::is_same<SD,uint16_t>::value || ! sourceHasPadding ) );
+	if( shuffle8u && TCM == CM_RGB && mRowFuncSourceInc >= 1 && mRowFuncSourceInc <= 4 ) {
+		const bool rgbSource = mColorModel == CM_RGB;
+		for( int t = 0; t < 16; t++ ) {
+			int pixel = t / mRowFuncTargetInc, channel = t % mRowFuncTargetInc;
+			int8_t sourceOffset = -1;
+			if( channel == mRowFuncTargetRed )
+				sourceOffset = rgbSource ? mRowFuncSourceRed : mRowFuncSourceGray;
+			else if( channel == mRowFuncTargetGreen )
+				sourceOffset = rgbSource ? mRowFuncSourceGreen : mRowFuncSourceGray;
+			else if( channel == mRowFuncTargetBlue )
+				sourceOffset = rgbSource ? mRowFuncSourceBlue : mRowFuncSourceGray;
+			else if( channel == mRowFuncTargetAlpha )
+				sourceOffset = mRowFuncSourceAlpha;
+
+			// target alpha without source alpha is forced to max, as is padding, which the generic path leaves untouched
+			if( pixel >= 4 ) {
+				mRowFuncShuffle[t] = 0x80;
+				mRowFuncShuffleFill[t] = 0;
+			}
+			else if( sourceOffset >= 0 ) {
+				mRowFuncShuffle[t] = static_cast<uint8_t>( pixel * mRowFuncSourceInc + sourceOffset );
+				mRowFuncShuffleFill[t] = 0;
+			}
+			else {
+				mRowFuncShuffle[t] = 0x80;
+				mRowFuncShuffleFill[t] = CHANTRAIT<uint8_t>::max();
+			}
+		}
+
+		switch( mRowFuncSourceInc * 8 + mRowFuncTargetInc ) {
+			case 1 * 8 + 3: return &ImageSource::rowFuncShuffle8u<SD,TD,1,3>;
+			case 1 * 8 + 4: return &ImageSource::rowFuncShuffle8u<SD,TD,1,4>;
+			case 2 * 8 + 3: return &ImageSource::rowFuncShuffle8u<SD,TD,2,3>;
+			case 2 * 8 + 4: return &ImageSource::rowFuncShuffle8u<SD,TD,2,4>;
+			case 3 * 8 + 3: return &ImageSource::rowFuncShuffle8u<SD,TD,3,3>;
+			case 3 * 8 + 4: return &ImageSource::rowFuncShuffle8u<SD,TD,3,4>;
+			case 4 * 8 + 3: return &ImageSource::rowFuncShuffle8u<SD,TD,4,3>;
+			case 4 * 8 + 4: return &ImageSource::rowFuncShuffle8u<SD,TD,4,4>;
+			default: break;
+		}
+	}
+
+	return nullptr;
+}
+
 void ImageSource::setupRowFuncRgbSource( ImageTargetRef target )
 {
 	translateRgbColorModelToOffsets( mChannelOrder, &mRowFuncSourceRed, &mRowFuncSourceGreen, &mRowFuncSourceBlue, &mRowFuncSourceAlpha, &mRowFuncSourceInc );
@@ -300,6 +529,8 @@ ImageSource::RowFunc ImageSource::setupRowFuncForTypesAndTargetColorModel( Image
 			setupRowFuncRgbSource( target );
 			if( mCustomPixelInc != 0 )
 				mRowFuncSourceInc = mCustomPixelInc;
+			if( RowFunc fastPath = setupRowFuncFastPath<SD,TD,TCM>() )
+				return fastPath;
 			bool alpha = ( mRowFuncSourceAlpha != -1 ) && ( mRowFuncTargetAlpha != -1 );
 			if( alpha )
 				return &ImageSource::rowFuncSourceRgb<SD,TD,TCM,true>;
@@ -311,6 +542,8 @@ ImageSource::RowFunc ImageSource::setupRowFuncForTypesAndTargetColorModel( Image
 			setupRowFuncGraySource( target );
 			if( mCustomPixelInc != 0 )
 				mRowFuncSourceInc = mCustomPixelInc;
+			if( RowFunc fastPath = setupRowFuncFastPath<SD,TD,TCM>() )
+				return fastPath;
 			bool alpha = ( mRowFuncSourceAlpha != -1 ) && ( mRowFuncTargetAlpha != -1 );
 			if( alpha )
 				return &ImageSource::rowFuncSourceGray<SD,TD,TCM,true>;
@@ -383,6 +616,179 @@ ImageSource::RowFunc ImageSource::setupRowFunc( ImageTargetRef target )
 	}
 }
 
+void ImageSource::setupRegion( const Options &options )
+{
+	mRegionArea = Area( 0, 0, mWidth, mHeight );
+	if( options.getArea().getWidth() > 0 || options.getArea().getHeight() > 0 ) {
+		mRegionArea.clipBy( options.getArea() );
+		if( mRegionArea.getWidth() <= 0 || mRegionArea.getHeight() <= 0 )
+			throw ImageIoExceptionFailedLoad( "Image area is outside of the image." );
+	}
+
+	mRegionDownscale = std::max<int32_t>( options.getDownscale(), 1 );
+	setSize( ( mRegionArea.getWidth() + mRegionDownscale - 1 ) / mRegionDownscale, ( mRegionArea.getHeight() + mRegionDownscale - 1 ) / mRegionDownscale );
+	mRegionApplied = true;
+}
+
+namespace {
+
+template<typename T> double regionValueToDouble( T v )				{ return double( v ); }
+template<> double regionValueToDouble<half_float>( half_float v )	{ return double( halfToFloat( v ) ); }
+
+template<typename T> T regionValueFromDouble( double v )			{ return T( v ); }
+template<> uint8_t regionValueFromDouble<uint8_t>( double v )		{ return uint8_t( v + 0.5 ); }
+template<> uint16_t regionValueFromDouble<uint16_t>( double v )		{ return uint16_t( v + 0.5 ); }
+template<> half_float regionValueFromDouble<half_float>( double v )	{ return floatToHalf( float( v ) ); }
+
+} // anonymous namespace
+
+template<typename T>
+void ImageSource::downscaleRegionRow( ImageTargetRef target, RowFunc func, int32_t regionRow, const T *data )
+{
+	const int32_t factor = mRegionDownscale;
+	const int32_t inc = mCustomPixelInc ? mCustomPixelInc : channelOrderNumChannels( mChannelOrder );
+	const int32_t areaWidth = mRegionArea.getWidth();
+	const int32_t blockRow = regionRow % factor;
+
+	// the blocks are accumulated in place, which only works if each load() passes the rows from the first one down
+	CI_ASSERT_MSG( regionRow == 0 || regionRow == mRegionLastRow + 1, "rows must be passed to processRegionRow() in order" );
+	mRegionLastRow = regionRow;
+
+	// accumulate each factor x factor block, emitting a row once its last source row arrives
+	if( blockRow == 0 )
+		mRegionSums.assign( mWidth * inc, 0 );
+	for( int32_t x = 0; x < areaWidth; x++ ) {
+		double *sum = &mRegionSums[( x / factor ) * inc];
+		for( int32_t c = 0; c < inc; c++ )
+			sum[c] += regionValueToDouble( data[x * inc + c] );
+	}
+
+	if( blockRow == factor - 1 || regionRow == mRegionArea.getHeight() - 1 ) {
+		mRegionRow.resize( mWidth * inc * sizeof( T ) );
+		T *result = reinterpret_cast<T*>( mRegionRow.data() );
+		for( int32_t x = 0; x < mWidth; x++ ) {
+			// blocks on the right and bottom edges may be partial
+			const double scale = 1.0 / ( ( blockRow + 1 ) * std::min( factor, areaWidth - x * factor ) );
+			for( int32_t c = 0; c < inc; c++ )
+				result[x * inc + c] = regionValueFromDouble<T>( mRegionSums[x * inc + c] * scale );
+		}
+		( this->*func )( target, regionRow / factor, result );
+	}
+}
+
+void ImageSource::processRegionRow( ImageTargetRef target, RowFunc func, int32_t sourceRow, const void *data )
+{
+	if( sourceRow < mRegionArea.y1 || sourceRow >= mRegionArea.y2 )
+		return;
+
+	const int32_t inc = mCustomPixelInc ? mCustomPixelInc : channelOrderNumChannels( mChannelOrder );
+	const uint8_t *row = static_cast<const uint8_t*>( data ) + mRegionArea.x1 * inc * dataTypeBytes( mDataType );
+	const int32_t regionRow = sourceRow - mRegionArea.y1;
+	if( mRegionDownscale == 1 ) {
+		( this->*func )( target, regionRow, row );
+		return;
+	}
+
+	switch( mDataType ) {
+		case UINT8:
+			downscaleRegionRow( target, func, regionRow, reinterpret_cast<const uint8_t*>( row ) );
+		break;
+		case UINT16:
+			downscaleRegionRow( target, func, regionRow, reinterpret_cast<const uint16_t*>( row ) );
+		break;
+		case FLOAT16:
+			downscaleRegionRow( target, func, regionRow, reinterpret_cast<const half_float*>( row ) );
+		break;
+		case FLOAT32:
+			downscaleRegionRow( target, func, regionRow, reinterpret_cast<const float*>( row ) );
+		break;
+		case DATA_UNKNOWN:
+		default:
+			throw ImageIoExceptionIllegalDataType( "Unknown data type." );
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// ImageSourceRegion
+//! Applies ImageSource::Options::area() and downscale() to sources which don't support them natively, by loading full rows into a scratch row.
+class ImageSourceRegion : public ImageSource {
+  public:
+	static ImageSourceRef apply( const ImageSourceRef &source, const ImageSource::Options &options )
+	{
+		if( ! source || source->mRegionApplied || ! options.hasRegion() )
+			return source;
+		return ImageSourceRef( new ImageSourceRegion( source, options ) );
+	}
+
+	void load( ImageTargetRef target ) override
+	{
+		auto rowTarget = make_shared<RowTarget>( this, target );
+		mSource->load( rowTarget );
+		rowTarget->flush();
+	}
+
+  private:
+	// Receives rows in the source's layout, passing each one on once the source has moved to the next
+	class RowTarget : public ImageTarget {
+	  public:
+		RowTarget( ImageSourceRegion *region, const ImageTargetRef &target )
+			: mRegion( region ), mTarget( target ), mCurrentRow( -1 )
+		{
+			const ImageSourceRef &source = region->mSource;
+			setSize( source->getWidth(), source->getHeight() );
+			setDataType( region->getDataType() );
+			setColorModel( region->getColorModel() );
+			setChannelOrder( region->getChannelOrder() );
+			mRow.resize( source->getWidth() * channelOrderNumChannels( getChannelOrder() ) * dataTypeBytes( getDataType() ) );
+			mRowFunc = region->setupRowFunc( target );
+		}
+
+		void* getRowPointer( int32_t row ) override
+		{
+			if( row != mCurrentRow ) {
+				flush();
+				mCurrentRow = row;
+			}
+			return mRow.data();
+		}
+
+		void flush()
+		{
+			if( mCurrentRow >= 0 )
+				mRegion->processRegionRow( mTarget, mRowFunc, mCurrentRow, mRow.data() );
+			mCurrentRow = -1;
+		}
+
+	  private:
+		ImageSourceRegion		*mRegion;
+		ImageTargetRef			mTarget;
+		RowFunc					mRowFunc;
+		int32_t					mCurrentRow;
+		std::vector<uint8_t>	mRow;
+	};
+
+	ImageSourceRegion( const ImageSourceRef &source, const ImageSource::Options &options )
+		: mSource( source )
+	{
+		// the scratch row uses the natural channel order of the source's color model, as it may have a custom pixel increment
+		setSize( source->getWidth(), source->getHeight() );
+		setDataType( source->getDataType() );
+		setColorModel( source->getColorModel() );
+		if( source->getChannelOrder() != CUSTOM && ! source->mCustomPixelInc )
+			setChannelOrder( source->getChannelOrder() );
+		else if( source->getColorModel() == CM_GRAY )
+			setChannelOrder( source->hasAlpha() ? YA : Y );
+		else
+			setChannelOrder( source->hasAlpha() ? RGBA : RGB );
+		setPixelAspectRatio( source->getPixelAspectRatio() );
+		setPremultiplied( source->isPremultiplied() );
+		setFrameCount( source->getCount() );
+		setupRegion( options );
+	}
+
+	ImageSourceRef		mSource;
+};
+
 ImageSourceRef loadImage( const fs::path &path, ImageSource::Options options, string extension )
 {
 #if defined( CINDER_ANDROID )
@@ -491,7 +897,7 @@ ImageSourceRef ImageIoRegistrar::Inst::createSource( DataSourceRef dataSource, I
 		if( sIt != mSources.end() ) {
 			for( multimap<int32_t,ImageIoRegistrar::SourceCreationFunc>::const_iterator sourcesIt = sIt->second.begin(); sourcesIt != sIt->second.end(); ++sourcesIt ) {
 				try {
-					return (*(sourcesIt->second))( dataSource, options );
+					return ImageSourceRegion::apply( (*(sourcesIt->second))( dataSource, options ), options );
 				}
 				catch( ImageIoException & ) {
 					// if we're out of handlers, rethrow the exception, otherwise continue on
@@ -505,7 +911,7 @@ ImageSourceRef ImageIoRegistrar::Inst::createSource( DataSourceRef dataSource, I
 	// if there is no extension, or none of the registered types got it, we'll have to try the generic loaders
 	for( map<int32_t, ImageIoRegistrar::SourceCreationFunc>::const_iterator genericIt = mGenericSources.begin(); genericIt != mGenericSources.end(); ++genericIt ) {
 		try {
-			return (*(genericIt->second))( dataSource, options );
+			return ImageSourceRegion::apply( (*(genericIt->second))( dataSource, options ), options );
 		}
 		catch( ImageIoException & ) {
 			// if we're out of handlers, rethrow the exception, otherwise continue on
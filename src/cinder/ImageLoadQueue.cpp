@@ -0,0 +1,377 @@
+/*
+ Copyright (c) 2026, The Cinder Project
+
+ This code is intended to be used with the Cinder C++ library, http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include "cinder/ImageLoadQueue.h"
+#include "cinder/Log.h"
+#include "cinder/Thread.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+
+using namespace std;
+
+namespace cinder {
+
+namespace {
+
+// Returns the extension loadImage() will use for \a dataSource, lowercase and without the leading dot.
+string getExtension( const DataSourceRef &dataSource )
+{
+	string result = dataSource->getFilePathHint().extension().string();
+	if( ! result.empty() && result[0] == '.' )
+		result = result.substr( 1 );
+	std::transform( result.begin(), result.end(), result.begin(), static_cast<int(*)(int)>( tolower ) );
+	return result;
+}
+
+// Calls the callback of \a request, logging rather than propagating anything it throws so that the remaining callbacks still run.
+void callCallback( const ImageLoadRequestRef &request, const function<void( const ImageLoadRequestRef& )> &callback )
+{
+	try {
+		callback( request );
+	}
+	catch( std::exception &exc ) {
+		CI_LOG_EXCEPTION( "exception in ImageLoadQueue callback", exc );
+	}
+	catch( ... ) {
+		CI_LOG_E( "unknown exception in ImageLoadQueue callback" );
+	}
+}
+
+} // anonymous namespace
+
+///////////////////////////////////////////////////////////////////////////////
+// ImageLoadRequest
+ImageLoadRequest::ImageLoadRequest( const ImageLoadQueueRef &queue, const DataSourceRef &dataSource, int32_t priority, uint64_t sequence )
+	: mQueue( queue ), mDataSource( dataSource ), mFuture( mPromise.get_future().share() ), mState( QUEUED ), mPriority( priority ),
+		mSequence( sequence ), mDecodeSeconds( 0 )
+{
+}
+
+ImageLoadRequest::State ImageLoadRequest::getState() const
+{
+	// once the queue is gone, every request has reached its final state
+	auto queue = mQueue.lock();
+	if( ! queue )
+		return mState;
+
+	lock_guard<mutex> lock( queue->mMutex );
+	return mState;
+}
+
+bool ImageLoadRequest::isFinished() const
+{
+	State state = getState();
+	return state == DONE || state == FAILED || state == CANCELLED;
+}
+
+int32_t ImageLoadRequest::getPriority() const
+{
+	auto queue = mQueue.lock();
+	if( ! queue )
+		return mPriority;
+
+	lock_guard<mutex> lock( queue->mMutex );
+	return mPriority;
+}
+
+void ImageLoadRequest::setPriority( int32_t priority )
+{
+	auto queue = mQueue.lock();
+	if( ! queue )
+		return;
+
+	lock_guard<mutex> lock( queue->mMutex );
+	if( mState != QUEUED || mPriority == priority )
+		return;
+
+	// the queue is ordered by priority, so the request has to be reinserted
+	auto self = shared_from_this();
+	queue->mQueued.erase( self );
+	mPriority = priority;
+	queue->mQueued.insert( self );
+}
+
+bool ImageLoadRequest::cancel()
+{
+	auto queue = mQueue.lock();
+	if( ! queue )
+		return false;
+
+	lock_guard<mutex> lock( queue->mMutex );
+	return queue->cancelLocked( shared_from_this() );
+}
+
+double ImageLoadRequest::getDecodeSeconds() const
+{
+	auto queue = mQueue.lock();
+	if( ! queue )
+		return mDecodeSeconds;
+
+	lock_guard<mutex> lock( queue->mMutex );
+	return mDecodeSeconds;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// ImageLoadQueue
+ImageLoadQueueRef ImageLoadQueue::create( const Options &options )
+{
+	ImageLoadQueueRef result( new ImageLoadQueue( options ) );
+	result->start();
+	return result;
+}
+
+ImageLoadQueueRef ImageLoadQueue::getDefault()
+{
+	// leaked, so that workers are never joined during static destruction
+	static ImageLoadQueueRef *sDefault = new ImageLoadQueueRef( create() );
+	return *sDefault;
+}
+
+ImageLoadQueue::ImageLoadQueue( const Options &options )
+	: mOptions( options ), mNumDecoding( 0 ), mNextSequence( 0 ), mStopping( false )
+{
+}
+
+ImageLoadQueue::~ImageLoadQueue()
+{
+	{
+		lock_guard<mutex> lock( mMutex );
+		mStopping = true;
+		while( ! mQueued.empty() )
+			cancelLocked( *mQueued.begin() );
+	}
+	mRequestCondition.notify_all();
+
+	for( auto &thread : mThreads )
+		thread.join();
+}
+
+void ImageLoadQueue::start()
+{
+	size_t numThreads = mOptions.getNumThreads();
+	if( numThreads == 0 )
+		numThreads = std::max<size_t>( 1, thread::hardware_concurrency() );
+
+	for( size_t i = 0; i < numThreads; i++ )
+		mThreads.emplace_back( &ImageLoadQueue::threadFn, this );
+}
+
+ImageLoadRequestRef ImageLoadQueue::load( const DataSourceRef &dataSource, int32_t priority, const Callback &callback )
+{
+	ImageLoadRequestRef result;
+	{
+		lock_guard<mutex> lock( mMutex );
+		result = ImageLoadRequestRef( new ImageLoadRequest( shared_from_this(), dataSource, priority, mNextSequence++ ) );
+		result->mCallback = callback;
+		mQueued.insert( result );
+	}
+	mRequestCondition.notify_one();
+
+	return result;
+}
+
+ImageLoadRequestRef ImageLoadQueue::load( const fs::path &path, int32_t priority, const Callback &callback )
+{
+	return load( loadFile( path ), priority, callback );
+}
+
+vector<ImageLoadRequestRef> ImageLoadQueue::load( const vector<DataSourceRef> &dataSources, int32_t priority, const Callback &callback )
+{
+	vector<ImageLoadRequestRef> result;
+	result.reserve( dataSources.size() );
+	{
+		lock_guard<mutex> lock( mMutex );
+		auto self = shared_from_this();
+		for( const auto &dataSource : dataSources ) {
+			result.push_back( ImageLoadRequestRef( new ImageLoadRequest( self, dataSource, priority, mNextSequence++ ) ) );
+			result.back()->mCallback = callback;
+			mQueued.insert( result.back() );
+		}
+	}
+	mRequestCondition.notify_all();
+
+	return result;
+}
+
+void ImageLoadQueue::cancelAll()
+{
+	lock_guard<mutex> lock( mMutex );
+	while( ! mQueued.empty() )
+		cancelLocked( *mQueued.begin() );
+}
+
+void ImageLoadQueue::waitAll()
+{
+	unique_lock<mutex> lock( mMutex );
+	mFinishedCondition.wait( lock, [this] { return mQueued.empty() && mNumDecoding == 0; } );
+}
+
+void ImageLoadQueue::poll()
+{
+	vector<ImageLoadRequestRef> finished;
+	{
+		lock_guard<mutex> lock( mDeferredMutex );
+		finished.swap( mDeferred );
+	}
+
+	for( const auto &request : finished )
+		callCallback( request, request->mCallback );
+}
+
+size_t ImageLoadQueue::getNumQueued() const
+{
+	lock_guard<mutex> lock( mMutex );
+	return mQueued.size();
+}
+
+map<string, ImageLoadQueue::DecodeStats> ImageLoadQueue::getDecodeStats() const
+{
+	lock_guard<mutex> lock( mMutex );
+	return mDecodeStats;
+}
+
+void ImageLoadQueue::resetDecodeStats()
+{
+	lock_guard<mutex> lock( mMutex );
+	mDecodeStats.clear();
+}
+
+bool ImageLoadQueue::cancelLocked( const ImageLoadRequestRef &request )
+{
+	if( request->mState != ImageLoadRequest::QUEUED )
+		return false;
+
+	mQueued.erase( request );
+	request->mState = ImageLoadRequest::CANCELLED;
+	request->mPromise.set_exception( make_exception_ptr( ImageLoadExceptionCancelled() ) );
+	mFinishedCondition.notify_all();
+	return true;
+}
+
+void ImageLoadQueue::threadFn()
+{
+	ThreadSetup threadSetup;
+
+	while( true ) {
+		ImageLoadRequestRef request;
+		{
+			unique_lock<mutex> lock( mMutex );
+			mRequestCondition.wait( lock, [this] { return mStopping || ! mQueued.empty(); } );
+			if( mStopping )
+				return;
+
+			request = *mQueued.begin();
+			mQueued.erase( mQueued.begin() );
+			request->mState = ImageLoadRequest::DECODING;
+			mNumDecoding++;
+		}
+
+		decode( request );
+		finish( request );
+	}
+}
+
+void ImageLoadQueue::decode( const ImageLoadRequestRef &request )
+{
+	const string extension = getExtension( request->mDataSource );
+
+	Surface8uRef surface;
+	exception_ptr exc;
+	auto start = chrono::steady_clock::now();
+	try {
+		ImageSourceRef source = loadImage( request->mDataSource, mOptions.getImageSourceOptions(), extension );
+		if( ! source )
+			throw ImageIoExceptionUnknownExtension( "Could not create source for image with extension: " + extension );
+		surface = Surface8u::create( source );
+	}
+	catch( ... ) {
+		exc = current_exception();
+	}
+	double seconds = chrono::duration<double>( chrono::steady_clock::now() - start ).count();
+
+	{
+		lock_guard<mutex> lock( mMutex );
+		DecodeStats &stats = mDecodeStats[extension];
+		if( surface ) {
+			stats.mNumDecoded++;
+			stats.mNumPixels += uint64_t( surface->getWidth() ) * uint64_t( surface->getHeight() );
+		}
+		else
+			stats.mNumFailed++;
+		stats.mTotalSeconds += seconds;
+		stats.mMaxSeconds = std::max( stats.mMaxSeconds, seconds );
+
+		request->mDecodeSeconds = seconds;
+		request->mState = surface ? ImageLoadRequest::DONE : ImageLoadRequest::FAILED;
+	}
+
+	if( surface )
+		request->mPromise.set_value( surface );
+	else
+		request->mPromise.set_exception( exc );
+}
+
+void ImageLoadQueue::finish( const ImageLoadRequestRef &request )
+{
+	if( request->mCallback ) {
+		if( mOptions.getDeferCallbacks() ) {
+			lock_guard<mutex> lock( mDeferredMutex );
+			mDeferred.push_back( request );
+		}
+		else
+			callCallback( request, request->mCallback );
+	}
+
+	{
+		lock_guard<mutex> lock( mMutex );
+		mNumDecoding--;
+	}
+	mFinishedCondition.notify_all();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// loadImagesAsync
+vector<shared_future<Surface8uRef>> loadImagesAsync( const vector<DataSourceRef> &dataSources, int32_t priority )
+{
+	vector<shared_future<Surface8uRef>> result;
+	result.reserve( dataSources.size() );
+	for( const auto &request : ImageLoadQueue::getDefault()->load( dataSources, priority ) )
+		result.push_back( request->getFuture() );
+
+	return result;
+}
+
+vector<shared_future<Surface8uRef>> loadImagesAsync( const vector<fs::path> &paths, int32_t priority )
+{
+	vector<DataSourceRef> dataSources;
+	dataSources.reserve( paths.size() );
+	for( const auto &path : paths )
+		dataSources.push_back( loadFile( path ) );
+
+	return loadImagesAsync( dataSources, priority );
+}
+
+} // namespace cinder
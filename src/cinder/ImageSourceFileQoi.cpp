@@ -26,45 +26,83 @@
 #define QOI_IMPLEMENTATION
 #include "qoi/qoi.h"
 
-#include <cstdio>
 #include <cstdlib>
 
+using namespace std;
+
 namespace cinder {
 
 namespace {
 
-// Cross-platform wrapper for qoi_read that handles Unicode paths properly
-void* qoiReadPath( const fs::path &path, qoi_desc *desc, int channels )
-{
-#if defined( CINDER_MSW )
-	FILE *f = _wfopen( path.wstring().c_str(), L"rb" );
-#else
-	FILE *f = fopen( path.string().c_str(), "rb" );
-#endif
-
-	if( ! f )
-		return nullptr;
-
-	fseek( f, 0, SEEK_END );
-	int size = ftell( f );
-	if( size <= 0 || fseek( f, 0, SEEK_SET ) != 0 ) {
-		fclose( f );
-		return nullptr;
+// The decoding loop of qoi_decode(), keeping its state between calls so that an image can be decoded a row at a time
+class QoiRowDecoder {
+  public:
+	QoiRowDecoder( const uint8_t *bytes, size_t size )
+		: mBytes( bytes ), mPos( QOI_HEADER_SIZE ), mChunksEnd( size - sizeof( qoi_padding ) ), mRun( 0 )
+	{
+		QOI_ZEROARR( mIndex );
+		mPixel.rgba.r = 0;
+		mPixel.rgba.g = 0;
+		mPixel.rgba.b = 0;
+		mPixel.rgba.a = 255;
 	}
 
-	void *data = malloc( size );
-	if( ! data ) {
-		fclose( f );
-		return nullptr;
+	//! Decodes the next \a numPixels pixels into \a pixels, with 3 or 4 \a channels.
+	void decode( uint8_t *pixels, size_t numPixels, int channels )
+	{
+		qoi_rgba_t px = mPixel;
+		for( size_t i = 0; i < numPixels; ++i, pixels += channels ) {
+			if( mRun > 0 )
+				mRun--;
+			else if( mPos < mChunksEnd ) {
+				const int b1 = mBytes[mPos++];
+				if( b1 == QOI_OP_RGB ) {
+					px.rgba.r = mBytes[mPos++];
+					px.rgba.g = mBytes[mPos++];
+					px.rgba.b = mBytes[mPos++];
+				}
+				else if( b1 == QOI_OP_RGBA ) {
+					px.rgba.r = mBytes[mPos++];
+					px.rgba.g = mBytes[mPos++];
+					px.rgba.b = mBytes[mPos++];
+					px.rgba.a = mBytes[mPos++];
+				}
+				else if( ( b1 & QOI_MASK_2 ) == QOI_OP_INDEX )
+					px = mIndex[b1];
+				else if( ( b1 & QOI_MASK_2 ) == QOI_OP_DIFF ) {
+					px.rgba.r += ( ( b1 >> 4 ) & 0x03 ) - 2;
+					px.rgba.g += ( ( b1 >> 2 ) & 0x03 ) - 2;
+					px.rgba.b += ( b1 & 0x03 ) - 2;
+				}
+				else if( ( b1 & QOI_MASK_2 ) == QOI_OP_LUMA ) {
+					const int b2 = mBytes[mPos++];
+					const int vg = ( b1 & 0x3f ) - 32;
+					px.rgba.r += vg - 8 + ( ( b2 >> 4 ) & 0x0f );
+					px.rgba.g += vg;
+					px.rgba.b += vg - 8 + ( b2 & 0x0f );
+				}
+				else if( ( b1 & QOI_MASK_2 ) == QOI_OP_RUN )
+					mRun = b1 & 0x3f;
+
+				mIndex[QOI_COLOR_HASH( px ) & ( 64 - 1 )] = px;
+			}
+
+			pixels[0] = px.rgba.r;
+			pixels[1] = px.rgba.g;
+			pixels[2] = px.rgba.b;
+			if( channels == 4 )
+				pixels[3] = px.rgba.a;
+		}
+		mPixel = px;
 	}
 
-	int bytesRead = (int)fread( data, 1, size, f );
-	fclose( f );
-
-	void *pixels = ( bytesRead != size ) ? nullptr : qoi_decode( data, bytesRead, desc, channels );
-	free( data );
-	return pixels;
-}
+  private:
+	const uint8_t	*mBytes;
+	size_t			mPos, mChunksEnd;
+	int				mRun;
+	qoi_rgba_t		mIndex[64];
+	qoi_rgba_t		mPixel;
+};
 
 } // anonymous namespace
 
@@ -86,32 +124,37 @@ void ImageSourceFileQoi::registerSelf()
 
 ///////////////////////////////////////////////////////////////////////////////
 // ImageSourceFileQoi
-ImageSourceFileQoi::ImageSourceFileQoi( DataSourceRef dataSourceRef, ImageSource::Options /*options*/ )
-	: mData( nullptr ), mRowBytes( 0 )
+ImageSourceFileQoi::ImageSourceFileQoi( DataSourceRef dataSourceRef, ImageSource::Options options )
 {
-	qoi_desc desc;
-	int channels = 0;
-
-	if( dataSourceRef->isFilePath() ) {
-		mData = (uint8_t*)qoiReadPath( dataSourceRef->getFilePath(), &desc, 0 );
-		if( ! mData )
-			throw ImageIoExceptionFailedLoad( "Failed to load QOI image" );
-
-		channels = desc.channels;
-		mRowBytes = desc.width * channels;
-	}
-	else { // we'll use a dataref from the buffer
-		BufferRef buffer = dataSourceRef->getBuffer();
-		mData = (uint8_t*)qoi_decode( buffer->getData(), (int)buffer->getSize(), &desc, 0 );
-		if( ! mData )
-			throw ImageIoExceptionFailedLoad( "Failed to decode QOI image" );
-
-		channels = desc.channels;
-		mRowBytes = desc.width * channels;
+	// files are mapped rather than read, so that only the pages of the rows which are decoded are loaded
+	if( dataSourceRef->isFilePath() && ! std::dynamic_pointer_cast<DataSourceMemoryMapped>( dataSourceRef ) ) {
+		try {
+			mEncoded = DataSourceMemoryMapped::create( dataSourceRef->getFilePath() )->getBuffer();
+		}
+		catch( MemoryMappedFileExc &exc ) {
+			throw ImageIoExceptionFailedLoad( string( "Failed to load QOI image: " ) + exc.what() );
+		}
 	}
+	else // we'll use a dataref from the buffer
+		mEncoded = dataSourceRef->getBuffer();
+
+	// only the header is parsed here; pixels are decoded a row at a time by load()
+	const unsigned char *bytes = static_cast<const unsigned char*>( mEncoded->getData() );
+	if( mEncoded->getSize() < QOI_HEADER_SIZE + sizeof( qoi_padding ) )
+		throw ImageIoExceptionFailedLoad( "Failed to decode QOI image" );
+
+	int p = 0;
+	unsigned int magic = qoi_read_32( bytes, &p );
+	unsigned int width = qoi_read_32( bytes, &p );
+	unsigned int height = qoi_read_32( bytes, &p );
+	int channels = bytes[p++];
+	int colorspace = bytes[p++];
+	if( magic != QOI_MAGIC || width == 0 || height == 0 || colorspace > 1 || height >= QOI_PIXELS_MAX / width )
+		throw ImageIoExceptionFailedLoad( "Failed to decode QOI image" );
 
 	setDataType( ImageIo::UINT8 );
-	setSize( desc.width, desc.height );
+	setSize( width, height );
+	mFullWidth = width;
 
 	switch( channels ) {
 		case 3:
@@ -123,23 +166,24 @@ ImageSourceFileQoi::ImageSourceFileQoi( DataSourceRef dataSourceRef, ImageSource
 			setChannelOrder( ImageIo::ChannelOrder::RGBA );
 		break;
 		default:
-			free( mData );
 			throw ImageIoException( "QOI: Unsupported number of channels" );
 	}
-}
-
 
-ImageSourceFileQoi::~ImageSourceFileQoi()
-{
-	if( mData )
-		free( mData );
+	setupRegion( options );
 }
 
 void ImageSourceFileQoi::load( ImageTargetRef target )
 {
 	ImageSource::RowFunc func = setupRowFunc( target );
-	for( int32_t row = 0; row < mHeight; ++row ) {
-		((*this).*func)( target, row, mData + row * mRowBytes );
+
+	// decodes a row at a time, stopping after the last row of the requested area
+	const int channels = channelOrderNumChannels( mChannelOrder );
+	std::vector<uint8_t> row( mFullWidth * channels );
+
+	QoiRowDecoder decoder( static_cast<const uint8_t*>( mEncoded->getData() ), mEncoded->getSize() );
+	for( int32_t y = 0; y < mRegionArea.y2; ++y ) {
+		decoder.decode( row.data(), mFullWidth, channels );
+		processRegionRow( target, func, y, row.data() );
 	}
 }
 
@@ -57,7 +57,7 @@ void ImageSourceFileStbImage::registerSelf()
 
 ///////////////////////////////////////////////////////////////////////////////
 // ImageSourceFileStbImage
-ImageSourceFileStbImage::ImageSourceFileStbImage( DataSourceRef dataSourceRef, ImageSource::Options /*options*/ )
+ImageSourceFileStbImage::ImageSourceFileStbImage( DataSourceRef dataSourceRef, ImageSource::Options options )
 	: mData8u( nullptr ), mData32f( nullptr ), mRowBytes( 0 )
 {
 	int width = 0, height = 0, components = 0;
@@ -122,6 +122,8 @@ ImageSourceFileStbImage::ImageSourceFileStbImage( DataSourceRef dataSourceRef, I
 		default:
 			throw ImageIoException();
 	}
+
+	setupRegion( options );
 }
 
 
@@ -137,8 +139,8 @@ void ImageSourceFileStbImage::load( ImageTargetRef target )
 {
 	ImageSource::RowFunc func = setupRowFunc( target );
 	const uint8_t *data = ( mData8u ) ? mData8u : reinterpret_cast<uint8_t*>( mData32f );
-	for( int32_t row = 0; row < mHeight; ++row ) {
-		((*this).*func)( target, row, data + row * mRowBytes );
+	for( int32_t row = mRegionArea.y1; row < mRegionArea.y2; ++row ) {
+		processRegionRow( target, func, row, data + row * mRowBytes );
 	}
 }
 
@@ -76,7 +76,7 @@ ImageSourcePngRef ImageSourcePng::createRef( DataSourceRef dataSourceRef, ImageS
 	return ImageSourcePngRef( new ImageSourcePng( dataSourceRef, options ) );
 }
 
-ImageSourcePng::ImageSourcePng( DataSourceRef dataSourceRef, ImageSource::Options /*options*/ )
+ImageSourcePng::ImageSourcePng( DataSourceRef dataSourceRef, ImageSource::Options options )
 	: ImageSource(), mInfoPtr( 0 ), mPngPtr( 0 )
 {
 	mPngPtr = png_create_read_struct( PNG_LIBPNG_VER_STRING, (png_voidp)NULL, NULL, NULL );
@@ -98,6 +98,8 @@ ImageSourcePng::ImageSourcePng( DataSourceRef dataSourceRef, ImageSource::Option
 	
 	if( ! loadHeader() )
 		throw ImageSourcePngException( "Could not load png header." );
+
+	setupRegion( options );
 }
 
 // part of this being separated allows for us to play nicely with the setjmp of libpng
@@ -178,9 +180,10 @@ void ImageSourcePng::load( ImageTargetRef target )
 		ImageSource::RowFunc func = setupRowFunc( target );
 		//int number_passes = png_set_interlace_handling( mPngPtr );
 		unique_ptr<png_byte[]> row_pointer( new png_byte[png_get_rowbytes( mPngPtr, mInfoPtr )] );
-		for( int32_t row = 0; row < mHeight; ++row ) {
+		// rows below the requested area are never decompressed
+		for( int32_t row = 0; row < mRegionArea.y2; ++row ) {
 			png_read_row( mPngPtr, row_pointer.get(), NULL );
-			((*this).*func)( target, row, row_pointer.get() );
+			processRegionRow( target, func, row, row_pointer.get() );
 		}
 	}
 	
@@ -48,6 +48,9 @@
 #endif
 
 #include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
 #include <algorithm>
 #include <time.h>
 #include <cstring>
@@ -59,9 +62,9 @@ namespace cinder { namespace log {
 namespace  {
 
 // output format is YYYY-MM-DD.HH:mm:ss
-const std::string getCurrentDateTimeString()
+const std::string getDateTimeString( const chrono::system_clock::time_point &time )
 {
-	time_t timeSinceEpoch = time( NULL );
+	time_t timeSinceEpoch = chrono::system_clock::to_time_t( time );
 	struct tm *now = localtime( &timeSinceEpoch );
 
 	char result[100];
@@ -70,6 +73,10 @@ const std::string getCurrentDateTimeString()
 	return result;
 }
 
+// Set while this thread writes a batch of asynchronous entries, usually on the writer thread. The loggers run with mMutex and the drain
+// lock held, so entries they log meanwhile can't be written synchronously or wait for room in a buffer.
+thread_local bool sWritingBatch = false;
+
 int getCurrentYearDay()
 {
 	time_t timeSinceEpoch = time( NULL );
@@ -103,10 +110,16 @@ LogManager* manager()
 }
 
 LogManager::LogManager()
+	: mAsyncEnabled( false )
 {
 	restoreToDefault();
 }
 
+LogManager::~LogManager()
+{
+	disableAsync();
+}
+
 void LogManager::clearLoggers()
 {
 	lock_guard<mutex> lock( mMutex );
@@ -163,6 +176,9 @@ void LogManager::setLevel( Level level )
 
 void LogManager::write( const Metadata &meta, const std::string &text )
 {
+	if( ( mAsyncEnabled.load( memory_order_acquire ) || sWritingBatch ) && writeAsync( meta, string( text ) ) )
+		return;
+
 	// TODO move this to a shared_lock_timed with c++14 support
 	lock_guard<mutex> lock( mMutex );
 
@@ -171,6 +187,375 @@ void LogManager::write( const Metadata &meta, const std::string &text )
 	}
 }
 
+void LogManager::write( const Metadata &meta, std::string &&text )
+{
+	if( ( mAsyncEnabled.load( memory_order_acquire ) || sWritingBatch ) && writeAsync( meta, std::move( text ) ) )
+		return;
+
+	lock_guard<mutex> lock( mMutex );
+
+	for( auto& logger : mLoggers ) {
+		logger->write( meta, text );
+	}
+}
+
+// ----------------------------------------------------------------------------------------------------
+// LogManager::AsyncWriter
+// ----------------------------------------------------------------------------------------------------
+
+struct LogManager::AsyncEntry {
+	uint64_t	mSequence;
+	Metadata	mMeta;
+	std::string	mText;
+};
+
+class LogManager::AsyncWriter {
+  public:
+	AsyncWriter( LogManager *manager )
+		: mManager( manager ), mSyncLevel( LEVEL_FATAL ), mBufferCapacity( 0 ), mAccepting( false ), mNumDropped( 0 ), mNumDroppedReported( 0 ), mNextSequence( 0 ), mWakeRequested( false ), mStopRequested( false )
+	{}
+
+	void	start( const AsyncOptions &options );
+	void	stop();
+
+	// Returns false if the entry must be written synchronously, because asynchronous logging was disabled concurrently.
+	bool	push( const Metadata &meta, std::string &&text );
+	// Writes all queued entries. Can be called from any thread, but only one thread drains at a time.
+	void	drain();
+
+	Level		getSyncLevel() const	{ return static_cast<Level>( mSyncLevel.load( memory_order_relaxed ) ); }
+	uint64_t	getNumDropped() const	{ return mNumDropped.load( memory_order_relaxed ); }
+	void		addDropped()			{ mNumDropped.fetch_add( 1, memory_order_relaxed ); }
+
+  private:
+	// A single-producer, single-consumer ring buffer. Only its owning thread pushes, and only the thread holding mDrainMutex pops.
+	struct ThreadBuffer {
+		ThreadBuffer( size_t capacity, AsyncOptions::Overflow overflow )
+			: mSlots( capacity ), mMask( capacity - 1 ), mOverflow( overflow ), mHead( 0 ), mTail( 0 ), mBusy( false ), mDetached( false ), mRetired( false )
+		{}
+
+		std::vector<AsyncEntry>	mSlots;
+		size_t					mMask;
+		AsyncOptions::Overflow	mOverflow;
+		alignas( 64 ) std::atomic<size_t>	mHead;	// next slot to pop, written by the consumer
+		alignas( 64 ) std::atomic<size_t>	mTail;	// next slot to push, written by the producer
+		// set by the producer while it pushes, so that stop() can wait for pushes that missed mDetached
+		std::atomic<bool>		mBusy;
+		// set by stop(), after which the producer writes synchronously and registers a new buffer once re-enabled
+		std::atomic<bool>		mDetached;
+		// set when the producing thread exits, so the buffer is discarded once drained
+		std::atomic<bool>		mRetired;
+	};
+
+	struct ThreadBufferHolder {
+		~ThreadBufferHolder()
+		{
+			if( mBuffer )
+				mBuffer->mRetired.store( true, memory_order_release );
+		}
+
+		std::shared_ptr<ThreadBuffer>	mBuffer;
+	};
+
+	ThreadBuffer*	getThreadBuffer();
+	void			wake();
+	void			run();
+
+	LogManager							*mManager;
+	AsyncOptions						mOptions; // guarded by mBuffersMutex
+	std::atomic<int>					mSyncLevel;
+	std::thread							mThread;
+
+	std::mutex							mBuffersMutex;
+	std::vector<std::shared_ptr<ThreadBuffer>>	mBuffers; // guarded by mBuffersMutex
+	size_t								mBufferCapacity; // guarded by mBuffersMutex
+	bool								mAccepting; // guarded by mBuffersMutex, false while stopped
+
+	std::mutex							mDrainMutex;
+	std::vector<AsyncEntry>				mBatch; // guarded by mDrainMutex
+	std::atomic<uint64_t>				mNumDropped;
+	uint64_t							mNumDroppedReported; // guarded by mDrainMutex
+	std::atomic<uint64_t>				mNextSequence;
+
+	std::mutex							mWakeMutex;
+	std::condition_variable				mWakeCondition;
+	std::atomic<bool>					mWakeRequested;
+	bool								mStopRequested; // guarded by mWakeMutex
+};
+
+void LogManager::AsyncWriter::start( const AsyncOptions &options )
+{
+	mSyncLevel.store( options.getSyncLevel(), memory_order_relaxed );
+	{
+		lock_guard<mutex> lock( mBuffersMutex );
+		mOptions = options;
+		mBufferCapacity = 2;
+		while( mBufferCapacity < options.getBufferSize() )
+			mBufferCapacity *= 2;
+		mAccepting = true;
+	}
+
+	mStopRequested = false;
+	mWakeRequested.store( false );
+	mThread = std::thread( &AsyncWriter::run, this );
+}
+
+void LogManager::AsyncWriter::stop()
+{
+	// detach every buffer and wait for pushes that are in flight, after which no more entries can be queued
+	vector<shared_ptr<ThreadBuffer>> buffers;
+	{
+		lock_guard<mutex> lock( mBuffersMutex );
+		mAccepting = false;
+		buffers = mBuffers;
+	}
+	for( auto &buffer : buffers )
+		buffer->mDetached.store( true );
+	for( auto &buffer : buffers ) {
+		while( buffer->mBusy.load() )
+			this_thread::yield();
+	}
+
+	{
+		lock_guard<mutex> lock( mWakeMutex );
+		mStopRequested = true;
+	}
+	mWakeCondition.notify_one();
+	mThread.join();
+
+	lock_guard<mutex> lock( mBuffersMutex );
+	mBuffers.clear();
+}
+
+LogManager::AsyncWriter::ThreadBuffer* LogManager::AsyncWriter::getThreadBuffer()
+{
+	static thread_local ThreadBufferHolder sHolder;
+
+	if( ! sHolder.mBuffer || sHolder.mBuffer->mDetached.load( memory_order_relaxed ) ) {
+		lock_guard<mutex> lock( mBuffersMutex );
+		if( ! mAccepting )
+			return nullptr;
+
+		sHolder.mBuffer = make_shared<ThreadBuffer>( mBufferCapacity, mOptions.getOverflow() );
+		mBuffers.push_back( sHolder.mBuffer );
+	}
+
+	return sHolder.mBuffer.get();
+}
+
+bool LogManager::AsyncWriter::push( const Metadata &meta, std::string &&text )
+{
+	ThreadBuffer *buffer = getThreadBuffer();
+	if( ! buffer )
+		return false;
+
+	// mBusy and mDetached are both sequentially consistent, so either stop() waits for this push or the push sees mDetached
+	buffer->mBusy.store( true );
+	if( buffer->mDetached.load() ) {
+		buffer->mBusy.store( false, memory_order_release );
+		return false;
+	}
+
+	const size_t tail = buffer->mTail.load( memory_order_relaxed );
+	while( tail - buffer->mHead.load( memory_order_acquire ) > buffer->mMask ) {
+		// a thread writing a batch would be waiting for itself to drain the buffer
+		if( buffer->mOverflow == AsyncOptions::Overflow::DROP || sWritingBatch ) {
+			buffer->mBusy.store( false, memory_order_release );
+			mNumDropped.fetch_add( 1, memory_order_relaxed );
+			wake();
+			return true;
+		}
+
+		// Overflow::BLOCK, give up if stop() is waiting for this push
+		if( buffer->mDetached.load() ) {
+			buffer->mBusy.store( false, memory_order_release );
+			return false;
+		}
+		wake();
+		this_thread::yield();
+	}
+
+	AsyncEntry &slot = buffer->mSlots[tail & buffer->mMask];
+	slot.mSequence = mNextSequence.fetch_add( 1, memory_order_relaxed );
+	slot.mMeta = meta;
+	slot.mText = std::move( text );
+	buffer->mTail.store( tail + 1, memory_order_release );
+	buffer->mBusy.store( false, memory_order_release );
+
+	// don't wait for the flush interval once the buffer is half full
+	if( tail + 1 - buffer->mHead.load( memory_order_relaxed ) > buffer->mSlots.size() / 2 )
+		wake();
+
+	return true;
+}
+
+void LogManager::AsyncWriter::wake()
+{
+	if( mWakeRequested.load( memory_order_relaxed ) )
+		return;
+
+	{
+		lock_guard<mutex> lock( mWakeMutex );
+		mWakeRequested.store( true, memory_order_relaxed );
+	}
+	mWakeCondition.notify_one();
+}
+
+void LogManager::AsyncWriter::drain()
+{
+	lock_guard<mutex> drainLock( mDrainMutex );
+
+	vector<shared_ptr<ThreadBuffer>> buffers;
+	{
+		lock_guard<mutex> lock( mBuffersMutex );
+		buffers = mBuffers;
+	}
+
+	mBatch.clear();
+	bool removeRetired = false;
+	for( auto &buffer : buffers ) {
+		// a retired buffer receives no more entries, so it is empty after this pop
+		const bool retired = buffer->mRetired.load( memory_order_acquire );
+		removeRetired = removeRetired || retired;
+
+		const size_t tail = buffer->mTail.load( memory_order_acquire );
+		size_t head = buffer->mHead.load( memory_order_relaxed );
+		for( ; head != tail; ++head )
+			mBatch.push_back( std::move( buffer->mSlots[head & buffer->mMask] ) );
+		buffer->mHead.store( head, memory_order_release );
+
+		if( retired )
+			buffer.reset();
+	}
+
+	if( removeRetired ) {
+		lock_guard<mutex> lock( mBuffersMutex );
+		mBuffers.erase( remove_if( mBuffers.begin(), mBuffers.end(), []( const shared_ptr<ThreadBuffer> &buffer ) {
+			return buffer->mRetired.load( memory_order_acquire ) && buffer->mHead.load( memory_order_relaxed ) == buffer->mTail.load( memory_order_acquire );
+		} ), mBuffers.end() );
+	}
+
+	// restore the order in which entries were logged across threads
+	sort( mBatch.begin(), mBatch.end(), []( const AsyncEntry &a, const AsyncEntry &b ) { return a.mSequence < b.mSequence; } );
+
+	const uint64_t numDropped = mNumDropped.load( memory_order_relaxed );
+	if( numDropped != mNumDroppedReported ) {
+		AsyncEntry entry;
+		entry.mSequence = 0;
+		entry.mMeta.mLevel = LEVEL_WARNING;
+		entry.mMeta.mLocation = Location( CINDER_CURRENT_FUNCTION, __FILE__, __LINE__ );
+		entry.mMeta.mTime = chrono::system_clock::now();
+		entry.mText = "dropped " + to_string( numDropped - mNumDroppedReported ) + " log entries, the log buffer was full";
+		mBatch.push_back( std::move( entry ) );
+		mNumDroppedReported = numDropped;
+	}
+
+	if( ! mBatch.empty() ) {
+		sWritingBatch = true;
+		mManager->writeBatch( mBatch );
+		sWritingBatch = false;
+	}
+}
+
+void LogManager::AsyncWriter::run()
+{
+	const auto interval = chrono::duration<double>( std::max( mOptions.getFlushInterval(), 0.0 ) );
+	while( true ) {
+		bool stop;
+		{
+			unique_lock<mutex> lock( mWakeMutex );
+			mWakeCondition.wait_for( lock, interval, [this] { return mWakeRequested.load( memory_order_relaxed ) || mStopRequested; } );
+			mWakeRequested.store( false, memory_order_relaxed );
+			stop = mStopRequested;
+		}
+
+		drain();
+		if( stop )
+			break;
+	}
+}
+
+void LogManager::enableAsync( const AsyncOptions &options )
+{
+	lock_guard<mutex> lock( mAsyncMutex );
+
+	if( mAsyncEnabled.load() ) {
+		mAsyncEnabled.store( false );
+		mAsyncWriter->stop();
+	}
+	else if( ! mAsyncWriter ) {
+		mAsyncWriter.reset( new AsyncWriter( this ) );
+		// write pending entries at exit, as the shared instance is never destroyed
+		static bool sRegisteredAtExit = false;
+		if( ! sRegisteredAtExit ) {
+			atexit( [] {
+				if( LogManager::instance() )
+					LogManager::instance()->disableAsync();
+			} );
+			sRegisteredAtExit = true;
+		}
+	}
+
+	mAsyncWriter->start( options );
+	mAsyncEnabled.store( true, memory_order_release );
+}
+
+void LogManager::disableAsync()
+{
+	lock_guard<mutex> lock( mAsyncMutex );
+
+	if( ! mAsyncEnabled.load() )
+		return;
+
+	mAsyncEnabled.store( false );
+	mAsyncWriter->stop();
+}
+
+void LogManager::flush()
+{
+	// the writer is only destroyed along with the LogManager, so it is safe to use once async logging has been enabled. Loggers calling
+	// this while a batch is written are already part of a drain.
+	if( mAsyncEnabled.load( memory_order_acquire ) && ! sWritingBatch )
+		mAsyncWriter->drain();
+}
+
+uint64_t LogManager::getNumDropped() const
+{
+	return mAsyncWriter ? mAsyncWriter->getNumDropped() : 0;
+}
+
+void LogManager::writeBatch( const std::vector<AsyncEntry> &entries )
+{
+	lock_guard<mutex> lock( mMutex );
+
+	// loggers only flush their output once per batch, rather than after every line
+	for( auto& logger : mLoggers ) {
+		logger->mBatching = true;
+		for( const auto &entry : entries )
+			logger->write( entry.mMeta, entry.mText );
+		logger->mBatching = false;
+		logger->flush();
+	}
+}
+
+bool LogManager::writeAsync( const Metadata &meta, std::string &&text )
+{
+	if( sWritingBatch ) {
+		// logged by a Logger, queued for the next batch regardless of level or dropped once the writer is stopping
+		if( ! mAsyncWriter->push( meta, std::move( text ) ) )
+			mAsyncWriter->addDropped();
+		return true;
+	}
+
+	if( meta.mLevel >= mAsyncWriter->getSyncLevel() ) {
+		// written by the caller, after everything that was queued before it
+		mAsyncWriter->drain();
+		return false;
+	}
+
+	return mAsyncWriter->push( meta, std::move( text ) );
+}
+
 // ----------------------------------------------------------------------------------------------------
 // Entry
 // ----------------------------------------------------------------------------------------------------
@@ -180,6 +565,7 @@ Entry::Entry( Level level, const Location &location )
 {
 	mMetaData.mLevel = level;
 	mMetaData.mLocation = location;
+	mMetaData.mTime = chrono::system_clock::now();
 }
 
 Entry::~Entry()
@@ -201,10 +587,15 @@ void Logger::writeDefault( std::ostream &stream, const Metadata &meta, const std
 {
 	stream << meta.mLevel << " ";
 
-	if( isTimestampEnabled() )
-		stream << getCurrentDateTimeString() << " ";
+	if( isTimestampEnabled() ) {
+		// entries written asynchronously keep the time they were logged at
+		const bool hasTime = meta.mTime != chrono::system_clock::time_point();
+		stream << getDateTimeString( hasTime ? meta.mTime : chrono::system_clock::now() ) << " ";
+	}
 
-	stream << meta.mLocation << " " << text << endl;
+	stream << meta.mLocation << " " << text << "\n";
+	if( ! mBatching )
+		stream.flush();
 }
 
 // ----------------------------------------------------------------------------------------------------
@@ -219,6 +610,11 @@ void LoggerConsole::write( const Metadata &meta, const string &text )
 	writeDefault( app::Platform::get()->console(), meta, text );
 }
 
+void LoggerConsole::flush()
+{
+	app::Platform::get()->console().flush();
+}
+
 // ----------------------------------------------------------------------------------------------------
 // LoggerFile
 // ----------------------------------------------------------------------------------------------------
@@ -251,6 +647,12 @@ void LoggerFile::write( const Metadata &meta, const string &text )
 	writeDefault( mStream, meta, text );
 }
 
+void LoggerFile::flush()
+{
+	if( mStream.is_open() )
+		mStream.flush();
+}
+
 fs::path LoggerFile::getDefaultLogFilePath() const
 {
 	return app::Platform::get()->getExecutablePath() / fs::path( "cinder.log" );
@@ -0,0 +1,120 @@
+/*
+ Copyright (c) 2026, The Cinder Project
+
+ This code is intended to be used with the Cinder C++ library, http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include "cinder/MemoryMappedFile.h"
+
+#if defined( CINDER_MSW )
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace cinder {
+
+#if defined( CINDER_MSW )
+
+MemoryMappedFile::MemoryMappedFile( const fs::path &path, bool copyOnWrite )
+	: mFilePath( path ), mData( nullptr ), mSize( 0 ), mCopyOnWrite( copyOnWrite ), mFileHandle( INVALID_HANDLE_VALUE ), mMappingHandle( nullptr )
+{
+	mFileHandle = ::CreateFileW( path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
+	if( mFileHandle == INVALID_HANDLE_VALUE )
+		throw MemoryMappedFileExc( "Failed to open file: " + path.string() );
+
+	LARGE_INTEGER size;
+	if( ! ::GetFileSizeEx( mFileHandle, &size ) ) {
+		::CloseHandle( mFileHandle );
+		throw MemoryMappedFileExc( "Failed to get size of file: " + path.string() );
+	}
+
+	mSize = (size_t)size.QuadPart;
+	if( ! mSize )
+		return;
+
+	mMappingHandle = ::CreateFileMappingW( mFileHandle, nullptr, copyOnWrite ? PAGE_WRITECOPY : PAGE_READONLY, 0, 0, nullptr );
+	if( mMappingHandle )
+		mData = ::MapViewOfFile( mMappingHandle, copyOnWrite ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, 0 );
+
+	if( ! mData ) {
+		if( mMappingHandle )
+			::CloseHandle( mMappingHandle );
+		::CloseHandle( mFileHandle );
+		throw MemoryMappedFileExc( "Failed to map file: " + path.string() );
+	}
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+	if( mData )
+		::UnmapViewOfFile( mData );
+	if( mMappingHandle )
+		::CloseHandle( mMappingHandle );
+	if( mFileHandle != INVALID_HANDLE_VALUE )
+		::CloseHandle( mFileHandle );
+}
+
+#else
+
+MemoryMappedFile::MemoryMappedFile( const fs::path &path, bool copyOnWrite )
+	: mFilePath( path ), mData( nullptr ), mSize( 0 ), mCopyOnWrite( copyOnWrite )
+{
+	int fd = ::open( path.c_str(), O_RDONLY );
+	if( fd < 0 )
+		throw MemoryMappedFileExc( "Failed to open file: " + path.string() );
+
+	struct stat info;
+	if( ::fstat( fd, &info ) != 0 ) {
+		::close( fd );
+		throw MemoryMappedFileExc( "Failed to get size of file: " + path.string() );
+	}
+
+	mSize = (size_t)info.st_size;
+	if( mSize ) {
+		// a private mapping shares the file's pages until one is written to
+		void *data = copyOnWrite ? ::mmap( nullptr, mSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0 ) : ::mmap( nullptr, mSize, PROT_READ, MAP_SHARED, fd, 0 );
+		if( data == MAP_FAILED ) {
+			::close( fd );
+			throw MemoryMappedFileExc( "Failed to map file: " + path.string() );
+		}
+
+		mData = data;
+	}
+
+	// the mapping keeps its own reference to the file
+	::close( fd );
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+	if( mData )
+		::munmap( const_cast<void *>( mData ), mSize );
+}
+
+#endif
+
+} // namespace cinder
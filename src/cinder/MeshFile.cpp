@@ -0,0 +1,429 @@
+/*
+ Copyright (c) 2026, The Cinder Project
+
+ This code is intended to be used with the Cinder C++ library, http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+
+#include "cinder/MeshFile.h"
+#include "cinder/TriMesh.h"
+#include "cinder/MemoryMappedFile.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+using namespace std;
+
+namespace cinder {
+
+namespace {
+
+const char sMagic[8] = { 'C', 'I', 'M', 'E', 'S', 'H', 0, 0 };
+const uint32_t sByteOrderMark = 0x01020304;
+
+uint64_t alignData( uint64_t offset )
+{
+	return ( offset + MeshFileHeader::DATA_ALIGNMENT - 1 ) / MeshFileHeader::DATA_ALIGNMENT * MeshFileHeader::DATA_ALIGNMENT;
+}
+
+bool isDirection( geom::Attrib attr )
+{
+	return attr == geom::NORMAL || attr == geom::TANGENT || attr == geom::BITANGENT;
+}
+
+uint64_t encodedBytes( const MeshFileAttrib &attrib, uint64_t numVertices )
+{
+	switch( attrib.mEncoding ) {
+		case MeshFileAttrib::FLOAT32:		return numVertices * attrib.mDims * sizeof( float );
+		case MeshFileAttrib::UNORM16:		return numVertices * attrib.mDims * sizeof( uint16_t );
+		case MeshFileAttrib::OCT_SNORM16:	return numVertices * 2 * sizeof( int16_t );
+		default:							return 0;
+	}
+}
+
+int16_t toSnorm16( float v )
+{
+	return static_cast<int16_t>( std::round( glm::clamp( v, -1.0f, 1.0f ) * 32767.0f ) );
+}
+
+// Octahedral projection of a unit vector, with the lower hemisphere folded over the diagonals
+void encodeOctahedral( const float *v, int16_t *result )
+{
+	const float length = std::abs( v[0] ) + std::abs( v[1] ) + std::abs( v[2] );
+	float x = ( length > 0 ) ? v[0] / length : 0;
+	float y = ( length > 0 ) ? v[1] / length : 0;
+	if( v[2] < 0 ) {
+		const float foldedX = ( 1 - std::abs( y ) ) * ( x >= 0 ? 1 : -1 );
+		y = ( 1 - std::abs( x ) ) * ( y >= 0 ? 1 : -1 );
+		x = foldedX;
+	}
+	result[0] = toSnorm16( x );
+	result[1] = toSnorm16( y );
+}
+
+void decodeOctahedral( const int16_t *v, float *result )
+{
+	float x = std::max( v[0] / 32767.0f, -1.0f );
+	float y = std::max( v[1] / 32767.0f, -1.0f );
+	const float z = 1 - std::abs( x ) - std::abs( y );
+	const float t = std::max( -z, 0.0f );
+	x += ( x >= 0 ) ? -t : t;
+	y += ( y >= 0 ) ? -t : t;
+
+	const float invLength = 1 / std::sqrt( x * x + y * y + z * z );
+	result[0] = x * invLength;
+	result[1] = y * invLength;
+	result[2] = z * invLength;
+}
+
+void appendVarint( uint32_t value, vector<uint8_t> *result )
+{
+	while( value >= 0x80 ) {
+		result->push_back( static_cast<uint8_t>( value | 0x80 ) );
+		value >>= 7;
+	}
+	result->push_back( static_cast<uint8_t>( value ) );
+}
+
+// Records the attribute and index pointers handed over by a TriMesh, which stay valid as long as the TriMesh does
+class MeshFileWriteTarget : public geom::Target {
+  public:
+	struct Attrib {
+		geom::Attrib	mAttrib;
+		uint8_t			mDims;
+		size_t			mStrideBytes;
+		const float		*mData;
+	};
+
+	MeshFileWriteTarget( const TriMesh &mesh ) : mMesh( mesh ), mIndices( nullptr ), mNumIndices( 0 ) {}
+
+	uint8_t	getAttribDims( geom::Attrib attr ) const override	{ return mMesh.getAttribDims( attr ); }
+
+	void copyAttrib( geom::Attrib attr, uint8_t dims, size_t strideBytes, const float *srcData, size_t count ) override
+	{
+		if( dims > 4 )
+			throw MeshFileExc( "cimesh: attributes may have at most 4 components" );
+		mAttribs.push_back( { attr, dims, strideBytes ? strideBytes : dims * sizeof( float ), srcData } );
+	}
+
+	void copyIndices( geom::Primitive primitive, const uint32_t *source, size_t numIndices, uint8_t requiredBytesPerIndex ) override
+	{
+		mIndices = source;
+		mNumIndices = numIndices;
+	}
+
+	const TriMesh		&mMesh;
+	vector<Attrib>		mAttribs;
+	const uint32_t		*mIndices;
+	size_t				mNumIndices;
+};
+
+} // anonymous namespace
+
+///////////////////////////////////////////////////////////////////////////////
+// MeshFile
+MeshFile::MeshFile( const DataSourceRef &dataSource )
+{
+	if( dataSource->isFilePath() && ! dynamic_pointer_cast<DataSourceMemoryMapped>( dataSource ) ) {
+		try {
+			mData = DataSourceMemoryMapped::create( dataSource->getFilePath() )->getBuffer();
+		}
+		catch( MemoryMappedFileExc &exc ) {
+			throw MeshFileExc( string( "cimesh: " ) + exc.what() );
+		}
+	}
+	else
+		mData = dataSource->getBuffer();
+
+	const uint64_t size = mData->getSize();
+	if( size < sizeof( mHeader ) )
+		throw MeshFileExc( "cimesh: file is too small" );
+
+	memcpy( &mHeader, mData->getData(), sizeof( mHeader ) );
+	if( memcmp( mHeader.mMagic, sMagic, sizeof( sMagic ) ) != 0 )
+		throw MeshFileExc( "cimesh: not a cimesh file" );
+	if( mHeader.mByteOrderMark != sByteOrderMark )
+		throw MeshFileExc( "cimesh: file was written with a different byte order" );
+	if( mHeader.mVersion != MeshFileHeader::VERSION )
+		throw MeshFileExc( "cimesh: unsupported version" );
+	if( mHeader.mNumIndices % 3 || mHeader.mNumVertices > numeric_limits<uint32_t>::max() || mHeader.mNumAttribs > geom::NUM_ATTRIBS )
+		throw MeshFileExc( "cimesh: invalid header" );
+	if( ( size - sizeof( mHeader ) ) / sizeof( MeshFileAttrib ) < mHeader.mNumAttribs )
+		throw MeshFileExc( "cimesh: file is truncated" );
+
+	auto checkSection = [size]( uint64_t offset, uint64_t bytes, uint64_t expectedBytes ) {
+		if( bytes != expectedBytes || offset % 4 )
+			throw MeshFileExc( "cimesh: invalid data layout" );
+		if( offset > size || size - offset < bytes )
+			throw MeshFileExc( "cimesh: file is truncated" );
+	};
+
+	if( mHeader.mIndexEncoding == MeshFileHeader::INDICES_UINT32 ) {
+		// checked before multiplying, which could overflow
+		if( mHeader.mIndexOffset > size || mHeader.mNumIndices > ( size - mHeader.mIndexOffset ) / sizeof( uint32_t ) )
+			throw MeshFileExc( "cimesh: file is truncated" );
+		checkSection( mHeader.mIndexOffset, mHeader.mIndexBytes, mHeader.mNumIndices * sizeof( uint32_t ) );
+
+		// these are handed to the Target as they are, so they are checked here rather than in loadInto()
+		const uint32_t *indices = getIndexData();
+		for( uint64_t i = 0; i < mHeader.mNumIndices; i++ ) {
+			if( indices[i] >= mHeader.mNumVertices )
+				throw MeshFileExc( "cimesh: index out of range" );
+		}
+	}
+	else if( mHeader.mIndexEncoding == MeshFileHeader::INDICES_DELTA_VARINT ) {
+		// every index takes at least one byte, which bounds what loadInto() allocates by the size of the file
+		if( mHeader.mNumIndices > mHeader.mIndexBytes )
+			throw MeshFileExc( "cimesh: invalid data layout" );
+		checkSection( mHeader.mIndexOffset, mHeader.mIndexBytes, mHeader.mIndexBytes );
+	}
+	else
+		throw MeshFileExc( "cimesh: unknown index encoding" );
+
+	mAttribs.resize( mHeader.mNumAttribs );
+	if( ! mAttribs.empty() )
+		memcpy( mAttribs.data(), getData( sizeof( mHeader ) ), mAttribs.size() * sizeof( MeshFileAttrib ) );
+	for( const auto &attrib : mAttribs ) {
+		if( attrib.mAttrib >= geom::NUM_ATTRIBS || attrib.mDims == 0 || attrib.mDims > 4 || attrib.mEncoding > MeshFileAttrib::OCT_SNORM16
+				|| ( attrib.mEncoding == MeshFileAttrib::OCT_SNORM16 && attrib.mDims != 3 ) )
+			throw MeshFileExc( "cimesh: invalid attribute" );
+		checkSection( attrib.mOffset, attrib.mBytes, encodedBytes( attrib, mHeader.mNumVertices ) );
+	}
+}
+
+const MeshFileAttrib* MeshFile::findAttrib( geom::Attrib attr ) const
+{
+	for( const auto &attrib : mAttribs ) {
+		if( attrib.mAttrib == static_cast<uint32_t>( attr ) )
+			return &attrib;
+	}
+
+	return nullptr;
+}
+
+const float* MeshFile::getAttribData( geom::Attrib attr ) const
+{
+	const MeshFileAttrib *attrib = findAttrib( attr );
+	if( ! attrib || attrib->mEncoding != MeshFileAttrib::FLOAT32 )
+		return nullptr;
+
+	return reinterpret_cast<const float*>( getData( attrib->mOffset ) );
+}
+
+const uint32_t* MeshFile::getIndexData() const
+{
+	if( mHeader.mIndexEncoding != MeshFileHeader::INDICES_UINT32 )
+		return nullptr;
+
+	return reinterpret_cast<const uint32_t*>( getData( mHeader.mIndexOffset ) );
+}
+
+uint8_t MeshFile::getAttribDims( geom::Attrib attr ) const
+{
+	const MeshFileAttrib *attrib = findAttrib( attr );
+	return attrib ? static_cast<uint8_t>( attrib->mDims ) : 0;
+}
+
+geom::AttribSet MeshFile::getAvailableAttribs() const
+{
+	geom::AttribSet result;
+	for( const auto &attrib : mAttribs )
+		result.insert( static_cast<geom::Attrib>( attrib.mAttrib ) );
+
+	return result;
+}
+
+void MeshFile::loadInto( geom::Target *target, const geom::AttribSet &requestedAttribs ) const
+{
+	const size_t numVertices = getNumVertices();
+	vector<float> decoded;
+	for( const auto &attrib : mAttribs ) {
+		const geom::Attrib attr = static_cast<geom::Attrib>( attrib.mAttrib );
+		if( requestedAttribs.count( attr ) == 0 )
+			continue;
+
+		const uint8_t *data = getData( attrib.mOffset );
+		if( attrib.mEncoding == MeshFileAttrib::FLOAT32 ) {
+			target->copyAttrib( attr, static_cast<uint8_t>( attrib.mDims ), 0, reinterpret_cast<const float*>( data ), numVertices );
+			continue;
+		}
+
+		decoded.resize( numVertices * attrib.mDims );
+		if( attrib.mEncoding == MeshFileAttrib::UNORM16 ) {
+			const uint16_t *values = reinterpret_cast<const uint16_t*>( data );
+			for( size_t i = 0; i < numVertices * attrib.mDims; i += attrib.mDims ) {
+				for( uint32_t d = 0; d < attrib.mDims; d++ )
+					decoded[i + d] = attrib.mMin[d] + values[i + d] * attrib.mScale[d];
+			}
+		}
+		else {
+			const int16_t *values = reinterpret_cast<const int16_t*>( data );
+			for( size_t i = 0; i < numVertices; i++ )
+				decodeOctahedral( values + i * 2, &decoded[i * 3] );
+		}
+		target->copyAttrib( attr, static_cast<uint8_t>( attrib.mDims ), 0, decoded.data(), numVertices );
+	}
+
+	if( ! getNumIndices() )
+		return;
+
+	const uint8_t bytesPerIndex = ( numVertices > 65535 ) ? 4 : 2;
+	if( mHeader.mIndexEncoding == MeshFileHeader::INDICES_UINT32 ) {
+		target->copyIndices( geom::Primitive::TRIANGLES, getIndexData(), getNumIndices(), bytesPerIndex );
+		return;
+	}
+
+	vector<uint32_t> indices( getNumIndices() );
+	const uint8_t *data = getData( mHeader.mIndexOffset ), *dataEnd = data + mHeader.mIndexBytes;
+	uint32_t previous = 0;
+	for( auto &index : indices ) {
+		uint32_t value = 0;
+		for( int shift = 0; ; shift += 7 ) {
+			if( data == dataEnd || shift > 28 )
+				throw MeshFileExc( "cimesh: invalid index data" );
+			value |= uint32_t( *data & 0x7f ) << shift;
+			if( ! ( *data++ & 0x80 ) )
+				break;
+		}
+
+		previous += ( value >> 1 ) ^ ( 0 - ( value & 1 ) );
+		if( previous >= numVertices )
+			throw MeshFileExc( "cimesh: index out of range" );
+		index = previous;
+	}
+	target->copyIndices( geom::Primitive::TRIANGLES, indices.data(), indices.size(), bytesPerIndex );
+}
+
+void MeshFile::write( const DataTargetRef &dataTarget, const geom::Source &source, const Options &options )
+{
+	// TriMesh takes care of converting other primitives and indexing non-indexed sources
+	TriMesh mesh( source );
+	MeshFileWriteTarget meshTarget( mesh );
+	mesh.loadInto( &meshTarget, mesh.getAvailableAttribs() );
+
+	MeshFileHeader header;
+	memset( &header, 0, sizeof( header ) );
+	memcpy( header.mMagic, sMagic, sizeof( sMagic ) );
+	header.mByteOrderMark = sByteOrderMark;
+	header.mVersion = MeshFileHeader::VERSION;
+	header.mNumVertices = mesh.getNumVertices();
+	header.mNumIndices = meshTarget.mNumIndices;
+	header.mNumAttribs = static_cast<uint32_t>( meshTarget.mAttribs.size() );
+
+	// encode the indices and any quantized attributes up front, so that the layout of the file is known before writing
+	vector<uint8_t> encodedIndices;
+	if( options.getCompressIndices() ) {
+		header.mIndexEncoding = MeshFileHeader::INDICES_DELTA_VARINT;
+		encodedIndices.reserve( meshTarget.mNumIndices * 2 );
+		uint32_t previous = 0;
+		for( size_t i = 0; i < meshTarget.mNumIndices; i++ ) {
+			const int32_t delta = static_cast<int32_t>( meshTarget.mIndices[i] - previous );
+			appendVarint( ( static_cast<uint32_t>( delta ) << 1 ) ^ static_cast<uint32_t>( delta >> 31 ), &encodedIndices );
+			previous = meshTarget.mIndices[i];
+		}
+		header.mIndexBytes = encodedIndices.size();
+	}
+	else {
+		header.mIndexEncoding = MeshFileHeader::INDICES_UINT32;
+		header.mIndexBytes = meshTarget.mNumIndices * sizeof( uint32_t );
+	}
+	header.mIndexOffset = alignData( sizeof( MeshFileHeader ) + header.mNumAttribs * sizeof( MeshFileAttrib ) );
+
+	vector<MeshFileAttrib> table;
+	vector<vector<uint8_t>> encodedAttribs;
+	uint64_t offset = alignData( header.mIndexOffset + header.mIndexBytes );
+	for( const auto &src : meshTarget.mAttribs ) {
+		MeshFileAttrib attrib;
+		memset( &attrib, 0, sizeof( attrib ) );
+		attrib.mAttrib = src.mAttrib;
+		attrib.mDims = src.mDims;
+		attrib.mEncoding = MeshFileAttrib::FLOAT32;
+		auto element = [&src]( size_t i ) { return reinterpret_cast<const float*>( reinterpret_cast<const uint8_t*>( src.mData ) + i * src.mStrideBytes ); };
+
+		vector<uint8_t> encoded;
+		if( src.mAttrib == geom::POSITION && options.getQuantizePositions() ) {
+			attrib.mEncoding = MeshFileAttrib::UNORM16;
+			for( uint8_t d = 0; d < src.mDims; d++ ) {
+				float minValue = numeric_limits<float>::max(), maxValue = -numeric_limits<float>::max();
+				for( size_t i = 0; i < header.mNumVertices; i++ ) {
+					minValue = std::min( minValue, element( i )[d] );
+					maxValue = std::max( maxValue, element( i )[d] );
+				}
+				attrib.mMin[d] = ( header.mNumVertices > 0 ) ? minValue : 0;
+				attrib.mScale[d] = ( maxValue > minValue ) ? ( maxValue - minValue ) / 65535.0f : 0;
+			}
+
+			encoded.resize( encodedBytes( attrib, header.mNumVertices ) );
+			uint16_t *values = reinterpret_cast<uint16_t*>( encoded.data() );
+			for( size_t i = 0; i < header.mNumVertices; i++ ) {
+				for( uint8_t d = 0; d < src.mDims; d++ ) {
+					const float value = ( attrib.mScale[d] > 0 ) ? ( element( i )[d] - attrib.mMin[d] ) / attrib.mScale[d] : 0;
+					*values++ = static_cast<uint16_t>( glm::clamp( std::round( value ), 0.0f, 65535.0f ) );
+				}
+			}
+		}
+		else if( isDirection( src.mAttrib ) && src.mDims == 3 && options.getQuantizeNormals() ) {
+			attrib.mEncoding = MeshFileAttrib::OCT_SNORM16;
+			encoded.resize( encodedBytes( attrib, header.mNumVertices ) );
+			int16_t *values = reinterpret_cast<int16_t*>( encoded.data() );
+			for( size_t i = 0; i < header.mNumVertices; i++ )
+				encodeOctahedral( element( i ), values + i * 2 );
+		}
+
+		attrib.mOffset = offset;
+		attrib.mBytes = encodedBytes( attrib, header.mNumVertices );
+		offset = alignData( offset + attrib.mBytes );
+		table.push_back( attrib );
+		encodedAttribs.push_back( std::move( encoded ) );
+	}
+
+	OStreamRef out = dataTarget->getStream();
+	uint64_t written = 0;
+	auto writeAt = [&]( uint64_t position, const void *data, uint64_t bytes ) {
+		static const uint8_t padding[MeshFileHeader::DATA_ALIGNMENT] = {};
+		if( position > written )
+			out->writeData( padding, static_cast<size_t>( position - written ) );
+		if( bytes )
+			out->writeData( data, static_cast<size_t>( bytes ) );
+		written = position + bytes;
+	};
+
+	writeAt( 0, &header, sizeof( header ) );
+	writeAt( written, table.data(), table.size() * sizeof( MeshFileAttrib ) );
+	writeAt( header.mIndexOffset, options.getCompressIndices() ? encodedIndices.data() : static_cast<const void*>( meshTarget.mIndices ), header.mIndexBytes );
+	for( size_t a = 0; a < table.size(); a++ ) {
+		const auto &src = meshTarget.mAttribs[a];
+		if( table[a].mEncoding != MeshFileAttrib::FLOAT32 )
+			writeAt( table[a].mOffset, encodedAttribs[a].data(), table[a].mBytes );
+		else if( src.mStrideBytes == src.mDims * sizeof( float ) )
+			writeAt( table[a].mOffset, src.mData, table[a].mBytes );
+		else {
+			writeAt( table[a].mOffset, nullptr, 0 );
+			for( size_t i = 0; i < header.mNumVertices; i++ )
+				out->writeData( reinterpret_cast<const uint8_t*>( src.mData ) + i * src.mStrideBytes, src.mDims * sizeof( float ) );
+			written += table[a].mBytes;
+		}
+	}
+}
+
+} // namespace cinder
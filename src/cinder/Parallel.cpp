@@ -0,0 +1,180 @@
+/*
+ Copyright (c) 2026, The Cinder Project
+
+ This code is intended to be used with the Cinder C++ library, http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#include "cinder/Parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace cinder {
+
+namespace {
+
+// set while a thread runs a task, so that nested calls don't wait on the pool they are running on
+thread_local bool sInsideTask = false;
+
+// Worker threads are started on demand and live for the rest of the process. The calling thread runs tasks too, so a job
+// with N threads needs N - 1 workers.
+class ThreadPool {
+  public:
+	static ThreadPool* get()
+	{
+		// intentionally leaked so that workers never outlive the pool during static destruction
+		static ThreadPool *sInstance = new ThreadPool;
+		return sInstance;
+	}
+
+	void run( size_t numThreads, int32_t numTasks, const function<void( int32_t )> &task )
+	{
+		auto job = make_shared<Job>( task, numTasks );
+		{
+			lock_guard<mutex> lock( mMutex );
+			while( mWorkers.size() < numThreads - 1 )
+				mWorkers.emplace_back( &ThreadPool::workerLoop, this );
+
+			job->mNumHelpersWanted = numThreads - 1;
+			mJobs.push_back( job );
+		}
+		mWorkAvailable.notify_all();
+
+		job->process();
+
+		{
+			unique_lock<mutex> lock( job->mMutex );
+			job->mDoneCond.wait( lock, [&] { return job->mNumDone == job->mNumTasks; } );
+		}
+		{
+			// remove the job if not enough workers showed up to take it off the queue
+			lock_guard<mutex> lock( mMutex );
+			auto it = find( mJobs.begin(), mJobs.end(), job );
+			if( it != mJobs.end() )
+				mJobs.erase( it );
+		}
+
+		if( job->mException )
+			rethrow_exception( job->mException );
+	}
+
+  private:
+	struct Job {
+		Job( const function<void( int32_t )> &task, int32_t numTasks )
+			: mTask( task ), mNumTasks( numTasks ), mNextTask( 0 ), mNumDone( 0 ), mNumHelpersWanted( 0 )
+		{}
+
+		// runs tasks until none are left to claim
+		void process()
+		{
+			sInsideTask = true;
+			for( int32_t t = mNextTask++; t < mNumTasks; t = mNextTask++ ) {
+				try {
+					mTask( t );
+				}
+				catch( ... ) {
+					lock_guard<mutex> lock( mMutex );
+					if( ! mException )
+						mException = current_exception();
+				}
+
+				lock_guard<mutex> lock( mMutex );
+				if( ++mNumDone == mNumTasks )
+					mDoneCond.notify_all();
+			}
+			sInsideTask = false;
+		}
+
+		const function<void( int32_t )>	&mTask;
+		const int32_t					mNumTasks;
+		atomic<int32_t>					mNextTask;
+		int32_t							mNumDone;
+		size_t							mNumHelpersWanted; // guarded by the pool's mutex
+		exception_ptr					mException;
+		mutex							mMutex;
+		condition_variable				mDoneCond;
+	};
+
+	void workerLoop()
+	{
+		while( true ) {
+			shared_ptr<Job> job;
+			{
+				unique_lock<mutex> lock( mMutex );
+				mWorkAvailable.wait( lock, [this] { return ! mJobs.empty(); } );
+				job = mJobs.front();
+				if( --job->mNumHelpersWanted == 0 )
+					mJobs.pop_front();
+			}
+
+			job->process();
+		}
+	}
+
+	mutex						mMutex;
+	condition_variable			mWorkAvailable;
+	deque<shared_ptr<Job>>		mJobs;
+	vector<thread>				mWorkers;
+};
+
+} // anonymous namespace
+
+size_t getNumParallelThreads( size_t maxThreads )
+{
+	if( maxThreads )
+		return maxThreads;
+
+	return std::max<size_t>( thread::hardware_concurrency(), 1 );
+}
+
+void parallelFor( int32_t begin, int32_t end, int32_t minItemsPerTask, size_t maxThreads, const function<void( int32_t, int32_t )> &fn )
+{
+	const int32_t numItems = end - begin;
+	if( numItems <= 0 )
+		return;
+
+	const size_t numThreads = sInsideTask ? 1 : getNumParallelThreads( maxThreads );
+	const int32_t maxTasks = numItems / std::max<int32_t>( minItemsPerTask, 1 );
+	if( numThreads <= 1 || maxTasks < 2 ) {
+		fn( begin, end );
+		return;
+	}
+
+	// a few tasks per thread balance out uneven progress between threads
+	const int32_t targetTasks = std::min<int32_t>( maxTasks, int32_t( numThreads * 4 ) );
+	const int32_t itemsPerTask = ( numItems + targetTasks - 1 ) / targetTasks;
+	const int32_t numTasks = ( numItems + itemsPerTask - 1 ) / itemsPerTask;
+
+	ThreadPool::get()->run( std::min<size_t>( numThreads, numTasks ), numTasks, [&]( int32_t task ) {
+		const int32_t taskBegin = begin + task * itemsPerTask;
+		fn( taskBegin, std::min( taskBegin + itemsPerTask, end ) );
+	} );
+}
+
+} // namespace cinder
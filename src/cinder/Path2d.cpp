@@ -31,12 +31,14 @@
 #include "cinder/CinderMath.h"
 #include "cinder/Path2d.h"
 #include "cinder/Shape2d.h"
+#include "cinder/ip/Execution.h"
 
 #include <algorithm>
 #include <map>
 #include <set>
 #include <cfloat>
 #include <iterator>
+#include <limits>
 
 using std::vector;
 
@@ -2255,6 +2257,370 @@ float Path2dCalcCache::calcTimeForDistance( float distance, bool wrap, float tol
 	return mPath.segmentSolveTimeForDistance( currentSegment, currentSegmentLength, distance, tolerance, maxIterations );
 }
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Path2dQueryCache
+namespace {
+
+const uint32_t MAX_SEGMENTS_PER_LEAF = 4;
+const int MAX_BANDS = 4096;
+
+float calcBoxDistanceSquared( const vec2 &pt, const vec2 &boxMin, const vec2 &boxMax )
+{
+	vec2 d = glm::max( glm::max( boxMin - pt, pt - boxMax ), vec2( 0 ) );
+	return glm::dot( d, d );
+}
+
+} // anonymous namespace
+
+Path2dQueryCache::Path2dQueryCache( const Path2d &path )
+	: mBounds( 0, 0, 0, 0 )
+{
+	addContour( path );
+	build();
+}
+
+Path2dQueryCache::Path2dQueryCache( const Shape2d &shape )
+	: mBounds( 0, 0, 0, 0 )
+{
+	for( const auto &contour : shape.getContours() )
+		addContour( contour );
+	build();
+}
+
+void Path2dQueryCache::addContour( const Path2d &path )
+{
+	if( path.getPoints().empty() )
+		return;
+	const bool isFirstContour = mPieces.empty();
+
+	// the same pieces that Path2d::calcWinding() splits the curves into, so that the winding numbers come out identical
+	auto addPiece = [this]( Path2d::SegmentType type, const vec2 *points ) {
+		MonotonePiece piece;
+		piece.mType = type;
+		const int numPoints = Path2d::sSegmentTypePointCounts[type] + 1;
+		std::copy( points, points + numPoints, piece.mPoints );
+		piece.mMinY = std::min( points[0].y, points[numPoints - 1].y );
+		piece.mMaxY = std::max( points[0].y, points[numPoints - 1].y );
+		mPieces.push_back( piece );
+	};
+
+	auto addSegment = [this]( Path2d::SegmentType type, const vec2 *points, int numPoints ) {
+		Segment segment;
+		segment.mType = type;
+		segment.mOrder = static_cast<uint32_t>( mSegments.size() );
+		std::copy( points, points + numPoints, segment.mPoints );
+		segment.mMin = segment.mMax = points[0];
+		for( int p = 1; p < numPoints; ++p ) {
+			segment.mMin = glm::min( segment.mMin, points[p] );
+			segment.mMax = glm::max( segment.mMax, points[p] );
+		}
+		mSegments.push_back( segment );
+	};
+
+	const vec2 *points = path.getPoints().data();
+	size_t firstPoint = 0;
+	for( auto type : path.getSegments() ) {
+		vec2 dst[10];
+		switch( type ) {
+			case Path2d::LINETO:
+				addPiece( Path2d::LINETO, &points[firstPoint] );
+				addSegment( Path2d::LINETO, &points[firstPoint], 2 );
+				break;
+			case Path2d::QUADTO:
+				if( ! isMonoQuad( points[firstPoint].y, points[firstPoint + 1].y, points[firstPoint + 2].y ) ) {
+					const int n = chopQuadAtYExtrema( &points[firstPoint], dst );
+					addPiece( Path2d::QUADTO, &dst[0] );
+					if( n > 0 )
+						addPiece( Path2d::QUADTO, &dst[2] );
+				}
+				else
+					addPiece( Path2d::QUADTO, &points[firstPoint] );
+				addSegment( Path2d::QUADTO, &points[firstPoint], 3 );
+				break;
+			case Path2d::CUBICTO: {
+				int n = chopCubicAtYExtrema( &points[firstPoint], dst );
+				for( int i = 0; i <= n; ++i )
+					addPiece( Path2d::CUBICTO, &dst[i * 3] );
+				addSegment( Path2d::CUBICTO, &points[firstPoint], 4 );
+			}
+			break;
+			case Path2d::CLOSE: {
+				const vec2 closing[2] = { points[firstPoint], points[0] };
+				addSegment( Path2d::LINETO, closing, 2 );
+			}
+			break;
+			default:
+				throw Path2dExc();
+		}
+
+		firstPoint += Path2d::sSegmentTypePointCounts[type];
+	}
+
+	// calcWinding() always treats the path as closed
+	const vec2 closing[2] = { points[path.getPoints().size() - 1], points[0] };
+	addPiece( Path2d::LINETO, closing );
+
+	if( isFirstContour )
+		mBounds = path.calcBoundingBox();
+	else
+		mBounds.include( path.calcBoundingBox() );
+}
+
+void Path2dQueryCache::build()
+{
+	// sort the pieces into bands, with fewer bands if tall pieces would be repeated in too many of them
+	mMinY = mMaxY = mInvBandHeight = 0;
+	mNumBands = 1;
+	if( ! mPieces.empty() ) {
+		mMinY = mPieces[0].mMinY;
+		mMaxY = mPieces[0].mMaxY;
+		for( const auto &piece : mPieces ) {
+			mMinY = std::min( mMinY, piece.mMinY );
+			mMaxY = std::max( mMaxY, piece.mMaxY );
+		}
+		mNumBands = static_cast<int>( std::min<size_t>( mPieces.size(), MAX_BANDS ) );
+	}
+
+	while( true ) {
+		mInvBandHeight = ( mMaxY > mMinY ) ? mNumBands / ( mMaxY - mMinY ) : 0;
+		size_t numEntries = 0;
+		for( const auto &piece : mPieces )
+			numEntries += getBand( piece.mMaxY ) - getBand( piece.mMinY ) + 1;
+		if( mNumBands == 1 || numEntries <= mPieces.size() * 16 )
+			break;
+		mNumBands /= 2;
+	}
+
+	mBandOffsets.assign( mNumBands + 1, 0 );
+	for( const auto &piece : mPieces ) {
+		for( int band = getBand( piece.mMinY ); band <= getBand( piece.mMaxY ); ++band )
+			mBandOffsets[band + 1]++;
+	}
+	for( int band = 0; band < mNumBands; ++band )
+		mBandOffsets[band + 1] += mBandOffsets[band];
+
+	mBandPieces.resize( mBandOffsets.back() );
+	vector<uint32_t> next( mBandOffsets.begin(), mBandOffsets.end() - 1 );
+	for( uint32_t p = 0; p < mPieces.size(); ++p ) {
+		for( int band = getBand( mPieces[p].mMinY ); band <= getBand( mPieces[p].mMaxY ); ++band )
+			mBandPieces[next[band]++] = p;
+	}
+
+	mNodes.clear();
+	if( ! mSegments.empty() )
+		buildNode( 0, static_cast<uint32_t>( mSegments.size() ) );
+}
+
+uint32_t Path2dQueryCache::buildNode( uint32_t first, uint32_t last )
+{
+	const uint32_t nodeIndex = static_cast<uint32_t>( mNodes.size() );
+	mNodes.push_back( Node() );
+
+	vec2 boundsMin = mSegments[first].mMin, boundsMax = mSegments[first].mMax;
+	vec2 centerMin( FLT_MAX ), centerMax( -FLT_MAX );
+	for( uint32_t s = first; s < last; ++s ) {
+		boundsMin = glm::min( boundsMin, mSegments[s].mMin );
+		boundsMax = glm::max( boundsMax, mSegments[s].mMax );
+		const vec2 center = ( mSegments[s].mMin + mSegments[s].mMax ) * 0.5f;
+		centerMin = glm::min( centerMin, center );
+		centerMax = glm::max( centerMax, center );
+	}
+	mNodes[nodeIndex].mMin = boundsMin;
+	mNodes[nodeIndex].mMax = boundsMax;
+
+	if( last - first <= MAX_SEGMENTS_PER_LEAF ) {
+		mNodes[nodeIndex].mFirst = first;
+		mNodes[nodeIndex].mCount = last - first;
+		return nodeIndex;
+	}
+
+	// split at the median along the longer axis of the segment centers
+	const int axis = ( centerMax.x - centerMin.x >= centerMax.y - centerMin.y ) ? 0 : 1;
+	const uint32_t middle = first + ( last - first ) / 2;
+	std::nth_element( mSegments.begin() + first, mSegments.begin() + middle, mSegments.begin() + last, [axis]( const Segment &a, const Segment &b ) {
+		return a.mMin[axis] + a.mMax[axis] < b.mMin[axis] + b.mMax[axis];
+	} );
+
+	buildNode( first, middle );
+	const uint32_t right = buildNode( middle, last );
+	mNodes[nodeIndex].mFirst = right;
+	mNodes[nodeIndex].mCount = 0;
+	return nodeIndex;
+}
+
+int Path2dQueryCache::getBand( float y ) const
+{
+	return std::min( static_cast<int>( ( y - mMinY ) * mInvBandHeight ), mNumBands - 1 );
+}
+
+bool Path2dQueryCache::contains( const vec2 &pt, bool evenOddFill ) const
+{
+	if( ! ( pt.y >= mMinY && pt.y <= mMaxY ) || mPieces.empty() )
+		return false;
+
+	// pieces outside of the band can't contribute to the winding number, since they don't span pt.y
+	int w = 0;
+	int onCurveCount = 0;
+	const int band = getBand( pt.y );
+	for( uint32_t i = mBandOffsets[band]; i < mBandOffsets[band + 1]; ++i ) {
+		const MonotonePiece &piece = mPieces[mBandPieces[i]];
+		if( pt.y < piece.mMinY || pt.y > piece.mMaxY )
+			continue;
+
+		switch( piece.mType ) {
+			case Path2d::LINETO:
+				w += windingLine( piece.mPoints, pt, &onCurveCount );
+				break;
+			case Path2d::QUADTO:
+				w += windingMonoQuad( piece.mPoints, pt, &onCurveCount );
+				break;
+			default:
+				w += windingMonoCubic( piece.mPoints, pt, &onCurveCount );
+				break;
+		}
+	}
+
+	if( evenOddFill )
+		w &= 1;
+	if( w )
+		return true;
+
+	if( onCurveCount <= 1 )
+		return onCurveCount > 0;
+	if( ( onCurveCount & 1 ) || evenOddFill )
+		return ( onCurveCount & 1 ) > 0;
+
+	return false;
+}
+
+void Path2dQueryCache::containsMany( const vec2 *points, size_t numPoints, bool *results, bool evenOddFill ) const
+{
+	ip::parallelFor( 0, static_cast<int32_t>( numPoints ), 4096, [&]( int32_t taskBegin, int32_t taskEnd ) {
+		for( int32_t i = taskBegin; i < taskEnd; ++i )
+			results[i] = contains( points[i], evenOddFill );
+	} );
+}
+
+bool Path2dQueryCache::findClosest( const vec2 &pt, float maxDistanceSquared, vec2 *result, float *resultDistanceSquared ) const
+{
+	if( mNodes.empty() )
+		return false;
+
+	// ties are resolved in favor of the earliest segment, as Shape2d::calcClosestPoint() does
+	float bestDistanceSquared = maxDistanceSquared;
+	uint32_t bestOrder = std::numeric_limits<uint32_t>::max();
+
+	uint32_t stack[64];
+	int stackSize = 0;
+	stack[stackSize++] = 0;
+	while( stackSize > 0 ) {
+		const Node &node = mNodes[stack[--stackSize]];
+		if( calcBoxDistanceSquared( pt, node.mMin, node.mMax ) > bestDistanceSquared )
+			continue;
+
+		if( node.mCount ) {
+			for( uint32_t s = node.mFirst; s < node.mFirst + node.mCount; ++s ) {
+				const Segment &segment = mSegments[s];
+				if( calcBoxDistanceSquared( pt, segment.mMin, segment.mMax ) > bestDistanceSquared )
+					continue;
+
+				vec2 p;
+				if( segment.mType == Path2d::CUBICTO )
+					p = getClosestPointCubic( segment.mPoints, pt );
+				else if( segment.mType == Path2d::QUADTO )
+					p = getClosestPointQuadratic( segment.mPoints, pt );
+				else
+					p = getClosestPointLinear( segment.mPoints, pt );
+
+				const float d = glm::distance2( pt, p );
+				if( d < bestDistanceSquared || ( d == bestDistanceSquared && segment.mOrder < bestOrder ) ) {
+					*result = p;
+					bestDistanceSquared = d;
+					bestOrder = segment.mOrder;
+				}
+			}
+		}
+		else {
+			// visit the nearer child first
+			uint32_t nearChild = static_cast<uint32_t>( &node - mNodes.data() ) + 1, farChild = node.mFirst;
+			float nearDistance = calcBoxDistanceSquared( pt, mNodes[nearChild].mMin, mNodes[nearChild].mMax );
+			float farDistance = calcBoxDistanceSquared( pt, mNodes[farChild].mMin, mNodes[farChild].mMax );
+			if( farDistance < nearDistance ) {
+				std::swap( nearChild, farChild );
+				std::swap( nearDistance, farDistance );
+			}
+			if( farDistance <= bestDistanceSquared )
+				stack[stackSize++] = farChild;
+			if( nearDistance <= bestDistanceSquared )
+				stack[stackSize++] = nearChild;
+		}
+	}
+
+	*resultDistanceSquared = bestDistanceSquared;
+	return bestOrder != std::numeric_limits<uint32_t>::max();
+}
+
+float Path2dQueryCache::calcDistance( const vec2 &pt ) const
+{
+	vec2 closest;
+	float distanceSquared;
+	if( ! findClosest( pt, FLT_MAX, &closest, &distanceSquared ) )
+		return FLT_MAX;
+
+	return glm::distance( pt, closest );
+}
+
+float Path2dQueryCache::calcSignedDistance( const vec2 &pt, bool evenOddFill ) const
+{
+	if( contains( pt, evenOddFill ) )
+		return -calcDistance( pt );
+	else
+		return calcDistance( pt );
+}
+
+vec2 Path2dQueryCache::calcClosestPoint( const vec2 &pt ) const
+{
+	vec2 result;
+	float distanceSquared;
+	findClosest( pt, FLT_MAX, &result, &distanceSquared );
+	return result;
+}
+
+void Path2dQueryCache::calcSignedDistanceField( Channel32f *result, const Rectf &bounds, float maxDistance, bool evenOddFill ) const
+{
+	const int32_t width = result->getWidth(), height = result->getHeight();
+	const vec2 pixelSize( bounds.getWidth() / width, bounds.getHeight() / height );
+	const float maxDistanceSquared = ( maxDistance < FLT_MAX ) ? maxDistance * maxDistance : FLT_MAX;
+
+	ip::parallelFor( 0, height, 8, [&]( int32_t taskBegin, int32_t taskEnd ) {
+		for( int32_t y = taskBegin; y < taskEnd; ++y ) {
+			float *dst = result->getData( ivec2( 0, y ) );
+			const uint8_t inc = result->getIncrement();
+			float previousDistance = FLT_MAX;
+			for( int32_t x = 0; x < width; ++x, dst += inc ) {
+				const vec2 pt( bounds.x1 + ( x + 0.5f ) * pixelSize.x, bounds.y1 + ( y + 0.5f ) * pixelSize.y );
+
+				// the distance changes by no more than the distance between neighboring pixels, which bounds the search
+				float searchDistanceSquared = maxDistanceSquared;
+				if( previousDistance < maxDistance ) {
+					const float bound = ( previousDistance + std::abs( pixelSize.x ) ) * 1.0001f;
+					searchDistanceSquared = std::min( searchDistanceSquared, bound * bound );
+				}
+
+				vec2 closest;
+				float distanceSquared;
+				float distance = maxDistance;
+				if( findClosest( pt, searchDistanceSquared, &closest, &distanceSquared )
+						|| ( searchDistanceSquared < maxDistanceSquared && findClosest( pt, maxDistanceSquared, &closest, &distanceSquared ) ) )
+					distance = std::min( glm::distance( pt, closest ), maxDistance );
+
+				previousDistance = distance;
+				*dst = contains( pt, evenOddFill ) ? -distance : distance;
+			}
+		}
+	} );
+}
+
 std::vector<Path2d::SelfIntersection> Path2d::findSelfIntersections( float tolerance ) const
 {
 	std::vector<SelfIntersection> results;
@@ -2866,7 +3232,12 @@ std::vector<Path2d::Intersection> Path2d::findIntersections( const Shape2d& shap
 {
 	std::vector<Intersection> results;
 
+	// contours whose control points don't overlap ours can't intersect
+	const Rectf bounds = calcBoundingBox().inflated( vec2( tolerance ) );
 	for( size_t i = 0; i < shape.getNumContours(); ++i ) {
+		if( ! bounds.intersects( shape.getContour( i ).calcBoundingBox() ) )
+			continue;
+
 		auto contourIsects = findIntersections( shape.getContour( i ), tolerance );
 		// Set the contour index for each intersection
 		for( auto& ix : contourIsects ) {
@@ -30,6 +30,7 @@
 #include "cinder/Shape2d.h"
 #include "cinder/CinderMath.h"
 #include "cinder/CinderGlm.h"
+#include "cinder/ip/Execution.h"
 #include <cmath>
 #include <algorithm>
 #include <array>
@@ -2430,4 +2431,441 @@ Shape2d Shape2d::calcDashed( float dashOffset, const std::vector<float>& pattern
 	return result;
 }
 
+//=============================================================================
+// StrokeMesh2d - Direct Stroke Triangulation
+//
+// Rather than offsetting curves into an outline which then has to be tessellated, contours are flattened into polylines and each
+// segment is emitted as a quad between its offset points. Joins and caps are triangle fans around their center point. Samples
+// along a curve turn little enough to share a pair of mitered vertices between neighboring quads, and the flattening also limits
+// that turn so the outer edge stays within tolerance of the exact offset curve.
+//=============================================================================
+
+namespace {
+
+// Curve samples whose segments turn by more than this (the cosine of 60 degrees) get a round join instead of shared vertices
+constexpr double SMOOTH_JOIN_MIN_COS = 0.5;
+// The most segments a single curve is flattened into
+constexpr int MAX_CURVE_SEGMENTS = 1024;
+
+// Returns the largest angle an arc of \a radius can span while its chord stays within \a tolerance, limited to 90 degrees
+template<typename T>
+T calcMaxArcAngle( T radius, T tolerance )
+{
+	if( tolerance >= radius )
+		return T( PI / 2 );
+	return std::min( T( 2 ) * std::acos( T( 1 ) - tolerance / radius ), T( PI / 2 ) );
+}
+
+template<typename T>
+T calcTurn( const glm::tvec2<T> &a, const glm::tvec2<T> &b )
+{
+	if( a == glm::tvec2<T>( 0 ) || b == glm::tvec2<T>( 0 ) )
+		return 0;
+	return std::abs( std::atan2( cross2d( a, b ), glm::dot( a, b ) ) );
+}
+
+// Returns the number of segments which keep both a flattened curve and its offset by up to \a halfWidth within \a tolerance. The
+// first bound is Wang's formula, the second limits the turn per segment using the control polygon, whose total turn is at least the curve's.
+template<typename T>
+int calcNumCurveSegments( const glm::tvec2<T> *p, int degree, T tolerance, T maxTurn )
+{
+	T secondDiff, turn;
+	if( degree == 2 ) {
+		secondDiff = glm::length( p[0] - T( 2 ) * p[1] + p[2] ) * T( 0.25 );
+		turn = calcTurn( p[1] - p[0], p[2] - p[1] );
+	}
+	else {
+		secondDiff = std::max( glm::length( p[0] - T( 2 ) * p[1] + p[2] ), glm::length( p[1] - T( 2 ) * p[2] + p[3] ) ) * T( 0.75 );
+		turn = calcTurn( p[1] - p[0], p[2] - p[1] ) + calcTurn( p[2] - p[1], p[3] - p[2] );
+		if( p[1] == p[2] )
+			turn = calcTurn( p[1] - p[0], p[3] - p[2] );
+	}
+
+	const T result = std::max( std::ceil( std::sqrt( secondDiff / tolerance ) ), std::ceil( turn / maxTurn ) );
+	if( ! ( result >= 1 ) )
+		return 1;
+	return static_cast<int>( std::min<T>( result, T( MAX_CURVE_SEGMENTS ) ) );
+}
+
+template<typename T>
+void addPolylinePoint( std::vector<glm::tvec2<T>> *points, std::vector<uint8_t> *corners, const glm::tvec2<T> &p, bool corner )
+{
+	if( ! points->empty() && points->back() == p ) {
+		corners->back() |= corner ? 1 : 0;
+		return;
+	}
+	points->push_back( p );
+	corners->push_back( corner ? 1 : 0 );
+}
+
+//! Flattens \a path into \a points, clearing them first. \return whether the path is closed.
+template<typename T>
+bool flattenContour( const Path2d &path, T tolerance, T maxTurn, std::vector<glm::tvec2<T>> *points, std::vector<uint8_t> *corners )
+{
+	points->clear();
+	corners->clear();
+
+	const auto &pathPoints = path.getPoints();
+	if( pathPoints.empty() )
+		return false;
+
+	addPolylinePoint( points, corners, glm::tvec2<T>( pathPoints[0] ), true );
+	bool closed = false;
+	size_t pt = 1;
+	for( auto type : path.getSegments() ) {
+		switch( type ) {
+			case Path2d::LINETO:
+				addPolylinePoint( points, corners, glm::tvec2<T>( pathPoints[pt] ), true );
+				break;
+			case Path2d::QUADTO:
+			case Path2d::CUBICTO: {
+				const int degree = ( type == Path2d::QUADTO ) ? 2 : 3;
+				glm::tvec2<T> p[4];
+				for( int i = 0; i <= degree; ++i )
+					p[i] = glm::tvec2<T>( pathPoints[pt - 1 + i] );
+				const int numSegments = calcNumCurveSegments( p, degree, tolerance, maxTurn );
+				for( int i = 1; i < numSegments; ++i ) {
+					const T t = T( i ) / numSegments;
+					addPolylinePoint( points, corners, ( degree == 2 ) ? evalQuadraticBezier( p, t ) : evalCubicBezier( p, t ), false );
+				}
+				addPolylinePoint( points, corners, p[degree], true );
+				break;
+			}
+			case Path2d::CLOSE:
+				closed = true;
+				break;
+			default:
+				break;
+		}
+		pt += Path2d::sSegmentTypePointCounts[type];
+	}
+
+	if( closed && points->size() > 1 && points->back() == points->front() ) {
+		points->pop_back();
+		corners->pop_back();
+	}
+
+	return closed;
+}
+
+//! Emits the triangles for stroking polylines into a vertex and index buffer. Triangles wind counter-clockwise in a y-up coordinate system.
+template<typename T>
+class StrokeTriangulator {
+  public:
+	typedef glm::tvec2<T> Vec;
+
+	StrokeTriangulator( const StrokeStyle &style, T tolerance, std::vector<vec2> *positions, std::vector<uint32_t> *indices )
+		: mStyle( style ), mHalfWidth( T( 0.5 ) * std::abs( style.getWidth() ) ), mPositions( positions ), mIndices( indices )
+	{
+		mMaxFanAngle = calcMaxArcAngle( mHalfWidth, tolerance );
+		// like StrokeContext, corners which turn by less than the tolerance allows are not joined
+		mJoinThresh = tolerance / mHalfWidth;
+		mMiterLimit2 = T( style.getMiterLimit() ) * T( style.getMiterLimit() );
+	}
+
+	T		getMaxFanAngle() const { return mMaxFanAngle; }
+
+	void	strokePolyline( const Vec *points, const uint8_t *corners, size_t numPoints, bool closed );
+
+  private:
+	struct Pair {
+		uint32_t	mLeft, mRight;
+	};
+
+	uint32_t	addVertex( const Vec &p );
+	void		addTriangle( uint32_t a, uint32_t b, uint32_t c, bool counterClockwise );
+	void		addQuad( const Pair &a, const Pair &b );
+	//! Adds a fan around \a center from \a first to \a last, which are \a radius away from \a center and \a angle apart.
+	void		addFan( uint32_t centerIndex, const Vec &center, const Vec &radius, T angle, uint32_t first, uint32_t last );
+	Pair		addCap( const Vec &p, const Vec &dir, Cap cap, bool start );
+	//! Joins the segment in direction \a dir0 ending at \a p to the one in direction \a dir1 starting there. \a in ends the first segment, \a out starts the second.
+	void		addJoin( const Vec &p, const Vec &dir0, const Vec &dir1, bool corner, Pair *in, Pair *out );
+
+	const StrokeStyle		&mStyle;
+	T						mHalfWidth, mMaxFanAngle, mJoinThresh, mMiterLimit2;
+	std::vector<vec2>		*mPositions;
+	std::vector<uint32_t>	*mIndices;
+};
+
+template<typename T>
+uint32_t StrokeTriangulator<T>::addVertex( const Vec &p )
+{
+	mPositions->push_back( vec2( p ) );
+	return static_cast<uint32_t>( mPositions->size() - 1 );
+}
+
+template<typename T>
+void StrokeTriangulator<T>::addTriangle( uint32_t a, uint32_t b, uint32_t c, bool counterClockwise )
+{
+	mIndices->push_back( a );
+	mIndices->push_back( counterClockwise ? b : c );
+	mIndices->push_back( counterClockwise ? c : b );
+}
+
+template<typename T>
+void StrokeTriangulator<T>::addQuad( const Pair &a, const Pair &b )
+{
+	addTriangle( a.mLeft, a.mRight, b.mLeft, true );
+	addTriangle( b.mLeft, a.mRight, b.mRight, true );
+}
+
+template<typename T>
+void StrokeTriangulator<T>::addFan( uint32_t centerIndex, const Vec &center, const Vec &radius, T angle, uint32_t first, uint32_t last )
+{
+	const int numSegments = std::max( 1, static_cast<int>( std::ceil( std::abs( angle ) / mMaxFanAngle ) ) );
+	const T cosStep = std::cos( angle / numSegments ), sinStep = std::sin( angle / numSegments );
+
+	Vec r = radius;
+	uint32_t previous = first;
+	for( int i = 1; i < numSegments; ++i ) {
+		r = Vec( r.x * cosStep - r.y * sinStep, r.x * sinStep + r.y * cosStep );
+		const uint32_t next = addVertex( center + r );
+		addTriangle( centerIndex, previous, next, angle >= 0 );
+		previous = next;
+	}
+	addTriangle( centerIndex, previous, last, angle >= 0 );
+}
+
+template<typename T>
+typename StrokeTriangulator<T>::Pair StrokeTriangulator<T>::addCap( const Vec &p, const Vec &dir, Cap cap, bool start )
+{
+	const Vec norm = Vec( -dir.y, dir.x ) * mHalfWidth;
+	const Vec base = ( cap == Cap::Square ) ? p + dir * ( start ? -mHalfWidth : mHalfWidth ) : p;
+
+	Pair result = { addVertex( base + norm ), addVertex( base - norm ) };
+	if( cap == Cap::Round ) {
+		const uint32_t center = addVertex( p );
+		if( start )
+			addFan( center, p, norm, T( PI ), result.mLeft, result.mRight );
+		else
+			addFan( center, p, -norm, T( PI ), result.mRight, result.mLeft );
+	}
+
+	return result;
+}
+
+template<typename T>
+void StrokeTriangulator<T>::addJoin( const Vec &p, const Vec &dir0, const Vec &dir1, bool corner, Pair *in, Pair *out )
+{
+	const Vec norm0( -dir0.y, dir0.x ), norm1( -dir1.y, dir1.x );
+	const T crossVal = cross2d( dir0, dir1 ), dotVal = glm::dot( dir0, dir1 );
+
+	const bool smooth = corner ? ( dotVal > 0 && std::abs( crossVal ) < mJoinThresh ) : ( dotVal > T( SMOOTH_JOIN_MIN_COS ) );
+	if( smooth ) {
+		const Vec miter = ( norm0 + norm1 ) * ( mHalfWidth / ( 1 + dotVal ) );
+		in->mLeft = out->mLeft = addVertex( p + miter );
+		in->mRight = out->mRight = addVertex( p - miter );
+		return;
+	}
+
+	*in = { addVertex( p + norm0 * mHalfWidth ), addVertex( p - norm0 * mHalfWidth ) };
+	*out = { addVertex( p + norm1 * mHalfWidth ), addVertex( p - norm1 * mHalfWidth ) };
+	const uint32_t center = addVertex( p );
+
+	// the join fills the wedge between the segments on the outside of the turn, the segments overlap on the inside
+	const T angle = std::atan2( crossVal, dotVal );
+	const bool leftTurn = angle >= 0;
+	const uint32_t first = leftTurn ? in->mRight : in->mLeft;
+	const uint32_t last = leftTurn ? out->mRight : out->mLeft;
+	const T side = leftTurn ? T( -1 ) : T( 1 );
+
+	switch( corner ? mStyle.getJoin() : Join::Round ) {
+		case Join::Round:
+			addFan( center, p, norm0 * ( side * mHalfWidth ), angle, first, last );
+			break;
+		case Join::Miter:
+			if( 2 < ( 1 + dotVal ) * mMiterLimit2 ) {
+				const uint32_t miter = addVertex( p + ( norm0 + norm1 ) * ( side * mHalfWidth / ( 1 + dotVal ) ) );
+				addTriangle( center, first, miter, leftTurn );
+				addTriangle( center, miter, last, leftTurn );
+			}
+			else
+				addTriangle( center, first, last, leftTurn );
+			break;
+		case Join::Bevel:
+			addTriangle( center, first, last, leftTurn );
+			break;
+	}
+}
+
+template<typename T>
+void StrokeTriangulator<T>::strokePolyline( const Vec *points, const uint8_t *corners, size_t numPoints, bool closed )
+{
+	if( numPoints < 2 || ! ( mHalfWidth > 0 ) )
+		return;
+
+	auto direction = [&]( size_t i ) { return glm::normalize( points[( i + 1 ) % numPoints] - points[i] ); };
+
+	Pair previous, in, out;
+	Vec dir = direction( 0 );
+	if( closed ) {
+		Pair first;
+		addJoin( points[0], direction( numPoints - 1 ), dir, corners[0] != 0, &first, &previous );
+		for( size_t i = 1; i < numPoints; ++i ) {
+			const Vec next = direction( i );
+			addJoin( points[i], dir, next, corners[i] != 0, &in, &out );
+			addQuad( previous, in );
+			previous = out;
+			dir = next;
+		}
+		addQuad( previous, first );
+	}
+	else {
+		previous = addCap( points[0], dir, mStyle.getStartCap(), true );
+		for( size_t i = 1; i < numPoints - 1; ++i ) {
+			const Vec next = direction( i );
+			addJoin( points[i], dir, next, corners[i] != 0, &in, &out );
+			addQuad( previous, in );
+			previous = out;
+			dir = next;
+		}
+		addQuad( previous, addCap( points[numPoints - 1], dir, mStyle.getEndCap(), false ) );
+	}
+}
+
+//! Splits the polyline in \a contour into dashes like dashInternal(), stroking each of them using \a dash and \a pattern for storage.
+template<typename T, typename PolylineT>
+void strokeDashes( StrokeTriangulator<T> &triangulator, const PolylineT &contour, bool closed, const StrokeStyle &style, PolylineT *dash, std::vector<T> *dashPattern )
+{
+	std::vector<T> &pattern = *dashPattern;
+	pattern.clear();
+	T patternLength = 0;
+	for( float d : style.getDashPattern() ) {
+		if( std::isfinite( d ) && d != 0 ) {
+			pattern.push_back( std::abs( T( d ) ) );
+			patternLength += pattern.back();
+		}
+	}
+
+	const auto &points = contour.mPoints;
+	const size_t numPoints = points.size();
+	if( pattern.empty() || ! ( patternLength > 0 ) || ! std::isfinite( patternLength ) ) {
+		triangulator.strokePolyline( points.data(), contour.mCorners.data(), numPoints, closed );
+		return;
+	}
+	if( numPoints < 2 )
+		return;
+
+	T offset = std::fmod( T( style.getDashOffset() ), patternLength );
+	if( offset < 0 )
+		offset += patternLength;
+
+	size_t dashIdx = 0;
+	T dashRemaining = pattern[0];
+	bool active = true;
+	while( offset > 0 && dashRemaining <= offset ) {
+		offset -= dashRemaining;
+		dashIdx = ( dashIdx + 1 ) % pattern.size();
+		dashRemaining = pattern[dashIdx];
+		active = ! active;
+	}
+	dashRemaining -= offset;
+
+	auto emitDash = [&] {
+		if( dash->mPoints.size() > 1 )
+			triangulator.strokePolyline( dash->mPoints.data(), dash->mCorners.data(), dash->mPoints.size(), false );
+		dash->mPoints.clear();
+		dash->mCorners.clear();
+	};
+
+	dash->mPoints.clear();
+	dash->mCorners.clear();
+	if( active )
+		addPolylinePoint( &dash->mPoints, &dash->mCorners, points[0], true );
+
+	const size_t numSegments = closed ? numPoints : numPoints - 1;
+	for( size_t i = 0; i < numSegments; ++i ) {
+		const size_t end = ( i + 1 ) % numPoints;
+		const auto a = points[i], b = points[end];
+		const T length = glm::length( b - a );
+		T position = 0;
+		while( dashRemaining <= length - position ) {
+			position += dashRemaining;
+			const auto split = a + ( b - a ) * ( position / length );
+			if( active )
+				addPolylinePoint( &dash->mPoints, &dash->mCorners, split, true );
+			emitDash();
+			if( ! active )
+				addPolylinePoint( &dash->mPoints, &dash->mCorners, split, true );
+			dashIdx = ( dashIdx + 1 ) % pattern.size();
+			dashRemaining = pattern[dashIdx];
+			active = ! active;
+		}
+		dashRemaining -= length - position;
+		if( active )
+			addPolylinePoint( &dash->mPoints, &dash->mCorners, b, contour.mCorners[end] != 0 );
+	}
+
+	emitDash();
+}
+
+} // anonymous namespace
+
+void StrokeMesh2d::appendStroke( const Path2d &path, const StrokeStyle &style, float tolerance )
+{
+	appendContour( path, style, tolerance );
+}
+
+void StrokeMesh2d::appendStroke( const Shape2d &shape, const StrokeStyle &style, float tolerance )
+{
+	for( const auto &contour : shape.getContours() )
+		appendContour( contour, style, tolerance );
+}
+
+void StrokeMesh2d::appendContour( const Path2d &path, const StrokeStyle &style, float tolerance )
+{
+	bool useFloat = mPrecision == Precision::FLOAT;
+	if( mPrecision == Precision::AUTO ) {
+		// below 65536 times the tolerance, float rounding errors stay under 1/128 of the tolerance
+		float maxCoordinate = 0;
+		for( const auto &p : path.getPoints() )
+			maxCoordinate = std::max( maxCoordinate, std::max( std::abs( p.x ), std::abs( p.y ) ) );
+		useFloat = maxCoordinate + std::abs( style.getWidth() ) < tolerance * 65536.0f;
+	}
+
+	if( useFloat )
+		appendContour<float>( path, style, tolerance, &mContourF, &mDashF, &mDashPatternF );
+	else
+		appendContour<double>( path, style, tolerance, &mContourD, &mDashD, &mDashPatternD );
+}
+
+template<typename T>
+void StrokeMesh2d::appendContour( const Path2d &path, const StrokeStyle &style, T tolerance, Polyline<T> *contour, Polyline<T> *dash, std::vector<T> *dashPattern )
+{
+	if( ! ( tolerance > 0 ) )
+		return;
+
+	StrokeTriangulator<T> triangulator( style, tolerance, &mPositions, &mIndices );
+	const bool closed = flattenContour( path, tolerance, triangulator.getMaxFanAngle(), &contour->mPoints, &contour->mCorners );
+	if( style.getDashPattern().empty() )
+		triangulator.strokePolyline( contour->mPoints.data(), contour->mCorners.data(), contour->mPoints.size(), closed );
+	else
+		strokeDashes( triangulator, *contour, closed, style, dash, dashPattern );
+}
+
+namespace {
+
+template<typename PathT>
+void calcStrokesImpl( const PathT *paths, const StrokeStyle *styles, size_t count, StrokeMesh2d *results, float tolerance )
+{
+	ip::parallelFor( 0, static_cast<int32_t>( count ), 16, [&]( int32_t taskBegin, int32_t taskEnd ) {
+		for( int32_t i = taskBegin; i < taskEnd; ++i ) {
+			results[i].clear();
+			results[i].appendStroke( paths[i], styles[i], tolerance );
+		}
+	} );
+}
+
+} // anonymous namespace
+
+void StrokeMesh2d::calcStrokes( const Path2d *paths, const StrokeStyle *styles, size_t count, StrokeMesh2d *results, float tolerance )
+{
+	calcStrokesImpl( paths, styles, count, results, tolerance );
+}
+
+void StrokeMesh2d::calcStrokes( const Shape2d *shapes, const StrokeStyle *styles, size_t count, StrokeMesh2d *results, float tolerance )
+{
+	calcStrokesImpl( shapes, styles, count, results, tolerance );
+}
+
 } // namespace cinder
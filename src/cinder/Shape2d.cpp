@@ -286,8 +286,17 @@ vector<Shape2d::Intersection> Shape2d::findIntersections( const Shape2d &other,
 {
 	vector<Intersection> result;
 
+	// pairs of contours whose control points don't overlap can't intersect
+	vector<Rectf> otherBounds;
+	for( const auto &contour : other.mContours )
+		otherBounds.push_back( contour.calcBoundingBox() );
+
 	for( size_t i = 0; i < mContours.size(); ++i ) {
+		const Rectf bounds = mContours[i].calcBoundingBox().inflated( vec2( tolerance ) );
 		for( size_t j = 0; j < other.mContours.size(); ++j ) {
+			if( ! bounds.intersects( otherBounds[j] ) )
+				continue;
+
 			auto pathIsects = mContours[i].findIntersections( other.mContours[j], tolerance );
 			for( const auto &pi : pathIsects ) {
 				result.push_back( {
@@ -310,7 +319,11 @@ vector<Shape2d::Intersection> Shape2d::findIntersections( const Path2d &path, fl
 {
 	vector<Intersection> result;
 
+	const Rectf pathBounds = path.calcBoundingBox().inflated( vec2( tolerance ) );
 	for( size_t i = 0; i < mContours.size(); ++i ) {
+		if( ! pathBounds.intersects( mContours[i].calcBoundingBox() ) )
+			continue;
+
 		auto pathIsects = mContours[i].findIntersections( path, tolerance );
 		for( const auto &pi : pathIsects ) {
 			result.push_back( {
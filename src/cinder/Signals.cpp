@@ -154,14 +154,42 @@ void ConnectionList::clear()
 
 namespace detail {
 
-Disconnector::Disconnector( SignalBase *signal )
-	: mSignal( signal )
+Disconnector::Disconnector( SignalBase *signal, bool threadSafe )
+	: mSignal( signal ), mThreadSafe( threadSafe )
 {
 }
 
 bool Disconnector::disconnect( SignalLinkBase *link, int priority )
 {
-	return mSignal->disconnect( link, priority );
+	if( ! mThreadSafe )
+		return mSignal->disconnect( link, priority );
+
+	// the lock keeps the signal alive, but the callbacks it gave up are destroyed after unlocking, as they may disconnect from other
+	// signals, or from this one
+	DeferredRelease deferred;
+	bool result;
+	{
+		lock_guard<mutex> lock( mMutex );
+		if( ! mSignal )
+			return false;
+
+		result = mSignal->disconnectDeferred( link, priority, &deferred );
+	}
+
+	if( deferred.mFn )
+		deferred.mFn( deferred.mData );
+
+	return result;
+}
+
+void Disconnector::detach()
+{
+	if( mThreadSafe ) {
+		lock_guard<mutex> lock( mMutex );
+		mSignal = nullptr;
+	}
+	else
+		mSignal = nullptr;
 }
 
 } } } // namespace cinder::signals::detail
@@ -247,6 +247,14 @@ SurfaceT<T>::SurfaceT( T *data, int32_t width, int32_t height, ptrdiff_t rowByte
 	initChannels();
 }
 
+template<typename T>
+SurfaceT<T>::SurfaceT( const std::shared_ptr<T> &dataStore, int32_t width, int32_t height, ptrdiff_t rowBytes, SurfaceChannelOrder channelOrder )
+	: mWidth( width ), mHeight( height ), mRowBytes( rowBytes ), mData( dataStore.get() ), mDataStore( dataStore ), mChannelOrder( channelOrder )
+{
+	mPremultiplied = false;
+	initChannels();
+}
+
 template<typename T>
 SurfaceT<T>::SurfaceT( ImageSourceRef imageSource, const SurfaceConstraints &constraints )
 {
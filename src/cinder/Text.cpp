@@ -25,6 +25,7 @@
 #include "cinder/Text.h"
 #include "cinder/ip/Fill.h"
 #include "cinder/ip/Premultiply.h"
+#include "cinder/ip/Execution.h"
 #include "cinder/Utilities.h"
 #include "cinder/Noncopyable.h"
 
@@ -51,10 +52,13 @@
 #elif defined( CINDER_ANDROID ) || defined( CINDER_LINUX )
 	#include "cinder/linux/FreeTypeUtil.h"
 
+	#include <cstring>
+
 	static const float MAX_SIZE = 1000000.0f;
 #endif
 
 #include <limits.h>
+#include <algorithm>
 
 #include "cinder/app/App.h"
 
@@ -233,13 +237,13 @@ void Line::calcExtents()
 	for( vector<Run>::iterator runIt = mRuns.begin(); runIt != mRuns.end(); ++runIt ) {
 		FT_Face face = runIt->mFont.getFreetypeFace();
 
-		auto measure = ci::linux::ftutil::MeasureString( runIt->mText, face );
+		auto run = GlyphCache::get()->getRun( face, runIt->mText );
 
-		mWidth   += measure.getWidth();
+		mWidth   += run->mSize.x;
 		mAscent  = std::max( runIt->mFont.getAscent(),     mAscent  );
 		mDescent = std::max( runIt->mFont.getDescent(),    mDescent );
 		mLeading = std::max( runIt->mFont.getLeading(),    mLeading );
-		mHeight  = std::max( (float)(measure.getHeight()), mHeight  );
+		mHeight  = std::max( (float)(run->mSize.y),        mHeight  );
 	}
 #endif
 
@@ -305,38 +309,18 @@ void Line::render(Channel &channel, float currentY, float xBorder, float maxWidt
 
 #elif defined( CINDER_ANDROID ) || defined( CINDER_LINUX )
 
-void draw_bitmap( FT_Int x, FT_Int y, FT_Bitmap* bitmap, const ColorA8u& color, uint8_t *dstData, size_t dstPixelInc, size_t dstRowBytes, const ivec2& dstSize )
+// Draws \a glyph with the pen at \a pen, in 1/64 pixels with y pointing up from the bottom of the destination
+void drawGlyph( const GlyphCache::Glyph &glyph, const ivec2 &pen, const ColorA8u &color, uint8_t *dstData, size_t dstPixelInc, size_t dstRowBytes, const ivec2 &dstSize )
 {
-	FT_Int i, j, p, q;
-	FT_Int x_max = x + bitmap->width;
-	FT_Int y_max = y + bitmap->rows;
-
-	for( j = y, q = 0; j < y_max; ++j, ++q ) {
-		for( i = x, p = 0; i < x_max; ++i, ++p ) {
-		 	if( i < 0 || j < 0 || i >= dstSize.x || j >= dstSize.y ) {
-				continue;
-			}
-			
-			size_t index = j*dstRowBytes + i*dstPixelInc;
-			uint8_t *data = dstData + index;
-			int dr = *(data + 0);
-			int dg = *(data + 1);
-			int db = *(data + 2);
-			int da = *(data + 3);
-
-			int val = (bitmap->buffer[q * bitmap->width + p]);
-	  		int alpha = val + 1;
-			int invAlpha = 256 - val;
-			int r = (color.r*alpha + dr*invAlpha) >> 8;
-			int g = (color.g*alpha + dg*invAlpha) >> 8;
-			int b = (color.b*alpha + db*invAlpha) >> 8;
-			int a = (color.a*alpha + da*invAlpha) >> 8;
-			*(data + 0) = r;
-			*(data + 1) = g;
-			*(data + 2) = b;
-			*(data + 3) = a;
-		}
-	}
+	FT_Bitmap bitmap;
+	memset( &bitmap, 0, sizeof(bitmap) );
+	bitmap.width = glyph.mWidth;
+	bitmap.rows = glyph.mRows;
+	bitmap.pitch = glyph.mWidth;
+	bitmap.buffer = const_cast<uint8_t*>( glyph.mPixels.data() );
+
+	ivec2 offset = ivec2( ( pen.x >> 6 ) + glyph.mLeft, dstSize.y - ( ( pen.y >> 6 ) + glyph.mTop ) );
+	ci::linux::ftutil::DrawBitmap( offset, &bitmap, color, dstData, dstPixelInc, dstRowBytes, dstSize );
 }
 
 void Line::render( Surface &surface, float currentY, float xBorder, float maxWidth )
@@ -358,26 +342,19 @@ void Line::render( Surface &surface, float currentY, float xBorder, float maxWid
   #endif		
 	}
 
+	GlyphCache *glyphCache = GlyphCache::get();
+	vector<GlyphCache::GlyphRef> glyphs;
 	for( vector<Run>::const_iterator runIt = mRuns.begin(); runIt != mRuns.end(); ++runIt ) {
 		ColorA8u color = runIt->mColor;
 
 		FT_Face face = runIt->mFont.getFreetypeFace();
-		FT_Vector pen = { (int)currentX * 64, (int)(surfaceSize.y - currentY) * 64 };
-
-		std::u32string strU32 = ci::toUtf32( runIt->mText );
-		for( const auto& ch : strU32 ) {
-			FT_Set_Transform( face, nullptr, &pen );
-
-			FT_UInt glyphIndex = FT_Get_Char_Index( face, ch );
-			FT_Load_Glyph( face, glyphIndex, FT_LOAD_RENDER );
-
-			FT_GlyphSlot slot = face->glyph;
-			ivec2 offset = ivec2( slot->bitmap_left, surfaceSize.y - slot->bitmap_top );
-
-			draw_bitmap( offset.x, offset.y, &(slot->bitmap), color, surfaceData, surfacePixelInc, surfaceRowBytes, surfaceSize );
+		ivec2 pen = ivec2( (int)currentX * 64, (int)(surfaceSize.y - currentY) * 64 );
 
-			pen.x += slot->advance.x;
-			pen.y += slot->advance.y;
+		auto run = glyphCache->getRun( face, runIt->mText );
+		glyphCache->getGlyphs( face, *run, pen, &glyphs );
+		for( size_t i = 0; i < glyphs.size(); ++i ) {
+			drawGlyph( *glyphs[i], pen, color, surfaceData, surfacePixelInc, surfaceRowBytes, surfaceSize );
+			pen += run->mAdvances[i];
 		}
 
 		currentX = (pen.x / 64.0f) + 0.5f;
@@ -703,6 +680,65 @@ Surface renderString( const string &str, const Font &font, const ColorA &color,
 
 	return result;
 }
+
+void renderStrings( const string *strs, size_t count, const Font &font, const ColorA &color, Surface *results, float *baselineOffsets )
+{
+#if defined( CINDER_ANDROID ) || defined( CINDER_LINUX )
+	ip::parallelFor( 0, (int32_t)count, 4, [&]( int32_t taskBegin, int32_t taskEnd ) {
+		for( int32_t i = taskBegin; i < taskEnd; ++i )
+			results[i] = renderString( strs[i], font, color, baselineOffsets ? &baselineOffsets[i] : nullptr );
+	} );
+#else
+	// the GDI+ path shares TextManager's DC, so only the FreeType path is spread across threads
+	for( size_t i = 0; i < count; ++i )
+		results[i] = renderString( strs[i], font, color, baselineOffsets ? &baselineOffsets[i] : nullptr );
+#endif
+}
+
+Surface renderStringAtlas( const string *strs, size_t count, const Font &font, const ColorA &color, int32_t width, Area *areas, float *baselineOffsets, int32_t padding )
+{
+	if( count == 0 )
+		return Surface();
+
+	vector<Surface> surfaces( count );
+	renderStrings( strs, count, font, color, surfaces.data(), baselineOffsets );
+
+	vector<ivec2> sizes( count, ivec2( 0 ) );
+	for( size_t i = 0; i < count; ++i ) {
+		if( surfaces[i].getData() )
+			sizes[i] = surfaces[i].getSize();
+		width = std::max( width, sizes[i].x + padding * 2 );
+	}
+
+	// packs rows from the tallest strings to the shortest, so that little of each row's height is wasted
+	vector<size_t> order( count );
+	for( size_t i = 0; i < count; ++i )
+		order[i] = i;
+	std::stable_sort( order.begin(), order.end(), [&]( size_t a, size_t b ) { return sizes[a].y > sizes[b].y; } );
+
+	ivec2 pos( padding );
+	int32_t rowHeight = 0;
+	for( size_t i : order ) {
+		if( ( pos.x > padding ) && ( pos.x + sizes[i].x + padding > width ) ) {
+			pos = ivec2( padding, pos.y + rowHeight + padding );
+			rowHeight = 0;
+		}
+		areas[i] = Area( pos, pos + sizes[i] );
+		pos.x += sizes[i].x + padding;
+		rowHeight = std::max( rowHeight, sizes[i].y );
+	}
+
+	Surface result( width, pos.y + rowHeight + padding, true, SurfaceConstraintsDefault() );
+	ip::fill( &result, ColorA( 0, 0, 0, 0 ) );
+	ip::parallelFor( 0, (int32_t)count, 16, [&]( int32_t taskBegin, int32_t taskEnd ) {
+		for( int32_t i = taskBegin; i < taskEnd; ++i ) {
+			if( surfaces[i].getData() )
+				result.copyFrom( surfaces[i], surfaces[i].getBounds(), areas[i].getUL() );
+		}
+	} );
+
+	return result;
+}
 #endif
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1017,10 +1053,10 @@ void TextBox::calculate() const
 
 	vector<string> lines = calculateLineBreaks( nullptr );
 	for( const auto& text : lines ) {
-		auto measure = ci::linux::ftutil::MeasureString( text, face );
-		float fullWidth = measure.getBaseline().x + measure.getWidth();
+		auto run = GlyphCache::get()->getRun( face, text );
+		float fullWidth = (float)( run->mBaseline.x + run->mSize.x );
 		mCalculatedSize.x = std::max( mCalculatedSize.x, fullWidth );
-		mCalculatedSize.y += measure.getHeight();
+		mCalculatedSize.y += run->mSize.y;
 	}
 
 	mInvalid = false;
@@ -1044,7 +1080,7 @@ vector<string> TextBox::calculateLineBreaks( const std::map<Font::Glyph, Font::G
 	};
 	struct LineMeasure {
 		LineMeasure( int maxWidth, const Font &font, const std::map<Font::Glyph, Font::GlyphMetrics>* cachedGlyphMetrics = nullptr ) 
-			: mMaxWidth( maxWidth ), mFont( font.getFreetypeFace() ), mCachedGlyphMerics( cachedGlyphMetrics ) {}
+			: mMaxWidth( maxWidth ), mFont( font ), mCachedGlyphMerics( cachedGlyphMetrics ) {}
 		bool operator()( const char *line, size_t len ) const {
 			if( mMaxWidth >= MAX_SIZE ) {
 				// too big anyway so just return true
@@ -1056,15 +1092,13 @@ vector<string> TextBox::calculateLineBreaks( const std::map<Font::Glyph, Font::G
 			FT_Vector pen = { 0, 0 };
 			for( const auto& ch : utf32Chars ) {
 				ivec2 advance = { 0, 0 };
-				FT_UInt glyphIndex = FT_Get_Char_Index( mFont, ch );
+				FT_UInt glyphIndex = mFont.getGlyphIndex( ch );
 				if( nullptr != mCachedGlyphMerics ) {
 					auto iter = mCachedGlyphMerics->find( glyphIndex );
 					advance = iter->second.advance;		
 				}
 				else  {
-					FT_Load_Glyph( mFont, glyphIndex, FT_LOAD_DEFAULT );
-					const FT_GlyphSlot& slot = mFont->glyph;
-					advance = ivec2( slot->advance.x, slot->advance.y );
+					advance = GlyphCache::get()->getGlyph( mFont.getFreetypeFace(), glyphIndex )->mAdvance;
 				}
 
 				pen.x += advance.x;
@@ -1078,7 +1112,7 @@ vector<string> TextBox::calculateLineBreaks( const std::map<Font::Glyph, Font::G
 		}
 
 		int													mMaxWidth;
-		FT_Face												mFont;
+		Font												mFont;
 		const std::map<Font::Glyph, Font::GlyphMetrics>* 	mCachedGlyphMerics;
 	};
 	std::function<void(const char *,size_t)> lineFn = LineProcessor( &result );		
@@ -1105,15 +1139,13 @@ vector<pair<uint32_t,vec2>> TextBox::measureGlyphs( const std::map<Font::Glyph,
 		FT_Vector pen = { 0, 0 };
 		for( const auto& ch : utf32Chars ) {
 			ivec2 advance = { 0, 0 };
-			FT_UInt glyphIndex = FT_Get_Char_Index( face, ch );
+			FT_UInt glyphIndex = mFont.getGlyphIndex( ch );
 			if( nullptr != cachedGlyphMetrics ) {
 				auto iter = cachedGlyphMetrics->find( glyphIndex );
 				advance = iter->second.advance;
 			}
 			else {
-				FT_Load_Glyph( face, glyphIndex, FT_LOAD_DEFAULT );
-				const FT_GlyphSlot& slot = face->glyph;
-				advance = ivec2( slot->advance.x, slot->advance.y );
+				advance = GlyphCache::get()->getGlyph( face, glyphIndex )->mAdvance;
 			}
 
 			float xPos = (pen.x / 64.0f) + 0.5f;
@@ -1134,15 +1166,16 @@ Surface TextBox::render( vec2 offset )
 	mCalculatedSize = vec2();
 	FT_Face face = mFont.getFreetypeFace();
 
-	std::vector<ci::linux::ftutil::Measure> measures;
+	GlyphCache *glyphCache = GlyphCache::get();
+	std::vector<GlyphCache::RunRef> runs;
 	std::vector<string> lines = calculateLineBreaks( nullptr );
 	for( const auto& text : lines ) {
-		auto measure = ci::linux::ftutil::MeasureString( text, face );
-		measures.push_back( measure );
+		auto run = glyphCache->getRun( face, text );
+		runs.push_back( run );
 
-		float fullWidth = measure.getBaseline().x + measure.getWidth();
+		float fullWidth = (float)( run->mBaseline.x + run->mSize.x );
 		mCalculatedSize.x = std::max( mCalculatedSize.x, fullWidth );
-		mCalculatedSize.y += measure.getHeight();		
+		mCalculatedSize.y += run->mSize.y;		
 	}
 
 	float sizeX = ( mSize.x <= 0 ) ? mCalculatedSize.x : mSize.x;
@@ -1167,40 +1200,32 @@ Surface TextBox::render( vec2 offset )
 	ivec2 		dstSize = result.getSize();
 
 	int curY = 0;
-	for( size_t i = 0; i < lines.size(); ++i ) {
-		const auto& text = lines[i];
-		const auto& measure = measures[i];
+	std::vector<GlyphCache::GlyphRef> glyphs;
+	for( size_t i = 0; i < runs.size(); ++i ) {
+		const auto& run = *runs[i];
 
-		vec2 baseline = measure.getBaseline();
+		vec2 baseline = run.mBaseline;
 		float penX = baseline.x + offset.x;
 		float penY = dstSize.y - (baseline.y + offset.y + curY);
 		if( TextBox::RIGHT == mAlign ) {
-			penX = dstSize.x - (measure.getWidth() + offset.x + 3.0f);
+			penX = dstSize.x - (run.mSize.x + offset.x + 3.0f);
 		}
 		else if( TextBox::CENTER == mAlign ) {
-			penX = 0.5f*(dstSize.x - measure.getWidth());		
+			penX = 0.5f*(dstSize.x - run.mSize.x);		
 		}
 
-		FT_Vector pen = { (int)(penX*64.0f), (int)(penY*64.0f) };
-
-		std::u32string utf32Chars = ci::toUtf32( text );		
-		for( const auto& ch : utf32Chars ) {
-			FT_Set_Transform( face, nullptr, &pen );
-
-			FT_UInt glyphIndex = FT_Get_Char_Index( face, ch );
-			FT_Load_Glyph( face, glyphIndex, FT_LOAD_RENDER );
-			const FT_GlyphSlot& slot = face->glyph;
+		ivec2 pen = ivec2( (int)(penX*64.0f), (int)(penY*64.0f) );
 
-			if( '\n' != (char)ch ) {
-				ivec2 drawOffset = ivec2( slot->bitmap_left, dstSize.y - slot->bitmap_top );
-				ci::linux::ftutil::DrawBitmap( drawOffset, &(slot->bitmap), mColor, dstData, dstPixelInc, dstRowBytes, dstSize );
+		glyphCache->getGlyphs( face, run, pen, &glyphs );
+		for( size_t g = 0; g < glyphs.size(); ++g ) {
+			if( '\n' != (char)run.mChars[g] ) {
+				drawGlyph( *glyphs[g], pen, mColor, dstData, dstPixelInc, dstRowBytes, dstSize );
 			}
 
-			pen.x += slot->advance.x;
-			pen.y += slot->advance.y;	
+			pen += run.mAdvances[g];
 		}
 
-		curY += measure.getHeight();
+		curY += run.mSize.y;
 	}
 
 	if( ! mPremultiplied ) {
@@ -1213,6 +1238,324 @@ Surface TextBox::render( vec2 offset )
 	return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// GlyphCache
+namespace {
+
+// the list node, map node and shared_ptr control block of an entry
+const size_t GLYPH_CACHE_ENTRY_OVERHEAD = 96;
+
+size_t hashCombine( size_t seed, size_t value )
+{
+	return seed ^ ( value + 0x9e3779b9 + ( seed << 6 ) + ( seed >> 2 ) );
+}
+
+} // anonymous namespace
+
+size_t GlyphCache::KeyHash::operator()( const FaceKey &key ) const
+{
+	size_t result = std::hash<FT_Face>()( key.mFace );
+	result = hashCombine( result, std::hash<int64_t>()( key.mScaleX ) );
+	return hashCombine( result, std::hash<int64_t>()( key.mScaleY ) );
+}
+
+size_t GlyphCache::KeyHash::operator()( const GlyphKey &key ) const
+{
+	size_t result = (*this)( key.mFaceKey );
+	result = hashCombine( result, key.mGlyphIndex );
+	return hashCombine( result, (size_t)( key.mSubpixel.x * 64 + key.mSubpixel.y ) );
+}
+
+size_t GlyphCache::KeyHash::operator()( const RunKey &key ) const
+{
+	return hashCombine( (*this)( key.mFaceKey ), std::hash<std::string>()( key.mText ) );
+}
+
+GlyphCache::GlyphCache()
+	: mEnabled( true ), mMemoryBudget( 32 * 1024 * 1024 ), mMemoryUsage( 0 ), mUseCount( 0 )
+{
+}
+
+GlyphCache* GlyphCache::get()
+{
+	// leaked like the FontManager instance, so it stays valid for anything that renders text during exit
+	static GlyphCache *sInstance = new GlyphCache;
+	return sInstance;
+}
+
+GlyphCache::RunRef GlyphCache::getRun( FT_Face face, const std::string &utf8 )
+{
+	unique_lock<mutex> lock( mMutex );
+
+	RunKey key = { { face, face->size->metrics.x_scale, face->size->metrics.y_scale }, utf8 };
+	if( mEnabled ) {
+		auto it = mRunMap.find( key );
+		if( it != mRunMap.end() ) {
+			mRuns.splice( mRuns.begin(), mRuns, it->second );
+			it->second->mLastUse = ++mUseCount;
+			return it->second->mValue;
+		}
+	}
+	lock.unlock();
+
+	auto run = make_shared<Run>();
+	run->mChars = ci::toUtf32( utf8 );
+	run->mGlyphIndices.reserve( run->mChars.size() );
+	run->mAdvances.reserve( run->mChars.size() );
+	{
+		lock_guard<mutex> freetypeLock( Font::getFreetypeMutex() );
+		for( char32_t ch : run->mChars )
+			run->mGlyphIndices.push_back( FT_Get_Char_Index( face, ch ) );
+	}
+	lock.lock();
+
+	// measures the same way as ftutil::MeasureString(), which renders each glyph with the pen in place
+	int xMin = 0, yMin = 0, xMax = 0, yMax = 0;
+	bool hasInitial = false;
+	ivec2 pen( 0 );
+	for( uint32_t glyphIndex : run->mGlyphIndices ) {
+		GlyphRef glyph = getGlyph( key.mFaceKey, glyphIndex, pen, lock );
+		run->mAdvances.push_back( glyph->mAdvance );
+		if( ! glyph->mLoaded )
+			continue;
+
+		int glyphPixWidth  = (int)((glyph->mMetricsSize.x / 64.0f) + 0.5f);
+		int glyphPixHeight = (int)((glyph->mMetricsSize.y / 64.0f) + 0.5f);
+		int glyphLeft   =  glyph->mLeft + ( pen.x >> 6 );
+		int glyphTop    = -( glyph->mTop + ( pen.y >> 6 ) );
+		int glyphRight  = glyphLeft + glyphPixWidth;
+		int glyphBottom = glyphTop + glyphPixHeight;
+
+		if( ! hasInitial ) {
+			xMin = glyphLeft;
+			yMin = glyphTop;
+			xMax = glyphRight;
+			yMax = glyphBottom;
+			hasInitial = true;
+		}
+
+		if( ( glyphPixWidth > 0 ) && ( glyphPixHeight > 0 ) ) {
+			yMin = std::min( yMin, glyphTop );
+			xMax = glyphRight;
+			yMax = std::max( yMax, glyphBottom );
+		}
+
+		pen += glyph->mAdvance;
+	}
+
+	run->mSize = ivec2( ( xMax - xMin ) + 1, (int)((face->size->metrics.height / 64.0f) + 0.5f) );
+	run->mBaseline = ivec2( xMin, (int)((std::fabs( face->size->metrics.ascender ) / 64.0f) + 0.5f) );
+
+	if( mEnabled ) {
+		// another thread may have created the same run meanwhile, whose entry is kept
+		auto it = mRunMap.find( key );
+		if( it != mRunMap.end() ) {
+			mRuns.splice( mRuns.begin(), mRuns, it->second );
+			it->second->mLastUse = ++mUseCount;
+			return it->second->mValue;
+		}
+
+		const size_t numBytes = GLYPH_CACHE_ENTRY_OVERHEAD + sizeof(Run) + utf8.size() + run->mChars.size() * ( sizeof(char32_t) + sizeof(uint32_t) + sizeof(ivec2) );
+		mRuns.push_front( { key, run, numBytes, ++mUseCount } );
+		mRunMap[key] = mRuns.begin();
+		mMemoryUsage += numBytes;
+		evictLocked();
+	}
+
+	return run;
+}
+
+GlyphCache::GlyphRef GlyphCache::getGlyph( FT_Face face, uint32_t glyphIndex, const ivec2 &pen )
+{
+	unique_lock<mutex> lock( mMutex );
+	return getGlyph( { face, face->size->metrics.x_scale, face->size->metrics.y_scale }, glyphIndex, pen, lock );
+}
+
+void GlyphCache::getGlyphs( FT_Face face, const Run &run, const ivec2 &pen, std::vector<GlyphRef> *result )
+{
+	unique_lock<mutex> lock( mMutex );
+
+	const FaceKey faceKey = { face, face->size->metrics.x_scale, face->size->metrics.y_scale };
+	result->clear();
+	ivec2 glyphPen = pen;
+	for( size_t i = 0; i < run.mGlyphIndices.size(); ++i ) {
+		result->push_back( getGlyph( faceKey, run.mGlyphIndices[i], glyphPen, lock ) );
+		glyphPen += run.mAdvances[i];
+	}
+}
+
+GlyphCache::GlyphRef GlyphCache::getGlyph( const FaceKey &faceKey, uint32_t glyphIndex, const ivec2 &pen, unique_lock<mutex> &lock )
+{
+	GlyphKey key = { faceKey, glyphIndex, ivec2( pen.x & 63, pen.y & 63 ) };
+	if( mEnabled ) {
+		auto it = mGlyphMap.find( key );
+		if( it != mGlyphMap.end() ) {
+			mGlyphs.splice( mGlyphs.begin(), mGlyphs, it->second );
+			it->second->mLastUse = ++mUseCount;
+			return it->second->mValue;
+		}
+	}
+
+	lock.unlock();
+	GlyphRef glyph = renderGlyph( key );
+	lock.lock();
+
+	if( mEnabled ) {
+		// another thread may have rendered the same glyph meanwhile, whose entry is kept
+		auto it = mGlyphMap.find( key );
+		if( it != mGlyphMap.end() ) {
+			mGlyphs.splice( mGlyphs.begin(), mGlyphs, it->second );
+			it->second->mLastUse = ++mUseCount;
+			return it->second->mValue;
+		}
+
+		const size_t numBytes = GLYPH_CACHE_ENTRY_OVERHEAD + sizeof(Glyph) + glyph->mPixels.size();
+		mGlyphs.push_front( { key, glyph, numBytes, ++mUseCount } );
+		mGlyphMap[key] = mGlyphs.begin();
+		mMemoryUsage += numBytes;
+		evictLocked();
+	}
+
+	return glyph;
+}
+
+GlyphCache::GlyphRef GlyphCache::renderGlyph( const GlyphKey &key )
+{
+	auto glyph = make_shared<Glyph>();
+	{
+		lock_guard<mutex> freetypeLock( Font::getFreetypeMutex() );
+
+		// only the subpixel offset is applied, moving the pen by whole pixels moves the bitmap by exactly as much
+		FT_Face face = key.mFaceKey.mFace;
+		FT_Vector delta = { key.mSubpixel.x, key.mSubpixel.y };
+		FT_Set_Transform( face, nullptr, &delta );
+		FT_Error error = FT_Load_Glyph( face, key.mGlyphIndex, FT_LOAD_RENDER );
+		FT_Set_Transform( face, nullptr, nullptr );
+
+		glyph->mLoaded = ( error == FT_Err_Ok );
+		glyph->mLeft = glyph->mTop = glyph->mWidth = glyph->mRows = 0;
+		glyph->mAdvance = glyph->mMetricsSize = ivec2( 0 );
+		if( glyph->mLoaded ) {
+			const FT_GlyphSlot slot = face->glyph;
+			const FT_Bitmap &bitmap = slot->bitmap;
+			glyph->mLeft = slot->bitmap_left;
+			glyph->mTop = slot->bitmap_top;
+			glyph->mWidth = (int)bitmap.width;
+			glyph->mRows = (int)bitmap.rows;
+			glyph->mAdvance = ivec2( slot->advance.x, slot->advance.y );
+			glyph->mMetricsSize = ivec2( slot->metrics.width, slot->metrics.height );
+
+			glyph->mPixels.resize( bitmap.width * bitmap.rows );
+			for( unsigned int y = 0; y < bitmap.rows; ++y ) {
+				const uint8_t *src = bitmap.buffer + y * bitmap.pitch;
+				uint8_t *dst = &glyph->mPixels[y * bitmap.width];
+				if( bitmap.pixel_mode == FT_PIXEL_MODE_MONO ) {
+					// embedded bitmaps may be monochrome, with 8 pixels to a byte
+					for( unsigned int x = 0; x < bitmap.width; ++x )
+						dst[x] = ( src[x >> 3] & ( 0x80 >> ( x & 7 ) ) ) ? 255 : 0;
+				}
+				else
+					memcpy( dst, src, bitmap.width );
+			}
+		}
+	}
+
+	return glyph;
+}
+
+void GlyphCache::evictLocked()
+{
+	// the glyphs and runs are each in order of use, so whichever of the two least recently used entries is older goes first
+	while( mMemoryUsage > mMemoryBudget && ! ( mGlyphs.empty() && mRuns.empty() ) ) {
+		if( ! mRuns.empty() && ( mGlyphs.empty() || mRuns.back().mLastUse < mGlyphs.back().mLastUse ) ) {
+			mMemoryUsage -= mRuns.back().mNumBytes;
+			mRunMap.erase( mRuns.back().mKey );
+			mRuns.pop_back();
+		}
+		else {
+			mMemoryUsage -= mGlyphs.back().mNumBytes;
+			mGlyphMap.erase( mGlyphs.back().mKey );
+			mGlyphs.pop_back();
+		}
+	}
+}
+
+void GlyphCache::setEnabled( bool enabled )
+{
+	lock_guard<mutex> lock( mMutex );
+	mEnabled = enabled;
+}
+
+bool GlyphCache::isEnabled() const
+{
+	lock_guard<mutex> lock( mMutex );
+	return mEnabled;
+}
+
+void GlyphCache::setMemoryBudget( size_t bytes )
+{
+	lock_guard<mutex> lock( mMutex );
+	mMemoryBudget = bytes;
+	evictLocked();
+}
+
+size_t GlyphCache::getMemoryBudget() const
+{
+	lock_guard<mutex> lock( mMutex );
+	return mMemoryBudget;
+}
+
+size_t GlyphCache::getMemoryUsage() const
+{
+	lock_guard<mutex> lock( mMutex );
+	return mMemoryUsage;
+}
+
+size_t GlyphCache::getNumGlyphs() const
+{
+	lock_guard<mutex> lock( mMutex );
+	return mGlyphs.size();
+}
+
+size_t GlyphCache::getNumRuns() const
+{
+	lock_guard<mutex> lock( mMutex );
+	return mRuns.size();
+}
+
+void GlyphCache::clear()
+{
+	lock_guard<mutex> lock( mMutex );
+	mGlyphs.clear();
+	mRuns.clear();
+	mGlyphMap.clear();
+	mRunMap.clear();
+	mMemoryUsage = 0;
+}
+
+void GlyphCache::clear( FT_Face face )
+{
+	lock_guard<mutex> lock( mMutex );
+	for( auto it = mGlyphs.begin(); it != mGlyphs.end(); ) {
+		if( it->mKey.mFaceKey.mFace == face ) {
+			mMemoryUsage -= it->mNumBytes;
+			mGlyphMap.erase( it->mKey );
+			it = mGlyphs.erase( it );
+		}
+		else
+			++it;
+	}
+	for( auto it = mRuns.begin(); it != mRuns.end(); ) {
+		if( it->mKey.mFaceKey.mFace == face ) {
+			mMemoryUsage -= it->mNumBytes;
+			mRunMap.erase( it->mKey );
+			it = mRuns.erase( it );
+		}
+		else
+			++it;
+	}
+}
+
 #endif
 
 } // namespace cinder
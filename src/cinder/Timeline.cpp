@@ -23,6 +23,7 @@
 */
 
 #include "cinder/Timeline.h"
+#include "cinder/Parallel.h"
 
 #include <algorithm>
 #include <vector>
@@ -31,25 +32,40 @@ using namespace std;
 
 namespace cinder {
 
+namespace {
+
+// batched tweens are split into chunks of this size when stepped on several threads
+const size_t STEP_CHUNK_SIZE = 8192;
+
+} // anonymous namespace
+
 ////////////////////////////////////////////////////////////////////////////////////////
 // Timeline
 typedef std::multimap<void*,TimelineItemRef>::iterator s_iter;
 typedef std::multimap<void*,TimelineItemRef>::const_iterator s_const_iter;
 
 Timeline::Timeline()
-	: TimelineItem( 0, 0, 0, 0 ), mDefaultAutoRemove( true ), mCurrentTime( 0 )
+	: TimelineItem( 0, 0, 0, 0 ), mDefaultAutoRemove( true ), mCurrentTime( 0 ), mHasPendingItems( false ), mBatchingEnabled( true ), mNumStepThreads( 1 )
 {
 	mUseAbsoluteTime = true;
 }
 
 Timeline::Timeline( const Timeline &rhs )
-	: TimelineItem( rhs ), mDefaultAutoRemove( rhs.mDefaultAutoRemove ), mCurrentTime( rhs.mCurrentTime )
+	: TimelineItem( rhs ), mDefaultAutoRemove( rhs.mDefaultAutoRemove ), mCurrentTime( rhs.mCurrentTime ), mHasPendingItems( false ), mBatchingEnabled( rhs.mBatchingEnabled ),
+		mNumStepThreads( rhs.mNumStepThreads )
 {
 	for( s_const_iter iter = rhs.mItems.begin(); iter != rhs.mItems.end(); ++iter ) {
-		mItems.insert( make_pair( iter->first, iter->second->clone() ) );
+		insertItem( iter->second->clone() );
 	}
 }
 
+Timeline::~Timeline()
+{
+	// tweens can outlive the Timeline through a TweenRef, and must not refer to its batches afterwards
+	for( auto &batch : mBatches )
+		batch->clear();
+}
+
 void Timeline::step( float timestep )
 {
 	mCurrentTime += timestep;
@@ -62,15 +78,26 @@ void Timeline::stepTo( float absoluteTime )
 	mCurrentTime = absoluteTime;
 	
 	eraseMarked();
+
+	// batches only step forward, so all items are stepped individually while reversing
+	if( reverse )
+		dissolveBatches();
+	else {
+		batchPending();
+		stepBatches( mCurrentTime );
+	}
 	
-	// we need to cache the end(). If a tween's update() fn or similar were to manipulate
-	// the list of items by adding new ones, we'll have invalidated our iterator.
-	// Deleted items are never removed immediately, but are marked for deletion.
-	s_iter endItem = mItems.end();
-	for( s_iter iter = mItems.begin(); iter != endItem; ++iter ) {
-		iter->second->stepTo( mCurrentTime, reverse );
-		if( iter->second->isComplete() && iter->second->getAutoRemove() )
-			iter->second->mMarkedForRemoval = true;
+	// we need to cache the size. If a tween's update() fn or similar were to add new items,
+	// they are appended and first stepped next time. Deleted items are never removed
+	// immediately, but are marked for deletion.
+	const size_t numItems = mSteppedItems.size();
+	for( size_t i = 0; i < numItems; ++i ) {
+		TimelineItem *item = mSteppedItems[i].get();
+		item->stepTo( mCurrentTime, reverse );
+		if( item->isComplete() && item->getAutoRemove() )
+			markForRemoval( item );
+		else if( item->mMarkedForRemoval ) // marked without going through markForRemoval()
+			mMarkedItems.emplace_back( item->mTarget, item );
 	}
 	
 	eraseMarked();	
@@ -86,7 +113,13 @@ CueRef Timeline::add( const std::function<void ()> &action, float atTime )
 
 void Timeline::clear()
 {
+	for( auto &batch : mBatches )
+		batch->clear();
+
 	mItems.clear();	
+	mSteppedItems.clear();
+	mHasPendingItems = false;
+	mMarkedItems.clear();
 }
 
 void Timeline::appendPingPong()
@@ -101,10 +134,8 @@ void Timeline::appendPingPong()
 	}
 	
 	for( vector<TimelineItemRef>::const_iterator appIt = toAppend.begin(); appIt != toAppend.end(); ++appIt ) {
-		mItems.insert( make_pair( (*appIt)->mTarget, *appIt ) );
+		insertItem( *appIt );
 	}
-	
-	setDurationDirty();
 }
 
 void Timeline::apply( TimelineItemRef item )
@@ -116,36 +147,214 @@ void Timeline::apply( TimelineItemRef item )
 
 void Timeline::add( TimelineItemRef item )
 {
-	item->mParent = this;
 	item->mStartTime = mCurrentTime;
-	mItems.insert( make_pair( item->mTarget, item ) );
-	setDurationDirty();
+	insertItem( item );
 }
 
 void Timeline::insert( TimelineItemRef item )
+{
+	insertItem( item );
+}
+
+void Timeline::insertItem( const TimelineItemRef &item )
 {
 	item->mParent = this;
+
+	// items sharing a target are stepped individually, in the order they were added
 	mItems.insert( make_pair( item->mTarget, item ) );
+	shareTarget( item->mTarget );
+	mSteppedItems.push_back( item );
+	setPending( item.get() );
+	if( item->mMarkedForRemoval )
+		mMarkedItems.emplace_back( item->mTarget, item.get() );
+
 	setDurationDirty();
 }
 
+void Timeline::markForRemoval( TimelineItem *item )
+{
+	if( item->mMarkedForRemoval )
+		return;
+
+	item->mMarkedForRemoval = true;
+	if( item->mBatchState.mBatch )
+		item->mBatchState.mBatch->remove( item );
+	mMarkedItems.emplace_back( item->mTarget, item );
+}
+
 // remove all items which have been marked for removal
 void Timeline::eraseMarked()
 {
-	bool needRecalc = false;
-	for( s_iter iter = mItems.begin(); iter != mItems.end(); ) {
-		if( iter->second->mMarkedForRemoval ) {
-			mItems.erase( iter++ );
-			needRecalc = true;
+	if( mMarkedItems.empty() )
+		return;
+
+	// the same item may be listed more than once, but is only found the first time
+	for( const auto &marked : mMarkedItems ) {
+		pair<s_iter,s_iter> range = mItems.equal_range( marked.first );
+		for( s_iter iter = range.first; iter != range.second; ++iter ) {
+			if( iter->second.get() == marked.second ) {
+				mItems.erase( iter );
+				break;
+			}
 		}
-		else
-			++iter;
 	}
-	
-	if( needRecalc )
-		setDurationDirty();
+	mMarkedItems.clear();
+
+	mSteppedItems.erase( remove_if( mSteppedItems.begin(), mSteppedItems.end(), []( const TimelineItemRef &item ) { return item->mMarkedForRemoval; } ), mSteppedItems.end() );
+	setDurationDirty();
 }	
 
+void Timeline::unbatch( TimelineItem *item )
+{
+	item->mBatchState.mBatch->remove( item );
+	mSteppedItems.push_back( item->thisRef() );
+	setPending( item );
+}
+
+void Timeline::setPending( TimelineItem *item )
+{
+	if( mBatchingEnabled ) {
+		item->mBatchState.mPending = true;
+		mHasPendingItems = true;
+	}
+}
+
+void Timeline::shareTarget( void *target )
+{
+	if( target == nullptr )
+		return;
+
+	pair<s_iter,s_iter> range = mItems.equal_range( target );
+	size_t numItems = 0;
+	for( s_iter iter = range.first; iter != range.second; ++iter ) {
+		if( ! iter->second->mMarkedForRemoval )
+			++numItems;
+	}
+
+	if( numItems > 1 ) {
+		for( s_iter iter = range.first; iter != range.second; ++iter ) {
+			if( iter->second->mMarkedForRemoval )
+				continue;
+
+			iter->second->mBatchState.mSharesTarget = true;
+			if( iter->second->mBatchState.mBatch )
+				unbatch( iter->second.get() );
+		}
+	}
+}
+
+void Timeline::dissolveBatches()
+{
+	for( auto &batch : mBatches ) {
+		for( size_t i = 0; i < batch->size(); ++i ) {
+			mSteppedItems.push_back( batch->getItem( i )->thisRef() );
+			setPending( batch->getItem( i ) );
+		}
+		batch->clear();
+	}
+}
+
+void Timeline::batchPending()
+{
+	if( ! mHasPendingItems )
+		return;
+	mHasPendingItems = false;
+
+	// moves batchable items into their batches and compacts the remaining ones in a single pass
+	BatchKey key;
+	auto remaining = mSteppedItems.begin();
+	for( auto &item : mSteppedItems ) {
+		BatchState &state = item->mBatchState;
+		if( state.mPending && ( ! state.mSharesTarget ) && ( ! item->mMarkedForRemoval ) && item->isBatchable( &key ) ) {
+			auto batchIt = find_if( mBatches.begin(), mBatches.end(), [&key]( const unique_ptr<TweenBatchBase> &batch ) { return batch->getKey() == key; } );
+			if( batchIt == mBatches.end() ) {
+				mBatches.emplace_back( item->createBatch() );
+				batchIt = mBatches.end() - 1;
+			}
+
+			state.mPending = false;
+			(*batchIt)->add( item.get() );
+			continue;
+		}
+
+		state.mPending = false;
+		*remaining++ = std::move( item );
+	}
+
+	mSteppedItems.erase( remaining, mSteppedItems.end() );
+}
+
+void Timeline::stepBatches( float time )
+{
+	size_t numTweens = 0;
+	for( const auto &batch : mBatches )
+		numTweens += batch->size();
+	if( numTweens == 0 )
+		return;
+
+	size_t numCompleted = 0;
+	if( mNumStepThreads > 1 && numTweens >= 2 * STEP_CHUNK_SIZE ) {
+		struct Chunk {
+			TweenBatchBase	*mBatch;
+			size_t			mBegin, mEnd, mNumCompleted;
+		};
+		vector<Chunk> chunks;
+		for( const auto &batch : mBatches ) {
+			for( size_t begin = 0; begin < batch->size(); begin += STEP_CHUNK_SIZE )
+				chunks.push_back( { batch.get(), begin, std::min( begin + STEP_CHUNK_SIZE, batch->size() ), 0 } );
+		}
+
+		parallelFor( 0, (int32_t)chunks.size(), 1, mNumStepThreads, [&chunks, time]( int32_t taskBegin, int32_t taskEnd ) {
+			for( int32_t index = taskBegin; index < taskEnd; ++index ) {
+				Chunk &chunk = chunks[index];
+				chunk.mNumCompleted = chunk.mBatch->step( time, chunk.mBegin, chunk.mEnd );
+			}
+		} );
+
+		for( const auto &chunk : chunks )
+			numCompleted += chunk.mNumCompleted;
+	}
+	else {
+		for( const auto &batch : mBatches )
+			numCompleted += batch->step( time, 0, batch->size() );
+	}
+
+	if( numCompleted > 0 ) {
+		vector<TimelineItem*> completed;
+		for( const auto &batch : mBatches )
+			batch->eraseCompleted( &completed );
+		for( TimelineItem *item : completed )
+			markForRemoval( item );
+	}
+}
+
+void Timeline::setBatchingEnabled( bool enable )
+{
+	if( enable == mBatchingEnabled )
+		return;
+
+	mBatchingEnabled = enable;
+	if( enable ) {
+		for( const auto &item : mSteppedItems )
+			setPending( item.get() );
+	}
+	else
+		dissolveBatches();
+}
+
+size_t Timeline::getNumBatchedItems() const
+{
+	size_t result = 0;
+	for( const auto &batch : mBatches )
+		result += batch->size();
+	return result;
+}
+
+void Timeline::setNumStepThreads( size_t numThreads )
+{
+	mNumStepThreads = getNumParallelThreads( numThreads );
+}
+
 
 float Timeline::calcDuration() const
 {
@@ -232,9 +441,10 @@ float Timeline::findEndTimeOf( void *target, bool *found ) const
 
 void Timeline::remove( TimelineItemRef item )
 {
-	for( s_iter iter = mItems.begin(); iter != mItems.end(); ++iter ) {
+	pair<s_iter,s_iter> range = mItems.equal_range( item->mTarget );
+	for( s_iter iter = range.first; iter != range.second; ++iter ) {
 		if( iter->second == item ) {
-			iter->second->mMarkedForRemoval = true;
+			markForRemoval( item.get() );
 			break;
 		}
 	}
@@ -247,7 +457,7 @@ void Timeline::removeTarget( void *target )
 		
 	pair<s_iter,s_iter> range = mItems.equal_range( target );
 	for( s_iter iter = range.first; iter != range.second; ++iter )
-		iter->second->mMarkedForRemoval = true;
+		markForRemoval( iter->second.get() );
 
 	setDurationDirty();
 }
@@ -267,9 +477,7 @@ void Timeline::cloneAndReplaceTarget( void *target, void *replacementTarget )
 	}
 
 	for( vector<TimelineItemRef>::iterator newItemIt = newItems.begin(); newItemIt != newItems.end(); ++newItemIt )
-		mItems.insert( make_pair( replacementTarget, *newItemIt ) );
-
-	setDurationDirty();
+		insertItem( *newItemIt );
 }
 
 void Timeline::replaceTarget( void *target, void *replacementTarget )
@@ -279,15 +487,25 @@ void Timeline::replaceTarget( void *target, void *replacementTarget )
 
 	s_iter iter = mItems.find( target );
 	while( ( iter != mItems.end() ) && ( iter->first == target ) ) {
-		iter->second->setTarget( replacementTarget );
+		TimelineItem *item = iter->second.get();
+		item->setTarget( replacementTarget );
+		if( item->mBatchState.mBatch )
+			item->mBatchState.mBatch->setTarget( item->mBatchState.mIndex, replacementTarget );
+		if( item->mMarkedForRemoval )
+			mMarkedItems.emplace_back( replacementTarget, item );
+
 		mItems.insert( make_pair( replacementTarget, iter->second ) );
 		iter = mItems.erase( iter );
 	}
+
+	// a batched item stays batched as long as it is the only one with its target
+	shareTarget( replacementTarget );
 }
 
 void Timeline::reset( bool unsetStarted )
 {
 	TimelineItem::reset( unsetStarted );
+	dissolveBatches();
 	
 	for( s_iter iter = mItems.begin(); iter != mItems.end(); ++iter )
 		iter->second->reset( unsetStarted );
@@ -301,6 +519,7 @@ void Timeline::loopStart()
 
 void Timeline::reverse()
 {
+	dissolveBatches();
 	for( s_iter iter = mItems.begin(); iter != mItems.end(); ++iter )
 		iter->second->reverse();
 }
@@ -326,11 +545,21 @@ void Timeline::update( float absTime )
 	stepTo( absTime );
 }
 
-void Timeline::itemTimeChanged( TimelineItem * /*item*/ )
+void Timeline::itemTimeChanged( TimelineItem *item )
 {
+	itemChanged( item );
 	setDurationDirty();
 }
 
+void Timeline::itemChanged( TimelineItem *item )
+{
+	// the item is batched on the next step if it can be now, whether or not it was batched before
+	if( item->mBatchState.mBatch )
+		unbatch( item );
+	else
+		setPending( item );
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////
 // Cue
 Cue::Cue( const std::function<void ()> &fn, float atTime )
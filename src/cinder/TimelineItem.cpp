@@ -46,7 +46,16 @@ TimelineItem::TimelineItem( Timeline *parent, void *target, float startTime, flo
 
 void TimelineItem::removeSelf()
 {
-	mMarkedForRemoval = true;
+	if( mParent )
+		mParent->markForRemoval( this );
+	else
+		mMarkedForRemoval = true;
+}
+
+void TimelineItem::notifyChanged()
+{
+	if( mParent )
+		mParent->itemChanged( this );
 }
 
 void TimelineItem::stepTo( float newTime, bool reverse )
@@ -22,23 +22,123 @@
 
 #include "cinder/Triangulate.h"
 #include "cinder/Shape2d.h"
+#include "cinder/ip/Execution.h"
 #include "../libtess2/tesselator.h"
 
+#include <cstdlib>
+#include <cstring>
+
 using namespace std;
 
 namespace cinder {
 
-void* stdAlloc( void* userData, unsigned int size )
-{
-	int *allocated = (int*)userData;
-	*allocated += (int)size;
-	return malloc( size );
-}
+namespace {
 
-void stdFree( void* /*userData*/, void* ptr )
-{
-	free( ptr );
-}
+// the memory each thread's Triangulator keeps between calls to calcMeshes()
+const size_t MAX_THREAD_CACHE_BYTES = 1024 * 1024;
+
+} // anonymous namespace
+
+// Recycles the memory libtess2 frees, so that a Triangulator which is reused stops calling malloc() once its pool holds enough
+// blocks of each size. Sizes are rounded up to powers of two, and each block starts with a header which holds its size class.
+struct Triangulator::MemoryPool {
+	static const int	HEADER_SIZE = 16; // keeps the alignment of malloc()
+	static const int	MIN_SIZE_CLASS = 5;
+	static const int	NUM_SIZE_CLASSES = 48;
+
+	MemoryPool()
+		: mNumBytes( 0 ), mNumFreeBytes( 0 )
+	{
+		memset( mFreeLists, 0, sizeof(mFreeLists) );
+	}
+
+	~MemoryPool()
+	{
+		for( void *block : mFreeLists ) {
+			while( block ) {
+				void *next = *static_cast<void**>( block );
+				std::free( block );
+				block = next;
+			}
+		}
+	}
+
+	static void* alloc( void *userData, unsigned int size )
+	{
+		MemoryPool *pool = static_cast<MemoryPool*>( userData );
+		int sizeClass = MIN_SIZE_CLASS;
+		while( ( size_t( 1 ) << sizeClass ) < size_t( size ) + HEADER_SIZE )
+			++sizeClass;
+
+		void *block = pool->mFreeLists[sizeClass];
+		if( block ) {
+			pool->mFreeLists[sizeClass] = *static_cast<void**>( block );
+			pool->mNumFreeBytes -= size_t( 1 ) << sizeClass;
+		}
+		else {
+			block = std::malloc( size_t( 1 ) << sizeClass );
+			if( ! block )
+				return nullptr;
+			pool->mNumBytes += size_t( 1 ) << sizeClass;
+		}
+
+		*static_cast<int*>( block ) = sizeClass;
+		return static_cast<char*>( block ) + HEADER_SIZE;
+	}
+
+	static void* realloc( void *userData, void *ptr, unsigned int size )
+	{
+		if( ! ptr )
+			return alloc( userData, size );
+
+		const size_t capacity = ( size_t( 1 ) << getSizeClass( ptr ) ) - HEADER_SIZE;
+		if( size <= capacity )
+			return ptr;
+
+		void *result = alloc( userData, size );
+		if( result ) {
+			memcpy( result, ptr, capacity );
+			free( userData, ptr );
+		}
+		return result;
+	}
+
+	static void free( void *userData, void *ptr )
+	{
+		if( ! ptr )
+			return;
+
+		MemoryPool *pool = static_cast<MemoryPool*>( userData );
+		const int sizeClass = getSizeClass( ptr );
+		void *block = static_cast<char*>( ptr ) - HEADER_SIZE;
+		*static_cast<void**>( block ) = pool->mFreeLists[sizeClass];
+		pool->mFreeLists[sizeClass] = block;
+		pool->mNumFreeBytes += size_t( 1 ) << sizeClass;
+	}
+
+	// Returns free blocks to the system, largest first, until at most \a maxFreeBytes are left
+	void trim( size_t maxFreeBytes )
+	{
+		for( int sizeClass = NUM_SIZE_CLASSES - 1; sizeClass >= MIN_SIZE_CLASS && mNumFreeBytes > maxFreeBytes; --sizeClass ) {
+			while( mFreeLists[sizeClass] && mNumFreeBytes > maxFreeBytes ) {
+				void *block = mFreeLists[sizeClass];
+				mFreeLists[sizeClass] = *static_cast<void**>( block );
+				std::free( block );
+				mNumBytes -= size_t( 1 ) << sizeClass;
+				mNumFreeBytes -= size_t( 1 ) << sizeClass;
+			}
+		}
+	}
+
+	static int getSizeClass( void *ptr )
+	{
+		return *reinterpret_cast<int*>( static_cast<char*>( ptr ) - HEADER_SIZE );
+	}
+
+	void	*mFreeLists[NUM_SIZE_CLASSES];
+	size_t	mNumBytes;		// all blocks, including those in use
+	size_t	mNumFreeBytes;	// blocks in the free lists
+};
 
 Triangulator::Triangulator( const Path2d &path, float approximationScale )
 {	
@@ -65,20 +165,34 @@ Triangulator::Triangulator()
 
 void Triangulator::allocate()
 {
-	mAllocated = 0;
+	if( ! mMemoryPool )
+		mMemoryPool = make_shared<MemoryPool>();
 	
 	TESSalloc ma;
 	memset( &ma, 0, sizeof(ma) );
-	ma.memalloc = stdAlloc;
-	ma.memfree = stdFree;
-	ma.userData = (void*)&mAllocated;
-	ma.extraVertices = 2560; // realloc not provided, allow 256 extra vertices.
+	ma.memalloc = MemoryPool::alloc;
+	ma.memrealloc = MemoryPool::realloc;
+	ma.memfree = MemoryPool::free;
+	ma.userData = mMemoryPool.get();
+	ma.extraVertices = 256; // the priority queue grows with memrealloc when it needs more
 
 	mTess = shared_ptr<TESStesselator>( tessNewTess( &ma ), tessDeleteTess );
 	if( ! mTess )
 		throw Triangulator::Exception();
 }
 
+void Triangulator::trimMemory( size_t maxBytes )
+{
+	if( mSubdivided.capacity() * sizeof( vec2 ) > maxBytes )
+		vector<vec2>().swap( mSubdivided );
+
+	if( mMemoryPool->mNumBytes > maxBytes ) {
+		// a new tesselator frees the results of the last tesselation, which are usually most of the memory in use
+		allocate();
+		mMemoryPool->trim( maxBytes );
+	}
+}
+
 void Triangulator::addShape( const Shape2d &shape, float approximationScale )
 {
 	size_t numContours = shape.getContours().size();
@@ -89,8 +203,10 @@ void Triangulator::addShape( const Shape2d &shape, float approximationScale )
 
 void Triangulator::addPath( const Path2d &path, float approximationScale )
 {
-	vector<vec2> subdivided = path.subdivide( approximationScale );
-	tessAddContour( mTess.get(), 2, &subdivided[0], sizeof(float) * 2, (int)subdivided.size() );
+	mSubdivided.clear();
+	path.subdivide( &mSubdivided, nullptr, approximationScale );
+	if( ! mSubdivided.empty() )
+		tessAddContour( mTess.get(), 2, mSubdivided.data(), sizeof(float) * 2, (int)mSubdivided.size() );
 }
 
 void Triangulator::addPolyLine( const PolyLine2f &polyLine )
@@ -102,16 +218,23 @@ void Triangulator::addPolyLine( const PolyLine2f &polyLine )
 void Triangulator::addPolyLine( const vec2 *points, size_t numPoints )
 {
 	if( numPoints > 0 )
-		tessAddContour( mTess.get(), 2, &points, sizeof(vec2), (int)numPoints );
+		tessAddContour( mTess.get(), 2, points, sizeof(vec2), (int)numPoints );
+}
+
+bool Triangulator::tesselate( Winding winding )
+{
+	if( tessTesselate( mTess.get(), (int)winding, TESS_POLYGONS, 3, 2, 0 ) )
+		return true;
+
+	// a failed tesselation can leave contours behind, which the next one would include
+	allocate();
+	return false;
 }
 
 TriMesh Triangulator::calcMesh( Winding winding )
 {
 	TriMesh result( TriMesh::Format().positions( 2 ) );
-	
-	tessTesselate( mTess.get(), (int)winding, TESS_POLYGONS, 3, 2, 0 );
-	result.appendPositions( (vec2*)tessGetVertices( mTess.get() ), tessGetVertexCount( mTess.get() ) );
-	result.appendIndices( (uint32_t*)( tessGetElements( mTess.get() ) ), tessGetElementCount( mTess.get() ) * 3 );
+	calcMesh( &result, winding );
 	
 	return result;
 }
@@ -119,12 +242,63 @@ TriMesh Triangulator::calcMesh( Winding winding )
 TriMeshRef Triangulator::createMesh( Winding winding )
 {
 	TriMeshRef result = make_shared<TriMesh>( TriMesh::Format().positions( 2 ) );
-	
-	tessTesselate( mTess.get(), (int)winding, TESS_POLYGONS, 3, 2, 0 );
-	result->appendPositions( (vec2*)tessGetVertices( mTess.get() ), tessGetVertexCount( mTess.get() ) );
-	result->appendIndices( (uint32_t*)( tessGetElements( mTess.get() ) ), tessGetElementCount( mTess.get() ) * 3 );
+	calcMesh( result.get(), winding );
 	
 	return result;
 }
 
+void Triangulator::calcMesh( std::vector<vec2> *positions, std::vector<uint32_t> *indices, Winding winding )
+{
+	if( ! tesselate( winding ) )
+		return;
+
+	const uint32_t firstVertex = (uint32_t)positions->size();
+	const vec2 *vertices = (const vec2*)tessGetVertices( mTess.get() );
+	positions->insert( positions->end(), vertices, vertices + tessGetVertexCount( mTess.get() ) );
+
+	const int *elements = tessGetElements( mTess.get() );
+	const size_t numIndices = tessGetElementCount( mTess.get() ) * 3;
+	indices->reserve( indices->size() + numIndices );
+	for( size_t i = 0; i < numIndices; ++i )
+		indices->push_back( firstVertex + (uint32_t)elements[i] );
+}
+
+void Triangulator::calcMesh( TriMesh *result, Winding winding )
+{
+	if( ! tesselate( winding ) )
+		return;
+
+	const uint32_t firstVertex = (uint32_t)result->getNumVertices();
+	result->appendPositions( (const vec2*)tessGetVertices( mTess.get() ), tessGetVertexCount( mTess.get() ) );
+
+	const int *elements = tessGetElements( mTess.get() );
+	const size_t numIndices = tessGetElementCount( mTess.get() ) * 3;
+	auto &indices = result->getIndices();
+	indices.reserve( indices.size() + numIndices );
+	for( size_t i = 0; i < numIndices; ++i )
+		indices.push_back( firstVertex + (uint32_t)elements[i] );
+}
+
+void Triangulator::calcMeshes( const Shape2d *shapes, size_t count, TriMesh *results, Winding winding, float approximationScale )
+{
+	ip::parallelFor( 0, (int32_t)count, 8, [&]( int32_t taskBegin, int32_t taskEnd ) {
+		static thread_local Triangulator sTriangulator;
+		for( int32_t i = taskBegin; i < taskEnd; ++i ) {
+			results[i].clear();
+			try {
+				sTriangulator.addShape( shapes[i], approximationScale );
+			}
+			catch( ... ) {
+				// don't leave the contours added so far for the next shape on this thread
+				sTriangulator.allocate();
+				throw;
+			}
+			sTriangulator.calcMesh( &results[i], winding );
+		}
+
+		// keep what a large shape needed from staying allocated by this thread for the rest of the process
+		sTriangulator.trimMemory( MAX_THREAD_CACHE_BYTES );
+	} );
+}
+
 } // namespace cinder
@@ -31,6 +31,7 @@
 #include "cinder/ImageTargetFileStbImage.h"
 #include "cinder/ImageSourceFileQoi.h"
 #include "cinder/ImageTargetFileQoi.h"
+#include "cinder/ImageFileRaw.h"
 
 #include "cinder/android/app/CinderNativeActivity.h"
 #include "cinder/android/hardware/Camera.h"
@@ -59,6 +60,8 @@ PlatformAndroid::PlatformAndroid()
 	ImageTargetFileStbImage::registerSelf();
 	ImageSourceFileQoi::registerSelf();
 	ImageTargetFileQoi::registerSelf();
+	ImageSourceFileRaw::registerSelf();
+	ImageTargetFileRaw::registerSelf();
 
 	dbg_app_log( "PlatformAndroid::PlatformAndroid" );
 
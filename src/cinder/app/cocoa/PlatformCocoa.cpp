@@ -32,6 +32,7 @@
 #include "cinder/ImageFileTinyExr.h"
 #include "cinder/ImageSourceFileQoi.h"
 #include "cinder/ImageTargetFileQoi.h"
+#include "cinder/ImageFileRaw.h"
 
 #if defined( CINDER_MAC )
 	#import <Cocoa/Cocoa.h>
@@ -66,6 +67,8 @@ PlatformCocoa::PlatformCocoa()
 	ImageTargetFileTinyExr::registerSelf();
 	ImageSourceFileQoi::registerSelf();
 	ImageTargetFileQoi::registerSelf();
+	ImageSourceFileRaw::registerSelf();
+	ImageTargetFileRaw::registerSelf();
 }
 
 void PlatformCocoa::prepareLaunch()
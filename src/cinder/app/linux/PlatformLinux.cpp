@@ -28,6 +28,7 @@
 #include "cinder/ImageTargetFileStbImage.h"
 #include "cinder/ImageSourceFileQoi.h"
 #include "cinder/ImageTargetFileQoi.h"
+#include "cinder/ImageFileRaw.h"
 #include "cinder/ImageFileTinyExr.h"
 #include "cinder/Utilities.h"
 #include "cinder/Log.h"
@@ -62,6 +63,8 @@ PlatformLinux::PlatformLinux()
 	ImageTargetFileStbImage::registerSelf();
 	ImageSourceFileQoi::registerSelf();
 	ImageTargetFileQoi::registerSelf();
+	ImageSourceFileRaw::registerSelf();
+	ImageTargetFileRaw::registerSelf();
 	ImageSourceFileTinyExr::registerSelf();
 	ImageTargetFileTinyExr::registerSelf();
 }
@@ -34,6 +34,7 @@
 #include "cinder/ImageTargetFileStbImage.h"
 #include "cinder/ImageSourceFileQoi.h"
 #include "cinder/ImageTargetFileQoi.h"
+#include "cinder/ImageFileRaw.h"
 
 #include <windows.h>
 #include <Shlwapi.h>
@@ -77,6 +78,8 @@ PlatformMsw::PlatformMsw()
 	ImageTargetFileStbImage::registerSelf();
 	ImageSourceFileQoi::registerSelf();
 	ImageTargetFileQoi::registerSelf();
+	ImageSourceFileRaw::registerSelf();
+	ImageTargetFileRaw::registerSelf();
 }
 
 DataSourceRef PlatformMsw::loadResource( const fs::path &resourcePath, int mswID, const std::string &mswType )
@@ -23,14 +23,29 @@
 
 #include "cinder/audio/Context.h"
 #include "cinder/audio/InputNode.h"
+#include "cinder/audio/Param.h"
 #include "cinder/audio/Utilities.h"
 #include "cinder/audio/dsp/Converter.h"
 
 #include "cinder/Cinder.h"
+#include "cinder/Log.h"
 #include "cinder/app/AppBase.h"
 
+#include <algorithm>
+#include <condition_variable>
+#include <iterator>
 #include <sstream>
 
+#if defined( CINDER_MSW_DESKTOP )
+	#include "cinder/msw/CinderMsw.h"
+#elif ! defined( CINDER_UWP )
+	#include <pthread.h>
+	#include <sched.h>
+#endif
+#if defined( _M_X64 ) || defined( _M_IX86 ) || defined( __x86_64__ ) || defined( __i386__ )
+	#include <immintrin.h>
+#endif
+
 #if defined( CINDER_COCOA )
 	#include "cinder/audio/cocoa/ContextAudioUnit.h"
 	#if defined( CINDER_MAC )
@@ -58,6 +73,205 @@ using namespace std;
 
 namespace cinder { namespace audio {
 
+// ----------------------------------------------------------------------------------------------------
+// RenderThreadPool
+// ----------------------------------------------------------------------------------------------------
+
+namespace {
+
+// Set on each RenderThreadPool worker so that Context::isAudioThread() also returns true there.
+thread_local const Context *sRenderWorkerContext = nullptr;
+
+// Number of times a wait on the audio thread polls before it starts yielding its time slice.
+const int RENDER_SPIN_COUNT = 4096;
+
+// Tells the CPU that the calling thread is busy waiting.
+inline void cpuPause()
+{
+#if defined( _M_X64 ) || defined( _M_IX86 ) || defined( __x86_64__ ) || defined( __i386__ )
+	_mm_pause();
+#elif defined( __aarch64__ ) || defined( __arm__ )
+	__asm__ __volatile__( "yield" );
+#endif
+}
+
+// Raises the calling thread to the real-time priority that audio threads run at. Without permission to do so, it keeps its priority.
+void raiseRenderWorkerPriority()
+{
+#if defined( CINDER_MSW_DESKTOP )
+	if( ! ::SetThreadPriority( ::GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL ) )
+		CI_LOG_D( "Unable to raise render thread priority, error: " << ::GetLastError() );
+#elif ! defined( CINDER_UWP )
+	sched_param param = {};
+	param.sched_priority = ( sched_get_priority_min( SCHED_FIFO ) + sched_get_priority_max( SCHED_FIFO ) ) / 2;
+	int error = pthread_setschedparam( pthread_self(), SCHED_FIFO, &param );
+	if( error )
+		CI_LOG_D( "Unable to raise render thread priority, error: " << error );
+#endif
+}
+
+} // anonymous namespace
+
+//! Fixed pool of real-time priority threads that run an indexed set of tasks on behalf of the audio thread, which also participates.
+//! Workers sleep between blocks. The calling thread claims tasks itself until none are left, so it only waits for the tasks that
+//! workers are in the middle of, and it never blocks on a lock.
+class RenderThreadPool : private Noncopyable {
+  public:
+	typedef void (*TaskFn)( void *data, size_t index );
+
+	RenderThreadPool( const Context *context, size_t numThreads )
+		: mContext( context ), mTaskFn( nullptr ), mTaskData( nullptr ), mNumTasks( 0 ), mNextTask( 0 ), mNumRemaining( 0 ), mNumActiveWorkers( 0 ),
+			mRunning( false ), mGeneration( 0 ), mQuit( false )
+	{
+		for( size_t i = 0; i < numThreads; i++ )
+			mThreads.emplace_back( &RenderThreadPool::threadEntry, this );
+	}
+
+	~RenderThreadPool()
+	{
+		{
+			lock_guard<mutex> lock( mMutex );
+			mQuit = true;
+		}
+		mCondition.notify_all();
+
+		for( auto &thread : mThreads )
+			thread.join();
+	}
+
+	size_t getNumThreads() const	{ return mThreads.size(); }
+	//! Returns true while run() is executing.
+	bool isRunning() const			{ return mRunning.load( memory_order_acquire ); }
+
+	//! Calls \a fn for each index in [0, numTasks), blocking until all have completed.
+	void run( size_t numTasks, TaskFn fn, void *data )
+	{
+		// workers only read the task once they see mRunning set, so it can be set up without the lock
+		mTaskFn = fn;
+		mTaskData = data;
+		mNumTasks = numTasks;
+		mNextTask = 0;
+		mNumRemaining = numTasks;
+		mRunning.store( true, memory_order_release );
+
+		// a worker holds the lock only while it checks whether to wake up. Rather than waiting for it, this run goes without the workers,
+		// as the calling thread processes whatever tasks they don't claim.
+		if( mMutex.try_lock() ) {
+			mGeneration++;
+			mMutex.unlock();
+			mCondition.notify_all();
+		}
+
+		processTasks();
+		spinUntil( [this] { return mNumRemaining.load( memory_order_acquire ) == 0; } );
+
+		// Workers only stay in a run while mRunning is true, so once it is cleared with no active workers none of them can still be touching the task.
+		mRunning.store( false );
+		spinUntil( [this] { return mNumActiveWorkers.load() == 0; } );
+	}
+
+  private:
+	void threadEntry()
+	{
+		sRenderWorkerContext = mContext;
+		raiseRenderWorkerPriority();
+
+		uint64_t lastGeneration = 0;
+		while( true ) {
+			{
+				unique_lock<mutex> lock( mMutex );
+				mCondition.wait( lock, [&] { return mQuit || mGeneration != lastGeneration; } );
+				if( mQuit )
+					return;
+
+				lastGeneration = mGeneration;
+			}
+
+			// joins before checking mRunning, so that run() either sees this worker as active or this worker sees that the run has ended
+			mNumActiveWorkers++;
+			if( mRunning.load() )
+				processTasks();
+			mNumActiveWorkers--;
+		}
+	}
+
+	//! Waits for \a done to return true, which happens once the tasks that workers are running complete. Polls for a bounded number of
+	//! iterations and then yields the time slice between polls, which only happens if a task takes much longer than expected.
+	template<typename DoneFn>
+	static void spinUntil( const DoneFn &done )
+	{
+		for( int i = 0; ! done(); i++ ) {
+			if( i < RENDER_SPIN_COUNT )
+				cpuPause();
+			else
+				this_thread::yield();
+		}
+	}
+
+	void processTasks()
+	{
+		while( true ) {
+			size_t index = mNextTask.fetch_add( 1 );
+			if( index >= mNumTasks )
+				break;
+
+			mTaskFn( mTaskData, index );
+			mNumRemaining.fetch_sub( 1, memory_order_release );
+		}
+	}
+
+	const Context*				mContext;
+	std::vector<std::thread>	mThreads;
+	std::mutex					mMutex;
+	std::condition_variable		mCondition;
+
+	TaskFn						mTaskFn;
+	void*						mTaskData;
+	size_t						mNumTasks;
+	std::atomic<size_t>			mNextTask, mNumRemaining, mNumActiveWorkers;
+	std::atomic<bool>			mRunning;
+	uint64_t					mGeneration;
+	bool						mQuit;
+};
+
+// ----------------------------------------------------------------------------------------------------
+// Context::Command
+// ----------------------------------------------------------------------------------------------------
+
+namespace {
+
+// Maximum number of commands that can be in flight to the audio thread before producers process them on their own.
+const size_t COMMAND_QUEUE_SIZE = 4096;
+
+} // anonymous namespace
+
+//! Instruction sent from a user thread to the audio thread. Commands are allocated and destroyed on user threads; the audio thread only
+//! links them into its own lists and sets mDone once it will no longer access them.
+struct Context::Command {
+	enum class Type { PARAM_EVENT, PARAM_RESET, SCHEDULE_EVENT, CANCEL_SCHEDULED_EVENTS };
+
+	Command( Type type, const NodeRef &node )
+		: mType( type ), mNode( node ), mParam( nullptr ), mFlag( false ), mValue( 0 ), mEventFrameThreshold( 0 ), mProcessingEvent( false ),
+			mNextScheduledEvent( nullptr ), mDone( false )
+	{}
+
+	Type					mType;
+	NodeRef					mNode;	// keeps the Node, and therefore any of its Param's, alive until the audio thread is done with this Command
+	Param*					mParam;
+	EventRef				mEvent;
+	bool					mFlag;	// replaceEvents for PARAM_EVENT, setValue for PARAM_RESET and callFuncBeforeProcess for SCHEDULE_EVENT
+	float					mValue;
+	uint64_t				mEventFrameThreshold;
+	bool					mProcessingEvent;
+	std::function<void ()>	mFunc;
+	Command*				mNextScheduledEvent;
+	std::atomic<bool>		mDone;
+};
+
+// ----------------------------------------------------------------------------------------------------
+// Context
+// ----------------------------------------------------------------------------------------------------
+
 std::shared_ptr<Context>		Context::sMasterContext;
 std::unique_ptr<DeviceManager>	Context::sDeviceManager;
 
@@ -126,7 +340,8 @@ void Context::setMaster( Context *masterContext, DeviceManager *deviceManager )
 }
 
 Context::Context()
-	: mEnabled( false ), mAutoPullRequired( false ), mAutoPullCacheDirty( false ), mNumProcessedFrames( 0 ), mTimeDuringLastProcessLoop( -1.0 )
+	: mEnabled( false ), mAutoPullRequired( false ), mAutoPullCacheDirty( false ), mNumProcessedFrames( 0 ), mTimeDuringLastProcessLoop( -1.0 ),
+		mCommandQueue( COMMAND_QUEUE_SIZE ), mScheduledEvents( nullptr ), mParallelGraphDirty( true )
 {
 	if( ! sIsRegisteredForCleanup )
 		registerClearStatics();
@@ -163,6 +378,13 @@ void Context::disable()
 	auto output = getOutput();
 	if( output )
 		getOutput()->disable();
+
+	// Nothing consumes the command queue until the Context is enabled again, so process what is left so it doesn't hold on to its Node's.
+	{
+		lock_guard<mutex> lock( mMutex );
+		processCommands();
+	}
+	releaseDoneCommands();
 }
 
 void Context::setEnabled( bool b )
@@ -175,6 +397,9 @@ void Context::setEnabled( bool b )
 
 void Context::connectionsDidChange( const NodeRef & /*node*/ )
 {
+	lock_guard<mutex> lock( mMutex );
+	if( mRenderThreadPool )
+		updateParallelPulledNodes();
 }
 
 void Context::initializeAllNodes()
@@ -221,6 +446,11 @@ void Context::setOutput( const OutputNodeRef &output )
 
 	if( mOutput )
 		initializeAllNodes();
+
+	lock_guard<mutex> lock( mMutex );
+	mParallelGraphDirty = true;
+	if( mRenderThreadPool )
+		updateParallelPulledNodes();
 }
 
 const OutputNodeRef& Context::getOutput()
@@ -282,7 +512,7 @@ void Context::uninitRecursive( const NodeRef &node, set<NodeRef> &traversedNodes
 
 bool Context::isAudioThread() const
 {
-	return mAudioThreadId == std::this_thread::get_id();
+	return mAudioThreadId == std::this_thread::get_id() || sRenderWorkerContext == this;
 }
 
 void Context::preProcess()
@@ -290,6 +520,7 @@ void Context::preProcess()
 	mProcessTimer.start();
 	mAudioThreadId = std::this_thread::get_id();
 
+	processCommands();
 	preProcessScheduledEvents();
 }
 
@@ -358,7 +589,135 @@ const std::vector<Node *>& Context::getAutoPulledNodes()
 }
 
 // ----------------------------------------------------------------------------------------------------
-// Event Scheduling
+// Parallel Rendering
+// ----------------------------------------------------------------------------------------------------
+
+void Context::setNumRenderThreads( size_t numThreads )
+{
+	lock_guard<mutex> lock( mMutex );
+
+	if( getNumRenderThreads() == numThreads )
+		return;
+
+	mRenderThreadPool.reset();
+	if( numThreads > 0 )
+		mRenderThreadPool.reset( new RenderThreadPool( this, numThreads ) );
+
+	updateParallelPulledNodes();
+}
+
+size_t Context::getNumRenderThreads() const
+{
+	return mRenderThreadPool ? mRenderThreadPool->getNumThreads() : 0;
+}
+
+// note: must be called with mMutex locked
+void Context::updateParallelPulledNodes()
+{
+	for( const auto &weakNode : mParallelPulledNodes ) {
+		NodeRef node = weakNode.lock();
+		if( node ) {
+			node->mPullInputsInParallel = false;
+			node->mParallelInputs.clear();
+		}
+	}
+	mParallelPulledNodes.clear();
+
+	if( mRenderThreadPool && mOutput ) {
+		set<Node *> traversedNodes;
+		findParallelPulledNodes( mOutput, traversedNodes );
+	}
+
+	mParallelGraphDirty = false;
+}
+
+// Marks the first Node's along each path from the output whose inputs can be pulled concurrently. Traversal stops at those Node's, as nested parallelism is not supported.
+void Context::findParallelPulledNodes( const NodeRef &node, set<Node *> &traversedNodes )
+{
+	if( ! traversedNodes.insert( node.get() ).second )
+		return;
+
+	const auto &inputs = node->getInputs();
+	if( inputs.size() > 1 && inputsAreIndependent( node ) ) {
+		const size_t framesPerBlock = mOutput->getOutputFramesPerBlock();
+
+		node->mParallelInputs.clear();
+		node->mParallelInputBuffers.resize( inputs.size() );
+		for( const auto &input : inputs ) {
+			node->mParallelInputBuffers[node->mParallelInputs.size()].setSize( framesPerBlock, node->getNumChannels() );
+			node->mParallelInputs.push_back( input.get() );
+		}
+
+		node->mPullInputsInParallel = true;
+		mParallelPulledNodes.push_back( node );
+		return;
+	}
+
+	for( const auto &input : inputs )
+		findParallelPulledNodes( input, traversedNodes );
+}
+
+bool Context::inputsAreIndependent( const NodeRef &node ) const
+{
+	set<Node *> allUpstreamNodes;
+	for( const auto &input : node->getInputs() ) {
+		set<Node *> upstreamNodes;
+		if( ! collectUpstreamNodes( input, upstreamNodes ) )
+			return false;
+
+		for( Node *upstreamNode : upstreamNodes ) {
+			if( ! allUpstreamNodes.insert( upstreamNode ).second )
+				return false; // shared with another input's subgraph
+		}
+	}
+
+	return true;
+}
+
+// Returns false if the subgraph cannot be pulled from another thread, which is currently the case when it is part of a cycle.
+bool Context::collectUpstreamNodes( const NodeRef &node, set<Node *> &upstreamNodes ) const
+{
+	if( ! upstreamNodes.insert( node.get() ).second )
+		return true;
+
+	if( node->supportsCycles() )
+		return false;
+
+	for( const auto &input : node->getInputs() ) {
+		if( ! collectUpstreamNodes( input, upstreamNodes ) )
+			return false;
+	}
+
+	return true;
+}
+
+// note: called from Node::sumInputs() on the audio thread, synchronized with mMutex by the OutputDeviceNode impl
+bool Context::pullInputsInParallel( Node *node )
+{
+	// Fall back to serial pulling if connections changed since the graph was last analyzed, or if we're already within a parallel section.
+	if( mParallelGraphDirty || ! mRenderThreadPool || mRenderThreadPool->isRunning() || mAudioThreadId != this_thread::get_id() )
+		return false;
+
+	// The input buffers are sized when the graph is analyzed and in Node::setupProcessWithSumming(), never here on the audio thread.
+	const size_t framesPerBlock = getFramesPerBlock();
+	for( const auto &buffer : node->mParallelInputBuffers ) {
+		if( buffer.getNumFrames() != framesPerBlock || buffer.getNumChannels() != node->getNumChannels() )
+			return false;
+	}
+
+	mRenderThreadPool->run( node->mParallelInputs.size(), &Context::pullParallelInput, node );
+	return true;
+}
+
+// static
+void Context::pullParallelInput( void *data, size_t inputIndex )
+{
+	Node *node = static_cast<Node *>( data );
+	node->mParallelInputs[inputIndex]->pullInputs( &node->mParallelInputBuffers[inputIndex] );
+}
+
+// ----------------------------------------------------------------------------------------------------
+// Commands and Event Scheduling
 // ----------------------------------------------------------------------------------------------------
 
 void Context::scheduleEvent( double when, const NodeRef &node, bool callFuncBeforeProcess, const std::function<void ()> &func )
@@ -371,29 +730,124 @@ void Context::scheduleEvent( double when, const NodeRef &node, bool callFuncBefo
 		eventFrameThreshold -= framesPerBlock;
 
 	// TODO: support multiple events, at the moment only supporting one per node.
-	if( node->mEventScheduled ) {
+	if( node->mNumEventsScheduled ) {
 		cancelScheduledEvents( node );
 	}
 
-	lock_guard<mutex> lock( mMutex );
-	node->mEventScheduled = true;
-	mScheduledEvents.push_back( ScheduledEvent( eventFrameThreshold, node, callFuncBeforeProcess, func ) );
+	unique_ptr<Command> command( new Command( Command::Type::SCHEDULE_EVENT, node ) );
+	command->mEventFrameThreshold = eventFrameThreshold;
+	command->mFlag = callFuncBeforeProcess;
+	command->mFunc = func;
+
+	node->mNumEventsScheduled++;
+	queueCommand( move( command ) );
 }
 
 void Context::cancelScheduledEvents( const NodeRef &node )
 {
-	lock_guard<mutex> lock( mMutex );
+	queueCommand( unique_ptr<Command>( new Command( Command::Type::CANCEL_SCHEDULED_EVENTS, node ) ) );
+}
 
-	for( auto eventIt = mScheduledEvents.begin(); eventIt != mScheduledEvents.end(); ++eventIt ) {
-		if( eventIt->mNode == node ) {
-			// reset process frame range to an entire block
-			auto &range = eventIt->mNode->mProcessFramesRange;
-			range.first = 0;
-			range.second = getFramesPerBlock();
+void Context::queueParamEvent( Param *param, const EventRef &event, bool replaceEvents )
+{
+	unique_ptr<Command> command( new Command( Command::Type::PARAM_EVENT, param->mParentNode->shared_from_this() ) );
+	command->mParam = param;
+	command->mEvent = event;
+	command->mFlag = replaceEvents;
 
-			eventIt->mNode->mEventScheduled = false;
-			mScheduledEvents.erase( eventIt );
-			break;
+	queueCommand( move( command ) );
+}
+
+void Context::queueParamReset( Param *param, bool setValue, float value )
+{
+	unique_ptr<Command> command( new Command( Command::Type::PARAM_RESET, param->mParentNode->shared_from_this() ) );
+	command->mParam = param;
+	command->mFlag = setValue;
+	command->mValue = value;
+
+	queueCommand( move( command ) );
+}
+
+void Context::queueCommand( unique_ptr<Command> command )
+{
+	releaseDoneCommands();
+
+	// While the Context is disabled there is no audio thread consuming the queue, so commands from user threads are processed right away.
+	const bool processNow = ! mEnabled && ! isAudioThread();
+	{
+		lock_guard<mutex> lock( mCommandsMutex );
+
+		Command *commandPtr = command.get();
+		mCommands.push_back( move( command ) );
+
+		if( processNow || ! mCommandQueue.write( &commandPtr, 1 ) ) {
+			// Take over as the queue's consumer, which also makes room if it is full. Earlier commands are processed first so they stay in order.
+			lock_guard<mutex> contextLock( mMutex );
+			processCommands();
+			CI_VERIFY( mCommandQueue.write( &commandPtr, 1 ) );
+			if( processNow )
+				processCommands();
+		}
+	}
+
+	if( processNow )
+		releaseDoneCommands();
+}
+
+void Context::releaseDoneCommands()
+{
+	// Commands the audio thread is done with are destroyed after mCommandsMutex is released, as they may hold the last reference to a Node.
+	vector<unique_ptr<Command>> doneCommands;
+	lock_guard<mutex> lock( mCommandsMutex );
+
+	auto doneBegin = stable_partition( mCommands.begin(), mCommands.end(), []( const unique_ptr<Command> &c ) { return ! c->mDone; } );
+	move( doneBegin, mCommands.end(), back_inserter( doneCommands ) );
+	mCommands.erase( doneBegin, mCommands.end() );
+}
+
+// note: must be called with mMutex locked, which makes the caller the only consumer of mCommandQueue
+void Context::processCommands()
+{
+	Command *command;
+	while( mCommandQueue.read( &command, 1 ) ) {
+		switch( command->mType ) {
+			case Command::Type::PARAM_EVENT:
+				command->mParam->addEventImpl( command->mEvent.get(), command->mFlag );
+				command->mDone = true;
+				break;
+			case Command::Type::PARAM_RESET:
+				command->mParam->resetEventsImpl();
+				if( command->mFlag )
+					command->mParam->mValue = command->mValue;
+				command->mDone = true;
+				break;
+			case Command::Type::SCHEDULE_EVENT: {
+				// append so that events are processed in the order they were scheduled
+				Command **tail = &mScheduledEvents;
+				while( *tail )
+					tail = &(*tail)->mNextScheduledEvent;
+				*tail = command;
+				break;
+			}
+			case Command::Type::CANCEL_SCHEDULED_EVENTS: {
+				for( Command **eventIt = &mScheduledEvents; *eventIt; /* */ ) {
+					Command *event = *eventIt;
+					if( event->mNode == command->mNode ) {
+						// reset process frame range to an entire block
+						auto &range = event->mNode->mProcessFramesRange;
+						range.first = 0;
+						range.second = getFramesPerBlock();
+
+						*eventIt = event->mNextScheduledEvent;
+						event->mNode->mNumEventsScheduled--;
+						event->mDone = true;
+					}
+					else
+						eventIt = &event->mNextScheduledEvent;
+				}
+				command->mDone = true;
+				break;
+			}
 		}
 	}
 }
@@ -404,17 +858,18 @@ void Context::preProcessScheduledEvents()
 	const uint64_t framesPerBlock = (uint64_t)getFramesPerBlock();
 	const uint64_t numProcessedFrames = mNumProcessedFrames;
 
-	for( auto &event : mScheduledEvents ) {
-		if( numProcessedFrames >= event.mEventFrameThreshold ) {
-			event.mProcessingEvent = true;
-			uint64_t frameOffset = numProcessedFrames - event.mEventFrameThreshold;
-			if( event.mCallFuncBeforeProcess ) {
-				event.mNode->mProcessFramesRange.first = size_t( framesPerBlock - frameOffset );
-				event.mFunc();
+	for( Command *event = mScheduledEvents; event; event = event->mNextScheduledEvent ) {
+		if( numProcessedFrames >= event->mEventFrameThreshold ) {
+			event->mProcessingEvent = true;
+			// events consumed late from the command queue are clamped to the current block
+			uint64_t frameOffset = std::min( numProcessedFrames - event->mEventFrameThreshold, framesPerBlock );
+			if( event->mFlag ) {
+				event->mNode->mProcessFramesRange.first = size_t( framesPerBlock - frameOffset );
+				event->mFunc();
 			}
 			else {
 				// set the process range but don't call its function until postProcess()
-				event.mNode->mProcessFramesRange.second = (size_t)frameOffset;
+				event->mNode->mProcessFramesRange.second = (size_t)frameOffset;
 			}
 		}
 	}
@@ -422,21 +877,23 @@ void Context::preProcessScheduledEvents()
 
 void Context::postProcessScheduledEvents()
 {
-	for( auto eventIt = mScheduledEvents.begin(); eventIt != mScheduledEvents.end(); /* */ ) {
-		if( eventIt->mProcessingEvent ) {
-			if( ! eventIt->mCallFuncBeforeProcess )
-				eventIt->mFunc();
+	for( Command **eventIt = &mScheduledEvents; *eventIt; /* */ ) {
+		Command *event = *eventIt;
+		if( event->mProcessingEvent ) {
+			if( ! event->mFlag )
+				event->mFunc();
 
 			// reset process frame range to an entire block
-			auto &range = eventIt->mNode->mProcessFramesRange;
+			auto &range = event->mNode->mProcessFramesRange;
 			range.first = 0;
 			range.second = getFramesPerBlock();
 
-			eventIt->mNode->mEventScheduled = false;
-			eventIt = mScheduledEvents.erase( eventIt );
+			*eventIt = event->mNextScheduledEvent;
+			event->mNode->mNumEventsScheduled--;
+			event->mDone = true;
 		}
 		else
-			++eventIt;
+			eventIt = &event->mNextScheduledEvent;
 	}
 }
 
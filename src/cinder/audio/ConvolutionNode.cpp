@@ -0,0 +1,641 @@
+/*
+ Copyright (c) 2026, The Cinder Project
+
+ This code is intended to be used with the Cinder C++ library, http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include "cinder/audio/ConvolutionNode.h"
+#include "cinder/audio/Context.h"
+#include "cinder/audio/Exception.h"
+#include "cinder/audio/dsp/Dsp.h"
+#include "cinder/audio/dsp/Fft.h"
+#include "cinder/CinderMath.h"
+
+#include <cmath>
+#include <cstring>
+
+using namespace ci;
+using namespace std;
+
+namespace cinder { namespace audio {
+
+namespace {
+
+const size_t DEFAULT_MAX_PARTITION_SIZE = 8192;
+// how much larger each stage's partitions are than the previous stage's
+const size_t PARTITION_GROWTH = 4;
+
+// Complex multiplies \a a and \a b, adding the result to \a result. The DC and nyquist components are packed into the first real and imaginary values by dsp::Fft.
+void multiplyAccumulate( const BufferSpectral &a, const BufferSpectral &b, BufferSpectral *result )
+{
+	const size_t numBins = a.getNumFrames();
+	const float *aReal = a.getReal();
+	const float *aImag = a.getImag();
+	const float *bReal = b.getReal();
+	const float *bImag = b.getImag();
+	float *resultReal = result->getReal();
+	float *resultImag = result->getImag();
+
+	resultReal[0] += aReal[0] * bReal[0];
+	resultImag[0] += aImag[0] * bImag[0];
+
+	for( size_t k = 1; k < numBins; k++ ) {
+		resultReal[k] += aReal[k] * bReal[k] - aImag[k] * bImag[k];
+		resultImag[k] += aReal[k] * bImag[k] + aImag[k] * bReal[k];
+	}
+}
+
+// Sets bin \a k of \a spectral, which is packed like the output of dsp::Fft's real transforms, so the DC and nyquist components are real values held
+// in the first real and imaginary values.
+inline void setBin( BufferSpectral *spectral, size_t k, float real, float imag )
+{
+	const size_t numBins = spectral->getNumFrames();
+	if( k == 0 )
+		spectral->getReal()[0] = real;
+	else if( k == numBins )
+		spectral->getImag()[0] = real;
+	else {
+		spectral->getReal()[k] = real;
+		spectral->getImag()[k] = imag;
+	}
+}
+
+// Gets bin \a k of \a spectral, which is packed as described in setBin().
+inline void getBin( const BufferSpectral &spectral, size_t k, float *real, float *imag )
+{
+	const size_t numBins = spectral.getNumFrames();
+	if( k == 0 ) {
+		*real = spectral.getReal()[0];
+		*imag = 0;
+	}
+	else if( k == numBins ) {
+		*real = spectral.getImag()[0];
+		*imag = 0;
+	}
+	else {
+		*real = spectral.getReal()[k];
+		*imag = spectral.getImag()[k];
+	}
+}
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------------------------------
+// ConvolutionNode::Stage
+// ----------------------------------------------------------------------------------------------------
+
+// Uniformly partitioned overlap-save convolution of one section of the impulse response, beginning at frame offset.
+//
+// The first stage (offset = 0) has partitions one processing block long and runs its entire convolution each block. Later stages have
+// partitions of N = k blocks and begin at an offset of 2N, which delays their output by one period of k blocks. The input gathered during a
+// period is transformed, multiplied with the impulse response partitions and transformed back over the k blocks of the following period,
+// then output during the period after that.
+//
+// So that no block has to run a whole transform of 2N frames, later stages split each one into steps with the four step FFT algorithm. The
+// 2N frames are viewed as k rows of 2N / k frames (every k'th frame), which are transformed separately. Each column of the transformed rows
+// is then multiplied by twiddle factors and transformed, which results in every k'th bin of the full transform. The inverse transform runs
+// the same steps in reverse order. Each block of a period runs the steps that add up to an equal share of the period's work.
+struct ConvolutionNode::Stage {
+	struct Channel {
+		Buffer						mInput, mPendingInput, mOutput, mNextOutput;
+		BufferSpectral				mAccum;
+		BufferSpectral				mTransposed; // rows or columns of the transform in progress
+		std::vector<BufferSpectral>	mFdl; // frequency domain delay line of past input partitions
+	};
+
+	Stage( const Buffer &impulseResponse, size_t offset, size_t endFrame, size_t partitionSize, size_t framesPerBlock, size_t numChannels );
+
+	void beginBlock();
+	void process( size_t ch, const float *input, float *output );
+	void endBlock();
+	void multiplyAccumulatePartitions( Channel *channel, size_t irChannel, size_t beginPartition, size_t endPartition );
+
+	// Runs steps [beginStep, endStep) of a period's work: the forward row and column transforms, the multiplication with each partition, and the inverse column and row transforms.
+	void processSteps( Channel *channel, size_t irChannel, size_t beginStep, size_t endStep );
+	size_t getNumSteps() const	{ return 2 * ( getNumRowPairs() + getNumColumns() ) + mNumPartitions; }
+	// Rows are transformed two at a time, as the real and imaginary parts of one complex row.
+	size_t getNumRowPairs() const	{ return mBlocksPerPeriod / 2; }
+	// Only the columns up to half of the row length are needed, as the transformed rows of real input are symmetric.
+	size_t getNumColumns() const	{ return mFramesPerBlock + 1; }
+
+	void forwardRows( const float *input, size_t rowPair, BufferSpectral *transposed );
+	void forwardColumn( const BufferSpectral &transposed, size_t column, BufferSpectral *spectral );
+	void inverseColumn( const BufferSpectral &spectral, size_t column, BufferSpectral *transposed );
+	void inverseRows( const BufferSpectral &transposed, size_t rowPair, float *output );
+
+	size_t	mOffset, mPartitionSize, mNumPartitions, mFramesPerBlock, mBlocksPerPeriod;
+	size_t	mBlockIndex, mFdlIndex;
+	bool	mHasPendingInput;
+
+	dsp::Fft										mFft; // the first stage's transforms, or the row transforms of later stages, which are the same size
+	std::unique_ptr<dsp::Fft>						mColumnFft;
+	Buffer											mFftBuffer;
+	BufferSpectral									mRowBuffer, mColumnBuffer;
+	BufferSpectral									mTwiddles; // exp( -2 pi i j / 2N ) for j in [0, N)
+	std::vector<size_t>								mBlockEndSteps; // the step that each block of a period ends at
+	std::vector<std::vector<BufferSpectral>>		mIrSpectra;
+	std::vector<Channel>							mChannels;
+};
+
+ConvolutionNode::Stage::Stage( const Buffer &impulseResponse, size_t offset, size_t endFrame, size_t partitionSize, size_t framesPerBlock, size_t numChannels )
+	: mOffset( offset ), mPartitionSize( partitionSize ), mFramesPerBlock( framesPerBlock ), mBlocksPerPeriod( partitionSize / framesPerBlock ),
+		mBlockIndex( 0 ), mFdlIndex( 0 ), mHasPendingInput( mOffset == 0 ), mFft( framesPerBlock * 2 )
+{
+	mNumPartitions = ( endFrame - offset + partitionSize - 1 ) / partitionSize;
+
+	mChannels.resize( numChannels );
+	for( auto &channel : mChannels ) {
+		channel.mInput = Buffer( partitionSize * 2 );
+		channel.mAccum = BufferSpectral( partitionSize * 2 );
+		channel.mFdl.resize( mNumPartitions, BufferSpectral( partitionSize * 2 ) );
+		if( mOffset != 0 ) {
+			channel.mPendingInput = Buffer( partitionSize * 2 );
+			channel.mOutput = Buffer( partitionSize );
+			channel.mNextOutput = Buffer( partitionSize );
+			channel.mTransposed = BufferSpectral( mBlocksPerPeriod * getNumColumns() * 2 );
+		}
+	}
+
+	mIrSpectra.resize( impulseResponse.getNumChannels() );
+	Buffer partition( partitionSize * 2 );
+	BufferSpectral spectral( partitionSize * 2 );
+
+	if( mOffset == 0 ) {
+		// The gain of a forward transform differs between dsp::Fft implementations, so the impulse response spectra are scaled to cancel it out.
+		mFftBuffer = Buffer( partitionSize * 2 );
+		mFftBuffer.zero();
+		mFftBuffer[0] = 1;
+		mFft.forward( &mFftBuffer, &spectral );
+		const float scale = 1.0f / spectral.getReal()[0];
+
+		for( size_t ch = 0; ch < impulseResponse.getNumChannels(); ch++ ) {
+			const float *irChannel = impulseResponse.getChannel( ch );
+			for( size_t i = 0; i < mNumPartitions; i++ ) {
+				const size_t numFrames = min( partitionSize, endFrame - i * partitionSize );
+
+				partition.zero();
+				memcpy( partition.getData(), irChannel + i * partitionSize, numFrames * sizeof( float ) );
+				mFft.forward( &partition, &spectral );
+				dsp::mul( spectral.getData(), scale, spectral.getData(), spectral.getSize() );
+
+				mIrSpectra[ch].push_back( spectral );
+			}
+		}
+
+		return;
+	}
+
+	mColumnFft.reset( new dsp::Fft( mBlocksPerPeriod ) );
+	mRowBuffer = BufferSpectral( mFft.getSize() * 2 );
+	mColumnBuffer = BufferSpectral( mBlocksPerPeriod * 2 );
+
+	mTwiddles = BufferSpectral( partitionSize * 2 );
+	for( size_t j = 0; j < partitionSize; j++ ) {
+		const double angle = -M_PI * double( j ) / double( partitionSize );
+		mTwiddles.getReal()[j] = float( cos( angle ) );
+		mTwiddles.getImag()[j] = float( sin( angle ) );
+	}
+
+	// The complex transforms are unscaled in the forward direction and scaled by 1 / size in the inverse direction, so the impulse response
+	// spectra are computed with the same steps and need no scaling.
+	BufferSpectral transposed( mBlocksPerPeriod * getNumColumns() * 2 );
+	for( size_t ch = 0; ch < impulseResponse.getNumChannels(); ch++ ) {
+		const float *irChannel = impulseResponse.getChannel( ch );
+		for( size_t i = 0; i < mNumPartitions; i++ ) {
+			const size_t partitionBegin = offset + i * partitionSize;
+			const size_t numFrames = min( partitionSize, endFrame - partitionBegin );
+
+			partition.zero();
+			memcpy( partition.getData(), irChannel + partitionBegin, numFrames * sizeof( float ) );
+			for( size_t rowPair = 0; rowPair < getNumRowPairs(); rowPair++ )
+				forwardRows( partition.getData(), rowPair, &transposed );
+			for( size_t column = 0; column < getNumColumns(); column++ )
+				forwardColumn( transposed, column, &spectral );
+
+			mIrSpectra[ch].push_back( spectral );
+		}
+	}
+
+	// Estimate the cost of each step by its number of floating point operations, and end each block at the step closest to its share of the total.
+	const size_t rowSize = mFft.getSize();
+	const double rowPairCost = 5.0 * rowSize * log2( double( rowSize ) ) + 8.0 * rowSize;
+	const double columnCost = 5.0 * mBlocksPerPeriod * log2( double( mBlocksPerPeriod ) ) + 6.0 * mBlocksPerPeriod;
+	const double partitionCost = 8.0 * partitionSize;
+	auto stepCost = [&]( size_t step ) {
+		if( step < getNumRowPairs() )
+			return rowPairCost;
+		step -= getNumRowPairs();
+		if( step < getNumColumns() )
+			return columnCost;
+		step -= getNumColumns();
+		if( step < mNumPartitions )
+			return partitionCost;
+		step -= mNumPartitions;
+		return step < getNumColumns() ? columnCost : rowPairCost;
+	};
+
+	const size_t numSteps = getNumSteps();
+	double totalCost = 0;
+	for( size_t step = 0; step < numSteps; step++ )
+		totalCost += stepCost( step );
+
+	mBlockEndSteps.resize( mBlocksPerPeriod );
+	size_t step = 0;
+	double cost = 0;
+	for( size_t block = 0; block < mBlocksPerPeriod; block++ ) {
+		const double blockEndCost = totalCost * double( block + 1 ) / double( mBlocksPerPeriod );
+		while( step < numSteps && cost + stepCost( step ) / 2 <= blockEndCost )
+			cost += stepCost( step++ );
+
+		mBlockEndSteps[block] = step;
+	}
+	mBlockEndSteps.back() = numSteps;
+}
+
+void ConvolutionNode::Stage::beginBlock()
+{
+	// a new input partition is transformed into the next slot of the delay lines at the beginning of each period
+	if( mHasPendingInput && mBlockIndex == 0 )
+		mFdlIndex = ( mFdlIndex + 1 ) % mNumPartitions;
+}
+
+void ConvolutionNode::Stage::endBlock()
+{
+	if( mOffset != 0 && ++mBlockIndex == mBlocksPerPeriod ) {
+		mBlockIndex = 0;
+		mHasPendingInput = true;
+	}
+}
+
+void ConvolutionNode::Stage::process( size_t ch, const float *input, float *output )
+{
+	const size_t partitionSize = mPartitionSize;
+	const size_t irChannel = min( ch, mIrSpectra.size() - 1 );
+	Channel &channel = mChannels[ch];
+	float *inputData = channel.mInput.getData();
+
+	if( mOffset == 0 ) {
+		// slide the input window and convolve the entire section within this block
+		memcpy( inputData, inputData + partitionSize, partitionSize * sizeof( float ) );
+		memcpy( inputData + partitionSize, input, partitionSize * sizeof( float ) );
+
+		mFft.forward( &channel.mInput, &channel.mFdl[mFdlIndex] );
+		channel.mAccum.zero();
+		multiplyAccumulatePartitions( &channel, irChannel, 0, mNumPartitions );
+		mFft.inverse( &channel.mAccum, &mFftBuffer );
+
+		dsp::add( output, mFftBuffer.getData() + partitionSize, output, partitionSize );
+		return;
+	}
+
+	const size_t blockIndex = mBlockIndex;
+	const size_t blockOffset = blockIndex * mFramesPerBlock;
+
+	dsp::add( output, channel.mOutput.getData() + blockOffset, output, mFramesPerBlock );
+	memcpy( inputData + partitionSize + blockOffset, input, mFramesPerBlock * sizeof( float ) );
+
+	if( mHasPendingInput )
+		processSteps( &channel, irChannel, blockIndex == 0 ? 0 : mBlockEndSteps[blockIndex - 1], mBlockEndSteps[blockIndex] );
+
+	if( blockIndex == mBlocksPerPeriod - 1 ) {
+		// the period is complete: hand its input window off to be convolved during the next period, and start outputting the previous one's result
+		channel.mPendingInput.copy( channel.mInput );
+		memcpy( inputData, inputData + partitionSize, partitionSize * sizeof( float ) );
+		swap( channel.mOutput, channel.mNextOutput );
+	}
+}
+
+void ConvolutionNode::Stage::processSteps( Channel *channel, size_t irChannel, size_t beginStep, size_t endStep )
+{
+	for( size_t step = beginStep; step < endStep; step++ ) {
+		size_t index = step;
+		if( index < getNumRowPairs() ) {
+			forwardRows( channel->mPendingInput.getData(), index, &channel->mTransposed );
+			continue;
+		}
+
+		index -= getNumRowPairs();
+		if( index < getNumColumns() ) {
+			forwardColumn( channel->mTransposed, index, &channel->mFdl[mFdlIndex] );
+			continue;
+		}
+
+		index -= getNumColumns();
+		if( index < mNumPartitions ) {
+			if( index == 0 )
+				channel->mAccum.zero();
+
+			multiplyAccumulatePartitions( channel, irChannel, index, index + 1 );
+			continue;
+		}
+
+		index -= mNumPartitions;
+		if( index < getNumColumns() ) {
+			inverseColumn( channel->mAccum, index, &channel->mTransposed );
+			continue;
+		}
+
+		index -= getNumColumns();
+		inverseRows( channel->mTransposed, index, channel->mNextOutput.getData() );
+	}
+}
+
+// Transforms rows 2 * rowPair and 2 * rowPair + 1 of \a input, storing their bins [0, rowSize / 2] in \a transposed, by column.
+void ConvolutionNode::Stage::forwardRows( const float *input, size_t rowPair, BufferSpectral *transposed )
+{
+	const size_t numRows = mBlocksPerPeriod;
+	const size_t rowSize = mFft.getSize();
+	const size_t row = rowPair * 2;
+	float *rowReal = mRowBuffer.getReal();
+	float *rowImag = mRowBuffer.getImag();
+
+	for( size_t j = 0; j < rowSize; j++ ) {
+		rowReal[j] = input[j * numRows + row];
+		rowImag[j] = input[j * numRows + row + 1];
+	}
+
+	mFft.forwardComplex( &mRowBuffer, &mRowBuffer );
+
+	// separate the two real rows' transforms: A[k] = ( Z[k] + conj( Z[-k] ) ) / 2 and B[k] = ( Z[k] - conj( Z[-k] ) ) / 2i
+	float *real = transposed->getReal();
+	float *imag = transposed->getImag();
+	for( size_t k = 0; k < getNumColumns(); k++ ) {
+		const size_t mirror = ( rowSize - k ) & ( rowSize - 1 );
+		const float zReal = rowReal[k];
+		const float zImag = rowImag[k];
+		const float mirrorReal = rowReal[mirror];
+		const float mirrorImag = -rowImag[mirror];
+
+		const size_t i = k * numRows + row;
+		real[i] = 0.5f * ( zReal + mirrorReal );
+		imag[i] = 0.5f * ( zImag + mirrorImag );
+		real[i + 1] = 0.5f * ( zImag - mirrorImag );
+		imag[i + 1] = -0.5f * ( zReal - mirrorReal );
+	}
+}
+
+// Completes bins column + rowSize * j of \a spectral from one column of the transformed rows, along with their mirror images.
+void ConvolutionNode::Stage::forwardColumn( const BufferSpectral &transposed, size_t column, BufferSpectral *spectral )
+{
+	const size_t numRows = mBlocksPerPeriod;
+	const size_t rowSize = mFft.getSize();
+	const size_t fftSize = mPartitionSize * 2;
+	const float *real = transposed.getReal() + column * numRows;
+	const float *imag = transposed.getImag() + column * numRows;
+	const float *twiddleReal = mTwiddles.getReal();
+	const float *twiddleImag = mTwiddles.getImag();
+	float *columnReal = mColumnBuffer.getReal();
+	float *columnImag = mColumnBuffer.getImag();
+
+	for( size_t m = 0; m < numRows; m++ ) {
+		const size_t t = m * column;
+		columnReal[m] = real[m] * twiddleReal[t] - imag[m] * twiddleImag[t];
+		columnImag[m] = real[m] * twiddleImag[t] + imag[m] * twiddleReal[t];
+	}
+
+	mColumnFft->forwardComplex( &mColumnBuffer, &mColumnBuffer );
+
+	// bins above nyquist are stored as the conjugate of their mirror image, unless this column also produces that one
+	const bool hasMirror = column != 0 && column != rowSize / 2;
+	for( size_t m = 0; m < numRows; m++ ) {
+		const size_t k = column + m * rowSize;
+		if( k <= mPartitionSize )
+			setBin( spectral, k, columnReal[m], columnImag[m] );
+		else if( hasMirror )
+			setBin( spectral, fftSize - k, columnReal[m], -columnImag[m] );
+	}
+}
+
+// Inverse transforms bins column + rowSize * j of \a spectral and multiplies them by the conjugate twiddle factors, storing them in \a transposed by row.
+void ConvolutionNode::Stage::inverseColumn( const BufferSpectral &spectral, size_t column, BufferSpectral *transposed )
+{
+	const size_t numRows = mBlocksPerPeriod;
+	const size_t rowSize = mFft.getSize();
+	const size_t fftSize = mPartitionSize * 2;
+	const float *twiddleReal = mTwiddles.getReal();
+	const float *twiddleImag = mTwiddles.getImag();
+	float *columnReal = mColumnBuffer.getReal();
+	float *columnImag = mColumnBuffer.getImag();
+
+	for( size_t m = 0; m < numRows; m++ ) {
+		const size_t k = column + m * rowSize;
+		if( k <= mPartitionSize )
+			getBin( spectral, k, &columnReal[m], &columnImag[m] );
+		else {
+			getBin( spectral, fftSize - k, &columnReal[m], &columnImag[m] );
+			columnImag[m] = -columnImag[m];
+		}
+	}
+
+	mColumnFft->inverseComplex( &mColumnBuffer, &mColumnBuffer );
+
+	float *real = transposed->getReal();
+	float *imag = transposed->getImag();
+	for( size_t m = 0; m < numRows; m++ ) {
+		const size_t t = m * column;
+		const size_t i = m * getNumColumns() + column;
+		real[i] = columnReal[m] * twiddleReal[t] + columnImag[m] * twiddleImag[t];
+		imag[i] = columnImag[m] * twiddleReal[t] - columnReal[m] * twiddleImag[t];
+	}
+}
+
+// Inverse transforms rows 2 * rowPair and 2 * rowPair + 1 of \a transposed into the real frames that they interleave with the other rows,
+// writing those in the second half of the transform to \a output.
+void ConvolutionNode::Stage::inverseRows( const BufferSpectral &transposed, size_t rowPair, float *output )
+{
+	const size_t numRows = mBlocksPerPeriod;
+	const size_t rowSize = mFft.getSize();
+	const size_t row = rowPair * 2;
+	const float *aReal = transposed.getReal() + row * getNumColumns();
+	const float *aImag = transposed.getImag() + row * getNumColumns();
+	const float *bReal = aReal + getNumColumns();
+	const float *bImag = aImag + getNumColumns();
+	float *rowReal = mRowBuffer.getReal();
+	float *rowImag = mRowBuffer.getImag();
+
+	// Z[k] = A[k] + i B[k], where the upper half of each row is the conjugate of the lower half
+	for( size_t k = 0; k < getNumColumns(); k++ ) {
+		rowReal[k] = aReal[k] - bImag[k];
+		rowImag[k] = aImag[k] + bReal[k];
+	}
+	for( size_t k = getNumColumns(); k < rowSize; k++ ) {
+		const size_t mirror = rowSize - k;
+		rowReal[k] = aReal[mirror] + bImag[mirror];
+		rowImag[k] = bReal[mirror] - aImag[mirror];
+	}
+
+	mFft.inverseComplex( &mRowBuffer, &mRowBuffer );
+
+	for( size_t j = rowSize / 2; j < rowSize; j++ ) {
+		const size_t i = j * numRows + row - mPartitionSize;
+		output[i] = rowReal[j];
+		output[i + 1] = rowImag[j];
+	}
+}
+
+void ConvolutionNode::Stage::multiplyAccumulatePartitions( Channel *channel, size_t irChannel, size_t beginPartition, size_t endPartition )
+{
+	const auto &irSpectra = mIrSpectra[irChannel];
+	for( size_t i = beginPartition; i < endPartition; i++ ) {
+		size_t fdlIndex = ( mFdlIndex + mNumPartitions - i ) % mNumPartitions;
+		multiplyAccumulate( channel->mFdl[fdlIndex], irSpectra[i], &channel->mAccum );
+	}
+}
+
+// ----------------------------------------------------------------------------------------------------
+// ConvolutionNode
+// ----------------------------------------------------------------------------------------------------
+
+ConvolutionNode::ConvolutionNode( const Format &format )
+	: Node( format ), mMaxPartitionSize( DEFAULT_MAX_PARTITION_SIZE )
+{
+}
+
+ConvolutionNode::ConvolutionNode( const BufferRef &impulseResponse, const Format &format )
+	: Node( format ), mImpulseResponse( impulseResponse ), mMaxPartitionSize( DEFAULT_MAX_PARTITION_SIZE )
+{
+}
+
+ConvolutionNode::~ConvolutionNode()
+{
+}
+
+void ConvolutionNode::setImpulseResponse( const BufferRef &impulseResponse )
+{
+	mImpulseResponse = impulseResponse;
+
+	if( isInitialized() )
+		updateStages();
+}
+
+void ConvolutionNode::loadImpulseResponse( const SourceFileRef &sourceFile )
+{
+	size_t sampleRate = getSampleRate();
+	if( sampleRate == sourceFile->getSampleRate() )
+		setImpulseResponse( sourceFile->loadBuffer() );
+	else {
+		auto sf = sourceFile->cloneWithSampleRate( sampleRate );
+		setImpulseResponse( sf->loadBuffer() );
+	}
+}
+
+void ConvolutionNode::setMaxPartitionSize( size_t frames )
+{
+	if( ! isPowerOf2( frames ) )
+		throw AudioExc( "max partition size must be a power of two" );
+
+	mMaxPartitionSize = frames;
+
+	if( isInitialized() )
+		updateStages();
+}
+
+size_t ConvolutionNode::getNumPartitions() const
+{
+	lock_guard<mutex> lock( getContext()->getMutex() );
+
+	size_t result = 0;
+	for( const auto &stage : mStages )
+		result += stage->mNumPartitions;
+
+	return result;
+}
+
+void ConvolutionNode::initialize()
+{
+	const size_t framesPerBlock = getFramesPerBlock();
+	if( ! isPowerOf2( framesPerBlock ) )
+		throw AudioFormatExc( "ConvolutionNode requires a power of two frames per block" );
+
+	mOutputBuffer.setNumFrames( framesPerBlock );
+	mStages = makeStages();
+}
+
+void ConvolutionNode::uninitialize()
+{
+	mStages.clear();
+}
+
+void ConvolutionNode::updateStages()
+{
+	// the stages are built before locking, and the old ones destroyed after unlocking, so that the audio thread isn't blocked during either
+	auto stages = makeStages();
+
+	lock_guard<mutex> lock( getContext()->getMutex() );
+	mStages.swap( stages );
+}
+
+std::vector<std::unique_ptr<ConvolutionNode::Stage>> ConvolutionNode::makeStages() const
+{
+	std::vector<std::unique_ptr<Stage>> result;
+	if( ! mImpulseResponse || mImpulseResponse->isEmpty() )
+		return result;
+
+	const size_t framesPerBlock = getFramesPerBlock();
+	const size_t numFrames = mImpulseResponse->getNumFrames();
+	const size_t maxPartitionSize = max( mMaxPartitionSize, framesPerBlock );
+
+	// Each stage ends where the next one begins, at twice the next stage's partition size. The last stage covers the remainder of the impulse response.
+	size_t offset = 0;
+	size_t partitionSize = framesPerBlock;
+	while( offset < numFrames ) {
+		size_t nextPartitionSize = min( partitionSize * PARTITION_GROWTH, maxPartitionSize );
+		size_t endFrame = numFrames;
+		if( nextPartitionSize > partitionSize && nextPartitionSize * 2 < numFrames )
+			endFrame = nextPartitionSize * 2;
+
+		result.emplace_back( new Stage( *mImpulseResponse, offset, endFrame, partitionSize, framesPerBlock, getNumChannels() ) );
+
+		offset = endFrame;
+		partitionSize = nextPartitionSize;
+	}
+
+	return result;
+}
+
+void ConvolutionNode::process( Buffer *buffer )
+{
+	if( mStages.empty() ) {
+		buffer->zero();
+		return;
+	}
+
+	const size_t numFrames = buffer->getNumFrames();
+	float *output = mOutputBuffer.getData();
+
+	for( auto &stage : mStages )
+		stage->beginBlock();
+
+	for( size_t ch = 0; ch < buffer->getNumChannels(); ch++ ) {
+		float *channel = buffer->getChannel( ch );
+
+		memset( output, 0, numFrames * sizeof( float ) );
+		for( auto &stage : mStages )
+			stage->process( ch, channel, output );
+
+		memcpy( channel, output, numFrames * sizeof( float ) );
+	}
+
+	for( auto &stage : mStages )
+		stage->endBlock();
+}
+
+} } // namespace cinder::audio
@@ -41,8 +41,9 @@ namespace cinder { namespace audio {
 // ----------------------------------------------------------------------------------------------------
 
 Node::Node( const Format &format )
-	: mInitialized( false ), mEnabled( false ), mEventScheduled( false ), mChannelMode( format.getChannelMode() ),
-		mNumChannels( 1 ), mAutoEnabled( true ), mProcessInPlace( true ), mLastProcessedFrame( numeric_limits<uint64_t>::max() )
+	: mInitialized( false ), mEnabled( false ), mNumEventsScheduled( 0 ), mChannelMode( format.getChannelMode() ),
+		mNumChannels( 1 ), mAutoEnabled( true ), mProcessInPlace( true ), mLastProcessedFrame( numeric_limits<uint64_t>::max() ),
+		mPullInputsInParallel( false )
 {
 	if( format.getChannels() ) {
 		mNumChannels = format.getChannels();
@@ -125,6 +126,7 @@ void Node::connectInput( const NodeRef &input )
 
 	lock_guard<mutex> lock( ctx->getMutex() );
 
+	ctx->mParallelGraphDirty = true;
 	mInputs.insert( input );
 	configureConnections();
 }
@@ -137,6 +139,7 @@ void Node::disconnectInput( const NodeRef &input )
 
 	lock_guard<mutex> lock( ctx->getMutex() );
 
+	ctx->mParallelGraphDirty = true;
 	for( auto inIt = mInputs.begin(); inIt != mInputs.end(); ++inIt ) {
 		if( *inIt == input ) {
 			mInputs.erase( inIt );
@@ -153,6 +156,7 @@ void Node::disconnectOutput( const NodeRef &output )
 
 	lock_guard<mutex> lock( ctx->getMutex() );
 
+	ctx->mParallelGraphDirty = true;
 	for( auto outIt = mOutputs.begin(); outIt != mOutputs.end(); ++outIt ) {
 		if( outIt->lock() == output ) {
 			mOutputs.erase( outIt );
@@ -179,7 +183,7 @@ void Node::enable()
 		initializeImpl();
 
 	// Need to cancel events regardless if node is already enabled as one might be disabling us
-	if( mEventScheduled ) {
+	if( mNumEventsScheduled ) {
 		auto context = getContext();
 		if( context && ! context->isAudioThread() ) {
 			context->cancelScheduledEvents( shared_from_this() );
@@ -196,7 +200,7 @@ void Node::enable()
 void Node::disable()
 {
 	// Need to cancel events regardless if node is already disabled as one might be enabling us
-	if( mEventScheduled ) {
+	if( mNumEventsScheduled ) {
 		auto context = getContext();
 		if( context && ! context->isAudioThread() ) {
 			context->cancelScheduledEvents( shared_from_this() );
@@ -457,12 +461,22 @@ void Node::process( Buffer * /*buffer*/ )
 
 void Node::sumInputs()
 {
-	// Pull all inputs, summing the results from the buffer that input used for processing.
-	// mInternalBuffer is not zero'ed before pulling inputs to allow for feedback.
-	for( auto &input : mInputs ) {
-		input->pullInputs( &mInternalBuffer );
-		const Buffer *processedBuffer = input->getProcessesInPlace() ? &mInternalBuffer : input->getInternalBuffer();
-		dsp::sumBuffers( processedBuffer, &mSummingBuffer );
+	if( mPullInputsInParallel && getContext()->pullInputsInParallel( this ) ) {
+		// Inputs were pulled concurrently into their own buffers, sum them in the same order as below so the results are identical.
+		for( size_t i = 0; i < mParallelInputs.size(); i++ ) {
+			const Node *input = mParallelInputs[i];
+			const Buffer *processedBuffer = input->getProcessesInPlace() ? &mParallelInputBuffers[i] : input->getInternalBuffer();
+			dsp::sumBuffers( processedBuffer, &mSummingBuffer );
+		}
+	}
+	else {
+		// Pull all inputs, summing the results from the buffer that input used for processing.
+		// mInternalBuffer is not zero'ed before pulling inputs to allow for feedback.
+		for( auto &input : mInputs ) {
+			input->pullInputs( &mInternalBuffer );
+			const Buffer *processedBuffer = input->getProcessesInPlace() ? &mInternalBuffer : input->getInternalBuffer();
+			dsp::sumBuffers( processedBuffer, &mSummingBuffer );
+		}
 	}
 
 	// Process the summed results if enabled.
@@ -482,6 +496,8 @@ void Node::setupProcessWithSumming()
 
 	mInternalBuffer.setSize( framesPerBlock, mNumChannels );
 	mSummingBuffer.setSize( framesPerBlock, mNumChannels );
+	for( auto &buffer : mParallelInputBuffers )
+		buffer.setSize( framesPerBlock, mNumChannels );
 }
 
 bool Node::checkCycle( const NodeRef &sourceNode, const NodeRef &destNode ) const
@@ -0,0 +1,160 @@
+/*
+ Copyright (c) 2026, The Cinder Project
+
+ This code is intended to be used with the Cinder C++ library, http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include "cinder/audio/OfflineContext.h"
+#include "cinder/audio/Exception.h"
+#include "cinder/audio/Utilities.h"
+
+using namespace std;
+
+namespace cinder { namespace audio {
+
+// ----------------------------------------------------------------------------------------------------
+// OfflineOutputNode
+// ----------------------------------------------------------------------------------------------------
+
+OfflineOutputNode::OfflineOutputNode( size_t sampleRate, size_t framesPerBlock, const Format &format )
+	: OutputNode( format ), mSampleRate( sampleRate ), mFramesPerBlock( framesPerBlock )
+{
+	if( getChannelMode() != ChannelMode::SPECIFIED ) {
+		setChannelMode( ChannelMode::SPECIFIED );
+		setNumChannels( 2 );
+	}
+}
+
+void OfflineOutputNode::setTargetFile( const TargetFileRef &targetFile )
+{
+	lock_guard<mutex> lock( getContext()->getMutex() );
+	mTargetFile = targetFile;
+}
+
+void OfflineOutputNode::setRenderCallback( const RenderCallback &callback )
+{
+	lock_guard<mutex> lock( getContext()->getMutex() );
+	mRenderCallback = callback;
+}
+
+void OfflineOutputNode::renderBlock( size_t numFrames )
+{
+	auto ctx = getContext();
+	if( ! ctx )
+		return;
+
+	lock_guard<mutex> lock( ctx->getMutex() );
+
+	ctx->preProcess();
+
+	auto internalBuffer = getInternalBuffer();
+	internalBuffer->zero();
+	pullInputs( internalBuffer );
+
+	if( checkNotClipping() )
+		internalBuffer->zero();
+
+	if( mTargetFile )
+		mTargetFile->write( internalBuffer, numFrames );
+	if( mRenderCallback )
+		mRenderCallback( internalBuffer, numFrames );
+
+	ctx->postProcess();
+}
+
+// ----------------------------------------------------------------------------------------------------
+// OfflineContext
+// ----------------------------------------------------------------------------------------------------
+
+OfflineContext::OfflineContext( size_t sampleRate, size_t framesPerBlock, size_t numChannels )
+	: mSampleRate( sampleRate ), mFramesPerBlock( framesPerBlock ), mNumChannels( numChannels ), mOutputSet( false )
+{
+	CI_ASSERT( framesPerBlock > 0 );
+}
+
+OfflineContext::~OfflineContext()
+{
+}
+
+OutputDeviceNodeRef OfflineContext::createOutputDeviceNode( const DeviceRef & /*device*/, const Node::Format & /*format*/ )
+{
+	throw AudioContextExc( "OfflineContext does not support hardware output devices." );
+}
+
+InputDeviceNodeRef OfflineContext::createInputDeviceNode( const DeviceRef & /*device*/, const Node::Format & /*format*/ )
+{
+	throw AudioContextExc( "OfflineContext does not support hardware input devices." );
+}
+
+void OfflineContext::setOutput( const OutputNodeRef &output )
+{
+	mOutputSet = true;
+	Context::setOutput( output );
+}
+
+const OutputNodeRef& OfflineContext::getOutput()
+{
+	// Node's can query the sample rate while the mutex is held, so the default output is stored without going through setOutput().
+	// It is initialized in render(), and connecting Node's to it updates the parallel rendering graph.
+	if( ! mOutputSet ) {
+		mOutputSet = true;
+		setDefaultOutput( makeNode<OfflineOutputNode>( mSampleRate, mFramesPerBlock, Node::Format().channels( mNumChannels ) ) );
+	}
+
+	return Context::getOutput();
+}
+
+OfflineOutputNodeRef OfflineContext::getOfflineOutput()
+{
+	return dynamic_pointer_cast<OfflineOutputNode>( getOutput() );
+}
+
+void OfflineContext::render( size_t numFrames )
+{
+	auto output = getOfflineOutput();
+	if( ! output )
+		throw AudioContextExc( "OfflineContext can only render with an OfflineOutputNode." );
+
+	if( ! output->isInitialized() )
+		initializeNode( output );
+
+	const size_t framesPerBlock = output->getOutputFramesPerBlock();
+	while( numFrames > 0 ) {
+		size_t blockFrames = std::min( numFrames, framesPerBlock );
+		output->renderBlock( blockFrames );
+		numFrames -= blockFrames;
+	}
+
+	// rendering happens on the calling thread, so commands finished while rendering can be destroyed here instead of when the next one is queued
+	releaseDoneCommands();
+}
+
+void OfflineContext::renderSeconds( double seconds )
+{
+	render( timeToFrame( seconds, (double)getSampleRate() ) );
+}
+
+void OfflineContext::renderBlock()
+{
+	render( getFramesPerBlock() );
+}
+
+} } // namespace cinder::audio
@@ -27,6 +27,8 @@
 
 #include "cinder/CinderMath.h"
 
+#include <algorithm>
+
 using namespace std;
 
 namespace cinder { namespace audio {
@@ -60,19 +62,19 @@ void rampOutQuad( float *array, size_t count, double t, double tIncr, float valu
 
 Event::Event( double timeBegin, double timeEnd, float valueBegin, float valueEnd, bool copyValueOnBegin, const RampFn &rampFn )
 	: mTimeBegin( timeBegin ), mTimeEnd( timeEnd ), mDuration( timeEnd - timeBegin ), mCopyValueOnBegin( copyValueOnBegin ),
-		mValueBegin( valueBegin ), mValueEnd( valueEnd ), mRampFn( rampFn ), mIsComplete( false ), mIsCanceled( false ), mTimeCancel( -1 )
+		mValueBegin( valueBegin ), mValueEnd( valueEnd ), mRampFn( rampFn ), mIsComplete( false ), mIsCanceled( false ), mTimeCancel( -1 ),
+		mPrev( nullptr ), mNext( nullptr ), mIsRetired( false )
 {
 }
 
 Param::Param( Node *parentNode, float initialValue )
-	: mParentNode( parentNode ), mValue( initialValue ), mIsVaryingThisBlock( false )
+	: mFirstEvent( nullptr ), mLastEvent( nullptr ), mValue( initialValue ), mIsVaryingThisBlock( false ), mParentNode( parentNode )
 {
 }
 
 void Param::setValue( float value )
 {
-	lock_guard<mutex> lock( getContext()->getMutex() );
-	resetImpl();
+	resetImpl( true, value );
 	mValue = value;
 }
 
@@ -84,19 +86,7 @@ EventRef Param::applyRamp( float valueEnd, double rampSeconds, const Options &op
 	double timeBegin = ( options.getBeginTime() >= 0 ? options.getBeginTime() : ctx->getNumProcessedSeconds() + options.getDelay() );
 	double timeEnd = timeBegin + rampSeconds;
 
-	EventRef event( new Event( timeBegin, timeEnd, mValue, valueEnd, true, options.getRampFn() ) );
-
-	if( ! options.getLabel().empty() )
-		event->mLabel = options.getLabel();
-
-	lock_guard<mutex> lock( ctx->getMutex() );
-
-	removeEventsAt( timeBegin );
-	if( mProcessor )
-		mProcessor.reset();
-
-	mEvents.push_back( event );
-	return event;
+	return addEvent( timeBegin, timeEnd, mValue, valueEnd, true, true, options );
 }
 
 EventRef Param::applyRamp( float valueBegin, float valueEnd, double rampSeconds, const Options &options )
@@ -107,57 +97,29 @@ EventRef Param::applyRamp( float valueBegin, float valueEnd, double rampSeconds,
 	double timeBegin = ( options.getBeginTime() >= 0 ? options.getBeginTime() : ctx->getNumProcessedSeconds() + options.getDelay() );
 	double timeEnd = timeBegin + rampSeconds;
 
-	EventRef event( new Event( timeBegin, timeEnd, valueBegin, valueEnd, false, options.getRampFn() ) );
-
-	if( ! options.getLabel().empty() )
-		event->mLabel = options.getLabel();
-
-	lock_guard<mutex> lock( ctx->getMutex() );
-
-	removeEventsAt( timeBegin );
-	if( mProcessor )
-		mProcessor.reset();
-
-	mEvents.push_back( event );
-	return event;
+	return addEvent( timeBegin, timeEnd, valueBegin, valueEnd, false, true, options );
 }
 
 EventRef Param::appendRamp( float valueEnd, double rampSeconds, const Options &options )
 {
 	initInternalBuffer();
 
-	auto ctx = getContext();
 	auto endTimeAndValue = findEndTimeAndValue();
 	double timeBegin = ( options.getBeginTime() >= 0 ? options.getBeginTime() : endTimeAndValue.first + options.getDelay() );
 	double timeEnd = timeBegin + rampSeconds;
 
-	EventRef event( new Event( timeBegin, timeEnd, endTimeAndValue.second, valueEnd, true, options.getRampFn() ) );
-
-	if( ! options.getLabel().empty() )
-		event->mLabel = options.getLabel();
-
-	lock_guard<mutex> lock( ctx->getMutex() );
-	mEvents.push_back( event );
-	return event;
+	return addEvent( timeBegin, timeEnd, endTimeAndValue.second, valueEnd, true, false, options );
 }
 
 EventRef Param::appendRamp( float valueBegin, float valueEnd, double rampSeconds, const Options &options )
 {
 	initInternalBuffer();
 
-	auto ctx = getContext();
 	auto endTimeAndValue = findEndTimeAndValue();
 	double timeBegin = ( options.getBeginTime() >= 0 ? options.getBeginTime() : endTimeAndValue.first + options.getDelay() );
 	double timeEnd = timeBegin + rampSeconds;
 
-	EventRef event( new Event( timeBegin, timeEnd, valueBegin, valueEnd, false, options.getRampFn() ) );
-
-	if( ! options.getLabel().empty() )
-		event->mLabel = options.getLabel();
-
-	lock_guard<mutex> lock( ctx->getMutex() );
-	mEvents.push_back( event );
-	return event;
+	return addEvent( timeBegin, timeEnd, valueBegin, valueEnd, false, false, options );
 }
 
 void Param::setProcessor( const NodeRef &node )
@@ -167,9 +129,12 @@ void Param::setProcessor( const NodeRef &node )
 
 	initInternalBuffer();
 
-	lock_guard<mutex> lock( getContext()->getMutex() );
+	auto ctx = getContext();
+	lock_guard<mutex> lock( ctx->getMutex() );
 
-	resetImpl();
+	// apply any queued commands first so that Event's scheduled before this call don't outlive the processor being set.
+	ctx->processCommands();
+	resetEventsImpl();
 
 	// force node to be mono and initialize it
 	node->setNumChannels( 1 );
@@ -181,41 +146,47 @@ void Param::setProcessor( const NodeRef &node )
 
 void Param::reset()
 {
-	lock_guard<mutex> lock( getContext()->getMutex() );
-	resetImpl();
+	resetImpl( false, 0 );
 }
 
-
 size_t Param::getNumEvents() const
 {
-	lock_guard<mutex> lock( getContext()->getMutex() );
-	return mEvents.size();
+	lock_guard<mutex> lock( mScheduledEventsMutex );
+
+	// Event's canceled by reset() or a replacing ramp no longer count, even though the audio thread may not have retired them yet.
+	size_t result = 0;
+	for( const auto &event : mScheduledEvents ) {
+		if( ! event->mIsRetired && ! event->mIsCanceled )
+			result++;
+	}
+
+	return result;
 }
 
 float Param::findDuration() const
 {
 	auto ctx = getContext();
-	lock_guard<mutex> lock( ctx->getMutex() );
+	lock_guard<mutex> lock( mScheduledEventsMutex );
 
-	if( mEvents.empty() )
-		return 0;
-	else {
-		const EventRef &event = mEvents.back();
-		return static_cast<float>(event->mTimeEnd - ctx->getNumProcessedSeconds());
+	for( auto eventIt = mScheduledEvents.rbegin(); eventIt != mScheduledEvents.rend(); ++eventIt ) {
+		if( ! (*eventIt)->mIsRetired && ! (*eventIt)->mIsCanceled )
+			return static_cast<float>( (*eventIt)->mTimeEnd - ctx->getNumProcessedSeconds() );
 	}
+
+	return 0;
 }
 
 pair<double, float> Param::findEndTimeAndValue() const
 {
 	auto ctx = getContext();
-	lock_guard<mutex> lock( ctx->getMutex() );
+	lock_guard<mutex> lock( mScheduledEventsMutex );
 
-	if( mEvents.empty() )
-		return make_pair( ctx->getNumProcessedSeconds(), mValue.load() );
-	else {
-		const EventRef &event = mEvents.back();
-		return make_pair( event->mTimeEnd, event->mValueEnd );
+	for( auto eventIt = mScheduledEvents.rbegin(); eventIt != mScheduledEvents.rend(); ++eventIt ) {
+		if( ! (*eventIt)->mIsRetired && ! (*eventIt)->mIsCanceled )
+			return make_pair( (*eventIt)->mTimeEnd, (*eventIt)->mValueEnd );
 	}
+
+	return make_pair( ctx->getNumProcessedSeconds(), mValue.load() );
 }
 
 const float* Param::getValueArray()
@@ -248,17 +219,17 @@ bool Param::eval( double timeBegin, float *array, size_t arrayLength, size_t sam
 	const double secondsPerBlock = (double)arrayLength * samplePeriod;
 	size_t samplesWritten = 0;
 
-	for( auto eventIt = mEvents.begin(); eventIt != mEvents.end(); /* */ ) {
-		Event &event = **eventIt;
+	for( Event *eventIt = mFirstEvent; eventIt; /* */ ) {
+		Event &event = *eventIt;
 
 		// first remove dead events
 		const bool cancelled = event.mIsCanceled;
 		if( event.mTimeEnd <= timeBegin || cancelled ) {
 			// if we skipped over the last event, record its end value before erasing.
-			if( mEvents.size() == 1 && ! cancelled )
+			if( mFirstEvent == mLastEvent && ! cancelled )
 				mValue = event.mValueEnd;
 
-			eventIt = mEvents.erase( eventIt );
+			eventIt = eraseEvent( eventIt );
 			continue;
 		}
 
@@ -284,7 +255,7 @@ bool Param::eval( double timeBegin, float *array, size_t arrayLength, size_t sam
 				if( event.mTimeCancel < timeBegin ) {
 					// event should already be over
 					event.cancel();
-					eventIt = mEvents.erase( eventIt );
+					eventIt = eraseEvent( eventIt );
 					continue;
 				}
 
@@ -305,7 +276,7 @@ bool Param::eval( double timeBegin, float *array, size_t arrayLength, size_t sam
 			if( endIndex < arrayLength ) {
 				event.mIsComplete = true;
 				mValue = event.mValueEnd;
-				eventIt = mEvents.erase( eventIt );
+				eventIt = eraseEvent( eventIt );
 			}
 			else if( samplesWritten == arrayLength ) {
 				// the array was filled, store the last calculated samples in mValue and finish evaluating
@@ -313,10 +284,10 @@ bool Param::eval( double timeBegin, float *array, size_t arrayLength, size_t sam
 				break;
 			}
 			else
-				++eventIt;
+				eventIt = eventIt->mNext;
 		}
 		else
-			++eventIt;
+			eventIt = eventIt->mNext;
 	}
 
 	if( ! samplesWritten )
@@ -331,27 +302,103 @@ bool Param::eval( double timeBegin, float *array, size_t arrayLength, size_t sam
 // Protected
 // ----------------------------------------------------------------------------------------------------
 
-void Param::resetImpl()
+EventRef Param::addEvent( double timeBegin, double timeEnd, float valueBegin, float valueEnd, bool copyValueOnBegin, bool replaceEvents, const Options &options )
 {
-	if( ! mEvents.empty() ) {
-		for( auto &event : mEvents )
-			event->cancel();
+	EventRef event( new Event( timeBegin, timeEnd, valueBegin, valueEnd, copyValueOnBegin, options.getRampFn() ) );
+
+	if( ! options.getLabel().empty() )
+		event->mLabel = options.getLabel();
+
+	auto ctx = getContext();
+	if( mProcessor ) {
+		lock_guard<mutex> lock( ctx->getMutex() );
+		mProcessor.reset();
+	}
+
+	{
+		lock_guard<mutex> lock( mScheduledEventsMutex );
+		removeRetiredEvents();
+		mScheduledEvents.push_back( event );
+	}
+
+	ctx->queueParamEvent( this, event, replaceEvents );
+	return event;
+}
+
+void Param::resetImpl( bool setValue, float value )
+{
+	auto ctx = getContext();
+	if( mProcessor ) {
+		lock_guard<mutex> lock( ctx->getMutex() );
+		mProcessor.reset();
+	}
 
-		mEvents.clear();
+	{
+		lock_guard<mutex> lock( mScheduledEventsMutex );
+		removeRetiredEvents();
+		for( auto &event : mScheduledEvents )
+			event->cancel();
 	}
 
-	mProcessor.reset();
+	ctx->queueParamReset( this, setValue, value );
+}
+
+// note: must be called with mScheduledEventsMutex locked
+void Param::removeRetiredEvents()
+{
+	mScheduledEvents.erase( remove_if( mScheduledEvents.begin(), mScheduledEvents.end(), []( const EventRef &event ) { return event->mIsRetired.load(); } ), mScheduledEvents.end() );
+}
+
+void Param::addEventImpl( Event *event, bool replaceEvents )
+{
+	if( replaceEvents )
+		removeEventsAt( event->mTimeBegin );
+
+	event->mPrev = mLastEvent;
+	event->mNext = nullptr;
+	if( mLastEvent )
+		mLastEvent->mNext = event;
+	else
+		mFirstEvent = event;
+
+	mLastEvent = event;
+}
+
+Event* Param::eraseEvent( Event *event )
+{
+	Event *next = event->mNext;
+	if( event->mPrev )
+		event->mPrev->mNext = next;
+	else
+		mFirstEvent = next;
+
+	if( next )
+		next->mPrev = event->mPrev;
+	else
+		mLastEvent = event->mPrev;
+
+	event->mPrev = event->mNext = nullptr;
+	event->mIsRetired = true;
+	return next;
+}
+
+void Param::resetEventsImpl()
+{
+	for( Event *event = mFirstEvent; event; /* */ ) {
+		event->cancel();
+		event = eraseEvent( event );
+	}
 }
 
 void Param::removeEventsAt( double time )
 {
 	auto context = mParentNode->getContext();
 	bool contextDisabled = ! context || ! context->isEnabled();
-	for( auto eventIt = mEvents.begin(); eventIt != mEvents.end(); /* */ ) {
-		Event &event = **eventIt;
+	for( Event *eventIt = mFirstEvent; eventIt; /* */ ) {
+		Event &event = *eventIt;
 		if( event.getTimeBegin() >= time ) {
 			if( contextDisabled ) {
-				eventIt = mEvents.erase( eventIt );
+				eventIt = eraseEvent( eventIt );
 				continue;
 			}
 			else {
@@ -366,7 +413,7 @@ void Param::removeEventsAt( double time )
 			else
 				event.mTimeCancel = time;
 		}
-		++eventIt;
+		eventIt = eventIt->mNext;
 	}
 }
 
@@ -0,0 +1,313 @@
+/*
+ Copyright (c) 2026, The Cinder Project
+
+ This code is intended to be used with the Cinder C++ library, http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include "cinder/audio/SampleCache.h"
+#include "cinder/audio/Source.h"
+#include "cinder/MemoryMappedFile.h"
+#include "cinder/Log.h"
+
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+
+using namespace ci;
+using namespace std;
+
+namespace cinder { namespace audio {
+
+namespace {
+
+const uint32_t	CACHE_FILE_MAGIC			= 0x43534943; // 'CISC'
+const uint32_t	CACHE_FILE_VERSION			= 1;
+const size_t	CACHE_FILE_DATA_ALIGNMENT	= 64;
+
+// Cache files consist of this header, followed by the source file's native path, then padding up to the planar float sample data.
+struct CacheFileHeader {
+	uint32_t	mMagic, mVersion;
+	uint64_t	mSourceFileSize;
+	int64_t		mSourceWriteTime;
+	uint64_t	mSampleRate, mNumChannels, mNumFrames;
+	uint64_t	mFilePathBytes;
+};
+
+bool getSourceFileInfo( const fs::path &filePath, uint64_t *size, int64_t *writeTime )
+{
+	error_code ec;
+	*size = fs::file_size( filePath, ec );
+	if( ec )
+		return false;
+
+	auto time = fs::last_write_time( filePath, ec );
+	if( ec )
+		return false;
+
+	*writeTime = time.time_since_epoch().count();
+	return true;
+}
+
+size_t getDataOffset( size_t filePathBytes )
+{
+	size_t offset = sizeof( CacheFileHeader ) + filePathBytes;
+	return ( offset + CACHE_FILE_DATA_ALIGNMENT - 1 ) / CACHE_FILE_DATA_ALIGNMENT * CACHE_FILE_DATA_ALIGNMENT;
+}
+
+fs::path getCachePath( const fs::path &directory, const fs::path &filePath, size_t sampleRate )
+{
+	// the path is hashed to keep file names short, collisions are caught by the path stored in the file's header
+	uint64_t hash = std::hash<fs::path::string_type>()( filePath.native() );
+
+	ostringstream name;
+	name << hex << setw( 16 ) << setfill( '0' ) << hash << dec << "_" << sampleRate << ".samples";
+	return directory / name.str();
+}
+
+BufferRef loadFromDiskCache( const fs::path &cachePath, const fs::path &filePath, size_t sampleRate, uint64_t sourceFileSize, int64_t sourceWriteTime )
+{
+	error_code ec;
+	if( ! fs::exists( cachePath, ec ) )
+		return BufferRef();
+
+	MemoryMappedFileRef file;
+	try {
+		file = MemoryMappedFile::create( cachePath );
+	}
+	catch( MemoryMappedFileExc &exc ) {
+		CI_LOG_W( "failed to map sample cache file: " << exc.what() );
+		return BufferRef();
+	}
+
+	if( file->getSize() < sizeof( CacheFileHeader ) )
+		return BufferRef();
+
+	const char *data = static_cast<const char *>( file->getData() );
+
+	CacheFileHeader header;
+	memcpy( &header, data, sizeof( header ) );
+
+	const auto &filePathNative = filePath.native();
+	size_t filePathBytes = filePathNative.size() * sizeof( fs::path::value_type );
+	if( header.mMagic != CACHE_FILE_MAGIC || header.mVersion != CACHE_FILE_VERSION || header.mSourceFileSize != sourceFileSize || header.mSourceWriteTime != sourceWriteTime
+		|| header.mSampleRate != sampleRate || header.mFilePathBytes != filePathBytes )
+		return BufferRef();
+
+	size_t dataOffset = getDataOffset( filePathBytes );
+	size_t numSamples = size_t( header.mNumChannels * header.mNumFrames );
+	if( file->getSize() != dataOffset + numSamples * sizeof( float ) || memcmp( data + sizeof( header ), filePathNative.data(), filePathBytes ) != 0 )
+		return BufferRef();
+
+	auto result = make_shared<Buffer>( size_t( header.mNumFrames ), size_t( header.mNumChannels ) );
+	memcpy( result->getData(), data + dataOffset, numSamples * sizeof( float ) );
+	return result;
+}
+
+void writeToDiskCache( const Buffer &buffer, const fs::path &cachePath, const fs::path &filePath, size_t sampleRate, uint64_t sourceFileSize, int64_t sourceWriteTime )
+{
+	const auto &filePathNative = filePath.native();
+
+	CacheFileHeader header;
+	header.mMagic = CACHE_FILE_MAGIC;
+	header.mVersion = CACHE_FILE_VERSION;
+	header.mSourceFileSize = sourceFileSize;
+	header.mSourceWriteTime = sourceWriteTime;
+	header.mSampleRate = sampleRate;
+	header.mNumChannels = buffer.getNumChannels();
+	header.mNumFrames = buffer.getNumFrames();
+	header.mFilePathBytes = filePathNative.size() * sizeof( fs::path::value_type );
+
+	// written to a uniquely named temporary file and then renamed, so that other processes never map a partially written cache file
+	fs::path tempPath = cachePath;
+	tempPath += "." + to_string( random_device()() ) + ".tmp";
+
+	ofstream stream( tempPath, ios::binary );
+	vector<char> padding( getDataOffset( size_t( header.mFilePathBytes ) ) - sizeof( header ) - size_t( header.mFilePathBytes ), 0 );
+	stream.write( reinterpret_cast<const char *>( &header ), sizeof( header ) );
+	stream.write( reinterpret_cast<const char *>( filePathNative.data() ), header.mFilePathBytes );
+	stream.write( padding.data(), padding.size() );
+	stream.write( reinterpret_cast<const char *>( buffer.getData() ), buffer.getSize() * sizeof( float ) );
+	stream.close();
+
+	error_code ec;
+	if( ! stream ) {
+		CI_LOG_W( "failed to write sample cache file: " << tempPath );
+		fs::remove( tempPath, ec );
+		return;
+	}
+
+	fs::rename( tempPath, cachePath, ec );
+	if( ec ) {
+		CI_LOG_W( "failed to rename sample cache file to: " << cachePath << ", error: " << ec.message() );
+		fs::remove( tempPath, ec );
+	}
+}
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------------------------------
+// SampleCache
+// ----------------------------------------------------------------------------------------------------
+
+SampleCache* SampleCache::get()
+{
+	static SampleCache sInstance;
+	return &sInstance;
+}
+
+SampleCache::SampleCache()
+	: mMemoryBudget( 512 * 1024 * 1024 ), mMemoryUsage( 0 )
+{
+}
+
+BufferRef SampleCache::load( const DataSourceRef &dataSource, size_t sampleRate )
+{
+	if( ! dataSource->isFilePath() )
+		return audio::load( dataSource, sampleRate )->loadBuffer();
+
+	error_code ec;
+	fs::path filePath = fs::absolute( dataSource->getFilePath(), ec ).lexically_normal();
+	if( ec )
+		filePath = dataSource->getFilePath();
+
+	Key key = { filePath, sampleRate };
+	fs::path diskCacheDirectory;
+	{
+		lock_guard<mutex> lock( mMutex );
+		auto entryIt = mEntryMap.find( key );
+		if( entryIt != mEntryMap.end() ) {
+			mEntries.splice( mEntries.begin(), mEntries, entryIt->second );
+			return entryIt->second->mBuffer;
+		}
+
+		diskCacheDirectory = mDiskCacheDirectory;
+	}
+
+	// Decoding happens without holding mMutex so that loading other samples isn't blocked.
+	uint64_t sourceFileSize = 0;
+	int64_t sourceWriteTime = 0;
+	bool useDiskCache = ! diskCacheDirectory.empty() && getSourceFileInfo( filePath, &sourceFileSize, &sourceWriteTime );
+
+	BufferRef buffer;
+	fs::path cachePath;
+	if( useDiskCache ) {
+		cachePath = getCachePath( diskCacheDirectory, filePath, sampleRate );
+		buffer = loadFromDiskCache( cachePath, filePath, sampleRate, sourceFileSize, sourceWriteTime );
+	}
+
+	if( ! buffer ) {
+		buffer = audio::load( dataSource, sampleRate )->loadBuffer();
+		if( useDiskCache )
+			writeToDiskCache( *buffer, cachePath, filePath, sampleRate, sourceFileSize, sourceWriteTime );
+	}
+
+	lock_guard<mutex> lock( mMutex );
+
+	// another thread may have loaded the same sample in the meantime, in which case that Buffer is shared instead
+	auto entryIt = mEntryMap.find( key );
+	if( entryIt != mEntryMap.end() ) {
+		mEntries.splice( mEntries.begin(), mEntries, entryIt->second );
+		return entryIt->second->mBuffer;
+	}
+
+	insertLocked( key, buffer );
+	evictLocked();
+	return buffer;
+}
+
+void SampleCache::setMemoryBudget( size_t bytes )
+{
+	lock_guard<mutex> lock( mMutex );
+	mMemoryBudget = bytes;
+	evictLocked();
+}
+
+size_t SampleCache::getMemoryBudget() const
+{
+	lock_guard<mutex> lock( mMutex );
+	return mMemoryBudget;
+}
+
+size_t SampleCache::getMemoryUsage() const
+{
+	lock_guard<mutex> lock( mMutex );
+	return mMemoryUsage;
+}
+
+size_t SampleCache::getNumBuffers() const
+{
+	lock_guard<mutex> lock( mMutex );
+	return mEntries.size();
+}
+
+void SampleCache::setDiskCacheDirectory( const fs::path &directory )
+{
+	if( ! directory.empty() ) {
+		error_code ec;
+		fs::create_directories( directory, ec );
+		if( ec )
+			CI_LOG_W( "failed to create sample cache directory: " << directory << ", error: " << ec.message() );
+	}
+
+	lock_guard<mutex> lock( mMutex );
+	mDiskCacheDirectory = directory;
+}
+
+fs::path SampleCache::getDiskCacheDirectory() const
+{
+	lock_guard<mutex> lock( mMutex );
+	return mDiskCacheDirectory;
+}
+
+void SampleCache::clear()
+{
+	lock_guard<mutex> lock( mMutex );
+	mEntries.clear();
+	mEntryMap.clear();
+	mMemoryUsage = 0;
+}
+
+void SampleCache::insertLocked( const Key &key, const BufferRef &buffer )
+{
+	size_t numBytes = buffer->getSize() * sizeof( float );
+	mEntries.push_front( Entry{ key, buffer, numBytes } );
+	mEntryMap[key] = mEntries.begin();
+	mMemoryUsage += numBytes;
+}
+
+void SampleCache::evictLocked()
+{
+	auto entryIt = mEntries.end();
+	while( mMemoryUsage > mMemoryBudget && entryIt != mEntries.begin() ) {
+		--entryIt;
+
+		// releasing a Buffer that is still in use elsewhere wouldn't free anything
+		if( entryIt->mBuffer.use_count() > 1 )
+			continue;
+
+		mMemoryUsage -= entryIt->mNumBytes;
+		mEntryMap.erase( entryIt->mKey );
+		entryIt = mEntries.erase( entryIt );
+	}
+}
+
+} } // namespace cinder::audio
@@ -23,8 +23,14 @@
 
 #include "cinder/audio/SamplePlayerNode.h"
 #include "cinder/audio/Context.h"
+#include "cinder/audio/SampleCache.h"
 #include "cinder/CinderMath.h"
 
+#include <algorithm>
+#include <condition_variable>
+#include <limits>
+#include <thread>
+
 using namespace ci;
 using namespace std;
 
@@ -179,6 +185,11 @@ void BufferPlayerNode::loadBuffer( const SourceFileRef &sourceFile )
 	}
 }
 
+void BufferPlayerNode::loadBufferCached( const DataSourceRef &dataSource )
+{
+	setBuffer( SampleCache::get()->load( dataSource, getSampleRate() ) );
+}
+
 void BufferPlayerNode::process( Buffer *buffer )
 {
 	const auto &frameRange = getProcessFramesRange();
@@ -212,18 +223,207 @@ void BufferPlayerNode::process( Buffer *buffer )
 		mReadPos += readCount;
 }
 
+// ----------------------------------------------------------------------------------------------------
+// FileReadScheduler
+// ----------------------------------------------------------------------------------------------------
+
+//! Pool of reader threads shared by all asynchronous FilePlayerNode's. Players post read requests from the audio thread without locking,
+//! and each free reader thread picks the requesting player whose ring buffers are the least full.
+class FileReadScheduler : private Noncopyable {
+  public:
+	//! Returns the shared instance, creating it if necessary. It is destroyed when the last player releases it.
+	static shared_ptr<FileReadScheduler> get();
+	static void		setNumThreadsShared( size_t numThreads );
+	static size_t	getNumThreadsShared();
+
+	FileReadScheduler( size_t numThreads )
+		: mNumRequests( 0 ), mQuit( false )
+	{
+		startThreads( numThreads );
+	}
+
+	~FileReadScheduler()
+	{
+		stopThreads();
+	}
+
+	void setNumThreads( size_t numThreads )
+	{
+		stopThreads();
+		startThreads( numThreads );
+	}
+
+	void addPlayer( FilePlayerNode *player )
+	{
+		lock_guard<mutex> lock( mMutex );
+		player->mReadInProgress = false;
+		mPlayers.push_back( player );
+	}
+
+	//! Removes \a player, blocking until any read currently in progress on it has finished.
+	void removePlayer( FilePlayerNode *player )
+	{
+		unique_lock<mutex> lock( mMutex );
+		mPlayers.erase( remove( mPlayers.begin(), mPlayers.end(), player ), mPlayers.end() );
+		mReadFinishedCond.wait( lock, [player] { return ! player->mReadInProgress; } );
+	}
+
+	//! Safe to call from the audio thread, as it doesn't take mMutex.
+	void requestRead( FilePlayerNode *player )
+	{
+		player->mReadRequested.store( true, memory_order_release );
+		wakeThreads( false );
+	}
+
+  private:
+	struct Shared {
+		mutex						mMutex;
+		weak_ptr<FileReadScheduler>	mScheduler;
+		size_t						mNumThreads = 2;
+	};
+
+	static Shared& getShared()
+	{
+		static Shared sShared;
+		return sShared;
+	}
+
+	void startThreads( size_t numThreads )
+	{
+		mQuit = false;
+		for( size_t i = 0; i < numThreads; i++ )
+			mThreads.emplace_back( &FileReadScheduler::threadEntry, this );
+	}
+
+	void stopThreads()
+	{
+		{
+			lock_guard<mutex> lock( mMutex );
+			mQuit = true;
+		}
+		wakeThreads( true );
+
+		for( auto &thread : mThreads )
+			thread.join();
+
+		mThreads.clear();
+	}
+
+	// Readers sleep on mNumRequests rather than a condition variable, as the audio thread can't take mMutex and its notify could otherwise
+	// arrive between a reader finding no requests and going to sleep. Any request made after a reader loads the count changes it, so wait() returns.
+	void wakeThreads( bool all )
+	{
+		mNumRequests.fetch_add( 1, memory_order_release );
+		if( all )
+			mNumRequests.notify_all();
+		else
+			mNumRequests.notify_one();
+	}
+
+	void threadEntry()
+	{
+		unique_lock<mutex> lock( mMutex );
+		while( ! mQuit ) {
+			const uint32_t numRequests = mNumRequests.load( memory_order_acquire );
+			FilePlayerNode *player = acquireNextPlayer();
+			if( ! player ) {
+				lock.unlock();
+				mNumRequests.wait( numRequests, memory_order_acquire );
+				lock.lock();
+				continue;
+			}
+
+			lock.unlock();
+			bool needsMore = player->readAsyncImpl();
+			lock.lock();
+
+			// re-queue players that still have room, so that large read-ahead buffers are filled one chunk at a time in order of priority
+			if( needsMore )
+				player->mReadRequested = true;
+
+			player->mReadInProgress = false;
+			mReadFinishedCond.notify_all();
+		}
+	}
+
+	// Must be called with mMutex held. Returns the requesting player with the least full ring buffers, or nullptr if there are none.
+	FilePlayerNode* acquireNextPlayer()
+	{
+		FilePlayerNode *result = nullptr;
+		float minFill = numeric_limits<float>::max();
+		for( auto &player : mPlayers ) {
+			if( player->mReadInProgress || ! player->mReadRequested.load( memory_order_acquire ) )
+				continue;
+
+			float fill = player->getReadAheadFill();
+			if( fill < minFill ) {
+				minFill = fill;
+				result = player;
+			}
+		}
+
+		if( result ) {
+			result->mReadRequested = false;
+			result->mReadInProgress = true;
+		}
+
+		return result;
+	}
+
+	vector<thread>			mThreads;
+	mutex					mMutex;
+	condition_variable		mReadFinishedCond;
+	atomic<uint32_t>		mNumRequests;
+	vector<FilePlayerNode*>	mPlayers;
+	bool					mQuit;
+};
+
+shared_ptr<FileReadScheduler> FileReadScheduler::get()
+{
+	auto &shared = getShared();
+	lock_guard<mutex> lock( shared.mMutex );
+
+	auto result = shared.mScheduler.lock();
+	if( ! result ) {
+		result = make_shared<FileReadScheduler>( shared.mNumThreads );
+		shared.mScheduler = result;
+	}
+
+	return result;
+}
+
+void FileReadScheduler::setNumThreadsShared( size_t numThreads )
+{
+	auto &shared = getShared();
+	lock_guard<mutex> lock( shared.mMutex );
+
+	// without a reader thread asynchronous players would never receive samples
+	shared.mNumThreads = max<size_t>( numThreads, 1 );
+	auto scheduler = shared.mScheduler.lock();
+	if( scheduler )
+		scheduler->setNumThreads( shared.mNumThreads );
+}
+
+size_t FileReadScheduler::getNumThreadsShared()
+{
+	auto &shared = getShared();
+	lock_guard<mutex> lock( shared.mMutex );
+	return shared.mNumThreads;
+}
+
 // ----------------------------------------------------------------------------------------------------
 // FilePlayerNode
 // ----------------------------------------------------------------------------------------------------
 
 FilePlayerNode::FilePlayerNode( const Format &format )
-	: SamplePlayerNode( format ), mRingBufferPaddingFactor( 2 ), mLastUnderrun( 0 ), mLastOverrun( 0 ), mIsReadAsync( true )
+	: SamplePlayerNode( format ), mRingBufferPaddingFactor( 2 ), mReadAheadFrames( 0 ), mLastUnderrun( 0 ), mLastOverrun( 0 ), mNumUnderruns( 0 ),
+		mSeekGeneration( 0 ), mReadRequested( false ), mReadInProgress( false ), mIsReadAsync( true )
 {
 }
 
 FilePlayerNode::FilePlayerNode( const SourceFileRef &sourceFile, bool isReadAsync, const Format &format )
-	: SamplePlayerNode( format ), mSourceFile( sourceFile ), mIsReadAsync( isReadAsync ), mRingBufferPaddingFactor( 2 ),
-		mLastUnderrun( 0 ), mLastOverrun( 0 )
+	: SamplePlayerNode( format ), mSourceFile( sourceFile ), mIsReadAsync( isReadAsync ), mRingBufferPaddingFactor( 2 ), mReadAheadFrames( 0 ),
+		mLastUnderrun( 0 ), mLastOverrun( 0 ), mNumUnderruns( 0 ), mSeekGeneration( 0 ), mReadRequested( false ), mReadInProgress( false )
 {
 	if( mSourceFile ) {
 		mNumFrames = mSourceFile->getNumFrames();
@@ -236,7 +436,7 @@ FilePlayerNode::FilePlayerNode( const SourceFileRef &sourceFile, bool isReadAsyn
 FilePlayerNode::~FilePlayerNode()
 {
 	if( isInitialized() )
-		destroyReadThreadImpl();
+		removeFromReadScheduler();
 }
 
 void FilePlayerNode::initialize()
@@ -251,8 +451,9 @@ void FilePlayerNode::initialize()
 
 		mIoBuffer.setSize( mSourceFile->getMaxFramesPerRead(), getNumChannels() );
 
+		size_t ringBufferSize = max( mReadAheadFrames, mSourceFile->getMaxFramesPerRead() * mRingBufferPaddingFactor );
 		for( size_t i = 0; i < getNumChannels(); i++ )
-			mRingBuffers.emplace_back( mSourceFile->getMaxFramesPerRead() * mRingBufferPaddingFactor );
+			mRingBuffers.emplace_back( ringBufferSize );
 
 		mBufferFramesThreshold = mRingBuffers[0].getSize() / 2;
 	}
@@ -260,18 +461,20 @@ void FilePlayerNode::initialize()
 	if( ! mLoopEnd  || mLoopEnd > mNumFrames )
 		mLoopEnd = mNumFrames;
 
+	mNumUnderruns = 0;
+	mReadRequested = false;
+
 	if( mIsReadAsync ) {
-		mAsyncReadShouldQuit = false;
-		mReadThread = unique_ptr<thread>( new thread( bind( &FilePlayerNode::readAsyncImpl, this ) ) );
+		mReadScheduler = FileReadScheduler::get();
+		mReadScheduler->addPlayer( this );
 	}
 }
 
 void FilePlayerNode::uninitialize()
 {
-	destroyReadThreadImpl();
+	removeFromReadScheduler();
 	mRingBuffers.clear();
 }
-
 void FilePlayerNode::enableProcessing()
 {
 	if( ! mSourceFile ) {
@@ -280,6 +483,10 @@ void FilePlayerNode::enableProcessing()
 	}
 
 	mIsEof = false;
+
+	// start reading ahead now rather than waiting for the first process() to find the ring buffers empty
+	if( mIsReadAsync && mReadScheduler )
+		mReadScheduler->requestRead( this );
 }
 
 void FilePlayerNode::disableProcessing()
@@ -352,6 +559,25 @@ void FilePlayerNode::setSourceFile( const SourceFileRef &sourceFile )
 		enable();
 }
 
+float FilePlayerNode::getReadAheadFill() const
+{
+	if( mRingBuffers.empty() )
+		return 0;
+
+	const auto &ringBuffer = mRingBuffers.back(); // the last channel is written last, so it is the least full
+	return float( ringBuffer.getAvailableRead() ) / float( ringBuffer.getSize() );
+}
+
+void FilePlayerNode::setNumReadThreads( size_t numThreads )
+{
+	FileReadScheduler::setNumThreadsShared( numThreads );
+}
+
+size_t FilePlayerNode::getNumReadThreads()
+{
+	return FileReadScheduler::getNumThreadsShared();
+}
+
 uint64_t FilePlayerNode::getLastUnderrun()
 {
 	uint64_t result = mLastUnderrun;
@@ -374,7 +600,7 @@ void FilePlayerNode::process( Buffer *buffer )
 
 	if( numReadAvail < mBufferFramesThreshold ) {
 		if( mIsReadAsync )
-			mIssueAsyncReadCond.notify_one();
+			mReadScheduler->requestRead( this );
 		else
 			readImpl();
 	}
@@ -397,38 +623,39 @@ void FilePlayerNode::process( Buffer *buffer )
 			mIsEof = true;
 			disable();
 		}
+		else {
+			// samples were still left in the file, reading didn't keep up with playback
+			mLastUnderrun = getContext()->getNumProcessedFrames();
+			mNumUnderruns++;
+		}
 	}
 }
 
-void FilePlayerNode::readAsyncImpl()
+bool FilePlayerNode::readAsyncImpl()
 {
-	size_t lastReadPos = mReadPos;
-	while( true ) {
-		unique_lock<mutex> lock( mAsyncReadMutex );
-		mIssueAsyncReadCond.wait( lock );
-
-		if( mAsyncReadShouldQuit )
-			return;
+	lock_guard<mutex> lock( mAsyncReadMutex );
 
-		size_t readPos = mReadPos;
-		if( readPos != lastReadPos )
-			mSourceFile->seek( readPos );
+	if( ! mSourceFile || mRingBuffers.empty() )
+		return false;
 
-		readImpl();
-		lastReadPos = mReadPos;
-	}
+	size_t numRead = readImpl();
+	return numRead && mRingBuffers[0].getAvailableWrite() >= mSourceFile->getMaxFramesPerRead();
 }
 
-void FilePlayerNode::readImpl()
+size_t FilePlayerNode::readImpl()
 {
+	// the reader threads may still be reading while the Context is destroyed, in which case overruns are no longer recorded
+	auto ctx = getContext();
+	const uint64_t seekGeneration = mSeekGeneration;
 	size_t readPos = mReadPos;
-	size_t availableWrite = mRingBuffers[0].getAvailableWrite();
+	size_t availableWrite = min( mRingBuffers[0].getAvailableWrite(), mSourceFile->getMaxFramesPerRead() );
 	size_t readEnd = mLoop ? mLoopEnd.load() : mNumFrames;
 	size_t numFramesToRead = readEnd < readPos ? 0 : min( availableWrite, readEnd - readPos );
 
 	if( ! numFramesToRead ) {
-		mLastOverrun = getContext()->getNumProcessedFrames();
-		return;
+		if( ctx )
+			mLastOverrun = ctx->getNumProcessedFrames();
+		return 0;
 	}
 
 	// safety check that the SourceFile is on the correct read position, which could happen if two users are simultaneously reading from the same file.
@@ -438,14 +665,21 @@ void FilePlayerNode::readImpl()
 	mIoBuffer.setNumFrames( numFramesToRead );
 
 	size_t numRead = mSourceFile->read( &mIoBuffer );
-	mReadPos += numRead;
 
 	for( size_t ch = 0; ch < getNumChannels(); ch++ ) {
 		if( ! mRingBuffers[ch].write( mIoBuffer.getChannel( ch ), numRead ) ) {
-			mLastOverrun = getContext()->getNumProcessedFrames();
-			return;
+			if( ctx )
+				mLastOverrun = ctx->getNumProcessedFrames();
+			return 0;
 		}
 	}
+
+	// Only advance once the samples are in the ring buffers, otherwise process() could see the end of file before they are readable. If the
+	// audio thread seeked during the read, such as when looping, the read position it set is kept.
+	if( mSeekGeneration == seekGeneration )
+		mReadPos.compare_exchange_strong( readPos, readPos + numRead );
+
+	return numRead;
 }
 
 void FilePlayerNode::seekImpl( size_t readPos )
@@ -454,6 +688,7 @@ void FilePlayerNode::seekImpl( size_t readPos )
 		return;
 
 	mIsEof = false;
+	mSeekGeneration++;
 	mReadPos = math<size_t>::clamp( readPos, 0, mNumFrames );
 
 	// if async mode, readAsyncImpl() will notice mReadPos was updated and do the seek there.
@@ -471,12 +706,11 @@ void FilePlayerNode::stopImpl()
 	seekImpl( 0 );
 }
 
-void FilePlayerNode::destroyReadThreadImpl()
+void FilePlayerNode::removeFromReadScheduler()
 {
-	if( mIsReadAsync && mReadThread ) {
-		mAsyncReadShouldQuit = true;
-		mIssueAsyncReadCond.notify_one();
-		mReadThread->join();
+	if( mReadScheduler ) {
+		mReadScheduler->removePlayer( this );
+		mReadScheduler.reset();
 	}
 }
 
@@ -27,6 +27,10 @@
 
 #if defined( CINDER_AUDIO_VDSP )
 	#include <Accelerate/Accelerate.h>
+#elif defined( CINDER_AUDIO_SSE )
+	#include <emmintrin.h>
+#elif defined( CINDER_AUDIO_NEON )
+	#include <arm_neon.h>
 #endif
 
 using namespace ci;
@@ -99,6 +103,21 @@ void generateWindow( WindowType windowType, float *window, size_t length )
 
 #if defined( CINDER_AUDIO_VDSP )
 
+namespace {
+
+// Returns the largest value in \a array, or zero if \a length is zero.
+float findMaximum( const float *array, size_t length )
+{
+	if( length == 0 )
+		return 0;
+
+	float result;
+	vDSP_maxv( array, 1, &result, length );
+	return result;
+}
+
+} // anonymous namespace
+
 void fill( float value, float *array, size_t length )
 {
 	vDSP_vfill( &value, array, 1, length );
@@ -164,7 +183,286 @@ void addMul( const float *arrayA, const float *arrayB, float scalar, float *resu
 	vDSP_vasm( const_cast<float *>( arrayA ), 1, const_cast<float *>( arrayB ), 1, &scalar, result, 1, length );
 }
 
-#else // ! defined( CINDER_AUDIO_VDSP )
+#elif defined( CINDER_AUDIO_SSE ) || defined( CINDER_AUDIO_NEON )
+
+namespace {
+
+// Thin wrappers over 4-wide float registers so that the routines below are shared between SSE2 and NEON.
+// Loads and stores are unaligned, as callers commonly pass channel or frame offsets into a Buffer.
+#if defined( CINDER_AUDIO_SSE )
+
+typedef __m128 vec4f;
+
+inline vec4f load4( const float *p )				{ return _mm_loadu_ps( p ); }
+inline void store4( float *p, vec4f v )				{ _mm_storeu_ps( p, v ); }
+inline vec4f splat4( float v )						{ return _mm_set1_ps( v ); }
+inline vec4f add4( vec4f a, vec4f b )				{ return _mm_add_ps( a, b ); }
+inline vec4f sub4( vec4f a, vec4f b )				{ return _mm_sub_ps( a, b ); }
+inline vec4f mul4( vec4f a, vec4f b )				{ return _mm_mul_ps( a, b ); }
+inline vec4f div4( vec4f a, vec4f b )				{ return _mm_div_ps( a, b ); }
+inline vec4f max4( vec4f a, vec4f b )				{ return _mm_max_ps( a, b ); }
+
+inline float horizontalSum( vec4f v )
+{
+	vec4f shuf = _mm_shuffle_ps( v, v, _MM_SHUFFLE( 2, 3, 0, 1 ) );
+	vec4f sums = _mm_add_ps( v, shuf );
+	shuf = _mm_movehl_ps( shuf, sums );
+	return _mm_cvtss_f32( _mm_add_ss( sums, shuf ) );
+}
+
+inline float horizontalMax( vec4f v )
+{
+	vec4f shuf = _mm_shuffle_ps( v, v, _MM_SHUFFLE( 2, 3, 0, 1 ) );
+	vec4f maxs = _mm_max_ps( v, shuf );
+	shuf = _mm_movehl_ps( shuf, maxs );
+	return _mm_cvtss_f32( _mm_max_ss( maxs, shuf ) );
+}
+
+#else // defined( CINDER_AUDIO_NEON )
+
+typedef float32x4_t vec4f;
+
+inline vec4f load4( const float *p )				{ return vld1q_f32( p ); }
+inline void store4( float *p, vec4f v )				{ vst1q_f32( p, v ); }
+inline vec4f splat4( float v )						{ return vdupq_n_f32( v ); }
+inline vec4f add4( vec4f a, vec4f b )				{ return vaddq_f32( a, b ); }
+inline vec4f sub4( vec4f a, vec4f b )				{ return vsubq_f32( a, b ); }
+inline vec4f mul4( vec4f a, vec4f b )				{ return vmulq_f32( a, b ); }
+inline vec4f div4( vec4f a, vec4f b )				{ return vdivq_f32( a, b ); }
+inline vec4f max4( vec4f a, vec4f b )				{ return vmaxq_f32( a, b ); }
+inline float horizontalSum( vec4f v )				{ return vaddvq_f32( v ); }
+inline float horizontalMax( vec4f v )				{ return vmaxvq_f32( v ); }
+
+#endif // defined( CINDER_AUDIO_NEON )
+
+// Each loop is unrolled to process 8 samples per iteration, which keeps two independent registers in flight. The remainder is handled with scalar code.
+const size_t UNROLL = 8;
+
+// Returns the largest value in \a array, or zero if \a length is zero.
+float findMaximum( const float *array, size_t length )
+{
+	if( length == 0 )
+		return 0;
+
+	const size_t end = length & ~( UNROLL - 1 );
+	float result = array[0];
+
+	size_t i = 0;
+	if( end ) {
+		vec4f acc0 = load4( array );
+		vec4f acc1 = load4( array + 4 );
+		for( i = UNROLL; i < end; i += UNROLL ) {
+			acc0 = max4( acc0, load4( array + i ) );
+			acc1 = max4( acc1, load4( array + i + 4 ) );
+		}
+		result = horizontalMax( max4( acc0, acc1 ) );
+	}
+	for( ; i < length; i++ ) {
+		if( result < array[i] )
+			result = array[i];
+	}
+	return result;
+}
+
+} // anonymous namespace
+
+void fill( float value, float *array, size_t length )
+{
+	const vec4f v = splat4( value );
+	const size_t end = length & ~( UNROLL - 1 );
+
+	size_t i = 0;
+	for( ; i < end; i += UNROLL ) {
+		store4( array + i, v );
+		store4( array + i + 4, v );
+	}
+	for( ; i < length; i++ )
+		array[i] = value;
+}
+
+float sum( const float *array, size_t length )
+{
+	vec4f acc0 = splat4( 0 );
+	vec4f acc1 = splat4( 0 );
+	const size_t end = length & ~( UNROLL - 1 );
+
+	size_t i = 0;
+	for( ; i < end; i += UNROLL ) {
+		acc0 = add4( acc0, load4( array + i ) );
+		acc1 = add4( acc1, load4( array + i + 4 ) );
+	}
+
+	float result = horizontalSum( add4( acc0, acc1 ) );
+	for( ; i < length; i++ )
+		result += array[i];
+	return result;
+}
+
+void add( const float *array, float scalar, float *result, size_t length )
+{
+	const vec4f s = splat4( scalar );
+	const size_t end = length & ~( UNROLL - 1 );
+
+	size_t i = 0;
+	for( ; i < end; i += UNROLL ) {
+		store4( result + i, add4( load4( array + i ), s ) );
+		store4( result + i + 4, add4( load4( array + i + 4 ), s ) );
+	}
+	for( ; i < length; i++ )
+		result[i] = array[i] + scalar;
+}
+
+void add( const float *arrayA, const float *arrayB, float *result, size_t length )
+{
+	const size_t end = length & ~( UNROLL - 1 );
+
+	size_t i = 0;
+	for( ; i < end; i += UNROLL ) {
+		store4( result + i, add4( load4( arrayA + i ), load4( arrayB + i ) ) );
+		store4( result + i + 4, add4( load4( arrayA + i + 4 ), load4( arrayB + i + 4 ) ) );
+	}
+	for( ; i < length; i++ )
+		result[i] = arrayA[i] + arrayB[i];
+}
+
+void sub( const float *array, float scalar, float *result, size_t length )
+{
+	const vec4f s = splat4( scalar );
+	const size_t end = length & ~( UNROLL - 1 );
+
+	size_t i = 0;
+	for( ; i < end; i += UNROLL ) {
+		store4( result + i, sub4( load4( array + i ), s ) );
+		store4( result + i + 4, sub4( load4( array + i + 4 ), s ) );
+	}
+	for( ; i < length; i++ )
+		result[i] = array[i] - scalar;
+}
+
+void sub( const float *arrayA, const float *arrayB, float *result, size_t length )
+{
+	const size_t end = length & ~( UNROLL - 1 );
+
+	size_t i = 0;
+	for( ; i < end; i += UNROLL ) {
+		store4( result + i, sub4( load4( arrayA + i ), load4( arrayB + i ) ) );
+		store4( result + i + 4, sub4( load4( arrayA + i + 4 ), load4( arrayB + i + 4 ) ) );
+	}
+	for( ; i < length; i++ )
+		result[i] = arrayA[i] - arrayB[i];
+}
+
+float rms( const float *array, size_t length )
+{
+	vec4f acc0 = splat4( 0 );
+	vec4f acc1 = splat4( 0 );
+	const size_t end = length & ~( UNROLL - 1 );
+
+	size_t i = 0;
+	for( ; i < end; i += UNROLL ) {
+		vec4f a = load4( array + i );
+		vec4f b = load4( array + i + 4 );
+		acc0 = add4( acc0, mul4( a, a ) );
+		acc1 = add4( acc1, mul4( b, b ) );
+	}
+
+	float sumSquared = horizontalSum( add4( acc0, acc1 ) );
+	for( ; i < length; i++ ) {
+		float val = array[i];
+		sumSquared += val * val;
+	}
+
+	return math<float>::sqrt( sumSquared / (float)length );
+}
+
+void mul( const float *array, float scalar, float *result, size_t length )
+{
+	const vec4f s = splat4( scalar );
+	const size_t end = length & ~( UNROLL - 1 );
+
+	size_t i = 0;
+	for( ; i < end; i += UNROLL ) {
+		store4( result + i, mul4( load4( array + i ), s ) );
+		store4( result + i + 4, mul4( load4( array + i + 4 ), s ) );
+	}
+	for( ; i < length; i++ )
+		result[i] = array[i] * scalar;
+}
+
+void mul( const float *arrayA, const float *arrayB, float *result, size_t length )
+{
+	const size_t end = length & ~( UNROLL - 1 );
+
+	size_t i = 0;
+	for( ; i < end; i += UNROLL ) {
+		store4( result + i, mul4( load4( arrayA + i ), load4( arrayB + i ) ) );
+		store4( result + i + 4, mul4( load4( arrayA + i + 4 ), load4( arrayB + i + 4 ) ) );
+	}
+	for( ; i < length; i++ )
+		result[i] = arrayA[i] * arrayB[i];
+}
+
+void divide( const float *array, float scalar, float *result, size_t length )
+{
+	// divides rather than multiplying by the reciprocal, so results match dividing each element exactly
+	const vec4f s = splat4( scalar );
+	const size_t end = length & ~( UNROLL - 1 );
+
+	size_t i = 0;
+	for( ; i < end; i += UNROLL ) {
+		store4( result + i, div4( load4( array + i ), s ) );
+		store4( result + i + 4, div4( load4( array + i + 4 ), s ) );
+	}
+	for( ; i < length; i++ )
+		result[i] = array[i] / scalar;
+}
+
+void divide( const float *arrayA, const float *arrayB, float *result, size_t length )
+{
+	const size_t end = length & ~( UNROLL - 1 );
+
+	size_t i = 0;
+	for( ; i < end; i += UNROLL ) {
+		store4( result + i, div4( load4( arrayA + i ), load4( arrayB + i ) ) );
+		store4( result + i + 4, div4( load4( arrayA + i + 4 ), load4( arrayB + i + 4 ) ) );
+	}
+	for( ; i < length; i++ )
+		result[i] = arrayA[i] / arrayB[i];
+}
+
+void addMul( const float *arrayA, const float *arrayB, float scalar, float *result, size_t length )
+{
+	const vec4f s = splat4( scalar );
+	const size_t end = length & ~( UNROLL - 1 );
+
+	size_t i = 0;
+	for( ; i < end; i += UNROLL ) {
+		store4( result + i, mul4( add4( load4( arrayA + i ), load4( arrayB + i ) ), s ) );
+		store4( result + i + 4, mul4( add4( load4( arrayA + i + 4 ), load4( arrayB + i + 4 ) ), s ) );
+	}
+	for( ; i < length; i++ )
+		result[i] = ( arrayA[i] + arrayB[i] ) * scalar;
+}
+
+#else // ! defined( CINDER_AUDIO_VDSP ) && ! defined( CINDER_AUDIO_SSE ) && ! defined( CINDER_AUDIO_NEON )
+
+namespace {
+
+// Returns the largest value in \a array, or zero if \a length is zero.
+float findMaximum( const float *array, size_t length )
+{
+	if( length == 0 )
+		return 0;
+
+	float result = array[0];
+	for( size_t i = 1; i < length; i++ ) {
+		if( result < array[i] )
+			result = array[i];
+	}
+	return result;
+}
+
+} // anonymous namespace
 
 void fill( float value, float *array, size_t length )
 {
@@ -229,7 +527,8 @@ void mul( const float *arrayA, const float *arrayB, float *result, size_t length
 
 void divide( const float *array, float scalar, float *result, size_t length )
 {
-	mul( array, 1 / scalar, result, length );
+	for( size_t i = 0; i < length; i++ )
+		result[i] = array[i] / scalar;
 }
 
 void divide( const float *arrayA, const float *arrayB, float *result, size_t length )
@@ -244,16 +543,11 @@ void addMul( const float *arrayA, const float *arrayB, float scalar, float *resu
 		result[i] = ( arrayA[i] + arrayB[i] ) * scalar;
 }
 
-#endif // ! defined( CINDER_AUDIO_VDSP )
+#endif // ! defined( CINDER_AUDIO_VDSP ) && ! defined( CINDER_AUDIO_SSE ) && ! defined( CINDER_AUDIO_NEON )
 
 void normalize( float *array, size_t length, float maxValue )
 {
-	float max = 0;
-	for( size_t i = 0; i < length; i++ ) {
-		if( max < array[i] )
-			max = array[i];
-	}
-
+	float max = findMaximum( array, length );
 	if( max > 0.00001f ) {
 		mul( array, maxValue / max, array, length );
 	}
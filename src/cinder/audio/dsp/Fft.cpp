@@ -26,12 +26,139 @@
 #include "cinder/audio/Exception.h"
 #include "cinder/CinderMath.h"
 
+#include <map>
+#include <mutex>
+
 #if defined( CINDER_AUDIO_FFT_OOURA )
 	#include "cinder/audio/dsp/ooura/fftsg.h"
 #endif
 
+using namespace std;
+
 namespace cinder { namespace audio { namespace dsp {
 
+// ----------------------------------------------------------------------------------------------------
+// Fft::Plan
+// ----------------------------------------------------------------------------------------------------
+
+// Holds the tables needed to compute transforms of one size, which are only read after construction so that they can be shared.
+struct Fft::Plan {
+	Plan( size_t fftSize );
+	~Plan();
+
+	static shared_ptr<Plan>	get( size_t fftSize );
+	static size_t			getNumCached();
+
+#if defined( CINDER_AUDIO_VDSP )
+	::FFTSetup						mFftSetup;
+#elif defined( CINDER_AUDIO_FFT_OOURA )
+	ooura::float4*					getTables4();
+
+	vector<int>						mIp;
+	vector<float>					mW;
+	// tables for transforming four channels at once, built the first time they're needed
+	vector<ooura::float4>			mW4;
+	once_flag						mW4Flag;
+#endif
+
+  private:
+	// Plans are held weakly, so that their tables are released once there are no more Fft's of that size.
+	struct Cache {
+		mutex							mMutex;
+		map<size_t, weak_ptr<Plan>>		mPlans;
+	};
+
+	static Cache& getCache();
+};
+
+Fft::Plan::Cache& Fft::Plan::getCache()
+{
+	static Cache sCache;
+	return sCache;
+}
+
+shared_ptr<Fft::Plan> Fft::Plan::get( size_t fftSize )
+{
+	auto &cache = getCache();
+	lock_guard<mutex> lock( cache.mMutex );
+
+	auto &plan = cache.mPlans[fftSize];
+	auto result = plan.lock();
+	if( ! result ) {
+		result = make_shared<Plan>( fftSize );
+		plan = result;
+	}
+
+	return result;
+}
+
+size_t Fft::Plan::getNumCached()
+{
+	auto &cache = getCache();
+	lock_guard<mutex> lock( cache.mMutex );
+
+	for( auto planIt = cache.mPlans.begin(); planIt != cache.mPlans.end(); ) {
+		if( planIt->second.expired() )
+			planIt = cache.mPlans.erase( planIt );
+		else
+			++planIt;
+	}
+
+	return cache.mPlans.size();
+}
+
+#if defined( CINDER_AUDIO_VDSP )
+
+Fft::Plan::Plan( size_t fftSize )
+{
+	mFftSetup = vDSP_create_fftsetup( log2f( fftSize ), FFT_RADIX2 );
+	CI_ASSERT( mFftSetup );
+}
+
+Fft::Plan::~Plan()
+{
+	vDSP_destroy_fftsetup( mFftSetup );
+}
+
+#elif defined( CINDER_AUDIO_FFT_OOURA )
+
+Fft::Plan::Plan( size_t fftSize )
+{
+	// The tables are built for a real transform of twice the size, which is what a complex transform of fftSize needs.
+	// Ooura's routines can also use them for the real transform of fftSize.
+	const size_t tableSize = fftSize * 2;
+	mIp.resize( 2 + (size_t)sqrt( fftSize ) );
+	mW.resize( fftSize );
+
+	vector<float> data( tableSize );
+	mIp[0] = 0;
+	ooura::rdft( (int)tableSize, 1, data.data(), mIp.data(), mW.data() );
+}
+
+Fft::Plan::~Plan()
+{
+}
+
+ooura::float4* Fft::Plan::getTables4()
+{
+	call_once( mW4Flag, [this] {
+		mW4.assign( mW.begin(), mW.end() );
+	} );
+
+	return mW4.data();
+}
+
+#endif
+
+size_t Fft::getNumCachedPlans()
+{
+	return Plan::getNumCached();
+}
+
+// ----------------------------------------------------------------------------------------------------
+// Fft
+// ----------------------------------------------------------------------------------------------------
+
 Fft::Fft( size_t fftSize )
 : mSize( fftSize )
 {
@@ -45,21 +172,52 @@ Fft::Fft( size_t fftSize )
 
 #if defined( CINDER_AUDIO_VDSP )
 
+namespace {
+
+void forwardVdsp( ::FFTSetup fftSetup, size_t log2FftSize, const float *waveform, BufferSpectral *spectral )
+{
+	::DSPSplitComplex splitComplexSignal;
+	splitComplexSignal.realp = spectral->getReal();
+	splitComplexSignal.imagp = spectral->getImag();
+
+	// in-place transfrom is okay here because we already first copy the data from waveform -> spectral
+	vDSP_ctoz( (const ::DSPComplex *)waveform, 2, &splitComplexSignal, 1, spectral->getNumFrames() );
+	vDSP_fft_zrip( fftSetup, &splitComplexSignal, 1, log2FftSize, FFT_FORWARD );
+}
+
+void inverseVdsp( ::FFTSetup fftSetup, size_t log2FftSize, const BufferSpectral *spectral, ::DSPSplitComplex *splitComplexResult, float *waveform )
+{
+	::DSPSplitComplex splitComplexSignal;
+	splitComplexSignal.realp = const_cast<float *>( spectral->getReal() );
+	splitComplexSignal.imagp = const_cast<float *>( spectral->getImag() );
+
+	const size_t sizeOverTwo = spectral->getNumFrames();
+
+	// use out-of-place transfrom so as to not overwrite spectral
+	vDSP_fft_zrop( fftSetup, &splitComplexSignal, 1, splitComplexResult, 1, log2FftSize, FFT_INVERSE );
+	vDSP_ztoc( splitComplexResult, 1, (::DSPComplex *)waveform, 2, sizeOverTwo );
+
+	float scale = 1.0f / float( 4 * sizeOverTwo );
+	vDSP_vsmul( waveform, 1, &scale, waveform, 1, sizeOverTwo * 2 );
+}
+
+} // anonymous namespace
+
 void Fft::init()
 {
-	mSplitComplexResult.realp = (float *)malloc( mSizeOverTwo * sizeof( float ) );
-	mSplitComplexResult.imagp = (float *)malloc( mSizeOverTwo * sizeof( float ) );
+	mPlan = Plan::get( mSize );
+
+	// large enough for complex transforms, of which the real transforms use half
+	mSplitComplexResult.realp = (float *)malloc( mSize * sizeof( float ) );
+	mSplitComplexResult.imagp = (float *)malloc( mSize * sizeof( float ) );
 
 	mLog2FftSize = log2f( mSize );
-	mFftSetup = vDSP_create_fftsetup( mLog2FftSize, FFT_RADIX2 );
-	CI_ASSERT( mFftSetup );
 }
 
 Fft::~Fft()
 {
 	free( mSplitComplexResult.realp );
 	free( mSplitComplexResult.imagp );
-	vDSP_destroy_fftsetup( mFftSetup );
 }
 
 void Fft::forward( const Buffer *waveform, BufferSpectral *spectral )
@@ -67,12 +225,7 @@ void Fft::forward( const Buffer *waveform, BufferSpectral *spectral )
 	CI_ASSERT( waveform->getNumFrames() == mSize );
 	CI_ASSERT( spectral->getNumFrames() == mSizeOverTwo );
 
-	mSplitComplexSignal.realp = spectral->getReal();
-	mSplitComplexSignal.imagp = spectral->getImag();
-
-	// in-place transfrom is okay here because we already first copy the data from waveform -> spectral
-	vDSP_ctoz( (::DSPComplex *)waveform->getData(), 2, &mSplitComplexSignal, 1, mSizeOverTwo );
-	vDSP_fft_zrip( mFftSetup, &mSplitComplexSignal, 1, mLog2FftSize, FFT_FORWARD );
+	forwardVdsp( mPlan->mFftSetup, mLog2FftSize, waveform->getData(), spectral );
 }
 
 void Fft::inverse( const BufferSpectral *spectral, Buffer *waveform )
@@ -80,31 +233,86 @@ void Fft::inverse( const BufferSpectral *spectral, Buffer *waveform )
 	CI_ASSERT( waveform->getNumFrames() == mSize );
 	CI_ASSERT( spectral->getNumFrames() == mSizeOverTwo );
 
-	mSplitComplexSignal.realp = const_cast<float *>( spectral->getReal() );
-	mSplitComplexSignal.imagp = const_cast<float *>( spectral->getImag() );
-	float *data = waveform->getData();
+	inverseVdsp( mPlan->mFftSetup, mLog2FftSize, spectral, &mSplitComplexResult, waveform->getData() );
+}
 
-	// use out-of-place transfrom so as to not overwrite spectral
-	vDSP_fft_zrop( mFftSetup, &mSplitComplexSignal, 1, &mSplitComplexResult, 1, mLog2FftSize, FFT_INVERSE );
-	vDSP_ztoc( &mSplitComplexResult, 1, (::DSPComplex *)data, 2, mSizeOverTwo );
+// vDSP's transforms are already vectorized for a single channel, so batches are transformed one channel at a time
+void Fft::forward( const Buffer *waveforms, std::vector<BufferSpectral> *spectra )
+{
+	CI_ASSERT( waveforms->getNumFrames() == mSize );
+	CI_ASSERT( spectra->size() >= waveforms->getNumChannels() );
+
+	for( size_t ch = 0; ch < waveforms->getNumChannels(); ch++ ) {
+		CI_ASSERT( (*spectra)[ch].getNumFrames() == mSizeOverTwo );
+		forwardVdsp( mPlan->mFftSetup, mLog2FftSize, waveforms->getChannel( ch ), &(*spectra)[ch] );
+	}
+}
+
+void Fft::inverse( const std::vector<BufferSpectral> *spectra, Buffer *waveforms )
+{
+	CI_ASSERT( waveforms->getNumFrames() == mSize );
+	CI_ASSERT( spectra->size() >= waveforms->getNumChannels() );
+
+	for( size_t ch = 0; ch < waveforms->getNumChannels(); ch++ ) {
+		CI_ASSERT( (*spectra)[ch].getNumFrames() == mSizeOverTwo );
+		inverseVdsp( mPlan->mFftSetup, mLog2FftSize, &(*spectra)[ch], &mSplitComplexResult, waveforms->getChannel( ch ) );
+	}
+}
+
+void Fft::forwardComplex( const BufferSpectral *input, BufferSpectral *output )
+{
+	CI_ASSERT( input->getNumFrames() == mSize );
+	CI_ASSERT( output->getNumFrames() == mSize );
 
-	float scale = 1.0f / float( 2 * mSize );
-	vDSP_vsmul( data, 1, &scale, data, 1, mSize );
+	::DSPSplitComplex splitComplexInput;
+	splitComplexInput.realp = const_cast<float *>( input->getReal() );
+	splitComplexInput.imagp = const_cast<float *>( input->getImag() );
+
+	::DSPSplitComplex splitComplexOutput;
+	splitComplexOutput.realp = output->getReal();
+	splitComplexOutput.imagp = output->getImag();
+
+	if( input == output )
+		vDSP_fft_zip( mPlan->mFftSetup, &splitComplexOutput, 1, mLog2FftSize, FFT_FORWARD );
+	else
+		vDSP_fft_zop( mPlan->mFftSetup, &splitComplexInput, 1, &splitComplexOutput, 1, mLog2FftSize, FFT_FORWARD );
+}
+
+void Fft::inverseComplex( const BufferSpectral *input, BufferSpectral *output )
+{
+	CI_ASSERT( input->getNumFrames() == mSize );
+	CI_ASSERT( output->getNumFrames() == mSize );
+
+	::DSPSplitComplex splitComplexInput;
+	splitComplexInput.realp = const_cast<float *>( input->getReal() );
+	splitComplexInput.imagp = const_cast<float *>( input->getImag() );
+
+	::DSPSplitComplex splitComplexOutput;
+	splitComplexOutput.realp = output->getReal();
+	splitComplexOutput.imagp = output->getImag();
+
+	if( input == output )
+		vDSP_fft_zip( mPlan->mFftSetup, &splitComplexOutput, 1, mLog2FftSize, FFT_INVERSE );
+	else
+		vDSP_fft_zop( mPlan->mFftSetup, &splitComplexInput, 1, &splitComplexOutput, 1, mLog2FftSize, FFT_INVERSE );
+
+	float scale = 1.0f / float( mSize );
+	vDSP_vsmul( output->getData(), 1, &scale, output->getData(), 1, output->getSize() );
 }
 
 #elif defined( CINDER_AUDIO_FFT_OOURA )
 
 void Fft::init()
 {
-	mOouraIp = (int *)calloc( 2 + (int)sqrt( mSizeOverTwo ), sizeof( int ) );
-	mOouraW = (float *)calloc( mSizeOverTwo, sizeof( float ) );
-	mBufferCopy = Buffer( mSize );
+	mPlan = Plan::get( mSize );
+
+	// large enough for complex transforms, of which the real transforms use half
+	mBufferCopy = Buffer( mSize * 2 );
+	mBatchBuffer = Buffer( mSize * 4 );
 }
 
 Fft::~Fft()
 {
-	free( mOouraIp );
-	free( mOouraW );
 }
 
 void Fft::forward( const Buffer *waveform, BufferSpectral *spectral )
@@ -112,18 +320,16 @@ void Fft::forward( const Buffer *waveform, BufferSpectral *spectral )
 	CI_ASSERT( waveform->getNumFrames() == mSize );
 	CI_ASSERT( spectral->getNumFrames() == mSizeOverTwo );
 
-	mBufferCopy.copy( *waveform );
-
 	float *a = mBufferCopy.getData();
 	float *real = spectral->getReal();
 	float *imag = spectral->getImag();
 
-	ooura::rdft( (int)mSize, 1, a, mOouraIp, mOouraW );
+	memcpy( a, waveform->getData(), mSize * sizeof( float ) );
 
-	real[0] = a[0];
-	imag[0] = a[1];
+	ooura::rdft( (int)mSize, 1, a, mPlan->mIp.data(), mPlan->mW.data() );
 
-	for( size_t k = 1; k < mSizeOverTwo; k++ ) {
+	// the nyquist component is packed into a[1], which ends up in imag[0]
+	for( size_t k = 0; k < mSizeOverTwo; k++ ) {
 		real[k] = a[k * 2];
 		imag[k] = a[k * 2 + 1];
 	}
@@ -134,24 +340,186 @@ void Fft::inverse( const BufferSpectral *spectral, Buffer *waveform )
 	CI_ASSERT( waveform->getNumFrames() == mSize );
 	CI_ASSERT( spectral->getNumFrames() == mSizeOverTwo );
 
-	mBufferCopy.copy( *spectral );
-
-	float *real = mBufferCopy.getData();
-	float *imag = &mBufferCopy.getData()[mSizeOverTwo];
+	const float *real = spectral->getReal();
+	const float *imag = spectral->getImag();
 	float *a = waveform->getData();
 
-	a[0] = real[0];
-	a[1] = imag[0];
-
-	for( size_t k = 1; k < mSizeOverTwo; k++ ) {
+	for( size_t k = 0; k < mSizeOverTwo; k++ ) {
 		a[k * 2] = real[k];
 		a[k * 2 + 1] = imag[k];
 	}
 
-	ooura::rdft( (int)mSize, -1, a, mOouraIp, mOouraW );
+	ooura::rdft( (int)mSize, -1, a, mPlan->mIp.data(), mPlan->mW.data() );
 	dsp::mul( a, 2.0f / (float)mSize, a, mSize );
 }
 
+// Channels are transformed four at a time by interleaving them into ooura::float4's, with any remaining channels transformed separately.
+void Fft::forward( const Buffer *waveforms, std::vector<BufferSpectral> *spectra )
+{
+	CI_ASSERT( waveforms->getNumFrames() == mSize );
+	CI_ASSERT( spectra->size() >= waveforms->getNumChannels() );
+
+	const size_t numChannels = waveforms->getNumChannels();
+	size_t ch = 0;
+
+	if( numChannels >= 4 ) {
+		auto a = reinterpret_cast<ooura::float4 *>( mBatchBuffer.getData() );
+		ooura::float4 *w = mPlan->getTables4();
+
+		for( ; ch + 4 <= numChannels; ch += 4 ) {
+			const float *in0 = waveforms->getChannel( ch );
+			const float *in1 = waveforms->getChannel( ch + 1 );
+			const float *in2 = waveforms->getChannel( ch + 2 );
+			const float *in3 = waveforms->getChannel( ch + 3 );
+			for( size_t i = 0; i < mSize; i++ )
+				a[i] = ooura::float4( in0[i], in1[i], in2[i], in3[i] );
+
+			ooura::rdft( (int)mSize, 1, a, mPlan->mIp.data(), w );
+
+			float *real[4], *imag[4];
+			for( size_t i = 0; i < 4; i++ ) {
+				CI_ASSERT( (*spectra)[ch + i].getNumFrames() == mSizeOverTwo );
+				real[i] = (*spectra)[ch + i].getReal();
+				imag[i] = (*spectra)[ch + i].getImag();
+			}
+
+			float values[8];
+			for( size_t k = 0; k < mSizeOverTwo; k++ ) {
+				a[k * 2].store( values );
+				a[k * 2 + 1].store( values + 4 );
+				for( size_t i = 0; i < 4; i++ ) {
+					real[i][k] = values[i];
+					imag[i][k] = values[i + 4];
+				}
+			}
+		}
+	}
+
+	for( ; ch < numChannels; ch++ ) {
+		CI_ASSERT( (*spectra)[ch].getNumFrames() == mSizeOverTwo );
+
+		float *a = mBufferCopy.getData();
+		float *real = (*spectra)[ch].getReal();
+		float *imag = (*spectra)[ch].getImag();
+
+		memcpy( a, waveforms->getChannel( ch ), mSize * sizeof( float ) );
+		ooura::rdft( (int)mSize, 1, a, mPlan->mIp.data(), mPlan->mW.data() );
+
+		for( size_t k = 0; k < mSizeOverTwo; k++ ) {
+			real[k] = a[k * 2];
+			imag[k] = a[k * 2 + 1];
+		}
+	}
+}
+
+void Fft::inverse( const std::vector<BufferSpectral> *spectra, Buffer *waveforms )
+{
+	CI_ASSERT( waveforms->getNumFrames() == mSize );
+	CI_ASSERT( spectra->size() >= waveforms->getNumChannels() );
+
+	const size_t numChannels = waveforms->getNumChannels();
+	const float scale = 2.0f / (float)mSize;
+	size_t ch = 0;
+
+	if( numChannels >= 4 ) {
+		auto a = reinterpret_cast<ooura::float4 *>( mBatchBuffer.getData() );
+		ooura::float4 *w = mPlan->getTables4();
+
+		for( ; ch + 4 <= numChannels; ch += 4 ) {
+			const float *real[4], *imag[4];
+			for( size_t i = 0; i < 4; i++ ) {
+				CI_ASSERT( (*spectra)[ch + i].getNumFrames() == mSizeOverTwo );
+				real[i] = (*spectra)[ch + i].getReal();
+				imag[i] = (*spectra)[ch + i].getImag();
+			}
+
+			for( size_t k = 0; k < mSizeOverTwo; k++ ) {
+				a[k * 2] = ooura::float4( real[0][k], real[1][k], real[2][k], real[3][k] );
+				a[k * 2 + 1] = ooura::float4( imag[0][k], imag[1][k], imag[2][k], imag[3][k] );
+			}
+
+			ooura::rdft( (int)mSize, -1, a, mPlan->mIp.data(), w );
+
+			float *out[4];
+			for( size_t i = 0; i < 4; i++ )
+				out[i] = waveforms->getChannel( ch + i );
+
+			float values[4];
+			for( size_t j = 0; j < mSize; j++ ) {
+				( a[j] * ooura::float4( scale ) ).store( values );
+				for( size_t i = 0; i < 4; i++ )
+					out[i][j] = values[i];
+			}
+		}
+	}
+
+	for( ; ch < numChannels; ch++ ) {
+		CI_ASSERT( (*spectra)[ch].getNumFrames() == mSizeOverTwo );
+
+		const float *real = (*spectra)[ch].getReal();
+		const float *imag = (*spectra)[ch].getImag();
+		float *a = waveforms->getChannel( ch );
+
+		for( size_t k = 0; k < mSizeOverTwo; k++ ) {
+			a[k * 2] = real[k];
+			a[k * 2 + 1] = imag[k];
+		}
+
+		ooura::rdft( (int)mSize, -1, a, mPlan->mIp.data(), mPlan->mW.data() );
+		dsp::mul( a, scale, a, mSize );
+	}
+}
+
+// Ooura's cdft() works on interleaved real and imaginary values, and its isgn = -1 case uses the exp( -2 pi i j k / n ) convention.
+void Fft::forwardComplex( const BufferSpectral *input, BufferSpectral *output )
+{
+	CI_ASSERT( input->getNumFrames() == mSize );
+	CI_ASSERT( output->getNumFrames() == mSize );
+
+	const float *inReal = input->getReal();
+	const float *inImag = input->getImag();
+	float *a = mBufferCopy.getData();
+
+	for( size_t k = 0; k < mSize; k++ ) {
+		a[k * 2] = inReal[k];
+		a[k * 2 + 1] = inImag[k];
+	}
+
+	ooura::cdft( (int)mSize * 2, -1, a, mPlan->mIp.data(), mPlan->mW.data() );
+
+	float *outReal = output->getReal();
+	float *outImag = output->getImag();
+	for( size_t k = 0; k < mSize; k++ ) {
+		outReal[k] = a[k * 2];
+		outImag[k] = a[k * 2 + 1];
+	}
+}
+
+void Fft::inverseComplex( const BufferSpectral *input, BufferSpectral *output )
+{
+	CI_ASSERT( input->getNumFrames() == mSize );
+	CI_ASSERT( output->getNumFrames() == mSize );
+
+	const float *inReal = input->getReal();
+	const float *inImag = input->getImag();
+	float *a = mBufferCopy.getData();
+
+	for( size_t k = 0; k < mSize; k++ ) {
+		a[k * 2] = inReal[k];
+		a[k * 2 + 1] = inImag[k];
+	}
+
+	ooura::cdft( (int)mSize * 2, 1, a, mPlan->mIp.data(), mPlan->mW.data() );
+
+	const float scale = 1.0f / (float)mSize;
+	float *outReal = output->getReal();
+	float *outImag = output->getImag();
+	for( size_t k = 0; k < mSize; k++ ) {
+		outReal[k] = a[k * 2] * scale;
+		outImag[k] = a[k * 2 + 1] * scale;
+	}
+}
+
 #endif // defined( CINDER_AUDIO_FFT_OOURA )
 
 } } } // namespace cinder::audio::dsp
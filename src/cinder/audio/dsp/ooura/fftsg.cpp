@@ -3271,4 +3271,7 @@ template void ddst<double>(int n, int isgn, double *a, int *ip, double *w);
 template void dfct<double>(int n, double *a, double *t, int *ip, double *w);
 template void dfst<double>(int n, double *a, double *t, int *ip, double *w);
 
+template void cdft<float4>(int n, int isgn, float4 *a, int *ip, float4 *w);
+template void rdft<float4>(int n, int isgn, float4 *a, int *ip, float4 *w);
+
 } } } } // namespace cinder::audio::dsp::ooura
@@ -342,7 +342,7 @@ TextureFont::TextureFont( const Font &font, const string &utf8Chars, const Forma
 	// get the glyph indices we'll need
 	set<Font::Glyph> glyphs;
 	for( const auto& ch : utf32Chars ) {
-		FT_UInt glyphIndex = FT_Get_Char_Index( face, ch );
+		FT_UInt glyphIndex = font.getGlyphIndex( ch );
 		glyphs.insert( glyphIndex );
 	}
 
@@ -393,8 +393,10 @@ TextureFont::TextureFont( const Font &font, const string &utf8Chars, const Forma
 				FT_UInt glyphIndex = renderGlyphs[i];
 				FT_Vector glyphPos = renderPositions[i];
 				FT_Vector pen = { glyphPos.x*64, glyphPos.y*64 };
+				std::lock_guard<std::mutex> lock( Font::getFreetypeMutex() );
 				FT_Set_Transform( face, nullptr, &pen );
 				FT_Load_Glyph( face, glyphIndex, FT_LOAD_RENDER );
+				FT_Set_Transform( face, nullptr, nullptr );
 				FT_GlyphSlot slot = face->glyph;
 				ivec2 drawOffset = ivec2( slot->bitmap_left, surfaceSize.y - slot->bitmap_top );
 				ci::linux::ftutil::DrawBitmap( drawOffset, &(slot->bitmap), white, surfaceData, surfacePixelInc, surfaceRowBytes, surfaceSize );
@@ -23,6 +23,7 @@
 
 #include "cinder/ip/Blend.h"
 #include "cinder/ip/Fill.h"
+#include "cinder/ip/Execution.h"
 
 using namespace std;
 
@@ -61,52 +62,54 @@ void blendImpl_u8( Surface8u *background, const Surface8u &foreground, const Are
 		return;
 	}
 	
-	for( int32_t y = 0; y < srcArea.getHeight(); ++y ) {
-		const uint8_t *src = reinterpret_cast<const uint8_t*>( reinterpret_cast<const uint8_t*>( foreground.getData() + srcArea.x1 * 4 ) + ( srcArea.y1 + y ) * srcRowBytes );
-		uint8_t *dst = reinterpret_cast<uint8_t*>( reinterpret_cast<uint8_t*>( background->getData() + absOffset.x * 4 ) + ( y + absOffset.y ) * dstRowBytes );
-		for( int32_t x = 0; x < width; ++x ) {
-			const uint8_t alphaS = (SRCALPHA) ? src[sA] : 255;
-			const uint8_t invAlphaS = (SRCALPHA) ? CHANTRAIT<uint8_t>::inverse(src[sA]) : 0;
-			const uint8_t alphaD = (DSTALPHA) ? dst[dA] : CHANTRAIT<uint8_t>::max();
-			const uint8_t invAlphaD = (DSTALPHA) ? CHANTRAIT<uint8_t>::inverse(dst[dA]) : 0;
-			if( DSTALPHA )
-				dst[dA] = 255 - invAlphaS * invAlphaD / 255;			
-			if( ( ! DSTALPHA ) || dst[dA] ) {
-				if( ! DSTALPHA && ! SRCPREMULT ) { // none * unpremult -> none
-					dst[dR] = ( invAlphaS * dst[dR] + alphaS * src[sR] ) / 255;
-					dst[dG] = ( invAlphaS * dst[dG] + alphaS * src[sG] ) / 255;
-					dst[dB] = ( invAlphaS * dst[dB] + alphaS * src[sB] ) / 255;
-				}			
-				else if( ! DSTALPHA && SRCPREMULT ) { // none * premult -> none
-					dst[dR] = invAlphaS * dst[dR] / 255 + src[sR];
-					dst[dG] = invAlphaS * dst[dG] / 255 + src[sG];
-					dst[dB] = invAlphaS * dst[dB] / 255 + src[sB];
-				}
-				else if( ! DSTPREMULT && ! SRCPREMULT ) { // unpremult * unpremult -> unpremult
-					dst[dR] = ( invAlphaS * alphaD * dst[dR] + invAlphaD * alphaS * src[sR] + alphaD * alphaS * src[sR] ) / ( 255 * dst[dA] );
-					dst[dG] = ( invAlphaS * alphaD * dst[dG] + invAlphaD * alphaS * src[sG] + alphaD * alphaS * src[sG] ) / ( 255 * dst[dA] );
-					dst[dB] = ( invAlphaS * alphaD * dst[dB] + invAlphaD * alphaS * src[sB] + alphaD * alphaS * src[sB] ) / ( 255 * dst[dA] );
-				}
-				else if( ! DSTPREMULT && SRCPREMULT ) { // unpremult * premult -> unpremult
-					dst[dR] = ( invAlphaS * alphaD * dst[dR] / 255 + invAlphaD * src[sR] + alphaD * src[sR] ) / dst[dA];
-					dst[dG] = ( invAlphaS * alphaD * dst[dG] / 255 + invAlphaD * src[sG] + alphaD * src[sG] ) / dst[dA];
-					dst[dB] = ( invAlphaS * alphaD * dst[dB] / 255 + invAlphaD * src[sB] + alphaD * src[sB] ) / dst[dA];
-				}
-				else if( DSTPREMULT && SRCPREMULT ) { // premult * premult -> premult
-					dst[dR] = ( invAlphaS * dst[dR] + invAlphaD * src[sR] + alphaD * src[sR] ) / 255;
-					dst[dG] = ( invAlphaS * dst[dG] + invAlphaD * src[sG] + alphaD * src[sG] ) / 255;
-					dst[dB] = ( invAlphaS * dst[dB] + invAlphaD * src[sB] + alphaD * src[sB] ) / 255;
-				}
-				else if( DSTPREMULT && ! SRCPREMULT ) { // premult * unpremult -> premult
-					dst[dR] = ( invAlphaS * dst[dR] + ( invAlphaD * alphaS * src[sR] + alphaD * alphaS * src[sR] ) / 255 ) / 255;
-					dst[dG] = ( invAlphaS * dst[dG] + ( invAlphaD * alphaS * src[sG] + alphaD * alphaS * src[sG] ) / 255 ) / 255;
-					dst[dB] = ( invAlphaS * dst[dB] + ( invAlphaD * alphaS * src[sB] + alphaD * alphaS * src[sB] ) / 255 ) / 255;
+	parallelForRows( Area( 0, 0, width, srcArea.getHeight() ), [&]( const Area &band ) {
+		for( int32_t y = band.getY1(); y < band.getY2(); ++y ) {
+			const uint8_t *src = reinterpret_cast<const uint8_t*>( reinterpret_cast<const uint8_t*>( foreground.getData() + srcArea.x1 * 4 ) + ( srcArea.y1 + y ) * srcRowBytes );
+			uint8_t *dst = reinterpret_cast<uint8_t*>( reinterpret_cast<uint8_t*>( background->getData() + absOffset.x * 4 ) + ( y + absOffset.y ) * dstRowBytes );
+			for( int32_t x = 0; x < width; ++x ) {
+				const uint8_t alphaS = (SRCALPHA) ? src[sA] : 255;
+				const uint8_t invAlphaS = (SRCALPHA) ? CHANTRAIT<uint8_t>::inverse(src[sA]) : 0;
+				const uint8_t alphaD = (DSTALPHA) ? dst[dA] : CHANTRAIT<uint8_t>::max();
+				const uint8_t invAlphaD = (DSTALPHA) ? CHANTRAIT<uint8_t>::inverse(dst[dA]) : 0;
+				if( DSTALPHA )
+					dst[dA] = 255 - invAlphaS * invAlphaD / 255;			
+				if( ( ! DSTALPHA ) || dst[dA] ) {
+					if( ! DSTALPHA && ! SRCPREMULT ) { // none * unpremult -> none
+						dst[dR] = ( invAlphaS * dst[dR] + alphaS * src[sR] ) / 255;
+						dst[dG] = ( invAlphaS * dst[dG] + alphaS * src[sG] ) / 255;
+						dst[dB] = ( invAlphaS * dst[dB] + alphaS * src[sB] ) / 255;
+					}			
+					else if( ! DSTALPHA && SRCPREMULT ) { // none * premult -> none
+						dst[dR] = invAlphaS * dst[dR] / 255 + src[sR];
+						dst[dG] = invAlphaS * dst[dG] / 255 + src[sG];
+						dst[dB] = invAlphaS * dst[dB] / 255 + src[sB];
+					}
+					else if( ! DSTPREMULT && ! SRCPREMULT ) { // unpremult * unpremult -> unpremult
+						dst[dR] = ( invAlphaS * alphaD * dst[dR] + invAlphaD * alphaS * src[sR] + alphaD * alphaS * src[sR] ) / ( 255 * dst[dA] );
+						dst[dG] = ( invAlphaS * alphaD * dst[dG] + invAlphaD * alphaS * src[sG] + alphaD * alphaS * src[sG] ) / ( 255 * dst[dA] );
+						dst[dB] = ( invAlphaS * alphaD * dst[dB] + invAlphaD * alphaS * src[sB] + alphaD * alphaS * src[sB] ) / ( 255 * dst[dA] );
+					}
+					else if( ! DSTPREMULT && SRCPREMULT ) { // unpremult * premult -> unpremult
+						dst[dR] = ( invAlphaS * alphaD * dst[dR] / 255 + invAlphaD * src[sR] + alphaD * src[sR] ) / dst[dA];
+						dst[dG] = ( invAlphaS * alphaD * dst[dG] / 255 + invAlphaD * src[sG] + alphaD * src[sG] ) / dst[dA];
+						dst[dB] = ( invAlphaS * alphaD * dst[dB] / 255 + invAlphaD * src[sB] + alphaD * src[sB] ) / dst[dA];
+					}
+					else if( DSTPREMULT && SRCPREMULT ) { // premult * premult -> premult
+						dst[dR] = ( invAlphaS * dst[dR] + invAlphaD * src[sR] + alphaD * src[sR] ) / 255;
+						dst[dG] = ( invAlphaS * dst[dG] + invAlphaD * src[sG] + alphaD * src[sG] ) / 255;
+						dst[dB] = ( invAlphaS * dst[dB] + invAlphaD * src[sB] + alphaD * src[sB] ) / 255;
+					}
+					else if( DSTPREMULT && ! SRCPREMULT ) { // premult * unpremult -> premult
+						dst[dR] = ( invAlphaS * dst[dR] + ( invAlphaD * alphaS * src[sR] + alphaD * alphaS * src[sR] ) / 255 ) / 255;
+						dst[dG] = ( invAlphaS * dst[dG] + ( invAlphaD * alphaS * src[sG] + alphaD * alphaS * src[sG] ) / 255 ) / 255;
+						dst[dB] = ( invAlphaS * dst[dB] + ( invAlphaD * alphaS * src[sB] + alphaD * alphaS * src[sB] ) / 255 ) / 255;
+					}
 				}
+				src += srcInc;
+				dst += dstInc;
 			}
-			src += srcInc;
-			dst += dstInc;
 		}
-	}
+	} );
 }
 
 template<bool DSTALPHA, bool DSTPREMULT, bool SRCPREMULT>
@@ -135,54 +138,56 @@ void blendImpl_float( Surface32f *background, const Surface32f &foreground, cons
 		return;
 	}
 	
-	for( int32_t y = 0; y < srcArea.getHeight(); ++y ) {
-		const float *src = reinterpret_cast<const float*>( reinterpret_cast<const uint8_t*>( foreground.getData() + srcArea.x1 * 4 ) + ( srcArea.y1 + y ) * srcRowBytes );
-		float *dst = reinterpret_cast<float*>( reinterpret_cast<uint8_t*>( background->getData() + absOffset.x * 4 ) + ( y + absOffset.y ) * dstRowBytes );
-		for( int32_t x = 0; x < width; ++x ) {
-			const float alphaS = (SRCALPHA) ? src[sA] : 1;
-			const float invAlphaS = (SRCALPHA) ? CHANTRAIT<float>::inverse(src[sA]) : 0;
-			const float alphaD = (DSTALPHA) ? dst[dA] : CHANTRAIT<float>::max();
-			const float invAlphaD = (DSTALPHA) ? CHANTRAIT<float>::inverse(dst[dA]) : 0;
-			if( DSTALPHA )
-				dst[dA] = 1 - invAlphaS * invAlphaD;
-			if( ( ! DSTALPHA ) || dst[dA] ) {
-				if( ! DSTALPHA && ! SRCPREMULT ) { // none * unpremult -> none
-					dst[dR] = invAlphaS * dst[dR] + alphaS * src[sR];
-					dst[dG] = invAlphaS * dst[dG] + alphaS * src[sG];
-					dst[dB] = invAlphaS * dst[dB] + alphaS * src[sB];
-				}			
-				else if( ! DSTALPHA && SRCPREMULT ) { // none * premult -> none
-					dst[dR] = invAlphaS * dst[dR] + src[sR];
-					dst[dG] = invAlphaS * dst[dG] + src[sG];
-					dst[dB] = invAlphaS * dst[dB] + src[sB];
-				}
-				else if( ! DSTPREMULT && ! SRCPREMULT ) { // unpremult * unpremult -> unpremult
-					float invDstA = 1.0f / dst[dA];
-					dst[dR] = ( invAlphaS * alphaD * dst[dR] + invAlphaD * alphaS * src[sR] + alphaD * alphaS * src[sR] ) * invDstA;
-					dst[dG] = ( invAlphaS * alphaD * dst[dG] + invAlphaD * alphaS * src[sG] + alphaD * alphaS * src[sG] ) * invDstA;
-					dst[dB] = ( invAlphaS * alphaD * dst[dB] + invAlphaD * alphaS * src[sB] + alphaD * alphaS * src[sB] ) * invDstA;
-				}
-				else if( ! DSTPREMULT && SRCPREMULT ) { // unpremult * premult -> unpremult
-					float invDstA = 1.0f / dst[dA];
-					dst[dR] = ( invAlphaS * alphaD * dst[dR] + invAlphaD * src[sR] + alphaD * src[sR] ) * invDstA;
-					dst[dG] = ( invAlphaS * alphaD * dst[dG] + invAlphaD * src[sG] + alphaD * src[sG] ) * invDstA;
-					dst[dB] = ( invAlphaS * alphaD * dst[dB] + invAlphaD * src[sB] + alphaD * src[sB] ) * invDstA;
-				}
-				else if( DSTPREMULT && SRCPREMULT ) { // premult * premult -> premult
-					dst[dR] = invAlphaS * dst[dR] + invAlphaD * src[sR] + alphaD * src[sR];
-					dst[dG] = invAlphaS * dst[dG] + invAlphaD * src[sG] + alphaD * src[sG];
-					dst[dB] = invAlphaS * dst[dB] + invAlphaD * src[sB] + alphaD * src[sB];
-				}
-				else if( DSTPREMULT && ! SRCPREMULT ) { // premult * unpremult -> premult
-					dst[dR] = invAlphaS * dst[dR] + invAlphaD * alphaS * src[sR] + alphaD * alphaS * src[sR];
-					dst[dG] = invAlphaS * dst[dG] + invAlphaD * alphaS * src[sG] + alphaD * alphaS * src[sG];
-					dst[dB] = invAlphaS * dst[dB] + invAlphaD * alphaS * src[sB] + alphaD * alphaS * src[sB];
+	parallelForRows( Area( 0, 0, width, srcArea.getHeight() ), [&]( const Area &band ) {
+		for( int32_t y = band.getY1(); y < band.getY2(); ++y ) {
+			const float *src = reinterpret_cast<const float*>( reinterpret_cast<const uint8_t*>( foreground.getData() + srcArea.x1 * 4 ) + ( srcArea.y1 + y ) * srcRowBytes );
+			float *dst = reinterpret_cast<float*>( reinterpret_cast<uint8_t*>( background->getData() + absOffset.x * 4 ) + ( y + absOffset.y ) * dstRowBytes );
+			for( int32_t x = 0; x < width; ++x ) {
+				const float alphaS = (SRCALPHA) ? src[sA] : 1;
+				const float invAlphaS = (SRCALPHA) ? CHANTRAIT<float>::inverse(src[sA]) : 0;
+				const float alphaD = (DSTALPHA) ? dst[dA] : CHANTRAIT<float>::max();
+				const float invAlphaD = (DSTALPHA) ? CHANTRAIT<float>::inverse(dst[dA]) : 0;
+				if( DSTALPHA )
+					dst[dA] = 1 - invAlphaS * invAlphaD;
+				if( ( ! DSTALPHA ) || dst[dA] ) {
+					if( ! DSTALPHA && ! SRCPREMULT ) { // none * unpremult -> none
+						dst[dR] = invAlphaS * dst[dR] + alphaS * src[sR];
+						dst[dG] = invAlphaS * dst[dG] + alphaS * src[sG];
+						dst[dB] = invAlphaS * dst[dB] + alphaS * src[sB];
+					}			
+					else if( ! DSTALPHA && SRCPREMULT ) { // none * premult -> none
+						dst[dR] = invAlphaS * dst[dR] + src[sR];
+						dst[dG] = invAlphaS * dst[dG] + src[sG];
+						dst[dB] = invAlphaS * dst[dB] + src[sB];
+					}
+					else if( ! DSTPREMULT && ! SRCPREMULT ) { // unpremult * unpremult -> unpremult
+						float invDstA = 1.0f / dst[dA];
+						dst[dR] = ( invAlphaS * alphaD * dst[dR] + invAlphaD * alphaS * src[sR] + alphaD * alphaS * src[sR] ) * invDstA;
+						dst[dG] = ( invAlphaS * alphaD * dst[dG] + invAlphaD * alphaS * src[sG] + alphaD * alphaS * src[sG] ) * invDstA;
+						dst[dB] = ( invAlphaS * alphaD * dst[dB] + invAlphaD * alphaS * src[sB] + alphaD * alphaS * src[sB] ) * invDstA;
+					}
+					else if( ! DSTPREMULT && SRCPREMULT ) { // unpremult * premult -> unpremult
+						float invDstA = 1.0f / dst[dA];
+						dst[dR] = ( invAlphaS * alphaD * dst[dR] + invAlphaD * src[sR] + alphaD * src[sR] ) * invDstA;
+						dst[dG] = ( invAlphaS * alphaD * dst[dG] + invAlphaD * src[sG] + alphaD * src[sG] ) * invDstA;
+						dst[dB] = ( invAlphaS * alphaD * dst[dB] + invAlphaD * src[sB] + alphaD * src[sB] ) * invDstA;
+					}
+					else if( DSTPREMULT && SRCPREMULT ) { // premult * premult -> premult
+						dst[dR] = invAlphaS * dst[dR] + invAlphaD * src[sR] + alphaD * src[sR];
+						dst[dG] = invAlphaS * dst[dG] + invAlphaD * src[sG] + alphaD * src[sG];
+						dst[dB] = invAlphaS * dst[dB] + invAlphaD * src[sB] + alphaD * src[sB];
+					}
+					else if( DSTPREMULT && ! SRCPREMULT ) { // premult * unpremult -> premult
+						dst[dR] = invAlphaS * dst[dR] + invAlphaD * alphaS * src[sR] + alphaD * alphaS * src[sR];
+						dst[dG] = invAlphaS * dst[dG] + invAlphaD * alphaS * src[sG] + alphaD * alphaS * src[sG];
+						dst[dB] = invAlphaS * dst[dB] + invAlphaD * alphaS * src[sB] + alphaD * alphaS * src[sB];
+					}
 				}
+				src += srcInc;
+				dst += dstInc;
 			}
-			src += srcInc;
-			dst += dstInc;
 		}
-	}
+	} );
 }
 
 void blend( Surface8u *background, const Surface8u &foreground, const Area &srcArea, const ivec2 &dstRelativeOffset )
@@ -21,6 +21,7 @@
 */
 
 #include "cinder/ip/Blur.h"
+#include "cinder/ip/Execution.h"
 
 namespace cinder { namespace ip { 
 
@@ -75,135 +76,147 @@ void stackBlur_impl( const IMAGET &srcSurface, IMAGET *dstSurface, const Area &a
 	srcPixelData += getPixelDataOffset( srcSurface );
 	dstPixelData += getPixelDataOffset( *dstSurface );
 
-	std::unique_ptr<SUMT[]> stack( new SUMT[div*CHANNELS] );
 	SUMT *tempPixelData = (SUMT*)malloc(width * height * sizeof(SUMT) * CHANNELS);
 	SUMT *channelData = tempPixelData;
 
-	SUMT *sir;
-	SUMT inSum[CHANNELS], outSum[CHANNELS], sum[CHANNELS];
-	int32_t p, yp;
-	int stackPointer, rbs;
-    
-	int yi = 0;
-	for( int32_t y = 0; y < height; y++ ) {
-		for( int c = 0; c < CHANNELS; ++c )
-			inSum[c] = outSum[c] = sum[c] = 0;
-		
-		for( int32_t i = -radius;i <= radius; i++ ) {
-			sir = &stack[(i + radius)*CHANNELS];
-			size_t offset = y * srcRowInc + std::min(widthMinusOne, std::max(i, 0)) * srcPixelInc;
-			rbs = radiusPlusOne - abs(i);
-			for( int c = 0; c < CHANNELS; ++c )
-				sir[c] = srcPixelData[offset + c];
-		
+	// horizontal pass from the source into tempPixelData, in bands of rows
+	parallelForRows( Area( 0, 0, width, height ), [&]( const Area &band ) {
+		std::unique_ptr<SUMT[]> stack( new SUMT[div*CHANNELS] );
+		SUMT *sir;
+		SUMT inSum[CHANNELS], outSum[CHANNELS], sum[CHANNELS];
+		int stackPointer, rbs;
+
+		int yi = band.getY1() * width;
+		for( int32_t y = band.getY1(); y < band.getY2(); y++ ) {
 			for( int c = 0; c < CHANNELS; ++c )
-				sum[c] += sir[c] * rbs;
-			if( i > 0 )
+				inSum[c] = outSum[c] = sum[c] = 0;
+			
+			for( int32_t i = -radius;i <= radius; i++ ) {
+				sir = &stack[(i + radius)*CHANNELS];
+				size_t offset = y * srcRowInc + std::min(widthMinusOne, std::max(i, 0)) * srcPixelInc;
+				rbs = radiusPlusOne - abs(i);
 				for( int c = 0; c < CHANNELS; ++c )
-					inSum[c] += sir[c];
-			else
+					sir[c] = srcPixelData[offset + c];
+			
 				for( int c = 0; c < CHANNELS; ++c )
-					outSum[c] += sir[c];
-		}
-		stackPointer = radius;
-		
-		for( int32_t x = 0; x < width; x++ ) {
-			for( int c = 0; c < CHANNELS; ++c ) {
-				if( std::is_integral<SUMT>::value )
-					channelData[c+yi*CHANNELS] = sum[c] / divisor;
+					sum[c] += sir[c] * rbs;
+				if( i > 0 )
+					for( int c = 0; c < CHANNELS; ++c )
+						inSum[c] += sir[c];
 				else
-					channelData[c+yi*CHANNELS] = sum[c] * invDivisor;
-				sum[c] -= outSum[c];
-			}
-			
-			int stackStart = stackPointer - radius + div;
-			sir = &stack[(stackStart % div)*CHANNELS];
-			
-			for( int c = 0; c < CHANNELS; ++c )
-				outSum[c] -= sir[c];
-			
-			size_t offset = y * srcRowInc + std::min(x + radius + 1, widthMinusOne) * srcPixelInc;
-			for( int c = 0; c < CHANNELS; ++c ) {
-				sir[c] = srcPixelData[offset+c];
-				inSum[c] += sir[c];
-				sum[c] += inSum[c];
+					for( int c = 0; c < CHANNELS; ++c )
+						outSum[c] += sir[c];
 			}
+			stackPointer = radius;
 			
-			stackPointer = (stackPointer + 1) % div;
-			sir = &stack[stackPointer*CHANNELS];
+			for( int32_t x = 0; x < width; x++ ) {
+				for( int c = 0; c < CHANNELS; ++c ) {
+					if( std::is_integral<SUMT>::value )
+						channelData[c+yi*CHANNELS] = sum[c] / divisor;
+					else
+						channelData[c+yi*CHANNELS] = sum[c] * invDivisor;
+					sum[c] -= outSum[c];
+				}
+				
+				int stackStart = stackPointer - radius + div;
+				sir = &stack[(stackStart % div)*CHANNELS];
+				
+				for( int c = 0; c < CHANNELS; ++c )
+					outSum[c] -= sir[c];
+				
+				size_t offset = y * srcRowInc + std::min(x + radius + 1, widthMinusOne) * srcPixelInc;
+				for( int c = 0; c < CHANNELS; ++c ) {
+					sir[c] = srcPixelData[offset+c];
+					inSum[c] += sir[c];
+					sum[c] += inSum[c];
+				}
+				
+				stackPointer = (stackPointer + 1) % div;
+				sir = &stack[stackPointer*CHANNELS];
 
-			for( int c = 0; c < CHANNELS; ++c ) {
-				outSum[c] += sir[c];
-				inSum[c] -= sir[c];
+				for( int c = 0; c < CHANNELS; ++c ) {
+					outSum[c] += sir[c];
+					inSum[c] -= sir[c];
+				}
+				
+				yi++;
 			}
-			
-			yi++;
 		}
-	}
-    
-	for( int32_t x = 0; x < width; x++ ) {
-		for( int c = 0; c < CHANNELS; ++c )
-			inSum[c] = outSum[c] = sum[c] = 0;
-
-		yp = -radius * width;
-		for( int i = -radius; i <= radius; i++ ) {
-			yi = std::max(0, yp) + x;
-			
-			sir = &stack[(i + radius)*CHANNELS];
-			
+	} );
+
+	// vertical pass from tempPixelData into the destination, in bands of columns which each read their whole height
+	const int32_t minColumnsPerTask = int32_t( getExecutionPolicy().getMinPixelsPerTask() / std::max( height, 1 ) );
+	parallelFor( 0, width, minColumnsPerTask, [&]( int32_t x1, int32_t x2 ) {
+		std::unique_ptr<SUMT[]> stack( new SUMT[div*CHANNELS] );
+		SUMT *sir;
+		SUMT inSum[CHANNELS], outSum[CHANNELS], sum[CHANNELS];
+		int32_t p, yp;
+		int stackPointer, rbs;
+
+		for( int32_t x = x1; x < x2; x++ ) {
 			for( int c = 0; c < CHANNELS; ++c )
-				sir[c] = channelData[c+yi*CHANNELS];
-			
-			rbs = radiusPlusOne - abs(i);
-			
-			for( int c = 0; c < CHANNELS; ++c )
-				sum[c] += channelData[c+yi*CHANNELS] * rbs;
-			
-			if( i > 0 )
+				inSum[c] = outSum[c] = sum[c] = 0;
+
+			yp = -radius * width;
+			for( int i = -radius; i <= radius; i++ ) {
+				int yi = std::max(0, yp) + x;
+				
+				sir = &stack[(i + radius)*CHANNELS];
+				
 				for( int c = 0; c < CHANNELS; ++c )
-					inSum[c] += sir[c];
-			else
+					sir[c] = channelData[c+yi*CHANNELS];
+				
+				rbs = radiusPlusOne - abs(i);
+				
 				for( int c = 0; c < CHANNELS; ++c )
-					outSum[c] += sir[c];
-			
-			if( i < heightMinusOne )
-				yp += width;
-		}
-		size_t offset = x * dstPixelInc;
-		stackPointer = radius;
-		for( int32_t y = 0; y < height; y++) {
-			for( int c = 0; c < CHANNELS; ++c ) {
-				if( std::is_integral<SUMT>::value )
-					dstPixelData[offset + c] = (T)(sum[c] / divisor);
+					sum[c] += channelData[c+yi*CHANNELS] * rbs;
+				
+				if( i > 0 )
+					for( int c = 0; c < CHANNELS; ++c )
+						inSum[c] += sir[c];
 				else
-					dstPixelData[offset + c] = (T)(sum[c] * invDivisor);
-				sum[c] -= outSum[c];
+					for( int c = 0; c < CHANNELS; ++c )
+						outSum[c] += sir[c];
+				
+				if( i < heightMinusOne )
+					yp += width;
 			}
-			
-			int stackStart = stackPointer - radius + div;
-			sir = &stack[(stackStart % div)*CHANNELS];
-			
-			for( int c = 0; c < CHANNELS; ++c )
-				outSum[c] -= sir[c];
-			
-			p = x + std::min( y + radiusPlusOne, heightMinusOne ) * width;
-			
-			for( int c = 0; c < CHANNELS; ++c ) {
-				sir[c] = channelData[c+p*CHANNELS];
-				inSum[c] += sir[c];
-				sum[c] += inSum[c];
+			size_t offset = x * dstPixelInc;
+			stackPointer = radius;
+			for( int32_t y = 0; y < height; y++) {
+				for( int c = 0; c < CHANNELS; ++c ) {
+					if( std::is_integral<SUMT>::value )
+						dstPixelData[offset + c] = (T)(sum[c] / divisor);
+					else
+						dstPixelData[offset + c] = (T)(sum[c] * invDivisor);
+					sum[c] -= outSum[c];
+				}
+				
+				int stackStart = stackPointer - radius + div;
+				sir = &stack[(stackStart % div)*CHANNELS];
+				
+				for( int c = 0; c < CHANNELS; ++c )
+					outSum[c] -= sir[c];
+				
+				p = x + std::min( y + radiusPlusOne, heightMinusOne ) * width;
+				
+				for( int c = 0; c < CHANNELS; ++c ) {
+					sir[c] = channelData[c+p*CHANNELS];
+					inSum[c] += sir[c];
+					sum[c] += inSum[c];
+				}
+				
+				stackPointer = (stackPointer + 1) % div;
+				sir = &stack[stackPointer*CHANNELS];
+
+				for( int c = 0; c < CHANNELS; ++c ) {
+					outSum[c] += sir[c];
+					inSum[c] -= sir[c];
+				}			
+				offset += dstRowInc;
 			}
-			
-			stackPointer = (stackPointer + 1) % div;
-			sir = &stack[stackPointer*CHANNELS];
-
-			for( int c = 0; c < CHANNELS; ++c ) {
-				outSum[c] += sir[c];
-				inSum[c] -= sir[c];
-			}			
-			offset += dstRowInc;
 		}
-	}
+	} );
 
 	free( tempPixelData );
 }
@@ -21,6 +21,7 @@
 */
 
 #include "cinder/ip/Checkerboard.h"
+#include "cinder/ip/Execution.h"
 
 namespace cinder { namespace ip { 
 
@@ -33,17 +34,19 @@ void checkerboard_impl( SurfaceT<T> *surface, const Area &area, int32_t tileSize
 	ptrdiff_t rowBytes = surface->getRowBytes();
 	uint8_t pixelInc = surface->getPixelInc();
 	uint8_t redOffset = surface->getRedOffset(), greenOffset = surface->getGreenOffset(), blueOffset = surface->getBlueOffset();
-	for( int32_t y = clippedArea.getY1(); y < clippedArea.getY2(); ++y ) {
-		T *dstPtr = reinterpret_cast<T*>( reinterpret_cast<uint8_t*>( surface->getData() + clippedArea.getX1() * pixelInc ) + y * rowBytes );
-		const int32_t yBit = ( ( y - clippedArea.getY1() ) / tileSize ) & 1;
-		for( int32_t x = 0; x < clippedArea.getWidth(); ++x ) {
-			const ColorT<T> &color = ((( x / tileSize ) & 1) ^ yBit ) ? evenColor : oddColor;
-			dstPtr[redOffset] = color.r;
-			dstPtr[greenOffset] = color.g;
-			dstPtr[blueOffset] = color.b;
-			dstPtr += pixelInc;
+	parallelForRows( clippedArea, [&]( const Area &band ) {
+		for( int32_t y = band.getY1(); y < band.getY2(); ++y ) {
+			T *dstPtr = reinterpret_cast<T*>( reinterpret_cast<uint8_t*>( surface->getData() + clippedArea.getX1() * pixelInc ) + y * rowBytes );
+			const int32_t yBit = ( ( y - clippedArea.getY1() ) / tileSize ) & 1;
+			for( int32_t x = 0; x < clippedArea.getWidth(); ++x ) {
+				const ColorT<T> &color = ((( x / tileSize ) & 1) ^ yBit ) ? evenColor : oddColor;
+				dstPtr[redOffset] = color.r;
+				dstPtr[greenOffset] = color.g;
+				dstPtr[blueOffset] = color.b;
+				dstPtr += pixelInc;
+			}
 		}
-	}
+	} );
 }
 
 template<typename T>
@@ -60,18 +63,20 @@ void checkerboard_impl( SurfaceT<T> *surface, const Area &area, int32_t tileSize
 	ptrdiff_t rowBytes = surface->getRowBytes();
 	uint8_t pixelInc = surface->getPixelInc();
 	uint8_t redOffset = surface->getRedOffset(), greenOffset = surface->getGreenOffset(), blueOffset = surface->getBlueOffset(), alphaOffset = surface->getAlphaOffset();
-	for( int32_t y = clippedArea.getY1(); y < clippedArea.getY2(); ++y ) {
-		T *dstPtr = reinterpret_cast<T*>( reinterpret_cast<uint8_t*>( surface->getData() + clippedArea.getX1() * pixelInc ) + y * rowBytes );
-		const int32_t yBit = ( ( y - clippedArea.getY1() ) / tileSize ) & 1;
-		for( int32_t x = 0; x < clippedArea.getWidth(); ++x ) {
-			const ColorAT<T> &color = ((( x / tileSize ) & 1) ^ yBit ) ? evenColor : oddColor;
-			dstPtr[redOffset] = color.r;
-			dstPtr[greenOffset] = color.g;
-			dstPtr[blueOffset] = color.b;
-			dstPtr[alphaOffset] = color.a;
-			dstPtr += pixelInc;
+	parallelForRows( clippedArea, [&]( const Area &band ) {
+		for( int32_t y = band.getY1(); y < band.getY2(); ++y ) {
+			T *dstPtr = reinterpret_cast<T*>( reinterpret_cast<uint8_t*>( surface->getData() + clippedArea.getX1() * pixelInc ) + y * rowBytes );
+			const int32_t yBit = ( ( y - clippedArea.getY1() ) / tileSize ) & 1;
+			for( int32_t x = 0; x < clippedArea.getWidth(); ++x ) {
+				const ColorAT<T> &color = ((( x / tileSize ) & 1) ^ yBit ) ? evenColor : oddColor;
+				dstPtr[redOffset] = color.r;
+				dstPtr[greenOffset] = color.g;
+				dstPtr[blueOffset] = color.b;
+				dstPtr[alphaOffset] = color.a;
+				dstPtr += pixelInc;
+			}
 		}
-	}
+	} );
 }
 } // anonymous namespace
 
@@ -21,6 +21,7 @@
 */
 
 #include "cinder/ip/EdgeDetect.h"
+#include "cinder/ip/Execution.h"
 #include "cinder/Surface.h"
 #include "cinder/CinderMath.h"
 
@@ -30,6 +31,7 @@ namespace cinder { namespace ip {
 // -1  0  1     1  2  1
 // -2  0  2     0  0  0
 // -1  0  1    -1 -2 -1
+// Rows are processed in parallel bands, each reading one row past its top and bottom edges from the source.
 // NOTE: this leaves garbage in the top and bottom rows, as well as the left and right columns
 
 template<typename T>
@@ -38,28 +40,30 @@ void edgeDetectSobel( const ChannelT<T> &srcChannel, const Area &srcArea, const
 	std::pair<Area,ivec2> srcDst = clippedSrcDst( srcChannel.getBounds(), srcArea, dstChannel->getBounds(), dstLT );
 	const Area &area( srcDst.first );
 	const ivec2 &dstOffset( srcDst.second );
-	typename CHANTRAIT<T>::SignedSum sumX, sumY;
 
 	ptrdiff_t srcRowInc = srcChannel.getRowBytes() / sizeof(T);
 	uint8_t srcPixelInc = srcChannel.getIncrement();
 	uint8_t dstPixelInc = dstChannel->getIncrement();
 	const T maxValue = CHANTRAIT<T>::max();
-	for( int32_t y = 1; y < area.getHeight() - 1; ++y ) {
-		const T *srcLine = srcChannel.getData( area.getX1() + 1, area.getY1() + y );
-		T *dstLine = dstChannel->getData( dstOffset.x + area.getX1() + 1, dstOffset.y + y );
-		for( int32_t x = area.getX1() + 1; x < area.getX2() - 1; ++x ) {
-			sumX = -*(srcLine-srcRowInc-srcPixelInc) + *(srcLine-srcRowInc+srcPixelInc) - 2 * *(srcLine-srcPixelInc)
-							+ 2 * *(srcLine+srcPixelInc) - *(srcLine+srcRowInc-srcPixelInc) + *(srcLine+srcRowInc+srcPixelInc);
-			sumY = *(srcLine-srcRowInc-srcPixelInc) + 2 * *(srcLine-srcRowInc) + *(srcLine-srcRowInc+srcPixelInc)
-							- *(srcLine+srcRowInc-srcPixelInc) - 2 * *(srcLine+srcPixelInc) - *(srcLine+srcRowInc+srcPixelInc);
-			sumX = (typename CHANTRAIT<T>::SignedSum)math<float>::sqrt( (float)sumX * sumX + (float)sumY * sumY );
-			if( sumX > maxValue )
-				sumX = maxValue;
-			*dstLine = static_cast<T>( sumX );
-			dstLine += dstPixelInc;
-			srcLine += srcPixelInc;
+	parallelForRows( Area( 0, 1, area.getWidth(), area.getHeight() - 1 ), [&]( const Area &band ) {
+		for( int32_t y = band.getY1(); y < band.getY2(); ++y ) {
+			const T *srcLine = srcChannel.getData( area.getX1() + 1, area.getY1() + y );
+			T *dstLine = dstChannel->getData( dstOffset.x + area.getX1() + 1, dstOffset.y + y );
+			for( int32_t x = area.getX1() + 1; x < area.getX2() - 1; ++x ) {
+				typename CHANTRAIT<T>::SignedSum sumX, sumY;
+				sumX = -*(srcLine-srcRowInc-srcPixelInc) + *(srcLine-srcRowInc+srcPixelInc) - 2 * *(srcLine-srcPixelInc)
+								+ 2 * *(srcLine+srcPixelInc) - *(srcLine+srcRowInc-srcPixelInc) + *(srcLine+srcRowInc+srcPixelInc);
+				sumY = *(srcLine-srcRowInc-srcPixelInc) + 2 * *(srcLine-srcRowInc) + *(srcLine-srcRowInc+srcPixelInc)
+								- *(srcLine+srcRowInc-srcPixelInc) - 2 * *(srcLine+srcPixelInc) - *(srcLine+srcRowInc+srcPixelInc);
+				sumX = (typename CHANTRAIT<T>::SignedSum)math<float>::sqrt( (float)sumX * sumX + (float)sumY * sumY );
+				if( sumX > maxValue )
+					sumX = maxValue;
+				*dstLine = static_cast<T>( sumX );
+				dstLine += dstPixelInc;
+				srcLine += srcPixelInc;
+			}
 		}
-	}
+	}, 1 );
 }
 
 template<typename T>
@@ -0,0 +1,105 @@
+/*
+ Copyright (c) 2026, The Cinder Project
+
+ This code is intended to be used with the Cinder C++ library, http://libcinder.org
+
+ Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+ the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright notice, this list of conditions and
+	the following disclaimer.
+    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+	the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+ WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED
+ TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#include "cinder/ip/Execution.h"
+#include "cinder/Parallel.h"
+
+#include <algorithm>
+#include <mutex>
+
+using namespace std;
+
+namespace cinder { namespace ip {
+
+namespace {
+
+thread_local const ExecutionPolicy *sScopedPolicy = nullptr;
+
+mutex& getDefaultPolicyMutex()
+{
+	static mutex sMutex;
+	return sMutex;
+}
+
+ExecutionPolicy& getDefaultPolicy()
+{
+	static ExecutionPolicy sPolicy;
+	return sPolicy;
+}
+
+} // anonymous namespace
+
+size_t ExecutionPolicy::getNumThreads() const
+{
+	return getNumParallelThreads( mMaxThreads );
+}
+
+void setDefaultExecutionPolicy( const ExecutionPolicy &policy )
+{
+	lock_guard<mutex> lock( getDefaultPolicyMutex() );
+	getDefaultPolicy() = policy;
+}
+
+ExecutionPolicy getDefaultExecutionPolicy()
+{
+	lock_guard<mutex> lock( getDefaultPolicyMutex() );
+	return getDefaultPolicy();
+}
+
+ExecutionPolicy getExecutionPolicy()
+{
+	if( sScopedPolicy )
+		return *sScopedPolicy;
+
+	return getDefaultExecutionPolicy();
+}
+
+ScopedExecutionPolicy::ScopedExecutionPolicy( const ExecutionPolicy &policy )
+	: mPolicy( policy ), mPrevPolicy( sScopedPolicy )
+{
+	sScopedPolicy = &mPolicy;
+}
+
+ScopedExecutionPolicy::~ScopedExecutionPolicy()
+{
+	sScopedPolicy = mPrevPolicy;
+}
+
+void parallelFor( int32_t begin, int32_t end, int32_t minItemsPerTask, const function<void( int32_t, int32_t )> &fn )
+{
+	cinder::parallelFor( begin, end, minItemsPerTask, getExecutionPolicy().getMaxThreads(), fn );
+}
+
+void parallelForRows( const Area &area, const function<void( const Area & )> &fn, int32_t halo )
+{
+	if( area.getWidth() <= 0 || area.getHeight() <= 0 )
+		return;
+
+	const int32_t minRows = std::max<int32_t>( int32_t( getExecutionPolicy().getMinPixelsPerTask() / area.getWidth() ), std::max( 4 * halo, 1 ) );
+	parallelFor( area.y1, area.y2, minRows, [&]( int32_t y1, int32_t y2 ) {
+		fn( Area( area.x1, y1, area.x2, y2 ) );
+	} );
+}
+
+} } // namespace cinder::ip
@@ -21,6 +21,7 @@
 */
 
 #include "cinder/ip/Fill.h"
+#include "cinder/ip/Execution.h"
 
 namespace cinder { namespace ip {
 
@@ -33,15 +34,17 @@ void fill_impl( SurfaceT<T> *surface, const ColorT<T> &color, const Area &area )
 	uint8_t pixelInc = surface->getPixelInc();
 	const T red = color.r, green = color.g, blue = color.b;
 	uint8_t redOffset = surface->getRedOffset(), greenOffset = surface->getGreenOffset(), blueOffset = surface->getBlueOffset();
-	for( int32_t y = clippedArea.getY1(); y < clippedArea.getY2(); ++y ) {
-		T *dstPtr = reinterpret_cast<T*>( reinterpret_cast<uint8_t*>( surface->getData() + clippedArea.getX1() * pixelInc ) + y * rowBytes );
-		for( int32_t x = 0; x < clippedArea.getWidth(); ++x ) {
-			dstPtr[redOffset] = red;
-			dstPtr[greenOffset] = green;
-			dstPtr[blueOffset] = blue;
-			dstPtr += pixelInc;
+	parallelForRows( clippedArea, [&]( const Area &band ) {
+		for( int32_t y = band.getY1(); y < band.getY2(); ++y ) {
+			T *dstPtr = reinterpret_cast<T*>( reinterpret_cast<uint8_t*>( surface->getData() + clippedArea.getX1() * pixelInc ) + y * rowBytes );
+			for( int32_t x = 0; x < clippedArea.getWidth(); ++x ) {
+				dstPtr[redOffset] = red;
+				dstPtr[greenOffset] = green;
+				dstPtr[blueOffset] = blue;
+				dstPtr += pixelInc;
+			}
 		}
-	}
+	} );
 }
 
 template<typename T>
@@ -59,16 +62,18 @@ void fill_impl( SurfaceT<T> *surface, const ColorAT<T> &color, const Area &area
 	uint8_t pixelInc = surface->getPixelInc();
 	const T red = color.r, green = color.g, blue = color.b, alpha = color.a;
 	uint8_t redOffset = surface->getRedOffset(), greenOffset = surface->getGreenOffset(), blueOffset = surface->getBlueOffset(), alphaOffset = surface->getAlphaOffset();
-	for( int32_t y = clippedArea.getY1(); y < clippedArea.getY2(); ++y ) {
-		T *dstPtr = reinterpret_cast<T*>( reinterpret_cast<uint8_t*>( surface->getData() + clippedArea.getX1() * pixelInc ) + y * rowBytes );
-		for( int32_t x = 0; x < clippedArea.getWidth(); ++x ) {
-			dstPtr[redOffset] = red;
-			dstPtr[greenOffset] = green;
-			dstPtr[blueOffset] = blue;
-			dstPtr[alphaOffset] = alpha;
-			dstPtr += pixelInc;
+	parallelForRows( clippedArea, [&]( const Area &band ) {
+		for( int32_t y = band.getY1(); y < band.getY2(); ++y ) {
+			T *dstPtr = reinterpret_cast<T*>( reinterpret_cast<uint8_t*>( surface->getData() + clippedArea.getX1() * pixelInc ) + y * rowBytes );
+			for( int32_t x = 0; x < clippedArea.getWidth(); ++x ) {
+				dstPtr[redOffset] = red;
+				dstPtr[greenOffset] = green;
+				dstPtr[blueOffset] = blue;
+				dstPtr[alphaOffset] = alpha;
+				dstPtr += pixelInc;
+			}
 		}
-	}
+	} );
 }
 
 template<typename T, typename Y>
@@ -106,13 +111,15 @@ void fill( ChannelT<T> *channel, T value, const Area &area )
 	
 	ptrdiff_t rowBytes = channel->getRowBytes();
 	uint8_t inc = channel->getIncrement();
-	for( int32_t y = clippedArea.getY1(); y < clippedArea.getY2(); ++y ) {
-		T *dstPtr = reinterpret_cast<T*>( reinterpret_cast<uint8_t*>( channel->getData() + clippedArea.getX1() * inc ) + y * rowBytes );
-		for( int32_t x = 0; x < clippedArea.getWidth(); ++x ) {
-			*dstPtr = value;
-			dstPtr += inc;
-		}
-	}	
+	parallelForRows( clippedArea, [&]( const Area &band ) {
+		for( int32_t y = band.getY1(); y < band.getY2(); ++y ) {
+			T *dstPtr = reinterpret_cast<T*>( reinterpret_cast<uint8_t*>( channel->getData() + clippedArea.getX1() * inc ) + y * rowBytes );
+			for( int32_t x = 0; x < clippedArea.getWidth(); ++x ) {
+				*dstPtr = value;
+				dstPtr += inc;
+			}
+		}	
+	} );
 }
 
 template<typename T>
@@ -21,6 +21,7 @@
 */
 
 #include "cinder/ip/Flip.h"
+#include "cinder/ip/Execution.h"
 
 using namespace std;
 
@@ -30,15 +31,17 @@ template<typename T>
 void flipVertical( SurfaceT<T> *surface )
 {
 	const ptrdiff_t rowBytes = surface->getRowBytes();
-	unique_ptr<uint8_t[]> buffer( new uint8_t[rowBytes] );
-	
 	const int32_t lastRow = surface->getHeight() - 1;
 	const int32_t halfHeight = surface->getHeight() / 2;
-	for( int32_t y = 0; y < halfHeight; ++y ) {
-		memcpy( buffer.get(), surface->getData( ivec2( 0, y ) ), rowBytes );
-		memcpy( surface->getData( ivec2( 0, y ) ), surface->getData( ivec2( 0, lastRow - y ) ), rowBytes );
-		memcpy( surface->getData( ivec2( 0, lastRow - y ) ), buffer.get(), rowBytes );
-	}	
+	// each band swaps its rows in the top half with their mirrors in the bottom half
+	parallelForRows( Area( 0, 0, surface->getWidth(), halfHeight ), [&]( const Area &band ) {
+		unique_ptr<uint8_t[]> buffer( new uint8_t[rowBytes] );
+		for( int32_t y = band.getY1(); y < band.getY2(); ++y ) {
+			memcpy( buffer.get(), surface->getData( ivec2( 0, y ) ), rowBytes );
+			memcpy( surface->getData( ivec2( 0, y ) ), surface->getData( ivec2( 0, lastRow - y ) ), rowBytes );
+			memcpy( surface->getData( ivec2( 0, lastRow - y ) ), buffer.get(), rowBytes );
+		}
+	} );
 }
 
 namespace { // anonymous
@@ -47,11 +50,13 @@ void flipVerticalRawSameChannelOrder( const SurfaceT<T> &srcSurface, SurfaceT<T>
 {
 	const uint8_t srcPixelInc = srcSurface.getPixelInc();
 	const size_t copyBytes = size.x * srcPixelInc * sizeof(T);
-	for( int32_t y = 0; y < size.y; ++y ) {
-		const T *srcPtr = srcSurface.getData( ivec2( 0, y ) );
-		T *dstPtr = destSurface->getData( ivec2( 0, size.y - y - 1 ) );
-		memcpy( dstPtr, srcPtr, copyBytes );
-	}
+	parallelForRows( Area( 0, 0, size.x, size.y ), [&]( const Area &band ) {
+		for( int32_t y = band.getY1(); y < band.getY2(); ++y ) {
+			const T *srcPtr = srcSurface.getData( ivec2( 0, y ) );
+			T *dstPtr = destSurface->getData( ivec2( 0, size.y - y - 1 ) );
+			memcpy( dstPtr, srcPtr, copyBytes );
+		}
+	} );
 }
 
 template<typename T>
@@ -67,18 +72,20 @@ void flipVerticalRawRgba( const SurfaceT<T> &srcSurface, SurfaceT<T> *destSurfac
 	const uint8_t dstBlue = destSurface->getChannelOrder().getBlueOffset();
 	const uint8_t dstAlpha = destSurface->getChannelOrder().getAlphaOffset();
 	
-	for( int32_t y = 0; y < size.y; ++y ) {
-		const T *src = srcSurface.getData( ivec2( 0, y ) );
-		T *dst = destSurface->getData( ivec2( 0, size.y - y - 1 ) );
-		for( int x = 0; x < size.x; ++x ) {
-			dst[dstRed] = src[srcRed];
-			dst[dstGreen] = src[srcGreen];
-			dst[dstBlue] = src[srcBlue];
-			dst[dstAlpha] = src[srcAlpha];
-			src += 4;
-			dst += 4;
+	parallelForRows( Area( 0, 0, size.x, size.y ), [&]( const Area &band ) {
+		for( int32_t y = band.getY1(); y < band.getY2(); ++y ) {
+			const T *src = srcSurface.getData( ivec2( 0, y ) );
+			T *dst = destSurface->getData( ivec2( 0, size.y - y - 1 ) );
+			for( int x = 0; x < size.x; ++x ) {
+				dst[dstRed] = src[srcRed];
+				dst[dstGreen] = src[srcGreen];
+				dst[dstBlue] = src[srcBlue];
+				dst[dstAlpha] = src[srcAlpha];
+				src += 4;
+				dst += 4;
+			}
 		}
-	}
+	} );
 }
 
 template<typename T>
@@ -95,18 +102,20 @@ void flipVerticalRawRgbFullAlpha( const SurfaceT<T> &srcSurface, SurfaceT<T> *de
 	const uint8_t dstBlue = destSurface->getChannelOrder().getBlueOffset();
 	const uint8_t dstAlpha = destSurface->getChannelOrder().getAlphaOffset();
 	
-	for( int32_t y = 0; y < size.y; ++y ) {
-		const T *src = srcSurface.getData( ivec2( 0, y ) );
-		T *dst = destSurface->getData( ivec2( 0, size.y - y - 1 ) );
-		for( int x = 0; x < size.x; ++x ) {
-			dst[dstRed] = src[srcRed];
-			dst[dstGreen] = src[srcGreen];
-			dst[dstBlue] = src[srcBlue];
-			dst[dstAlpha] = fullAlpha;
-			src += srcPixelInc;
-			dst += 4;
+	parallelForRows( Area( 0, 0, size.x, size.y ), [&]( const Area &band ) {
+		for( int32_t y = band.getY1(); y < band.getY2(); ++y ) {
+			const T *src = srcSurface.getData( ivec2( 0, y ) );
+			T *dst = destSurface->getData( ivec2( 0, size.y - y - 1 ) );
+			for( int x = 0; x < size.x; ++x ) {
+				dst[dstRed] = src[srcRed];
+				dst[dstGreen] = src[srcGreen];
+				dst[dstBlue] = src[srcBlue];
+				dst[dstAlpha] = fullAlpha;
+				src += srcPixelInc;
+				dst += 4;
+			}
 		}
-	}
+	} );
 }
 
 template<typename T>
@@ -122,17 +131,19 @@ void flipVerticalRawRgb( const SurfaceT<T> &srcSurface, SurfaceT<T> *destSurface
 	const uint8_t dstBlue = destSurface->getChannelOrder().getBlueOffset();
 	const uint8_t dstPixelInc = destSurface->getPixelInc();
 	
-	for( int32_t y = 0; y < size.y; ++y ) {
-		const T *src = srcSurface.getData( ivec2( 0, y ) );
-		T *dst = destSurface->getData( ivec2( 0, size.y - y - 1 ) );
-		for( int x = 0; x < size.x; ++x ) {
-			dst[dstRed] = src[srcRed];
-			dst[dstGreen] = src[srcGreen];
-			dst[dstBlue] = src[srcBlue];
-			src += srcPixelInc;
-			dst += dstPixelInc;
+	parallelForRows( Area( 0, 0, size.x, size.y ), [&]( const Area &band ) {
+		for( int32_t y = band.getY1(); y < band.getY2(); ++y ) {
+			const T *src = srcSurface.getData( ivec2( 0, y ) );
+			T *dst = destSurface->getData( ivec2( 0, size.y - y - 1 ) );
+			for( int x = 0; x < size.x; ++x ) {
+				dst[dstRed] = src[srcRed];
+				dst[dstGreen] = src[srcGreen];
+				dst[dstBlue] = src[srcBlue];
+				src += srcPixelInc;
+				dst += dstPixelInc;
+			}
 		}
-	}
+	} );
 }
 } // anonymous namespace
 
@@ -159,25 +170,29 @@ void flipVertical( const ChannelT<T> &srcChannel, ChannelT<T> *destChannel )
 	if( srcChannel.isPlanar() && destChannel->isPlanar() ) { // both channels are planar, so do a series of memcpy()'s
 		const size_t srcPixelInc = srcChannel.getIncrement();
 		const size_t copyBytes = srcDst.first.getWidth() * srcPixelInc * sizeof(T);
-		for( int32_t y = 0; y < srcDst.first.getHeight(); ++y ) {
-			const T *srcPtr = srcChannel.getData( ivec2( 0, y ) );
-			T *dstPtr = destChannel->getData( ivec2( 0, srcDst.first.getHeight() - y - 1 ) );
-			memcpy( dstPtr, srcPtr, copyBytes );
-		}
+		parallelForRows( Area( 0, 0, srcDst.first.getWidth(), srcDst.first.getHeight() ), [&]( const Area &band ) {
+			for( int32_t y = band.getY1(); y < band.getY2(); ++y ) {
+				const T *srcPtr = srcChannel.getData( ivec2( 0, y ) );
+				T *dstPtr = destChannel->getData( ivec2( 0, srcDst.first.getHeight() - y - 1 ) );
+				memcpy( dstPtr, srcPtr, copyBytes );
+			}
+		} );
 	}
 	else {
 		const uint8_t srcInc = srcChannel.getIncrement();
 		const uint8_t destInc = destChannel->getIncrement();
 		const int32_t width = srcDst.first.getWidth();
-		for( int y = 0; y < srcDst.first.getHeight(); ++y ) {
-			const T* src = srcChannel.getData( 0, y );
-			T* dest = destChannel->getData( 0, srcDst.first.getHeight() - 1 - y );
-			for ( int x = 0; x < width; ++x ) {
-				*dest	= *src;
-				src	+= srcInc;
-				dest += destInc;
+		parallelForRows( Area( 0, 0, width, srcDst.first.getHeight() ), [&]( const Area &band ) {
+			for( int y = band.getY1(); y < band.getY2(); ++y ) {
+				const T* src = srcChannel.getData( 0, y );
+				T* dest = destChannel->getData( 0, srcDst.first.getHeight() - 1 - y );
+				for ( int x = 0; x < width; ++x ) {
+					*dest	= *src;
+					src	+= srcInc;
+					dest += destInc;
+				}
 			}
-		}
+		} );
 	}
 }
 
@@ -189,28 +204,32 @@ void flipHorizontal( SurfaceT<T> *surface )
 	const int32_t halfWidth = width / 2;
 	
 	if( surface->getPixelInc() == 4 ) {
-		for( int32_t y = 0; y < height; ++y ) {
-			T *rowPtr = surface->getData( ivec2( 0, y ) );
-			for( int32_t x = 0; x < halfWidth; ++x ) {
-				for( int c = 0; c < 4; ++c ) {
-					T temp = rowPtr[x*4+c];
-					rowPtr[x*4+c] = rowPtr[(width-x-1)*4+c];
-					rowPtr[(width-x-1)*4+c] = temp;
+		parallelForRows( Area( 0, 0, width, height ), [&]( const Area &band ) {
+			for( int32_t y = band.getY1(); y < band.getY2(); ++y ) {
+				T *rowPtr = surface->getData( ivec2( 0, y ) );
+				for( int32_t x = 0; x < halfWidth; ++x ) {
+					for( int c = 0; c < 4; ++c ) {
+						T temp = rowPtr[x*4+c];
+						rowPtr[x*4+c] = rowPtr[(width-x-1)*4+c];
+						rowPtr[(width-x-1)*4+c] = temp;
+					}
 				}
 			}
-		}
+		} );
 	}
 	else { // pixel inc of 3
-		for( int32_t y = 0; y < height; ++y ) {
-			T *rowPtr = surface->getData( ivec2( 0, y ) );
-			for( int32_t x = 0; x < halfWidth; ++x ) {
-				for( int c = 0; c < 3; ++c ) {
-					T temp = rowPtr[x*3+c];
-					rowPtr[x*3+c] = rowPtr[(width-x-1)*3+c];
-					rowPtr[(width-x-1)*3+c] = temp;
+		parallelForRows( Area( 0, 0, width, height ), [&]( const Area &band ) {
+			for( int32_t y = band.getY1(); y < band.getY2(); ++y ) {
+				T *rowPtr = surface->getData( ivec2( 0, y ) );
+				for( int32_t x = 0; x < halfWidth; ++x ) {
+					for( int c = 0; c < 3; ++c ) {
+						T temp = rowPtr[x*3+c];
+						rowPtr[x*3+c] = rowPtr[(width-x-1)*3+c];
+						rowPtr[(width-x-1)*3+c] = temp;
+					}
 				}
 			}
-		}
+		} );
 	}
 }
 
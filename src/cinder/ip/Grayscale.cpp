@@ -21,6 +21,7 @@
 */
 
 #include "cinder/ip/Grayscale.h"
+#include "cinder/ip/Execution.h"
 #include "cinder/ChanTraits.h"
 
 namespace cinder { namespace ip {
@@ -34,18 +35,20 @@ void grayscale( const SurfaceT<T> &srcSurface, SurfaceT<T> *dstSurface )
 	uint8_t srcRedOffset = srcSurface.getRedOffset(), srcGreenOffset = srcSurface.getGreenOffset(), srcBlueOffset = srcSurface.getBlueOffset();
 	uint8_t dstRedOffset = dstSurface->getRedOffset(), dstGreenOffset = dstSurface->getGreenOffset(), dstBlueOffset = dstSurface->getBlueOffset();	
 	int8_t dstPixelInc = dstSurface->getPixelInc();
-	for( int32_t y = 0; y < area.getHeight(); ++y ) {
-		T *dstPtr = dstSurface->getData( ivec2( area.getX1(), y ) );
-		const T *srcPtr = srcSurface.getData( ivec2( area.getX1(), y ) );
-		for( int32_t x = area.getX1(); x < area.getX2(); ++x ) {
-			T gray = CHANTRAIT<T>::grayscale( srcPtr[srcRedOffset], srcPtr[srcGreenOffset], srcPtr[srcBlueOffset] );
-			dstPtr[dstRedOffset] = gray;
-			dstPtr[dstGreenOffset] = gray;
-			dstPtr[dstBlueOffset] = gray;
-			dstPtr += dstPixelInc;
-			srcPtr += srcPixelInc;
+	parallelForRows( area, [&]( const Area &band ) {
+		for( int32_t y = band.getY1(); y < band.getY2(); ++y ) {
+			T *dstPtr = dstSurface->getData( ivec2( area.getX1(), y ) );
+			const T *srcPtr = srcSurface.getData( ivec2( area.getX1(), y ) );
+			for( int32_t x = area.getX1(); x < area.getX2(); ++x ) {
+				T gray = CHANTRAIT<T>::grayscale( srcPtr[srcRedOffset], srcPtr[srcGreenOffset], srcPtr[srcBlueOffset] );
+				dstPtr[dstRedOffset] = gray;
+				dstPtr[dstGreenOffset] = gray;
+				dstPtr[dstBlueOffset] = gray;
+				dstPtr += dstPixelInc;
+				srcPtr += srcPixelInc;
+			}
 		}
-	}
+	} );
 }
 
 template<typename T>
@@ -56,15 +59,17 @@ void grayscale( const SurfaceT<T> &srcSurface, ChannelT<T> *dstChannel )
 	int8_t srcPixelInc = srcSurface.getPixelInc();
 	uint8_t srcRedOffset = srcSurface.getRedOffset(), srcGreenOffset = srcSurface.getGreenOffset(), srcBlueOffset = srcSurface.getBlueOffset();
 	int8_t dstPixelInc = dstChannel->getIncrement();
-	for( int32_t y = 0; y < area.getHeight(); ++y ) {
-		T *dstPtr = dstChannel->getData( ivec2( area.getX1(), y ) );
-		const T *srcPtr = srcSurface.getData( ivec2( area.getX1(), y ) );
-		for( int32_t x = area.getX1(); x < area.getX2(); ++x ) {
-			*dstPtr = CHANTRAIT<T>::grayscale( srcPtr[srcRedOffset], srcPtr[srcGreenOffset], srcPtr[srcBlueOffset] );
-			dstPtr += dstPixelInc;
-			srcPtr += srcPixelInc;
+	parallelForRows( area, [&]( const Area &band ) {
+		for( int32_t y = band.getY1(); y < band.getY2(); ++y ) {
+			T *dstPtr = dstChannel->getData( ivec2( area.getX1(), y ) );
+			const T *srcPtr = srcSurface.getData( ivec2( area.getX1(), y ) );
+			for( int32_t x = area.getX1(); x < area.getX2(); ++x ) {
+				*dstPtr = CHANTRAIT<T>::grayscale( srcPtr[srcRedOffset], srcPtr[srcGreenOffset], srcPtr[srcBlueOffset] );
+				dstPtr += dstPixelInc;
+				srcPtr += srcPixelInc;
+			}
 		}
-	}
+	} );
 }
 
 template<>
@@ -76,16 +81,18 @@ void grayscale( const Surface8u &srcSurface, Channel8u *dstChannel )
 	uint8_t srcRedOffset = srcSurface.getRedOffset(), srcGreenOffset = srcSurface.getGreenOffset(), srcBlueOffset = srcSurface.getBlueOffset();
 	int8_t dstPixelInc = dstChannel->getIncrement();
 	const uint8_t redWeight = 74, greenWeight = 147, blueWeight = 35;
-	for( int32_t y = 0; y < area.getHeight(); ++y ) {
-		uint8_t *dstPtr = dstChannel->getData( ivec2( area.getX1(), y ) );
-		const uint8_t *srcPtr = srcSurface.getData( ivec2( area.getX1(), y ) );
-		for( int32_t x = area.getX1(); x < area.getX2(); ++x ) {
-			uint32_t sum = srcPtr[srcRedOffset] * redWeight + srcPtr[srcGreenOffset] * greenWeight + srcPtr[srcBlueOffset] * blueWeight;
-			*dstPtr = static_cast<uint8_t>( sum >> 8 );
-			dstPtr += dstPixelInc;
-			srcPtr += srcPixelInc;
+	parallelForRows( area, [&]( const Area &band ) {
+		for( int32_t y = band.getY1(); y < band.getY2(); ++y ) {
+			uint8_t *dstPtr = dstChannel->getData( ivec2( area.getX1(), y ) );
+			const uint8_t *srcPtr = srcSurface.getData( ivec2( area.getX1(), y ) );
+			for( int32_t x = area.getX1(); x < area.getX2(); ++x ) {
+				uint32_t sum = srcPtr[srcRedOffset] * redWeight + srcPtr[srcGreenOffset] * greenWeight + srcPtr[srcBlueOffset] * blueWeight;
+				*dstPtr = static_cast<uint8_t>( sum >> 8 );
+				dstPtr += dstPixelInc;
+				srcPtr += srcPixelInc;
+			}
 		}
-	}
+	} );
 }
 
 #define grayscale_PROTOTYPES(T)\
@@ -24,30 +24,41 @@
 #include "cinder/ip/Grayscale.h"
 #include "cinder/ChanTraits.h"
 #include "cinder/ip/Fill.h"
+#include "cinder/ip/Execution.h"
 #include <algorithm>
+#include <mutex>
 
 namespace cinder { namespace ip {
 
 void hdrNormalize( Surface32f *surface )
 {
 	// first take histogram to find the minimum and maximum values present
-	float minVal = *(surface->getDataRed( ivec2() )), maxVal = *(surface->getDataRed( ivec2() ));
+	const float firstVal = *(surface->getDataRed( ivec2() ));
+	float minVal = firstVal, maxVal = firstVal;
 
 	const int8_t pixelInc = surface->getPixelInc();
 	const uint8_t redOffset = surface->getRedOffset(), greenOffset = surface->getGreenOffset(), blueOffset = surface->getBlueOffset();
-	for( int32_t y = 0; y < surface->getHeight(); ++y ) {
-		const float *srcPtr = surface->getData( ivec2( 0, y ) );
-		for( int32_t x = 0; x < surface->getWidth(); ++x ) {
-			minVal = std::min( minVal, srcPtr[redOffset] );
-			maxVal = std::max( maxVal, srcPtr[redOffset] );
-			minVal = std::min( minVal, srcPtr[greenOffset] );
-			maxVal = std::max( maxVal, srcPtr[greenOffset] );
-			minVal = std::min( minVal, srcPtr[blueOffset] );
-			maxVal = std::max( maxVal, srcPtr[blueOffset] );
+	std::mutex mutex;
+	parallelForRows( surface->getBounds(), [&]( const Area &band ) {
+		float bandMin = firstVal, bandMax = firstVal;
+		for( int32_t y = band.getY1(); y < band.getY2(); ++y ) {
+			const float *srcPtr = surface->getData( ivec2( 0, y ) );
+			for( int32_t x = 0; x < surface->getWidth(); ++x ) {
+				bandMin = std::min( bandMin, srcPtr[redOffset] );
+				bandMax = std::max( bandMax, srcPtr[redOffset] );
+				bandMin = std::min( bandMin, srcPtr[greenOffset] );
+				bandMax = std::max( bandMax, srcPtr[greenOffset] );
+				bandMin = std::min( bandMin, srcPtr[blueOffset] );
+				bandMax = std::max( bandMax, srcPtr[blueOffset] );
 
-			srcPtr += pixelInc;
+				srcPtr += pixelInc;
+			}
 		}
-	}
+
+		std::lock_guard<std::mutex> lock( mutex );
+		minVal = std::min( minVal, bandMin );
+		maxVal = std::max( maxVal, bandMax );
+	} );
 	
 	// if min==max then we should just fill with black
 	if( minVal == maxVal ) {
@@ -56,16 +67,18 @@ void hdrNormalize( Surface32f *surface )
 	}
 	
 	float scale = 1.0f / ( maxVal - minVal );
-	for( int32_t y = 0; y < surface->getHeight(); ++y ) {
-		float *dstPtr = surface->getData( ivec2( 0, y ) );
-		for( int32_t x = 0; x < surface->getWidth(); ++x ) {
-			dstPtr[redOffset] = ( dstPtr[redOffset] - minVal ) * scale;
-			dstPtr[greenOffset] = ( dstPtr[greenOffset] - minVal ) * scale;
-			dstPtr[blueOffset] = ( dstPtr[blueOffset] - minVal ) * scale;
+	parallelForRows( surface->getBounds(), [&]( const Area &band ) {
+		for( int32_t y = band.getY1(); y < band.getY2(); ++y ) {
+			float *dstPtr = surface->getData( ivec2( 0, y ) );
+			for( int32_t x = 0; x < surface->getWidth(); ++x ) {
+				dstPtr[redOffset] = ( dstPtr[redOffset] - minVal ) * scale;
+				dstPtr[greenOffset] = ( dstPtr[greenOffset] - minVal ) * scale;
+				dstPtr[blueOffset] = ( dstPtr[blueOffset] - minVal ) * scale;
 
-			dstPtr += pixelInc;
+				dstPtr += pixelInc;
+			}
 		}
-	}	
+	} );
 }
 
 void hdrNormalize( Channel32f *channel )
@@ -81,24 +94,35 @@ void hdrNormalize( Channel32f *channel )
 	}
 	
 	float scale = 1.0f / ( maxVal - minVal );
-	Channel32f::Iter iter = channel->getIter();
-	while( iter.line() ) {
-		while( iter.pixel() ) {
-			iter.v() = ( iter.v() - minVal ) * scale;
+	parallelForRows( channel->getBounds(), [&]( const Area &band ) {
+		Channel32f::Iter iter = channel->getIter( band );
+		while( iter.line() ) {
+			while( iter.pixel() ) {
+				iter.v() = ( iter.v() - minVal ) * scale;
+			}
 		}
-	}
+	} );
 }
 
 void getMinMax( const Channel32f &channel, float *resultMin, float *resultMax )
 {
-	float minVal = *(channel.getData( ivec2() )), maxVal = *(channel.getData( ivec2() ));
-	Channel32f::ConstIter iter = channel.getIter();
-	while( iter.line() ) {
-		while( iter.pixel() ) {
-			minVal = std::min( minVal, iter.v() );
-			maxVal = std::max( maxVal, iter.v() );
+	const float firstVal = *(channel.getData( ivec2() ));
+	float minVal = firstVal, maxVal = firstVal;
+	std::mutex mutex;
+	parallelForRows( channel.getBounds(), [&]( const Area &band ) {
+		float bandMin = firstVal, bandMax = firstVal;
+		Channel32f::ConstIter iter = channel.getIter( band );
+		while( iter.line() ) {
+			while( iter.pixel() ) {
+				bandMin = std::min( bandMin, iter.v() );
+				bandMax = std::max( bandMax, iter.v() );
+			}
 		}
-	}
+
+		std::lock_guard<std::mutex> lock( mutex );
+		minVal = std::min( minVal, bandMin );
+		maxVal = std::max( maxVal, bandMax );
+	} );
 	*resultMin = minVal;
 	*resultMax = maxVal;
 }
@@ -21,6 +21,7 @@
 */
 
 #include "cinder/ip/Premultiply.h"
+#include "cinder/ip/Execution.h"
 #include "cinder/ChanTraits.h"
 
 #include <algorithm>
@@ -41,18 +42,20 @@ void premultiply( SurfaceT<T> *surface )
 	ptrdiff_t rowBytes = surface->getRowBytes();
 	uint8_t pixelInc = surface->getPixelInc();
 	uint8_t redOffset = surface->getRedOffset(), greenOffset = surface->getGreenOffset(), blueOffset = surface->getBlueOffset(), alphaOffset = surface->getAlphaOffset();
-	for( int32_t y = clippedArea.getY1(); y < clippedArea.getY2(); ++y ) {
-		T *dstPtr = reinterpret_cast<T*>( reinterpret_cast<uint8_t*>( surface->getData() + clippedArea.getX1() * pixelInc ) + y * rowBytes );
-		for( int32_t x = 0; x < clippedArea.getWidth(); ++x ) {
-			// The basic formula for unpremultiplication is to divide by the alpha
-			T alpha = dstPtr[alphaOffset];
+	parallelForRows( clippedArea, [&]( const Area &band ) {
+		for( int32_t y = band.getY1(); y < band.getY2(); ++y ) {
+			T *dstPtr = reinterpret_cast<T*>( reinterpret_cast<uint8_t*>( surface->getData() + clippedArea.getX1() * pixelInc ) + y * rowBytes );
+			for( int32_t x = 0; x < clippedArea.getWidth(); ++x ) {
+				// The basic formula for unpremultiplication is to divide by the alpha
+				T alpha = dstPtr[alphaOffset];
 			
-			dstPtr[redOffset] = CHANTRAIT<T>::premultiply( dstPtr[redOffset], alpha );
-			dstPtr[greenOffset] = CHANTRAIT<T>::premultiply( dstPtr[greenOffset], alpha );
-			dstPtr[blueOffset] = CHANTRAIT<T>::premultiply( dstPtr[blueOffset], alpha );
-			dstPtr += pixelInc;
+				dstPtr[redOffset] = CHANTRAIT<T>::premultiply( dstPtr[redOffset], alpha );
+				dstPtr[greenOffset] = CHANTRAIT<T>::premultiply( dstPtr[greenOffset], alpha );
+				dstPtr[blueOffset] = CHANTRAIT<T>::premultiply( dstPtr[blueOffset], alpha );
+				dstPtr += pixelInc;
+			}
 		}
-	}
+	} );
 }
 
 // this is a candidate for sse2
@@ -69,20 +72,22 @@ void unpremultiply<uint8_t>( SurfaceT<uint8_t> *surface )
 	ptrdiff_t rowBytes = surface->getRowBytes();
 	uint8_t pixelInc = surface->getPixelInc();
 	uint8_t redOffset = surface->getRedOffset(), greenOffset = surface->getGreenOffset(), blueOffset = surface->getBlueOffset(), alphaOffset = surface->getAlphaOffset();
-	for( int32_t y = clippedArea.getY1(); y < clippedArea.getY2(); ++y ) {
-		uint8_t *dstPtr = reinterpret_cast<uint8_t*>( surface->getData() + clippedArea.getX1() * pixelInc ) + y * rowBytes;
-		for( int32_t x = 0; x < clippedArea.getWidth(); ++x ) {
-			// The basic formula for unpremultiplication is to divide by the alpha
-			// which in 8bit pixel arithmetic is to multiply by 255 and divide by the alpha
-			uint8_t alpha = dstPtr[alphaOffset];
-			if( alpha ) {
-				dstPtr[redOffset] = std::min<int>( dstPtr[redOffset] * 255 / alpha, 255 );
-				dstPtr[greenOffset] = std::min<int>( dstPtr[greenOffset] * 255 / alpha, 255 );
-				dstPtr[blueOffset] = std::min<int>( dstPtr[blueOffset] * 255 / alpha, 255 );
+	parallelForRows( clippedArea, [&]( const Area &band ) {
+		for( int32_t y = band.getY1(); y < band.getY2(); ++y ) {
+			uint8_t *dstPtr = reinterpret_cast<uint8_t*>( surface->getData() + clippedArea.getX1() * pixelInc ) + y * rowBytes;
+			for( int32_t x = 0; x < clippedArea.getWidth(); ++x ) {
+				// The basic formula for unpremultiplication is to divide by the alpha
+				// which in 8bit pixel arithmetic is to multiply by 255 and divide by the alpha
+				uint8_t alpha = dstPtr[alphaOffset];
+				if( alpha ) {
+					dstPtr[redOffset] = std::min<int>( dstPtr[redOffset] * 255 / alpha, 255 );
+					dstPtr[greenOffset] = std::min<int>( dstPtr[greenOffset] * 255 / alpha, 255 );
+					dstPtr[blueOffset] = std::min<int>( dstPtr[blueOffset] * 255 / alpha, 255 );
+				}
+				dstPtr += pixelInc;
 			}
-			dstPtr += pixelInc;
-		}
-	}	
+		}	
+	} );
 }
 
 template<>
@@ -98,19 +103,21 @@ void unpremultiply<float>( SurfaceT<float> *surface )
 	ptrdiff_t rowBytes = surface->getRowBytes();
 	uint8_t pixelInc = surface->getPixelInc();
 	uint8_t redOffset = surface->getRedOffset(), greenOffset = surface->getGreenOffset(), blueOffset = surface->getBlueOffset(), alphaOffset = surface->getAlphaOffset();
-	for( int32_t y = clippedArea.getY1(); y < clippedArea.getY2(); ++y ) {
-		float *dstPtr = reinterpret_cast<float*>( reinterpret_cast<uint8_t*>( surface->getData() + clippedArea.getX1() * pixelInc ) + y * rowBytes );
-		for( int32_t x = 0; x < clippedArea.getWidth(); ++x ) {
-			// The basic formula for unpremultiplication is to divide by the alpha
-			if( dstPtr[alphaOffset] != 0 ) {
-				float invAlpha = 1.0f / dstPtr[alphaOffset];
-				dstPtr[redOffset] *= invAlpha;
-				dstPtr[greenOffset] *= invAlpha;
-				dstPtr[blueOffset] *= invAlpha;
+	parallelForRows( clippedArea, [&]( const Area &band ) {
+		for( int32_t y = band.getY1(); y < band.getY2(); ++y ) {
+			float *dstPtr = reinterpret_cast<float*>( reinterpret_cast<uint8_t*>( surface->getData() + clippedArea.getX1() * pixelInc ) + y * rowBytes );
+			for( int32_t x = 0; x < clippedArea.getWidth(); ++x ) {
+				// The basic formula for unpremultiplication is to divide by the alpha
+				if( dstPtr[alphaOffset] != 0 ) {
+					float invAlpha = 1.0f / dstPtr[alphaOffset];
+					dstPtr[redOffset] *= invAlpha;
+					dstPtr[greenOffset] *= invAlpha;
+					dstPtr[blueOffset] *= invAlpha;
+				}
+				dstPtr += pixelInc;
 			}
-			dstPtr += pixelInc;
-		}
-	}	
+		}	
+	} );
 }
 
 template CI_API void premultiply( SurfaceT<uint8_t> *Surface );
@@ -22,6 +22,7 @@
 
 #include "cinder/Surface.h"
 #include "cinder/ip/Resize.h"
+#include "cinder/ip/Execution.h"
 #include "cinder/Filter.h"
 #include "cinder/Rect.h"
 #include "cinder/ChanTraits.h"
@@ -30,10 +31,23 @@
 #include <vector>
 using std::vector;
 using std::pair;
-using std::unique_ptr;
+using std::shared_ptr;
 #include <limits>
-#include <fstream>
 #include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <typeinfo>
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+	#define CINDER_IP_SSE
+	#include <emmintrin.h>
+#elif defined( __ARM_NEON ) || defined( __aarch64__ ) || defined( _M_ARM64 )
+	#define CINDER_IP_NEON
+	#include <arm_neon.h>
+#endif
 
 namespace cinder { namespace ip {
 
@@ -45,6 +59,7 @@ struct SCALETRAIT {
 template<>
 struct SCALETRAIT<uint8_t> {
 	typedef int32_t SUMT;
+	typedef int16_t LINET;									// type of the horizontally filtered lines
 	static const int32_t WEIGHTBITS = 14;					// # bits in filter coefficients
 	static const int32_t FINALSHIFT = 2 * WEIGHTBITS - 8;	// shift after x&y filter passes
 	static const int32_t HALFFINALSHIFT = 1 << ( FINALSHIFT - 1 );
@@ -57,12 +72,24 @@ struct SCALETRAIT<uint8_t> {
 			result = 255;
 		return static_cast<uint8_t>( result );
 	}
-	static int32_t CHANNELTOBUFFER( const int32_t in ) { return in >> 8; }
+	static int16_t CHANNELTOBUFFER( const int32_t in ) { return static_cast<int16_t>( std::min( std::max( in >> 8, -32768 ), 32767 ) ); }
 };
 
+template<>
+struct SCALETRAIT<uint16_t> {
+	typedef float SUMT;
+	typedef float LINET;
+	static const float WEIGHTONE;		// filter weight of one
+	static uint16_t ACCUMTOCHANNEL( const float in ) { return static_cast<uint16_t>( std::min( std::max( in + 0.5f, 0.0f ), 65535.0f ) ); }
+	static float CHANNELTOBUFFER( const float in ) { return in; }
+};
+
+const float SCALETRAIT<uint16_t>::WEIGHTONE = 1.0f;
+
 template<>
 struct SCALETRAIT<float> {
 	typedef float SUMT;
+	typedef float LINET;
 	static const float WEIGHTONE;		// filter weight of one
 	static float ACCUMTOCHANNEL( const float in ) { return in; }
 	static float CHANNELTOBUFFER( const float in ) { return in; }
@@ -92,141 +119,6 @@ class WeightTable {		/* SAMPLED FILTER WEIGHT TABLE */
     T		*weight;		/* weight[i] goes with pixel at start+i */
 };
 
-template<typename LT, typename AT>
-void scanlineAccumulate( LT weight, LT *lineBuffer, int32_t lineBufferWidth, AT *accum );
-template<typename T, typename WT>
-void makeWeightTable( int32_t b, float cen, const FilterBase &filter, const FilterParams *params, int32_t len, bool trimzeros, WeightTable<WT> *wtab );
-
-template<typename AT, typename T>
-void scanlineShiftAccumToChannel( AT *accum, int32_t x1, int32_t y, int32_t width, ChannelT<T> *channel )
-{
-	AT result;
-	T *dst;
-
-	dst = channel->getData( x1, y );
-	int8_t pixelStride = channel->getIncrement();
-
-	for( int32_t i = 0; i < width; i++ ) {
-		result = SCALETRAIT<T>::ACCUMTOCHANNEL( *accum++ );
-		*dst = static_cast<T>( result );
-		dst += pixelStride;
-	}
-}
-
-template<typename T, typename WT, typename AT>
-void scanlineFilterChannelToBuffer( WeightTable<WT> *weights, int32_t x, int32_t y, const ChannelT<T> &channel, AT *lineBuffer, int32_t width )
-{
-	int32_t b, af;
-	AT sum;
-	AT *wp;
-	const T *srcLine, *src;
-
-	srcLine = channel.getData( x, y );
-
-	int8_t pixelStride = channel.getIncrement();
-	for ( b = 0; b < width; b++ ) {
-		if( std::numeric_limits<AT>::is_integer )
-			sum = 1 << 7;
-		else
-			sum = 0;
-		src = srcLine + weights->start * pixelStride;
-		wp = weights->weight;
-		for ( af = weights->start; af < weights->end; af++ ) {
-			sum += *wp++ * *src;
-			src += pixelStride;
-		}
-		*lineBuffer++ = SCALETRAIT<T>::CHANNELTOBUFFER( sum );
-		weights++;
-	}	
-}
-
-// assumes channels are of same dimensions
-template<typename T>
-void resample( const vector<const ChannelT<T>*> &srcChannels, const FilterBase &filter, const Area &srcArea, const Area &dstArea, const vector<ChannelT<T>*> &dstChannels )
-{
-	Rectf clippedSrcRect;
-	Area clippedDstArea;
-	getClippedScaledRects( srcChannels[0]->getBounds(), Rectf( srcArea ), dstChannels[0]->getBounds(), dstArea, &clippedSrcRect, &clippedDstArea );
-	
-	if ( ( clippedSrcRect.getWidth() <= 0 ) || ( clippedDstArea.getWidth() <= 0 ) 
-		|| ( clippedSrcRect.getHeight() <= 0 ) || ( clippedDstArea.getHeight() <= 0 ) )
-		return;
-	
-	FilterParams filterParamsX, filterParamsY;
-	Mapping m;
-	int32_t dstWidth = (int32_t)clippedDstArea.getWidth(), dstHeight = (int32_t)clippedDstArea.getHeight();
-	int32_t srcWidth = (int32_t)clippedSrcRect.getWidth(), srcHeight = (int32_t)clippedSrcRect.getHeight();
-	int32_t srcOffsetX = static_cast<int32_t>( floor( clippedSrcRect.getX1() ) );
-	int32_t srcOffsetY = static_cast<int32_t>( floor( clippedSrcRect.getY1() ) );
-	vector<pair<int32_t,unique_ptr<typename SCALETRAIT<T>::SUMT[]>>> linesBuffer;
-
-	m.sx = dstWidth / (float)srcWidth;
-	m.sy = dstHeight / (float)srcHeight;
-	m.tx = clippedDstArea.getX1() - 0.5f - m.sx * ( clippedSrcRect.getX1() - 0.5f );
-	m.ty = clippedDstArea.getY1() - 0.5f - m.sy * ( clippedSrcRect.getY1() - 0.5f );
-	m.ux = clippedDstArea.getX1() - m.sx * ( clippedSrcRect.getX1()- 0.5f ) - m.tx;
-	m.uy = clippedDstArea.getY1() - m.sy * ( clippedSrcRect.getY1()- 0.5f ) - m.ty;
-
-	filterParamsX.scale = std::max( 1.0f, 1.0f / m.sx );
-	filterParamsX.supp = std::max( 0.5f, filterParamsX.scale * filter.getSupport() );
-	filterParamsX.width = (int32_t)ceil( 2.0f * filterParamsX.supp );
-
-	filterParamsY.scale = std::max( 1.0f, 1.0f / m.sy );
-	filterParamsY.supp = std::max( 0.5f, filterParamsY.scale * filter.getSupport() );
-	filterParamsY.width = (int32_t)ceil( 2.0f * filterParamsY.supp );
-
-	for( int32_t i = 0; i < filterParamsY.width; i++ )
-		linesBuffer.push_back( std::make_pair( -1, unique_ptr<typename SCALETRAIT<T>::SUMT[]>( new typename SCALETRAIT<T>::SUMT[dstWidth] ) ) );
-
-	WeightTable<typename SCALETRAIT<T>::SUMT> *xWeights, yWeights;
-	typename SCALETRAIT<T>::SUMT *xWeightBuffer, *xWeightPtr;
-	xWeights = (WeightTable<typename SCALETRAIT<T>::SUMT>*)malloc( sizeof(WeightTable<int32_t>) * dstWidth );
-	xWeightBuffer = (typename SCALETRAIT<T>::SUMT*)malloc( sizeof(typename SCALETRAIT<T>::SUMT) * dstWidth * filterParamsX.width );
-	yWeights.weight = (typename SCALETRAIT<T>::SUMT*)malloc( sizeof(typename SCALETRAIT<T>::SUMT) * filterParamsY.width );
-	unique_ptr<typename SCALETRAIT<T>::SUMT[]> accum = unique_ptr<typename SCALETRAIT<T>::SUMT[]>( new typename SCALETRAIT<T>::SUMT[dstWidth] );
-
-	xWeightPtr = xWeightBuffer;
-	for ( int32_t bx = 0; bx < dstWidth; bx++, xWeightPtr += filterParamsX.width ) {
-		xWeights[bx].weight = xWeightPtr;
-		makeWeightTable<T,typename SCALETRAIT<T>::SUMT>( MAP(bx, m.sx, m.ux), filter, &filterParamsX, srcWidth, true, &xWeights[bx] );
-	}
-
-	for( size_t chan = 0; chan < srcChannels.size(); ++chan ) {
-		for ( int32_t dstY = 0; dstY < dstHeight; ++dstY ) {     // loop over dest scanlines
-			// prepare a weight table for dest y position by
-			makeWeightTable<T,typename SCALETRAIT<T>::SUMT>( MAP(dstY, m.sy, m.uy), filter, &filterParamsY, srcHeight, false, &yWeights );
-
-			memset( accum.get(), 0, sizeof(int32_t) * dstWidth );
-
-			// loop over source scanlines that influence this dest scanline
-			for ( int32_t ayf = yWeights.start; ayf < yWeights.end; ayf++ ) {
-				typename SCALETRAIT<T>::SUMT *line = linesBuffer[ayf % filterParamsY.width].second.get();
-				if( linesBuffer[ayf % filterParamsY.width].first != ayf ) {
-					scanlineFilterChannelToBuffer( xWeights, srcOffsetX, srcOffsetY + ayf, *(srcChannels[chan]), line, dstWidth );
-					linesBuffer[ayf % filterParamsY.width].first = ayf;
-				}
-				scanlineAccumulate<typename SCALETRAIT<T>::SUMT,typename SCALETRAIT<T>::SUMT>( yWeights.weight[ayf - yWeights.start], line, dstWidth, accum.get() );
-			}
-
-			scanlineShiftAccumToChannel( accum.get(), clippedDstArea.getX1(), clippedDstArea.getY1() + dstY, dstWidth, dstChannels[chan] );
-		}
-	}
-
-	free( xWeights );
-	free( xWeightBuffer );
-	free( yWeights.weight );
-}
-
-template<typename LT, typename AT>
-void scanlineAccumulate( LT weight, LT *lineBuffer, int32_t width, AT *accum )
-{
-	AT *dest = accum;
-	int32_t x;
-
-	for ( x = 0; x < width; x++ )
-		*dest++ += *lineBuffer++ * weight;
-}
-
 template<typename T, typename WT>
 void makeWeightTable( float cen, const FilterBase &filter, const FilterParams *params, int32_t len, bool trimzeros, WeightTable<WT> *wtab )
 {
@@ -307,36 +199,610 @@ void makeWeightTable( float cen, const FilterBase &filter, const FilterParams *p
 	}   
 }
 
+// ----------------------------------------------------------------------------------------------------
+// MARK: - ContributionTable
+// ----------------------------------------------------------------------------------------------------
+
+// The sampled filter weights of every dest pixel along one axis. Each pixel's weights are padded with zeros to mMaxTaps, so
+// the inner loops can read whole pairs or vectors of them without bounds checks.
+template<typename WT>
+struct ContributionTable {
+	int32_t				mMaxTaps;
+	vector<int32_t>		mStart;			// first source sample of each dest pixel
+	vector<int32_t>		mNumTaps;		// number of source samples of each dest pixel
+	vector<WT>			mWeights;		// mMaxTaps weights per dest pixel
+	// integer tables also pack neighboring weights into int16 pairs for the SIMD multiply-adds
+	int32_t				mMaxPairs;
+	vector<int32_t>		mWeightPairs;
+	bool				mSimd;			// false if the weights don't fit the SIMD loops, which are then skipped
+
+	const WT*		getWeights( int32_t b ) const		{ return &mWeights[b * mMaxTaps]; }
+	const int32_t*	getWeightPairs( int32_t b ) const	{ return &mWeightPairs[b * mMaxPairs]; }
+};
+
 template<typename T>
-void resize( const SurfaceT<T> &srcSurface, const Area &srcArea, SurfaceT<T> *dstSurface, const Area &dstArea, const FilterBase &filter )
+shared_ptr<const ContributionTable<typename SCALETRAIT<T>::SUMT>> makeContributionTable( const FilterBase &filter, const FilterParams &params, float scale, float offset, int32_t dstLen, int32_t srcLen, bool trimzeros )
 {
-	vector<const ChannelT<T>*> srcChannels;
-	vector<ChannelT<T>*> dstChannels;
-
-	srcChannels.push_back( &srcSurface.getChannelRed() );
-	dstChannels.push_back( &dstSurface->getChannelRed() );
-	srcChannels.push_back( &srcSurface.getChannelGreen() );
-	dstChannels.push_back( &dstSurface->getChannelGreen() );
-	srcChannels.push_back( &srcSurface.getChannelBlue() );
-	dstChannels.push_back( &dstSurface->getChannelBlue() );
-	if ( srcSurface.hasAlpha() && dstSurface->hasAlpha() ) {
-		srcChannels.push_back( &srcSurface.getChannelAlpha() );
-		dstChannels.push_back( &dstSurface->getChannelAlpha() );	
+	typedef typename SCALETRAIT<T>::SUMT WT;
+
+	auto result = std::make_shared<ContributionTable<WT>>();
+	result->mMaxTaps = std::max<int32_t>( params.width, 1 );
+	result->mStart.resize( dstLen );
+	result->mNumTaps.resize( dstLen );
+	result->mWeights.resize( dstLen * result->mMaxTaps );
+
+	WeightTable<WT> wtab;
+	for( int32_t b = 0; b < dstLen; b++ ) {
+		wtab.weight = &result->mWeights[b * result->mMaxTaps];
+		makeWeightTable<T,WT>( MAP(b, scale, offset), filter, &params, srcLen, trimzeros, &wtab );
+		result->mStart[b] = wtab.start;
+		result->mNumTaps[b] = wtab.end - wtab.start;
+		// makeWeightTable() can leave stale weights past the end when it falls back to a single sample
+		std::fill( wtab.weight + result->mNumTaps[b], wtab.weight + result->mMaxTaps, WT( 0 ) );
+	}
+
+	result->mSimd = true;
+	result->mMaxPairs = 0;
+	if( std::numeric_limits<WT>::is_integer ) {
+		result->mMaxPairs = ( result->mMaxTaps + 1 ) / 2;
+		result->mWeightPairs.resize( dstLen * result->mMaxPairs );
+		for( int32_t b = 0; b < dstLen; b++ ) {
+			const WT *weights = result->getWeights( b );
+			for( int32_t i = 0; i < result->mMaxTaps; i++ ) {
+				if( weights[i] < std::numeric_limits<int16_t>::min() || weights[i] > std::numeric_limits<int16_t>::max() )
+					result->mSimd = false;
+				uint32_t weight = static_cast<uint16_t>( weights[i] );
+				result->mWeightPairs[b * result->mMaxPairs + i / 2] |= ( i % 2 ) ? ( weight << 16 ) : weight;
+			}
+		}
+	}
+
+	return result;
+}
+
+// The filters in Filter.h, which are completely described by their type, support and for FilterMitchell its b and c parameters
+enum class FilterId { BOX, TRIANGLE, QUADRATIC, CUBIC, CATMULL_ROM, MITCHELL, SINC_BLACKMAN, GAUSSIAN, BESSEL_BLACKMAN };
+
+// Identifies a ContributionTable
+struct ContributionTableKey {
+	FilterId	mFilter;
+	float		mSupport, mB, mC;
+	float		mScale, mOffset;
+	int32_t		mDstLen, mSrcLen;
+	bool		mTrimZeros;
+
+	bool operator<( const ContributionTableKey &rhs ) const
+	{
+		return std::tie( mFilter, mSupport, mB, mC, mScale, mOffset, mDstLen, mSrcLen, mTrimZeros )
+			< std::tie( rhs.mFilter, rhs.mSupport, rhs.mB, rhs.mC, rhs.mScale, rhs.mOffset, rhs.mDstLen, rhs.mSrcLen, rhs.mTrimZeros );
 	}
+};
 
-	resample( srcChannels, filter, srcArea, dstArea, dstChannels );
+// Fills in the filter part of \a key and returns true if \a filter is one of the filters in Filter.h. Subclasses and other filters
+// may compute anything from state the key can't see, so they return false.
+bool setFilterKey( const FilterBase &filter, ContributionTableKey *key )
+{
+	const std::type_info &type = typeid( filter );
+	key->mB = key->mC = 0;
+	if( type == typeid( FilterBox ) )
+		key->mFilter = FilterId::BOX;
+	else if( type == typeid( FilterTriangle ) )
+		key->mFilter = FilterId::TRIANGLE;
+	else if( type == typeid( FilterQuadratic ) )
+		key->mFilter = FilterId::QUADRATIC;
+	else if( type == typeid( FilterCubic ) )
+		key->mFilter = FilterId::CUBIC;
+	else if( type == typeid( FilterCatmullRom ) )
+		key->mFilter = FilterId::CATMULL_ROM;
+	else if( type == typeid( FilterMitchell ) ) {
+		key->mFilter = FilterId::MITCHELL;
+		key->mB = static_cast<const FilterMitchell &>( filter ).getB();
+		key->mC = static_cast<const FilterMitchell &>( filter ).getC();
+	}
+	else if( type == typeid( FilterSincBlackman ) )
+		key->mFilter = FilterId::SINC_BLACKMAN;
+	else if( type == typeid( FilterGaussian ) )
+		key->mFilter = FilterId::GAUSSIAN;
+#if ! defined( CINDER_COCOA_TOUCH )
+	else if( type == typeid( FilterBesselBlackman ) )
+		key->mFilter = FilterId::BESSEL_BLACKMAN;
+#endif
+	else
+		return false;
+
+	key->mSupport = filter.getSupport();
+	return true;
 }
 
+const size_t MAX_CACHED_CONTRIBUTION_TABLES = 32;
+
+// Returns the ContributionTable for one axis, reusing the table from a previous call with the same filter and dimensions.
 template<typename T>
-void resize( const ChannelT<T> &srcChannel, const Area &srcArea, ChannelT<T> *dstChannel, const Area &dstArea, const FilterBase &filter )
+shared_ptr<const ContributionTable<typename SCALETRAIT<T>::SUMT>> getContributionTable( const FilterBase &filter, const FilterParams &params, float scale, float offset, int32_t dstLen, int32_t srcLen, bool trimzeros )
+{
+	typedef ContributionTable<typename SCALETRAIT<T>::SUMT> TableT;
+	struct CacheEntry {
+		shared_ptr<const TableT>	mTable;
+		uint64_t					mLastUsed;
+	};
+
+	static std::mutex sMutex;
+	static std::map<ContributionTableKey, CacheEntry> sCache;
+	static uint64_t sUseCount = 0;
+
+	ContributionTableKey key;
+	key.mScale = scale;
+	key.mOffset = offset;
+	key.mDstLen = dstLen;
+	key.mSrcLen = srcLen;
+	key.mTrimZeros = trimzeros;
+
+	// NaN would break the ordering of the map
+	if( ! setFilterKey( filter, &key ) || std::isnan( key.mSupport ) || std::isnan( key.mB ) || std::isnan( key.mC ) || std::isnan( scale ) || std::isnan( offset ) )
+		return makeContributionTable<T>( filter, params, scale, offset, dstLen, srcLen, trimzeros );
+
+	{
+		std::lock_guard<std::mutex> lock( sMutex );
+		auto cached = sCache.find( key );
+		if( cached != sCache.end() ) {
+			cached->second.mLastUsed = ++sUseCount;
+			return cached->second.mTable;
+		}
+	}
+
+	auto result = makeContributionTable<T>( filter, params, scale, offset, dstLen, srcLen, trimzeros );
+
+	std::lock_guard<std::mutex> lock( sMutex );
+	if( sCache.size() >= MAX_CACHED_CONTRIBUTION_TABLES ) {
+		auto leastRecentlyUsed = std::min_element( sCache.begin(), sCache.end(), []( const pair<const ContributionTableKey, CacheEntry> &a, const pair<const ContributionTableKey, CacheEntry> &b ) {
+			return a.second.mLastUsed < b.second.mLastUsed;
+		} );
+		sCache.erase( leastRecentlyUsed );
+	}
+	sCache[key] = CacheEntry{ result, ++sUseCount };
+	return result;
+}
+
+// ----------------------------------------------------------------------------------------------------
+// MARK: - Horizontal and vertical passes
+// ----------------------------------------------------------------------------------------------------
+// The horizontal pass filters one source row into a line holding LANES values per dest pixel, the vertical pass then sums
+// weighted lines. Lanes are a pixel's channels in source memory order, so that a whole RGBA pixel fits in one SIMD register.
+
+template<typename T, int LANES>
+void filterRowScalar( const T *src, int32_t srcInc, const ContributionTable<typename SCALETRAIT<T>::SUMT> &table, int32_t dstWidth, typename SCALETRAIT<T>::LINET *line )
+{
+	typedef typename SCALETRAIT<T>::SUMT SUMT;
+
+	// 3 channel pixels leave the fourth lane empty
+	const int32_t numLanes = std::min<int32_t>( LANES, srcInc );
+	for( int32_t x = 0; x < dstWidth; x++ ) {
+		const SUMT *weights = table.getWeights( x );
+		const T *pixel = src + table.mStart[x] * srcInc;
+		const int32_t numTaps = table.mNumTaps[x];
+		for( int32_t lane = 0; lane < LANES; lane++ ) {
+			SUMT sum = std::numeric_limits<SUMT>::is_integer ? SUMT( 1 << 7 ) : SUMT( 0 );
+			if( lane < numLanes ) {
+				for( int32_t t = 0; t < numTaps; t++ )
+					sum += weights[t] * pixel[t * srcInc + lane];
+			}
+			*line++ = SCALETRAIT<T>::CHANNELTOBUFFER( sum );
+		}
+	}
+}
+
+template<typename T>
+void filterColumnsScalar( const typename SCALETRAIT<T>::LINET * const *lines, const typename SCALETRAIT<T>::SUMT *weights, int32_t numTaps, int32_t length, T *dst )
+{
+	typedef typename SCALETRAIT<T>::SUMT SUMT;
+
+	for( int32_t i = 0; i < length; i++ ) {
+		SUMT sum = 0;
+		for( int32_t t = 0; t < numTaps; t++ )
+			sum += lines[t][i] * weights[t];
+		dst[i] = SCALETRAIT<T>::ACCUMTOCHANNEL( sum );
+	}
+}
+
+#if defined( CINDER_IP_SSE )
+
+inline __m128i loadPixel( const uint8_t *pixel, int32_t inc )
+{
+	int32_t result;
+	if( inc == 4 )
+		memcpy( &result, pixel, 4 );
+	else
+		result = pixel[0] | ( pixel[1] << 8 ) | ( pixel[2] << 16 );
+
+	return _mm_cvtsi32_si128( result );
+}
+
+inline __m128 loadPixel( const float *pixel, int32_t inc )
+{
+	return ( inc == 4 ) ? _mm_loadu_ps( pixel ) : _mm_setr_ps( pixel[0], pixel[1], pixel[2], 0 );
+}
+
+inline __m128 loadPixel( const uint16_t *pixel, int32_t inc )
+{
+	if( inc == 4 )
+		return _mm_cvtepi32_ps( _mm_unpacklo_epi16( _mm_loadl_epi64( reinterpret_cast<const __m128i*>( pixel ) ), _mm_setzero_si128() ) );
+	else
+		return _mm_setr_ps( pixel[0], pixel[1], pixel[2], 0 );
+}
+
+// Multiplies pairs of 8 bit samples by packed int16 weight pairs; the results are identical to filterRowScalar().
+inline void filterRowSimd( const uint8_t *src, int32_t srcInc, const ContributionTable<int32_t> &table, int32_t dstWidth, int16_t *line )
+{
+	const __m128i zero = _mm_setzero_si128();
+	for( int32_t x = 0; x < dstWidth; x++ ) {
+		const int32_t *weightPairs = table.getWeightPairs( x );
+		const uint8_t *pixel = src + table.mStart[x] * srcInc;
+		const int32_t numTaps = table.mNumTaps[x];
+
+		__m128i sum = _mm_set1_epi32( 1 << 7 );
+		int32_t t = 0;
+		for( ; t + 1 < numTaps; t += 2, pixel += 2 * srcInc ) {
+			// interleave the channels of both pixels: a0 b0 a1 b1 a2 b2 a3 b3
+			__m128i pixels = _mm_unpacklo_epi8( _mm_unpacklo_epi8( loadPixel( pixel, srcInc ), loadPixel( pixel + srcInc, srcInc ) ), zero );
+			sum = _mm_add_epi32( sum, _mm_madd_epi16( pixels, _mm_set1_epi32( weightPairs[t / 2] ) ) );
+		}
+		if( t < numTaps ) {
+			// the upper weight of the last pair is zero
+			__m128i pixels = _mm_unpacklo_epi16( _mm_unpacklo_epi8( loadPixel( pixel, srcInc ), zero ), zero );
+			sum = _mm_add_epi32( sum, _mm_madd_epi16( pixels, _mm_set1_epi32( weightPairs[t / 2] ) ) );
+		}
+
+		sum = _mm_srai_epi32( sum, 8 );
+		_mm_storel_epi64( reinterpret_cast<__m128i*>( line + x * 4 ), _mm_packs_epi32( sum, sum ) );
+	}
+}
+
+template<typename T>
+void filterRowSimd( const T *src, int32_t srcInc, const ContributionTable<float> &table, int32_t dstWidth, float *line )
+{
+	for( int32_t x = 0; x < dstWidth; x++ ) {
+		const float *weights = table.getWeights( x );
+		const T *pixel = src + table.mStart[x] * srcInc;
+		const int32_t numTaps = table.mNumTaps[x];
+
+		__m128 sum = _mm_setzero_ps();
+		for( int32_t t = 0; t < numTaps; t++, pixel += srcInc )
+			sum = _mm_add_ps( sum, _mm_mul_ps( loadPixel( pixel, srcInc ), _mm_set1_ps( weights[t] ) ) );
+
+		_mm_storeu_ps( line + x * 4, sum );
+	}
+}
+
+// Processes two lines at a time, eight values per iteration. \a length must be a multiple of 8.
+inline void filterColumnsSimd( const int16_t * const *lines, const int32_t *weightPairs, int32_t numTaps, int32_t length, uint8_t *dst )
+{
+	const __m128i half = _mm_set1_epi32( SCALETRAIT<uint8_t>::HALFFINALSHIFT );
+	for( int32_t i = 0; i < length; i += 8 ) {
+		__m128i sumLo = half, sumHi = half;
+		for( int32_t t = 0; t < numTaps; t += 2 ) {
+			__m128i a = _mm_loadu_si128( reinterpret_cast<const __m128i*>( lines[t] + i ) );
+			// an odd last line is paired with itself and a zero weight
+			__m128i b = ( t + 1 < numTaps ) ? _mm_loadu_si128( reinterpret_cast<const __m128i*>( lines[t + 1] + i ) ) : a;
+			__m128i weights = _mm_set1_epi32( weightPairs[t / 2] );
+			sumLo = _mm_add_epi32( sumLo, _mm_madd_epi16( _mm_unpacklo_epi16( a, b ), weights ) );
+			sumHi = _mm_add_epi32( sumHi, _mm_madd_epi16( _mm_unpackhi_epi16( a, b ), weights ) );
+		}
+
+		sumLo = _mm_srai_epi32( sumLo, SCALETRAIT<uint8_t>::FINALSHIFT );
+		sumHi = _mm_srai_epi32( sumHi, SCALETRAIT<uint8_t>::FINALSHIFT );
+		__m128i result = _mm_packs_epi32( sumLo, sumHi );
+		_mm_storel_epi64( reinterpret_cast<__m128i*>( dst + i ), _mm_packus_epi16( result, result ) );
+	}
+}
+
+// \a length must be a multiple of 4.
+template<typename T>
+void filterColumnsSimd( const float * const *lines, const float *weights, int32_t numTaps, int32_t length, T *dst )
+{
+	for( int32_t i = 0; i < length; i += 4 ) {
+		__m128 sum = _mm_setzero_ps();
+		for( int32_t t = 0; t < numTaps; t++ )
+			sum = _mm_add_ps( sum, _mm_mul_ps( _mm_loadu_ps( lines[t] + i ), _mm_set1_ps( weights[t] ) ) );
+
+		float result[4];
+		_mm_storeu_ps( result, sum );
+		for( int32_t j = 0; j < 4; j++ )
+			dst[i + j] = SCALETRAIT<T>::ACCUMTOCHANNEL( result[j] );
+	}
+}
+
+#elif defined( CINDER_IP_NEON )
+
+inline int16x4_t loadPixel( const uint8_t *pixel, int32_t inc )
+{
+	uint32_t result;
+	if( inc == 4 )
+		memcpy( &result, pixel, 4 );
+	else
+		result = pixel[0] | ( pixel[1] << 8 ) | ( pixel[2] << 16 );
+
+	return vreinterpret_s16_u16( vget_low_u16( vmovl_u8( vreinterpret_u8_u32( vdup_n_u32( result ) ) ) ) );
+}
+
+inline float32x4_t loadPixel( const float *pixel, int32_t inc )
+{
+	if( inc == 4 )
+		return vld1q_f32( pixel );
+
+	const float result[4] = { pixel[0], pixel[1], pixel[2], 0 };
+	return vld1q_f32( result );
+}
+
+inline float32x4_t loadPixel( const uint16_t *pixel, int32_t inc )
+{
+	if( inc == 4 )
+		return vcvtq_f32_u32( vmovl_u16( vld1_u16( pixel ) ) );
+
+	const float result[4] = { pixel[0], pixel[1], pixel[2], 0 };
+	return vld1q_f32( result );
+}
+
+inline void filterRowSimd( const uint8_t *src, int32_t srcInc, const ContributionTable<int32_t> &table, int32_t dstWidth, int16_t *line )
 {
-	vector<const ChannelT<T>*> srcChannels;
-	vector<ChannelT<T>*> dstChannels;
+	for( int32_t x = 0; x < dstWidth; x++ ) {
+		const int32_t *weights = table.getWeights( x );
+		const uint8_t *pixel = src + table.mStart[x] * srcInc;
+		const int32_t numTaps = table.mNumTaps[x];
+
+		int32x4_t sum = vdupq_n_s32( 1 << 7 );
+		for( int32_t t = 0; t < numTaps; t++, pixel += srcInc )
+			sum = vmlal_n_s16( sum, loadPixel( pixel, srcInc ), static_cast<int16_t>( weights[t] ) );
+
+		vst1_s16( line + x * 4, vqmovn_s32( vshrq_n_s32( sum, 8 ) ) );
+	}
+}
+
+template<typename T>
+void filterRowSimd( const T *src, int32_t srcInc, const ContributionTable<float> &table, int32_t dstWidth, float *line )
+{
+	for( int32_t x = 0; x < dstWidth; x++ ) {
+		const float *weights = table.getWeights( x );
+		const T *pixel = src + table.mStart[x] * srcInc;
+		const int32_t numTaps = table.mNumTaps[x];
+
+		float32x4_t sum = vdupq_n_f32( 0 );
+		for( int32_t t = 0; t < numTaps; t++, pixel += srcInc )
+			sum = vaddq_f32( sum, vmulq_n_f32( loadPixel( pixel, srcInc ), weights[t] ) );
+
+		vst1q_f32( line + x * 4, sum );
+	}
+}
+
+// \a length must be a multiple of 8.
+inline void filterColumnsSimd( const int16_t * const *lines, const int32_t *weights, int32_t numTaps, int32_t length, uint8_t *dst )
+{
+	for( int32_t i = 0; i < length; i += 8 ) {
+		int32x4_t sumLo = vdupq_n_s32( SCALETRAIT<uint8_t>::HALFFINALSHIFT );
+		int32x4_t sumHi = sumLo;
+		for( int32_t t = 0; t < numTaps; t++ ) {
+			int16x8_t line = vld1q_s16( lines[t] + i );
+			sumLo = vmlal_n_s16( sumLo, vget_low_s16( line ), static_cast<int16_t>( weights[t] ) );
+			sumHi = vmlal_n_s16( sumHi, vget_high_s16( line ), static_cast<int16_t>( weights[t] ) );
+		}
+
+		int16x8_t result = vcombine_s16( vqmovn_s32( vshrq_n_s32( sumLo, SCALETRAIT<uint8_t>::FINALSHIFT ) ), vqmovn_s32( vshrq_n_s32( sumHi, SCALETRAIT<uint8_t>::FINALSHIFT ) ) );
+		vst1_u8( dst + i, vqmovun_s16( result ) );
+	}
+}
+
+// \a length must be a multiple of 4.
+template<typename T>
+void filterColumnsSimd( const float * const *lines, const float *weights, int32_t numTaps, int32_t length, T *dst )
+{
+	for( int32_t i = 0; i < length; i += 4 ) {
+		float32x4_t sum = vdupq_n_f32( 0 );
+		for( int32_t t = 0; t < numTaps; t++ )
+			sum = vaddq_f32( sum, vmulq_n_f32( vld1q_f32( lines[t] + i ), weights[t] ) );
+
+		float result[4];
+		vst1q_f32( result, sum );
+		for( int32_t j = 0; j < 4; j++ )
+			dst[i + j] = SCALETRAIT<T>::ACCUMTOCHANNEL( result[j] );
+	}
+}
+
+#endif // defined( CINDER_IP_NEON )
+
+template<typename T, int LANES>
+void filterRow( const T *src, int32_t srcInc, const ContributionTable<typename SCALETRAIT<T>::SUMT> &table, int32_t dstWidth, typename SCALETRAIT<T>::LINET *line )
+{
+#if defined( CINDER_IP_SSE ) || defined( CINDER_IP_NEON )
+	if( LANES == 4 && table.mSimd ) {
+		filterRowSimd( src, srcInc, table, dstWidth, line );
+		return;
+	}
+#endif
+	filterRowScalar<T, LANES>( src, srcInc, table, dstWidth, line );
+}
+
+inline void filterColumns( const int16_t * const *lines, const ContributionTable<int32_t> &table, int32_t b, int32_t length, uint8_t *dst )
+{
+#if defined( CINDER_IP_SSE )
+	if( table.mSimd ) {
+		filterColumnsSimd( lines, table.getWeightPairs( b ), table.mNumTaps[b], length, dst );
+		return;
+	}
+#elif defined( CINDER_IP_NEON )
+	if( table.mSimd ) {
+		filterColumnsSimd( lines, table.getWeights( b ), table.mNumTaps[b], length, dst );
+		return;
+	}
+#endif
+	filterColumnsScalar<uint8_t>( lines, table.getWeights( b ), table.mNumTaps[b], length, dst );
+}
+
+template<typename T>
+void filterColumns( const float * const *lines, const ContributionTable<float> &table, int32_t b, int32_t length, T *dst )
+{
+#if defined( CINDER_IP_SSE ) || defined( CINDER_IP_NEON )
+	filterColumnsSimd( lines, table.getWeights( b ), table.mNumTaps[b], length, dst );
+#else
+	filterColumnsScalar<T>( lines, table.getWeights( b ), table.mNumTaps[b], length, dst );
+#endif
+}
+
+// ----------------------------------------------------------------------------------------------------
+// MARK: - resample
+// ----------------------------------------------------------------------------------------------------
+
+// Where resample() reads and writes pixels. mDstOffsets maps each lane to a channel of the dest pixel, or -1 to skip it.
+struct ResampleLayout {
+	Area		mSrcBounds, mDstBounds;
+	const void	*mSrcData;
+	ptrdiff_t	mSrcRowBytes;
+	int32_t		mSrcInc;
+	void		*mDstData;
+	ptrdiff_t	mDstRowBytes;
+	int32_t		mDstInc;
+	int32_t		mDstOffsets[4];
+};
+
+// Below this many multiply-adds (~a 512x512 RGBA image with a short filter) resizing isn't worth spreading over threads.
+const int64_t MIN_PARALLEL_WORK = 1 << 22;
+
+// Dest rows are processed in bands, each of which first filters the source rows it needs horizontally and then vertically.
+// Neighboring bands recompute the few source rows they share so that bands are independent of each other.
+template<typename T, int LANES>
+void resample( const ResampleLayout &layout, const FilterBase &filter, const Area &srcArea, const Area &dstArea )
+{
+	typedef typename SCALETRAIT<T>::LINET LINET;
+
+	Rectf clippedSrcRect;
+	Area clippedDstArea;
+	getClippedScaledRects( layout.mSrcBounds, Rectf( srcArea ), layout.mDstBounds, dstArea, &clippedSrcRect, &clippedDstArea );
 	
-	srcChannels.push_back( &srcChannel );
-	dstChannels.push_back( dstChannel );
+	if ( ( clippedSrcRect.getWidth() <= 0 ) || ( clippedDstArea.getWidth() <= 0 ) 
+		|| ( clippedSrcRect.getHeight() <= 0 ) || ( clippedDstArea.getHeight() <= 0 ) )
+		return;
 	
-	resample( srcChannels, filter, srcArea, dstArea, dstChannels );
+	FilterParams filterParamsX, filterParamsY;
+	Mapping m;
+	int32_t dstWidth = (int32_t)clippedDstArea.getWidth(), dstHeight = (int32_t)clippedDstArea.getHeight();
+	int32_t srcWidth = (int32_t)clippedSrcRect.getWidth(), srcHeight = (int32_t)clippedSrcRect.getHeight();
+	int32_t srcOffsetX = static_cast<int32_t>( floor( clippedSrcRect.getX1() ) );
+	int32_t srcOffsetY = static_cast<int32_t>( floor( clippedSrcRect.getY1() ) );
+
+	m.sx = dstWidth / (float)srcWidth;
+	m.sy = dstHeight / (float)srcHeight;
+	m.tx = clippedDstArea.getX1() - 0.5f - m.sx * ( clippedSrcRect.getX1() - 0.5f );
+	m.ty = clippedDstArea.getY1() - 0.5f - m.sy * ( clippedSrcRect.getY1() - 0.5f );
+	m.ux = clippedDstArea.getX1() - m.sx * ( clippedSrcRect.getX1()- 0.5f ) - m.tx;
+	m.uy = clippedDstArea.getY1() - m.sy * ( clippedSrcRect.getY1()- 0.5f ) - m.ty;
+
+	filterParamsX.scale = std::max( 1.0f, 1.0f / m.sx );
+	filterParamsX.supp = std::max( 0.5f, filterParamsX.scale * filter.getSupport() );
+	filterParamsX.width = (int32_t)ceil( 2.0f * filterParamsX.supp );
+
+	filterParamsY.scale = std::max( 1.0f, 1.0f / m.sy );
+	filterParamsY.supp = std::max( 0.5f, filterParamsY.scale * filter.getSupport() );
+	filterParamsY.width = (int32_t)ceil( 2.0f * filterParamsY.supp );
+
+	auto xTable = getContributionTable<T>( filter, filterParamsX, m.sx, m.ux, dstWidth, srcWidth, true );
+	auto yTable = getContributionTable<T>( filter, filterParamsY, m.sy, m.uy, dstHeight, srcHeight, false );
+
+	const uint8_t *srcOrigin = static_cast<const uint8_t*>( layout.mSrcData ) + srcOffsetY * layout.mSrcRowBytes + srcOffsetX * layout.mSrcInc * sizeof(T);
+	uint8_t *dstOrigin = static_cast<uint8_t*>( layout.mDstData ) + clippedDstArea.getY1() * layout.mDstRowBytes + clippedDstArea.getX1() * layout.mDstInc * sizeof(T);
+
+	// lines are padded to whole SIMD vectors
+	const int32_t lineLength = ( dstWidth * LANES + 7 ) & ~7;
+	bool directStore = ( layout.mDstInc == LANES );
+	for( int32_t lane = 0; lane < LANES; lane++ )
+		directStore = directStore && ( layout.mDstOffsets[lane] == lane );
+
+	const int64_t work = int64_t( dstWidth ) * LANES * ( int64_t( srcHeight ) * xTable->mMaxTaps + int64_t( dstHeight ) * yTable->mMaxTaps );
+	const size_t numThreads = ( work >= MIN_PARALLEL_WORK ) ? getExecutionPolicy().getNumThreads() : 1;
+	// a few bands per thread balance the load, while bands of at least 8 rows keep the shared source rows cheap
+	const int32_t bandRows = std::min<int32_t>( std::max<int32_t>( dstHeight / int32_t( numThreads * 4 ), 8 ), 64 );
+	const int32_t numBands = ( dstHeight + bandRows - 1 ) / bandRows;
+
+	auto processBand = [&]( int32_t band ) {
+		const int32_t dstY1 = band * bandRows;
+		const int32_t dstY2 = std::min( dstY1 + bandRows, dstHeight );
+
+		int32_t srcY1 = std::numeric_limits<int32_t>::max(), srcY2 = 0;
+		for( int32_t dstY = dstY1; dstY < dstY2; dstY++ ) {
+			srcY1 = std::min( srcY1, yTable->mStart[dstY] );
+			srcY2 = std::max( srcY2, yTable->mStart[dstY] + yTable->mNumTaps[dstY] );
+		}
+
+		vector<LINET> lines( ( srcY2 - srcY1 ) * lineLength );
+		for( int32_t srcY = srcY1; srcY < srcY2; srcY++ ) {
+			const T *src = reinterpret_cast<const T*>( srcOrigin + srcY * layout.mSrcRowBytes );
+			filterRow<T, LANES>( src, layout.mSrcInc, *xTable, dstWidth, &lines[( srcY - srcY1 ) * lineLength] );
+		}
+
+		vector<const LINET*> taps( yTable->mMaxTaps );
+		vector<T> row( lineLength );
+		for( int32_t dstY = dstY1; dstY < dstY2; dstY++ ) {
+			for( int32_t t = 0; t < yTable->mNumTaps[dstY]; t++ )
+				taps[t] = &lines[( yTable->mStart[dstY] + t - srcY1 ) * lineLength];
+			filterColumns( taps.data(), *yTable, dstY, lineLength, row.data() );
+
+			T *dst = reinterpret_cast<T*>( dstOrigin + dstY * layout.mDstRowBytes );
+			if( directStore )
+				memcpy( dst, row.data(), dstWidth * LANES * sizeof(T) );
+			else {
+				for( int32_t x = 0; x < dstWidth; x++ ) {
+					for( int32_t lane = 0; lane < LANES; lane++ ) {
+						if( layout.mDstOffsets[lane] >= 0 )
+							dst[x * layout.mDstInc + layout.mDstOffsets[lane]] = row[x * LANES + lane];
+					}
+				}
+			}
+		}
+	};
+
+	// below MIN_PARALLEL_WORK all bands are processed as a single task on the calling thread
+	parallelFor( 0, numBands, ( numThreads > 1 ) ? 1 : numBands, [&]( int32_t firstBand, int32_t lastBand ) {
+		for( int32_t band = firstBand; band < lastBand; band++ )
+			processBand( band );
+	} );
+}
+
+template<typename T>
+void resize( const SurfaceT<T> &srcSurface, const Area &srcArea, SurfaceT<T> *dstSurface, const Area &dstArea, const FilterBase &filter )
+{
+	ResampleLayout layout;
+	layout.mSrcBounds = srcSurface.getBounds();
+	layout.mSrcData = srcSurface.getData();
+	layout.mSrcRowBytes = srcSurface.getRowBytes();
+	layout.mSrcInc = srcSurface.getPixelInc();
+	layout.mDstBounds = dstSurface->getBounds();
+	layout.mDstData = dstSurface->getData();
+	layout.mDstRowBytes = dstSurface->getRowBytes();
+	layout.mDstInc = dstSurface->getPixelInc();
+
+	// all channels of a pixel are filtered together, in the source's channel order
+	std::fill( layout.mDstOffsets, layout.mDstOffsets + 4, -1 );
+	layout.mDstOffsets[srcSurface.getRedOffset()] = dstSurface->getRedOffset();
+	layout.mDstOffsets[srcSurface.getGreenOffset()] = dstSurface->getGreenOffset();
+	layout.mDstOffsets[srcSurface.getBlueOffset()] = dstSurface->getBlueOffset();
+	if ( srcSurface.hasAlpha() && dstSurface->hasAlpha() )
+		layout.mDstOffsets[srcSurface.getAlphaOffset()] = dstSurface->getAlphaOffset();
+
+	resample<T, 4>( layout, filter, srcArea, dstArea );
+}
+
+template<typename T>
+void resize( const ChannelT<T> &srcChannel, const Area &srcArea, ChannelT<T> *dstChannel, const Area &dstArea, const FilterBase &filter )
+{
+	ResampleLayout layout;
+	layout.mSrcBounds = srcChannel.getBounds();
+	layout.mSrcData = srcChannel.getData();
+	layout.mSrcRowBytes = srcChannel.getRowBytes();
+	layout.mSrcInc = srcChannel.getIncrement();
+	layout.mDstBounds = dstChannel->getBounds();
+	layout.mDstData = dstChannel->getData();
+	layout.mDstRowBytes = dstChannel->getRowBytes();
+	layout.mDstInc = dstChannel->getIncrement();
+	layout.mDstOffsets[0] = 0;
+
+	resample<T, 1>( layout, filter, srcArea, dstArea );
 }
 
 template<typename T>
@@ -368,6 +834,7 @@ void resize( const ChannelT<T> &srcChannel, ChannelT<T> *dstChannel, const Filte
 
 // These should match CHANNEL_TYPES
 resize_PROTOTYPES(uint8_t)
+resize_PROTOTYPES(uint16_t)
 resize_PROTOTYPES(float)
 
 } } // namespace cinder::ip
@@ -21,6 +21,7 @@
 */
 
 #include "cinder/ip/Threshold.h"
+#include "cinder/ip/Execution.h"
 #include "cinder/ChanTraits.h"
 
 #include <stdlib.h>
@@ -35,15 +36,17 @@ void thresholdImpl( SurfaceT<T> *surface, T value, const Area &area )
 	uint8_t pixelInc = surface->getPixelInc();
 	uint8_t redOffset = surface->getRedOffset(), greenOffset = surface->getGreenOffset(), blueOffset = surface->getBlueOffset();
 	T maxValue = CHANTRAIT<T>::max();
-	for( int32_t y = clippedArea.getY1(); y < clippedArea.getY2(); ++y ) {
-		T *dstPtr = reinterpret_cast<T*>( reinterpret_cast<uint8_t*>( surface->getData() + clippedArea.getX1() * pixelInc ) + y * rowBytes );
-		for( int32_t x = 0; x < clippedArea.getWidth(); ++x ) {
-			dstPtr[redOffset] = ( dstPtr[redOffset] > value ) ? maxValue : 0;
-			dstPtr[greenOffset] = ( dstPtr[greenOffset] > value ) ? maxValue : 0;
-			dstPtr[blueOffset] = ( dstPtr[blueOffset] > value ) ? maxValue : 0;;
-			dstPtr += pixelInc;
-		}
-	}	
+	parallelForRows( clippedArea, [&]( const Area &band ) {
+		for( int32_t y = band.getY1(); y < band.getY2(); ++y ) {
+			T *dstPtr = reinterpret_cast<T*>( reinterpret_cast<uint8_t*>( surface->getData() + clippedArea.getX1() * pixelInc ) + y * rowBytes );
+			for( int32_t x = 0; x < clippedArea.getWidth(); ++x ) {
+				dstPtr[redOffset] = ( dstPtr[redOffset] > value ) ? maxValue : 0;
+				dstPtr[greenOffset] = ( dstPtr[greenOffset] > value ) ? maxValue : 0;
+				dstPtr[blueOffset] = ( dstPtr[blueOffset] > value ) ? maxValue : 0;;
+				dstPtr += pixelInc;
+			}
+		}	
+	} );
 }
 
 template<typename T>
@@ -60,17 +63,19 @@ void thresholdImpl( const SurfaceT<T> &srcSurface, T value, const Area &srcArea,
 	uint8_t dstPixelInc = dstSurface->getPixelInc();
 	uint8_t dstRedOffset = dstSurface->getRedOffset(), dstGreenOffset = dstSurface->getGreenOffset(), dstBlueOffset = dstSurface->getBlueOffset();
 	const T maxValue = CHANTRAIT<T>::max();
-	for( int32_t y = 0; y < area.getHeight(); ++y ) {
-		T *dstPtr = reinterpret_cast<T*>( reinterpret_cast<uint8_t*>( dstSurface->getData() + ( dstOffset.x + area.getX1() ) * dstPixelInc ) + ( y + dstOffset.y ) * dstRowBytes );
-		const T *srcPtr = reinterpret_cast<const T*>( reinterpret_cast<const uint8_t*>( srcSurface.getData() + area.getX1() * srcPixelInc ) + ( y + area.getY1() ) * srcRowBytes );
-		for( int32_t x = area.getX1(); x < area.getX2(); ++x ) {
-			dstPtr[dstRedOffset] = ( srcPtr[srcRedOffset] > value ) ? maxValue : 0;
-			dstPtr[dstGreenOffset] = ( srcPtr[srcGreenOffset] > value ) ? maxValue : 0;
-			dstPtr[dstBlueOffset] = ( srcPtr[srcBlueOffset] > value ) ? maxValue : 0;;			
-			dstPtr += dstPixelInc;
-			srcPtr += srcPixelInc;
+	parallelForRows( Area( 0, 0, area.getWidth(), area.getHeight() ), [&]( const Area &band ) {
+		for( int32_t y = band.getY1(); y < band.getY2(); ++y ) {
+			T *dstPtr = reinterpret_cast<T*>( reinterpret_cast<uint8_t*>( dstSurface->getData() + ( dstOffset.x + area.getX1() ) * dstPixelInc ) + ( y + dstOffset.y ) * dstRowBytes );
+			const T *srcPtr = reinterpret_cast<const T*>( reinterpret_cast<const uint8_t*>( srcSurface.getData() + area.getX1() * srcPixelInc ) + ( y + area.getY1() ) * srcRowBytes );
+			for( int32_t x = area.getX1(); x < area.getX2(); ++x ) {
+				dstPtr[dstRedOffset] = ( srcPtr[srcRedOffset] > value ) ? maxValue : 0;
+				dstPtr[dstGreenOffset] = ( srcPtr[srcGreenOffset] > value ) ? maxValue : 0;
+				dstPtr[dstBlueOffset] = ( srcPtr[srcBlueOffset] > value ) ? maxValue : 0;;			
+				dstPtr += dstPixelInc;
+				srcPtr += srcPixelInc;
+			}
 		}
-	}
+	} );
 }
 
 template<typename T>
@@ -83,15 +88,17 @@ void thresholdImpl( const ChannelT<T> &srcChannel, T value, const Area &srcArea,
 	uint8_t srcInc = srcChannel.getIncrement();
 	uint8_t dstInc = dstChannel->getIncrement();
 	const T maxValue = CHANTRAIT<T>::max();
-	for( int32_t y = 0; y < area.getHeight(); ++y ) {
-		T *dstPtr = dstChannel->getData( ivec2( area.getX1(), y ) + dstOffset );
-		const T *srcPtr = srcChannel.getData( ivec2( area.getX1(), y ) );
-		for( int32_t x = area.getX1(); x < area.getX2(); ++x ) {
-			*dstPtr = ( *srcPtr > value ) ? maxValue : 0;
-			dstPtr += dstInc;
-			srcPtr += srcInc;
+	parallelForRows( Area( 0, 0, area.getWidth(), area.getHeight() ), [&]( const Area &band ) {
+		for( int32_t y = band.getY1(); y < band.getY2(); ++y ) {
+			T *dstPtr = dstChannel->getData( ivec2( area.getX1(), y ) + dstOffset );
+			const T *srcPtr = srcChannel.getData( ivec2( area.getX1(), y ) );
+			for( int32_t x = area.getX1(); x < area.getX2(); ++x ) {
+				*dstPtr = ( *srcPtr > value ) ? maxValue : 0;
+				dstPtr += dstInc;
+				srcPtr += srcInc;
+			}
 		}
-	}
+	} );
 }
 
 template<typename T>
@@ -134,36 +141,38 @@ void calculateAdaptiveThreshold( const ChannelT<T> *srcChannel, typename CHANTRA
 	const T maxValue = CHANTRAIT<T>::max();
 
 	// perform thresholding
-	for( int32_t j = 0; j < imageHeight; j++ ) {
-		T *dstLine = dstChannel->getData( 0, j );
-		T *dst = dstLine;
-		const T *srcLine = srcChannel->getData( 0, j );
-		const T *src = srcLine;
-		for( int32_t i = 0; i< imageWidth; i++ ) {
-
-			// set the SxS region
-			int32_t x1 = i - s2, x2 = i + s2;
-			int32_t y1 = j - s2, y2 = j + s2;
-
-			// check the border
-			if( x1 < 0 ) x1 = 0;
-			if( x2 >= imageWidth ) x2 = imageWidth - 1;
-			if( y1 < 0 ) y1 = 0;
-			if( y2 >= imageHeight ) y2 = imageHeight - 1;
+	parallelForRows( Area( 0, 0, imageWidth, imageHeight ), [&]( const Area &band ) {
+		for( int32_t j = band.getY1(); j < band.getY2(); j++ ) {
+			T *dstLine = dstChannel->getData( 0, j );
+			T *dst = dstLine;
+			const T *srcLine = srcChannel->getData( 0, j );
+			const T *src = srcLine;
+			for( int32_t i = 0; i< imageWidth; i++ ) {
+
+				// set the SxS region
+				int32_t x1 = i - s2, x2 = i + s2;
+				int32_t y1 = j - s2, y2 = j + s2;
+
+				// check the border
+				if( x1 < 0 ) x1 = 0;
+				if( x2 >= imageWidth ) x2 = imageWidth - 1;
+				if( y1 < 0 ) y1 = 0;
+				if( y2 >= imageHeight ) y2 = imageHeight - 1;
 			
-			int32_t count = ( x2 - x1 ) * ( y2 - y1 );
-
-			// I(x,y)=s(x2,y2)-s(x1,y2)-s(x2,y1)+s(x1,x1)
-			SUMT sum =	integralImage[y2 * imageWidth + x2] -
-						integralImage[y1 * imageWidth + x2] -
-						integralImage[y2 * imageWidth + x1] +
-						integralImage[y1 * imageWidth + x1];
-
-			*dst = ( (SUMT)(*src * count) < (sum * comparisonMult / 256) ) ? 0 : maxValue;
-			dst += dstInc;
-			src += srcInc;
+				int32_t count = ( x2 - x1 ) * ( y2 - y1 );
+
+				// I(x,y)=s(x2,y2)-s(x1,y2)-s(x2,y1)+s(x1,x1)
+				SUMT sum =	integralImage[y2 * imageWidth + x2] -
+							integralImage[y1 * imageWidth + x2] -
+							integralImage[y2 * imageWidth + x1] +
+							integralImage[y1 * imageWidth + x1];
+
+				*dst = ( (SUMT)(*src * count) < (sum * comparisonMult / 256) ) ? 0 : maxValue;
+				dst += dstInc;
+				src += srcInc;
+			}
 		}
-	}
+	} );
 }
 
 template<typename T>
@@ -178,39 +187,41 @@ void calculateAdaptiveThresholdZero( const ChannelT<T> *srcChannel, typename CHA
 	uint8_t dstInc = dstChannel->getIncrement();
 
 	// perform thresholding
-	for( int32_t j = 0; j < imageHeight; j++ ) {
-		T *dstLine = dstChannel->getData( 0, j );
-		T *dst = dstLine;
-		const T *srcLine = srcChannel->getData( 0, j );
-		const T *src = srcLine;
-		for( int32_t i = 0; i< imageWidth; i++ ) {
-
-			// set the SxS region
-			int32_t x1 = i - s2, x2 = i + s2;
-			int32_t y1 = j - s2, y2 = j + s2;
-
-			// check the border
-			if( x1 < 0 ) x1 = 0;
-			if( x2 >= imageWidth ) x2 = imageWidth - 1;
-			if( y1 < 0 ) y1 = 0;
-			if( y2 >= imageHeight ) y2 = imageHeight - 1;
+	parallelForRows( Area( 0, 0, imageWidth, imageHeight ), [&]( const Area &band ) {
+		for( int32_t j = band.getY1(); j < band.getY2(); j++ ) {
+			T *dstLine = dstChannel->getData( 0, j );
+			T *dst = dstLine;
+			const T *srcLine = srcChannel->getData( 0, j );
+			const T *src = srcLine;
+			for( int32_t i = 0; i< imageWidth; i++ ) {
+
+				// set the SxS region
+				int32_t x1 = i - s2, x2 = i + s2;
+				int32_t y1 = j - s2, y2 = j + s2;
+
+				// check the border
+				if( x1 < 0 ) x1 = 0;
+				if( x2 >= imageWidth ) x2 = imageWidth - 1;
+				if( y1 < 0 ) y1 = 0;
+				if( y2 >= imageHeight ) y2 = imageHeight - 1;
 			
-			int32_t count = ( x2 - x1 ) * ( y2 - y1 );
-
-			// I(x,y)=s(x2,y2)-s(x1,y2)-s(x2,y1)+s(x1,x1)
-			SUMT sum =	integralImage[y2 * imageWidth + x2] -
-						integralImage[y1 * imageWidth + x2] -
-						integralImage[y2 * imageWidth + x1] +
-						integralImage[y1 * imageWidth + x1];
-
-			//*dst = ( (*dst * count) < sum ) ? 0 : maxValue;
-			int32_t diffSignExtended = (int32_t)( sum - *src * count );
-			diffSignExtended >>= 31;
-			*dst = (T)(diffSignExtended & 0xFF);
-			dst += dstInc;
-			src += srcInc;
+				int32_t count = ( x2 - x1 ) * ( y2 - y1 );
+
+				// I(x,y)=s(x2,y2)-s(x1,y2)-s(x2,y1)+s(x1,x1)
+				SUMT sum =	integralImage[y2 * imageWidth + x2] -
+							integralImage[y1 * imageWidth + x2] -
+							integralImage[y2 * imageWidth + x1] +
+							integralImage[y1 * imageWidth + x1];
+
+				//*dst = ( (*dst * count) < sum ) ? 0 : maxValue;
+				int32_t diffSignExtended = (int32_t)( sum - *src * count );
+				diffSignExtended >>= 31;
+				*dst = (T)(diffSignExtended & 0xFF);
+				dst += dstInc;
+				src += srcInc;
+			}
 		}
-	}
+	} );
 
 }
 
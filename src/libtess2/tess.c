@@ -525,6 +525,7 @@ TESStesselator* tessNewTess( TESSalloc* alloc )
 
 	// Initialize to begin polygon.
 	tess->mesh = NULL;
+	tess->outOfMemory = 0;
 
 	tess->vertices = 0;
 	tess->vertexCount = 0;
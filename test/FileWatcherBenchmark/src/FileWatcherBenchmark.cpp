@@ -0,0 +1,116 @@
+// Compares the FileWatcher backends as the number of watched files grows, with one watch per file as an app that reloads shaders
+// and assets would set up. For each backend and file count the table lists the time taken to add all watches, the CPU time used
+// while nothing changes (as a percentage of one core) and the time from modifying a file until its callback fires.
+// CPU time is measured with std::clock(), which only reports process CPU time on POSIX platforms.
+
+#include "cinder/FileWatcher.h"
+#include "cinder/Rand.h"
+
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace ci;
+
+const int FILE_COUNTS[] = { 100, 1000, 10000, 20000 };
+const int FILES_PER_DIRECTORY = 100;
+const double IDLE_SECONDS = 2;
+const int NUM_MODIFICATIONS = 20;
+
+struct Result {
+	double	mSetupMs, mIdleCpuPercent, mMeanLatencyMs, mMaxLatencyMs;
+};
+
+vector<fs::path> createFiles( const fs::path &dir, int numFiles )
+{
+	vector<fs::path> result;
+	for( int i = 0; i < numFiles; i++ ) {
+		fs::path subdir = dir / ( "dir" + to_string( i / FILES_PER_DIRECTORY ) );
+		if( i % FILES_PER_DIRECTORY == 0 )
+			fs::create_directories( subdir );
+
+		result.push_back( subdir / ( "shader" + to_string( i ) + ".glsl" ) );
+		ofstream( result.back().string() ) << "void main() {}";
+	}
+
+	return result;
+}
+
+Result measure( FileWatcher::Backend backend, const vector<fs::path> &files )
+{
+	Result result;
+	FileWatcher watcher( backend );
+	watcher.setConnectToAppUpdateEnabled( false );
+
+	vector<fs::path> modified;
+	auto setupStart = chrono::steady_clock::now();
+	for( const auto &file : files ) {
+		watcher.watch( file, FileWatcher::Options().callOnWatch( false ), [&modified]( const WatchEvent &event ) {
+			modified.insert( modified.end(), event.getFiles().begin(), event.getFiles().end() );
+		} );
+	}
+	result.mSetupMs = chrono::duration<double, milli>( chrono::steady_clock::now() - setupStart ).count();
+
+	// the main thread sleeps, so all CPU time is spent by the watcher
+	clock_t cpuStart = clock();
+	this_thread::sleep_for( chrono::duration<double>( IDLE_SECONDS ) );
+	result.mIdleCpuPercent = 100.0 * ( clock() - cpuStart ) / CLOCKS_PER_SEC / IDLE_SECONDS;
+
+	// modify files one at a time, calling update() as an app would, but at a much higher rate
+	Rand rand( 1 );
+	vector<double> latencies;
+	for( int i = 0; i < NUM_MODIFICATIONS; i++ ) {
+		const fs::path &file = files[rand.nextUint( (uint32_t)files.size() )];
+		modified.clear();
+
+		auto start = chrono::steady_clock::now();
+		ofstream( file.string() ) << "void main() { /* " << i << " */ }";
+		while( find( modified.begin(), modified.end(), file ) == modified.end() && chrono::steady_clock::now() - start < chrono::seconds( 5 ) ) {
+			this_thread::sleep_for( chrono::microseconds( 200 ) );
+			watcher.update();
+		}
+		latencies.push_back( chrono::duration<double, milli>( chrono::steady_clock::now() - start ).count() );
+
+		// keep the next write's last write time apart from this one's, which polling relies on
+		this_thread::sleep_for( chrono::milliseconds( 20 ) );
+	}
+
+	result.mMeanLatencyMs = 0;
+	for( double latency : latencies )
+		result.mMeanLatencyMs += latency / latencies.size();
+	result.mMaxLatencyMs = *max_element( latencies.begin(), latencies.end() );
+	return result;
+}
+
+int main( int argc, char *argv[] )
+{
+	const fs::path dir = fs::temp_directory_path() / "cinder_FileWatcherBenchmark";
+	fs::remove_all( dir );
+
+	const pair<string, FileWatcher::Backend> backends[] = { { "polling", FileWatcher::Backend::POLLING }, { "native", FileWatcher::Backend::NATIVE } };
+	if( FileWatcher().getBackend() != FileWatcher::Backend::NATIVE )
+		cout << "note: the native backend isn't available on this platform, both rows measure polling" << endl;
+
+	cout << setw( 10 ) << left << "backend" << setw( 10 ) << right << "files" << setw( 12 ) << "setup ms" << setw( 12 ) << "idle CPU %";
+	cout << setw( 16 ) << "mean latency ms" << setw( 16 ) << "max latency ms" << endl;
+	for( int numFiles : FILE_COUNTS ) {
+		fs::remove_all( dir );
+		auto files = createFiles( dir, numFiles );
+
+		for( const auto &backend : backends ) {
+			Result result = measure( backend.second, files );
+			cout << setw( 10 ) << left << backend.first << right << setw( 10 ) << numFiles << fixed << setprecision( 1 ) << setw( 12 ) << result.mSetupMs;
+			cout << setw( 12 ) << result.mIdleCpuPercent << setw( 16 ) << result.mMeanLatencyMs << setw( 16 ) << result.mMaxLatencyMs << endl;
+		}
+	}
+
+	fs::remove_all( dir );
+	return 0;
+}
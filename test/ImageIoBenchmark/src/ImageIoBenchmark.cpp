@@ -0,0 +1,133 @@
+// Times ImageSource row conversion from every source DataType and ChannelOrder into every target DataType and ChannelOrder,
+// which is the work done when loading or writing an image whose layout differs from the Surface's. Results are in megapixels
+// per second, one table per pair of data types, with source channel orders as rows and target channel orders as columns.
+
+#include "cinder/ImageIo.h"
+#include "cinder/Rand.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace ci;
+
+const int NUM_ITERATIONS = 3;
+const int32_t WIDTH = 1024, HEIGHT = 1024;
+
+const ImageIo::ChannelOrder sChannelOrders[] = { ImageIo::RGBA, ImageIo::BGRA, ImageIo::ARGB, ImageIo::ABGR, ImageIo::RGBX, ImageIo::BGRX,
+												 ImageIo::XRGB, ImageIo::XBGR, ImageIo::RGB, ImageIo::BGR, ImageIo::Y, ImageIo::YA };
+const char *sChannelOrderNames[] = { "RGBA", "BGRA", "ARGB", "ABGR", "RGBX", "BGRX", "XRGB", "XBGR", "RGB", "BGR", "Y", "YA" };
+
+const ImageIo::DataType sDataTypes[] = { ImageIo::UINT8, ImageIo::UINT16, ImageIo::FLOAT16, ImageIo::FLOAT32 };
+const char *sDataTypeNames[] = { "8u", "16u", "16f", "32f" };
+
+ImageIo::ColorModel colorModel( ImageIo::ChannelOrder channelOrder )
+{
+	return ( channelOrder == ImageIo::Y || channelOrder == ImageIo::YA ) ? ImageIo::CM_GRAY : ImageIo::CM_RGB;
+}
+
+size_t rowBytes( ImageIo::DataType dataType, ImageIo::ChannelOrder channelOrder )
+{
+	return WIDTH * ImageIo::dataTypeBytes( dataType ) * ImageIo::channelOrderNumChannels( channelOrder );
+}
+
+// Converts rows of noise held in memory, so that only the row conversion is timed
+class MemoryImageSource : public ImageSource {
+  public:
+	MemoryImageSource( ImageIo::DataType dataType, ImageIo::ChannelOrder channelOrder )
+		: mData( rowBytes( dataType, channelOrder ) * HEIGHT )
+	{
+		setSize( WIDTH, HEIGHT );
+		setDataType( dataType );
+		setChannelOrder( channelOrder );
+		setColorModel( colorModel( channelOrder ) );
+
+		// keep the values within [0,1] when interpreted as 16 bit halfs or 32 bit floats
+		if( dataType == FLOAT32 ) {
+			for( size_t i = 0; i < mData.size() / 4; i++ )
+				reinterpret_cast<float*>( mData.data() )[i] = randFloat();
+		}
+		else if( dataType == FLOAT16 ) {
+			for( size_t i = 0; i < mData.size() / 2; i++ )
+				reinterpret_cast<half_float*>( mData.data() )[i] = floatToHalf( randFloat() );
+		}
+		else {
+			for( auto &v : mData )
+				v = uint8_t( randInt( 256 ) );
+		}
+	}
+
+	void load( ImageTargetRef target ) override
+	{
+		RowFunc func = setupRowFunc( target );
+		const size_t bytes = rowBytes( mDataType, mChannelOrder );
+		for( int32_t row = 0; row < mHeight; row++ )
+			( this->*func )( target, row, mData.data() + row * bytes );
+	}
+
+  private:
+	vector<uint8_t>	mData;
+};
+
+class MemoryImageTarget : public ImageTarget {
+  public:
+	MemoryImageTarget( ImageIo::DataType dataType, ImageIo::ChannelOrder channelOrder )
+		: mRowBytes( rowBytes( dataType, channelOrder ) ), mData( mRowBytes * HEIGHT )
+	{
+		setSize( WIDTH, HEIGHT );
+		setDataType( dataType );
+		setChannelOrder( channelOrder );
+		setColorModel( colorModel( channelOrder ) );
+	}
+
+	void*	getRowPointer( int32_t row ) override	{ return mData.data() + row * mRowBytes; }
+
+  private:
+	size_t			mRowBytes;
+	vector<uint8_t>	mData;
+};
+
+// Returns the conversion rate in megapixels per second, after one warm up call.
+double measure( const ImageSourceRef &source, const ImageTargetRef &target )
+{
+	source->load( target );
+
+	auto start = chrono::high_resolution_clock::now();
+	for( int i = 0; i < NUM_ITERATIONS; i++ )
+		source->load( target );
+	auto end = chrono::high_resolution_clock::now();
+
+	double seconds = chrono::duration<double>( end - start ).count() / NUM_ITERATIONS;
+	return WIDTH * HEIGHT / seconds / 1.0e6;
+}
+
+int main( int argc, char *argv[] )
+{
+	cout << "megapixels per second converting " << WIDTH << "x" << HEIGHT << " images" << endl << endl;
+
+	for( size_t sd = 0; sd < size( sDataTypes ); sd++ ) {
+		for( size_t td = 0; td < size( sDataTypes ); td++ ) {
+			cout << sDataTypeNames[sd] << " -> " << sDataTypeNames[td] << endl << setw( 6 ) << "";
+			for( auto name : sChannelOrderNames )
+				cout << setw( 8 ) << name;
+			cout << endl;
+
+			for( size_t so = 0; so < size( sChannelOrders ); so++ ) {
+				auto source = make_shared<MemoryImageSource>( sDataTypes[sd], sChannelOrders[so] );
+				cout << setw( 6 ) << sChannelOrderNames[so];
+				for( auto targetOrder : sChannelOrders ) {
+					auto target = make_shared<MemoryImageTarget>( sDataTypes[td], targetOrder );
+					cout << setw( 8 ) << fixed << setprecision( 0 ) << measure( source, target ) << flush;
+				}
+				cout << endl;
+			}
+			cout << endl;
+		}
+	}
+
+	return 0;
+}
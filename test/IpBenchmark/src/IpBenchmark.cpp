@@ -0,0 +1,113 @@
+// Times each ip:: routine at 1080p, 4K and 8K, first on the calling thread only and then with the default ExecutionPolicy,
+// which uses every hardware thread.
+
+#include "cinder/ip/Blend.h"
+#include "cinder/ip/Blur.h"
+#include "cinder/ip/Checkerboard.h"
+#include "cinder/ip/EdgeDetect.h"
+#include "cinder/ip/Execution.h"
+#include "cinder/ip/Fill.h"
+#include "cinder/ip/Flip.h"
+#include "cinder/ip/Grayscale.h"
+#include "cinder/ip/Hdr.h"
+#include "cinder/ip/Premultiply.h"
+#include "cinder/ip/Resize.h"
+#include "cinder/ip/Threshold.h"
+#include "cinder/Rand.h"
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace ci;
+
+const int NUM_ITERATIONS = 3;
+
+template<typename T>
+SurfaceT<T> makeNoiseSurface( ivec2 size )
+{
+	SurfaceT<T> result( size.x, size.y, true, SurfaceChannelOrder::RGBA );
+	for( int32_t y = 0; y < size.y; y++ ) {
+		T *row = result.getData( ivec2( 0, y ) );
+		for( int32_t x = 0; x < size.x * 4; x++ )
+			row[x] = T( randFloat() * CHANTRAIT<T>::max() );
+	}
+
+	return result;
+}
+
+// Returns the average time in milliseconds of \a fn, after one warm up call.
+double measure( const function<void()> &fn )
+{
+	fn();
+
+	auto start = chrono::high_resolution_clock::now();
+	for( int i = 0; i < NUM_ITERATIONS; i++ )
+		fn();
+	auto end = chrono::high_resolution_clock::now();
+
+	return chrono::duration<double, milli>( end - start ).count() / NUM_ITERATIONS;
+}
+
+void run( const string &sizeName, ivec2 size )
+{
+	Surface8u surface8u = makeNoiseSurface<uint8_t>( size );
+	Surface8u src8u = makeNoiseSurface<uint8_t>( size );
+	Surface8u foreground8u = makeNoiseSurface<uint8_t>( size );
+	Surface32f surface32f = makeNoiseSurface<float>( size );
+	Surface32f foreground32f = makeNoiseSurface<float>( size );
+	Channel8u channel8u( size.x, size.y ), src8uChannel = src8u.getChannelRed().clone();
+	Channel32f channel32f = surface32f.getChannelRed().clone();
+	Surface8u half8u( size.x / 2, size.y / 2, true );
+
+	const vector<pair<string, function<void()>>> routines = {
+		{ "blend 8u", [&] { ip::blend( &surface8u, foreground8u ); } },
+		{ "blend 32f", [&] { ip::blend( &surface32f, foreground32f ); } },
+		{ "stackBlur 8u r=8", [&] { ip::stackBlur( &surface8u, 8 ); } },
+		{ "stackBlur 32f r=8", [&] { ip::stackBlur( &surface32f, 8 ); } },
+		{ "checkerboard 8u", [&] { ip::checkerboard( &surface8u, surface8u.getBounds() ); } },
+		{ "edgeDetectSobel 8u", [&] { ip::edgeDetectSobel( src8u, &surface8u ); } },
+		{ "fill 8u", [&] { ip::fill( &surface8u, ColorA8u( 10, 20, 30, 40 ) ); } },
+		{ "flipVertical 8u", [&] { ip::flipVertical( &surface8u ); } },
+		{ "flipHorizontal 8u", [&] { ip::flipHorizontal( &surface8u ); } },
+		{ "grayscale 8u", [&] { ip::grayscale( src8u, &channel8u ); } },
+		{ "hdrNormalize 32f", [&] { ip::hdrNormalize( &surface32f ); } },
+		{ "getMinMax 32f", [&] { float minVal, maxVal; ip::getMinMax( channel32f, &minVal, &maxVal ); } },
+		{ "premultiply 8u", [&] { ip::premultiply( &surface8u ); } },
+		{ "unpremultiply 8u", [&] { ip::unpremultiply( &surface8u ); } },
+		{ "threshold 8u", [&] { ip::threshold( src8u, (uint8_t)128, &surface8u ); } },
+		{ "adaptiveThreshold 8u", [&] { ip::adaptiveThreshold( src8uChannel, 31, 0.1f, &channel8u ); } },
+		{ "resize 8u 1/2", [&] { ip::resize( src8u, &half8u ); } },
+	};
+
+	cout << sizeName << " (" << size.x << "x" << size.y << ")" << endl;
+	for( const auto &routine : routines ) {
+		double sequentialMs;
+		{
+			ip::ScopedExecutionPolicy scopedPolicy( ip::ExecutionPolicy::sequential() );
+			sequentialMs = measure( routine.second );
+		}
+		double parallelMs = measure( routine.second );
+
+		cout << setw( 24 ) << routine.first << fixed << setprecision( 2 ) << setw( 14 ) << sequentialMs << setw( 14 ) << parallelMs
+			 << setw( 10 ) << sequentialMs / parallelMs << "x" << endl;
+	}
+	cout << endl;
+}
+
+int main( int argc, char *argv[] )
+{
+	cout << "threads: " << ip::getExecutionPolicy().getNumThreads() << endl;
+	cout << "times are in milliseconds" << endl << endl;
+	cout << setw( 24 ) << "routine" << setw( 14 ) << "sequential ms" << setw( 14 ) << "parallel ms" << setw( 11 ) << "speedup" << endl;
+
+	run( "1080p", ivec2( 1920, 1080 ) );
+	run( "4K", ivec2( 3840, 2160 ) );
+	run( "8K", ivec2( 7680, 4320 ) );
+
+	return 0;
+}
@@ -0,0 +1,107 @@
+// Measures KdTree on point clouds of growing size, as used for flocking: the time to build the tree on one thread and on all
+// hardware threads, the time to refit it after every point has moved a little, and the time per query for the 8 nearest
+// neighbors and for all neighbors within a radius, both one query at a time and as a parallel batch. The last column is the
+// time per 8-nearest query found by brute force, measured on fewer queries for the larger clouds.
+
+#include "cinder/KdTree.h"
+#include "cinder/Rand.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+using namespace ci;
+
+const int POINT_COUNTS[] = { 10000, 100000, 1000000 };
+const int NUM_QUERIES = 100000;
+const uint32_t K = 8;
+const float RADIUS = 0.02f; // points lie in a unit cube, so this finds about 33 neighbors at 1M points
+const uint32_t MAX_RADIUS_RESULTS = 64;
+
+template<typename Fn>
+double measureMs( const Fn &fn )
+{
+	auto start = chrono::steady_clock::now();
+	fn();
+	return chrono::duration<double, milli>( chrono::steady_clock::now() - start ).count();
+}
+
+uint32_t bruteForceKNearest( const vector<vec3> &points, const vec3 &p, uint32_t *resultIndices )
+{
+	vector<pair<float, uint32_t>> nearest; // max-heap of the K nearest so far
+	for( uint32_t i = 0; i < points.size(); i++ ) {
+		const float distSqr = glm::distance2( points[i], p );
+		if( nearest.size() < K ) {
+			nearest.push_back( { distSqr, i } );
+			push_heap( nearest.begin(), nearest.end() );
+		}
+		else if( distSqr < nearest.front().first ) {
+			pop_heap( nearest.begin(), nearest.end() );
+			nearest.back() = { distSqr, i };
+			push_heap( nearest.begin(), nearest.end() );
+		}
+	}
+	for( size_t i = 0; i < nearest.size(); i++ )
+		resultIndices[i] = nearest[i].second;
+
+	return (uint32_t)nearest.size();
+}
+
+int main( int argc, char *argv[] )
+{
+	Rand rand( 1 );
+	vector<vec3> queries( NUM_QUERIES );
+	for( auto &q : queries )
+		q = vec3( rand.nextFloat(), rand.nextFloat(), rand.nextFloat() );
+
+	cout << "hardware threads: " << getNumParallelThreads( 0 ) << endl << endl;
+	cout << setw( 9 ) << "points" << setw( 12 ) << "build ms" << setw( 14 ) << "par build ms" << setw( 10 ) << "refit ms";
+	cout << setw( 10 ) << "knn ns" << setw( 14 ) << "batch knn ns" << setw( 13 ) << "radius ns" << setw( 16 ) << "batch radius ns" << setw( 16 ) << "brute knn ns" << endl;
+
+	for( int numPoints : POINT_COUNTS ) {
+		vector<vec3> points( numPoints );
+		for( auto &p : points )
+			p = vec3( rand.nextFloat(), rand.nextFloat(), rand.nextFloat() );
+
+		KdTree<vec3> tree;
+		tree.setMaxThreads( 1 );
+		const double buildMs = measureMs( [&] { tree.initialize( points ); } );
+		tree.setMaxThreads( 0 );
+		const double parallelBuildMs = measureMs( [&] { tree.initialize( points ); } );
+
+		for( auto &p : points )
+			p += vec3( rand.nextFloat( -0.001f, 0.001f ), rand.nextFloat( -0.001f, 0.001f ), rand.nextFloat( -0.001f, 0.001f ) );
+		const double refitMs = measureMs( [&] { tree.refit( points ); } );
+
+		vector<uint32_t> indices( NUM_QUERIES * MAX_RADIUS_RESULTS ), counts( NUM_QUERIES );
+		vector<float> distances( NUM_QUERIES * K );
+		uint64_t numFound = 0;
+		const double knnNs = measureMs( [&] {
+			for( int i = 0; i < NUM_QUERIES; i++ )
+				numFound += tree.findKNearest( queries[i], K, indices.data(), distances.data() );
+		} ) * 1e6 / NUM_QUERIES;
+		const double batchKnnNs = measureMs( [&] { tree.findKNearest( queries, K, indices.data(), distances.data(), counts.data() ); } ) * 1e6 / NUM_QUERIES;
+
+		const double radiusNs = measureMs( [&] {
+			for( int i = 0; i < NUM_QUERIES; i++ )
+				numFound += tree.findWithinRadius( queries[i], RADIUS, indices.data(), nullptr, MAX_RADIUS_RESULTS );
+		} ) * 1e6 / NUM_QUERIES;
+		const double batchRadiusNs = measureMs( [&] { tree.findWithinRadius( queries, RADIUS, indices.data(), nullptr, MAX_RADIUS_RESULTS, counts.data() ); } ) * 1e6 / NUM_QUERIES;
+
+		const int numBruteQueries = std::max( 10, 100000000 / numPoints / 10 );
+		const double bruteNs = measureMs( [&] {
+			for( int i = 0; i < numBruteQueries; i++ )
+				numFound += bruteForceKNearest( points, queries[i], indices.data() );
+		} ) * 1e6 / numBruteQueries;
+
+		cout << fixed << setprecision( 1 ) << setw( 9 ) << numPoints << setw( 12 ) << buildMs << setw( 14 ) << parallelBuildMs << setw( 10 ) << refitMs;
+		cout << setprecision( 0 ) << setw( 10 ) << knnNs << setw( 14 ) << batchKnnNs << setw( 13 ) << radiusNs << setw( 16 ) << batchRadiusNs << setw( 16 ) << bruteNs << endl;
+		if( ! numFound )
+			cout << "error: no points found" << endl;
+	}
+
+	return 0;
+}
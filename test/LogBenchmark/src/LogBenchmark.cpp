@@ -0,0 +1,104 @@
+// Measures the latency of a single CI_LOG_I() call while several threads log to a LoggerFile at the same time, comparing
+// synchronous logging against LogManager::enableAsync() with both overflow policies. Every call is timed individually, the
+// table lists the mean, median and 99th percentile latency per call and the total throughput across all threads. On machines
+// with fewer cores than threads, the mean mostly shows how often the logging threads were preempted.
+
+#include "cinder/Log.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace ci;
+
+const int NUM_CALLS = 20000;	// per thread
+const int THREAD_COUNTS[] = { 1, 2, 4, 8 };
+
+struct Result {
+	double	mMeanNs, mMedianNs, mP99Ns, mCallsPerSecond;
+};
+
+Result measure( int numThreads )
+{
+	vector<vector<double>> latencies( numThreads, vector<double>( NUM_CALLS ) );
+	vector<thread> threads;
+
+	auto start = chrono::steady_clock::now();
+	for( int t = 0; t < numThreads; t++ ) {
+		threads.emplace_back( [t, &latencies] {
+			for( int i = 0; i < NUM_CALLS; i++ ) {
+				auto callStart = chrono::steady_clock::now();
+				CI_LOG_I( "thread " << t << " frame " << i << " position " << i * 0.5f );
+				latencies[t][i] = chrono::duration<double, nano>( chrono::steady_clock::now() - callStart ).count();
+			}
+		} );
+	}
+	for( auto &thread : threads )
+		thread.join();
+	auto end = chrono::steady_clock::now();
+
+	// the time to write anything still queued is part of the total, but not of any call's latency
+	log::manager()->flush();
+	end = std::max( end, chrono::steady_clock::now() );
+
+	vector<double> all;
+	for( const auto &threadLatencies : latencies )
+		all.insert( all.end(), threadLatencies.begin(), threadLatencies.end() );
+	sort( all.begin(), all.end() );
+
+	Result result;
+	result.mMeanNs = 0;
+	for( double latency : all )
+		result.mMeanNs += latency / all.size();
+	result.mMedianNs = all[all.size() / 2];
+	result.mP99Ns = all[all.size() * 99 / 100];
+	result.mCallsPerSecond = all.size() / chrono::duration<double>( end - start ).count();
+	return result;
+}
+
+int main( int argc, char *argv[] )
+{
+	const fs::path dir = fs::temp_directory_path() / "cinder_LogBenchmark";
+	fs::remove_all( dir );
+	log::manager()->resetLogger( make_shared<log::LoggerFile>( dir / "benchmark.log", false ) );
+
+	typedef log::LogManager::AsyncOptions AsyncOptions;
+	struct Mode {
+		string	mName;
+		bool	mAsync;
+		AsyncOptions	mOptions;
+	};
+
+	const Mode modes[] = {
+		{ "sync", false, AsyncOptions() },
+		{ "async block", true, AsyncOptions().overflow( AsyncOptions::Overflow::BLOCK ) },
+		{ "async drop", true, AsyncOptions().overflow( AsyncOptions::Overflow::DROP ) }
+	};
+
+	cout << "logging " << NUM_CALLS << " entries per thread to " << dir << endl << endl;
+	cout << setw( 14 ) << left << "mode" << setw( 10 ) << right << "threads" << setw( 14 ) << "mean ns" << setw( 14 ) << "median ns" << setw( 14 ) << "p99 ns" << setw( 14 ) << "calls/s" << setw( 10 ) << "dropped" << endl;
+	for( const auto &mode : modes ) {
+		for( int numThreads : THREAD_COUNTS ) {
+			if( mode.mAsync )
+				log::manager()->enableAsync( mode.mOptions );
+
+			const uint64_t numDropped = log::manager()->getNumDropped();
+			Result result = measure( numThreads );
+
+			cout << setw( 14 ) << left << mode.mName << right << setw( 10 ) << numThreads << fixed << setprecision( 0 );
+			cout << setw( 14 ) << result.mMeanNs << setw( 14 ) << result.mMedianNs << setw( 14 ) << result.mP99Ns << setw( 14 ) << result.mCallsPerSecond;
+			cout << setw( 10 ) << log::manager()->getNumDropped() - numDropped << endl;
+
+			log::manager()->disableAsync();
+		}
+	}
+
+	log::manager()->clearLoggers();
+	fs::remove_all( dir );
+	return 0;
+}
@@ -0,0 +1,88 @@
+// Measures how long it takes to load a mesh of about two million vertices into a TriMesh from an OBJ file through ObjLoader, from
+// the binary format of TriMesh::write() through TriMesh::read() and from ".cimesh" files written by MeshFile, both uncompressed and
+// with quantized attributes and compressed indices. The "open ms" column is the time until the mesh is available as a geom::Source,
+// which for ".cimesh" files is only the time to map and validate them. Every file is loaded once before it's timed, so the numbers
+// measure parsing and copying rather than the disk.
+
+#include "cinder/MeshFile.h"
+#include "cinder/ObjLoader.h"
+#include "cinder/TriMesh.h"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+
+using namespace std;
+using namespace ci;
+
+const int NUM_RUNS = 3;
+
+struct Result {
+	double	mOpenMs, mLoadMs;
+};
+
+// Returns the fastest of NUM_RUNS runs, after one untimed run that brings the file into the page cache
+Result measure( const function<geom::SourceRef()> &openFn )
+{
+	TriMesh warmup( *openFn() );
+
+	Result result = { numeric_limits<double>::max(), numeric_limits<double>::max() };
+	for( int run = 0; run < NUM_RUNS; run++ ) {
+		auto start = chrono::steady_clock::now();
+		geom::SourceRef source = openFn();
+		auto opened = chrono::steady_clock::now();
+		TriMesh mesh( *source );
+		auto loaded = chrono::steady_clock::now();
+
+		result.mOpenMs = std::min( result.mOpenMs, chrono::duration<double, milli>( opened - start ).count() );
+		result.mLoadMs = std::min( result.mLoadMs, chrono::duration<double, milli>( loaded - start ).count() );
+	}
+
+	return result;
+}
+
+int main( int argc, char *argv[] )
+{
+	const fs::path dir = fs::temp_directory_path() / "cinder_MeshFileBenchmark";
+	fs::remove_all( dir );
+	fs::create_directories( dir );
+
+	TriMesh mesh( geom::Sphere().subdivisions( 2000 ), TriMesh::Format().positions().normals().texCoords() );
+	cout << "writing a mesh with " << mesh.getNumVertices() << " vertices and " << mesh.getNumTriangles() << " triangles to " << dir << endl << endl;
+
+	writeObj( writeFile( dir / "mesh.obj" ), mesh );
+	mesh.write( writeFile( dir / "mesh.trimesh" ) );
+	MeshFile::write( writeFile( dir / "float.cimesh" ), mesh );
+	MeshFile::write( writeFile( dir / "quantized.cimesh" ), mesh, MeshFile::Options().quantizePositions().quantizeNormals().compressIndices() );
+
+	struct Format {
+		string							mName;
+		fs::path						mPath;
+		function<geom::SourceRef()>		mOpenFn;
+	};
+
+	const Format formats[] = {
+		{ "ObjLoader", dir / "mesh.obj", [&dir] { return geom::SourceRef( new ObjLoader( loadFile( dir / "mesh.obj" ) ) ); } },
+		{ "TriMesh::read", dir / "mesh.trimesh", [&dir] {
+			auto result = TriMesh::create();
+			result->read( loadFile( dir / "mesh.trimesh" ) );
+			return geom::SourceRef( result );
+		} },
+		{ "cimesh", dir / "float.cimesh", [&dir] { return geom::SourceRef( MeshFile::create( loadFile( dir / "float.cimesh" ) ) ); } },
+		{ "cimesh quantized", dir / "quantized.cimesh", [&dir] { return geom::SourceRef( MeshFile::create( loadFile( dir / "quantized.cimesh" ) ) ); } }
+	};
+
+	cout << setw( 18 ) << left << "format" << setw( 12 ) << right << "size MB" << setw( 12 ) << "open ms" << setw( 12 ) << "load ms" << endl;
+	for( const auto &format : formats ) {
+		Result result = measure( format.mOpenFn );
+		cout << setw( 18 ) << left << format.mName << right << fixed << setprecision( 1 ) << setw( 12 ) << fs::file_size( format.mPath ) / ( 1024.0 * 1024.0 );
+		cout << setw( 12 ) << result.mOpenMs << setw( 12 ) << result.mLoadMs << endl;
+	}
+
+	fs::remove_all( dir );
+	return 0;
+}
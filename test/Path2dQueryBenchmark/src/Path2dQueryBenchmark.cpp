@@ -0,0 +1,124 @@
+// Compares Shape2d's hit-testing and distance queries against those of a Path2dQueryCache built from the same shape, for shapes
+// with a growing number of cubic segments spread over an outline and several holes. The table lists the time to build the cache,
+// the time per contains() and calcDistance() query at random points around the shape, and the time to compute a 256x256 signed
+// distance field, for Shape2d::calcSignedDistance() on every pixel, for the cache on one thread, on all threads, and on all threads
+// with distances clamped to 8 pixels. The Shape2d distance field is estimated from every 16th row, since it takes minutes otherwise.
+
+#include "cinder/Path2d.h"
+#include "cinder/Shape2d.h"
+#include "cinder/Rand.h"
+#include "cinder/ip/Execution.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+using namespace std;
+using namespace ci;
+
+const int SEGMENT_COUNTS[] = { 100, 1000, 10000 };
+const int NUM_HOLES = 8;
+const int SDF_SIZE = 256;
+const int SDF_BRUTE_FORCE_ROW_STEP = 16;
+
+// A wobbly closed contour of cubics around a circle
+Path2d makeBlob( Rand &rand, const vec2 &center, float radius, int numSegments )
+{
+	Path2d result;
+	auto pointAt = [&]( int i ) {
+		float angle = i * 2 * M_PI / numSegments;
+		return center + vec2( cos( angle ), sin( angle ) ) * radius * ( 1 + 0.05f * sin( angle * 37 ) );
+	};
+	result.moveTo( pointAt( 0 ) );
+	for( int i = 0; i < numSegments; ++i ) {
+		vec2 p0 = pointAt( i ), p3 = pointAt( i + 1 );
+		result.curveTo( mix( p0, p3, 0.33f ) + rand.nextVec2() * radius * 0.02f, mix( p0, p3, 0.66f ) + rand.nextVec2() * radius * 0.02f, p3 );
+	}
+	result.close();
+	return result;
+}
+
+Shape2d makeShape( int numSegments )
+{
+	Rand rand( numSegments );
+	Shape2d result;
+	result.appendContour( makeBlob( rand, vec2( 500 ), 450, numSegments / 2 ) );
+	for( int h = 0; h < NUM_HOLES; ++h ) {
+		float angle = h * 2 * M_PI / NUM_HOLES;
+		result.appendContour( makeBlob( rand, vec2( 500 ) + vec2( cos( angle ), sin( angle ) ) * 250.0f, 80, numSegments / 2 / NUM_HOLES ) );
+	}
+
+	return result;
+}
+
+template<typename Fn>
+double measureNs( size_t count, Fn fn )
+{
+	auto start = chrono::steady_clock::now();
+	fn();
+	return chrono::duration<double, nano>( chrono::steady_clock::now() - start ).count() / count;
+}
+
+int main( int argc, char *argv[] )
+{
+	const Rectf bounds( 0, 0, 1000, 1000 );
+	Rand rand( 1 );
+	vector<vec2> points( 100000 );
+	for( auto &pt : points )
+		pt = vec2( rand.nextFloat( bounds.x1, bounds.x2 ), rand.nextFloat( bounds.y1, bounds.y2 ) );
+
+	cout << setw( 10 ) << "segments" << setw( 10 ) << "build ms" << setw( 14 ) << "contains ns" << setw( 10 ) << "cached" << setw( 14 ) << "distance ns";
+	cout << setw( 10 ) << "cached" << setw( 12 ) << "SDF ms" << setw( 10 ) << "cached" << setw( 10 ) << "threads" << setw( 10 ) << "clamped" << endl;
+
+	volatile float sink = 0;
+	for( int numSegments : SEGMENT_COUNTS ) {
+		Shape2d shape = makeShape( numSegments );
+
+		unique_ptr<Path2dQueryCache> cache;
+		const double buildMs = measureNs( 1, [&] { cache.reset( new Path2dQueryCache( shape ) ); } ) / 1e6;
+
+		// fewer queries for Shape2d, whose cost grows with the number of segments
+		const size_t numBruteForce = 200000 / numSegments;
+		const double containsNs = measureNs( numBruteForce, [&] {
+			for( size_t i = 0; i < numBruteForce; ++i )
+				sink = sink + shape.contains( points[i] );
+		} );
+		const double containsCachedNs = measureNs( points.size(), [&] {
+			for( const auto &pt : points )
+				sink = sink + cache->contains( pt );
+		} );
+		const double distanceNs = measureNs( numBruteForce / 10, [&] {
+			for( size_t i = 0; i < numBruteForce / 10; ++i )
+				sink = sink + shape.calcDistance( points[i] );
+		} );
+		const double distanceCachedNs = measureNs( points.size() / 10, [&] {
+			for( size_t i = 0; i < points.size() / 10; ++i )
+				sink = sink + cache->calcDistance( points[i] );
+		} );
+
+		const vec2 pixelSize = bounds.getSize() / float( SDF_SIZE );
+		const double sdfMs = measureNs( 1, [&] {
+			for( int y = 0; y < SDF_SIZE; y += SDF_BRUTE_FORCE_ROW_STEP ) {
+				for( int x = 0; x < SDF_SIZE; ++x )
+					sink = sink + shape.calcSignedDistance( bounds.getUpperLeft() + ( vec2( x, y ) + vec2( 0.5f ) ) * pixelSize );
+			}
+		} ) * SDF_BRUTE_FORCE_ROW_STEP / 1e6;
+
+		Channel32f field( SDF_SIZE, SDF_SIZE );
+		double sdfCachedMs;
+		{
+			ip::ScopedExecutionPolicy policy( ip::ExecutionPolicy::sequential() );
+			sdfCachedMs = measureNs( 1, [&] { cache->calcSignedDistanceField( &field, bounds ); } ) / 1e6;
+		}
+		const double sdfThreadsMs = measureNs( 1, [&] { cache->calcSignedDistanceField( &field, bounds ); } ) / 1e6;
+		const double sdfClampedMs = measureNs( 1, [&] { cache->calcSignedDistanceField( &field, bounds, pixelSize.x * 8 ); } ) / 1e6;
+
+		cout << fixed << setprecision( 1 ) << setw( 10 ) << numSegments << setw( 10 ) << buildMs << setw( 14 ) << containsNs << setw( 10 ) << containsCachedNs;
+		cout << setw( 14 ) << distanceNs << setw( 10 ) << distanceCachedNs << setw( 12 ) << sdfMs << setw( 10 ) << sdfCachedMs << setw( 10 ) << sdfThreadsMs << setw( 10 ) << sdfClampedMs << endl;
+	}
+
+	cout << endl << "using " << ip::getExecutionPolicy().getNumThreads() << " threads" << endl;
+	return 0;
+}
@@ -0,0 +1,133 @@
+// Compares the ways of turning the strokes of real SVG documents into triangles, restroking every path each frame as an
+// animation would. "calcStroke" is Path2d::calcStroke() followed by a Triangulator, "double" and "auto" append every stroke
+// to one reused StrokeMesh2d in double precision and with the default automatic precision, "batch" strokes each shape into
+// its own StrokeMesh2d with StrokeMesh2d::calcStrokes() on all threads, and "dashed" is the batch with a dash pattern whose
+// offset moves every frame. Strokes use the width, join and cap of each SVG element. Times are per frame, the triangle count
+// is that of the automatic precision mesh. By default the SVGs of the samples are loaded, other files can be passed as arguments.
+
+#include "cinder/Path2d.h"
+#include "cinder/Shape2d.h"
+#include "cinder/Triangulate.h"
+#include "cinder/svg/Svg.h"
+#include "cinder/ip/Execution.h"
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+using namespace ci;
+
+const double MIN_SECONDS = 0.5;
+
+const char *DEFAULT_FILES[] = {
+	"samples/BezierPathIteration/assets/black_type_logo.svg",
+	"samples/_svg/EuroMap/assets/Europe.svg",
+	"samples/_svg/GoodNightMorning/assets/cityscape.svg"
+};
+
+StrokeStyle toStrokeStyle( const svg::Node &node )
+{
+	StrokeStyle result;
+	// the shapes are in document coordinates, so the width is scaled along with them
+	result.setWidth( node.getStrokeWidth() * sqrt( abs( glm::determinant( node.getTransformAbsolute() ) ) ) );
+	result.setJoin( node.getLineJoin() == svg::LINE_JOIN_ROUND ? Join::Round : node.getLineJoin() == svg::LINE_JOIN_BEVEL ? Join::Bevel : Join::Miter );
+	result.setCaps( node.getLineCap() == svg::LINE_CAP_ROUND ? Cap::Round : node.getLineCap() == svg::LINE_CAP_SQUARE ? Cap::Square : Cap::Butt );
+	return result;
+}
+
+void collectShapes( const svg::Group &group, vector<Shape2d> *shapes, vector<StrokeStyle> *styles )
+{
+	for( const svg::Node *child : group.getChildren() ) {
+		if( ! child->isVisible() )
+			continue;
+		if( auto childGroup = dynamic_cast<const svg::Group*>( child ) )
+			collectShapes( *childGroup, shapes, styles );
+		else if( ! dynamic_cast<const svg::Text*>( child ) ) {
+			Shape2d shape = child->getShapeAbsolute();
+			if( shape.getNumContours() > 0 ) {
+				shapes->push_back( shape );
+				styles->push_back( toStrokeStyle( *child ) );
+			}
+		}
+	}
+}
+
+// Returns the mean time of a frame in milliseconds
+double measure( const function<void( int frame )> &fn )
+{
+	int frames = 0;
+	auto start = chrono::steady_clock::now();
+	double seconds = 0;
+	while( seconds < MIN_SECONDS ) {
+		fn( frames++ );
+		seconds = chrono::duration<double>( chrono::steady_clock::now() - start ).count();
+	}
+	return seconds * 1000 / frames;
+}
+
+int main( int argc, char *argv[] )
+{
+	vector<fs::path> files;
+	for( int i = 1; i < argc; ++i )
+		files.push_back( argv[i] );
+	if( files.empty() ) {
+		const fs::path cinderPath = fs::path( __FILE__ ).parent_path() / ".." / ".." / "..";
+		for( const char *file : DEFAULT_FILES )
+			files.push_back( cinderPath / file );
+	}
+
+	cout << "batches run on " << ip::getExecutionPolicy().getNumThreads() << " threads" << endl << endl;
+	cout << setw( 22 ) << left << "file" << right << setw( 8 ) << "shapes" << setw( 10 ) << "segments" << setw( 11 ) << "triangles";
+	cout << setw( 14 ) << "calcStroke ms" << setw( 11 ) << "double ms" << setw( 9 ) << "auto ms" << setw( 10 ) << "batch ms" << setw( 11 ) << "dashed ms" << endl;
+	for( const auto &file : files ) {
+		vector<Shape2d> shapes;
+		vector<StrokeStyle> styles;
+		collectShapes( *svg::Doc::create( file ), &shapes, &styles );
+
+		size_t numSegments = 0;
+		for( const auto &shape : shapes ) {
+			for( const auto &contour : shape.getContours() )
+				numSegments += contour.getNumSegments();
+		}
+
+		double triangulatorMs = measure( [&]( int frame ) {
+			for( size_t i = 0; i < shapes.size(); ++i )
+				TriMesh mesh = Triangulator( shapes[i].calcStroke( styles[i] ) ).calcMesh( Triangulator::WINDING_NONZERO );
+		} );
+
+		StrokeMesh2d mesh;
+		mesh.setPrecision( StrokeMesh2d::Precision::DOUBLE );
+		double doubleMs = measure( [&]( int frame ) {
+			mesh.clear();
+			for( size_t i = 0; i < shapes.size(); ++i )
+				mesh.appendStroke( shapes[i], styles[i] );
+		} );
+
+		mesh.setPrecision( StrokeMesh2d::Precision::AUTO );
+		double autoMs = measure( [&]( int frame ) {
+			mesh.clear();
+			for( size_t i = 0; i < shapes.size(); ++i )
+				mesh.appendStroke( shapes[i], styles[i] );
+		} );
+
+		vector<StrokeMesh2d> meshes( shapes.size() );
+		double batchMs = measure( [&]( int frame ) {
+			StrokeMesh2d::calcStrokes( shapes.data(), styles.data(), shapes.size(), meshes.data() );
+		} );
+
+		vector<StrokeStyle> dashedStyles = styles;
+		double dashedMs = measure( [&]( int frame ) {
+			for( auto &style : dashedStyles )
+				style.setDashes( frame * 0.5f, { 6, 3 } );
+			StrokeMesh2d::calcStrokes( shapes.data(), dashedStyles.data(), shapes.size(), meshes.data() );
+		} );
+
+		cout << setw( 22 ) << left << file.filename().string() << right << setw( 8 ) << shapes.size() << setw( 10 ) << numSegments << setw( 11 ) << mesh.getNumTriangles();
+		cout << fixed << setprecision( 2 ) << setw( 14 ) << triangulatorMs << setw( 11 ) << doubleMs << setw( 9 ) << autoMs << setw( 10 ) << batchMs << setw( 11 ) << dashedMs << endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "cinder/Surface.h"
+#include "cinder/Filter.h"
+#include "cinder/Area.h"
+
+namespace legacy {
+
+//! The previous implementation of ci::ip::resize(), instantiated for uint8_t and float Surfaces.
+template<typename T>
+void resize( const ci::SurfaceT<T> &srcSurface, const ci::Area &srcArea, ci::SurfaceT<T> *dstSurface, const ci::Area &dstArea, const ci::FilterBase &filter );
+
+} // namespace legacy
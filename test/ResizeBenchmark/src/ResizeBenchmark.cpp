@@ -0,0 +1,104 @@
+// Compares ip::resize() against the previous single threaded, scalar implementation (see LegacyResize.cpp) for every
+// FilterBase kernel, on 8 bit and float RGBA Surfaces.
+
+#include "LegacyResize.h"
+
+#include "cinder/ip/Resize.h"
+#include "cinder/Rand.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace ci;
+
+const int NUM_ITERATIONS = 3;
+
+template<typename T>
+SurfaceT<T> makeNoiseSurface( ivec2 size )
+{
+	SurfaceT<T> result( size.x, size.y, true, SurfaceChannelOrder::RGBA );
+	for( int32_t y = 0; y < size.y; y++ ) {
+		T *row = result.getData( ivec2( 0, y ) );
+		for( int32_t x = 0; x < size.x * 4; x++ )
+			row[x] = T( randFloat() * CHANTRAIT<T>::max() );
+	}
+
+	return result;
+}
+
+// Returns the average time in milliseconds of \a fn, after one warm up call.
+template<typename FnT>
+double measure( const FnT &fn )
+{
+	fn();
+
+	auto start = chrono::high_resolution_clock::now();
+	for( int i = 0; i < NUM_ITERATIONS; i++ )
+		fn();
+	auto end = chrono::high_resolution_clock::now();
+
+	return chrono::duration<double, milli>( end - start ).count() / NUM_ITERATIONS;
+}
+
+template<typename T>
+double maxDifference( const SurfaceT<T> &a, const SurfaceT<T> &b )
+{
+	double result = 0;
+	for( int32_t y = 0; y < a.getHeight(); y++ ) {
+		for( int32_t x = 0; x < a.getWidth() * 4; x++ )
+			result = std::max( result, std::abs( double( a.getData( ivec2( 0, y ) )[x] ) - double( b.getData( ivec2( 0, y ) )[x] ) ) );
+	}
+
+	return result;
+}
+
+template<typename T>
+void run( const string &typeName, const vector<pair<string, shared_ptr<FilterBase>>> &filters, ivec2 srcSize, ivec2 dstSize )
+{
+	auto src = makeNoiseSurface<T>( srcSize );
+	SurfaceT<T> legacyResult( dstSize.x, dstSize.y, true, SurfaceChannelOrder::RGBA );
+	SurfaceT<T> result( dstSize.x, dstSize.y, true, SurfaceChannelOrder::RGBA );
+
+	cout << typeName << " " << srcSize.x << "x" << srcSize.y << " -> " << dstSize.x << "x" << dstSize.y << endl;
+	for( const auto &filter : filters ) {
+		double legacyMs = measure( [&] { legacy::resize( src, src.getBounds(), &legacyResult, legacyResult.getBounds(), *filter.second ); } );
+		double ms = measure( [&] { ip::resize( src, src.getBounds(), &result, result.getBounds(), *filter.second ); } );
+
+		cout << setw( 16 ) << filter.first << fixed << setprecision( 2 ) << setw( 12 ) << legacyMs << setw( 12 ) << ms
+			 << setw( 10 ) << legacyMs / ms << "x" << setw( 12 ) << setprecision( 4 ) << maxDifference( legacyResult, result ) << endl;
+	}
+	cout << endl;
+}
+
+int main( int argc, char *argv[] )
+{
+	vector<pair<string, shared_ptr<FilterBase>>> filters = {
+		{ "Box", make_shared<FilterBox>() },
+		{ "Triangle", make_shared<FilterTriangle>() },
+		{ "Quadratic", make_shared<FilterQuadratic>() },
+		{ "Cubic", make_shared<FilterCubic>() },
+		{ "CatmullRom", make_shared<FilterCatmullRom>() },
+		{ "Mitchell", make_shared<FilterMitchell>() },
+		{ "SincBlackman", make_shared<FilterSincBlackman>() },
+		{ "Gaussian", make_shared<FilterGaussian>() },
+#if ! defined( CINDER_COCOA_TOUCH )
+		{ "BesselBlackman", make_shared<FilterBesselBlackman>() },
+#endif
+	};
+
+	cout << "hardware threads: " << thread::hardware_concurrency() << endl;
+	cout << "times are in milliseconds, max diff is the largest difference of any channel from the legacy result" << endl << endl;
+	cout << setw( 16 ) << "filter" << setw( 12 ) << "legacy ms" << setw( 12 ) << "new ms" << setw( 11 ) << "speedup" << setw( 12 ) << "max diff" << endl;
+
+	run<uint8_t>( "8 bit", filters, ivec2( 4000, 3000 ), ivec2( 1000, 750 ) );
+	run<uint8_t>( "8 bit", filters, ivec2( 1920, 1080 ), ivec2( 3840, 2160 ) );
+	run<float>( "float", filters, ivec2( 4000, 3000 ), ivec2( 1000, 750 ) );
+	run<float>( "float", filters, ivec2( 1920, 1080 ), ivec2( 1280, 720 ) );
+
+	return 0;
+}
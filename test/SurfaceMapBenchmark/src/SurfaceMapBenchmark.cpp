@@ -0,0 +1,120 @@
+// Times scrubbing through a sequence of uncompressed 1080p RGBA frames, comparing mapSurface() against loading each frame
+// through loadImage(). Every method copies all of a frame's pixels into a staging buffer, as uploading it to a texture would,
+// except "map only", which shows the cost of opening a frame whose pixels aren't touched. The frames are read once before timing, so they are
+// in the OS file cache and the numbers reflect copying and decoding rather than disk speed.
+
+#include "cinder/ImageFileRaw.h"
+#include "cinder/ImageSourceFileQoi.h"
+#include "cinder/ImageTargetFileQoi.h"
+#include "cinder/Rand.h"
+
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace ci;
+
+const int NUM_FRAMES = 24;
+const int NUM_PASSES = 3;
+const int32_t WIDTH = 1920, HEIGHT = 1080;
+
+// Copies every row into a staging buffer, as a texture upload would, so that each pixel is read
+uint64_t upload( const Surface8u &surface )
+{
+	static vector<uint8_t> sStaging( WIDTH * HEIGHT * 4 );
+	const size_t rowLength = surface.getWidth() * surface.getPixelInc();
+	for( int32_t y = 0; y < surface.getHeight(); y++ )
+		memcpy( sStaging.data() + y * rowLength, surface.getData( ivec2( 0, y ) ), rowLength );
+
+	return sStaging[sStaging.size() / 2];
+}
+
+// A gradient with some noise, so that QOI compresses it about as well as footage
+Surface8u makeFrame( int frame )
+{
+	Surface8u result( WIDTH, HEIGHT, true, SurfaceChannelOrder::RGBA );
+	Rand rand( frame );
+	for( int32_t y = 0; y < HEIGHT; y++ ) {
+		uint8_t *row = result.getData( ivec2( 0, y ) );
+		for( int32_t x = 0; x < WIDTH; x++, row += 4 ) {
+			row[0] = uint8_t( x + frame + rand.nextInt( 4 ) );
+			row[1] = uint8_t( y + rand.nextInt( 4 ) );
+			row[2] = uint8_t( x + y );
+			row[3] = 255;
+		}
+	}
+
+	return result;
+}
+
+// Returns frames per second of reading every frame with \a load, after one pass to warm up the file cache
+double measure( const vector<fs::path> &paths, const function<uint64_t( const fs::path & )> &load )
+{
+	uint64_t sum = 0;
+	for( const auto &path : paths )
+		sum += load( path );
+
+	auto start = chrono::high_resolution_clock::now();
+	for( int pass = 0; pass < NUM_PASSES; pass++ ) {
+		for( const auto &path : paths )
+			sum += load( path );
+	}
+	auto end = chrono::high_resolution_clock::now();
+
+	// keeps the uploads alive
+	if( sum == 42 )
+		cout << " ";
+
+	return paths.size() * NUM_PASSES / chrono::duration<double>( end - start ).count();
+}
+
+int main( int argc, char *argv[] )
+{
+	ImageSourceFileQoi::registerSelf();
+	ImageTargetFileQoi::registerSelf();
+	ImageSourceFileRaw::registerSelf();
+	ImageTargetFileRaw::registerSelf();
+
+	const fs::path dir = fs::temp_directory_path() / "cinder_SurfaceMapBenchmark";
+	fs::create_directories( dir );
+
+	cout << "writing " << NUM_FRAMES << " frames of " << WIDTH << "x" << HEIGHT << " RGBA to " << dir << endl;
+	vector<fs::path> rawPaths, qoiPaths;
+	for( int frame = 0; frame < NUM_FRAMES; frame++ ) {
+		auto surface = makeFrame( frame );
+		rawPaths.push_back( dir / ( "frame" + to_string( frame ) + ".ciraw" ) );
+		qoiPaths.push_back( dir / ( "frame" + to_string( frame ) + ".qoi" ) );
+		writeImage( rawPaths.back(), surface );
+		writeImage( qoiPaths.back(), surface );
+	}
+
+	struct Method {
+		string								mName;
+		const vector<fs::path>				*mPaths;
+		function<uint64_t( const fs::path & )>	mLoad;
+	};
+
+	const Method methods[] = {
+		{ "loadImage() qoi", &qoiPaths, []( const fs::path &path ) { return upload( Surface8u( loadImage( path ) ) ); } },
+		{ "loadImage() stream read", &rawPaths, []( const fs::path &path ) { return upload( Surface8u( loadImage( DataSourceBuffer::create( loadFile( path )->getBuffer() ), ImageSource::Options(), "ciraw" ) ) ); } },
+		{ "loadImage() ciraw", &rawPaths, []( const fs::path &path ) { return upload( Surface8u( loadImage( path ) ) ); } },
+		{ "mapSurface()", &rawPaths, []( const fs::path &path ) { return upload( *mapSurface<uint8_t>( path ) ); } },
+		{ "mapSurface() copy-on-write", &rawPaths, []( const fs::path &path ) { return upload( *mapSurface<uint8_t>( path, true ) ); } },
+		{ "mapSurface() map only", &rawPaths, []( const fs::path &path ) { return uint64_t( mapSurface<uint8_t>( path )->getWidth() ); } }
+	};
+
+	const double frameBytes = WIDTH * HEIGHT * 4.0;
+	cout << endl << setw( 28 ) << left << "method" << setw( 12 ) << right << "frames/s" << setw( 12 ) << "GB/s" << endl;
+	for( const auto &method : methods ) {
+		double fps = measure( *method.mPaths, method.mLoad );
+		cout << setw( 28 ) << left << method.mName << right << fixed << setprecision( 1 ) << setw( 12 ) << fps << setw( 12 ) << setprecision( 2 ) << fps * frameBytes / 1.0e9 << endl;
+	}
+
+	fs::remove_all( dir );
+	return 0;
+}
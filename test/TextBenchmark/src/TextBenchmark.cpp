@@ -0,0 +1,145 @@
+// Measures how many labels per second the FreeType text renderer produces with the GlyphCache disabled and enabled. "labels"
+// renders short strings that change every frame with renderString(), as a score or a timer would, "paragraphs" lays out and
+// renders wrapped TextBoxes in every alignment and "layouts" renders multi-line TextLayouts. The cache is cleared before each
+// enabled run, so its numbers include warming it up. The size of the cache afterwards is listed in the last columns. The
+// GlyphCache is part of the FreeType renderer, which is only used on Linux.
+// The second table renders batches of 200 subtitle-length strings with the cache enabled: "serial" calls renderString() for
+// each, "batch 1" and "batch" call renderStrings() on one thread and on all threads, and "atlas" packs the batch into a 1024
+// pixel wide Surface with renderStringAtlas() on all threads.
+
+#include "cinder/Text.h"
+#include "cinder/Font.h"
+#include "cinder/ip/Execution.h"
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace ci;
+
+const double MIN_SECONDS = 0.5;
+
+const char *PARAGRAPH = "The quick brown fox jumps over the lazy dog. Pack my box with five dozen liquor jugs! How vexingly quick daft zebras jump.";
+
+// Returns the number of labels rendered per second
+double measure( const function<int( int )> &fn )
+{
+	int labels = 0, frame = 0;
+	auto start = chrono::steady_clock::now();
+	double seconds = 0;
+	while( seconds < MIN_SECONDS ) {
+		labels += fn( frame++ );
+		seconds = chrono::duration<double>( chrono::steady_clock::now() - start ).count();
+	}
+	return labels / seconds;
+}
+
+int main( int argc, char *argv[] )
+{
+#if defined( CINDER_LINUX )
+	const vector<function<int( const Font &, int )>> tests = {
+		// labels
+		[]( const Font &font, int frame ) {
+			for( int i = 0; i < 20; ++i )
+				renderString( "Score: " + to_string( frame * 20 + i ) + "  Time: " + to_string( ( frame + i ) % 600 ), font, ColorA( 1, 1, 1, 1 ) );
+			return 20;
+		},
+		// paragraphs
+		[]( const Font &font, int frame ) {
+			for( auto align : { TextBox::LEFT, TextBox::CENTER, TextBox::RIGHT } ) {
+				TextBox box;
+				box.font( font ).text( PARAGRAPH ).size( 200 + frame % 3 * 40, TextBox::GROW ).alignment( align );
+				box.render();
+			}
+			return 3;
+		},
+		// layouts
+		[]( const Font &font, int frame ) {
+			TextLayout layout;
+			layout.setFont( font );
+			layout.setColor( Color( 1, 0.5f, 0 ) );
+			layout.addLine( "Frame " + to_string( frame ) );
+			layout.addCenteredLine( "centered line" );
+			layout.append( " continued" );
+			layout.addRightLine( "right aligned" );
+			layout.render( true );
+			return 1;
+		}
+	};
+	const char *names[] = { "labels", "paragraphs", "layouts" };
+
+	GlyphCache *cache = GlyphCache::get();
+	cout << setw( 20 ) << left << "font" << setw( 12 ) << "test" << right << setw( 12 ) << "uncached/s" << setw( 12 ) << "cached/s" << setw( 9 ) << "speedup";
+	cout << setw( 8 ) << "glyphs" << setw( 6 ) << "runs" << setw( 10 ) << "cache KB" << endl;
+	for( const char *fontName : { "DejaVu Sans", "DejaVu Sans Mono" } ) {
+		for( float size : { 12.0f, 24.0f, 48.0f } ) {
+			Font font( fontName, size );
+			for( size_t t = 0; t < tests.size(); ++t ) {
+				auto fn = [&]( int frame ) { return tests[t]( font, frame ); };
+
+				cache->setEnabled( false );
+				double uncached = measure( fn );
+				cache->setEnabled( true );
+				cache->clear();
+				double cached = measure( fn );
+
+				const string label = string( fontName ) + " " + to_string( (int)size );
+				cout << setw( 20 ) << left << label << setw( 12 ) << names[t] << right << fixed << setprecision( 0 ) << setw( 12 ) << uncached << setw( 12 ) << cached;
+				cout << setprecision( 2 ) << setw( 8 ) << cached / uncached << "x";
+				cout << setw( 8 ) << cache->getNumGlyphs() << setw( 6 ) << cache->getNumRuns() << setw( 10 ) << cache->getMemoryUsage() / 1024 << endl;
+			}
+		}
+	}
+
+	vector<string> strs;
+	for( int i = 0; i < 200; ++i )
+		strs.push_back( "Subtitle " + to_string( i ) + ": " + string( PARAGRAPH ).substr( i % 40, 30 + i % 50 ) );
+	vector<Surface> surfaces( strs.size() );
+	vector<Area> areas( strs.size() );
+
+	cout << endl << "batches run on " << ip::getExecutionPolicy().getNumThreads() << " threads" << endl << endl;
+	cout << setw( 20 ) << left << "font" << right << setw( 12 ) << "serial/s" << setw( 12 ) << "batch 1/s" << setw( 12 ) << "batch/s" << setw( 12 ) << "atlas/s" << endl;
+	for( const char *fontName : { "DejaVu Sans", "DejaVu Sans Mono" } ) {
+		for( float size : { 12.0f, 24.0f, 48.0f } ) {
+			Font font( fontName, size );
+			cache->clear();
+			const int count = (int)strs.size();
+			double serial = measure( [&]( int ) {
+				for( size_t i = 0; i < strs.size(); ++i )
+					surfaces[i] = renderString( strs[i], font, ColorA( 1, 1, 1, 1 ) );
+				return count;
+			} );
+
+			double batchSingle;
+			{
+				ip::ScopedExecutionPolicy policy( ip::ExecutionPolicy().maxThreads( 1 ) );
+				batchSingle = measure( [&]( int ) {
+					renderStrings( strs.data(), strs.size(), font, ColorA( 1, 1, 1, 1 ), surfaces.data() );
+					return count;
+				} );
+			}
+
+			double batch = measure( [&]( int ) {
+				renderStrings( strs.data(), strs.size(), font, ColorA( 1, 1, 1, 1 ), surfaces.data() );
+				return count;
+			} );
+
+			double atlas = measure( [&]( int ) {
+				renderStringAtlas( strs.data(), strs.size(), font, ColorA( 1, 1, 1, 1 ), 1024, areas.data() );
+				return count;
+			} );
+
+			const string label = string( fontName ) + " " + to_string( (int)size );
+			cout << setw( 20 ) << left << label << right << fixed << setprecision( 0 ) << setw( 12 ) << serial << setw( 12 ) << batchSingle << setw( 12 ) << batch << setw( 12 ) << atlas << endl;
+		}
+	}
+#else
+	cout << "the GlyphCache and parallel rendering are only used on Linux" << endl;
+#endif
+
+	return 0;
+}
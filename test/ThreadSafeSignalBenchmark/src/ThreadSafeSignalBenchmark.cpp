@@ -0,0 +1,108 @@
+// Compares the cost of emitting a Signal and a ThreadSafeSignal with 1, 100 and 10000 connected slots, as well as the time taken
+// to connect all of the slots. The last column of the table lists the time per emission when several threads emit the
+// ThreadSafeSignal at once while another thread keeps connecting and disconnecting slots, which Signal doesn't support. On
+// machines with fewer cores than threads, that column mostly shows how often the emitting threads were preempted.
+
+#include "cinder/Cinder.h"
+#include "cinder/Signals.h"
+
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace ci::signals;
+
+const int SLOT_COUNTS[] = { 1, 100, 10000 };
+const int NUM_SLOT_CALLS = 20000000; // per measurement, spread over as many emissions as needed
+const int NUM_EMIT_THREADS = 4;
+
+static thread_local uint64_t sCounter = 0;
+static void addToCounter( uint64_t value )	{ sCounter += value; }
+void (*sAddToCounter)( uint64_t ) = addToCounter; // external symbol to prevent easy inlining
+
+struct Result {
+	double	mConnectMs, mEmitNs;
+};
+
+template<typename SignalT>
+Result measure( int numSlots )
+{
+	Result result;
+	SignalT sig;
+
+	auto connectStart = chrono::steady_clock::now();
+	for( int i = 0; i < numSlots; i++ )
+		sig.connect( sAddToCounter );
+	result.mConnectMs = chrono::duration<double, milli>( chrono::steady_clock::now() - connectStart ).count();
+
+	const int numEmits = NUM_SLOT_CALLS / numSlots;
+	const uint64_t startCounter = sCounter;
+	auto emitStart = chrono::steady_clock::now();
+	for( int i = 0; i < numEmits; i++ )
+		sig.emit( 1 );
+	result.mEmitNs = chrono::duration<double, nano>( chrono::steady_clock::now() - emitStart ).count() / numEmits;
+
+	if( sCounter - startCounter != uint64_t( numEmits ) * numSlots )
+		cout << "error: unexpected number of slot calls" << endl;
+
+	return result;
+}
+
+double measureConcurrent( int numSlots )
+{
+	ThreadSafeSignal<void ( uint64_t )> sig;
+	for( int i = 0; i < numSlots; i++ )
+		sig.connect( sAddToCounter );
+
+	atomic<bool> done( false );
+	thread connectThread( [&sig, &done] {
+		while( ! done ) {
+			auto conn = sig.connect( []( uint64_t ) {} );
+			this_thread::sleep_for( chrono::microseconds( 100 ) );
+			conn.disconnect();
+		}
+	} );
+
+	const int numEmits = NUM_SLOT_CALLS / numSlots / NUM_EMIT_THREADS;
+	atomic<uint64_t> counter( 0 );
+	vector<thread> threads;
+	auto start = chrono::steady_clock::now();
+	for( int t = 0; t < NUM_EMIT_THREADS; t++ ) {
+		threads.emplace_back( [&sig, &counter, numEmits] {
+			for( int i = 0; i < numEmits; i++ )
+				sig.emit( 1 );
+			counter += sCounter;
+		} );
+	}
+	for( auto &thread : threads )
+		thread.join();
+	const double result = chrono::duration<double, nano>( chrono::steady_clock::now() - start ).count() / ( numEmits * NUM_EMIT_THREADS );
+
+	done = true;
+	connectThread.join();
+	if( counter != uint64_t( numEmits ) * NUM_EMIT_THREADS * numSlots )
+		cout << "error: unexpected number of slot calls" << endl;
+
+	return result;
+}
+
+int main( int argc, char *argv[] )
+{
+	cout << setw( 8 ) << "slots" << setw( 18 ) << "Signal connect ms" << setw( 16 ) << "Signal emit ns";
+	cout << setw( 14 ) << "TS connect ms" << setw( 12 ) << "TS emit ns" << setw( 10 ) << "speedup" << setw( 22 ) << "TS concurrent emit ns" << endl;
+	for( int numSlots : SLOT_COUNTS ) {
+		Result signal = measure<Signal<void ( uint64_t )>>( numSlots );
+		Result threadSafe = measure<ThreadSafeSignal<void ( uint64_t )>>( numSlots );
+		double concurrent = measureConcurrent( numSlots );
+
+		cout << fixed << setprecision( 2 ) << setw( 8 ) << numSlots << setw( 18 ) << signal.mConnectMs << setw( 16 ) << signal.mEmitNs;
+		cout << setw( 14 ) << threadSafe.mConnectMs << setw( 12 ) << threadSafe.mEmitNs << setw( 9 ) << signal.mEmitNs / threadSafe.mEmitNs << "x";
+		cout << setw( 22 ) << concurrent << endl;
+	}
+
+	return 0;
+}
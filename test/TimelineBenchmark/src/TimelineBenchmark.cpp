@@ -0,0 +1,89 @@
+// Times Timeline::step() with many long-running tweens, split evenly between float, vec2, vec3, Color and quat Anims and a few easing
+// functions, as in a particle-like UI animation. "individual" disables batching, stepping every tween on its own as Timeline always
+// used to, "batched" steps them in batches on the calling thread and "threaded" also uses one thread per hardware thread. The table
+// lists the time taken to apply all tweens, the time taken by the first step, which batches the tweens, and the mean time of the others.
+
+#include "cinder/Color.h"
+#include "cinder/Rand.h"
+#include "cinder/Timeline.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace ci;
+
+const int TWEEN_COUNTS[] = { 1000, 10000, 100000 };
+const int NUM_STEPS = 200;
+
+struct Result {
+	double	mApplyMs, mFirstStepMs, mStepMs;
+};
+
+Result measure( int numTweens, bool batching, size_t numThreads )
+{
+	auto timeline = Timeline::create();
+	timeline->setBatchingEnabled( batching );
+	timeline->setNumStepThreads( numThreads );
+
+	vector<Anim<float>> floats( numTweens / 5, 0.0f );
+	vector<Anim<vec2>> vec2s( numTweens / 5, vec2( 0 ) );
+	vector<Anim<vec3>> vec3s( numTweens / 5, vec3( 0 ) );
+	vector<Anim<Color>> colors( numTweens / 5, Color::black() );
+	vector<Anim<quat>> quats( numTweens / 5, quat( 1, 0, 0, 0 ) );
+	const EaseFn easeFns[] = { easeNone, easeInOutQuad, easeOutCubic, easeInOutSine };
+
+	Rand rand( 1 );
+	auto applyStart = chrono::steady_clock::now();
+	for( int i = 0; i < numTweens / 5; i++ ) {
+		// long enough that no tween completes while stepping
+		const float duration = rand.nextFloat( 10, 20 );
+		const EaseFn &easeFn = easeFns[i % 4];
+		timeline->apply( &floats[i], 1.0f, duration, easeFn );
+		timeline->apply( &vec2s[i], rand.nextVec2(), duration, easeFn );
+		timeline->apply( &vec3s[i], rand.nextVec3(), duration, easeFn );
+		timeline->apply( &colors[i], Color( rand.nextFloat(), rand.nextFloat(), rand.nextFloat() ), duration, easeFn );
+		timeline->apply( &quats[i], glm::angleAxis( rand.nextFloat( 3 ), rand.nextVec3() ), duration, easeFn );
+	}
+	Result result;
+	result.mApplyMs = chrono::duration<double, milli>( chrono::steady_clock::now() - applyStart ).count();
+
+	auto stepStart = chrono::steady_clock::now();
+	timeline->step( 1 / 60.0f );
+	result.mFirstStepMs = chrono::duration<double, milli>( chrono::steady_clock::now() - stepStart ).count();
+
+	stepStart = chrono::steady_clock::now();
+	for( int step = 0; step < NUM_STEPS; step++ )
+		timeline->step( 1 / 60.0f );
+	result.mStepMs = chrono::duration<double, milli>( chrono::steady_clock::now() - stepStart ).count() / NUM_STEPS;
+
+	return result;
+}
+
+int main( int argc, char *argv[] )
+{
+	struct Mode {
+		string	mName;
+		bool	mBatching;
+		size_t	mNumThreads;
+	};
+	const Mode modes[] = { { "individual", false, 1 }, { "batched", true, 1 }, { "threaded", true, 0 } };
+
+	cout << setw( 12 ) << left << "mode" << setw( 10 ) << right << "tweens" << setw( 12 ) << "apply ms" << setw( 16 ) << "first step ms" << setw( 12 ) << "step ms" << setw( 12 ) << "speedup" << endl;
+	for( int numTweens : TWEEN_COUNTS ) {
+		double individualStepMs = 0;
+		for( const auto &mode : modes ) {
+			Result result = measure( numTweens, mode.mBatching, mode.mNumThreads );
+			if( ! mode.mBatching )
+				individualStepMs = result.mStepMs;
+
+			cout << setw( 12 ) << left << mode.mName << right << setw( 10 ) << numTweens << fixed << setprecision( 3 ) << setw( 12 ) << result.mApplyMs << setw( 16 ) << result.mFirstStepMs;
+			cout << setw( 12 ) << result.mStepMs << setprecision( 1 ) << setw( 11 ) << individualStepMs / result.mStepMs << "x" << endl;
+		}
+	}
+
+	return 0;
+}
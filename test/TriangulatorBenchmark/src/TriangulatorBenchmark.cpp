@@ -0,0 +1,119 @@
+// Compares the ways of filling the shapes of real SVG documents with triangles, retriangulating every shape each frame as an
+// animation would. "new" constructs a Triangulator for each shape and returns a new TriMesh from calcMesh(), "reused" adds
+// every shape to one Triangulator and appends its triangles to vectors that are reused from frame to frame, "batch 1" and
+// "batch" triangulate each shape into its own TriMesh with Triangulator::calcMeshes() on one thread and on all threads. All
+// shapes are filled with the nonzero winding rule, which is the default of SVG. Times are per frame. By default the SVGs of
+// the samples are loaded, other files can be passed as arguments.
+
+#include "cinder/Shape2d.h"
+#include "cinder/Triangulate.h"
+#include "cinder/svg/Svg.h"
+#include "cinder/ip/Execution.h"
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+using namespace ci;
+
+const double MIN_SECONDS = 0.5;
+
+const char *DEFAULT_FILES[] = {
+	"samples/BezierPathIteration/assets/black_type_logo.svg",
+	"samples/_svg/EuroMap/assets/Europe.svg",
+	"samples/_svg/GoodNightMorning/assets/cityscape.svg"
+};
+
+void collectShapes( const svg::Group &group, vector<Shape2d> *shapes )
+{
+	for( const svg::Node *child : group.getChildren() ) {
+		if( ! child->isVisible() )
+			continue;
+		if( auto childGroup = dynamic_cast<const svg::Group*>( child ) )
+			collectShapes( *childGroup, shapes );
+		else if( ! dynamic_cast<const svg::Text*>( child ) ) {
+			Shape2d shape = child->getShapeAbsolute();
+			if( shape.getNumContours() > 0 )
+				shapes->push_back( shape );
+		}
+	}
+}
+
+// Returns the mean time of a frame in milliseconds
+double measure( const function<void()> &fn )
+{
+	int frames = 0;
+	auto start = chrono::steady_clock::now();
+	double seconds = 0;
+	while( seconds < MIN_SECONDS ) {
+		fn();
+		++frames;
+		seconds = chrono::duration<double>( chrono::steady_clock::now() - start ).count();
+	}
+	return seconds * 1000 / frames;
+}
+
+int main( int argc, char *argv[] )
+{
+	vector<fs::path> files;
+	for( int i = 1; i < argc; ++i )
+		files.push_back( argv[i] );
+	if( files.empty() ) {
+		const fs::path cinderPath = fs::path( __FILE__ ).parent_path() / ".." / ".." / "..";
+		for( const char *file : DEFAULT_FILES )
+			files.push_back( cinderPath / file );
+	}
+
+	const auto winding = Triangulator::WINDING_NONZERO;
+	cout << "batches run on " << ip::getExecutionPolicy().getNumThreads() << " threads" << endl << endl;
+	cout << setw( 22 ) << left << "file" << right << setw( 8 ) << "shapes" << setw( 10 ) << "segments" << setw( 11 ) << "triangles";
+	cout << setw( 9 ) << "new ms" << setw( 12 ) << "reused ms" << setw( 13 ) << "batch 1 ms" << setw( 10 ) << "batch ms" << endl;
+	for( const auto &file : files ) {
+		vector<Shape2d> shapes;
+		collectShapes( *svg::Doc::create( file ), &shapes );
+
+		size_t numSegments = 0;
+		for( const auto &shape : shapes ) {
+			for( const auto &contour : shape.getContours() )
+				numSegments += contour.getNumSegments();
+		}
+
+		double newMs = measure( [&] {
+			for( const auto &shape : shapes )
+				TriMesh mesh = Triangulator( shape ).calcMesh( winding );
+		} );
+
+		Triangulator triangulator;
+		vector<vec2> positions;
+		vector<uint32_t> indices;
+		double reusedMs = measure( [&] {
+			positions.clear();
+			indices.clear();
+			for( const auto &shape : shapes ) {
+				triangulator.addShape( shape );
+				triangulator.calcMesh( &positions, &indices, winding );
+			}
+		} );
+
+		vector<TriMesh> meshes( shapes.size(), TriMesh( TriMesh::Format().positions( 2 ) ) );
+		double batchSingleMs;
+		{
+			ip::ScopedExecutionPolicy policy( ip::ExecutionPolicy().maxThreads( 1 ) );
+			batchSingleMs = measure( [&] {
+				Triangulator::calcMeshes( shapes.data(), shapes.size(), meshes.data(), winding );
+			} );
+		}
+
+		double batchMs = measure( [&] {
+			Triangulator::calcMeshes( shapes.data(), shapes.size(), meshes.data(), winding );
+		} );
+
+		cout << setw( 22 ) << left << file.filename().string() << right << setw( 8 ) << shapes.size() << setw( 10 ) << numSegments << setw( 11 ) << indices.size() / 3;
+		cout << fixed << setprecision( 2 ) << setw( 9 ) << newMs << setw( 12 ) << reusedMs << setw( 13 ) << batchSingleMs << setw( 10 ) << batchMs << endl;
+	}
+
+	return 0;
+}
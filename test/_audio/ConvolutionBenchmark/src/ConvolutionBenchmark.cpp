@@ -0,0 +1,82 @@
+// Measures the CPU cost of ConvolutionNode for impulse responses of different lengths and processing block sizes,
+// with both non-uniform (default) and uniform partitioning.
+
+#include "cinder/audio/OfflineContext.h"
+#include "cinder/audio/ConvolutionNode.h"
+#include "cinder/audio/GenNode.h"
+#include "cinder/Rand.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+using namespace std;
+using namespace ci;
+using namespace ci::audio;
+
+const size_t SAMPLE_RATE = 48000;
+const size_t NUM_CHANNELS = 2;
+const double SECONDS_RENDERED = 5;
+
+// Returns a decaying noise impulse response, similar in shape to a room's reverb tail.
+audio::BufferRef makeImpulseResponse( double seconds )
+{
+	const size_t numFrames = size_t( seconds * SAMPLE_RATE );
+	auto result = make_shared<audio::Buffer>( numFrames, NUM_CHANNELS );
+	for( size_t ch = 0; ch < NUM_CHANNELS; ch++ ) {
+		float *channel = result->getChannel( ch );
+		for( size_t i = 0; i < numFrames; i++ )
+			channel[i] = randFloat( -1.0f, 1.0f ) * expf( -6.0f * float( i ) / float( numFrames ) ) * 0.01f;
+	}
+
+	return result;
+}
+
+// Returns the processing time in microseconds per block, per channel.
+double measure( const audio::BufferRef &impulseResponse, size_t framesPerBlock, bool uniform )
+{
+	auto ctx = make_shared<OfflineContext>( SAMPLE_RATE, framesPerBlock, NUM_CHANNELS );
+	auto noise = ctx->makeNode<GenNoiseNode>( Node::Format().channels( NUM_CHANNELS ) );
+	auto convolution = ctx->makeNode<ConvolutionNode>( impulseResponse );
+	if( uniform )
+		convolution->setMaxPartitionSize( framesPerBlock );
+
+	noise >> convolution >> ctx->getOutput();
+	noise->enable();
+
+	// render a few blocks first so that the impulse response is partitioned and everything is initialized
+	for( size_t i = 0; i < 8; i++ )
+		ctx->renderBlock();
+
+	const size_t numBlocks = size_t( SECONDS_RENDERED * SAMPLE_RATE / framesPerBlock );
+
+	auto start = chrono::high_resolution_clock::now();
+	for( size_t i = 0; i < numBlocks; i++ )
+		ctx->renderBlock();
+	auto end = chrono::high_resolution_clock::now();
+
+	return chrono::duration<double, micro>( end - start ).count() / double( numBlocks * NUM_CHANNELS );
+}
+
+int main( int argc, char *argv[] )
+{
+	cout << "samplerate: " << SAMPLE_RATE << ", channels: " << NUM_CHANNELS << endl;
+	cout << "cost is in microseconds per block per channel, and percent of realtime per channel" << endl << endl;
+	cout << setw( 8 ) << "ir (s)" << setw( 8 ) << "block" << setw( 16 ) << "non-uniform us" << setw( 10 ) << "% rt" << setw( 14 ) << "uniform us" << setw( 10 ) << "% rt" << endl;
+
+	for( double irSeconds : { 1.0, 4.0, 10.0 } ) {
+		auto impulseResponse = makeImpulseResponse( irSeconds );
+
+		for( size_t framesPerBlock : { 64, 256, 1024 } ) {
+			const double blockMicroseconds = 1e6 * double( framesPerBlock ) / double( SAMPLE_RATE );
+			double nonUniform = measure( impulseResponse, framesPerBlock, false );
+			double uniform = measure( impulseResponse, framesPerBlock, true );
+
+			cout << setw( 8 ) << fixed << setprecision( 0 ) << irSeconds << setw( 8 ) << framesPerBlock
+				 << setw( 16 ) << setprecision( 2 ) << nonUniform << setw( 10 ) << 100 * nonUniform / blockMicroseconds
+				 << setw( 14 ) << uniform << setw( 10 ) << 100 * uniform / blockMicroseconds << endl;
+		}
+	}
+
+	return 0;
+}
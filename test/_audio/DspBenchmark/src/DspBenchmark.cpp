@@ -0,0 +1,148 @@
+// Compares the audio::dsp vector routines against plain scalar loops, for the block sizes commonly seen in an audio graph.
+
+#include "cinder/audio/Buffer.h"
+#include "cinder/audio/dsp/Dsp.h"
+#include "cinder/Rand.h"
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+
+using namespace std;
+using namespace ci;
+using namespace ci::audio;
+
+namespace scalar {
+
+void add( const float *arrayA, const float *arrayB, float *result, size_t length )
+{
+	for( size_t i = 0; i < length; i++ )
+		result[i] = arrayA[i] + arrayB[i];
+}
+
+void mul( const float *array, float scalar, float *result, size_t length )
+{
+	for( size_t i = 0; i < length; i++ )
+		result[i] = array[i] * scalar;
+}
+
+void mul( const float *arrayA, const float *arrayB, float *result, size_t length )
+{
+	for( size_t i = 0; i < length; i++ )
+		result[i] = arrayA[i] * arrayB[i];
+}
+
+void addMul( const float *arrayA, const float *arrayB, float scalar, float *result, size_t length )
+{
+	for( size_t i = 0; i < length; i++ )
+		result[i] = ( arrayA[i] + arrayB[i] ) * scalar;
+}
+
+void fill( float value, float *array, size_t length )
+{
+	for( size_t i = 0; i < length; i++ )
+		array[i] = value;
+}
+
+float sum( const float *array, size_t length )
+{
+	float result( 0.0f );
+	for( size_t i = 0; i < length; i++ )
+		result += array[i];
+	return result;
+}
+
+float rms( const float *array, size_t length )
+{
+	float sumSquared( 0.0f );
+	for( size_t i = 0; i < length; i++ )
+		sumSquared += array[i] * array[i];
+	return sqrt( sumSquared / (float)length );
+}
+
+} // namespace scalar
+
+// Prevents the compiler from optimizing away reductions whose result is otherwise unused.
+volatile float sSink = 0;
+
+// Returns the average time in nanoseconds per call of \a fn.
+double measure( const function<void ()> &fn, size_t numFrames )
+{
+	const size_t iterations = max<size_t>( 1000, ( 1 << 24 ) / numFrames );
+
+	fn(); // warm up
+
+	auto start = chrono::high_resolution_clock::now();
+	for( size_t i = 0; i < iterations; i++ )
+		fn();
+	auto end = chrono::high_resolution_clock::now();
+
+	return chrono::duration<double, nano>( end - start ).count() / double( iterations );
+}
+
+void printResult( const char *name, size_t numFrames, double scalarNs, double dspNs )
+{
+	cout << setw( 8 ) << name << setw( 8 ) << numFrames
+		 << setw( 14 ) << fixed << setprecision( 1 ) << scalarNs
+		 << setw( 14 ) << dspNs
+		 << setw( 10 ) << setprecision( 2 ) << scalarNs / dspNs << "x" << endl;
+}
+
+void benchBlockSize( size_t numFrames )
+{
+	Buffer a( numFrames ), b( numFrames ), result( numFrames );
+	for( size_t i = 0; i < numFrames; i++ ) {
+		a[i] = randFloat( -1, 1 );
+		b[i] = randFloat( -1, 1 );
+	}
+
+	const float *pa = a.getData();
+	const float *pb = b.getData();
+	float *pr = result.getData();
+
+	printResult( "add", numFrames,
+		measure( [=] { scalar::add( pa, pb, pr, numFrames ); }, numFrames ),
+		measure( [=] { dsp::add( pa, pb, pr, numFrames ); }, numFrames ) );
+	printResult( "mul", numFrames,
+		measure( [=] { scalar::mul( pa, pb, pr, numFrames ); }, numFrames ),
+		measure( [=] { dsp::mul( pa, pb, pr, numFrames ); }, numFrames ) );
+	printResult( "mulS", numFrames,
+		measure( [=] { scalar::mul( pa, 0.5f, pr, numFrames ); }, numFrames ),
+		measure( [=] { dsp::mul( pa, 0.5f, pr, numFrames ); }, numFrames ) );
+	printResult( "addMul", numFrames,
+		measure( [=] { scalar::addMul( pa, pb, 0.5f, pr, numFrames ); }, numFrames ),
+		measure( [=] { dsp::addMul( pa, pb, 0.5f, pr, numFrames ); }, numFrames ) );
+	printResult( "fill", numFrames,
+		measure( [=] { scalar::fill( 0.5f, pr, numFrames ); }, numFrames ),
+		measure( [=] { dsp::fill( 0.5f, pr, numFrames ); }, numFrames ) );
+	printResult( "sum", numFrames,
+		measure( [=] { sSink = scalar::sum( pa, numFrames ); }, numFrames ),
+		measure( [=] { sSink = dsp::sum( pa, numFrames ); }, numFrames ) );
+	printResult( "rms", numFrames,
+		measure( [=] { sSink = scalar::rms( pa, numFrames ); }, numFrames ),
+		measure( [=] { sSink = dsp::rms( pa, numFrames ); }, numFrames ) );
+}
+
+int main( int argc, char *argv[] )
+{
+#if defined( CINDER_AUDIO_VDSP )
+	const char *backend = "vDSP";
+#elif defined( CINDER_AUDIO_SSE )
+	const char *backend = "SSE2";
+#elif defined( CINDER_AUDIO_NEON )
+	const char *backend = "NEON";
+#else
+	const char *backend = "scalar";
+#endif
+
+	cout << "audio::dsp backend: " << backend << endl << endl;
+	cout << setw( 8 ) << "routine" << setw( 8 ) << "frames" << setw( 14 ) << "scalar (ns)" << setw( 14 ) << "dsp (ns)" << setw( 11 ) << "speedup" << endl;
+
+	for( size_t numFrames : { 64, 256, 512, 1024, 4096 } ) {
+		benchBlockSize( numFrames );
+		cout << endl;
+	}
+
+	return 0;
+}
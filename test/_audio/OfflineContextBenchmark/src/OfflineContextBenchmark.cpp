@@ -0,0 +1,71 @@
+// Measures how fast an OfflineContext renders graphs of increasing size, both serially and with parallel render threads.
+
+#include "cinder/audio/OfflineContext.h"
+#include "cinder/audio/FilterNode.h"
+#include "cinder/audio/GainNode.h"
+#include "cinder/audio/GenNode.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+using namespace std;
+using namespace ci;
+using namespace ci::audio;
+
+const size_t FRAMES_PER_BLOCK = 512;
+const double SECONDS_RENDERED = 10;
+
+// Returns the number of blocks rendered per second, for a graph of \a numVoices sine -> lowpass -> gain voices summed at the output.
+double measure( size_t numVoices, size_t numRenderThreads )
+{
+	auto ctx = make_shared<OfflineContext>( 44100, FRAMES_PER_BLOCK, 2 );
+	ctx->setNumRenderThreads( numRenderThreads );
+
+	vector<NodeRef> nodes;
+	for( size_t i = 0; i < numVoices; i++ ) {
+		auto gen = ctx->makeNode<GenSineNode>( 110.0f + float( i ) );
+		auto lowpass = ctx->makeNode<FilterLowPassNode>();
+		auto gain = ctx->makeNode<GainNode>( 1.0f / float( numVoices ) );
+		gen >> lowpass >> gain >> ctx->getOutput();
+		gen->enable();
+
+		nodes.push_back( gen );
+		nodes.push_back( lowpass );
+		nodes.push_back( gain );
+	}
+
+	// render a few blocks first so that everything is initialized
+	for( size_t i = 0; i < 8; i++ )
+		ctx->renderBlock();
+
+	const size_t numBlocks = max<size_t>( 8, size_t( SECONDS_RENDERED * 44100 / FRAMES_PER_BLOCK ) / numVoices );
+
+	auto start = chrono::high_resolution_clock::now();
+	for( size_t i = 0; i < numBlocks; i++ )
+		ctx->renderBlock();
+	auto end = chrono::high_resolution_clock::now();
+
+	return double( numBlocks ) / chrono::duration<double>( end - start ).count();
+}
+
+int main( int argc, char *argv[] )
+{
+	const size_t numRenderThreads = max<size_t>( 1, thread::hardware_concurrency() ) - 1;
+	const double realtimeBlocksPerSecond = 44100.0 / FRAMES_PER_BLOCK;
+
+	cout << "frames per block: " << FRAMES_PER_BLOCK << ", parallel render threads: " << numRenderThreads << endl << endl;
+	cout << setw( 8 ) << "voices" << setw( 16 ) << "serial (blk/s)" << setw( 12 ) << "x realtime" << setw( 18 ) << "parallel (blk/s)" << setw( 12 ) << "x realtime" << endl;
+
+	for( size_t numVoices : { 1, 10, 100, 1000 } ) {
+		double serial = measure( numVoices, 0 );
+		double parallel = measure( numVoices, numRenderThreads );
+
+		cout << setw( 8 ) << numVoices
+			 << setw( 16 ) << fixed << setprecision( 1 ) << serial << setw( 12 ) << serial / realtimeBlocksPerSecond
+			 << setw( 18 ) << parallel << setw( 12 ) << parallel / realtimeBlocksPerSecond << endl;
+	}
+
+	return 0;
+}
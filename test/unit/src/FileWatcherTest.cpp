@@ -4,6 +4,9 @@
 #include "cinder/app/App.h"
 #include "cinder/FileWatcher.h"
 
+#include <algorithm>
+#include <fstream>
+
 using namespace std;
 using namespace ci;
 
@@ -35,6 +38,33 @@ void updateFileWatcher( FileWatcher& watcher, double timeoutSeconds, std::functi
 	}
 }
 
+// Returns an empty directory for tests that modify files
+fs::path makeTestDirectory()
+{
+	fs::path result = fs::temp_directory_path() / "cinder_FileWatcherTest";
+	fs::remove_all( result );
+	fs::create_directories( result );
+	return result;
+}
+
+void writeTestFile( const fs::path &path, const string &contents )
+{
+	ofstream stream( path.string() );
+	stream << contents;
+}
+
+// Writes \a path with a last write time \a seconds ahead of now, so that polling sees it change regardless of the file system's resolution
+void writeTestFileAhead( const fs::path &path, const string &contents, int seconds )
+{
+	writeTestFile( path, contents );
+	fs::last_write_time( path, fs::file_time_type::clock::now() + chrono::seconds( seconds ) );
+}
+
+bool contains( const vector<fs::path> &paths, const fs::path &path )
+{
+	return find( paths.begin(), paths.end(), path ) != paths.end();
+}
+
 TEST_CASE( "FileWatcher" )
 {
 	SECTION( "shared instance" )
@@ -146,4 +176,114 @@ TEST_CASE( "FileWatcher" )
 		REQUIRE( watcher.getNumWatches() == 0 );
 		REQUIRE( watcher.getNumWatchedFiles() == 0 );
 	}
+
+	SECTION( "backends" )
+	{
+#if defined( CINDER_LINUX )
+		REQUIRE( FileWatcher().getBackend() == FileWatcher::Backend::NATIVE );
+#endif
+		REQUIRE( FileWatcher( FileWatcher::Backend::POLLING ).getBackend() == FileWatcher::Backend::POLLING );
+	}
+
+	SECTION( "directories" )
+	{
+		for( auto backend : { FileWatcher::Backend::POLLING, FileWatcher::Backend::NATIVE } ) {
+			fs::path dir = makeTestDirectory();
+			fs::create_directories( dir / "sub" );
+			writeTestFile( dir / "a.txt", "a" );
+			writeTestFile( dir / "sub" / "b.txt", "b" );
+
+			FileWatcher watcher( backend );
+			watcher.setConnectToAppUpdateEnabled( false );
+
+			vector<fs::path> modified, modifiedRecursive;
+			watcher.watch( dir, FileWatcher::Options().callOnWatch( false ), [&modified]( const WatchEvent &event ) {
+				modified.insert( modified.end(), event.getFiles().begin(), event.getFiles().end() );
+			} );
+			watcher.watch( dir, FileWatcher::Options().callOnWatch( false ).recursive(), [&modifiedRecursive]( const WatchEvent &event ) {
+				modifiedRecursive.insert( modifiedRecursive.end(), event.getFiles().begin(), event.getFiles().end() );
+			} );
+			REQUIRE( watcher.getNumWatchedFiles() == 2 );
+
+			// modified files and files in directories created after the watch are reported
+			writeTestFileAhead( dir / "sub" / "b.txt", "b2", 1 );
+			writeTestFile( dir / "c.txt", "c" );
+			fs::create_directories( dir / "new" / "deeper" );
+			writeTestFile( dir / "new" / "deeper" / "d.txt", "d" );
+
+			updateFileWatcher( watcher, 5, [&]( FileWatcher &watcher ) {
+				return contains( modified, dir / "c.txt" ) && contains( modifiedRecursive, dir / "c.txt" ) &&
+					   contains( modifiedRecursive, dir / "sub" / "b.txt" ) && contains( modifiedRecursive, dir / "new" / "deeper" / "d.txt" );
+			} );
+
+			REQUIRE( modified == vector<fs::path>( { dir / "c.txt" } ) );
+			REQUIRE( modifiedRecursive.size() == 3 );
+			REQUIRE( contains( modifiedRecursive, dir / "c.txt" ) );
+			REQUIRE( contains( modifiedRecursive, dir / "sub" / "b.txt" ) );
+			REQUIRE( contains( modifiedRecursive, dir / "new" / "deeper" / "d.txt" ) );
+		}
+	}
+
+	SECTION( "saving through a temporary file is reported once" )
+	{
+		for( auto backend : { FileWatcher::Backend::POLLING, FileWatcher::Backend::NATIVE } ) {
+			fs::path dir = makeTestDirectory();
+			fs::path file = dir / "shader.glsl";
+			writeTestFile( file, "v1" );
+
+			FileWatcher watcher( backend );
+			watcher.setConnectToAppUpdateEnabled( false );
+
+			vector<vector<fs::path>> events;
+			watcher.watch( file, FileWatcher::Options().callOnWatch( false ), [&events]( const WatchEvent &event ) {
+				events.push_back( event.getFiles() );
+			} );
+
+			// the way many editors save, so that the file is never seen half written
+			writeTestFileAhead( dir / "shader.glsl.tmp", "v2", 1 );
+			fs::rename( dir / "shader.glsl.tmp", file );
+			updateFileWatcher( watcher, 5, [&events]( FileWatcher &watcher ) { return ! events.empty(); } );
+
+			// any further notifications for the first save arrive before those of the second
+			writeTestFileAhead( dir / "shader.glsl.tmp", "v3", 2 );
+			fs::rename( dir / "shader.glsl.tmp", file );
+			updateFileWatcher( watcher, 5, [&events]( FileWatcher &watcher ) { return events.size() >= 2; } );
+
+			REQUIRE( events.size() == 2 );
+			REQUIRE( events[0] == vector<fs::path>( { file } ) );
+			REQUIRE( events[1] == vector<fs::path>( { file } ) );
+		}
+	}
+
+	SECTION( "directories that are removed and recreated" )
+	{
+		for( auto backend : { FileWatcher::Backend::POLLING, FileWatcher::Backend::NATIVE } ) {
+			fs::path dir = makeTestDirectory() / "assets";
+			fs::create_directories( dir );
+			writeTestFile( dir / "a.txt", "a" );
+
+			FileWatcher watcher( backend );
+			watcher.setConnectToAppUpdateEnabled( false );
+
+			vector<fs::path> modified;
+			watcher.watch( dir, FileWatcher::Options().callOnWatch( false ), [&modified]( const WatchEvent &event ) {
+				modified.insert( modified.end(), event.getFiles().begin(), event.getFiles().end() );
+			} );
+
+			// files written to the directory after it was recreated, such as by a build step, are still reported
+			fs::remove_all( dir );
+			updateFileWatcher( watcher, 0.2, []( FileWatcher &watcher ) { return false; } );
+			fs::create_directories( dir );
+			writeTestFileAhead( dir / "a.txt", "a2", 1 );
+			updateFileWatcher( watcher, 5, [&]( FileWatcher &watcher ) { return contains( modified, dir / "a.txt" ); } );
+			REQUIRE( contains( modified, dir / "a.txt" ) );
+
+			modified.clear();
+			writeTestFileAhead( dir / "b.txt", "b", 2 );
+			updateFileWatcher( watcher, 5, [&]( FileWatcher &watcher ) { return contains( modified, dir / "b.txt" ); } );
+			REQUIRE( modified == vector<fs::path>( { dir / "b.txt" } ) );
+		}
+
+		fs::remove_all( fs::temp_directory_path() / "cinder_FileWatcherTest" );
+	}
 }
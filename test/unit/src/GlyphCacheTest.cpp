@@ -0,0 +1,172 @@
+#include "cinder/Text.h"
+#include "cinder/Unicode.h"
+
+#include "catch.hpp"
+
+#if defined( CINDER_LINUX )
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace ci;
+using namespace std;
+
+namespace {
+
+bool isEqual( const Surface &a, const Surface &b )
+{
+	if( a.getSize() != b.getSize() )
+		return false;
+	for( int y = 0; y < a.getHeight(); ++y ) {
+		if( memcmp( a.getData( ivec2( 0, y ) ), b.getData( ivec2( 0, y ) ), a.getWidth() * a.getPixelInc() ) != 0 )
+			return false;
+	}
+
+	return true;
+}
+
+// Renders the same labels, paragraphs and layouts whether or not the cache is enabled
+vector<Surface> renderTexts( const Font &font )
+{
+	vector<Surface> result;
+	for( int i = 0; i < 20; ++i )
+		result.push_back( renderString( "Score: " + to_string( i * 37 ), font, ColorA( 1, 0.5f, 0.25f, 1 ) ) );
+
+	for( auto align : { TextBox::LEFT, TextBox::CENTER, TextBox::RIGHT } ) {
+		TextBox box;
+		box.font( font ).text( "The quick brown fox jumps over the lazy dog, twice." ).size( 120, TextBox::GROW ).alignment( align );
+		result.push_back( box.render( vec2( 0.25f, 0.5f ) ) );
+	}
+
+	TextLayout layout;
+	layout.setFont( font );
+	layout.addLine( "left" );
+	layout.addCenteredLine( "centered line" );
+	layout.append( " and more" );
+	layout.addRightLine( "right" );
+	result.push_back( layout.render( true ) );
+
+	return result;
+}
+
+} // anonymous namespace
+
+TEST_CASE( "GlyphCache" )
+{
+	GlyphCache *cache = GlyphCache::get();
+	cache->clear();
+	const size_t memoryBudget = cache->getMemoryBudget();
+	Font font( "DejaVu Sans", 17 );
+	FT_Face face = font.getFreetypeFace();
+
+SECTION( "rendering with the cache matches rendering without it" )
+{
+	cache->setEnabled( false );
+	auto expected = renderTexts( font );
+	REQUIRE( cache->getNumGlyphs() == 0 );
+	REQUIRE( cache->getNumRuns() == 0 );
+
+	cache->setEnabled( true );
+	auto first = renderTexts( font );
+	const size_t numGlyphs = cache->getNumGlyphs(), numRuns = cache->getNumRuns();
+	REQUIRE( numGlyphs > 0 );
+	REQUIRE( numRuns > 0 );
+
+	// rendering again only uses what's cached
+	auto second = renderTexts( font );
+	REQUIRE( cache->getNumGlyphs() == numGlyphs );
+	REQUIRE( cache->getNumRuns() == numRuns );
+
+	for( size_t i = 0; i < expected.size(); ++i ) {
+		REQUIRE( isEqual( first[i], expected[i] ) );
+		REQUIRE( isEqual( second[i], expected[i] ) );
+	}
+}
+
+SECTION( "glyphs are cached by subpixel offset" )
+{
+	const uint32_t glyphIndex = font.getGlyphChar( 'g' );
+	auto glyph = cache->getGlyph( face, glyphIndex, ivec2( 64 * 5 + 13, 64 * 3 ) );
+	REQUIRE( glyph->mLoaded );
+	REQUIRE( glyph->mWidth > 0 );
+	REQUIRE( glyph->mPixels.size() == size_t( glyph->mWidth * glyph->mRows ) );
+	REQUIRE( glyph->mAdvance.x > 0 );
+
+	// the integer part of the pen doesn't affect the bitmap, the fractional part does
+	REQUIRE( cache->getGlyph( face, glyphIndex, ivec2( 64 * 9 + 13, 64 * 11 ) ) == glyph );
+	REQUIRE( cache->getGlyph( face, glyphIndex, ivec2( -64 * 2 + 13, 0 ) ) == glyph );
+	REQUIRE( cache->getGlyph( face, glyphIndex, ivec2( 64 * 5 + 14, 64 * 3 ) ) != glyph );
+	REQUIRE( cache->getGlyph( face, font.getGlyphChar( 'h' ), ivec2( 64 * 5 + 13, 64 * 3 ) ) != glyph );
+}
+
+SECTION( "runs" )
+{
+	for( const string &text : { "Hello world", "Ünïcödé ½ → ∑", " leading space" } ) {
+		auto run = cache->getRun( face, text );
+		REQUIRE( run->mChars == toUtf32( text ) );
+		REQUIRE( run->mGlyphIndices.size() == run->mChars.size() );
+		REQUIRE( run->mAdvances.size() == run->mChars.size() );
+		REQUIRE( cache->getRun( face, text ) == run );
+
+		// a single line is rendered at the size of its run
+		Surface surface = renderString( text, font, ColorA( 1, 1, 1, 1 ) );
+		REQUIRE( surface.getWidth() == run->mSize.x );
+		REQUIRE( surface.getHeight() == run->mSize.y );
+
+		vector<GlyphCache::GlyphRef> glyphs;
+		cache->getGlyphs( face, *run, ivec2( 0 ), &glyphs );
+		REQUIRE( glyphs.size() == run->mChars.size() );
+		for( size_t i = 0; i < glyphs.size(); ++i )
+			REQUIRE( glyphs[i]->mAdvance == run->mAdvances[i] );
+	}
+
+	// runs are cached per font size
+	Font larger( "DejaVu Sans", 34 );
+	REQUIRE( cache->getRun( larger.getFreetypeFace(), "Hello world" )->mSize.y > cache->getRun( face, "Hello world" )->mSize.y );
+}
+
+SECTION( "the least recently used entries are evicted" )
+{
+	cache->setMemoryBudget( 16 * 1024 );
+	auto kept = cache->getRun( face, "kept" );
+	weak_ptr<const GlyphCache::Run> first = cache->getRun( face, "label 0" );
+	for( int i = 1; i < 1000; ++i ) {
+		cache->getRun( face, "label " + to_string( i ) );
+		REQUIRE( cache->getRun( face, "kept" ) == kept );
+		REQUIRE( cache->getMemoryUsage() <= 16 * 1024 );
+	}
+
+	// nothing else referenced the first label, so it was released along with its entry
+	REQUIRE( first.expired() );
+	REQUIRE( cache->getNumRuns() < 1000 );
+
+	cache->setMemoryBudget( 0 );
+	REQUIRE( cache->getNumGlyphs() == 0 );
+	REQUIRE( cache->getNumRuns() == 0 );
+	REQUIRE( cache->getMemoryUsage() == 0 );
+}
+
+SECTION( "clearing a face" )
+{
+	Font other( "DejaVu Sans", 23 );
+	cache->getRun( face, "one face" );
+	cache->getRun( other.getFreetypeFace(), "another face" );
+	const size_t numRuns = cache->getNumRuns();
+
+	cache->clear( other.getFreetypeFace() );
+	REQUIRE( cache->getNumRuns() == numRuns - 1 );
+	REQUIRE( cache->getNumGlyphs() > 0 );
+
+	cache->clear();
+	REQUIRE( cache->getNumGlyphs() == 0 );
+	REQUIRE( cache->getNumRuns() == 0 );
+	REQUIRE( cache->getMemoryUsage() == 0 );
+}
+
+	cache->setEnabled( true );
+	cache->setMemoryBudget( memoryBudget );
+	cache->clear();
+}
+
+#endif // defined( CINDER_LINUX )
@@ -0,0 +1,136 @@
+#include "cinder/ImageFileRaw.h"
+#include "cinder/DataSource.h"
+#include "cinder/DataTarget.h"
+#include "cinder/Rand.h"
+
+#include "catch.hpp"
+
+#include <cstring>
+#include <vector>
+
+using namespace ci;
+using namespace std;
+
+namespace {
+
+fs::path getTestPath( const string &name )
+{
+	fs::path result = fs::temp_directory_path() / "cinder_ImageFileRawTest";
+	fs::create_directories( result );
+	return result / name;
+}
+
+template<typename T>
+SurfaceT<T> makeRandomSurface( int32_t width, int32_t height, SurfaceChannelOrder channelOrder )
+{
+	Rand rand( width * 31 + height );
+	SurfaceT<T> result( width, height, channelOrder.hasAlpha(), channelOrder );
+	for( int32_t y = 0; y < height; y++ ) {
+		T *row = result.getData( ivec2( 0, y ) );
+		for( int32_t x = 0; x < width * result.getPixelInc(); x++ )
+			row[x] = T( rand.nextInt( 256 ) );
+	}
+
+	return result;
+}
+
+template<typename T>
+void writeRaw( const fs::path &path, const SurfaceT<T> &surface )
+{
+	writeImage( ImageTargetFileRaw::create( writeFile( path ), (ImageSourceRef)surface, ImageTarget::Options(), "ciraw" ), (ImageSourceRef)surface );
+}
+
+template<typename T>
+bool equalPixels( const SurfaceT<T> &a, const SurfaceT<T> &b )
+{
+	if( a.getSize() != b.getSize() )
+		return false;
+	for( int32_t y = 0; y < a.getHeight(); y++ ) {
+		for( int32_t x = 0; x < a.getWidth(); x++ ) {
+			if( ! ( a.getPixel( ivec2( x, y ) ) == b.getPixel( ivec2( x, y ) ) ) )
+				return false;
+		}
+	}
+
+	return true;
+}
+
+} // anonymous namespace
+
+TEST_CASE( "ImageFileRaw" )
+{
+
+SECTION( "mapped Surfaces share the file's memory" )
+{
+	const fs::path path = getTestPath( "bgra.ciraw" );
+	auto surface = makeRandomSurface<uint8_t>( 61, 37, SurfaceChannelOrder::BGRA );
+	writeRaw( path, surface );
+
+	auto mapped = mapSurface<uint8_t>( path, true );
+	REQUIRE( mapped->getChannelOrder() == SurfaceChannelOrder::BGRA );
+	REQUIRE( mapped->getRowBytes() == surface.getRowBytes() );
+	REQUIRE( equalPixels( *mapped, surface ) );
+
+	// the pixels follow the header directly, rather than being copied into a separate data store
+	auto file = MemoryMappedFile::create( path );
+	REQUIRE( memcmp( static_cast<const uint8_t*>( file->getData() ) + RawImageHeader::DATA_OFFSET, surface.getData(), surface.getRowBytes() * surface.getHeight() ) == 0 );
+
+	// writes to a copy-on-write mapping never reach the file, and the data store keeps the mapping alive after the Surface is gone
+	shared_ptr<uint8_t> dataStore = mapped->getDataStore();
+	const ptrdiff_t rowBytes = mapped->getRowBytes();
+	mapped->setPixel( ivec2( 3, 4 ), ColorA8u( 1, 2, 3, 4 ) );
+	mapped.reset();
+	REQUIRE( dataStore.get()[4 * rowBytes + 3 * 4 + 2] == 1 );
+	REQUIRE( equalPixels( *mapSurface<uint8_t>( path ), surface ) );
+}
+
+SECTION( "data types and loading through ImageIo" )
+{
+	const fs::path path = getTestPath( "rgb16.ciraw" );
+	auto surface = makeRandomSurface<uint16_t>( 20, 11, SurfaceChannelOrder::RGB );
+	writeRaw( path, surface );
+
+	REQUIRE( equalPixels( *mapSurface<uint16_t>( path ), surface ) );
+	REQUIRE_THROWS_AS( mapSurface<uint8_t>( path ), ImageIoExceptionIllegalDataType );
+	REQUIRE_THROWS_AS( mapSurface<float>( getTestPath( "missing.ciraw" ) ), ImageIoExceptionFailedLoad );
+
+	// DataSourcePath, DataSourceMemoryMapped and DataSourceBuffer all decode the same pixels
+	REQUIRE( equalPixels( Surface16u( ImageSourceFileRaw::create( loadFile( path ) ) ), surface ) );
+	REQUIRE( equalPixels( Surface16u( ImageSourceFileRaw::create( loadFileMapped( path ) ) ), surface ) );
+	REQUIRE( equalPixels( Surface16u( ImageSourceFileRaw::create( DataSourceBuffer::create( loadFile( path )->getBuffer() ) ) ), surface ) );
+
+	auto area = Surface16u( ImageSourceFileRaw::create( loadFile( path ), ImageSource::Options().area( Area( 4, 2, 9, 10 ) ) ) );
+	REQUIRE( area.getSize() == ivec2( 5, 8 ) );
+	REQUIRE( area.getPixel( ivec2( 0, 0 ) ) == surface.getPixel( ivec2( 4, 2 ) ) );
+	REQUIRE( area.getPixel( ivec2( 4, 7 ) ) == surface.getPixel( ivec2( 8, 9 ) ) );
+}
+
+SECTION( "invalid files" )
+{
+	const fs::path path = getTestPath( "truncated.ciraw" );
+	writeRaw( path, makeRandomSurface<uint8_t>( 16, 16, SurfaceChannelOrder::RGBA ) );
+
+	auto buffer = loadFile( path )->getBuffer();
+	REQUIRE_THROWS_AS( ImageSourceFileRaw::create( DataSourceBuffer::create( Buffer::create( buffer->getData(), buffer->getSize() - 1 ) ) ), ImageIoExceptionFailedLoad );
+	static_cast<uint8_t*>( buffer->getData() )[0] = 'X';
+	REQUIRE_THROWS_AS( ImageSourceFileRaw::create( DataSourceBuffer::create( buffer ) ), ImageIoExceptionFailedLoad );
+}
+
+SECTION( "DataSourceMemoryMapped buffers and streams keep the mapping alive" )
+{
+	const fs::path path = getTestPath( "buffer.ciraw" );
+	writeRaw( path, makeRandomSurface<uint8_t>( 8, 8, SurfaceChannelOrder::RGB ) );
+
+	BufferRef buffer = DataSourceMemoryMapped::create( path )->getBuffer();
+	BufferRef copy = loadFile( path )->getBuffer();
+	REQUIRE( buffer->getSize() == copy->getSize() );
+	REQUIRE( memcmp( buffer->getData(), copy->getData(), copy->getSize() ) == 0 );
+
+	IStreamRef stream = DataSourceMemoryMapped::create( path )->createStream();
+	vector<uint8_t> streamed( copy->getSize() );
+	stream->readData( streamed.data(), streamed.size() );
+	REQUIRE( memcmp( streamed.data(), copy->getData(), copy->getSize() ) == 0 );
+}
+
+	fs::remove_all( getTestPath( "" ).parent_path() );
+}
@@ -0,0 +1,315 @@
+#include "cinder/ImageIo.h"
+#include "cinder/ImageFileTinyExr.h"
+#include "cinder/ImageSourceFileQoi.h"
+#include "cinder/ImageSourceFileStbImage.h"
+#include "cinder/ImageSourcePng.h"
+#include "cinder/ImageTargetFileQoi.h"
+#include "cinder/ImageTargetFileStbImage.h"
+#include "cinder/ChanTraits.h"
+#include "cinder/Channel.h"
+#include "cinder/Rand.h"
+#include "cinder/Surface.h"
+
+#include "catch.hpp"
+
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+using namespace ci;
+using namespace std;
+
+namespace {
+
+const ImageIo::ChannelOrder sAllChannelOrders[] = { ImageIo::RGBA, ImageIo::BGRA, ImageIo::ARGB, ImageIo::ABGR, ImageIo::RGBX, ImageIo::BGRX,
+													ImageIo::XRGB, ImageIo::XBGR, ImageIo::RGB, ImageIo::BGR, ImageIo::Y, ImageIo::YA };
+
+template<typename T> ImageIo::DataType dataType();
+template<> ImageIo::DataType dataType<uint8_t>()	{ return ImageIo::UINT8; }
+template<> ImageIo::DataType dataType<uint16_t>()	{ return ImageIo::UINT16; }
+template<> ImageIo::DataType dataType<half_float>()	{ return ImageIo::FLOAT16; }
+template<> ImageIo::DataType dataType<float>()		{ return ImageIo::FLOAT32; }
+
+ImageIo::ColorModel colorModel( ImageIo::ChannelOrder channelOrder )
+{
+	return ( channelOrder == ImageIo::Y || channelOrder == ImageIo::YA ) ? ImageIo::CM_GRAY : ImageIo::CM_RGB;
+}
+
+template<typename T> T randomValue( Rand &rand )	{ return T( rand.nextInt( 256 ) ); }
+template<> uint16_t randomValue<uint16_t>( Rand &rand )		{ return uint16_t( rand.nextInt( 65536 ) ); }
+template<> float randomValue<float>( Rand &rand )			{ return rand.nextFloat( -0.1f, 1.1f ); }
+template<> half_float randomValue<half_float>( Rand &rand )	{ return floatToHalf( rand.nextFloat( -0.1f, 1.1f ) ); }
+
+template<typename T>
+bool equal( T a, T b )
+{
+	return memcmp( &a, &b, sizeof( T ) ) == 0;
+}
+
+// Serves rows of random values in any data type and channel order
+template<typename T>
+class MemoryImageSource : public ImageSource {
+  public:
+	MemoryImageSource( int32_t width, int32_t height, ChannelOrder channelOrder )
+	{
+		setSize( width, height );
+		setDataType( dataType<T>() );
+		setChannelOrder( channelOrder );
+		setColorModel( colorModel( channelOrder ) );
+
+		Rand rand( width * 31 + channelOrder );
+		mData.resize( width * height * channelOrderNumChannels( channelOrder ) );
+		for( auto &v : mData )
+			v = randomValue<T>( rand );
+	}
+
+	void load( ImageTargetRef target ) override
+	{
+		RowFunc func = setupRowFunc( target );
+		for( int32_t row = 0; row < mHeight; row++ )
+			( this->*func )( target, row, getRow( row ) );
+	}
+
+	const T*	getRow( int32_t row ) const		{ return mData.data() + row * mWidth * channelOrderNumChannels( mChannelOrder ); }
+
+	vector<T>	mData;
+};
+
+template<typename T>
+class MemoryImageTarget : public ImageTarget {
+  public:
+	MemoryImageTarget( int32_t width, int32_t height, ChannelOrder channelOrder )
+	{
+		setSize( width, height );
+		setDataType( dataType<T>() );
+		setChannelOrder( channelOrder );
+		setColorModel( colorModel( channelOrder ) );
+		mData.resize( width * height * channelOrderNumChannels( channelOrder ) );
+	}
+
+	void*	getRowPointer( int32_t row ) override	{ return mData.data() + row * mWidth * channelOrderNumChannels( mChannelOrder ); }
+
+	vector<T>	mData;
+};
+
+struct Offsets {
+	Offsets( ImageIo::ChannelOrder channelOrder )
+		: gray( -1 ), red( -1 ), green( -1 ), blue( -1 )
+	{
+		if( colorModel( channelOrder ) == ImageIo::CM_RGB )
+			ImageIo::translateRgbColorModelToOffsets( channelOrder, &red, &green, &blue, &alpha, &inc );
+		else
+			ImageIo::translateGrayColorModelToOffsets( channelOrder, &gray, &alpha, &inc );
+	}
+
+	int8_t gray, red, green, blue, alpha, inc;
+};
+
+// Compares every converted row against CHANTRAIT conversions of the source, ignoring target padding channels
+template<typename SD, typename TD>
+void testConversion( ImageIo::ChannelOrder sourceOrder, ImageIo::ChannelOrder targetOrder )
+{
+	const int32_t width = 37, height = 3;
+	auto source = make_shared<MemoryImageSource<SD>>( width, height, sourceOrder );
+	auto target = make_shared<MemoryImageTarget<TD>>( width, height, targetOrder );
+	source->load( target );
+
+	const Offsets s( sourceOrder ), t( targetOrder );
+	for( int32_t row = 0; row < height; row++ ) {
+		const SD *sourceData = source->getRow( row );
+		const TD *targetData = reinterpret_cast<const TD*>( target->getRowPointer( row ) );
+		for( int32_t x = 0; x < width; x++, sourceData += s.inc, targetData += t.inc ) {
+			if( t.red >= 0 ) {
+				const int8_t red = s.red >= 0 ? s.red : s.gray, green = s.green >= 0 ? s.green : s.gray, blue = s.blue >= 0 ? s.blue : s.gray;
+				REQUIRE( equal( targetData[t.red], CHANTRAIT<TD>::convert( sourceData[red] ) ) );
+				REQUIRE( equal( targetData[t.green], CHANTRAIT<TD>::convert( sourceData[green] ) ) );
+				REQUIRE( equal( targetData[t.blue], CHANTRAIT<TD>::convert( sourceData[blue] ) ) );
+			}
+			else if( s.gray >= 0 )
+				REQUIRE( equal( targetData[t.gray], CHANTRAIT<TD>::convert( sourceData[s.gray] ) ) );
+			else
+				REQUIRE( equal( targetData[t.gray], CHANTRAIT<TD>::convert( CHANTRAIT<SD>::grayscale( sourceData[s.red], sourceData[s.green], sourceData[s.blue] ) ) ) );
+
+			// only RGB to RGB conversions fill in a missing source alpha
+			if( t.alpha >= 0 && s.alpha >= 0 )
+				REQUIRE( equal( targetData[t.alpha], CHANTRAIT<TD>::convert( sourceData[s.alpha] ) ) );
+			else if( t.alpha >= 0 && s.red >= 0 && t.red >= 0 )
+				REQUIRE( equal( targetData[t.alpha], CHANTRAIT<TD>::max() ) );
+		}
+	}
+}
+
+template<typename SD, typename TD>
+void testAllChannelOrders()
+{
+	for( auto sourceOrder : sAllChannelOrders ) {
+		for( auto targetOrder : sAllChannelOrders )
+			testConversion<SD,TD>( sourceOrder, targetOrder );
+	}
+}
+
+template<typename SD>
+void testAllTargetTypes()
+{
+	testAllChannelOrders<SD,uint8_t>();
+	testAllChannelOrders<SD,uint16_t>();
+	testAllChannelOrders<SD,half_float>();
+	testAllChannelOrders<SD,float>();
+}
+
+// Averages each factor x factor block of \a area, in rows of \a inc channels returned by \a getRow, rounding integer types to the nearest integer
+template<typename T, typename GetRowFn>
+vector<T> averageRegion( const Area &area, int32_t factor, int32_t inc, GetRowFn getRow )
+{
+	const int32_t width = ( area.getWidth() + factor - 1 ) / factor, height = ( area.getHeight() + factor - 1 ) / factor;
+	vector<T> result( width * height * inc );
+	for( int32_t y = 0; y < height; y++ ) {
+		for( int32_t x = 0; x < width; x++ ) {
+			for( int32_t c = 0; c < inc; c++ ) {
+				double sum = 0;
+				int32_t count = 0;
+				for( int32_t sy = area.y1 + y * factor; sy < std::min( area.y1 + ( y + 1 ) * factor, area.y2 ); sy++ ) {
+					for( int32_t sx = area.x1 + x * factor; sx < std::min( area.x1 + ( x + 1 ) * factor, area.x2 ); sx++, count++ )
+						sum += getRow( sy )[sx * inc + c];
+				}
+				result[( y * width + x ) * inc + c] = std::is_floating_point<T>::value ? T( sum / count ) : T( sum / count + 0.5 );
+			}
+		}
+	}
+
+	return result;
+}
+
+// Loads \a source into a Surface and compares it against averageRegion() of \a rows, where \a offsets are the source's red, green, blue and alpha channels
+template<typename T, typename GetRowFn>
+void testRegion( const ImageSourceRef &source, const Area &area, int32_t factor, const int8_t offsets[4], GetRowFn getRow )
+{
+	const vector<T> expected = averageRegion<T>( area, factor, 4, getRow );
+	SurfaceT<T> surface( source );
+	REQUIRE( surface.getWidth() == ( area.getWidth() + factor - 1 ) / factor );
+	REQUIRE( surface.getHeight() == ( area.getHeight() + factor - 1 ) / factor );
+	for( int32_t y = 0; y < surface.getHeight(); y++ ) {
+		for( int32_t x = 0; x < surface.getWidth(); x++ ) {
+			const T *e = &expected[( y * surface.getWidth() + x ) * 4];
+			REQUIRE( surface.getPixel( ivec2( x, y ) ) == ColorAT<T>( e[offsets[0]], e[offsets[1]], e[offsets[2]], e[offsets[3]] ) );
+		}
+	}
+}
+
+// Runs testRegion() on RGBA sources returned by \a createSource for a few areas and downscale factors. Factors are powers of two,
+// so that averaged float values stay exact.
+template<typename T, typename CreateSourceFn, typename GetRowFn>
+void testRegions( const Area &bounds, CreateSourceFn createSource, GetRowFn getRow )
+{
+	const int8_t offsets[4] = { 0, 1, 2, 3 };
+	testRegion<T>( createSource( ImageSource::Options() ), bounds, 1, offsets, getRow );
+	testRegion<T>( createSource( ImageSource::Options().area( Area( 5, 7, 30, 20 ) ) ), Area( 5, 7, 30, 20 ), 1, offsets, getRow );
+	testRegion<T>( createSource( ImageSource::Options().downscale( 4 ) ), bounds, 4, offsets, getRow );
+	testRegion<T>( createSource( ImageSource::Options().area( Area( 10, 3, 100, 100 ) ).downscale( 2 ) ), Area( 10, 3, bounds.x2, bounds.y2 ), 2, offsets, getRow );
+}
+
+} // anonymous namespace
+
+TEST_CASE( "ImageIo" )
+{
+
+SECTION( "row conversion between all data types and channel orders" )
+{
+	testAllTargetTypes<uint8_t>();
+	testAllTargetTypes<uint16_t>();
+	testAllTargetTypes<half_float>();
+	testAllTargetTypes<float>();
+}
+
+SECTION( "non-planar channels" )
+{
+	Surface8u surface( 41, 5, true, SurfaceChannelOrder::BGRA );
+	Rand rand( 5 );
+	for( int32_t y = 0; y < surface.getHeight(); y++ ) {
+		for( int32_t x = 0; x < surface.getWidth() * 4; x++ )
+			surface.getData( ivec2( 0, y ) )[x] = uint8_t( rand.nextInt( 256 ) );
+	}
+
+	Surface8u rgb( (ImageSourceRef)surface.getChannelGreen(), SurfaceConstraintsDefault(), false );
+	Channel32f channel( (ImageSourceRef)surface.getChannelRed() );
+	for( int32_t y = 0; y < surface.getHeight(); y++ ) {
+		for( int32_t x = 0; x < surface.getWidth(); x++ ) {
+			const ColorA8u pixel = surface.getPixel( ivec2( x, y ) );
+			REQUIRE( rgb.getPixel( ivec2( x, y ) ) == ColorA8u( pixel.g, pixel.g, pixel.g, 255 ) );
+			REQUIRE( channel.getValue( ivec2( x, y ) ) == pixel.r / 255.0f );
+		}
+	}
+}
+
+SECTION( "area and downscale in a streaming decoder" )
+{
+	Surface8u surface( 53, 41, true, SurfaceChannelOrder::RGBA );
+	Rand rand( 13 );
+	for( int32_t y = 0; y < surface.getHeight(); y++ ) {
+		for( int32_t x = 0; x < surface.getWidth() * 4; x++ )
+			surface.getData( ivec2( 0, y ) )[x] = uint8_t( rand.nextInt( 4 ) * 60 ); // few values, so that QOI uses all of its ops
+	}
+
+	const fs::path path = fs::temp_directory_path() / "cinder_ImageIoTest.qoi";
+	writeImage( ImageTargetFileQoi::create( writeFile( path ), (ImageSourceRef)surface, ImageTarget::Options(), "qoi" ), (ImageSourceRef)surface );
+	const DataSourceRef buffer = DataSourceBuffer::create( loadFile( path )->getBuffer() );
+
+	auto getRow = [&surface]( int32_t y ) { return surface.getData( ivec2( 0, y ) ); };
+	const int8_t offsets[4] = { 0, 1, 2, 3 };
+	testRegion<uint8_t>( ImageSourceFileQoi::create( loadFile( path ), ImageSource::Options() ), surface.getBounds(), 1, offsets, getRow );
+	testRegion<uint8_t>( ImageSourceFileQoi::create( buffer, ImageSource::Options() ), surface.getBounds(), 1, offsets, getRow );
+	testRegion<uint8_t>( ImageSourceFileQoi::create( loadFile( path ), ImageSource::Options().area( Area( 5, 7, 30, 20 ) ) ), Area( 5, 7, 30, 20 ), 1, offsets, getRow );
+	testRegion<uint8_t>( ImageSourceFileQoi::create( buffer, ImageSource::Options().downscale( 4 ) ), surface.getBounds(), 4, offsets, getRow );
+	testRegion<uint8_t>( ImageSourceFileQoi::create( buffer, ImageSource::Options().area( Area( 10, 3, 100, 100 ) ).downscale( 3 ) ), Area( 10, 3, 53, 41 ), 3, offsets, getRow );
+
+	REQUIRE_THROWS_AS( ImageSourceFileQoi::create( buffer, ImageSource::Options().area( Area( 60, 0, 70, 10 ) ) ), ImageIoExceptionFailedLoad );
+	fs::remove( path );
+}
+
+SECTION( "area and downscale in whole image decoders" )
+{
+	Surface8u surface( 53, 41, true, SurfaceChannelOrder::RGBA );
+	Surface32f surface32f( 53, 41, true, SurfaceChannelOrder::RGBA );
+	Rand rand( 17 );
+	for( int32_t y = 0; y < surface.getHeight(); y++ ) {
+		for( int32_t x = 0; x < surface.getWidth() * 4; x++ ) {
+			surface.getData( ivec2( 0, y ) )[x] = uint8_t( rand.nextInt( 256 ) );
+			surface32f.getData( ivec2( 0, y ) )[x] = float( rand.nextInt( 5 ) ) * 0.25f; // exact as a half float
+		}
+	}
+	auto getRow = [&surface]( int32_t y ) { return surface.getData( ivec2( 0, y ) ); };
+	auto getRow32f = [&surface32f]( int32_t y ) { return surface32f.getData( ivec2( 0, y ) ); };
+
+	const fs::path pngPath = fs::temp_directory_path() / "cinder_ImageIoTest.png";
+	writeImage( ImageTargetFileStbImage::create( writeFile( pngPath ), (ImageSourceRef)surface, ImageTarget::Options(), "png" ), (ImageSourceRef)surface );
+	testRegions<uint8_t>( surface.getBounds(), [&]( const ImageSource::Options &options ) { return ImageSourcePng::createSourceRef( loadFile( pngPath ), options ); }, getRow );
+	fs::remove( pngPath );
+
+	const fs::path tgaPath = fs::temp_directory_path() / "cinder_ImageIoTest.tga";
+	writeImage( ImageTargetFileStbImage::create( writeFile( tgaPath ), (ImageSourceRef)surface, ImageTarget::Options(), "tga" ), (ImageSourceRef)surface );
+	testRegions<uint8_t>( surface.getBounds(), [&]( const ImageSource::Options &options ) { return ImageSourceFileStbImage::create( loadFile( tgaPath ), options ); }, getRow );
+	fs::remove( tgaPath );
+
+	const fs::path exrPath = fs::temp_directory_path() / "cinder_ImageIoTest.exr";
+	writeImage( ImageTargetFileTinyExr::create( writeFile( exrPath ), (ImageSourceRef)surface32f, ImageTarget::Options(), "exr" ), (ImageSourceRef)surface32f );
+	testRegions<float>( surface32f.getBounds(), [&]( const ImageSource::Options &options ) { return ImageSourceFileTinyExr::create( loadFile( exrPath ), options ); }, getRow32f );
+	fs::remove( exrPath );
+}
+
+SECTION( "area and downscale for sources without native support" )
+{
+	ImageIoRegistrar::registerSourceType( "citestregion", []( DataSourceRef, ImageSource::Options ) -> ImageSourceRef {
+		return make_shared<MemoryImageSource<uint16_t>>( 38, 29, ImageIo::BGRA );
+	} );
+
+	MemoryImageSource<uint16_t> reference( 38, 29, ImageIo::BGRA );
+	auto getRow = [&reference]( int32_t y ) { return reference.getRow( y ); };
+	const int8_t offsets[4] = { 2, 1, 0, 3 };
+	const DataSourceRef dataSource = DataSourceBuffer::create( Buffer::create( 1 ) );
+
+	testRegion<uint16_t>( loadImage( dataSource, ImageSource::Options(), "citestregion" ), Area( 0, 0, 38, 29 ), 1, offsets, getRow );
+	testRegion<uint16_t>( loadImage( dataSource, ImageSource::Options().area( Area( 3, 4, 20, 25 ) ), "citestregion" ), Area( 3, 4, 20, 25 ), 1, offsets, getRow );
+	testRegion<uint16_t>( loadImage( dataSource, ImageSource::Options().area( Area( 3, 4, 38, 29 ) ).downscale( 4 ), "citestregion" ), Area( 3, 4, 38, 29 ), 4, offsets, getRow );
+}
+
+} // "ImageIo"
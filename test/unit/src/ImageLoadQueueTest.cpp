@@ -0,0 +1,229 @@
+#include "cinder/ImageLoadQueue.h"
+
+#include "catch.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+using namespace ci;
+using namespace std;
+
+namespace {
+
+// Describes an image for TestImageSource, stored as the raw bytes of a DataSourceBuffer.
+struct TestImage {
+	uint16_t	mWidth, mHeight;
+	uint8_t		mValue;
+	bool		mFail, mBlock;
+};
+
+mutex						sMutex;
+condition_variable			sGateCondition;
+bool						sGateOpen = true;
+vector<uint8_t>				sDecodeOrder;
+
+// Decodes to an RGB image filled with TestImage::mValue, recording the order in which images are decoded.
+class TestImageSource : public ImageSource {
+  public:
+	static ImageSourceRef create( DataSourceRef dataSource, ImageSource::Options /*options*/ )
+	{
+		return make_shared<TestImageSource>( dataSource );
+	}
+
+	TestImageSource( const DataSourceRef &dataSource )
+	{
+		memcpy( &mImage, dataSource->getBuffer()->getData(), sizeof( TestImage ) );
+		if( mImage.mFail )
+			throw ImageIoExceptionFailedLoad( "test image failure" );
+
+		unique_lock<mutex> lock( sMutex );
+		if( mImage.mBlock )
+			sGateCondition.wait( lock, [] { return sGateOpen; } );
+		sDecodeOrder.push_back( mImage.mValue );
+
+		setSize( mImage.mWidth, mImage.mHeight );
+		setDataType( ImageIo::UINT8 );
+		setColorModel( ImageIo::CM_RGB );
+		setChannelOrder( ImageIo::RGB );
+	}
+
+	void load( ImageTargetRef target ) override
+	{
+		RowFunc func = setupRowFunc( target );
+		vector<uint8_t> row( mWidth * 3, mImage.mValue );
+		for( int32_t y = 0; y < mHeight; y++ )
+			( this->*func )( target, y, row.data() );
+	}
+
+  private:
+	TestImage	mImage;
+};
+
+DataSourceRef makeTestImage( uint8_t value, uint16_t width = 16, uint16_t height = 8, bool fail = false, bool block = false )
+{
+	static bool sRegistered = false;
+	if( ! sRegistered ) {
+		ImageIoRegistrar::registerSourceType( "citestimage", TestImageSource::create );
+		sRegistered = true;
+	}
+
+	TestImage image = { width, height, value, fail, block };
+	auto buffer = Buffer::create( sizeof( TestImage ) );
+	memcpy( buffer->getData(), &image, sizeof( TestImage ) );
+	return DataSourceBuffer::create( buffer, "image.citestimage" );
+}
+
+void setGateOpen( bool open )
+{
+	{
+		lock_guard<mutex> lock( sMutex );
+		sGateOpen = open;
+		sDecodeOrder.clear();
+	}
+	sGateCondition.notify_all();
+}
+
+} // anonymous namespace
+
+TEST_CASE( "ImageLoadQueue" )
+{
+
+SECTION( "many images are decoded concurrently" )
+{
+	auto queue = ImageLoadQueue::create( ImageLoadQueue::Options().numThreads( 4 ) );
+	REQUIRE( queue->getNumThreads() == 4 );
+
+	vector<DataSourceRef> dataSources;
+	for( int i = 0; i < 200; i++ )
+		dataSources.push_back( makeTestImage( uint8_t( i ), uint16_t( 1 + i ), 3 ) );
+
+	atomic<int> numCallbacks( 0 );
+	auto requests = queue->load( dataSources, 0, [&numCallbacks]( const ImageLoadRequestRef & ) { numCallbacks++; } );
+	REQUIRE( requests.size() == dataSources.size() );
+
+	uint64_t numPixels = 0;
+	for( int i = 0; i < 200; i++ ) {
+		auto surface = requests[i]->getSurface();
+		REQUIRE( surface->getWidth() == 1 + i );
+		REQUIRE( surface->getHeight() == 3 );
+		REQUIRE( surface->getPixel( ivec2( i, 2 ) ) == ColorA8u( uint8_t( i ), uint8_t( i ), uint8_t( i ), 255 ) );
+		REQUIRE( requests[i]->getState() == ImageLoadRequest::DONE );
+		numPixels += surface->getWidth() * surface->getHeight();
+	}
+
+	queue->waitAll();
+	REQUIRE( numCallbacks == 200 );
+
+	auto stats = queue->getDecodeStats();
+	REQUIRE( stats.size() == 1 );
+	REQUIRE( stats["citestimage"].mNumDecoded == 200 );
+	REQUIRE( stats["citestimage"].mNumFailed == 0 );
+	REQUIRE( stats["citestimage"].mNumPixels == numPixels );
+	REQUIRE( stats["citestimage"].mMaxSeconds <= stats["citestimage"].mTotalSeconds );
+
+	queue->resetDecodeStats();
+	REQUIRE( queue->getDecodeStats().empty() );
+}
+
+SECTION( "failures are delivered through the future" )
+{
+	auto queue = ImageLoadQueue::create( ImageLoadQueue::Options().numThreads( 2 ) );
+	auto request = queue->load( makeTestImage( 1, 16, 8, true ) );
+
+	REQUIRE_THROWS_AS( request->getSurface(), ImageIoExceptionFailedLoad );
+	REQUIRE( request->getState() == ImageLoadRequest::FAILED );
+	REQUIRE( queue->getDecodeStats()["citestimage"].mNumFailed == 1 );
+}
+
+SECTION( "priorities and cancellation" )
+{
+	auto queue = ImageLoadQueue::create( ImageLoadQueue::Options().numThreads( 1 ) );
+
+	// occupy the only worker, so that the following requests stay queued
+	setGateOpen( false );
+	auto blocker = queue->load( makeTestImage( 0, 16, 8, false, true ) );
+	while( blocker->getState() != ImageLoadRequest::DECODING )
+		this_thread::yield();
+
+	auto a = queue->load( makeTestImage( 1 ), 0 );
+	auto b = queue->load( makeTestImage( 2 ), 5 );
+	auto c = queue->load( makeTestImage( 3 ), 2 );
+	auto d = queue->load( makeTestImage( 4 ), 0 );
+	auto e = queue->load( makeTestImage( 5 ), 1 );
+	REQUIRE( queue->getNumQueued() == 5 );
+
+	d->setPriority( 10 );
+	REQUIRE( d->getPriority() == 10 );
+	REQUIRE( e->cancel() );
+	REQUIRE_FALSE( e->cancel() );
+	REQUIRE_FALSE( blocker->cancel() );
+	REQUIRE( queue->getNumQueued() == 4 );
+
+	{
+		lock_guard<mutex> lock( sMutex );
+		sGateOpen = true;
+	}
+	sGateCondition.notify_all();
+	queue->waitAll();
+
+	REQUIRE( sDecodeOrder == vector<uint8_t>( { 0, 4, 2, 3, 1 } ) );
+	REQUIRE( e->getState() == ImageLoadRequest::CANCELLED );
+	REQUIRE( e->isFinished() );
+	REQUIRE_THROWS_AS( e->getSurface(), ImageLoadExceptionCancelled );
+	REQUIRE( a->getSurface()->getPixel( ivec2( 0, 0 ) ) == ColorA8u( 1, 1, 1, 255 ) );
+
+	setGateOpen( true );
+}
+
+SECTION( "deferred callbacks wait for poll()" )
+{
+	auto queue = ImageLoadQueue::create( ImageLoadQueue::Options().numThreads( 2 ).deferCallbacks() );
+
+	int numCallbacks = 0;
+	for( int i = 0; i < 10; i++ )
+		queue->load( makeTestImage( uint8_t( i ) ), 0, [&numCallbacks]( const ImageLoadRequestRef &request ) {
+			REQUIRE( request->getState() == ImageLoadRequest::DONE );
+			numCallbacks++;
+		} );
+
+	queue->waitAll();
+	REQUIRE( numCallbacks == 0 );
+	queue->poll();
+	REQUIRE( numCallbacks == 10 );
+}
+
+SECTION( "throwing callbacks don't stop the others" )
+{
+	for( bool defer : { false, true } ) {
+		auto queue = ImageLoadQueue::create( ImageLoadQueue::Options().numThreads( 1 ).deferCallbacks( defer ) );
+
+		atomic<int> numCallbacks( 0 );
+		for( int i = 0; i < 6; i++ ) {
+			queue->load( makeTestImage( uint8_t( i ) ), 0, [&numCallbacks, i]( const ImageLoadRequestRef & ) {
+				numCallbacks++;
+				if( i % 3 == 1 )
+					throw ImageIoExceptionFailedLoad( "test callback failure" );
+				else if( i % 3 == 2 )
+					throw i;
+			} );
+		}
+
+		queue->waitAll();
+		if( defer )
+			queue->poll();
+		REQUIRE( numCallbacks == 6 );
+	}
+}
+
+SECTION( "loadImagesAsync" )
+{
+	auto futures = loadImagesAsync( vector<DataSourceRef>( { makeTestImage( 7, 4, 4 ), makeTestImage( 9, 5, 2 ) } ) );
+	REQUIRE( futures.size() == 2 );
+	REQUIRE( futures[0].get()->getPixel( ivec2( 3, 3 ) ) == ColorA8u( 7, 7, 7, 255 ) );
+	REQUIRE( futures[1].get()->getSize() == ivec2( 5, 2 ) );
+}
+
+} // "ImageLoadQueue"
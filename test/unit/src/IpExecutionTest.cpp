@@ -0,0 +1,243 @@
+#include "cinder/ip/Execution.h"
+#include "cinder/ip/Blend.h"
+#include "cinder/ip/Blur.h"
+#include "cinder/ip/Checkerboard.h"
+#include "cinder/ip/EdgeDetect.h"
+#include "cinder/ip/Fill.h"
+#include "cinder/ip/Flip.h"
+#include "cinder/ip/Grayscale.h"
+#include "cinder/ip/Hdr.h"
+#include "cinder/ip/Premultiply.h"
+#include "cinder/ip/Threshold.h"
+#include "cinder/Rand.h"
+
+#include "catch.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+using namespace ci;
+using namespace std;
+
+namespace {
+
+// Many small tasks on more threads than most test machines have, so that band edges land all over the image.
+ip::ExecutionPolicy getParallelPolicy()
+{
+	return ip::ExecutionPolicy().maxThreads( 4 ).minPixelsPerTask( 256 );
+}
+
+template<typename T>
+T randomValue( Rand &rand )
+{
+	return T( rand.nextInt( 256 ) );
+}
+
+template<>
+float randomValue<float>( Rand &rand )
+{
+	return rand.nextFloat() * 4.0f - 1.0f;
+}
+
+template<typename T>
+SurfaceT<T> makeRandomSurface( int32_t width, int32_t height, SurfaceChannelOrder channelOrder )
+{
+	Rand rand( width * 7919 + height );
+	SurfaceT<T> result( width, height, channelOrder.hasAlpha(), channelOrder );
+	for( int32_t y = 0; y < height; y++ ) {
+		T *row = result.getData( ivec2( 0, y ) );
+		for( int32_t x = 0; x < width * result.getPixelInc(); x++ )
+			row[x] = randomValue<T>( rand );
+	}
+
+	return result;
+}
+
+template<typename T>
+ChannelT<T> makeRandomChannel( int32_t width, int32_t height )
+{
+	Rand rand( width * 104729 + height );
+	ChannelT<T> result( width, height );
+	for( int32_t y = 0; y < height; y++ ) {
+		for( int32_t x = 0; x < width; x++ )
+			result.setValue( ivec2( x, y ), randomValue<T>( rand ) );
+	}
+
+	return result;
+}
+
+template<typename T>
+bool isEqual( const SurfaceT<T> &a, const SurfaceT<T> &b )
+{
+	for( int32_t y = 0; y < a.getHeight(); y++ ) {
+		if( memcmp( a.getData( ivec2( 0, y ) ), b.getData( ivec2( 0, y ) ), a.getWidth() * a.getPixelInc() * sizeof(T) ) != 0 )
+			return false;
+	}
+
+	return true;
+}
+
+template<typename T>
+bool isEqual( const ChannelT<T> &a, const ChannelT<T> &b )
+{
+	for( int32_t y = 0; y < a.getHeight(); y++ ) {
+		for( int32_t x = 0; x < a.getWidth(); x++ ) {
+			if( a.getValue( ivec2( x, y ) ) != b.getValue( ivec2( x, y ) ) )
+				return false;
+		}
+	}
+
+	return true;
+}
+
+// Runs \a fn on two copies of \a image, sequentially and split across threads, and requires identical results.
+template<typename ImageT, typename FnT>
+void requireSameResult( const ImageT &image, const FnT &fn )
+{
+	ImageT sequential = image.clone(), parallel = image.clone();
+	{
+		ip::ScopedExecutionPolicy scopedPolicy( ip::ExecutionPolicy::sequential() );
+		fn( &sequential );
+	}
+	{
+		ip::ScopedExecutionPolicy scopedPolicy( getParallelPolicy() );
+		fn( &parallel );
+	}
+
+	REQUIRE( isEqual( sequential, parallel ) );
+}
+
+} // anonymous namespace
+
+TEST_CASE( "ip/Execution" )
+{
+
+SECTION( "parallelFor covers the range exactly once" )
+{
+	ip::ScopedExecutionPolicy scopedPolicy( getParallelPolicy() );
+
+	for( int32_t numItems : { 0, 1, 7, 100, 1001 } ) {
+		for( int32_t minItemsPerTask : { 1, 3, 64 } ) {
+			vector<int> counts( numItems, 0 );
+			mutex countsMutex;
+			ip::parallelFor( 5, 5 + numItems, minItemsPerTask, [&]( int32_t begin, int32_t end ) {
+				lock_guard<mutex> lock( countsMutex );
+				REQUIRE( begin < end );
+				REQUIRE( ( end - begin >= minItemsPerTask || end == 5 + numItems ) );
+				for( int32_t i = begin; i < end; i++ )
+					counts[i - 5]++;
+			} );
+
+			for( int count : counts )
+				REQUIRE( count == 1 );
+		}
+	}
+}
+
+SECTION( "parallelForRows bands tile the area" )
+{
+	ip::ScopedExecutionPolicy scopedPolicy( getParallelPolicy() );
+
+	const Area area( 3, 10, 50, 500 );
+	vector<int> rows( area.y2, 0 );
+	mutex rowsMutex;
+	ip::parallelForRows( area, [&]( const Area &band ) {
+		lock_guard<mutex> lock( rowsMutex );
+		REQUIRE( band.x1 == area.x1 );
+		REQUIRE( band.x2 == area.x2 );
+		// bands are at least 4 times as tall as the halo, other than the last one
+		REQUIRE( ( band.getHeight() >= 20 || band.y2 == area.y2 ) );
+		for( int32_t y = band.y1; y < band.y2; y++ )
+			rows[y]++;
+	}, 5 );
+
+	for( int32_t y = 0; y < area.y2; y++ )
+		REQUIRE( rows[y] == ( y >= area.y1 ? 1 : 0 ) );
+}
+
+SECTION( "nested calls and exceptions" )
+{
+	ip::ScopedExecutionPolicy scopedPolicy( getParallelPolicy() );
+
+	std::atomic<int> total( 0 );
+	ip::parallelFor( 0, 16, 1, [&]( int32_t begin, int32_t end ) {
+		for( int32_t i = begin; i < end; i++ ) {
+			ip::parallelFor( 0, 100, 1, [&]( int32_t innerBegin, int32_t innerEnd ) {
+				total += innerEnd - innerBegin;
+			} );
+		}
+	} );
+	REQUIRE( total == 1600 );
+
+	REQUIRE_THROWS_AS( ip::parallelFor( 0, 100, 1, [&]( int32_t begin, int32_t end ) {
+		if( begin <= 50 && 50 < end )
+			throw std::runtime_error( "band failed" );
+	} ), std::runtime_error );
+}
+
+SECTION( "scoped policies nest and restore" )
+{
+	const size_t defaultThreads = ip::getDefaultExecutionPolicy().getMaxThreads();
+	{
+		ip::ScopedExecutionPolicy outer( ip::ExecutionPolicy().maxThreads( 3 ) );
+		REQUIRE( ip::getExecutionPolicy().getMaxThreads() == 3 );
+		{
+			ip::ScopedExecutionPolicy inner( ip::ExecutionPolicy::sequential() );
+			REQUIRE( ip::getExecutionPolicy().getNumThreads() == 1 );
+		}
+		REQUIRE( ip::getExecutionPolicy().getMaxThreads() == 3 );
+	}
+	REQUIRE( ip::getExecutionPolicy().getMaxThreads() == defaultThreads );
+}
+
+SECTION( "routines give the same results split across threads" )
+{
+	const auto rgba8u = makeRandomSurface<uint8_t>( 203, 157, SurfaceChannelOrder::RGBA );
+	const auto bgr8u = makeRandomSurface<uint8_t>( 203, 157, SurfaceChannelOrder::BGR );
+	const auto rgba16u = makeRandomSurface<uint16_t>( 203, 157, SurfaceChannelOrder::RGBA );
+	const auto argb32f = makeRandomSurface<float>( 203, 157, SurfaceChannelOrder::ARGB );
+	const auto channel8u = makeRandomChannel<uint8_t>( 203, 157 );
+	const auto channel32f = makeRandomChannel<float>( 203, 157 );
+	const auto foreground8u = makeRandomSurface<uint8_t>( 120, 90, SurfaceChannelOrder::RGBA );
+	const auto foreground32f = makeRandomSurface<float>( 120, 90, SurfaceChannelOrder::RGBA );
+
+	requireSameResult( rgba8u, []( Surface8u *s ) { ip::fill( s, ColorA8u( 1, 2, 3, 4 ), Area( 10, 20, 150, 140 ) ); } );
+	requireSameResult( bgr8u, []( Surface8u *s ) { ip::fill( s, Color8u( 1, 2, 3 ) ); } );
+	requireSameResult( channel32f, []( Channel32f *c ) { ip::fill( c, 0.5f, Area( 5, 5, 100, 150 ) ); } );
+	requireSameResult( rgba8u, []( Surface8u *s ) { ip::checkerboard( s, Area( 3, 7, 200, 150 ), 9, ColorA8u( 255, 0, 0, 255 ), ColorA8u( 0, 0, 255, 128 ) ); } );
+
+	requireSameResult( rgba8u, [&]( Surface8u *s ) { ip::blend( s, foreground8u, foreground8u.getBounds(), ivec2( 50, 40 ) ); } );
+	requireSameResult( argb32f, [&]( Surface32f *s ) { ip::blend( s, foreground32f, foreground32f.getBounds(), ivec2( -20, 90 ) ); } );
+
+	requireSameResult( bgr8u, []( Surface8u *s ) { ip::threshold( s, (uint8_t)100 ); } );
+	requireSameResult( channel8u, [&]( Channel8u *c ) { ip::threshold( channel8u, (uint8_t)100, c ); } );
+	requireSameResult( channel8u, []( Channel8u *c ) { ip::adaptiveThreshold( c, 15, 0.1f ); } );
+	requireSameResult( channel8u, []( Channel8u *c ) { ip::adaptiveThresholdZero( c, 15 ); } );
+
+	requireSameResult( rgba8u, [&]( Surface8u *s ) { ip::grayscale( bgr8u, s ); } );
+	requireSameResult( channel8u, [&]( Channel8u *c ) { ip::grayscale( rgba8u, c ); } );
+
+	requireSameResult( rgba8u, []( Surface8u *s ) { ip::premultiply( s ); } );
+	requireSameResult( rgba16u, []( Surface16u *s ) { ip::premultiply( s ); } );
+	requireSameResult( rgba8u, []( Surface8u *s ) { ip::unpremultiply( s ); } );
+
+	requireSameResult( rgba8u, []( Surface8u *s ) { ip::flipVertical( s ); } );
+	requireSameResult( rgba8u, [&]( Surface8u *s ) { ip::flipVertical( bgr8u, s ); } );
+	requireSameResult( channel8u, [&]( Channel8u *c ) { ip::flipVertical( channel8u, c ); } );
+	requireSameResult( argb32f, []( Surface32f *s ) { ip::flipHorizontal( s ); } );
+
+	requireSameResult( bgr8u, [&]( Surface8u *s ) { ip::edgeDetectSobel( rgba8u, s ); } );
+	requireSameResult( channel32f, [&]( Channel32f *c ) { ip::edgeDetectSobel( channel32f, c ); } );
+
+	requireSameResult( rgba8u, []( Surface8u *s ) { ip::stackBlur( s, 7 ); } );
+	requireSameResult( rgba16u, []( Surface16u *s ) { ip::stackBlur( s, Area( 20, 10, 180, 150 ), 3 ); } );
+	requireSameResult( channel32f, []( Channel32f *c ) { ip::stackBlur( c, 12 ); } );
+
+	requireSameResult( argb32f, []( Surface32f *s ) { ip::hdrNormalize( s ); } );
+	requireSameResult( channel32f, []( Channel32f *c ) { ip::hdrNormalize( c ); } );
+}
+
+} // "ip/Execution"
@@ -0,0 +1,177 @@
+#include "cinder/KdTree.h"
+#include "cinder/Rand.h"
+
+#include "catch.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+using namespace ci;
+using namespace std;
+
+namespace {
+
+vector<vec3> makeRandomPoints( size_t count, uint32_t seed )
+{
+	Rand rand( seed );
+	vector<vec3> result;
+	for( size_t i = 0; i < count; i++ )
+		result.push_back( rand.nextVec3() * rand.nextFloat( 10 ) );
+
+	// a few duplicates, which must all be found
+	for( size_t i = 0; i < count / 50; i++ )
+		result.push_back( result[rand.nextUint( (uint32_t)count )] );
+
+	return result;
+}
+
+// the indices of the points within radius of p, or the k nearest ones, sorted by distance and then index
+vector<pair<float, uint32_t>> bruteForce( const vector<vec3> &points, const vec3 &p, float radius, size_t k )
+{
+	vector<pair<float, uint32_t>> result;
+	for( uint32_t i = 0; i < points.size(); i++ ) {
+		const float distSqr = glm::distance2( points[i], p );
+		if( distSqr <= radius * radius )
+			result.push_back( { distSqr, i } );
+	}
+	sort( result.begin(), result.end() );
+	if( result.size() > k )
+		result.resize( k );
+
+	return result;
+}
+
+void requireMatchesBruteForce( const KdTree<vec3> &tree, const vector<vec3> &points, const vector<vec3> &queries )
+{
+	for( const auto &p : queries ) {
+		// k nearest; ties at the k-th distance may pick any of the tied points, so only distances are compared
+		const uint32_t k = 7;
+		uint32_t indices[k];
+		float distances[k];
+		auto expected = bruteForce( points, p, FLT_MAX, k );
+		REQUIRE( tree.findKNearest( p, k, indices, distances ) == k );
+		for( uint32_t i = 0; i < k; i++ ) {
+			REQUIRE( distances[i] == expected[i].first );
+			REQUIRE( glm::distance2( points[indices[i]], p ) == distances[i] );
+		}
+
+		// within a radius
+		const float radius = 1.5f;
+		vector<uint32_t> found( points.size() );
+		uint32_t count = tree.findWithinRadius( p, radius, found.data(), nullptr, (uint32_t)found.size() );
+		found.resize( count );
+		sort( found.begin(), found.end() );
+		expected = bruteForce( points, p, radius, points.size() );
+		vector<uint32_t> expectedIndices;
+		for( const auto &e : expected )
+			expectedIndices.push_back( e.second );
+		sort( expectedIndices.begin(), expectedIndices.end() );
+		REQUIRE( found == expectedIndices );
+
+		// nearest
+		float pt[3] = { p.x, p.y, p.z }, result[3];
+		uint32_t index;
+		tree.findNearest( pt, result, &index );
+		REQUIRE( glm::distance2( points[index], p ) == expected.front().first );
+		REQUIRE( vec3( result[0], result[1], result[2] ) == points[index] );
+	}
+}
+
+// claims to hold more points than a KdTree can, without storing them
+struct TooManyPoints {
+	size_t	size() const						{ return 1u << 29; }
+	vec3	operator[]( size_t /*i*/ ) const	{ return vec3( 0 ); }
+};
+
+} // anonymous namespace
+
+TEST_CASE( "KdTree" )
+{
+	auto points = makeRandomPoints( 20000, 1 );
+	auto queries = makeRandomPoints( 100, 2 );
+
+SECTION( "queries match brute force" )
+{
+	KdTree<vec3> tree( points );
+	REQUIRE( tree.getNumNodes() == points.size() );
+	requireMatchesBruteForce( tree, points, queries );
+
+	// limits on the number of results and the distance
+	uint32_t indices[4];
+	float distances[4];
+	REQUIRE( tree.findWithinRadius( queries[0], 5, indices, distances, 4 ) > 4 );
+	REQUIRE( tree.findKNearest( queries[0], 4, indices, distances, 0.0001f ) == 0 );
+	REQUIRE( tree.findKNearest( points[10], 1, indices, distances, 0.0001f ) == 1 );
+	REQUIRE( distances[0] == 0 );
+}
+
+SECTION( "parallel construction and batch queries" )
+{
+	KdTree<vec3> single( points, 1 );
+	KdTree<vec3> tree( points, 4 );
+	requireMatchesBruteForce( tree, points, queries );
+
+	const uint32_t k = 5;
+	vector<uint32_t> indices( queries.size() * k ), counts( queries.size() );
+	vector<float> distances( queries.size() * k );
+	tree.findKNearest( queries, k, indices.data(), distances.data(), counts.data() );
+	for( size_t i = 0; i < queries.size(); i++ ) {
+		uint32_t singleIndices[k];
+		float singleDistances[k];
+		REQUIRE( counts[i] == single.findKNearest( queries[i], k, singleIndices, singleDistances ) );
+		REQUIRE( equal( singleDistances, singleDistances + k, distances.begin() + i * k ) );
+	}
+
+	const uint32_t maxResults = 16;
+	indices.resize( queries.size() * maxResults );
+	tree.findWithinRadius( queries, 1, indices.data(), nullptr, maxResults, counts.data() );
+	for( size_t i = 0; i < queries.size(); i++ )
+		REQUIRE( counts[i] == bruteForce( points, queries[i], 1, points.size() ).size() );
+}
+
+SECTION( "refit after the points have moved" )
+{
+	KdTree<vec3> tree( points, 4 );
+
+	Rand rand( 3 );
+	for( int frame = 0; frame < 3; frame++ ) {
+		for( auto &p : points )
+			p += rand.nextVec3() * 0.5f;
+		tree.refit( points );
+		requireMatchesBruteForce( tree, points, queries );
+	}
+}
+
+SECTION( "empty and tiny trees" )
+{
+	KdTree<vec2, 2> empty{ vector<vec2>() };
+	uint32_t index;
+	float distance;
+	float pt[2] = { 0, 0 }, result[2];
+	empty.findNearest( pt, result, &index );
+	REQUIRE( index == uint32_t( -1 ) );
+	REQUIRE( empty.findKNearest( vec2( 0 ), 1, &index, &distance ) == 0 );
+	REQUIRE( empty.findWithinRadius( vec2( 0 ), 1, &index, &distance, 1 ) == 0 );
+
+	KdTree<vec2, 2> one( vector<vec2>( 1, vec2( 1, 2 ) ) );
+	REQUIRE( one.findKNearest( vec2( 0 ), 1, &index, &distance ) == 1 );
+	REQUIRE( index == 0 );
+	REQUIRE( distance == 5 );
+
+	// no point is nearest to a NaN or infinite query point
+	float nanPt[2] = { numeric_limits<float>::quiet_NaN(), 0 }, infPt[2] = { numeric_limits<float>::infinity(), 0 };
+	one.findNearest( nanPt, result, &index );
+	REQUIRE( index == uint32_t( -1 ) );
+	one.findNearest( infPt, result, &index );
+	REQUIRE( index == uint32_t( -1 ) );
+}
+
+SECTION( "too many points" )
+{
+	KdTree<vec3> tree;
+	REQUIRE_THROWS_AS( tree.initialize( TooManyPoints() ), KdTreeExc );
+	REQUIRE( tree.getNumNodes() == 0 );
+}
+
+}
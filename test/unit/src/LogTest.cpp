@@ -0,0 +1,258 @@
+#include "cinder/Log.h"
+
+#include "catch.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace ci;
+using namespace std;
+
+namespace {
+
+// Records every entry along with the thread that wrote it. Writes can be held back by closing the gate.
+class TestLogger : public log::Logger {
+  public:
+	struct Record {
+		log::Level							mLevel;
+		string								mText;
+		thread::id							mThreadId;
+		chrono::system_clock::time_point	mTime;
+	};
+
+	TestLogger() : log::Logger( log::LEVEL_VERBOSE ), mGateOpen( true ), mNumWaiting( 0 ), mNumFlushes( 0 ) {}
+
+	void write( const log::Metadata &meta, const string &text ) override
+	{
+		if( mOnWrite )
+			mOnWrite( text );
+
+		unique_lock<mutex> lock( mMutex );
+		mNumWaiting++;
+		mGateCondition.wait( lock, [this] { return mGateOpen; } );
+		mNumWaiting--;
+		mRecords.push_back( { meta.mLevel, text, this_thread::get_id(), meta.mTime } );
+	}
+
+	void flush() override
+	{
+		lock_guard<mutex> lock( mMutex );
+		mNumFlushes++;
+	}
+
+	void setGateOpen( bool open )
+	{
+		{
+			lock_guard<mutex> lock( mMutex );
+			mGateOpen = open;
+		}
+		mGateCondition.notify_all();
+	}
+
+	vector<Record> getRecords()
+	{
+		lock_guard<mutex> lock( mMutex );
+		return mRecords;
+	}
+
+	mutex					mMutex;
+	condition_variable		mGateCondition;
+	bool					mGateOpen;
+	atomic<int>				mNumWaiting;
+	int						mNumFlushes;
+	vector<Record>			mRecords;
+	//! Called before each entry is recorded, outside of mMutex
+	function<void( const string &text )>	mOnWrite;
+};
+
+} // anonymous namespace
+
+TEST_CASE( "Log" )
+{
+	auto manager = log::manager();
+	auto logger = make_shared<TestLogger>();
+	manager->resetLogger( logger );
+
+SECTION( "entries from many threads are written in batches by the writer thread" )
+{
+	manager->enableAsync( log::LogManager::AsyncOptions().bufferSize( 16 ) );
+	REQUIRE( manager->isAsyncEnabled() );
+
+	const int numThreads = 4, numEntries = 2000;
+	vector<thread> threads;
+	for( int t = 0; t < numThreads; t++ ) {
+		threads.emplace_back( [t] {
+			for( int i = 0; i < numEntries; i++ )
+				CINDER_LOG_STREAM( log::LEVEL_INFO, t << " " << i );
+		} );
+	}
+	vector<thread::id> threadIds;
+	for( auto &thread : threads ) {
+		threadIds.push_back( thread.get_id() );
+		thread.join();
+	}
+
+	manager->flush();
+	auto records = logger->getRecords();
+	REQUIRE( records.size() == numThreads * numEntries );
+
+	// entries from each thread keep their order, and none are written on the logging threads
+	vector<int> next( numThreads, 0 );
+	for( const auto &record : records ) {
+		int t, i;
+		istringstream( record.mText ) >> t >> i;
+		REQUIRE( i == next[t]++ );
+		for( const auto &id : threadIds )
+			REQUIRE( record.mThreadId != id );
+	}
+	REQUIRE( logger->mNumFlushes > 0 );
+}
+
+SECTION( "entries at the sync level are written by the caller, in order" )
+{
+	manager->enableAsync( log::LogManager::AsyncOptions().flushInterval( 60 ).syncLevel( log::LEVEL_WARNING ) );
+
+	CINDER_LOG_STREAM( log::LEVEL_INFO, "a" );
+	CINDER_LOG_STREAM( log::LEVEL_WARNING, "b" );
+
+	auto records = logger->getRecords();
+	REQUIRE( records.size() == 2 );
+	REQUIRE( records[0].mText == "a" );
+	REQUIRE( records[1].mText == "b" );
+	REQUIRE( records[1].mThreadId == this_thread::get_id() );
+}
+
+SECTION( "full buffers drop entries with Overflow::DROP" )
+{
+	manager->enableAsync( log::LogManager::AsyncOptions().bufferSize( 8 ).overflow( log::LogManager::AsyncOptions::Overflow::DROP ).flushInterval( 0.001 ) );
+	const uint64_t numDropped = manager->getNumDropped();
+
+	// hold the writer thread inside the logger, so that nothing is drained while the buffer fills up
+	logger->setGateOpen( false );
+	CINDER_LOG_STREAM( log::LEVEL_INFO, "first" );
+	while( logger->mNumWaiting == 0 )
+		this_thread::sleep_for( chrono::milliseconds( 1 ) );
+
+	for( int i = 0; i < 100; i++ )
+		CINDER_LOG_STREAM( log::LEVEL_INFO, i );
+	REQUIRE( manager->getNumDropped() - numDropped == 92 );
+
+	logger->setGateOpen( true );
+	manager->flush();
+
+	auto records = logger->getRecords();
+	REQUIRE( records.size() == 1 + 8 + 1 );
+	REQUIRE( records[0].mText == "first" );
+	REQUIRE( records[8].mText == "7" );
+	REQUIRE( records[9].mLevel == log::LEVEL_WARNING );
+	REQUIRE( records[9].mText.find( "92" ) != string::npos );
+}
+
+SECTION( "full buffers block with Overflow::BLOCK" )
+{
+	manager->enableAsync( log::LogManager::AsyncOptions().bufferSize( 2 ).flushInterval( 60 ) );
+	const uint64_t numDropped = manager->getNumDropped();
+
+	for( int i = 0; i < 1000; i++ )
+		CINDER_LOG_STREAM( log::LEVEL_INFO, i );
+	manager->flush();
+
+	auto records = logger->getRecords();
+	REQUIRE( records.size() == 1000 );
+	REQUIRE( records[999].mText == "999" );
+	REQUIRE( manager->getNumDropped() == numDropped );
+}
+
+SECTION( "entries keep the time they were logged at" )
+{
+	manager->enableAsync( log::LogManager::AsyncOptions().flushInterval( 60 ) );
+	const auto before = chrono::system_clock::now();
+	CINDER_LOG_STREAM( log::LEVEL_INFO, "queued" );
+	const auto after = chrono::system_clock::now();
+	manager->flush();
+
+	auto records = logger->getRecords();
+	REQUIRE( records.size() == 1 );
+	REQUIRE( records[0].mTime >= before );
+	REQUIRE( records[0].mTime <= after );
+}
+
+SECTION( "Loggers can log while a batch is written" )
+{
+	// waiting for room in the buffer would deadlock, so entries logged by the Logger beyond its capacity are dropped
+	manager->enableAsync( log::LogManager::AsyncOptions().bufferSize( 4 ).flushInterval( 60 ) );
+	const uint64_t numDropped = manager->getNumDropped();
+	logger->mOnWrite = []( const string &text ) {
+		if( text == "outer" ) {
+			for( int i = 0; i < 10; i++ )
+				CINDER_LOG_STREAM( i % 2 ? log::LEVEL_ERROR : log::LEVEL_INFO, "inner " << i );
+			log::manager()->flush();
+		}
+	};
+
+	CINDER_LOG_STREAM( log::LEVEL_INFO, "outer" );
+	manager->flush();
+	manager->flush();
+	logger->mOnWrite = nullptr;
+
+	auto records = logger->getRecords();
+	REQUIRE( records.size() == 6 );
+	REQUIRE( records[0].mText == "outer" );
+	REQUIRE( records[1].mText == "inner 0" );
+	REQUIRE( records[4].mText == "inner 3" );
+	REQUIRE( records[4].mLevel == log::LEVEL_ERROR );
+	REQUIRE( records[5].mLevel == log::LEVEL_WARNING );
+	REQUIRE( manager->getNumDropped() == numDropped + 6 );
+}
+
+SECTION( "disableAsync() writes pending entries and returns to synchronous logging" )
+{
+	manager->enableAsync( log::LogManager::AsyncOptions().flushInterval( 60 ) );
+	CINDER_LOG_STREAM( log::LEVEL_INFO, "queued" );
+	manager->disableAsync();
+	REQUIRE_FALSE( manager->isAsyncEnabled() );
+
+	CINDER_LOG_STREAM( log::LEVEL_INFO, "sync" );
+	auto records = logger->getRecords();
+	REQUIRE( records.size() == 2 );
+	REQUIRE( records[0].mText == "queued" );
+	REQUIRE( records[1].mThreadId == this_thread::get_id() );
+
+	// re-enabling with other options
+	manager->enableAsync( log::LogManager::AsyncOptions().bufferSize( 4 ) );
+	CINDER_LOG_STREAM( log::LEVEL_INFO, "again" );
+	manager->flush();
+	REQUIRE( logger->getRecords().back().mText == "again" );
+}
+
+SECTION( "LoggerFile writes batches" )
+{
+	fs::path path = fs::temp_directory_path() / "cinder_LogTest" / "async.log";
+	fs::remove_all( path.parent_path() );
+	manager->resetLogger( make_shared<log::LoggerFile>( path, false ) );
+	manager->enableAsync();
+
+	for( int i = 0; i < 500; i++ )
+		CINDER_LOG_STREAM( log::LEVEL_INFO, "line " << i );
+	manager->flush();
+
+	ifstream stream( path.string() );
+	vector<string> lines;
+	for( string line; getline( stream, line ); )
+		lines.push_back( line );
+	REQUIRE( lines.size() == 500 );
+	REQUIRE( lines.back().find( "line 499" ) != string::npos );
+
+	manager->disableAsync();
+	manager->clearLoggers();
+	fs::remove_all( path.parent_path() );
+}
+
+	manager->disableAsync();
+	manager->restoreToDefault();
+}
@@ -0,0 +1,165 @@
+#include "cinder/MeshFile.h"
+#include "cinder/ObjLoader.h"
+#include "cinder/TriMesh.h"
+
+#include "catch.hpp"
+
+#include <cstring>
+#include <functional>
+
+using namespace ci;
+using namespace std;
+
+namespace {
+
+fs::path getTestPath( const string &name )
+{
+	fs::path result = fs::temp_directory_path() / "cinder_MeshFileTest";
+	fs::create_directories( result );
+	return result / name;
+}
+
+TriMesh makeMesh()
+{
+	return TriMesh( geom::Sphere().subdivisions( 40 ) >> geom::Translate( 1, 2, 3 ), TriMesh::Format().positions().normals().texCoords() );
+}
+
+float maxDistance( const vec3 *a, const vec3 *b, size_t count )
+{
+	float result = 0;
+	for( size_t i = 0; i < count; i++ )
+		result = std::max( result, distance( a[i], b[i] ) );
+	return result;
+}
+
+// Opens a copy of the file in \a buffer after \a modify has changed its header or data
+MeshFileRef createModified( const BufferRef &buffer, const function<void( MeshFileHeader *header, uint8_t *data )> &modify )
+{
+	auto copy = Buffer::create( buffer->getSize() );
+	memcpy( copy->getData(), buffer->getData(), buffer->getSize() );
+
+	MeshFileHeader header;
+	memcpy( &header, copy->getData(), sizeof( header ) );
+	modify( &header, static_cast<uint8_t*>( copy->getData() ) );
+	memcpy( copy->getData(), &header, sizeof( header ) );
+	return MeshFile::create( DataSourceBuffer::create( copy ) );
+}
+
+} // anonymous namespace
+
+TEST_CASE( "MeshFile" )
+{
+
+SECTION( "uncompressed attributes and indices are passed straight from the mapping" )
+{
+	const fs::path path = getTestPath( "float.cimesh" );
+	TriMesh mesh = makeMesh();
+	MeshFile::write( writeFile( path ), mesh );
+
+	auto file = MeshFile::create( loadFile( path ) );
+	REQUIRE( file->getNumVertices() == mesh.getNumVertices() );
+	REQUIRE( file->getNumIndices() == mesh.getNumIndices() );
+	REQUIRE( file->getAvailableAttribs() == mesh.getAvailableAttribs() );
+	REQUIRE( file->getAttribDims( geom::TEX_COORD_0 ) == 2 );
+	REQUIRE( file->getAttribDims( geom::COLOR ) == 0 );
+
+	REQUIRE( file->getHeader().mIndexOffset % MeshFileHeader::DATA_ALIGNMENT == 0 );
+	for( const auto &attrib : file->getAttribTable() )
+		REQUIRE( attrib.mOffset % MeshFileHeader::DATA_ALIGNMENT == 0 );
+
+	REQUIRE( memcmp( file->getIndexData(), mesh.getIndices().data(), mesh.getNumIndices() * sizeof( uint32_t ) ) == 0 );
+	REQUIRE( memcmp( file->getAttribData( geom::POSITION ), mesh.getPositions<3>(), mesh.getNumVertices() * sizeof( vec3 ) ) == 0 );
+
+	TriMesh loaded( *file );
+	REQUIRE( loaded.getIndices() == mesh.getIndices() );
+	REQUIRE( memcmp( loaded.getNormals().data(), mesh.getNormals().data(), mesh.getNumVertices() * sizeof( vec3 ) ) == 0 );
+	REQUIRE( memcmp( loaded.getTexCoords0<2>(), mesh.getTexCoords0<2>(), mesh.getNumVertices() * sizeof( vec2 ) ) == 0 );
+
+	// loading from a buffer rather than a file
+	TriMesh fromBuffer( *MeshFile::create( DataSourceBuffer::create( loadFile( path )->getBuffer() ) ) );
+	REQUIRE( fromBuffer.getIndices() == mesh.getIndices() );
+}
+
+SECTION( "quantized attributes and compressed indices" )
+{
+	const fs::path path = getTestPath( "quantized.cimesh" );
+	TriMesh mesh = makeMesh();
+	MeshFile::write( writeFile( path ), mesh, MeshFile::Options().quantizePositions().quantizeNormals().compressIndices() );
+
+	auto file = MeshFile::create( loadFile( path ) );
+	REQUIRE( file->getIndexData() == nullptr );
+	REQUIRE( file->getAttribData( geom::POSITION ) == nullptr );
+	REQUIRE( file->getAttribData( geom::TEX_COORD_0 ) != nullptr );
+	REQUIRE( fs::file_size( path ) < ( mesh.getNumVertices() * sizeof( float ) * ( 3 + 3 + 2 ) + mesh.getNumIndices() * sizeof( uint32_t ) ) / 2 );
+
+	TriMesh loaded( *file );
+	REQUIRE( loaded.getIndices() == mesh.getIndices() );
+
+	// the sphere has a radius of 1, so its extent is 2 along each axis
+	REQUIRE( maxDistance( loaded.getPositions<3>(), mesh.getPositions<3>(), mesh.getNumVertices() ) <= 2 / 131070.0f * 1.8f );
+
+	float maxAngle = 0;
+	for( size_t i = 0; i < mesh.getNumVertices(); i++ ) {
+		REQUIRE( length( loaded.getNormals()[i] ) == Approx( 1 ) );
+		const vec3 &a = loaded.getNormals()[i], &b = mesh.getNormals()[i];
+		maxAngle = std::max( maxAngle, atan2( length( cross( a, b ) ), dot( a, b ) ) );
+	}
+	REQUIRE( toDegrees( maxAngle ) < 0.005f );
+}
+
+SECTION( "converting from ObjLoader" )
+{
+	const fs::path objPath = getTestPath( "mesh.obj" );
+	writeObj( writeFile( objPath ), makeMesh() );
+	ObjLoader loader( loadFile( objPath ) );
+	TriMesh mesh( loader );
+
+	const fs::path path = getTestPath( "converted.cimesh" );
+	MeshFile::write( writeFile( path ), loader, MeshFile::Options().compressIndices() );
+	TriMesh loaded( *MeshFile::create( loadFile( path ) ) );
+	REQUIRE( loaded.getNumVertices() == mesh.getNumVertices() );
+	REQUIRE( loaded.getIndices() == mesh.getIndices() );
+	REQUIRE( loaded.getNormals() == mesh.getNormals() );
+}
+
+SECTION( "invalid files" )
+{
+	const fs::path path = getTestPath( "truncated.cimesh" );
+	MeshFile::write( writeFile( path ), makeMesh() );
+
+	auto buffer = loadFile( path )->getBuffer();
+	REQUIRE_THROWS_AS( MeshFile::create( DataSourceBuffer::create( Buffer::create( buffer->getData(), buffer->getSize() - 1 ) ) ), MeshFileExc );
+	REQUIRE_THROWS_AS( MeshFile::create( DataSourceBuffer::create( Buffer::create( buffer->getData(), 10 ) ) ), MeshFileExc );
+
+	// malformed headers and index data
+	REQUIRE( createModified( buffer, []( MeshFileHeader*, uint8_t* ) {} )->getNumIndices() == makeMesh().getNumIndices() );
+	REQUIRE_THROWS_AS( createModified( buffer, []( MeshFileHeader *header, uint8_t* ) {
+		// the size of the indices overflows to the size that is stored
+		header->mNumIndices += 3ull << 62;
+	} ), MeshFileExc );
+	REQUIRE_THROWS_AS( createModified( buffer, []( MeshFileHeader *header, uint8_t *data ) {
+		reinterpret_cast<uint32_t*>( data + header->mIndexOffset )[5] = static_cast<uint32_t>( header->mNumVertices );
+	} ), MeshFileExc );
+
+	const fs::path compressedPath = getTestPath( "compressed.cimesh" );
+	MeshFile::write( writeFile( compressedPath ), makeMesh(), MeshFile::Options().compressIndices() );
+	auto compressed = loadFile( compressedPath )->getBuffer();
+	REQUIRE_THROWS_AS( createModified( compressed, []( MeshFileHeader *header, uint8_t* ) {
+		header->mNumIndices = 3ull << 60;
+	} ), MeshFileExc );
+	REQUIRE_THROWS_AS( createModified( compressed, []( MeshFileHeader *header, uint8_t* ) {
+		header->mNumIndices = header->mIndexBytes / 3 * 3 + 3;
+	} ), MeshFileExc );
+
+	MeshFileHeader header;
+	memcpy( &header, buffer->getData(), sizeof( header ) );
+	header.mVersion = MeshFileHeader::VERSION + 1;
+	memcpy( buffer->getData(), &header, sizeof( header ) );
+	REQUIRE_THROWS_AS( MeshFile::create( DataSourceBuffer::create( buffer ) ), MeshFileExc );
+	static_cast<uint8_t*>( buffer->getData() )[0] = 'X';
+	REQUIRE_THROWS_AS( MeshFile::create( DataSourceBuffer::create( buffer ) ), MeshFileExc );
+	REQUIRE_THROWS_AS( MeshFile::create( loadFile( getTestPath( "missing.cimesh" ) ) ), Exception );
+}
+
+	fs::remove_all( getTestPath( "" ).parent_path() );
+}
@@ -3,6 +3,7 @@
 #include "cinder/Shape2d.h"
 #include "cinder/CinderMath.h"
 #include "cinder/Rand.h"
+#include "cinder/ip/Execution.h"
 
 #include "catch.hpp"
 
@@ -2453,3 +2454,284 @@ TEST_CASE("Output validity - no NaN/Infinity in results")
 		}
 	}
 }
+
+TEST_CASE("Path2dQueryCache")
+{
+	// lines, quadratics and cubics, a hole, a self-intersecting contour and a contour far away from the others
+	Shape2d shape;
+	shape.appendContour( Path2d::star( vec2( 200, 200 ), 13, 150, 60, 0.3f ) );
+	shape.appendContour( Path2d::circle( vec2( 200, 200 ), 40 ) );
+	shape.appendContour( Path2d::roundedRectangle( Rectf( 150, 250, 450, 420 ), 30 ) );
+	shape.moveTo( 300, 50 );
+	shape.quadTo( 500, 0, 420, 150 );
+	shape.quadTo( 260, 260, 380, 40 );
+	shape.curveTo( 600, 300, 250, 400, 520, 110 );
+	shape.close();
+	shape.appendContour( Path2d::ellipse( vec2( 2000, 2000 ), 50, 20 ) );
+
+	Rand rand( 21 );
+	vector<vec2> points;
+	for( int i = 0; i < 4000; ++i )
+		points.push_back( vec2( rand.nextFloat( -50, 650 ), rand.nextFloat( -50, 500 ) ) );
+	// points on vertices and edges, where the on-curve rules apply
+	for( const auto &contour : shape.getContours() ) {
+		for( size_t p = 0; p < contour.getNumPoints(); ++p ) {
+			points.push_back( contour.getPoint( p ) );
+			points.push_back( vec2( contour.getPoint( p ).x, 200 ) );
+		}
+	}
+	points.push_back( vec2( 200, 250 ) );
+	points.push_back( vec2( 300, 250 ) );
+
+	SECTION("Results match Shape2d")
+	{
+		Path2dQueryCache cache( shape );
+		REQUIRE( cache.getBounds().getUpperLeft() == shape.calcBoundingBox().getUpperLeft() );
+		REQUIRE( cache.getBounds().getLowerRight() == shape.calcBoundingBox().getLowerRight() );
+
+		for( const auto &pt : points ) {
+			REQUIRE( cache.contains( pt ) == shape.contains( pt ) );
+			REQUIRE( cache.contains( pt, false ) == shape.contains( pt, false ) );
+			REQUIRE( cache.calcDistance( pt ) == shape.calcDistance( pt ) );
+			REQUIRE( cache.calcSignedDistance( pt, false ) == shape.calcSignedDistance( pt, false ) );
+			REQUIRE( cache.calcClosestPoint( pt ) == shape.calcClosestPoint( pt ) );
+		}
+
+		unique_ptr<bool[]> results( new bool[points.size()] );
+		cache.containsMany( points.data(), points.size(), results.get(), false );
+		for( size_t i = 0; i < points.size(); ++i )
+			REQUIRE( results[i] == shape.contains( points[i], false ) );
+	}
+
+	SECTION("Results match Path2d")
+	{
+		const Path2d &path = shape.getContours()[3];
+		Path2dQueryCache cache( path );
+		for( const auto &pt : points ) {
+			REQUIRE( cache.contains( pt ) == path.contains( pt ) );
+			REQUIRE( cache.contains( pt, false ) == path.contains( pt, false ) );
+			REQUIRE( cache.calcSignedDistance( pt ) == path.calcSignedDistance( pt ) );
+			REQUIRE( cache.calcClosestPoint( pt ) == path.calcClosestPoint( pt ) );
+		}
+
+		// open paths
+		Path2d open;
+		open.moveTo( 0, 0 );
+		open.curveTo( 100, 200, 200, -100, 300, 100 );
+		Path2dQueryCache openCache( open );
+		for( const auto &pt : points ) {
+			REQUIRE( openCache.contains( pt ) == open.contains( pt ) );
+			REQUIRE( openCache.calcDistance( pt ) == open.calcDistance( pt ) );
+		}
+	}
+
+	SECTION("Signed distance fields")
+	{
+		Path2dQueryCache cache( shape );
+		const Rectf bounds( -20, -10, 620, 470 );
+		Channel32f field( 96, 64 );
+		const vec2 pixelSize( bounds.getWidth() / 96, bounds.getHeight() / 64 );
+		for( size_t threads : { 1, 4 } ) {
+			ip::ScopedExecutionPolicy policy( ip::ExecutionPolicy().maxThreads( threads ) );
+			for( float maxDistance : { FLT_MAX, 12.0f } ) {
+				cache.calcSignedDistanceField( &field, bounds, maxDistance, false );
+				for( int32_t y = 0; y < field.getHeight(); ++y ) {
+					for( int32_t x = 0; x < field.getWidth(); ++x ) {
+						const vec2 pt( bounds.x1 + ( x + 0.5f ) * pixelSize.x, bounds.y1 + ( y + 0.5f ) * pixelSize.y );
+						const float expected = shape.calcSignedDistance( pt, false );
+						REQUIRE( field.getValue( ivec2( x, y ) ) == glm::clamp( expected, -maxDistance, maxDistance ) );
+					}
+				}
+			}
+		}
+	}
+
+	SECTION("Empty geometry")
+	{
+		Path2dQueryCache cache( Shape2d{} );
+		REQUIRE_FALSE( cache.contains( vec2( 0 ) ) );
+		REQUIRE( cache.calcDistance( vec2( 1, 2 ) ) == FLT_MAX );
+
+		Channel32f field( 4, 4 );
+		cache.calcSignedDistanceField( &field, Rectf( 0, 0, 1, 1 ), 5 );
+		REQUIRE( field.getValue( ivec2( 3, 3 ) ) == 5 );
+	}
+
+	SECTION("Shape2d::findIntersections skips distant contours")
+	{
+		Path2d line;
+		line.moveTo( -100, 200 );
+		line.lineTo( 700, 210 );
+
+		auto intersections = shape.findIntersections( line );
+		size_t expected = 0;
+		for( const auto &contour : shape.getContours() )
+			expected += contour.findIntersections( line ).size();
+		REQUIRE( intersections.size() == expected );
+		REQUIRE( line.findIntersections( shape ).size() == expected );
+	}
+}
+
+TEST_CASE("StrokeMesh2d")
+{
+	// open and closed contours with lines, quadratics, cubics, sharp corners and a cusp
+	Shape2d shape;
+	shape.appendContour( Path2d::star( vec2( 120, 120 ), 7, 90, 40, 0.2f ) );
+	shape.moveTo( 250, 40 );
+	shape.quadTo( 420, 0, 360, 120 );
+	shape.curveTo( 250, 260, 480, 30, 300, 200 );
+	shape.lineTo( 260, 120 );
+	shape.lineTo( 250, 200 );
+	shape.moveTo( 40, 260 );
+	shape.curveTo( 200, 360, 80, 360, 240, 260 );
+	shape.appendContour( Path2d::roundedRectangle( Rectf( 280, 230, 460, 330 ), 20 ) );
+
+	const float tolerance = 0.25f;
+	auto meshContains = []( const StrokeMesh2d &mesh, const vec2 &pt ) {
+		const auto &positions = mesh.getPositions();
+		const auto &indices = mesh.getIndices();
+		for( size_t i = 0; i < indices.size(); i += 3 ) {
+			const vec2 &a = positions[indices[i]], &b = positions[indices[i + 1]], &c = positions[indices[i + 2]];
+			const float d0 = cross2d( b - a, pt - a ), d1 = cross2d( c - b, pt - b ), d2 = cross2d( a - c, pt - c );
+			if( ( d0 >= 0 && d1 >= 0 && d2 >= 0 ) || ( d0 <= 0 && d1 <= 0 && d2 <= 0 ) )
+				return true;
+		}
+		return false;
+	};
+
+	SECTION("Triangles cover the same area as calcStroke()")
+	{
+		vector<StrokeStyle> styles = {
+			StrokeStyle( 12 ),
+			StrokeStyle( 9 ).join( Join::Miter ).caps( Cap::Butt ),
+			StrokeStyle( 9 ).join( Join::Miter ).miterLimit( 1.5f ).caps( Cap::Square ),
+			StrokeStyle( 20 ).join( Join::Bevel ).startCap( Cap::Square ).endCap( Cap::Round ),
+			StrokeStyle( 3 ).join( Join::Bevel ).caps( Cap::Butt )
+		};
+
+		for( const auto &style : styles ) {
+			StrokeMesh2d mesh;
+			mesh.appendStroke( shape, style, tolerance );
+			REQUIRE_FALSE( mesh.empty() );
+			for( uint32_t index : mesh.getIndices() )
+				REQUIRE( index < mesh.getNumVertices() );
+
+			// away from the outline, a point is covered by the triangles exactly when it's inside the exact stroke
+			const Shape2d exact = shape.calcStroke( style, tolerance );
+			Path2dQueryCache exactCache( exact );
+			for( float y = 0; y < 380; y += 1.5f ) {
+				for( float x = 0; x < 500; x += 1.5f ) {
+					const vec2 pt( x, y );
+					if( exactCache.calcDistance( pt ) > 3 * tolerance )
+						REQUIRE( meshContains( mesh, pt ) == exactCache.contains( pt, false ) );
+				}
+			}
+		}
+	}
+
+	SECTION("Dashes")
+	{
+		// dashes are measured along the flattened path, which only matches calcStroke() exactly for straight segments
+		Path2d polyline;
+		polyline.moveTo( 20, 20 );
+		polyline.lineTo( 300, 40 );
+		polyline.lineTo( 120, 200 );
+		polyline.lineTo( 330, 220 );
+		Path2d closed = Path2d::star( vec2( 200, 120 ), 5, 80, 30 );
+
+		const StrokeStyle style = StrokeStyle( 8 ).join( Join::Miter ).caps( Cap::Square ).dashes( 13, { 30, 12, 4, 12 } );
+		for( const Path2d *path : { &polyline, &closed } ) {
+			StrokeMesh2d mesh;
+			mesh.appendStroke( *path, style, tolerance );
+			Path2dQueryCache exactCache( path->calcStroke( style, tolerance ) );
+			for( float y = 0; y < 240; y += 1.0f ) {
+				for( float x = 0; x < 340; x += 1.0f ) {
+					const vec2 pt( x, y );
+					if( exactCache.calcDistance( pt ) > 3 * tolerance )
+						REQUIRE( meshContains( mesh, pt ) == exactCache.contains( pt, false ) );
+				}
+			}
+		}
+
+		// a reused mesh doesn't keep any of the previous dash pattern
+		StrokeMesh2d reused, fresh;
+		reused.appendStroke( polyline, style, tolerance );
+		reused.clear();
+		reused.appendStroke( closed, StrokeStyle( 8 ).dashes( 0, { 20, 10 } ), tolerance );
+		fresh.appendStroke( closed, StrokeStyle( 8 ).dashes( 0, { 20, 10 } ), tolerance );
+		REQUIRE( reused.getIndices() == fresh.getIndices() );
+		REQUIRE( reused.getPositions() == fresh.getPositions() );
+	}
+
+	SECTION("Single and double precision")
+	{
+		StrokeMesh2d singleMesh, doubleMesh;
+		singleMesh.setPrecision( StrokeMesh2d::Precision::FLOAT );
+		doubleMesh.setPrecision( StrokeMesh2d::Precision::DOUBLE );
+		singleMesh.appendStroke( shape, StrokeStyle( 6 ), tolerance );
+		doubleMesh.appendStroke( shape, StrokeStyle( 6 ), tolerance );
+
+		REQUIRE( singleMesh.getIndices() == doubleMesh.getIndices() );
+		for( size_t i = 0; i < singleMesh.getNumVertices(); ++i )
+			REQUIRE( distance( singleMesh.getPositions()[i], doubleMesh.getPositions()[i] ) < 0.001f );
+	}
+
+	SECTION("Buffers are reused")
+	{
+		StrokeMesh2d mesh;
+		mesh.appendStroke( shape, StrokeStyle( 5 ), tolerance );
+		const size_t numTriangles = mesh.getNumTriangles();
+		const vec2 *positions = mesh.getPositions().data();
+		const uint32_t *indices = mesh.getIndices().data();
+
+		mesh.clear();
+		REQUIRE( mesh.empty() );
+		mesh.appendStroke( shape, StrokeStyle( 5 ), tolerance );
+		REQUIRE( mesh.getNumTriangles() == numTriangles );
+		REQUIRE( mesh.getPositions().data() == positions );
+		REQUIRE( mesh.getIndices().data() == indices );
+
+		// strokes are appended
+		mesh.appendStroke( shape.getContours()[0], StrokeStyle( 5 ), tolerance );
+		REQUIRE( mesh.getNumTriangles() > numTriangles );
+	}
+
+	SECTION("calcStrokes() matches appendStroke() on any number of threads")
+	{
+		vector<Path2d> paths;
+		vector<StrokeStyle> styles;
+		Rand rand( 22 );
+		for( int i = 0; i < 200; ++i ) {
+			paths.push_back( shape.getContours()[i % shape.getNumContours()] );
+			paths.back().translate( vec2( rand.nextFloat( -100, 100 ), rand.nextFloat( -100, 100 ) ) );
+			styles.push_back( StrokeStyle( rand.nextFloat( 1, 10 ) ).join( ( i % 3 ) ? Join::Round : Join::Miter ) );
+		}
+
+		vector<StrokeMesh2d> expected( paths.size() );
+		for( size_t i = 0; i < paths.size(); ++i )
+			expected[i].appendStroke( paths[i], styles[i], tolerance );
+
+		vector<StrokeMesh2d> results( paths.size() );
+		for( size_t threads : { 1, 4 } ) {
+			ip::ScopedExecutionPolicy policy( ip::ExecutionPolicy().maxThreads( threads ) );
+			StrokeMesh2d::calcStrokes( paths.data(), styles.data(), paths.size(), results.data(), tolerance );
+			for( size_t i = 0; i < paths.size(); ++i ) {
+				REQUIRE( results[i].getPositions() == expected[i].getPositions() );
+				REQUIRE( results[i].getIndices() == expected[i].getIndices() );
+			}
+		}
+	}
+
+	SECTION("Empty results")
+	{
+		StrokeMesh2d mesh;
+		mesh.appendStroke( Path2d(), StrokeStyle( 5 ) );
+		mesh.appendStroke( shape, StrokeStyle( 0 ) );
+		Path2d point;
+		point.moveTo( 10, 10 );
+		point.lineTo( 10, 10 );
+		mesh.appendStroke( point, StrokeStyle( 5 ) );
+		REQUIRE( mesh.empty() );
+		REQUIRE( mesh.getNumVertices() == 0 );
+	}
+}
@@ -0,0 +1,226 @@
+#include "cinder/ip/Resize.h"
+#include "cinder/Rand.h"
+
+#include "catch.hpp"
+
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+using namespace ci;
+using namespace std;
+
+namespace {
+
+vector<shared_ptr<FilterBase>> getFilters()
+{
+	vector<shared_ptr<FilterBase>> result;
+	result.push_back( make_shared<FilterBox>() );
+	result.push_back( make_shared<FilterTriangle>() );
+	result.push_back( make_shared<FilterQuadratic>() );
+	result.push_back( make_shared<FilterCubic>() );
+	result.push_back( make_shared<FilterCatmullRom>() );
+	result.push_back( make_shared<FilterMitchell>() );
+	result.push_back( make_shared<FilterSincBlackman>() );
+	result.push_back( make_shared<FilterGaussian>() );
+	return result;
+}
+
+// A filter whose function can change between resizes without changing its type or support
+class SwitchingFilter : public FilterBase {
+  public:
+	SwitchingFilter() : FilterBase( 1.0f ) {}
+
+	float operator()( float x ) const override	{ return mBox ? mBoxFilter( x ) : mTriangleFilter( x ); }
+
+	bool			mBox = false;
+	FilterBox		mBoxFilter;
+	FilterTriangle	mTriangleFilter;
+};
+
+template<typename T>
+T randomValue( Rand &rand )
+{
+	return T( rand.nextInt( 256 ) );
+}
+
+template<>
+float randomValue<float>( Rand &rand )
+{
+	return rand.nextFloat();
+}
+
+template<>
+uint16_t randomValue<uint16_t>( Rand &rand )
+{
+	return uint16_t( rand.nextInt( 65536 ) );
+}
+
+template<typename T>
+SurfaceT<T> makeRandomSurface( int32_t width, int32_t height, SurfaceChannelOrder channelOrder )
+{
+	Rand rand( width * 7919 + height );
+	SurfaceT<T> result( width, height, channelOrder.hasAlpha(), channelOrder );
+	for( int32_t y = 0; y < height; y++ ) {
+		T *row = result.getData( ivec2( 0, y ) );
+		for( int32_t x = 0; x < width * result.getPixelInc(); x++ )
+			row[x] = randomValue<T>( rand );
+	}
+
+	return result;
+}
+
+template<typename T>
+double maxDifference( const ChannelT<T> &a, const ChannelT<T> &b )
+{
+	double result = 0;
+	for( int32_t y = 0; y < a.getHeight(); y++ ) {
+		for( int32_t x = 0; x < a.getWidth(); x++ )
+			result = std::max( result, std::abs( double( a.getValue( ivec2( x, y ) ) ) - double( b.getValue( ivec2( x, y ) ) ) ) );
+	}
+
+	return result;
+}
+
+template<typename T>
+void testConstantColor( const ColorAT<T> &color, const FilterBase &filter )
+{
+	SurfaceT<T> src( 61, 47, true );
+	for( int32_t y = 0; y < src.getHeight(); y++ ) {
+		for( int32_t x = 0; x < src.getWidth(); x++ )
+			src.setPixel( ivec2( x, y ), color );
+	}
+
+	for( ivec2 size : { ivec2( 13, 9 ), ivec2( 61, 47 ), ivec2( 150, 101 ) } ) {
+		auto dst = ip::resizeCopy( src, src.getBounds(), size, filter );
+		for( int32_t y = 0; y < size.y; y++ ) {
+			for( int32_t x = 0; x < size.x; x++ ) {
+				ColorAT<T> pixel = dst.getPixel( ivec2( x, y ) );
+				REQUIRE( std::abs( double( pixel.r ) - double( color.r ) ) < 1e-5 );
+				REQUIRE( std::abs( double( pixel.g ) - double( color.g ) ) < 1e-5 );
+				REQUIRE( std::abs( double( pixel.b ) - double( color.b ) ) < 1e-5 );
+				REQUIRE( std::abs( double( pixel.a ) - double( color.a ) ) < 1e-5 );
+			}
+		}
+	}
+}
+
+// A Surface is resized the same as each of its channels on their own. Results are allowed to differ by floating point
+// rounding only, as channels and whole pixels go through different code paths.
+template<typename T>
+void testSurfaceMatchesChannels( int32_t srcWidth, int32_t srcHeight, int32_t dstWidth, int32_t dstHeight, SurfaceChannelOrder srcOrder, SurfaceChannelOrder dstOrder, const FilterBase &filter )
+{
+	const double tolerance = std::is_same<T, uint8_t>::value ? 0 : ( std::is_same<T, uint16_t>::value ? 1 : 1e-5 );
+
+	auto src = makeRandomSurface<T>( srcWidth, srcHeight, srcOrder );
+	SurfaceT<T> dst( dstWidth, dstHeight, dstOrder.hasAlpha(), dstOrder );
+	ip::resize( src, &dst, filter );
+
+	ChannelT<T> channel( dstWidth, dstHeight );
+	ip::resize( src.getChannelRed(), &channel, filter );
+	REQUIRE( maxDifference( channel, dst.getChannelRed() ) <= tolerance );
+	ip::resize( src.getChannelGreen(), &channel, filter );
+	REQUIRE( maxDifference( channel, dst.getChannelGreen() ) <= tolerance );
+	ip::resize( src.getChannelBlue(), &channel, filter );
+	REQUIRE( maxDifference( channel, dst.getChannelBlue() ) <= tolerance );
+	if( src.hasAlpha() && dst.hasAlpha() ) {
+		ip::resize( src.getChannelAlpha(), &channel, filter );
+		REQUIRE( maxDifference( channel, dst.getChannelAlpha() ) <= tolerance );
+	}
+}
+
+} // anonymous namespace
+
+TEST_CASE( "ip/Resize" )
+{
+	auto filters = getFilters();
+
+SECTION( "constant images stay constant" )
+{
+	for( const auto &filter : filters ) {
+		testConstantColor( ColorA8u( 10, 100, 200, 255 ), *filter );
+		testConstantColor( ColorAT<uint16_t>( 1000, 20000, 65535, 0 ), *filter );
+		testConstantColor( ColorAf( 0.1f, 0.5f, 1.0f, 0.25f ), *filter );
+	}
+}
+
+SECTION( "surfaces are resized like their channels" )
+{
+	for( const auto &filter : filters ) {
+		// very short images, where the filter spans the whole source height
+		testSurfaceMatchesChannels<uint8_t>( 5, 3, 9, 9, SurfaceChannelOrder::RGBA, SurfaceChannelOrder::RGBA, *filter );
+		testSurfaceMatchesChannels<float>( 37, 29, 11, 7, SurfaceChannelOrder::RGBA, SurfaceChannelOrder::RGBA, *filter );
+
+		testSurfaceMatchesChannels<uint8_t>( 100, 80, 301, 203, SurfaceChannelOrder::BGR, SurfaceChannelOrder::RGBA, *filter );
+		testSurfaceMatchesChannels<uint8_t>( 321, 240, 160, 119, SurfaceChannelOrder::ARGB, SurfaceChannelOrder::BGRA, *filter );
+		testSurfaceMatchesChannels<uint16_t>( 100, 80, 53, 97, SurfaceChannelOrder::RGBX, SurfaceChannelOrder::RGB, *filter );
+		testSurfaceMatchesChannels<float>( 100, 80, 53, 97, SurfaceChannelOrder::RGB, SurfaceChannelOrder::ABGR, *filter );
+	}
+
+	// large enough to be split across threads
+	testSurfaceMatchesChannels<uint8_t>( 1600, 1200, 900, 700, SurfaceChannelOrder::RGBA, SurfaceChannelOrder::RGBA, FilterTriangle() );
+	testSurfaceMatchesChannels<float>( 1024, 768, 1500, 1100, SurfaceChannelOrder::BGRA, SurfaceChannelOrder::RGB, FilterCubic() );
+}
+
+SECTION( "8 bit results are within rounding of float results" )
+{
+	auto src8u = makeRandomSurface<uint8_t>( 200, 150, SurfaceChannelOrder::RGBA );
+	Surface32f src32f( 200, 150, true, SurfaceChannelOrder::RGBA );
+	for( int32_t y = 0; y < src8u.getHeight(); y++ ) {
+		for( int32_t x = 0; x < src8u.getWidth() * 4; x++ )
+			src32f.getData( ivec2( 0, y ) )[x] = src8u.getData( ivec2( 0, y ) )[x] / 255.0f;
+	}
+
+	for( const auto &filter : filters ) {
+		auto dst8u = ip::resizeCopy( src8u, src8u.getBounds(), ivec2( 77, 301 ), *filter );
+		auto dst32f = ip::resizeCopy( src32f, src32f.getBounds(), ivec2( 77, 301 ), *filter );
+		for( int32_t y = 0; y < dst8u.getHeight(); y++ ) {
+			for( int32_t x = 0; x < dst8u.getWidth() * 4; x++ ) {
+				float expected = glm::clamp( dst32f.getData( ivec2( 0, y ) )[x] * 255.0f, 0.0f, 255.0f );
+				REQUIRE( std::abs( float( dst8u.getData( ivec2( 0, y ) )[x] ) - expected ) <= 1.5f );
+			}
+		}
+	}
+}
+
+SECTION( "cached weights match the filter's parameters" )
+{
+	auto src = makeRandomSurface<float>( 90, 70, SurfaceChannelOrder::RGB );
+	const ivec2 dstSize( 41, 123 );
+
+	// FilterMitchell with b = 0 and c = 0.5 is the Catmull-Rom spline
+	auto mitchell = ip::resizeCopy( src, src.getBounds(), dstSize, FilterMitchell() );
+	auto catmullRom = ip::resizeCopy( src, src.getBounds(), dstSize, FilterCatmullRom() );
+	auto mitchellCatmullRom = ip::resizeCopy( src, src.getBounds(), dstSize, FilterMitchell( 2.0f, 0.0f, 0.5f ) );
+	REQUIRE( maxDifference( mitchellCatmullRom.getChannelRed(), catmullRom.getChannelRed() ) < 1e-5 );
+	REQUIRE( maxDifference( mitchellCatmullRom.getChannelRed(), mitchell.getChannelRed() ) > 1e-3 );
+
+	// filters other than those in Filter.h are not cached
+	SwitchingFilter switching;
+	auto triangle = ip::resizeCopy( src, src.getBounds(), dstSize, FilterTriangle( 1.0f ) );
+	auto box = ip::resizeCopy( src, src.getBounds(), dstSize, FilterBox( 1.0f ) );
+	REQUIRE( maxDifference( ip::resizeCopy( src, src.getBounds(), dstSize, switching ).getChannelGreen(), triangle.getChannelGreen() ) == 0 );
+	switching.mBox = true;
+	REQUIRE( maxDifference( ip::resizeCopy( src, src.getBounds(), dstSize, switching ).getChannelGreen(), box.getChannelGreen() ) == 0 );
+}
+
+SECTION( "pixels outside of the dest area are untouched" )
+{
+	auto src = makeRandomSurface<uint8_t>( 64, 64, SurfaceChannelOrder::RGB );
+	Surface8u dst( 40, 30, false );
+	for( int32_t y = 0; y < dst.getHeight(); y++ ) {
+		for( int32_t x = 0; x < dst.getWidth(); x++ )
+			dst.setPixel( ivec2( x, y ), Color8u( 1, 2, 3 ) );
+	}
+
+	const Area dstArea( 5, 4, 35, 20 );
+	ip::resize( src, Area( 10, 10, 50, 60 ), &dst, dstArea, FilterGaussian() );
+	for( int32_t y = 0; y < dst.getHeight(); y++ ) {
+		for( int32_t x = 0; x < dst.getWidth(); x++ ) {
+			if( x < dstArea.x1 || x > dstArea.x2 || y < dstArea.y1 || y > dstArea.y2 )
+				REQUIRE( dst.getPixel( ivec2( x, y ) ) == ColorA8u( 1, 2, 3, 255 ) );
+		}
+	}
+}
+
+} // "ip/Resize"
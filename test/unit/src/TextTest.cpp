@@ -0,0 +1,164 @@
+#include "cinder/Text.h"
+#include "cinder/ip/Execution.h"
+
+#include "catch.hpp"
+
+#if ! defined( CINDER_COCOA_TOUCH )
+
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ci;
+using namespace std;
+
+namespace {
+
+bool isEqual( const Surface &a, const Surface &b )
+{
+	if( a.getSize() != b.getSize() )
+		return false;
+	for( int y = 0; y < a.getHeight(); ++y ) {
+		for( int x = 0; x < a.getWidth(); ++x ) {
+			if( a.getPixel( ivec2( x, y ) ) != b.getPixel( ivec2( x, y ) ) )
+				return false;
+		}
+	}
+
+	return true;
+}
+
+vector<string> makeLabels( size_t count )
+{
+	vector<string> result;
+	for( size_t i = 0; i < count; ++i )
+		result.push_back( ( i % 3 == 0 ) ? "Subtitle line " + to_string( i ) + ", somewhat longer" : "label " + to_string( i * 7 ) );
+
+	return result;
+}
+
+#if defined( CINDER_LINUX )
+// Renders renderString(), TextBox and TextLayout output that only depends on \a seed
+vector<Surface> renderTexts( const Font &font, int seed )
+{
+	vector<Surface> result;
+	for( int i = 0; i < 10; ++i )
+		result.push_back( renderString( "Score: " + to_string( seed * 100 + i ), font, ColorA( 1, 1, 1, 1 ) ) );
+
+	TextBox box;
+	box.font( font ).text( "The quick brown fox " + to_string( seed ) + " jumps over the lazy dog." ).size( 150, TextBox::GROW );
+	result.push_back( box.render() );
+
+	TextLayout layout;
+	layout.setFont( font );
+	layout.addLine( "layout " + to_string( seed ) );
+	layout.addCenteredLine( "centered" );
+	result.push_back( layout.render( true ) );
+
+	return result;
+}
+#endif
+
+} // anonymous namespace
+
+TEST_CASE( "Text" )
+{
+	ip::ScopedExecutionPolicy policy( ip::ExecutionPolicy().maxThreads( 4 ) );
+	Font font( "Arial", 19 );
+	const ColorA color( 1, 0.5f, 0.25f, 1 );
+
+SECTION( "renderStrings matches renderString" )
+{
+	auto labels = makeLabels( 150 );
+	vector<Surface> surfaces( labels.size() );
+	vector<float> baselineOffsets( labels.size() );
+	renderStrings( labels.data(), labels.size(), font, color, surfaces.data(), baselineOffsets.data() );
+
+	for( size_t i = 0; i < labels.size(); ++i ) {
+		float baselineOffset;
+		Surface expected = renderString( labels[i], font, color, &baselineOffset );
+		REQUIRE( isEqual( surfaces[i], expected ) );
+		REQUIRE( baselineOffsets[i] == baselineOffset );
+	}
+}
+
+SECTION( "renderStringAtlas" )
+{
+	auto labels = makeLabels( 60 );
+	vector<Surface> surfaces( labels.size() );
+	renderStrings( labels.data(), labels.size(), font, color, surfaces.data() );
+
+	const int32_t padding = 2;
+	vector<Area> areas( labels.size() );
+	Surface atlas = renderStringAtlas( labels.data(), labels.size(), font, color, 512, areas.data(), nullptr, padding );
+	REQUIRE( atlas.getWidth() == 512 );
+
+	for( size_t i = 0; i < labels.size(); ++i ) {
+		// each string is padded, and keeps its padding from every other string
+		REQUIRE( areas[i].getSize() == surfaces[i].getSize() );
+		REQUIRE( areas[i].x1 >= padding );
+		REQUIRE( areas[i].y1 >= padding );
+		REQUIRE( areas[i].x2 + padding <= atlas.getWidth() );
+		REQUIRE( areas[i].y2 + padding <= atlas.getHeight() );
+		for( size_t j = 0; j < i; ++j ) {
+			const bool apartX = ( areas[j].x2 + padding <= areas[i].x1 ) || ( areas[i].x2 + padding <= areas[j].x1 );
+			const bool apartY = ( areas[j].y2 + padding <= areas[i].y1 ) || ( areas[i].y2 + padding <= areas[j].y1 );
+			REQUIRE( ( apartX || apartY ) );
+		}
+
+		Surface packed( areas[i].getWidth(), areas[i].getHeight(), true, surfaces[i].getChannelOrder() );
+		packed.copyFrom( atlas, areas[i], -areas[i].getUL() );
+		REQUIRE( isEqual( packed, surfaces[i] ) );
+	}
+
+	// an atlas narrower than the widest string grows to fit it
+	Surface narrow = renderStringAtlas( labels.data(), labels.size(), font, color, 16, areas.data(), nullptr, padding );
+	int32_t widest = 0;
+	for( const auto &surface : surfaces )
+		widest = std::max( widest, surface.getWidth() );
+	REQUIRE( narrow.getWidth() == widest + padding * 2 );
+	REQUIRE( narrow.getHeight() > atlas.getHeight() );
+
+	REQUIRE( ! renderStringAtlas( nullptr, 0, font, color, 512, nullptr ).getData() );
+}
+
+#if defined( CINDER_LINUX )
+SECTION( "fonts and text used from several threads" )
+{
+	vector<vector<Surface>> expected;
+	for( int seed = 0; seed < 4; ++seed )
+		expected.push_back( renderTexts( Font( "DejaVu Sans", 12.0f + seed ), seed ) );
+
+	// a small budget makes the threads evict each other's glyphs and runs as well
+	GlyphCache *cache = GlyphCache::get();
+	const size_t memoryBudget = cache->getMemoryBudget();
+	cache->clear();
+	cache->setMemoryBudget( 64 * 1024 );
+
+	vector<int> numMatching( 4, 0 );
+	vector<thread> threads;
+	for( int seed = 0; seed < 4; ++seed ) {
+		threads.emplace_back( [&, seed] {
+			for( int i = 0; i < 5; ++i ) {
+				// each thread creates its own fonts while the others render
+				auto surfaces = renderTexts( Font( "DejaVu Sans", 12.0f + seed ), seed );
+				bool matching = surfaces.size() == expected[seed].size();
+				for( size_t j = 0; matching && j < surfaces.size(); ++j )
+					matching = isEqual( surfaces[j], expected[seed][j] );
+				numMatching[seed] += matching ? 1 : 0;
+			}
+		} );
+	}
+	for( auto &thread : threads )
+		thread.join();
+
+	for( int matching : numMatching )
+		REQUIRE( matching == 5 );
+
+	cache->setMemoryBudget( memoryBudget );
+	cache->clear();
+}
+#endif
+}
+
+#endif // ! defined( CINDER_COCOA_TOUCH )
@@ -0,0 +1,216 @@
+#include "cinder/Timeline.h"
+#include "cinder/Color.h"
+#include "cinder/Rand.h"
+
+#include "catch.hpp"
+
+#include <vector>
+
+using namespace ci;
+using namespace std;
+
+namespace {
+
+// Anims of every common type, tweened the same way on any number of Timelines
+struct Particles {
+	Particles( size_t count )
+		: mPositions( count, vec2( 0 ) ), mAlphas( count, 0.0f ), mColors( count, Color::black() ), mOrientations( count, quat( 1, 0, 0, 0 ) )
+	{}
+
+	void animate( const TimelineRef &timeline )
+	{
+		Rand rand( 7 );
+		for( size_t i = 0; i < mPositions.size(); i++ ) {
+			const float duration = ( i % 17 == 0 ) ? 0 : rand.nextFloat( 0.5f, 3 );
+			const float delay = rand.nextFloat( 0, 1 );
+
+			auto options = timeline->apply( &mPositions[i], vec2( rand.nextFloat(), rand.nextFloat() ), duration, ( i % 2 ) ? easeInOutQuad : easeOutCubic ).delay( delay );
+			if( i % 5 == 0 )
+				options.loop();
+			if( i % 7 == 0 )
+				options.pingPong();
+			if( i % 11 == 0 )
+				options.autoRemove( false );
+
+			timeline->apply( &mAlphas[i], 1.0f, 0.0f, duration, easeNone ).delay( delay );
+			timeline->apply( &mColors[i], Color( rand.nextFloat(), 0.5f, 1 ), duration * 0.5f, easeInQuad );
+			if( i % 3 == 0 )
+				timeline->appendTo( &mColors[i], Color( 0, 0, 0 ), 1.0f, easeOutQuad );
+			timeline->apply( &mOrientations[i], glm::angleAxis( rand.nextFloat( 3 ), vec3( 0, 1, 0 ) ), duration );
+		}
+	}
+
+	bool operator==( const Particles &rhs ) const
+	{
+		for( size_t i = 0; i < mPositions.size(); i++ ) {
+			if( mPositions[i]() != rhs.mPositions[i]() || mAlphas[i]() != rhs.mAlphas[i]() || mColors[i]() != rhs.mColors[i]() || mOrientations[i]() != rhs.mOrientations[i]() )
+				return false;
+			if( mPositions[i].isComplete() != rhs.mPositions[i].isComplete() || mAlphas[i].isComplete() != rhs.mAlphas[i].isComplete() )
+				return false;
+		}
+
+		return true;
+	}
+
+	vector<Anim<vec2>>		mPositions;
+	vector<Anim<float>>		mAlphas;
+	vector<Anim<Color>>		mColors;
+	vector<Anim<quat>>		mOrientations;
+};
+
+} // anonymous namespace
+
+TEST_CASE( "Timeline" )
+{
+
+SECTION( "batched tweens behave like individually stepped ones" )
+{
+	auto batched = Timeline::create(), individual = Timeline::create();
+	individual->setBatchingEnabled( false );
+
+	Particles a( 300 ), b( 300 );
+	a.animate( batched );
+	b.animate( individual );
+
+	for( int step = 0; step < 300; step++ ) {
+		const float timestep = ( step % 13 == 0 ) ? 0.1f : 1 / 60.0f;
+		batched->step( timestep );
+		individual->step( timestep );
+
+		REQUIRE( a == b );
+		REQUIRE( batched->getNumItems() == individual->getNumItems() );
+	}
+
+	REQUIRE( individual->getNumBatchedItems() == 0 );
+	REQUIRE( batched->getNumBatchedItems() > 0 );
+
+	// stepping backwards and forwards again
+	for( int step = 0; step < 60; step++ ) {
+		const float timestep = ( step < 30 ) ? -0.05f : 0.1f;
+		batched->step( timestep );
+		individual->step( timestep );
+
+		REQUIRE( a == b );
+	}
+}
+
+SECTION( "tweens with callbacks are stepped individually" )
+{
+	auto timeline = Timeline::create();
+	Anim<float> value( 0 ), other( 0 );
+
+	int numUpdates = 0;
+	timeline->apply( &value, 1.0f, 1.0f ).updateFn( [&numUpdates] { numUpdates++; } );
+	TweenRef<float> tween = timeline->apply( &other, 1.0f, 1.0f );
+	timeline->step( 0.25f );
+	REQUIRE( numUpdates == 1 );
+	REQUIRE( timeline->getNumBatchedItems() == 1 );
+
+	// setting a callback on a running tween moves it out of its batch
+	bool finished = false;
+	tween->setFinishFn( [&finished] { finished = true; } );
+	REQUIRE( timeline->getNumBatchedItems() == 0 );
+
+	timeline->step( 1 );
+	REQUIRE( numUpdates == 2 );
+	REQUIRE( finished );
+	REQUIRE( value() == 1.0f );
+	REQUIRE( other() == 1.0f );
+	REQUIRE( timeline->empty() );
+}
+
+SECTION( "clearing the callbacks of a tween batches it" )
+{
+	auto timeline = Timeline::create();
+	Anim<float> value( 0 );
+
+	TweenRef<float> tween = timeline->apply( &value, 1.0f, 1.0f ).updateFn( [] {} );
+	timeline->step( 0.25f );
+	REQUIRE( timeline->getNumBatchedItems() == 0 );
+
+	tween->setUpdateFn( nullptr );
+	timeline->step( 0.25f );
+	REQUIRE( timeline->getNumBatchedItems() == 1 );
+	REQUIRE( value() == 0.5f );
+}
+
+SECTION( "changing a batched tween" )
+{
+	auto timeline = Timeline::create();
+	Anim<float> value( 0 );
+
+	TweenRef<float> tween = timeline->apply( &value, 1.0f, 1.0f );
+	timeline->step( 0.5f );
+	REQUIRE( timeline->getNumBatchedItems() == 1 );
+	REQUIRE( value() == 0.5f );
+
+	tween->setLoop();
+	tween->setStartTime( 0.25f );
+	timeline->step( 1 );
+	REQUIRE( timeline->getNumBatchedItems() == 1 );
+	REQUIRE( value() == Approx( 0.25f ) );
+	REQUIRE_FALSE( tween->isComplete() );
+
+	tween->removeSelf();
+	timeline->step( 0.1f );
+	REQUIRE( timeline->empty() );
+	REQUIRE( timeline->getNumBatchedItems() == 0 );
+}
+
+SECTION( "reversing a batched tween" )
+{
+	auto timeline = Timeline::create();
+	Anim<float> value( 0 );
+
+	TweenRef<float> tween = timeline->apply( &value, 1.0f, 1.0f );
+	timeline->step( 0.5f );
+	REQUIRE( timeline->getNumBatchedItems() == 1 );
+
+	static_cast<TimelineItem*>( tween.get() )->reverse();
+	timeline->step( 0.25f );
+	REQUIRE( timeline->getNumBatchedItems() == 1 );
+	REQUIRE( value() == Approx( 0.25f ) );
+}
+
+SECTION( "moved and destroyed Anims" )
+{
+	auto timeline = Timeline::create();
+	vector<Anim<float>> values;
+	for( int i = 0; i < 100; i++ ) {
+		values.emplace_back( 0.0f );
+		timeline->apply( &values.back(), 1.0f, 2.0f );
+		timeline->step( 0 );
+	}
+	REQUIRE( timeline->getNumBatchedItems() == 100 );
+
+	timeline->stepTo( 1 );
+	for( const auto &value : values )
+		REQUIRE( value() == 0.5f );
+
+	values.resize( 50 );
+	timeline->stepTo( 1.5f );
+	REQUIRE( timeline->getNumItems() == 50 );
+	for( const auto &value : values )
+		REQUIRE( value() == 0.75f );
+}
+
+SECTION( "stepping on several threads" )
+{
+	auto threaded = Timeline::create(), single = Timeline::create();
+	threaded->setNumStepThreads( 4 );
+	REQUIRE( threaded->getNumStepThreads() == 4 );
+
+	Particles a( 20000 ), b( 20000 );
+	a.animate( threaded );
+	b.animate( single );
+
+	for( int step = 0; step < 30; step++ ) {
+		threaded->step( 0.1f );
+		single->step( 0.1f );
+	}
+
+	REQUIRE( a == b );
+	REQUIRE( threaded->getNumItems() == single->getNumItems() );
+}
+
+}
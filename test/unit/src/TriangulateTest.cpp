@@ -0,0 +1,185 @@
+#include "cinder/Triangulate.h"
+#include "cinder/Rand.h"
+#include "cinder/ip/Execution.h"
+
+#include "catch.hpp"
+
+#include <vector>
+
+using namespace ci;
+using namespace std;
+
+namespace {
+
+float calcArea( const vector<vec2> &positions, const vector<uint32_t> &indices )
+{
+	float result = 0;
+	for( size_t i = 0; i < indices.size(); i += 3 )
+		result += abs( cross2d( positions[indices[i + 1]] - positions[indices[i]], positions[indices[i + 2]] - positions[indices[i]] ) ) / 2;
+	return result;
+}
+
+vector<vec2> getPositions( const TriMesh &mesh )
+{
+	const vec2 *positions = reinterpret_cast<const vec2*>( mesh.getPositions<2>() );
+	return vector<vec2>( positions, positions + mesh.getNumVertices() );
+}
+
+// Shapes with curves, holes and self-intersections, each a little different
+vector<Shape2d> makeShapes( size_t count )
+{
+	Rand rand( 23 );
+	vector<Shape2d> result;
+	for( size_t i = 0; i < count; ++i ) {
+		Shape2d shape;
+		const vec2 center( rand.nextFloat( 0, 500 ), rand.nextFloat( 0, 500 ) );
+		shape.appendContour( Path2d::star( center, 5 + i % 9, 60, 25, rand.nextFloat( 0.5f ) ) );
+		shape.appendContour( Path2d::circle( center, 15 + i % 7 ) );
+		if( i % 3 == 0 ) {
+			shape.moveTo( center );
+			shape.curveTo( center + vec2( 120, -80 ), center + vec2( -100, -90 ), center + vec2( 40, 70 ) );
+			shape.close();
+		}
+		result.push_back( shape );
+	}
+
+	return result;
+}
+
+} // anonymous namespace
+
+TEST_CASE( "Triangulator" )
+{
+
+SECTION( "a reused Triangulator produces the same meshes as new ones" )
+{
+	auto shapes = makeShapes( 40 );
+	Triangulator reused;
+	for( const auto &shape : shapes ) {
+		for( auto winding : { Triangulator::WINDING_ODD, Triangulator::WINDING_NONZERO } ) {
+			TriMesh expected = Triangulator( shape ).calcMesh( winding );
+			reused.addShape( shape );
+			TriMesh mesh = reused.calcMesh( winding );
+
+			REQUIRE( mesh.getNumTriangles() > 0 );
+			REQUIRE( getPositions( mesh ) == getPositions( expected ) );
+			REQUIRE( mesh.getIndices() == expected.getIndices() );
+		}
+	}
+
+	// nothing is left over from the previous tesselation
+	REQUIRE( reused.calcMesh().getNumTriangles() == 0 );
+}
+
+SECTION( "appending to caller-provided storage" )
+{
+	auto shapes = makeShapes( 3 );
+	vector<vec2> positions( 1, vec2( -1 ) );
+	vector<uint32_t> indices;
+
+	Triangulator triangulator;
+	TriMesh combined( TriMesh::Format().positions( 2 ) );
+	for( const auto &shape : shapes ) {
+		const size_t firstVertex = positions.size(), firstIndex = indices.size();
+		TriMesh expected = Triangulator( shape ).calcMesh();
+
+		triangulator.addShape( shape );
+		triangulator.calcMesh( &positions, &indices );
+		REQUIRE( vector<vec2>( positions.begin() + firstVertex, positions.end() ) == getPositions( expected ) );
+		for( size_t i = 0; i < expected.getIndices().size(); ++i )
+			REQUIRE( indices[firstIndex + i] == expected.getIndices()[i] + firstVertex );
+
+		triangulator.addShape( shape );
+		triangulator.calcMesh( &combined );
+	}
+
+	REQUIRE( getPositions( combined ) == vector<vec2>( positions.begin() + 1, positions.end() ) );
+	REQUIRE( combined.getNumIndices() == indices.size() );
+	REQUIRE( combined.getIndices().back() + 1 == indices.back() );
+
+	// a square given as a pointer to its corners
+	const vec2 square[] = { vec2( 0, 0 ), vec2( 2, 0 ), vec2( 2, 2 ), vec2( 0, 2 ) };
+	positions.clear();
+	indices.clear();
+	triangulator.addPolyLine( square, 4 );
+	triangulator.calcMesh( &positions, &indices );
+	REQUIRE( indices.size() == 6 );
+	REQUIRE( calcArea( positions, indices ) == Approx( 4 ) );
+}
+
+SECTION( "contours with thousands of intersections" )
+{
+	// a star polygon whose edges cross each other more often than the tesselator's initial priority queue has room for
+	vector<vec2> star;
+	const int numPoints = 151;
+	for( int i = 0; i < numPoints; ++i ) {
+		const float angle = i * 61 * 2 * float( M_PI ) / numPoints;
+		star.push_back( vec2( cos( angle ), sin( angle ) ) * 100.0f );
+	}
+
+	Triangulator triangulator;
+	triangulator.addPolyLine( star.data(), star.size() );
+	TriMesh mesh = triangulator.calcMesh( Triangulator::WINDING_NONZERO );
+	REQUIRE( mesh.getNumTriangles() > 0 );
+	for( uint32_t index : mesh.getIndices() )
+		REQUIRE( index < mesh.getNumVertices() );
+
+	// the nonzero winding fill of the star covers the disk within its innermost intersections, and lies within its circumcircle
+	const float area = calcArea( getPositions( mesh ), mesh.getIndices() );
+	REQUIRE( area < float( M_PI ) * 100 * 100 );
+	REQUIRE( area > float( M_PI ) * 50 * 50 );
+}
+
+SECTION( "batches on any number of threads" )
+{
+	auto shapes = makeShapes( 100 );
+	vector<TriMesh> expected;
+	for( const auto &shape : shapes )
+		expected.push_back( Triangulator( shape ).calcMesh( Triangulator::WINDING_NONZERO ) );
+
+	vector<TriMesh> results( shapes.size(), TriMesh( TriMesh::Format().positions( 2 ) ) );
+	for( size_t threads : { 1, 4 } ) {
+		ip::ScopedExecutionPolicy policy( ip::ExecutionPolicy().maxThreads( threads ) );
+		// twice, so that the meshes are replaced and the threads' Triangulators reused
+		for( int pass = 0; pass < 2; ++pass ) {
+			Triangulator::calcMeshes( shapes.data(), shapes.size(), results.data(), Triangulator::WINDING_NONZERO );
+			for( size_t i = 0; i < shapes.size(); ++i ) {
+				REQUIRE( getPositions( results[i] ) == getPositions( expected[i] ) );
+				REQUIRE( results[i].getIndices() == expected[i].getIndices() );
+			}
+		}
+	}
+}
+
+SECTION( "batches with shapes larger than the threads keep memory for" )
+{
+	// a star polygon with tens of thousands of intersections needs several megabytes, which the threads release afterwards
+	Shape2d star;
+	const int numPoints = 301;
+	for( int i = 0; i < numPoints; ++i ) {
+		const float angle = i * 121 * 2 * float( M_PI ) / numPoints;
+		if( i == 0 )
+			star.moveTo( vec2( cos( angle ), sin( angle ) ) * 100.0f );
+		else
+			star.lineTo( vec2( cos( angle ), sin( angle ) ) * 100.0f );
+	}
+	star.close();
+
+	auto shapes = makeShapes( 30 );
+	shapes.insert( shapes.begin() + 10, star );
+	vector<TriMesh> expected;
+	for( const auto &shape : shapes )
+		expected.push_back( Triangulator( shape ).calcMesh( Triangulator::WINDING_NONZERO ) );
+
+	vector<TriMesh> results( shapes.size(), TriMesh( TriMesh::Format().positions( 2 ) ) );
+	ip::ScopedExecutionPolicy policy( ip::ExecutionPolicy().maxThreads( 4 ) );
+	for( int pass = 0; pass < 2; ++pass ) {
+		Triangulator::calcMeshes( shapes.data(), shapes.size(), results.data(), Triangulator::WINDING_NONZERO );
+		for( size_t i = 0; i < shapes.size(); ++i ) {
+			REQUIRE( getPositions( results[i] ) == getPositions( expected[i] ) );
+			REQUIRE( results[i].getIndices() == expected[i].getIndices() );
+		}
+	}
+}
+
+}
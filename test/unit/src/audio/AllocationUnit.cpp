@@ -0,0 +1,170 @@
+// Verifies that rendering does not allocate on the audio thread. This replaces the global operator new / delete to count heap calls,
+// so it is built as its own AudioAllocationTests executable rather than as part of UnitTests.
+
+#include "catch.hpp"
+
+#include "cinder/audio/OfflineContext.h"
+#include "cinder/audio/GainNode.h"
+#include "cinder/audio/GenNode.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <thread>
+#include <vector>
+
+using namespace ci;
+using namespace ci::audio;
+
+// ----------------------------------------------------------------------------------------------------
+// Allocation tracking
+// ----------------------------------------------------------------------------------------------------
+
+namespace {
+
+thread_local bool		sTrackAllocations = false;
+std::atomic<size_t>		sNumHeapCalls( 0 );
+
+void* trackedAlloc( size_t size, size_t alignment )
+{
+	if( sTrackAllocations )
+		sNumHeapCalls++;
+
+	if( size == 0 )
+		size = 1;
+
+	void *result = nullptr;
+	if( alignment ) {
+#if defined( _MSC_VER )
+		result = _aligned_malloc( size, alignment );
+#else
+		if( posix_memalign( &result, alignment, size ) != 0 )
+			result = nullptr;
+#endif
+	}
+	else
+		result = std::malloc( size );
+
+	if( ! result )
+		throw std::bad_alloc();
+
+	return result;
+}
+
+void trackedFree( void *ptr, bool aligned )
+{
+	if( sTrackAllocations )
+		sNumHeapCalls++;
+
+#if defined( _MSC_VER )
+	if( aligned ) {
+		_aligned_free( ptr );
+		return;
+	}
+#endif
+	std::free( ptr );
+}
+
+} // anonymous namespace
+
+void* operator new( size_t size )										{ return trackedAlloc( size, 0 ); }
+void* operator new[]( size_t size )										{ return trackedAlloc( size, 0 ); }
+void* operator new( size_t size, std::align_val_t alignment )			{ return trackedAlloc( size, size_t( alignment ) ); }
+void* operator new[]( size_t size, std::align_val_t alignment )			{ return trackedAlloc( size, size_t( alignment ) ); }
+void operator delete( void *ptr ) noexcept								{ trackedFree( ptr, false ); }
+void operator delete[]( void *ptr ) noexcept							{ trackedFree( ptr, false ); }
+void operator delete( void *ptr, size_t ) noexcept						{ trackedFree( ptr, false ); }
+void operator delete[]( void *ptr, size_t ) noexcept					{ trackedFree( ptr, false ); }
+void operator delete( void *ptr, std::align_val_t ) noexcept			{ trackedFree( ptr, true ); }
+void operator delete[]( void *ptr, std::align_val_t ) noexcept			{ trackedFree( ptr, true ); }
+void operator delete( void *ptr, size_t, std::align_val_t ) noexcept	{ trackedFree( ptr, true ); }
+void operator delete[]( void *ptr, size_t, std::align_val_t ) noexcept	{ trackedFree( ptr, true ); }
+
+namespace {
+
+// Renders \a numBlocks blocks with one OfflineContext::render() and returns the number of heap calls made on this thread from the end of the first
+// block until the last one. This leaves out render() destroying the commands the Context finished with, which happens after the last block.
+size_t countHeapCallsWhileRendering( const std::shared_ptr<OfflineContext> &ctx, size_t numBlocks )
+{
+	size_t numRendered = 0;
+	ctx->getOfflineOutput()->setRenderCallback( [&]( const audio::Buffer * /*buffer*/, size_t /*numFrames*/ ) {
+		sTrackAllocations = ++numRendered < numBlocks;
+	} );
+
+	sNumHeapCalls = 0;
+	ctx->render( numBlocks * ctx->getFramesPerBlock() );
+	sTrackAllocations = false;
+
+	ctx->getOfflineOutput()->setRenderCallback( nullptr );
+	return sNumHeapCalls;
+}
+
+} // anonymous namespace
+
+TEST_CASE( "audio/allocations" )
+{
+	const size_t numVoices = 8;
+
+	auto ctx = std::make_shared<OfflineContext>( 44100, 128, 2 );
+
+	std::vector<std::shared_ptr<GenSineNode>> gens;
+	std::vector<std::shared_ptr<GainNode>> gains;
+	for( size_t i = 0; i < numVoices; i++ ) {
+		auto gen = ctx->makeNode<GenSineNode>( 220.0f * float( i + 1 ) );
+		auto gain = ctx->makeNode<GainNode>( 0.1f );
+		gen >> gain >> ctx->getOutput();
+		gen->enable();
+
+		gens.push_back( gen );
+		gains.push_back( gain );
+	}
+
+	// render once so all buffers are allocated
+	ctx->renderBlock();
+
+SECTION( "Param commands" )
+{
+	// commands are only sent through the queue while the Context is enabled
+	ctx->enable();
+
+	std::atomic<bool> done( false );
+	std::atomic<size_t> numCommands( 0 );
+	std::thread producer( [&] {
+		size_t i = 0;
+		while( ! done ) {
+			auto &gain = gains[i % numVoices];
+			auto &gen = gens[i % numVoices];
+
+			gain->getParam()->applyRamp( float( i % 10 ) / 10.0f, 0.01 );
+			gain->getParam()->appendRamp( 0.5f, 0.01 );
+			gen->getParamFreq()->applyRamp( 100.0f + float( i % 1000 ), 0.005, Param::Options().delay( 0.001 ) );
+			gen->setEnabled( i % 2 == 0, ctx->getNumProcessedSeconds() + 0.002 );
+			if( i % 100 == 0 )
+				gain->setValue( 0.1f );
+
+			numCommands += 5;
+			i++;
+		}
+	} );
+
+	size_t numHeapCalls = 0, numBlocks = 0;
+	while( numBlocks < 2000 || numCommands < 10000 ) {
+		numHeapCalls += countHeapCallsWhileRendering( ctx, 100 );
+		numBlocks += 100;
+	}
+
+	done = true;
+	producer.join();
+
+	REQUIRE( numHeapCalls == 0 );
+}
+
+SECTION( "parallel rendering" )
+{
+	ctx->setNumRenderThreads( 2 );
+	REQUIRE( ctx->getOutput()->getPullsInputsInParallel() );
+
+	REQUIRE( countHeapCallsWhileRendering( ctx, 1000 ) == 0 );
+}
+
+} // "audio/allocations"
@@ -0,0 +1,142 @@
+#include "catch.hpp"
+#include "utils.h"
+
+#include "cinder/audio/ConvolutionNode.h"
+#include "cinder/audio/OfflineContext.h"
+#include "cinder/audio/SamplePlayerNode.h"
+#include "cinder/audio/dsp/Dsp.h"
+
+using namespace ci;
+using namespace ci::audio;
+
+namespace {
+
+const float CONVOLUTION_ERROR = 0.0001f;
+
+// Plays \a input through a ConvolutionNode with \a impulseResponse and returns the first \a numFrames frames of its output.
+audio::Buffer renderConvolution( const audio::BufferRef &input, const audio::BufferRef &impulseResponse, size_t numChannels, size_t framesPerBlock, size_t maxPartitionSize, size_t numFrames )
+{
+	auto ctx = std::make_shared<OfflineContext>( 44100, framesPerBlock, numChannels );
+	auto player = ctx->makeNode<BufferPlayerNode>( input );
+	auto convolution = ctx->makeNode<ConvolutionNode>( impulseResponse, Node::Format().channels( numChannels ) );
+	convolution->setMaxPartitionSize( maxPartitionSize );
+
+	player >> convolution >> ctx->getOutput();
+	player->start();
+
+	audio::Buffer result( numFrames, numChannels );
+	size_t writePos = 0;
+	ctx->getOfflineOutput()->setRenderCallback( [&]( const audio::Buffer *buffer, size_t numFramesRendered ) {
+		for( size_t ch = 0; ch < numChannels; ch++ )
+			std::copy( buffer->getChannel( ch ), buffer->getChannel( ch ) + numFramesRendered, result.getChannel( ch ) + writePos );
+		writePos += numFramesRendered;
+	} );
+
+	ctx->render( numFrames );
+	return result;
+}
+
+// Direct form convolution of the mono \a input with each channel of \a impulseResponse.
+audio::Buffer convolveDirect( const audio::Buffer &input, const audio::Buffer &impulseResponse, size_t numFrames )
+{
+	audio::Buffer result( numFrames, impulseResponse.getNumChannels() );
+	for( size_t ch = 0; ch < impulseResponse.getNumChannels(); ch++ ) {
+		const float *ir = impulseResponse.getChannel( ch );
+		float *out = result.getChannel( ch );
+		for( size_t n = 0; n < numFrames; n++ ) {
+			double sum = 0;
+			for( size_t k = 0; k < impulseResponse.getNumFrames() && k <= n; k++ ) {
+				if( n - k < input.getNumFrames() )
+					sum += double( ir[k] ) * double( input[n - k] );
+			}
+			out[n] = float( sum );
+		}
+	}
+
+	return result;
+}
+
+audio::BufferRef makeRandomBuffer( size_t numFrames, size_t numChannels, float scale )
+{
+	auto result = std::make_shared<audio::Buffer>( numFrames, numChannels );
+	fillRandom( result.get() );
+	dsp::mul( result->getData(), scale, result->getData(), result->getSize() );
+	return result;
+}
+
+} // anonymous namespace
+
+TEST_CASE( "audio/ConvolutionNode" )
+{
+	randSeed( 1 );
+
+	auto input = makeRandomBuffer( 3000, 1, 0.5f );
+
+SECTION( "non-uniform partitions match direct convolution" )
+{
+	auto ir = makeRandomBuffer( 5000, 1, 0.02f );
+	const size_t numFrames = input->getNumFrames() + ir->getNumFrames();
+
+	auto result = renderConvolution( input, ir, 1, 64, 1024, numFrames );
+	auto expected = convolveDirect( *input, *ir, numFrames );
+
+	REQUIRE( maxError( result, expected ) < CONVOLUTION_ERROR );
+}
+
+SECTION( "long periods match direct convolution" )
+{
+	// the last stages' transforms are split over 32 and 128 blocks
+	auto ir = makeRandomBuffer( 20000, 1, 0.005f );
+	const size_t numFrames = input->getNumFrames() + ir->getNumFrames();
+
+	auto result = renderConvolution( input, ir, 1, 32, 4096, numFrames );
+	auto expected = convolveDirect( *input, *ir, numFrames );
+
+	REQUIRE( maxError( result, expected ) < CONVOLUTION_ERROR );
+}
+
+SECTION( "two blocks per period match direct convolution" )
+{
+	auto ir = makeRandomBuffer( 2000, 1, 0.02f );
+	const size_t numFrames = input->getNumFrames() + ir->getNumFrames();
+
+	auto result = renderConvolution( input, ir, 1, 64, 128, numFrames );
+	auto expected = convolveDirect( *input, *ir, numFrames );
+
+	REQUIRE( maxError( result, expected ) < CONVOLUTION_ERROR );
+}
+
+SECTION( "uniform partitions match direct convolution" )
+{
+	auto ir = makeRandomBuffer( 2000, 1, 0.02f );
+	const size_t numFrames = input->getNumFrames() + ir->getNumFrames();
+
+	auto result = renderConvolution( input, ir, 1, 128, 128, numFrames );
+	auto expected = convolveDirect( *input, *ir, numFrames );
+
+	REQUIRE( maxError( result, expected ) < CONVOLUTION_ERROR );
+}
+
+SECTION( "impulse response shorter than a block" )
+{
+	auto ir = makeRandomBuffer( 10, 1, 0.2f );
+	const size_t numFrames = input->getNumFrames() + 512;
+
+	auto result = renderConvolution( input, ir, 1, 512, 8192, numFrames );
+	auto expected = convolveDirect( *input, *ir, numFrames );
+
+	REQUIRE( maxError( result, expected ) < CONVOLUTION_ERROR );
+}
+
+SECTION( "multi-channel impulse response" )
+{
+	auto ir = makeRandomBuffer( 3000, 2, 0.02f );
+	const size_t numFrames = input->getNumFrames() + ir->getNumFrames();
+
+	auto result = renderConvolution( input, ir, 2, 64, 512, numFrames );
+	auto expected = convolveDirect( *input, *ir, numFrames );
+
+	REQUIRE( maxError( result, expected ) < CONVOLUTION_ERROR );
+}
+
+} // "audio/ConvolutionNode"
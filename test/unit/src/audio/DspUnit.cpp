@@ -0,0 +1,116 @@
+#include "catch.hpp"
+#include "utils.h"
+
+#include "cinder/audio/Buffer.h"
+#include "cinder/audio/dsp/Dsp.h"
+
+#include <cstdint>
+
+using namespace ci;
+using namespace ci::audio;
+
+// Lengths that exercise both the vectorized body and the scalar remainder of each routine.
+static const size_t sTestLengths[] = { 1, 3, 4, 7, 8, 9, 16, 31, 512, 1027 };
+
+TEST_CASE( "audio/Dsp" )
+{
+
+SECTION( "buffer alignment" )
+{
+	for( size_t length : sTestLengths ) {
+		Buffer buffer( length, 2 );
+		REQUIRE( reinterpret_cast<uintptr_t>( buffer.getData() ) % BUFFER_ALIGNMENT == 0 );
+	}
+}
+
+SECTION( "element-wise arithmetic" )
+{
+	for( size_t length : sTestLengths ) {
+		// offset by one sample so that the vectorized paths are also run on unaligned data.
+		Buffer a( length + 1 ), b( length + 1 ), result( length + 1 );
+		fillRandom( &a );
+		fillRandom( &b );
+		const float *pa = a.getData() + 1;
+		const float *pb = b.getData() + 1;
+		float *pr = result.getData() + 1;
+
+		dsp::add( pa, pb, pr, length );
+		for( size_t i = 0; i < length; i++ )
+			REQUIRE( pr[i] == pa[i] + pb[i] );
+
+		dsp::sub( pa, pb, pr, length );
+		for( size_t i = 0; i < length; i++ )
+			REQUIRE( pr[i] == pa[i] - pb[i] );
+
+		dsp::mul( pa, pb, pr, length );
+		for( size_t i = 0; i < length; i++ )
+			REQUIRE( pr[i] == pa[i] * pb[i] );
+
+		dsp::add( pa, 0.5f, pr, length );
+		for( size_t i = 0; i < length; i++ )
+			REQUIRE( pr[i] == pa[i] + 0.5f );
+
+		dsp::sub( pa, 0.5f, pr, length );
+		for( size_t i = 0; i < length; i++ )
+			REQUIRE( pr[i] == pa[i] - 0.5f );
+
+		dsp::mul( pa, 0.5f, pr, length );
+		for( size_t i = 0; i < length; i++ )
+			REQUIRE( pr[i] == pa[i] * 0.5f );
+
+		// dividing by 3 differs from multiplying by its rounded reciprocal for some values
+		dsp::divide( pa, 3.0f, pr, length );
+		for( size_t i = 0; i < length; i++ )
+			REQUIRE( pr[i] == pa[i] / 3.0f );
+
+		Buffer divisors( length );
+		dsp::add( pb, 2.0f, divisors.getData(), length );
+		dsp::divide( pa, divisors.getData(), pr, length );
+		for( size_t i = 0; i < length; i++ )
+			REQUIRE( pr[i] == pa[i] / divisors[i] );
+
+		dsp::addMul( pa, pb, 0.5f, pr, length );
+		for( size_t i = 0; i < length; i++ )
+			REQUIRE( std::fabs( pr[i] - ( pa[i] + pb[i] ) * 0.5f ) < ACCEPTABLE_FLOAT_ERROR );
+
+		dsp::fill( 0.25f, pr, length );
+		for( size_t i = 0; i < length; i++ )
+			REQUIRE( pr[i] == 0.25f );
+	}
+}
+
+SECTION( "reductions" )
+{
+	for( size_t length : sTestLengths ) {
+		Buffer a( length );
+		fillRandom( &a );
+
+		double sum = 0, sumSquared = 0;
+		for( size_t i = 0; i < length; i++ ) {
+			sum += a[i];
+			sumSquared += a[i] * a[i];
+		}
+
+		const float tolerance = 1e-4f;
+		REQUIRE( std::fabs( dsp::sum( a.getData(), length ) - float( sum ) ) < tolerance );
+		REQUIRE( std::fabs( dsp::rms( a.getData(), length ) - float( std::sqrt( sumSquared / length ) ) ) < tolerance );
+	}
+}
+
+SECTION( "normalize" )
+{
+	for( size_t length : sTestLengths ) {
+		Buffer a( length );
+		fillRandom( &a );
+		a[length / 2] = 2.0f;
+
+		dsp::normalize( a.getData(), length );
+
+		float max = a[0];
+		for( size_t i = 1; i < length; i++ )
+			max = std::max( max, a[i] );
+		REQUIRE( std::fabs( max - 1.0f ) < ACCEPTABLE_FLOAT_ERROR );
+	}
+}
+
+} // "audio/Dsp"
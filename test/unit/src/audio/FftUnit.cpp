@@ -1,14 +1,11 @@
-#include "cinder/Cinder.h"
-
-// FIXME: OOURA roundtrip FFT seems to be broken on windows for sizeFft = 4 (https://github.com/cinder/Cinder/issues/1263)
-#if defined( CINDER_MAC )
-
 #include "catch.hpp"
 #include "utils.h"
 
 #include "cinder/Log.h"
 #include "cinder/audio/dsp/Fft.h"
+#include "cinder/CinderMath.h"
 
+#include <complex>
 #include <iostream>
 
 using namespace ci::audio;
@@ -43,6 +40,62 @@ void computeRoundTrip( size_t sizeFft )
 	REQUIRE( maxErr < ACCEPTABLE_FLOAT_ERROR );
 }
 
+// Transforms 6 channels both with the batched methods and one at a time, so that both the 4 channel and remaining channel paths are used.
+void computeBatchedTransforms( size_t sizeFft )
+{
+	const size_t numChannels = 6;
+
+	dsp::Fft fft( sizeFft );
+	Buffer waveforms( sizeFft, numChannels );
+	fillRandom( &waveforms );
+
+	std::vector<BufferSpectral> spectra( numChannels, BufferSpectral( sizeFft ) );
+	fft.forward( &waveforms, &spectra );
+
+	Buffer waveform( sizeFft );
+	BufferSpectral spectral( sizeFft );
+	for( size_t ch = 0; ch < numChannels; ch++ ) {
+		waveform.copyChannel( 0, waveforms.getChannel( ch ) );
+		fft.forward( &waveform, &spectral );
+		REQUIRE( maxError( spectral, spectra[ch] ) < ACCEPTABLE_FLOAT_ERROR * sizeFft );
+	}
+
+	Buffer result( sizeFft, numChannels );
+	fft.inverse( &spectra, &result );
+	REQUIRE( maxError( result, waveforms ) < ACCEPTABLE_FLOAT_ERROR );
+}
+
+void computeComplexTransforms( size_t sizeFft )
+{
+	dsp::Fft fft( sizeFft );
+	BufferSpectral input( sizeFft * 2 );
+	fillRandom( &input );
+
+	BufferSpectral output( sizeFft * 2 );
+	fft.forwardComplex( &input, &output );
+
+	// compare with a direct DFT
+	float maxErr = 0;
+	for( size_t k = 0; k < sizeFft; k++ ) {
+		std::complex<double> sum = 0;
+		for( size_t j = 0; j < sizeFft; j++ ) {
+			double phase = -2.0 * M_PI * double( j * k % sizeFft ) / double( sizeFft );
+			sum += std::complex<double>( input.getReal()[j], input.getImag()[j] ) * std::polar( 1.0, phase );
+		}
+		maxErr = std::max( maxErr, (float)std::abs( sum - std::complex<double>( output.getReal()[k], output.getImag()[k] ) ) );
+	}
+
+	REQUIRE( maxErr < ACCEPTABLE_FLOAT_ERROR * sizeFft );
+
+	BufferSpectral result( sizeFft * 2 );
+	fft.inverseComplex( &output, &result );
+	REQUIRE( maxError( result, input ) < ACCEPTABLE_FLOAT_ERROR );
+
+	// in-place
+	fft.forwardComplex( &input, &input );
+	REQUIRE( maxError( input, output ) < ACCEPTABLE_FLOAT_ERROR );
+}
+
 }
 
 TEST_CASE( "audio/Fft" )
@@ -55,6 +108,28 @@ SECTION( "round trip error" )
 		computeRoundTrip( 2 << i );
 }
 
-} // "audio/Fft"
+SECTION( "batched transforms" )
+{
+	for( size_t i = 0; i < 12; i ++ )
+		computeBatchedTransforms( 2 << i );
+}
+
+SECTION( "complex transforms" )
+{
+	for( size_t i = 0; i < 9; i ++ )
+		computeComplexTransforms( 2 << i );
+}
+
+SECTION( "plans are shared between instances" )
+{
+	const size_t numPlans = dsp::Fft::getNumCachedPlans();
+	{
+		dsp::Fft fftA( 1 << 17 );
+		dsp::Fft fftB( 1 << 17 );
+		REQUIRE( dsp::Fft::getNumCachedPlans() == numPlans + 1 );
+	}
+
+	REQUIRE( dsp::Fft::getNumCachedPlans() == numPlans );
+}
 
-#endif // ! defined( CINDER_MSW )
+} // "audio/Fft"
@@ -0,0 +1,138 @@
+#include "catch.hpp"
+#include "utils.h"
+
+#include "cinder/audio/OfflineContext.h"
+#include "cinder/audio/SamplePlayerNode.h"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace ci;
+using namespace ci::audio;
+
+namespace {
+
+// In-memory SourceFile where each sample is its frame index modulo 1024, so that sums of many players remain exact.
+class RampSourceFile : public SourceFile {
+  public:
+	RampSourceFile( size_t sampleRate, size_t numFrames )
+		: SourceFile( sampleRate )
+	{
+		mNumFrames = mFileNumFrames = numFrames;
+		setMaxFramesPerRead( 1024 );
+	}
+
+	size_t			getNumChannels() const override			{ return 1; }
+	size_t			getSampleRateNative() const override	{ return getSampleRate(); }
+	SourceFileRef	cloneWithSampleRate( size_t sampleRate ) const override	{ return std::make_shared<RampSourceFile>( sampleRate, mNumFrames ); }
+
+	static float valueAt( size_t frame )	{ return float( frame % 1024 ); }
+
+  protected:
+	size_t performRead( audio::Buffer *buffer, size_t bufferFrameOffset, size_t numFramesNeeded ) override
+	{
+		float *channel = buffer->getChannel( 0 ) + bufferFrameOffset;
+		for( size_t i = 0; i < numFramesNeeded; i++ )
+			channel[i] = valueAt( mReadPos + i );
+
+		return numFramesNeeded;
+	}
+
+	void performSeek( size_t readPositionFrames ) override	{}
+};
+
+// Blocks until every player has either buffered \a numFrames or read to the end of its file.
+void waitForReaders( const std::vector<FilePlayerNodeRef> &players, size_t numFrames )
+{
+	for( const auto &player : players ) {
+		float minFill = float( numFrames ) / float( player->getReadAheadFrames() );
+		while( player->getReadAheadFill() < minFill && player->getReadPosition() < player->getNumFrames() )
+			std::this_thread::sleep_for( std::chrono::microseconds( 100 ) );
+	}
+}
+
+} // anonymous namespace
+
+TEST_CASE( "audio/FilePlayerNode" )
+{
+
+SECTION( "many players share the read threads" )
+{
+	const size_t numPlayers = 64;
+	const size_t numFrames = 20000;
+	const size_t framesPerBlock = 256;
+
+	auto ctx = std::make_shared<OfflineContext>( 44100, framesPerBlock, 1 );
+	ctx->getOfflineOutput()->enableClipDetection( false );
+
+	std::vector<FilePlayerNodeRef> players;
+	for( size_t i = 0; i < numPlayers; i++ ) {
+		auto player = ctx->makeNode<FilePlayerNode>( std::make_shared<RampSourceFile>( 44100, numFrames ) );
+		player->setReadAheadFrames( 4096 );
+		player >> ctx->getOutput();
+		players.push_back( player );
+	}
+
+	std::vector<float> result;
+	ctx->getOfflineOutput()->setRenderCallback( [&result]( const audio::Buffer *buffer, size_t numFrames ) {
+		result.insert( result.end(), buffer->getChannel( 0 ), buffer->getChannel( 0 ) + numFrames );
+	} );
+
+	for( auto &player : players )
+		player->start();
+
+	while( result.size() < numFrames ) {
+		waitForReaders( players, framesPerBlock );
+		ctx->renderBlock();
+	}
+
+	for( size_t i = 0; i < numFrames; i++ )
+		REQUIRE( result[i] == RampSourceFile::valueAt( i ) * float( numPlayers ) );
+
+	for( auto &player : players )
+		REQUIRE( player->getNumUnderruns() == 0 );
+}
+
+SECTION( "changing the number of read threads while playing" )
+{
+	const size_t numFrames = 10000;
+	const size_t framesPerBlock = 128;
+
+	auto ctx = std::make_shared<OfflineContext>( 44100, framesPerBlock, 1 );
+	ctx->getOfflineOutput()->enableClipDetection( false );
+
+	auto player = ctx->makeNode<FilePlayerNode>( std::make_shared<RampSourceFile>( 44100, numFrames ) );
+	player->setReadAheadFrames( 2048 );
+	player >> ctx->getOutput();
+
+	std::vector<float> result;
+	ctx->getOfflineOutput()->setRenderCallback( [&result]( const audio::Buffer *buffer, size_t numFrames ) {
+		result.insert( result.end(), buffer->getChannel( 0 ), buffer->getChannel( 0 ) + numFrames );
+	} );
+
+	size_t numReadThreads = FilePlayerNode::getNumReadThreads();
+
+	player->start();
+
+	std::vector<FilePlayerNodeRef> players = { player };
+	for( size_t block = 0; result.size() < numFrames; block++ ) {
+		if( block % 16 == 0 ) {
+			// zero read threads is clamped to one
+			FilePlayerNode::setNumReadThreads( block % 3 );
+			REQUIRE( FilePlayerNode::getNumReadThreads() == std::max<size_t>( block % 3, 1 ) );
+		}
+
+		waitForReaders( players, framesPerBlock );
+		ctx->renderBlock();
+	}
+
+	FilePlayerNode::setNumReadThreads( numReadThreads );
+
+	for( size_t i = 0; i < numFrames; i++ )
+		REQUIRE( result[i] == RampSourceFile::valueAt( i ) );
+
+	REQUIRE( player->getNumUnderruns() == 0 );
+}
+
+} // "audio/FilePlayerNode"
@@ -0,0 +1,110 @@
+#include "catch.hpp"
+
+#include "cinder/audio/OfflineContext.h"
+#include "cinder/audio/GainNode.h"
+#include "cinder/audio/GenNode.h"
+#include "cinder/audio/PanNode.h"
+
+#include <vector>
+
+using namespace ci;
+using namespace ci::audio;
+
+namespace {
+
+// Restarts the generators and renders \a numFrames, returning the result (channels are concatenated per block).
+std::vector<float> renderFromStart( const std::shared_ptr<OfflineContext> &ctx, const std::vector<GenNodeRef> &gens, size_t numFrames )
+{
+	for( const auto &gen : gens )
+		gen->setPhase( 0 );
+
+	std::vector<float> result;
+	ctx->getOfflineOutput()->setRenderCallback( [&result]( const audio::Buffer *buffer, size_t numFrames ) {
+		for( size_t ch = 0; ch < buffer->getNumChannels(); ch++ )
+			result.insert( result.end(), buffer->getChannel( ch ), buffer->getChannel( ch ) + numFrames );
+	} );
+
+	ctx->render( numFrames );
+	ctx->getOfflineOutput()->setRenderCallback( nullptr );
+	return result;
+}
+
+// Renders the graph serially and then with render threads, requiring identical output. Returns whether \a node pulled its inputs in parallel.
+bool rendersIdenticallyInParallel( const std::shared_ptr<OfflineContext> &ctx, const std::vector<GenNodeRef> &gens, const NodeRef &node )
+{
+	const size_t numFrames = 10000;
+
+	ctx->setNumRenderThreads( 0 );
+	auto serial = renderFromStart( ctx, gens, numFrames );
+
+	ctx->setNumRenderThreads( 2 );
+	auto parallel = renderFromStart( ctx, gens, numFrames );
+	bool pullsInParallel = node->getPullsInputsInParallel();
+	ctx->setNumRenderThreads( 0 );
+
+	REQUIRE( serial.size() == numFrames * ctx->getOutput()->getNumChannels() );
+	REQUIRE( parallel == serial );
+	return pullsInParallel;
+}
+
+} // anonymous namespace
+
+TEST_CASE( "audio/Node" )
+{
+	auto ctx = std::make_shared<OfflineContext>( 44100, 128, 2 );
+	std::vector<GenNodeRef> gens;
+
+SECTION( "parallel pulling of independent subgraphs" )
+{
+	// the mixer is below the output, so it is the outermost Node with independent inputs
+	auto mixer = ctx->makeNode<GainNode>( 0.25f );
+	mixer >> ctx->getOutput();
+	for( size_t i = 0; i < 4; i++ ) {
+		auto gen = ctx->makeNode<GenSineNode>( 220.0f * float( i + 1 ) );
+		gen >> ctx->makeNode<GainNode>( 0.5f ) >> mixer;
+		gen->enable();
+		gens.push_back( gen );
+	}
+
+	REQUIRE( rendersIdenticallyInParallel( ctx, gens, mixer ) );
+	REQUIRE( ! ctx->getOutput()->getPullsInputsInParallel() );
+}
+
+SECTION( "parallel pulling with summing inputs" )
+{
+	// mono and stereo inputs with unequal channel counts, which sum into their own buffers instead of processing in-place
+	auto mixer = ctx->makeNode<GainNode>( 0.5f, Node::Format().channels( 2 ) );
+	mixer >> ctx->getOutput();
+
+	auto gen1 = ctx->makeNode<GenTriangleNode>( 330.0f );
+	gen1 >> mixer;
+	auto gen2 = ctx->makeNode<GenSineNode>( 440.0f );
+	auto pan = ctx->makeNode<Pan2dNode>();
+	pan->setPos( 0.25f );
+	gen2 >> pan >> mixer;
+	auto gen3 = ctx->makeNode<GenSineNode>( 550.0f );
+	gen3 >> ctx->makeNode<GainNode>( 0.75f ) >> mixer;
+	gens = { gen1, gen2, gen3 };
+	for( const auto &gen : gens )
+		gen->enable();
+
+	REQUIRE( rendersIdenticallyInParallel( ctx, gens, mixer ) );
+}
+
+SECTION( "shared subgraphs are pulled serially" )
+{
+	// both inputs of the mixer pull from the same generator, so they are not independent
+	auto mixer = ctx->makeNode<GainNode>( 0.5f );
+	mixer >> ctx->getOutput();
+
+	auto gen = ctx->makeNode<GenSineNode>( 440.0f );
+	gen >> ctx->makeNode<GainNode>( 0.5f ) >> mixer;
+	gen >> ctx->makeNode<GainNode>( 0.25f ) >> mixer;
+	gen->enable();
+	gens.push_back( gen );
+
+	REQUIRE( ! rendersIdenticallyInParallel( ctx, gens, mixer ) );
+	REQUIRE( ! ctx->getOutput()->getPullsInputsInParallel() );
+}
+
+} // "audio/Node"
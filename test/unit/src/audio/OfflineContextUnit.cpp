@@ -0,0 +1,117 @@
+#include "catch.hpp"
+#include "utils.h"
+
+#include "cinder/audio/OfflineContext.h"
+#include "cinder/audio/GainNode.h"
+#include "cinder/audio/GenNode.h"
+
+#include <vector>
+
+using namespace ci;
+using namespace ci::audio;
+
+namespace {
+
+// Sums \a numVoices sine -> gain chains at the output of \a ctx, returning the generators.
+std::vector<GenSineNodeRef> makeVoices( const ContextRef &ctx, size_t numVoices )
+{
+	std::vector<GenSineNodeRef> gens;
+	for( size_t i = 0; i < numVoices; i++ ) {
+		auto gen = ctx->makeNode<GenSineNode>( 110.0f * float( i + 1 ) );
+		auto gain = ctx->makeNode<GainNode>( 1.0f / float( numVoices ) );
+		gen >> gain >> ctx->getOutput();
+		gen->enable();
+		gens.push_back( gen );
+	}
+
+	return gens;
+}
+
+// Restarts the generators and renders \a numFrames, returning the result (channels are concatenated per block).
+std::vector<float> renderFromStart( const std::shared_ptr<OfflineContext> &ctx, const std::vector<GenSineNodeRef> &gens, size_t numFrames )
+{
+	for( const auto &gen : gens )
+		gen->setPhase( 0 );
+
+	std::vector<float> result;
+	ctx->getOfflineOutput()->setRenderCallback( [&result]( const audio::Buffer *buffer, size_t numFrames ) {
+		for( size_t ch = 0; ch < buffer->getNumChannels(); ch++ )
+			result.insert( result.end(), buffer->getChannel( ch ), buffer->getChannel( ch ) + numFrames );
+	} );
+
+	ctx->render( numFrames );
+	ctx->getOfflineOutput()->setRenderCallback( nullptr );
+	return result;
+}
+
+} // anonymous namespace
+
+TEST_CASE( "audio/OfflineContext" )
+{
+
+SECTION( "render frame count" )
+{
+	auto ctx = std::make_shared<OfflineContext>( 48000, 128, 1 );
+	auto gen = ctx->makeNode<GenSineNode>( 440.0f );
+	gen >> ctx->getOutput();
+	gen->enable();
+
+	size_t numBlocks = 0, numFramesDelivered = 0;
+	ctx->getOfflineOutput()->setRenderCallback( [&]( const audio::Buffer *buffer, size_t numFrames ) {
+		REQUIRE( buffer->getNumFrames() == 128 );
+		numBlocks++;
+		numFramesDelivered += numFrames;
+	} );
+
+	ctx->render( 1000 );
+
+	REQUIRE( numBlocks == 8 );
+	REQUIRE( numFramesDelivered == 1000 );
+	REQUIRE( ctx->getNumProcessedFrames() == 8 * 128 );
+
+	ctx->renderBlock();
+	REQUIRE( ctx->getNumProcessedFrames() == 9 * 128 );
+}
+
+SECTION( "renders signal" )
+{
+	auto ctx = std::make_shared<OfflineContext>( 44100, 512, 1 );
+	auto gen = ctx->makeNode<GenSineNode>( 440.0f );
+	gen >> ctx->getOutput();
+	gen->enable();
+
+	float maxValue = 0;
+	ctx->getOfflineOutput()->setRenderCallback( [&]( const audio::Buffer *buffer, size_t numFrames ) {
+		for( size_t i = 0; i < numFrames; i++ )
+			maxValue = std::max( maxValue, std::fabs( (*buffer)[i] ) );
+	} );
+
+	ctx->renderSeconds( 0.1 );
+	REQUIRE( maxValue > 0.9f );
+	REQUIRE( maxValue <= 1.0f );
+}
+
+SECTION( "parallel rendering matches serial" )
+{
+	const size_t numFrames = 44100;
+	auto ctx = std::make_shared<OfflineContext>( 44100, 256, 2 );
+	auto gens = makeVoices( ctx, 16 );
+
+	// render the same graph with and without render threads, so the voices are summed in the same order
+	REQUIRE( ! ctx->getOutput()->getPullsInputsInParallel() );
+	auto serial = renderFromStart( ctx, gens, numFrames );
+
+	ctx->setNumRenderThreads( 3 );
+	REQUIRE( ctx->getOutput()->getPullsInputsInParallel() );
+	auto parallel = renderFromStart( ctx, gens, numFrames );
+
+	ctx->setNumRenderThreads( 0 );
+	REQUIRE( ! ctx->getOutput()->getPullsInputsInParallel() );
+	auto serialAgain = renderFromStart( ctx, gens, numFrames );
+
+	REQUIRE( serial.size() == numFrames * 2 );
+	REQUIRE( parallel == serial );
+	REQUIRE( serialAgain == serial );
+}
+
+} // "audio/OfflineContext"
@@ -0,0 +1,130 @@
+#include "catch.hpp"
+
+#include "cinder/audio/OfflineContext.h"
+#include "cinder/audio/GainNode.h"
+#include "cinder/audio/GenNode.h"
+
+using namespace ci;
+using namespace ci::audio;
+
+TEST_CASE( "audio/Param" )
+{
+
+SECTION( "ramp reaches its end value" )
+{
+	auto ctx = std::make_shared<OfflineContext>( 44100, 256, 1 );
+	auto gain = ctx->makeNode<GainNode>( 0.0f );
+	ctx->makeNode<GenSineNode>( 440.0f ) >> gain >> ctx->getOutput();
+
+	gain->getParam()->applyRamp( 1.0f, 0.1 );
+	REQUIRE( gain->getParam()->getNumEvents() == 1 );
+
+	ctx->renderSeconds( 0.2 );
+	REQUIRE( gain->getValue() == Approx( 1.0f ) );
+	REQUIRE( gain->getParam()->getNumEvents() == 0 );
+}
+
+SECTION( "appended ramps follow each other" )
+{
+	auto ctx = std::make_shared<OfflineContext>( 44100, 256, 1 );
+	auto gain = ctx->makeNode<GainNode>( 0.0f );
+	ctx->makeNode<GenSineNode>( 440.0f ) >> gain >> ctx->getOutput();
+
+	auto first = gain->getParam()->applyRamp( 0.5f, 0.1 );
+	auto second = gain->getParam()->appendRamp( 1.0f, 0.1 );
+	REQUIRE( second->getTimeBegin() == Approx( first->getTimeEnd() ) );
+	REQUIRE( gain->getParam()->findEndTimeAndValue().second == 1.0f );
+
+	ctx->renderSeconds( 0.15 );
+	REQUIRE( first->isComplete() );
+	REQUIRE( gain->getValue() > 0.5f );
+	REQUIRE( gain->getValue() < 1.0f );
+
+	ctx->renderSeconds( 0.1 );
+	REQUIRE( second->isComplete() );
+	REQUIRE( gain->getValue() == Approx( 1.0f ) );
+}
+
+SECTION( "setValue cancels events" )
+{
+	auto ctx = std::make_shared<OfflineContext>( 44100, 256, 1 );
+	auto gain = ctx->makeNode<GainNode>( 0.0f );
+	ctx->makeNode<GenSineNode>( 440.0f ) >> gain >> ctx->getOutput();
+
+	auto event = gain->getParam()->applyRamp( 1.0f, 1.0 );
+	ctx->renderSeconds( 0.1 );
+
+	gain->setValue( 0.25f );
+	REQUIRE( gain->getValue() == 0.25f );
+	REQUIRE( gain->getParam()->getNumEvents() == 0 );
+
+	ctx->renderSeconds( 0.1 );
+	REQUIRE( gain->getValue() == 0.25f );
+	REQUIRE( gain->getParam()->getNumEvents() == 0 );
+	REQUIRE( ! event->isComplete() );
+}
+
+SECTION( "reset clears scheduled events" )
+{
+	auto ctx = std::make_shared<OfflineContext>( 44100, 256, 1 );
+	auto gain = ctx->makeNode<GainNode>( 0.0f );
+	ctx->makeNode<GenSineNode>( 440.0f ) >> gain >> ctx->getOutput();
+
+	gain->getParam()->applyRamp( 1.0f, 1.0 );
+	gain->getParam()->appendRamp( 0.5f, 1.0 );
+	ctx->renderSeconds( 0.1 );
+	REQUIRE( gain->getParam()->getNumEvents() == 2 );
+
+	gain->getParam()->reset();
+	REQUIRE( gain->getParam()->getNumEvents() == 0 );
+	REQUIRE( gain->getParam()->findDuration() == 0 );
+}
+
+SECTION( "scheduled enable and disable" )
+{
+	auto ctx = std::make_shared<OfflineContext>( 44100, 256, 1 );
+	auto gen = ctx->makeNode<GenSineNode>( 440.0f );
+	gen >> ctx->getOutput();
+
+	gen->enable( 0.1 );
+	gen->disable( 0.3 );
+	ctx->renderSeconds( 0.05 );
+	REQUIRE( ! gen->isEnabled() );
+
+	// only one event is supported per Node, so disable() replaced the scheduled enable()
+	ctx->renderSeconds( 0.1 );
+	REQUIRE( ! gen->isEnabled() );
+
+	gen->enable();
+	gen->disable( ctx->getNumProcessedSeconds() + 0.1 );
+	ctx->renderSeconds( 0.05 );
+	REQUIRE( gen->isEnabled() );
+	ctx->renderSeconds( 0.1 );
+	REQUIRE( ! gen->isEnabled() );
+}
+
+SECTION( "finished commands release their Node" )
+{
+	auto ctx = std::make_shared<OfflineContext>( 44100, 256, 1 );
+
+	// the Context isn't processing, so the ramp is applied right away
+	auto gain = ctx->makeNode<GainNode>( 0.0f );
+	gain->getParam()->applyRamp( 1.0f, 0.1 );
+	REQUIRE( gain->getParam()->getNumEvents() == 1 );
+	std::weak_ptr<GainNode> weakGain = gain;
+	gain.reset();
+	REQUIRE( weakGain.expired() );
+
+	// after rendering on this thread, ramps are sent to the next render and released once it is done with them
+	gain = ctx->makeNode<GainNode>( 0.0f );
+	ctx->makeNode<GenSineNode>( 440.0f ) >> gain >> ctx->getOutput();
+	ctx->renderBlock();
+	gain->getParam()->applyRamp( 1.0f, 0.01 );
+	ctx->renderBlock();
+	gain->disconnectAll();
+	weakGain = gain;
+	gain.reset();
+	REQUIRE( weakGain.expired() );
+}
+
+} // "audio/Param"
@@ -0,0 +1,118 @@
+#include "catch.hpp"
+
+#include "cinder/audio/SampleCache.h"
+#include "cinder/audio/Target.h"
+#include "cinder/CinderMath.h"
+
+#include <cmath>
+#include <cstring>
+
+using namespace ci;
+using namespace ci::audio;
+
+namespace {
+
+fs::path getTestDirectory()
+{
+	fs::path result = fs::temp_directory_path() / "cinder_SampleCacheUnit";
+	fs::create_directories( result );
+	return result;
+}
+
+// Writes a two channel sine wave to an Ogg Vorbis file, which can be decoded on all platforms.
+fs::path writeTestFile( const std::string &name, size_t numFrames, float freq )
+{
+	fs::path result = getTestDirectory() / name;
+
+	audio::Buffer buffer( numFrames, 2 );
+	for( size_t ch = 0; ch < buffer.getNumChannels(); ch++ ) {
+		for( size_t i = 0; i < numFrames; i++ )
+			buffer.getChannel( ch )[i] = 0.5f * std::sin( 2.0f * float( M_PI ) * freq * float( i + ch ) / 44100.0f );
+	}
+
+	auto target = TargetFile::create( result, 44100, 2 );
+	target->write( &buffer );
+	return result;
+}
+
+void resetCache()
+{
+	auto cache = SampleCache::get();
+	cache->clear();
+	cache->setDiskCacheDirectory( fs::path() );
+	cache->setMemoryBudget( 512 * 1024 * 1024 );
+}
+
+} // anonymous namespace
+
+TEST_CASE( "audio/SampleCache" )
+{
+	auto cache = SampleCache::get();
+	resetCache();
+
+	fs::path fileA = writeTestFile( "a.ogg", 20000, 440 );
+	fs::path fileB = writeTestFile( "b.ogg", 10000, 220 );
+
+SECTION( "buffers are shared by path and samplerate" )
+{
+	auto a1 = cache->load( fileA );
+	auto a2 = cache->load( loadFile( fileA ) );
+	auto a3 = cache->load( fileA, 22050 );
+
+	REQUIRE( a1 );
+	REQUIRE( a1 == a2 );
+	REQUIRE( a1 != a3 );
+	REQUIRE( a1->getNumChannels() == 2 );
+	REQUIRE( a3->getNumFrames() < a1->getNumFrames() );
+	REQUIRE( cache->getNumBuffers() == 2 );
+	REQUIRE( cache->getMemoryUsage() == ( a1->getSize() + a3->getSize() ) * sizeof( float ) );
+}
+
+SECTION( "least recently used buffers are evicted over budget" )
+{
+	size_t bytesA = cache->load( fileA )->getSize() * sizeof( float );
+	size_t bytesB = cache->load( fileB )->getSize() * sizeof( float );
+	REQUIRE( cache->getNumBuffers() == 2 );
+
+	// touch a so that b is least recently used
+	cache->load( fileA );
+
+	cache->setMemoryBudget( bytesA );
+	REQUIRE( cache->getNumBuffers() == 1 );
+	REQUIRE( cache->getMemoryUsage() == bytesA );
+
+	// buffers that are still referenced elsewhere are kept
+	auto b = cache->load( fileB );
+	cache->setMemoryBudget( bytesB );
+	REQUIRE( cache->getNumBuffers() == 1 );
+	REQUIRE( cache->getMemoryUsage() == bytesB );
+	REQUIRE( cache->load( fileB ) == b );
+}
+
+SECTION( "disk cache" )
+{
+	fs::path cacheDir = getTestDirectory() / "cache";
+	fs::remove_all( cacheDir );
+	cache->setDiskCacheDirectory( cacheDir );
+
+	auto decoded = cache->load( fileA );
+
+	size_t numCacheFiles = 0;
+	for( const auto &entry : fs::directory_iterator( cacheDir ) ) {
+		if( entry.path().extension() == ".samples" )
+			numCacheFiles++;
+	}
+	REQUIRE( numCacheFiles == 1 );
+
+	// dropping the in-memory copy forces the next load to come from the disk cache
+	cache->clear();
+	auto mapped = cache->load( fileA );
+
+	REQUIRE( mapped != decoded );
+	REQUIRE( mapped->getNumFrames() == decoded->getNumFrames() );
+	REQUIRE( mapped->getNumChannels() == decoded->getNumChannels() );
+	REQUIRE( std::memcmp( mapped->getData(), decoded->getData(), decoded->getSize() * sizeof( float ) ) == 0 );
+}
+
+	resetCache();
+}
@@ -5,9 +5,11 @@
 #include "cinder/Signals.h"
 #include "cinder/app/Event.h"
 
+#include <atomic>
 #include <iostream>
 #include <iomanip>
 #include <sstream>
+#include <thread>
 
 using namespace std;
 using namespace ci;
@@ -38,6 +40,14 @@ static char floatCallback( float f, int, string )
 	return 0;
 }
 
+// Disconnects a Connection when destroyed along with the callback that holds it
+struct DisconnectOnDestroy {
+	DisconnectOnDestroy( const Connection &conn ) : mConn( conn ) {}
+	~DisconnectOnDestroy()	{ mConn.disconnect(); }
+
+	Connection	mConn;
+};
+
 } // namespace
 
 TEST_CASE( "signals/Signals" )
@@ -625,3 +635,193 @@ TEST_CASE( "signals/Signals" )
 	}
 
 } // Signals
+
+TEST_CASE( "signals/ThreadSafeSignal" )
+{
+	SECTION( "Slots are called in priority order and can be disconnected" )
+	{
+		ThreadSafeSignal<void ()> sig;
+		string accum;
+
+		auto conn1 = sig.connect( [&] { accum += "a"; } );
+		sig.connect( 1, [&] { accum += "b"; } );
+		auto conn3 = sig.connect( 1, [&] { accum += "c"; } );
+		sig.connect( 2, [&] { accum += "d"; } );
+		sig.connect( -100, [&] { accum += "e"; } );
+		sig.connect( 100, [&] { accum += "f"; } );
+		sig.connect( [&] { accum += "g"; } );
+
+		sig.emit();
+		REQUIRE( accum == "fdbcage" );
+		REQUIRE( sig.getNumSlots() == 7 );
+
+		REQUIRE( conn3.disconnect() );
+		REQUIRE_FALSE( conn3.disconnect() );
+		REQUIRE( conn1.disconnect() );
+		REQUIRE( sig.getNumSlots() == 5 );
+
+		accum.clear();
+		sig.emit();
+		REQUIRE( accum == "fdbge" );
+	}
+
+	SECTION( "Connections can be changed within a signal callback" )
+	{
+		ThreadSafeSignal<void ()> sig;
+		int i = 0;
+
+		Connection conn2;
+		sig.connect( [&] {
+			conn2.disconnect();
+			sig.connect( [&] { i += 100; } );
+			i++;
+		} );
+		conn2 = sig.connect( [&] { i += 10; } );
+
+		// the disconnected slot is skipped and the new one isn't called until the next emission
+		sig.emit();
+		REQUIRE( i == 1 );
+		REQUIRE( sig.getNumSlots() == 2 );
+
+		sig.emit();
+		REQUIRE( i == 102 );
+	}
+
+	SECTION( "Collectors, toggling and ScopedConnection" )
+	{
+		ThreadSafeSignal<int (), CollectorVector<int>> sig;
+		sig.connect( [] { return 1; } );
+		auto conn = sig.connect( [] { return 2; } );
+		{
+			ScopedConnection scoped = sig.connect( [] { return 3; } );
+			REQUIRE( sig.emit() == vector<int>( { 1, 2, 3 } ) );
+		}
+
+		conn.disable();
+		REQUIRE( sig.emit() == vector<int>( { 1 } ) );
+		conn.enable();
+		REQUIRE( sig.emit() == vector<int>( { 1, 2 } ) );
+
+		ThreadSafeSignal<bool (), CollectorUntil0<bool>> until;
+		int numCalls = 0;
+		until.connect( [&] { numCalls++; return false; } );
+		until.connect( [&] { numCalls++; return true; } );
+		REQUIRE_FALSE( until.emit() );
+		REQUIRE( numCalls == 1 );
+	}
+
+	SECTION( "Connections outliving the signal" )
+	{
+		Connection conn;
+		{
+			ThreadSafeSignal<void ()> sig;
+			conn = sig.connect( [] {} );
+			REQUIRE( conn.isConnected() );
+		}
+
+		REQUIRE_FALSE( conn.isConnected() );
+		REQUIRE_FALSE( conn.disconnect() );
+	}
+
+	SECTION( "Emitting while other threads connect and disconnect" )
+	{
+		ThreadSafeSignal<void ( int )> sig;
+		atomic<int> sum( 0 );
+
+		// these stay connected throughout, so every emission calls them
+		const int numPermanent = 50;
+		for( int i = 0; i < numPermanent; i++ )
+			sig.connect( [&sum]( int value ) { sum += value; } );
+
+		atomic<bool> done( false );
+		vector<thread> threads;
+		for( int t = 0; t < 2; t++ ) {
+			threads.emplace_back( [&sig, &done, t] {
+				vector<Connection> connections;
+				while( ! done ) {
+					connections.push_back( sig.connect( t, []( int ) {} ) );
+					if( connections.size() > 20 ) {
+						for( auto &conn : connections )
+							conn.disconnect();
+						connections.clear();
+					}
+				}
+				for( auto &conn : connections )
+					conn.disconnect();
+			} );
+		}
+
+		const int numEmitThreads = 3, numEmits = 2000;
+		vector<thread> emitThreads;
+		for( int t = 0; t < numEmitThreads; t++ ) {
+			emitThreads.emplace_back( [&sig] {
+				for( int i = 0; i < numEmits; i++ )
+					sig.emit( 1 );
+			} );
+		}
+
+		for( auto &thread : emitThreads )
+			thread.join();
+		done = true;
+		for( auto &thread : threads )
+			thread.join();
+
+		REQUIRE( sum == numPermanent * numEmitThreads * numEmits );
+		REQUIRE( sig.getNumSlots() == numPermanent );
+	}
+
+	SECTION( "Connecting while other threads emit continuously" )
+	{
+		ThreadSafeSignal<void ()> sig;
+		sig.connect( [] {} );
+
+		atomic<bool> done( false );
+		vector<thread> emitThreads;
+		for( int t = 0; t < 3; t++ ) {
+			emitThreads.emplace_back( [&sig, &done] {
+				while( ! done )
+					sig.emit();
+			} );
+		}
+
+		// every connect() and disconnect() waits for emissions that are acquiring the slots, but not for those that start after it
+		for( int i = 0; i < 500; i++ )
+			sig.connect( [] {} ).disconnect();
+
+		done = true;
+		for( auto &thread : emitThreads )
+			thread.join();
+
+		REQUIRE( sig.getNumSlots() == 1 );
+	}
+
+	SECTION( "Callbacks destroyed by a disconnection can disconnect from any signal" )
+	{
+		ThreadSafeSignal<void ()> signals[2];
+		atomic<int> numDisconnected( 0 );
+
+		// each callback disconnects a slot of the other signal and of its own when it is destroyed, while the other thread does the opposite
+		vector<thread> threads;
+		for( int t = 0; t < 2; t++ ) {
+			threads.emplace_back( [&signals, &numDisconnected, t] {
+				auto &own = signals[t], &other = signals[1 - t];
+				for( int i = 0; i < 2000; i++ ) {
+					auto holder = make_shared<DisconnectOnDestroy>( other.connect( [] {} ) );
+					auto sameHolder = make_shared<DisconnectOnDestroy>( own.connect( [] {} ) );
+					Connection conn = own.connect( [holder, sameHolder] {} );
+					holder.reset();
+					sameHolder.reset();
+					numDisconnected += conn.disconnect() ? 1 : 0;
+				}
+			} );
+		}
+
+		for( auto &thread : threads )
+			thread.join();
+
+		REQUIRE( numDisconnected == 4000 );
+		REQUIRE( signals[0].getNumSlots() == 0 );
+		REQUIRE( signals[1].getNumSlots() == 0 );
+	}
+
+} // ThreadSafeSignal